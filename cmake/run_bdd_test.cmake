@@ -71,6 +71,9 @@ elseif(DEFINED TEDDY_METHOD AND TEDDY_METHOD)
 elseif(DEFINED CUDD_METHOD AND CUDD_METHOD)
     set(REFERENCE_FILES_DIR "${TEST_EXPRESSIONS_DIR}/expected_output")
     message(STATUS "Using expected_output reference files for CUDD method test")
+elseif(DEFINED NATIVE_METHOD AND NATIVE_METHOD)
+    set(REFERENCE_FILES_DIR "${TEST_EXPRESSIONS_DIR}/expected_output")
+    message(STATUS "Using expected_output reference files for native method test")
 else()
     set(REFERENCE_FILES_DIR "${TEST_EXPRESSIONS_DIR}/expected_output")
 endif()
@@ -197,6 +200,16 @@ elseif(DEFINED CUDD_METHOD AND CUDD_METHOD)
         TIMEOUT 30
     )
     message(STATUS "Running with --method=cudd option")
+elseif(DEFINED NATIVE_METHOD AND NATIVE_METHOD)
+    execute_process(
+        COMMAND "${EXECUTABLE}" "${TEST_EXPRESSION_FILE}" "--method=native"
+        WORKING_DIRECTORY "${TEST_BUILD_DIR}"
+        RESULT_VARIABLE EXEC_RESULT
+        OUTPUT_VARIABLE EXEC_OUTPUT
+        ERROR_VARIABLE EXEC_ERROR
+        TIMEOUT 30
+    )
+    message(STATUS "Running with --method=native option")
 else()
     execute_process(
         COMMAND "${EXECUTABLE}" "${TEST_EXPRESSION_FILE}"
@@ -126,6 +126,28 @@ function(add_bdd_cudd_test TEST_NAME EXPRESSION_FILE)
     )
 endfunction()
 
+# Define test helper function for native method BDD generation tests
+function(add_bdd_native_test TEST_NAME EXPRESSION_FILE)
+    # Create a test that uses --method=native and compares against default reference files
+    add_test(
+        NAME ${TEST_NAME}
+        COMMAND ${CMAKE_COMMAND}
+            -DTEST_NAME=${TEST_NAME}
+            -DEXPRESSION_FILE=${EXPRESSION_FILE}
+            -DEXECUTABLE=$<TARGET_FILE:bdd_demo>
+            -DSOURCE_DIR=${CMAKE_SOURCE_DIR}
+            -DBINARY_DIR=${CMAKE_BINARY_DIR}
+            -DNATIVE_METHOD=TRUE
+            -P ${CMAKE_SOURCE_DIR}/cmake/run_bdd_test.cmake
+    )
+
+    # Set test properties
+    set_tests_properties(${TEST_NAME} PROPERTIES
+        TIMEOUT 30
+        WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+    )
+endfunction()
+
 # Define test helper function for Mermaid generation tests
 function(add_mermaid_test TEST_NAME EXPRESSION_FILE)
     # Create a test that uses --mermaid with --method=teddy and verifies the analysis markdown file
@@ -210,6 +232,10 @@ function(register_bdd_tests)
                     message(STATUS "Skipped CUDD method test for ${TEST_NAME} (no CUDD reference files)")
                 endif()
 
+                # Add native method test (complement edges are expanded, so results are identical)
+                add_bdd_native_test("${TEST_NAME}_native" "${REL_PATH}")
+                message(STATUS "Added native method test: ${TEST_NAME}_native")
+
                 # Check if reordered reference files exist
                 set(REORDERED_NODES_FILE "${CMAKE_SOURCE_DIR}/test_expressions/reordered/${BASE_NAME}_bdd_nodes.txt")
 
@@ -263,6 +289,10 @@ function(register_bdd_tests)
                 else()
                     message(STATUS "Skipped CUDD method edge case test for ${TEST_NAME} (no CUDD reference files)")
                 endif()
+
+                # Add native method test for edge cases
+                add_bdd_native_test("${TEST_NAME}_native" "${REL_PATH}")
+                message(STATUS "Added native method edge case test: ${TEST_NAME}_native")
             endif()
         endif()
     endforeach()
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file batch_evaluator.hpp
+ * @brief Bit-sliced batch evaluation of expressions and decision diagrams
+ *
+ * Evaluates one Boolean function over many assignments at once. Input is
+ * columnar: one bitmap per variable, where bit `r` of a column holds the value
+ * of that variable in row `r`. An expression tree or a built TeDDy/CUDD
+ * diagram is first compiled to a straight-line program of bitwise AND, OR,
+ * XOR, NOT and MUX instructions; every instruction then processes a tile of
+ * rows with 64-bit words, AVX2 (256-bit) or AVX-512 (512-bit) lanes, selected
+ * at runtime from what the CPU supports. Tiles are split across threads.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <libteddy/core.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expression_types.hpp"
+
+class BDD;
+
+namespace batch_eval {
+
+/**
+ * @brief Instruction set used for the bitwise kernels
+ */
+enum class isa {
+    automatic,  ///< Widest instruction set supported by the CPU
+    scalar,     ///< Portable 64-bit words
+    avx2,       ///< 256-bit AVX2 lanes
+    avx512      ///< 512-bit AVX-512F lanes
+};
+
+/**
+ * @brief Display name of an instruction set ("scalar", "avx2", ...)
+ */
+std::string isa_name(isa value);
+
+/**
+ * @brief Parses an instruction set name as accepted by isa_name()
+ * @throws std::runtime_error If the name is unknown
+ */
+isa parse_isa(const std::string& name);
+
+/**
+ * @brief Whether the running CPU (and OS) supports an instruction set
+ */
+bool isa_supported(isa value);
+
+/**
+ * @brief Widest instruction set supported by the running CPU
+ */
+isa detect_isa();
+
+/**
+ * @brief Operation of a program instruction
+ */
+enum class opcode : std::uint8_t {
+    op_and,  ///< a & b
+    op_or,   ///< a | b
+    op_xor,  ///< a ^ b
+    op_not,  ///< ~a
+    op_mux   ///< a ? b : c, bitwise
+};
+
+/**
+ * @brief One instruction of a compiled program
+ *
+ * Operands are value ids (see program). The instruction at position `i`
+ * defines value `program::first_result() + i`.
+ */
+struct instruction {
+    opcode op = opcode::op_and;
+    std::uint32_t a = 0;  ///< First operand (MUX selector)
+    std::uint32_t b = 0;  ///< Second operand (MUX value when the selector is 1)
+    std::uint32_t c = 0;  ///< Third operand (MUX value when the selector is 0)
+};
+
+/**
+ * @brief Straight-line bitwise program computing one Boolean function
+ *
+ * Values are numbered as follows: `[0, inputs().size())` are the input
+ * columns, then the constants zero() and one(), then one value per
+ * instruction. Instructions only refer to earlier values, so the program can
+ * be executed in order. The emit helpers fold constants and trivial cases, so
+ * e.g. `apply_and(x, one())` emits nothing and returns `x`.
+ */
+class program {
+   public:
+    /**
+     * @brief Creates an empty program over the given input variables
+     * @param inputs Input variable names; value id `i` refers to `inputs[i]`
+     */
+    explicit program(std::vector<std::string> inputs = {});
+
+    const std::vector<std::string>& inputs() const {
+        return inputs_;
+    }
+
+    const std::vector<instruction>& code() const {
+        return code_;
+    }
+
+    std::uint32_t zero() const {
+        return static_cast<std::uint32_t>(inputs_.size());
+    }
+
+    std::uint32_t one() const {
+        return zero() + 1;
+    }
+
+    std::uint32_t first_result() const {
+        return zero() + 2;
+    }
+
+    /**
+     * @brief Value id of the program result
+     */
+    std::uint32_t result() const {
+        return result_;
+    }
+
+    void set_result(std::uint32_t value) {
+        result_ = value;
+    }
+
+    /**
+     * @brief Value id of an input variable
+     * @throws std::runtime_error If the program has no such input
+     */
+    std::uint32_t input(const std::string& name) const;
+
+    std::uint32_t apply_and(std::uint32_t a, std::uint32_t b);
+    std::uint32_t apply_or(std::uint32_t a, std::uint32_t b);
+    std::uint32_t apply_xor(std::uint32_t a, std::uint32_t b);
+    std::uint32_t apply_not(std::uint32_t a);
+
+    /**
+     * @brief Bitwise if-then-else `f ? g : h`
+     */
+    std::uint32_t ite(std::uint32_t f, std::uint32_t g, std::uint32_t h);
+
+   private:
+    std::uint32_t emit(opcode op, std::uint32_t a, std::uint32_t b = 0, std::uint32_t c = 0);
+
+    std::vector<std::string> inputs_;
+    std::unordered_map<std::string, std::uint32_t> input_index_;
+    std::vector<instruction> code_;
+    std::uint32_t result_ = 0;
+};
+
+/**
+ * @brief Compiles an expression tree to a program
+ *
+ * Inputs are the expression's variables in ordered_variable_names() order
+ * (bit-vector fields contribute one input per bit). Cardinality constraints
+ * and field comparisons are compiled with the same layered counters and
+ * comparator chains as the BDD converters.
+ */
+program compile_expression(const my_expression& expr);
+
+/**
+ * @brief Compiles a TeDDy BDD to a program with one MUX per internal node
+ *
+ * @param diagram The BDD to compile
+ * @param variable_names Name of each TeDDy variable index
+ */
+program compile_teddy(teddy::bdd_manager::diagram_t diagram,
+                      const std::vector<std::string>& variable_names);
+
+/**
+ * @brief Compiles a CUDD BDD to a program with one MUX per internal node
+ *
+ * Complemented edges become NOT instructions.
+ *
+ * @param bdd The BDD to compile
+ * @param variable_names Name of each CUDD variable index
+ */
+program compile_cudd(const BDD& bdd, const std::vector<std::string>& variable_names);
+
+/**
+ * @brief Number of 64-bit words holding @p rows bits
+ */
+constexpr std::size_t words_for_rows(std::size_t rows) {
+    return (rows + 63) / 64;
+}
+
+/**
+ * @brief Columnar batch of assignments, one bitmap per variable
+ *
+ * Every column must hold words_for_rows(rows) words. Bits past `rows` in the
+ * last word are ignored.
+ */
+struct column_batch {
+    std::size_t rows = 0;
+    std::unordered_map<std::string, std::vector<std::uint64_t>> columns;
+};
+
+/**
+ * @brief Execution settings for evaluate()
+ */
+struct evaluate_options {
+    isa instruction_set = isa::automatic;  ///< Kernel selection
+    unsigned threads = 0;                  ///< Worker threads (0 = hardware concurrency)
+    std::size_t tile_words = 64;           ///< Words processed per instruction (multiple of 8)
+};
+
+/**
+ * @brief Evaluates a program on every row of a batch
+ *
+ * @param prog Compiled program
+ * @param batch Input columns; must contain a column for every program input
+ * @param options Instruction set, thread count and tile size
+ * @return Result bitmap of words_for_rows(batch.rows) words, unused bits zero
+ *
+ * @throws std::runtime_error If a column is missing or has the wrong size, the
+ *         requested instruction set is not supported, or the tile size is invalid
+ */
+std::vector<std::uint64_t> evaluate(const program& prog, const column_batch& batch,
+                                    const evaluate_options& options = {});
+
+}  // namespace batch_eval
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file bdd_bytecode.hpp
+ * @brief Compact bytecode for BDD filters, with a verifier and an interpreter
+ *
+ * A built TeDDy or CUDD diagram is compiled into a register-free bytecode that
+ * can be shipped to a running process and executed without the manager that
+ * built it. Each decision node becomes one test-and-jump instruction; the two
+ * terminals become return instructions at the end of the code.
+ *
+ * Instructions (all integers little-endian, offsets relative to the end of the
+ * instruction, so every jump goes forward):
+ * - `ret_false` (1 byte), `ret_true` (1 byte)
+ * - `test` (7 bytes): opcode, u16 variable, u16 false offset, u16 true offset
+ * - `test_wide` (13 bytes): opcode, u32 variable, u32 false offset, u32 true offset
+ *
+ * Nodes are laid out in depth-first order with parents before children, so the
+ * low child of a node usually follows it directly (offset 0) and a lookup walks
+ * forward through consecutive bytes.
+ *
+ * Because bytecode may come from an untrusted source, a program is verified
+ * once when it is created: every instruction must decode within the code,
+ * every jump must land on an instruction boundary, and every variable must be
+ * named. Forward-only jumps guarantee that evaluation terminates.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <libteddy/core.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+class BDD;
+
+namespace bdd_bytecode {
+
+/**
+ * @brief Instruction opcodes
+ */
+enum class opcode : std::uint8_t {
+    ret_false = 0,  ///< Return false
+    ret_true = 1,   ///< Return true
+    test = 2,       ///< Test a variable, 16-bit operands
+    test_wide = 3   ///< Test a variable, 32-bit operands
+};
+
+/**
+ * @brief Checks that bytecode is safe to execute
+ *
+ * @param code Instructions, starting with the entry instruction
+ * @param variable_count Number of variables an assignment provides
+ * @throws std::runtime_error Describing the first invalid instruction
+ */
+void verify(std::span<const std::uint8_t> code, std::size_t variable_count);
+
+/**
+ * @class program
+ * @brief Verified bytecode together with the names of its variables
+ */
+class program {
+   public:
+    /**
+     * @brief Creates a program from bytecode, verifying it first
+     *
+     * @param code Instructions, starting with the entry instruction
+     * @param variable_names Name of each variable index used by the code
+     * @throws std::runtime_error If the code does not verify
+     */
+    program(std::vector<std::uint8_t> code, std::vector<std::string> variable_names);
+
+    /**
+     * @brief Reads a program written by serialize(), verifying it
+     * @throws std::runtime_error If the bytes are not a valid program
+     */
+    static program deserialize(std::span<const std::uint8_t> bytes);
+
+    /**
+     * @brief Encodes the program for deployment
+     *
+     * Layout: magic "BDDBC001", u32 variable count, u32 code size, then for
+     * each variable a u32 length and its bytes, then the code.
+     */
+    std::vector<std::uint8_t> serialize() const;
+
+    const std::vector<std::uint8_t>& code() const {
+        return code_;
+    }
+
+    const std::vector<std::string>& variable_names() const {
+        return variable_names_;
+    }
+
+    /**
+     * @brief Human-readable listing, one instruction per line
+     */
+    std::string disassemble() const;
+
+    /**
+     * @brief Evaluates the program for one assignment
+     *
+     * @param assignment One byte per variable (0 = false, otherwise true)
+     * @throws std::runtime_error If the assignment has fewer values than variables
+     */
+    bool evaluate(std::span<const std::uint8_t> assignment) const;
+
+    /**
+     * @brief Evaluates the program for many assignments
+     *
+     * @param rows Row-major assignments, variable_names().size() bytes per row
+     * @param results One output byte per row (0 or 1)
+     * @throws std::runtime_error If the buffer sizes do not match
+     */
+    void evaluate_batch(std::span<const std::uint8_t> rows, std::span<std::uint8_t> results) const;
+
+   private:
+    std::vector<std::uint8_t> code_;           ///< Verified instructions
+    std::vector<std::string> variable_names_;  ///< Variable names by index
+};
+
+/**
+ * @brief Compiles a TeDDy BDD to bytecode
+ *
+ * @param diagram The diagram to compile
+ * @param variable_names Name of each TeDDy variable index
+ */
+program compile_teddy(teddy::bdd_manager::diagram_t diagram,
+                      const std::vector<std::string>& variable_names);
+
+/**
+ * @brief Compiles a CUDD BDD to bytecode
+ *
+ * Complemented edges are resolved during compilation, so a node reached both
+ * plainly and complemented yields two instructions.
+ *
+ * @param bdd The BDD to compile
+ * @param variable_names Name of each CUDD variable index
+ */
+program compile_cudd(const BDD& bdd, const std::vector<std::string>& variable_names);
+
+}  // namespace bdd_bytecode
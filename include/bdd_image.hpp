@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file bdd_image.hpp
+ * @brief Flat, immutable BDD images for fast lookup and cross-process sharing
+ *
+ * A built TeDDy or CUDD diagram is lowered into a contiguous array of 12-byte
+ * node records holding a variable index and two 32-bit child indices. The
+ * image no longer needs the manager that built it. Nodes are laid out level by
+ * level in breadth-first order, so a lookup only ever moves forward through the
+ * array and the top levels share a few cache lines.
+ *
+ * Images can be saved to a file and loaded with a read-only memory mapping, so
+ * any number of reader processes share one physical copy of each diagram.
+ *
+ * File layout (native byte order):
+ * - 32-byte header: magic "BDDIMG01", format version, node count, variable
+ *   count, root index, and the byte offset of the name table
+ * - node records, starting at offset 32
+ * - name table: for each variable a 32-bit length followed by its bytes
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <libteddy/core.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+class BDD;
+class Cudd;
+
+namespace bdd_image {
+
+/**
+ * @brief One node of a flat image
+ *
+ * Records 0 and 1 are the false and true terminals; their fields are unused.
+ */
+struct node_record {
+    std::uint32_t var;       ///< Variable index into image::variable_names()
+    std::uint32_t child[2];  ///< Record index of the low (0) and high (1) child
+};
+
+static_assert(sizeof(node_record) == 12, "node records must stay 12 bytes");
+
+/**
+ * @class image
+ * @brief Immutable flat BDD, either owned in memory or mapped from a file
+ */
+class image {
+   public:
+    static constexpr std::uint32_t false_index = 0;  ///< Record of the false terminal
+    static constexpr std::uint32_t true_index = 1;   ///< Record of the true terminal
+
+    image() = default;
+
+    /**
+     * @brief Creates an in-memory image from laid-out records
+     *
+     * @param records Node records, including the two terminal records
+     * @param root Index of the root record
+     * @param variable_names Name of each variable index used by the records
+     * @throws std::runtime_error If a record refers to an invalid child or variable
+     */
+    image(std::vector<node_record> records, std::uint32_t root,
+          std::vector<std::string> variable_names);
+
+    image(const image&) = delete;
+    image& operator=(const image&) = delete;
+    image(image&& other) noexcept;
+    image& operator=(image&& other) noexcept;
+    ~image();
+
+    /**
+     * @brief Maps an image file read-only
+     *
+     * The node records are used in place from the mapping; only the variable
+     * names are copied.
+     *
+     * @throws std::runtime_error If the file cannot be opened or is not a valid image
+     */
+    static image load(const std::string& path);
+
+    /**
+     * @brief Writes the image to a file
+     * @throws std::runtime_error If the file cannot be written
+     */
+    void save(const std::string& path) const;
+
+    std::span<const node_record> nodes() const {
+        return {nodes_, node_count_};
+    }
+
+    std::uint32_t root() const {
+        return root_;
+    }
+
+    const std::vector<std::string>& variable_names() const {
+        return variable_names_;
+    }
+
+    /**
+     * @brief Whether the records live in a read-only file mapping
+     */
+    bool is_mapped() const {
+        return mapping_ != nullptr;
+    }
+
+    /**
+     * @brief Evaluates the function for one assignment
+     *
+     * @param assignment One byte per variable (0 = false, otherwise true)
+     * @throws std::runtime_error If the assignment has fewer values than variables
+     */
+    bool evaluate(std::span<const std::uint8_t> assignment) const;
+
+    /**
+     * @brief Evaluates the function for many assignments
+     *
+     * Walks a group of rows in lockstep and prefetches the next record of each
+     * row, so the memory latency of one row overlaps the work on the others.
+     *
+     * @param rows Row-major assignments, variable_names().size() bytes per row
+     * @param results One output byte per row (0 or 1)
+     * @throws std::runtime_error If the buffer sizes do not match
+     */
+    void evaluate_batch(std::span<const std::uint8_t> rows, std::span<std::uint8_t> results) const;
+
+   private:
+    void validate() const;
+    void release();
+
+    std::vector<node_record> owned_;           ///< Records of an in-memory image
+    const node_record* nodes_ = nullptr;       ///< Records in use (owned or mapped)
+    std::size_t node_count_ = 0;               ///< Number of records
+    std::uint32_t root_ = false_index;         ///< Root record
+    std::vector<std::string> variable_names_;  ///< Variable names by index
+    void* mapping_ = nullptr;                  ///< Base of the file mapping, if any
+    std::size_t mapping_size_ = 0;             ///< Size of the file mapping
+};
+
+/**
+ * @brief Lowers a TeDDy BDD into a flat image
+ *
+ * @param manager Manager that built the diagram (used for variable levels)
+ * @param diagram The diagram to lower
+ * @param variable_names Name of each TeDDy variable index
+ */
+image compile_teddy(const teddy::bdd_manager& manager, teddy::bdd_manager::diagram_t diagram,
+                    const std::vector<std::string>& variable_names);
+
+/**
+ * @brief Lowers a CUDD BDD into a flat image
+ *
+ * Complemented edges are resolved during lowering, so a node reached both
+ * plainly and complemented yields two records.
+ *
+ * @param manager Manager that built the BDD (used for variable levels)
+ * @param bdd The BDD to lower
+ * @param variable_names Name of each CUDD variable index
+ */
+image compile_cudd(const Cudd& manager, const BDD& bdd,
+                   const std::vector<std::string>& variable_names);
+
+}  // namespace bdd_image
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file bdd_transfer.hpp
+ * @brief Direct copies of BDDs between TeDDy and CUDD managers
+ *
+ * Each copy is one memoized bottom-up pass (graph::postorder_fold) over
+ * teddy_view or cudd_view: every source node becomes ITE(variable, high copy,
+ * low copy) in the target. Nodes are matched by variable index, not by level,
+ * so the copy is the same function when the two managers order their
+ * variables differently. cudd_view expands complement edges, so a CUDD node
+ * reached in both phases is rebuilt once per phase.
+ *
+ * The cost depends on the target. When the orders agree, the variable of each
+ * ITE is above both copies, and CUDD's Ite makes that node with one
+ * unique-table lookup, so a copy into CUDD is linear in the size of the
+ * source. TeDDy has no public node constructor, and make_teddy_ite() walks
+ * both copies once per node, so a copy into TeDDy costs the sum of the sizes
+ * of the sub-diagrams below every source node: close to linear for wide,
+ * shallow diagrams, but quadratic in the size of the source for a chain of
+ * nodes. When the orders differ, each node is a general ITE in either library.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <span>
+
+#include <cudd/cudd.h>
+
+#include <cudd/cuddObj.hh>
+#include <libteddy/core.hpp>
+
+#include "cudd_view.hpp"
+#include "graph.hpp"
+#include "teddy_convert.hpp"
+#include "teddy_view.hpp"
+
+namespace bdd_transfer_detail {
+
+/**
+ * @brief Folds a TeDDy diagram bottom-up
+ *
+ * @param terminal `R(bool value)` for the terminal nodes
+ * @param node `R(int index, const R& low, const R& high)` for decision nodes
+ */
+template <class R, class Terminal, class Node>
+R fold_teddy(const teddy::bdd_manager::diagram_t& f, Terminal terminal, Node node) {
+    teddy_view view(nullptr, f);
+    return graph::postorder_fold<teddy_view, R>(
+        view, view.roots().front(),
+        [&](const teddy_view&, teddy_view::handle h, std::span<const R> children) {
+            if (h.p->is_terminal()) {
+                return terminal(h.p->get_value() != 0);
+            }
+            return node(h.p->get_index(), children[0], children[1]);
+        });
+}
+
+/**
+ * @brief Folds a CUDD BDD bottom-up, with complement edges expanded
+ *
+ * @param terminal `R(bool value)` for the constant in either phase
+ * @param node `R(int index, const R& low, const R& high)` for decision nodes
+ */
+template <class R, class Terminal, class Node>
+R fold_cudd(const Cudd& source, const BDD& f, Terminal terminal, Node node) {
+    cudd_view view(&source, f.getNode());
+    return graph::postorder_fold<cudd_view, R>(
+        view, view.roots().front(),
+        [&](const cudd_view&, cudd_view::handle h, std::span<const R> children) {
+            DdNode* regular = Cudd_Regular(h.p);
+            if (Cudd_IsConstant(regular)) {
+                return terminal(!Cudd_IsComplement(h.p));
+            }
+            return node(static_cast<int>(Cudd_NodeReadIndex(regular)), children[0],
+                        children[1]);
+        });
+}
+
+}  // namespace bdd_transfer_detail
+
+/**
+ * @brief Copies a TeDDy BDD into another TeDDy manager
+ *
+ * Costs the sum of the sizes of the sub-diagrams of @p f, up to quadratic in
+ * its size (see the file comment).
+ *
+ * @param f Diagram to copy (of any TeDDy BDD manager)
+ * @param target Manager with at least the variables of @p f
+ * @return The same function in @p target
+ */
+inline teddy::bdd_manager::diagram_t copy_teddy_bdd(const teddy::bdd_manager::diagram_t& f,
+                                                    teddy::bdd_manager& target) {
+    using bdd_t = teddy::bdd_manager::diagram_t;
+    auto ite = make_teddy_ite(target);
+    return bdd_transfer_detail::fold_teddy<bdd_t>(
+        f, [&](bool value) { return target.constant(value ? 1 : 0); },
+        [&](int index, const bdd_t& low, const bdd_t& high) {
+            return ite(target.variable(index), high, low);
+        });
+}
+
+/**
+ * @brief Copies a CUDD BDD into another CUDD manager
+ *
+ * @param source Manager owning @p f
+ * @param f BDD to copy
+ * @param target Manager of the copy
+ * @return The same function in @p target
+ */
+inline BDD copy_cudd_bdd(const Cudd& source, const BDD& f, const Cudd& target) {
+    return bdd_transfer_detail::fold_cudd<BDD>(
+        source, f, [&](bool value) { return value ? target.bddOne() : target.bddZero(); },
+        [&](int index, const BDD& low, const BDD& high) {
+            return target.bddVar(index).Ite(high, low);
+        });
+}
+
+/**
+ * @brief Copies a TeDDy BDD into a CUDD manager
+ *
+ * TeDDy variable i becomes CUDD variable i (`bddVar(i)`), the numbering used
+ * by convert_to_bdd() and convert_to_cudd_bdd(), whatever the level of the
+ * variable in either manager. Linear in the size of @p f when the orders
+ * agree.
+ *
+ * @param f Diagram to copy (of any TeDDy BDD manager)
+ * @param target Manager of the copy; missing variables are created
+ * @return The same function in @p target
+ */
+inline BDD copy_teddy_to_cudd(const teddy::bdd_manager::diagram_t& f, const Cudd& target) {
+    return bdd_transfer_detail::fold_teddy<BDD>(
+        f, [&](bool value) { return value ? target.bddOne() : target.bddZero(); },
+        [&](int index, const BDD& low, const BDD& high) {
+            return target.bddVar(index).Ite(high, low);
+        });
+}
+
+/**
+ * @brief Copies a CUDD BDD into a TeDDy manager
+ *
+ * CUDD variable i becomes TeDDy variable i. TeDDy has no complement edges,
+ * so complemented CUDD edges are expanded: each phase of a node is built as
+ * a node of its own. Like copy_teddy_bdd(), the copy is up to quadratic in
+ * the size of @p f.
+ *
+ * @param source Manager owning @p f
+ * @param f BDD to copy
+ * @param target Manager with at least as many variables as the support of @p f uses
+ * @return The same function in @p target
+ */
+inline teddy::bdd_manager::diagram_t copy_cudd_to_teddy(const Cudd& source, const BDD& f,
+                                                        teddy::bdd_manager& target) {
+    using bdd_t = teddy::bdd_manager::diagram_t;
+    auto ite = make_teddy_ite(target);
+    return bdd_transfer_detail::fold_cudd<bdd_t>(
+        source, f, [&](bool value) { return target.constant(value ? 1 : 0); },
+        [&](int index, const bdd_t& low, const bdd_t& high) {
+            return ite(target.variable(index), high, low);
+        });
+}
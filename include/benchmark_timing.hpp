@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file benchmark_timing.hpp
+ * @brief Timing helper shared by the benchmark programs
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+namespace benchmark_timing {
+
+/**
+ * @brief Runs @p work `repeat` times and returns the best time in seconds
+ */
+inline double best_time(int repeat, const std::function<void()>& work) {
+    double best = 0.0;
+    for (int r = 0; r < repeat; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (r == 0 || elapsed.count() < best) {
+            best = elapsed.count();
+        }
+    }
+    return best;
+}
+
+}  // namespace benchmark_timing
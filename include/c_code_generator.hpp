@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file c_code_generator.hpp
+ * @brief Generic template for generating C evaluator functions from BDD structures
+ *
+ * Emits a self-contained C translation unit (also valid C++) that evaluates a
+ * BDD without any library support:
+ *
+ * - `int <name>(const uint64_t* bits)` walks the diagram with branches. The
+ *   default style is a goto-based decision graph in which every internal node
+ *   is a label, so shared nodes are emitted once. The nested style expands the
+ *   diagram into if/else blocks, which suits small or tree-shaped diagrams.
+ * - `void <name>_batch(const uint64_t* const* columns, uint64_t* out, size_t words)`
+ *   is branch-free: every node becomes one bitwise multiplexer over 64-bit words,
+ *   so each call evaluates 64 assignments per word.
+ *
+ * Inputs are packed bit arrays indexed by the position of each variable in the
+ * supplied name list: the scalar function reads variable i from bit (i % 64) of
+ * `bits[i / 64]`, and the batch function reads it from column `columns[i]`.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dag_walker.hpp"
+#include "node_table_generator.hpp"
+
+namespace c_code {
+
+/**
+ * @brief Control flow used by the scalar evaluator
+ */
+enum class BranchStyle {
+    goto_graph,  ///< One label per internal node; shared nodes are emitted once
+    nested       ///< Nested if/else blocks; shared nodes are duplicated
+};
+
+/**
+ * @brief Configuration for C code output
+ */
+struct CCodeConfig {
+    std::string function_name = "bdd_eval";             ///< Scalar function name (C identifier)
+    BranchStyle branch_style = BranchStyle::goto_graph;  ///< Scalar control flow
+    bool emit_batch = true;  ///< Also emit the branch-free `<name>_batch` function
+    std::size_t max_nested_nodes = 100'000;  ///< Expanded size limit for the nested style
+};
+
+/**
+ * @brief Generate a C evaluator for a BDD
+ *
+ * @tparam Iterator Type that satisfies the NodeTableIterator concept
+ * @param root_iterator Iterator positioned at the root of the BDD
+ * @param variable_names Variables in input bit order; every decision variable must appear
+ * @param out Output stream to write the C source to
+ * @param config Function name and code style options
+ * @throws std::runtime_error If the function name is not a C identifier, a node has
+ *         an unknown variable or not two children, or the nested expansion is too large
+ */
+template <node_table::NodeTableIterator Iterator>
+void generate_c_code(const Iterator& root_iterator, const std::vector<std::string>& variable_names,
+                     std::ostream& out, const CCodeConfig& config = CCodeConfig()) {
+    const std::string& name = config.function_name;
+    bool valid_name = !name.empty() && !(name[0] >= '0' && name[0] <= '9');
+    for (char c : name) {
+        bool alnum = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        valid_name = valid_name && (alnum || c == '_');
+    }
+    if (!valid_name) {
+        throw std::runtime_error("Invalid C function name: '" + name + "'");
+    }
+
+    std::unordered_map<std::string, std::size_t> variable_index;
+    for (std::size_t i = 0; i < variable_names.size(); ++i) {
+        variable_index.emplace(variable_names[i], i);
+    }
+
+    // Parents before children
+    auto [nodes, edges] = dag_walker::collect_nodes_and_edges_topological(root_iterator);
+    (void)edges;
+    std::reverse(nodes.begin(), nodes.end());
+
+    // Per node: variable index, child node positions, or the terminal value
+    struct node_info {
+        bool terminal = false;
+        int value = 0;
+        std::size_t var = 0;
+        std::size_t low = 0;
+        std::size_t high = 0;
+    };
+    std::unordered_map<const void*, std::size_t> position;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        position.emplace(nodes[i].get_node_address(), i);
+    }
+    std::vector<node_info> info(nodes.size());
+    std::vector<std::size_t> internal;  // Positions of decision nodes, parents first
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].is_terminal()) {
+            info[i].terminal = true;
+            info[i].value = nodes[i].get_terminal_value() != 0 ? 1 : 0;
+            continue;
+        }
+        auto var_it = variable_index.find(nodes[i].get_variable_name());
+        if (var_it == variable_index.end()) {
+            throw std::runtime_error("Unknown variable in BDD: '" + nodes[i].get_variable_name()
+                                     + "'");
+        }
+        auto children = nodes[i].get_children();
+        if (children.size() != 2) {
+            throw std::runtime_error("C code generation requires two children per node");
+        }
+        info[i].var = var_it->second;
+        info[i].low = position.at(children[0].get_node_address());
+        info[i].high = position.at(children[1].get_node_address());
+        internal.push_back(i);
+    }
+
+    // Header comment with the input layout
+    out << "/*\n";
+    out << std::format(" * Evaluator for a BDD with {} decision nodes over {} variables.\n",
+                       internal.size(), variable_names.size());
+    out << " * Generated code; regenerate instead of editing.\n";
+    out << " *\n";
+    out << " * Variable i is bit (i % 64) of bits[i / 64] for " << name << ",\n";
+    out << " * and column i (64 assignments per word) for " << name << "_batch.\n";
+    out << " *\n";
+    out << " * Variables:\n";
+    for (std::size_t i = 0; i < variable_names.size(); ++i) {
+        std::string label = variable_names[i];
+        for (auto pos = label.find("*/"); pos != std::string::npos; pos = label.find("*/")) {
+            label.replace(pos, 2, "* /");  // Keep the comment closed
+        }
+        out << std::format(" *   {}: {}\n", i, label);
+    }
+    out << " */\n\n";
+    out << "#include <stddef.h>\n";
+    out << "#include <stdint.h>\n\n";
+
+    auto bit_test = [&](std::size_t var) {
+        return std::format("(bits[{}] >> {}) & 1u", var / 64, var % 64);
+    };
+
+    // Scalar evaluator
+    out << "int " << name << "(const uint64_t* bits) {\n";
+    if (nodes.empty() || info[0].terminal) {
+        out << "    (void)bits;\n";
+        out << "    return " << (nodes.empty() ? 0 : info[0].value) << ";\n";
+    } else if (config.branch_style == BranchStyle::goto_graph) {
+        // Jump to a node: terminals return directly
+        auto jump = [&](std::size_t target) {
+            return info[target].terminal ? std::format("return {};", info[target].value)
+                                         : std::format("goto n{};", target);
+        };
+        // Fall through when a child is emitted right after its parent, and only
+        // label nodes that are reached by a goto
+        auto next_of = [&](std::size_t k) {
+            return k + 1 < internal.size() ? internal[k + 1] : nodes.size();
+        };
+        std::vector<bool> labelled(nodes.size(), false);
+        for (std::size_t k = 0; k < internal.size(); ++k) {
+            const auto& node = info[internal[k]];
+            const std::size_t next = next_of(k);
+            if (node.high != next) {
+                labelled[node.high] = true;
+            }
+            if (node.low != next) {
+                labelled[node.low] = true;
+            }
+        }
+        for (std::size_t k = 0; k < internal.size(); ++k) {
+            const std::size_t i = internal[k];
+            const auto& node = info[i];
+            if (labelled[i]) {
+                out << "n" << i << ":\n";
+            }
+            const std::size_t next = next_of(k);
+            if (node.high == next) {
+                out << "    if (!(" << bit_test(node.var) << ")) " << jump(node.low) << "\n";
+            } else if (node.low == next) {
+                out << "    if (" << bit_test(node.var) << ") " << jump(node.high) << "\n";
+            } else {
+                out << "    if (" << bit_test(node.var) << ") " << jump(node.high) << "\n";
+                out << "    " << jump(node.low) << "\n";
+            }
+        }
+    } else {
+        // Size of the expanded decision tree, saturated at the limit
+        std::vector<std::size_t> tree_size(nodes.size(), 0);
+        for (std::size_t i = nodes.size(); i-- > 0;) {
+            if (!info[i].terminal) {
+                tree_size[i] = std::min(config.max_nested_nodes + 1,
+                                        1 + tree_size[info[i].low] + tree_size[info[i].high]);
+            }
+        }
+        if (tree_size[0] > config.max_nested_nodes) {
+            throw std::runtime_error(
+                std::format("Nested C code would expand to more than {} nodes; use the goto "
+                            "style",
+                            config.max_nested_nodes));
+        }
+
+        auto emit = [&](auto& self, std::size_t index, std::size_t depth) -> void {
+            std::string indent(4 * depth, ' ');
+            const auto& node = info[index];
+            if (node.terminal) {
+                out << indent << "return " << node.value << ";\n";
+                return;
+            }
+            out << indent << "if (" << bit_test(node.var) << ") {\n";
+            self(self, node.high, depth + 1);
+            out << indent << "} else {\n";
+            self(self, node.low, depth + 1);
+            out << indent << "}\n";
+        };
+        emit(emit, 0, 1);
+    }
+    out << "}\n";
+
+    if (!config.emit_batch) {
+        return;
+    }
+
+    // Branch-free batch evaluator, children computed before parents
+    auto word = [&](std::size_t index) {
+        if (info[index].terminal) {
+            return std::string(info[index].value != 0 ? "~UINT64_C(0)" : "UINT64_C(0)");
+        }
+        return std::format("n{}", index);
+    };
+
+    out << "\nvoid " << name
+        << "_batch(const uint64_t* const* columns, uint64_t* out, size_t words) {\n";
+    if (nodes.empty() || info[0].terminal) {
+        out << "    (void)columns;\n";
+    }
+    out << "    for (size_t w = 0; w < words; ++w) {\n";
+    std::vector<bool> used(variable_names.size(), false);
+    for (auto i : internal) {
+        used[info[i].var] = true;
+    }
+    for (std::size_t v = 0; v < used.size(); ++v) {
+        if (used[v]) {
+            out << std::format("        const uint64_t v{} = columns[{}][w];\n", v, v);
+        }
+    }
+    for (auto it = internal.rbegin(); it != internal.rend(); ++it) {
+        const std::size_t i = *it;
+        const auto& node = info[i];
+        const auto& low = info[node.low];
+        const auto& high = info[node.high];
+        std::string v = std::format("v{}", node.var);
+        std::string expr;
+        if (high.terminal && low.terminal) {
+            // Reduced diagrams never have equal terminal children
+            expr = high.value != 0 ? v : "~" + v;
+        } else if (high.terminal) {
+            expr = high.value != 0 ? std::format("{} | {}", v, word(node.low))
+                                   : std::format("~{} & {}", v, word(node.low));
+        } else if (low.terminal) {
+            expr = low.value != 0 ? std::format("~{} | {}", v, word(node.high))
+                                  : std::format("{} & {}", v, word(node.high));
+        } else {
+            expr = std::format("({} & {}) | (~{} & {})", v, word(node.high), v, word(node.low));
+        }
+        out << std::format("        const uint64_t n{} = {};\n", i, expr);
+    }
+    out << "        out[w] = " << (nodes.empty() ? "UINT64_C(0)" : word(0)) << ";\n";
+    out << "    }\n";
+    out << "}\n";
+}
+
+}  // namespace c_code
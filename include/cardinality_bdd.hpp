@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file cardinality_bdd.hpp
+ * @brief Library-independent construction of cardinality constraints as layered BDDs
+ *
+ * A cardinality constraint over n operands is built as a counter with one
+ * layer per operand and at most k + 2 states per layer (counts above k
+ * behave identically for every constraint kind). Layers are built bottom-up
+ * with a single if-then-else per state, so when the operands are literals
+ * sorted by level every ITE only places a variable above already-built
+ * sub-diagrams and the result has O(n * k) nodes.
+ *
+ * The build cost depends on the ITE, and the O(n * k) build time only holds
+ * for CUDD, where each ITE is a unique-table lookup. TeDDy's ITE
+ * (make_teddy_ite()) is three applies that walk the layers below, so there
+ * the build is O(n^2 * k^2) apply steps in the worst case; the result still
+ * has O(n * k) nodes.
+ *
+ * The builder is templated on the diagram type and takes the ITE operation as
+ * a callable so that the TeDDy and CUDD converters can share it.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "expression_types.hpp"
+
+namespace cardinality_bdd {
+
+/**
+ * @brief Level of a literal operand, or -1 for any other expression
+ *
+ * Literals are variables and negated variables. Their level is used to
+ * order the layers so each ITE introduces a variable above the sub-diagrams
+ * it combines.
+ *
+ * @tparam LevelOf Callable mapping a variable name to its current level
+ * @param operand The operand expression
+ * @param level_of Level lookup for variable names
+ * @return The level of the literal's variable, or -1 if not a literal
+ */
+template <typename LevelOf>
+int operand_level(const my_expression& operand, LevelOf&& level_of) {
+    if (const auto* var = std::get_if<my_variable>(&operand)) {
+        return level_of(var->variable_name);
+    }
+    if (const auto* neg = std::get_if<my_not>(&operand)) {
+        if (neg->expr) {
+            if (const auto* inner = std::get_if<my_variable>(neg->expr.get())) {
+                return level_of(inner->variable_name);
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Builds a cardinality constraint from its operand diagrams
+ *
+ * @tparam Diagram Diagram handle type of the target library
+ * @tparam Ite Callable `Diagram(const Diagram& f, const Diagram& g, const Diagram& h)`
+ * @param node The cardinality constraint (kind and bound)
+ * @param operands Operand diagrams paired with their level from operand_level()
+ * @param zero Constant false diagram
+ * @param one Constant true diagram
+ * @param ite If-then-else operation of the target library
+ * @return Diagram that is true iff the number of true operands satisfies @p node
+ */
+template <typename Diagram, typename Ite>
+Diagram build(const my_cardinality& node, std::vector<std::pair<int, Diagram>> operands,
+              const Diagram& zero, const Diagram& one, Ite&& ite) {
+    // Deepest literals go last so that they are placed first by the bottom-up pass;
+    // non-literal operands (level -1) end up at the top.
+    std::stable_sort(operands.begin(), operands.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    const size_t n = operands.size();
+    const size_t cap = std::min(node.k + 1, n);  // Saturating count
+
+    // layer[c]: function of the remaining operands given c operands were already true
+    std::vector<Diagram> layer;
+    layer.reserve(cap + 1);
+    for (size_t c = 0; c <= cap; ++c) {
+        layer.push_back(node.accepts(c) ? one : zero);
+    }
+
+    for (size_t i = n; i-- > 0;) {
+        // Only counts 0..i are reachable before operand i is examined
+        const size_t reachable = std::min(i, cap);
+        std::vector<Diagram> next;
+        next.reserve(reachable + 1);
+        for (size_t c = 0; c <= reachable; ++c) {
+            next.push_back(ite(operands[i].second, layer[std::min(c + 1, cap)], layer[c]));
+        }
+        layer = std::move(next);
+    }
+
+    return layer[0];
+}
+
+}  // namespace cardinality_bdd
@@ -0,0 +1,321 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file conjunctive_partition.hpp
+ * @brief Conjunctively partitioned CUDD BDDs for large constraint sets
+ *
+ * The monolithic BDD of a conjunction of constraints, such as the N-Queens
+ * files, is often far larger than all of its conjuncts together. A
+ * conjunctive_partition keeps the top-level conjuncts of the expression as
+ * a list of separate BDDs in one Cudd manager and only answers questions on
+ * that list:
+ *
+ * - Evaluation walks one path per partition and stops at the first that
+ *   is false.
+ * - Satisfiability conjoins the partitions one at a time and existentially
+ *   quantifies each variable as soon as no later partition depends on it
+ *   (early quantification with AndAbstract), so the intermediate BDDs only
+ *   hold the variables shared with the partitions still to come.
+ * - The monolithic BDD is conjoined on demand, once, for the callers that
+ *   need it (counting, enumeration and the graph outputs).
+ *
+ * Conjuncts are ordered by the deepest variable they depend on and merged
+ * greedily: neighbours are conjoined while the result stays within a node
+ * threshold, which trades fewer, larger partitions for less work per query.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <cudd/cudd.h>
+
+#include <cudd/cuddObj.hh>
+
+#include "conversion_limits.hpp"
+#include "cudd_convert.hpp"
+#include "expression_types.hpp"
+#include "partitioned_convert.hpp"
+
+namespace conjunctive_partition_detail {
+
+/**
+ * @brief Indices of the variables a BDD depends on, in increasing order
+ */
+inline std::vector<int> support_indices(const BDD& f) {
+    std::vector<int> indices;
+    std::unordered_set<DdNode*> visited;
+    std::vector<DdNode*> pending = {Cudd_Regular(f.getNode())};
+    while (!pending.empty()) {
+        DdNode* node = pending.back();
+        pending.pop_back();
+        if (Cudd_IsConstant(node) || !visited.insert(node).second) {
+            continue;
+        }
+        indices.push_back(static_cast<int>(Cudd_NodeReadIndex(node)));
+        pending.push_back(Cudd_Regular(Cudd_T(node)));
+        pending.push_back(Cudd_Regular(Cudd_E(node)));
+    }
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    return indices;
+}
+
+/**
+ * @brief Value of a BDD under a complete assignment, following one path
+ */
+inline bool evaluate(const BDD& f, std::span<const std::uint8_t> assignment) {
+    DdNode* node = f.getNode();
+    while (!Cudd_IsConstant(Cudd_Regular(node))) {
+        DdNode* regular = Cudd_Regular(node);
+        const unsigned int index = Cudd_NodeReadIndex(regular);
+        if (index >= assignment.size()) {
+            throw std::runtime_error(
+                std::format("Assignment has no value for variable {}", index));
+        }
+        DdNode* next = assignment[index] != 0 ? Cudd_T(regular) : Cudd_E(regular);
+        node = Cudd_NotCond(next, Cudd_IsComplement(node));
+    }
+    return !Cudd_IsComplement(node);
+}
+
+}  // namespace conjunctive_partition_detail
+
+/**
+ * @class conjunctive_partition
+ * @brief A CUDD BDD kept as the conjunction of a list of smaller BDDs
+ *
+ * The partitions belong to the manager passed at construction, which must
+ * outlive the partition.
+ */
+class conjunctive_partition {
+   public:
+    /// Default node threshold for merging conjuncts (see the constructor)
+    static constexpr std::size_t default_cluster_size = 1000;
+
+    /**
+     * @brief What a satisfiability check did
+     */
+    struct quantify_stats {
+        std::size_t steps = 0;       ///< Partitions conjoined before the answer was known
+        std::size_t quantified = 0;  ///< Variables quantified away
+        std::size_t peak_nodes = 0;  ///< Largest intermediate BDD
+    };
+
+    /**
+     * @brief Orders and clusters a list of conjuncts
+     *
+     * Constant-true conjuncts are dropped and a constant-false conjunct
+     * replaces the whole list. The others are sorted by their deepest
+     * variable, then each is conjoined into the current cluster if the
+     * result has at most @p cluster_size nodes, and starts a new cluster
+     * otherwise. A conjunct larger than the threshold stays a partition of
+     * its own.
+     *
+     * @param mgr Manager owning every conjunct
+     * @param conjuncts BDDs whose conjunction is represented
+     * @param cluster_size Node threshold for a merged partition (0 = never merge)
+     */
+    conjunctive_partition(const Cudd& mgr, std::vector<BDD> conjuncts,
+                          std::size_t cluster_size = default_cluster_size)
+        : mgr_(&mgr), conjuncts_(conjuncts.size()) {
+        using conjunctive_partition_detail::support_indices;
+
+        std::vector<std::pair<int, BDD>> ordered;
+        for (BDD& f : conjuncts) {
+            if (f.IsZero()) {
+                parts_ = {f};
+                return;
+            }
+            if (!f.IsOne()) {
+                const auto support = support_indices(f);
+                ordered.emplace_back(support.back(), std::move(f));
+            }
+        }
+        std::stable_sort(ordered.begin(), ordered.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (auto& [deepest, f] : ordered) {
+            if (!parts_.empty() && cluster_size != 0) {
+                BDD merged = parts_.back() & f;
+                if (static_cast<std::size_t>(merged.nodeCount()) <= cluster_size) {
+                    parts_.back() = merged;
+                    continue;
+                }
+            }
+            parts_.push_back(std::move(f));
+        }
+        if (parts_.empty()) {
+            parts_.push_back(mgr.bddOne());
+        }
+    }
+
+    /**
+     * @brief Converts each operand of the top-level AND chain of @p expr and clusters them
+     *
+     * An expression that is not an AND is a single conjunct.
+     *
+     * @param expr The root expression
+     * @param mgr Manager that owns the partitions
+     * @param var_map Variable index of every name used by @p expr
+     * @param cluster_size Node threshold for a merged partition (0 = never merge)
+     * @param budget Limits to enforce while converting each conjunct, or nullptr
+     * @return The clustered partition of @p expr
+     * @throws conversion_aborted If a limit of @p budget is exceeded
+     */
+    static conjunctive_partition build(const my_expression& expr, const Cudd& mgr,
+                                       const std::unordered_map<std::string, int>& var_map,
+                                       std::size_t cluster_size = default_cluster_size,
+                                       conversion_budget* budget = nullptr) {
+        const auto operands = partitioned_convert_detail::chain_operands<my_and>(expr);
+        std::vector<BDD> conjuncts;
+        conjuncts.reserve(operands.size());
+        for (const my_expression* operand : operands) {
+            conjuncts.push_back(convert_to_cudd_bdd_with_map(*operand, mgr, var_map, budget));
+        }
+        return conjunctive_partition(mgr, std::move(conjuncts), cluster_size);
+    }
+
+    /// Partitions in the order they are conjoined
+    const std::vector<BDD>& parts() const {
+        return parts_;
+    }
+
+    /// Number of conjuncts before clustering
+    std::size_t conjuncts() const {
+        return conjuncts_;
+    }
+
+    /// Node count of each partition
+    std::vector<std::size_t> part_sizes() const {
+        std::vector<std::size_t> sizes;
+        sizes.reserve(parts_.size());
+        for (const BDD& part : parts_) {
+            sizes.push_back(static_cast<std::size_t>(part.nodeCount()));
+        }
+        return sizes;
+    }
+
+    /**
+     * @brief Value of the conjunction under a complete assignment
+     *
+     * @param assignment Value (0 or 1) of every variable, by index
+     * @throws std::runtime_error If a partition tests a variable beyond the assignment
+     */
+    bool evaluate(std::span<const std::uint8_t> assignment) const {
+        return std::all_of(parts_.begin(), parts_.end(), [&](const BDD& part) {
+            return conjunctive_partition_detail::evaluate(part, assignment);
+        });
+    }
+
+    /**
+     * @brief Whether some assignment satisfies every partition
+     *
+     * Conjoins the partitions in order with AndAbstract, quantifying each
+     * variable at the last partition that depends on it, and stops as soon
+     * as the intermediate result is false.
+     *
+     * @param stats Receives the number of steps, quantified variables and the peak size
+     */
+    bool is_satisfiable(quantify_stats* stats = nullptr) const {
+        using conjunctive_partition_detail::support_indices;
+
+        std::vector<std::vector<int>> supports;
+        std::unordered_map<int, std::size_t> last_use;
+        for (std::size_t i = 0; i < parts_.size(); ++i) {
+            supports.push_back(support_indices(parts_[i]));
+            for (int index : supports.back()) {
+                last_use[index] = i;
+            }
+        }
+
+        quantify_stats local;
+        BDD product = mgr_->bddOne();
+        for (std::size_t i = 0; i < parts_.size(); ++i) {
+            BDD cube = mgr_->bddOne();
+            for (int index : supports[i]) {
+                if (last_use.at(index) == i) {
+                    cube &= mgr_->bddVar(index);
+                    ++local.quantified;
+                }
+            }
+            product = product.AndAbstract(parts_[i], cube);
+            ++local.steps;
+            local.peak_nodes =
+                std::max(local.peak_nodes, static_cast<std::size_t>(product.nodeCount()));
+            if (product.IsZero()) {
+                break;
+            }
+        }
+        if (stats != nullptr) {
+            *stats = local;
+        }
+        return !product.IsZero();
+    }
+
+    /**
+     * @brief The monolithic BDD, conjoined on the first call
+     *
+     * With a @p budget the limits are installed on the manager for the
+     * duration of the conjunction (see cudd_convert_detail::limit_guard)
+     * and checked after every partition.
+     *
+     * @param budget Limits to enforce, or nullptr
+     * @throws conversion_aborted If a limit of @p budget is exceeded
+     */
+    const BDD& conjunction(conversion_budget* budget = nullptr) const {
+        if (conjunction_) {
+            return *conjunction_;
+        }
+        const std::string what = std::format("conjunction of {} partitions", parts_.size());
+        std::optional<cudd_convert_detail::limit_guard> guard;
+        if (budget != nullptr) {
+            guard.emplace(*mgr_, budget->limits());
+        }
+
+        BDD product = parts_.front();
+        for (std::size_t i = 1; i < parts_.size(); ++i) {
+            std::string reason;
+            try {
+                product &= parts_[i];
+            } catch (const std::logic_error&) {
+                reason = guard ? guard->reason(*budget) : "CUDD operation failed";
+            }
+            if (budget != nullptr) {
+                budget->note_peak(static_cast<std::size_t>(mgr_->ReadPeakNodeCount()));
+                if (reason.empty()) {
+                    reason = budget->exceeded(static_cast<std::size_t>(mgr_->ReadKeys()));
+                }
+            }
+            if (!reason.empty()) {
+                throw conversion_aborted(reason, what,
+                                         budget != nullptr ? budget->peak_nodes() : 0,
+                                         budget != nullptr ? budget->elapsed_seconds() : 0.0);
+            }
+        }
+        conjunction_ = product;
+        return *conjunction_;
+    }
+
+   private:
+    const Cudd* mgr_;
+    std::vector<BDD> parts_;
+    std::size_t conjuncts_;
+    mutable std::optional<BDD> conjunction_;
+};
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file conversion_limits.hpp
+ * @brief Node, memory and time budgets for expression to BDD conversion
+ *
+ * A conversion_budget is passed to convert_to_bdd() or convert_to_cudd_bdd().
+ * The converters report the size of their manager after every expression
+ * node they build; when a limit is exceeded the conversion stops with a
+ * conversion_aborted exception that names the sub-expression being built,
+ * the peak size reached and the time used. CUDD additionally enforces the
+ * limits inside its operations (see cudd_convert.hpp).
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "expression_graph.hpp"
+#include "expression_types.hpp"
+
+/**
+ * @brief Limits for one conversion; zero means unlimited
+ */
+struct conversion_limits {
+    std::size_t max_nodes = 0;             ///< Nodes in the manager, including garbage
+    std::size_t max_memory = 0;            ///< Bytes used by the manager
+    std::chrono::milliseconds timeout{0};  ///< Wall-clock time of the conversion
+
+    bool unlimited() const {
+        return max_nodes == 0 && max_memory == 0 && timeout.count() == 0;
+    }
+};
+
+/**
+ * @class conversion_aborted
+ * @brief Thrown when a conversion exceeds one of its limits
+ */
+class conversion_aborted : public std::runtime_error {
+   public:
+    conversion_aborted(const std::string& reason, std::string subexpression,
+                       std::size_t peak_nodes, double seconds)
+        : std::runtime_error(reason),
+          subexpression_(std::move(subexpression)),
+          peak_nodes_(peak_nodes),
+          seconds_(seconds) {}
+
+    /// Text of the expression node whose operation hit the limit (shortened)
+    const std::string& subexpression() const {
+        return subexpression_;
+    }
+
+    /// Largest manager size seen during the conversion
+    std::size_t peak_nodes() const {
+        return peak_nodes_;
+    }
+
+    /// Time from the start of the conversion to the abort
+    double seconds() const {
+        return seconds_;
+    }
+
+   private:
+    std::string subexpression_;
+    std::size_t peak_nodes_;
+    double seconds_;
+};
+
+/**
+ * @class conversion_budget
+ * @brief Tracks the limits, peak size and elapsed time of one conversion
+ */
+class conversion_budget {
+   public:
+    /// Longest sub-expression text kept in a conversion_aborted report
+    static constexpr std::size_t max_report_length = 120;
+
+    /**
+     * @param limits Limits to enforce; the clock starts now
+     * @param bytes_per_node Estimated memory per node, used for the memory
+     *        limit (0 if the library enforces that limit itself)
+     */
+    explicit conversion_budget(const conversion_limits& limits, std::size_t bytes_per_node = 0)
+        : limits_(limits),
+          bytes_per_node_(bytes_per_node),
+          start_(std::chrono::steady_clock::now()) {}
+
+    const conversion_limits& limits() const {
+        return limits_;
+    }
+
+    std::size_t peak_nodes() const {
+        return peak_nodes_;
+    }
+
+    double elapsed_seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    /// Raises the recorded peak (for libraries that track their own)
+    void note_peak(std::size_t nodes) {
+        peak_nodes_ = std::max(peak_nodes_, nodes);
+    }
+
+    /**
+     * @brief Describes the limit a manager of @p nodes nodes exceeds
+     * @return Empty if all limits hold
+     */
+    std::string exceeded(std::size_t nodes) const {
+        if (limits_.max_nodes != 0 && nodes > limits_.max_nodes) {
+            return std::format("node limit of {} exceeded ({} nodes)", limits_.max_nodes, nodes);
+        }
+        if (limits_.max_memory != 0 && bytes_per_node_ != 0
+            && nodes * bytes_per_node_ > limits_.max_memory) {
+            return memory_reason();
+        }
+        if (limits_.timeout.count() != 0
+            && std::chrono::steady_clock::now() - start_ > limits_.timeout) {
+            return timeout_reason();
+        }
+        return {};
+    }
+
+    /**
+     * @brief Records the manager size after building @p expr and enforces the limits
+     *
+     * When the node or memory limit is exceeded, @p reclaim is called once to
+     * collect garbage and return the size afterwards; the conversion aborts
+     * only if a limit is still exceeded then.
+     *
+     * @param expr Expression node just built
+     * @param nodes Current manager size
+     * @param reclaim `std::size_t()` collecting garbage
+     * @throws conversion_aborted If a limit is exceeded after collection
+     */
+    template <class Reclaim>
+    void check(const my_expression& expr, std::size_t nodes, Reclaim&& reclaim) {
+        note_peak(nodes);
+        std::string reason = exceeded(nodes);
+        if (reason.empty()) {
+            return;
+        }
+        if (reason != timeout_reason()) {
+            reason = exceeded(reclaim());
+        }
+        if (!reason.empty()) {
+            abort(expr, reason);
+        }
+    }
+
+    /**
+     * @brief Enforces the limits without a way to collect garbage
+     * @throws conversion_aborted If a limit is exceeded
+     */
+    void check(const my_expression& expr, std::size_t nodes) {
+        check(expr, nodes, [nodes] { return nodes; });
+    }
+
+    /**
+     * @brief Stops the conversion while @p expr was being built
+     * @throws conversion_aborted Always
+     */
+    [[noreturn]] void abort(const my_expression& expr, const std::string& reason) const {
+        throw conversion_aborted(reason, expression_to_string(expr, max_report_length),
+                                 peak_nodes_, elapsed_seconds());
+    }
+
+    std::string memory_reason() const {
+        return std::format("memory limit of {} bytes exceeded", limits_.max_memory);
+    }
+
+    std::string timeout_reason() const {
+        return std::format("time limit of {} ms exceeded", limits_.timeout.count());
+    }
+
+   private:
+    conversion_limits limits_;
+    std::size_t bytes_per_node_;
+    std::chrono::steady_clock::time_point start_;
+    std::size_t peak_nodes_ = 0;
+};
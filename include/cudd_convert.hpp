@@ -27,6 +27,7 @@
 #include <iostream>
 #include <libteddy/core.hpp>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <sstream>
 #include <stack>
@@ -41,65 +42,180 @@
 
 #include <cudd/cuddObj.hh>
 
+#include "cardinality_bdd.hpp"
+#include "conversion_limits.hpp"
 #include "cudd_graph.hpp"
 #include "dag_walker.hpp"
 #include "expression_adapter.hpp"
 #include "expression_graph.hpp"
 #include "expression_parser.hpp"
+#include "field_compare_bdd.hpp"
+#include "manager_sizing.hpp"
 #include "node_table_generator.hpp"
 #include "teddy_graph.hpp"
 
+namespace cudd_convert_detail {
+
 /**
- * @brief Convert expression to CUDD BDD format for comparison
- *
- * This function converts a parsed expression to CUDD BDD format using the CUDD library.
- * CUDD (Colorado University Decision Diagram) is a mature BDD library that provides
- * efficient BDD operations and automatic variable reordering. This function is used
- * for comparing BDD implementations.
+ * @brief Installs the limits of a conversion_budget on a CUDD manager while alive
  *
- * @param expr The expression to convert
- * @param variable_names The set of variable names used in the expression
- * @return Pair containing the CUDD manager and the root BDD
+ * The memory and time limits map to CUDD's own (SetMaxMemory, SetTimeLimit);
+ * the node limit is a termination callback on the unique-table size, so all
+ * three interrupt CUDD inside an operation. CUDD's C++ wrapper then throws
+ * std::logic_error, which the converter turns into conversion_aborted.
  */
-inline std::pair<std::unique_ptr<Cudd>, BDD> convert_to_cudd_bdd(
-    const my_expression& expr, const std::unordered_set<std::string>& variable_names) {
-    // Create CUDD manager
-    auto cudd_mgr = std::make_unique<Cudd>();
+class limit_guard {
+   public:
+    limit_guard(const Cudd& mgr, const conversion_limits& limits)
+        : mgr_(mgr),
+          max_nodes_(limits.max_nodes),
+          max_memory_(limits.max_memory),
+          timed_(limits.timeout.count() != 0) {
+        if (max_memory_ != 0) {
+            saved_memory_ = mgr_.SetMaxMemory(max_memory_);
+        }
+        if (timed_) {
+            mgr_.ResetStartTime();
+            mgr_.SetTimeLimit(static_cast<unsigned long>(limits.timeout.count()));
+        }
+        if (max_nodes_ != 0) {
+            Cudd_RegisterTerminationCallback(mgr_.getManager(), &over_node_limit, this);
+        }
+    }
 
-    // Create variable mapping
-    std::vector<std::string> sorted_vars(variable_names.begin(), variable_names.end());
-    std::ranges::sort(sorted_vars);
+    ~limit_guard() {
+        if (max_nodes_ != 0) {
+            Cudd_UnregisterTerminationCallback(mgr_.getManager());
+        }
+        if (max_memory_ != 0) {
+            mgr_.SetMaxMemory(saved_memory_);
+        }
+        if (timed_) {
+            mgr_.UnsetTimeLimit();
+        }
+        mgr_.ClearErrorCode();
+    }
 
-    std::cout << "CUDD variable ordering: ";
-    for (size_t i = 0; i < sorted_vars.size(); ++i) {
-        std::cout << sorted_vars[i] << "=" << i;
-        if (i < sorted_vars.size() - 1)
-            std::cout << ", ";
+    limit_guard(const limit_guard&) = delete;
+    limit_guard& operator=(const limit_guard&) = delete;
+
+    /// Reason for the failure recorded in the manager's error code
+    std::string reason(const conversion_budget& budget) const {
+        switch (mgr_.ReadErrorCode()) {
+            case CUDD_TIMEOUT_EXPIRED:
+                return budget.timeout_reason();
+            case CUDD_MAX_MEM_EXCEEDED:
+            case CUDD_MEMORY_OUT:
+                return budget.memory_reason();
+            case CUDD_TERMINATION:
+                return std::format("node limit of {} exceeded", max_nodes_);
+            default:
+                return "CUDD operation failed";
+        }
     }
-    std::cout << std::endl;
 
-    std::unordered_map<std::string, int> var_map;
-    for (size_t i = 0; i < sorted_vars.size(); ++i) {
-        var_map[sorted_vars[i]] = static_cast<int>(i);
+   private:
+    static int over_node_limit(const void* arg) {
+        const auto* guard = static_cast<const limit_guard*>(arg);
+        return Cudd_ReadKeys(guard->mgr_.getManager()) > guard->max_nodes_ ? 1 : 0;
+    }
+
+    const Cudd& mgr_;
+    std::size_t max_nodes_;
+    std::size_t max_memory_;
+    bool timed_;
+    std::size_t saved_memory_ = 0;
+};
+
+}  // namespace cudd_convert_detail
+
+/**
+ * @brief Converts an expression to a CUDD BDD with a given variable numbering
+ *
+ * The recursive conversion behind convert_to_cudd_bdd(). Taking the manager
+ * and numbering as parameters lets a subtree be converted with the indices
+ * of the whole expression in a separate manager (see
+ * partitioned_convert.hpp). Nothing is printed.
+ *
+ * With a @p budget the limits are installed on @p mgr for the duration of
+ * the conversion (see cudd_convert_detail::limit_guard) and checked again
+ * after every expression node.
+ *
+ * Variables listed in @p fixed are replaced by constants, which builds the
+ * cofactor of the expression directly instead of restricting the whole BDD
+ * afterwards (see equivalence_check.hpp). Names listed in @p defined stand
+ * for BDDs built earlier in @p mgr, e.g. the `let` definitions of a
+ * multi-output file (see multi_output.hpp).
+ *
+ * @param expr The expression to convert
+ * @param mgr Manager that owns the result
+ * @param var_map Variable index of every name used by @p expr
+ * @param budget Limits to enforce, or nullptr
+ * @param fixed Value of each variable to replace by a constant, or nullptr
+ * @param defined BDD of each name that refers to a definition, or nullptr
+ * @return Root BDD of @p expr in @p mgr
+ * @throws std::runtime_error If a variable of @p expr is in neither map
+ * @throws conversion_aborted If a limit of @p budget is exceeded
+ */
+inline BDD convert_to_cudd_bdd_with_map(const my_expression& expr, const Cudd& mgr,
+                                        const std::unordered_map<std::string, int>& var_map,
+                                        conversion_budget* budget = nullptr,
+                                        const std::unordered_map<std::string, bool>* fixed =
+                                            nullptr,
+                                        const std::unordered_map<std::string, BDD>* defined =
+                                            nullptr) {
+    std::optional<cudd_convert_detail::limit_guard> guard;
+    if (budget != nullptr) {
+        guard.emplace(mgr, budget->limits());
     }
 
-    // Recursive lambda to convert expression to CUDD BDD
+    auto literal = [&](const std::string& name) {
+        if (fixed != nullptr) {
+            if (auto it = fixed->find(name); it != fixed->end()) {
+                return it->second ? mgr.bddOne() : mgr.bddZero();
+            }
+        }
+        return mgr.bddVar(var_map.at(name));
+    };
+
+    // Recursive lambda to convert expression to CUDD BDD; convert_node builds one node
+    std::function<BDD(const my_expression&)> convert_node;
     std::function<BDD(const my_expression&)> convert_recursive =
         [&](const my_expression& e) -> BDD {
+        if (budget == nullptr) {
+            return convert_node(e);
+        }
+        BDD result;
+        try {
+            result = convert_node(e);
+        } catch (const std::logic_error&) {
+            // An operation of this node was interrupted by one of the installed limits
+            budget->note_peak(static_cast<std::size_t>(mgr.ReadPeakNodeCount()));
+            budget->abort(e, guard->reason(*budget));
+        }
+        budget->check(e, static_cast<std::size_t>(mgr.ReadKeys()));
+        return result;
+    };
+    convert_node = [&](const my_expression& e) -> BDD {
         return std::visit(
             [&](const auto& content) -> BDD {
                 using T = std::decay_t<decltype(content)>;
 
                 if constexpr (std::is_same_v<T, my_variable>) {
-                    auto it = var_map.find(content.variable_name);
-                    if (it == var_map.end()) {
+                    if (defined != nullptr) {
+                        if (auto def = defined->find(content.variable_name);
+                            def != defined->end()) {
+                            return def->second;
+                        }
+                    }
+                    if (!var_map.contains(content.variable_name)) {
                         throw std::runtime_error("Variable not found in variable map: "
                                                  + content.variable_name);
                     }
-                    return cudd_mgr->bddVar(it->second);
+                    return literal(content.variable_name);
                 } else if constexpr (std::is_same_v<T, my_not>) {
                     BDD expr_bdd = convert_recursive(*content.expr);
-                    BDD one = cudd_mgr->bddOne();
+                    BDD one = mgr.bddOne();
                     return expr_bdd ^ one;
                 } else if constexpr (std::is_same_v<T, my_and>) {
                     BDD left = convert_recursive(*content.left);
@@ -113,6 +229,31 @@ inline std::pair<std::unique_ptr<Cudd>, BDD> convert_to_cudd_bdd(
                     BDD left = convert_recursive(*content.left);
                     BDD right = convert_recursive(*content.right);
                     return left ^ right;
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    std::vector<std::pair<int, BDD>> operands;
+                    operands.reserve(content.operands.size());
+                    for (const auto& operand : content.operands) {
+                        BDD operand_bdd = convert_recursive(*operand);
+                        int level = cardinality_bdd::operand_level(
+                            *operand, [&](const std::string& name) {
+                                auto it = var_map.find(name);
+                                return it == var_map.end() ? -1 : mgr.ReadPerm(it->second);
+                            });
+                        operands.emplace_back(level, std::move(operand_bdd));
+                    }
+                    auto ite = [](const BDD& f, const BDD& g, const BDD& h) {
+                        return f.Ite(g, h);
+                    };
+                    return cardinality_bdd::build(content, std::move(operands),
+                                                  mgr.bddZero(), mgr.bddOne(), ite);
+                } else if constexpr (std::is_same_v<T, my_compare>) {
+                    auto ite = [](const BDD& f, const BDD& g, const BDD& h) {
+                        return f.Ite(g, h);
+                    };
+                    return field_compare_bdd::build(content, literal, mgr.bddZero(),
+                                                    mgr.bddOne(), ite);
+                } else if constexpr (std::is_same_v<T, my_constant>) {
+                    return content.value ? mgr.bddOne() : mgr.bddZero();
                 }
 
                 // This should never be reached
@@ -121,8 +262,54 @@ inline std::pair<std::unique_ptr<Cudd>, BDD> convert_to_cudd_bdd(
             e);
     };
 
+    return convert_recursive(expr);
+}
+
+/**
+ * @brief Convert expression to CUDD BDD format for comparison
+ *
+ * This function converts a parsed expression to CUDD BDD format using the CUDD library.
+ * CUDD (Colorado University Decision Diagram) is a mature BDD library that provides
+ * efficient BDD operations and automatic variable reordering. This function is used
+ * for comparing BDD implementations.
+ *
+ * Cardinality constraints are built with CUDD's ITE as layered counters (see
+ * cardinality_bdd.hpp) rather than as chains of binary operations. Field
+ * comparisons are built the same way as bit-level comparator chains (see
+ * field_compare_bdd.hpp).
+ *
+ * @param expr The expression to convert
+ * @param variable_names The set of variable names used in the expression
+ * @param budget Node, memory and time limits to enforce, or nullptr
+ * @param sizing Initial unique-table and cache sizes of the manager (see manager_sizing.hpp)
+ * @return Pair containing the CUDD manager and the root BDD
+ * @throws conversion_aborted If a limit of @p budget is exceeded
+ */
+inline std::pair<std::unique_ptr<Cudd>, BDD> convert_to_cudd_bdd(
+    const my_expression& expr, const std::unordered_set<std::string>& variable_names,
+    conversion_budget* budget = nullptr, const manager_sizing& sizing = {}) {
+    // Create CUDD manager
+    auto cudd_mgr =
+        std::make_unique<Cudd>(0, 0, sizing.cudd_unique_slots, sizing.cudd_cache_slots);
+
+    // Create variable mapping
+    std::vector<std::string> sorted_vars = ordered_variable_names(variable_names);
+
+    std::cout << "CUDD variable ordering: ";
+    for (size_t i = 0; i < sorted_vars.size(); ++i) {
+        std::cout << sorted_vars[i] << "=" << i;
+        if (i < sorted_vars.size() - 1)
+            std::cout << ", ";
+    }
+    std::cout << std::endl;
+
+    std::unordered_map<std::string, int> var_map;
+    for (size_t i = 0; i < sorted_vars.size(); ++i) {
+        var_map[sorted_vars[i]] = static_cast<int>(i);
+    }
+
     // Convert the expression
-    BDD result = convert_recursive(expr);
+    BDD result = convert_to_cudd_bdd_with_map(expr, *cudd_mgr, var_map, budget);
 
     return std::make_pair(std::move(cudd_mgr), result);
 }
@@ -23,8 +23,10 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "c_code_generator.hpp"
 #include "dot_graph_generator.hpp"
 #include "mermaid_graph_generator.hpp"
 #include "node_table_generator.hpp"
@@ -127,3 +129,56 @@ void write_cudd_nodes_to_stream(const Cudd& cudd_manager, const BDD& bdd,
 void write_cudd_nodes_to_markdown(const Cudd& cudd_manager, const BDD& bdd,
                                   const std::vector<std::string>& variable_names,
                                   std::ostream& out);
+
+/**
+ * @brief Writes CUDD BDD as a self-contained C evaluator
+ *
+ * Generates C source using the generic c_code_generator.hpp template.
+ * Complemented edges are expanded by cudd_iterator, so the generated code
+ * only contains plain decisions. Variable i of the generated code is
+ * variable_names[i].
+ *
+ * @param cudd_manager CUDD manager containing the BDD
+ * @param bdd CUDD BDD to compile
+ * @param variable_names Vector of variable names, in input bit order
+ * @param out Output stream for the C source
+ * @param config Function name and code style options
+ * @throws std::runtime_error If the configuration is invalid for this BDD
+ */
+void write_cudd_to_c(const Cudd& cudd_manager, const BDD& bdd,
+                     const std::vector<std::string>& variable_names, std::ostream& out,
+                     const c_code::CCodeConfig& config = c_code::CCodeConfig());
+
+/**
+ * @brief Writes several BDDs of one CUDD manager as a single DOT graph
+ *
+ * Nodes shared between the outputs are drawn once, and a label node with
+ * the output name points at each root (see multi_output.hpp).
+ *
+ * @param cudd_manager CUDD manager owning every BDD
+ * @param outputs Name and BDD of each output
+ * @param variable_names Vector of variable names for labeling
+ * @param out Output stream for DOT content
+ * @param graph_name Name for the generated DOT graph (default: "DD")
+ */
+void write_cudd_outputs_to_dot(const Cudd& cudd_manager,
+                               const std::vector<std::pair<std::string, BDD>>& outputs,
+                               const std::vector<std::string>& variable_names, std::ostream& out,
+                               const std::string& graph_name = "DD");
+
+/**
+ * @brief Writes one node table for several BDDs of one CUDD manager
+ *
+ * Shared nodes get a single row; the row of each output root is listed
+ * after the table.
+ *
+ * @param cudd_manager CUDD manager owning every BDD
+ * @param outputs Name and BDD of each output
+ * @param variable_names Vector of variable names for display
+ * @param out Output stream to write the table to
+ * @param include_headers Whether to include descriptive headers and footers (default: true)
+ */
+void write_cudd_outputs_nodes_to_stream(const Cudd& cudd_manager,
+                                        const std::vector<std::pair<std::string, BDD>>& outputs,
+                                        const std::vector<std::string>& variable_names,
+                                        std::ostream& out, bool include_headers = true);
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file cudd_zdd_convert.hpp
+ * @brief Conversion of expressions to CUDD zero-suppressed decision diagrams
+ *
+ * A ZDD represents a function by the family of its satisfying assignments,
+ * each written as the set of variables that are true. A node whose 1-edge
+ * leads to the empty family is removed, so a variable missing from a path
+ * is 0 on that path, where in a BDD it would be free. Sparse families, such
+ * as the solutions of the N-Queens files with one queen per row, need far
+ * fewer nodes this way than as a BDD.
+ *
+ * The ZDD is built directly from the expression with CUDD's family
+ * operations over the universe U of all subsets of the variables: AND is
+ * intersection, OR is union, NOT f is U - f and XOR is the symmetric
+ * difference. Cardinality constraints and field comparisons use the same
+ * builders as the BDD converters, with ITE(f, g, h) = (f * g) + ((U - f) * h).
+ * CUDD's ZDD variables are never reordered here, so variable i is at level i.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cudd/cudd.h>
+
+#include <cudd/cuddObj.hh>
+
+#include "cardinality_bdd.hpp"
+#include "conversion_limits.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "field_compare_bdd.hpp"
+#include "manager_sizing.hpp"
+
+/**
+ * @brief Converts an expression to a CUDD ZDD with a given variable numbering
+ *
+ * @p mgr must have at least one ZDD variable per index of @p var_map (see
+ * convert_to_cudd_zdd()); the universe the complements are taken in is the
+ * family of all subsets of those ZDD variables. With a @p budget the limits
+ * are installed on @p mgr as for convert_to_cudd_bdd_with_map().
+ *
+ * @param expr The expression to convert
+ * @param mgr Manager that owns the result
+ * @param var_map Variable index of every name used by @p expr
+ * @param budget Limits to enforce, or nullptr
+ * @return Family of the satisfying assignments of @p expr
+ * @throws std::runtime_error If a variable of @p expr is not in @p var_map
+ * @throws conversion_aborted If a limit of @p budget is exceeded
+ */
+inline ZDD convert_to_cudd_zdd_with_map(const my_expression& expr, const Cudd& mgr,
+                                        const std::unordered_map<std::string, int>& var_map,
+                                        conversion_budget* budget = nullptr) {
+    std::optional<cudd_convert_detail::limit_guard> guard;
+    if (budget != nullptr) {
+        guard.emplace(mgr, budget->limits());
+    }
+
+    const ZDD universe = mgr.zddOne(0);
+    const ZDD empty = mgr.zddZero();
+
+    auto literal = [&](const std::string& name) { return mgr.zddVar(var_map.at(name)); };
+    auto ite = [&](const ZDD& f, const ZDD& g, const ZDD& h) {
+        return (f * g) + ((universe - f) * h);
+    };
+
+    // Same structure as convert_to_cudd_bdd_with_map(): convert_node builds one node
+    std::function<ZDD(const my_expression&)> convert_node;
+    std::function<ZDD(const my_expression&)> convert_recursive =
+        [&](const my_expression& e) -> ZDD {
+        if (budget == nullptr) {
+            return convert_node(e);
+        }
+        ZDD result;
+        try {
+            result = convert_node(e);
+        } catch (const std::logic_error&) {
+            budget->note_peak(static_cast<std::size_t>(mgr.ReadPeakNodeCount()));
+            budget->abort(e, guard->reason(*budget));
+        }
+        budget->check(e, static_cast<std::size_t>(mgr.ReadKeys()));
+        return result;
+    };
+    convert_node = [&](const my_expression& e) -> ZDD {
+        return std::visit(
+            [&](const auto& content) -> ZDD {
+                using T = std::decay_t<decltype(content)>;
+
+                if constexpr (std::is_same_v<T, my_variable>) {
+                    if (!var_map.contains(content.variable_name)) {
+                        throw std::runtime_error("Variable not found in variable map: "
+                                                 + content.variable_name);
+                    }
+                    return literal(content.variable_name);
+                } else if constexpr (std::is_same_v<T, my_not>) {
+                    return universe - convert_recursive(*content.expr);
+                } else if constexpr (std::is_same_v<T, my_and>) {
+                    ZDD left = convert_recursive(*content.left);
+                    ZDD right = convert_recursive(*content.right);
+                    return left * right;
+                } else if constexpr (std::is_same_v<T, my_or>) {
+                    ZDD left = convert_recursive(*content.left);
+                    ZDD right = convert_recursive(*content.right);
+                    return left + right;
+                } else if constexpr (std::is_same_v<T, my_xor>) {
+                    ZDD left = convert_recursive(*content.left);
+                    ZDD right = convert_recursive(*content.right);
+                    return (left - right) + (right - left);
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    std::vector<std::pair<int, ZDD>> operands;
+                    operands.reserve(content.operands.size());
+                    for (const auto& operand : content.operands) {
+                        ZDD operand_zdd = convert_recursive(*operand);
+                        int level = cardinality_bdd::operand_level(
+                            *operand, [&](const std::string& name) {
+                                auto it = var_map.find(name);
+                                return it == var_map.end() ? -1 : it->second;
+                            });
+                        operands.emplace_back(level, std::move(operand_zdd));
+                    }
+                    return cardinality_bdd::build(content, std::move(operands), empty, universe,
+                                                  ite);
+                } else if constexpr (std::is_same_v<T, my_compare>) {
+                    return field_compare_bdd::build(content, literal, empty, universe, ite);
+                } else if constexpr (std::is_same_v<T, my_constant>) {
+                    return content.value ? universe : empty;
+                }
+
+                // This should never be reached
+                throw std::runtime_error("Unknown expression type");
+            },
+            e);
+    };
+
+    return convert_recursive(expr);
+}
+
+/**
+ * @brief Converts an expression to a CUDD ZDD in a new manager
+ *
+ * The manager is created with one BDD and one ZDD variable per expression
+ * variable, numbered in the order of ordered_variable_names() like
+ * convert_to_cudd_bdd(), so the BDD of the same expression can be built in
+ * it for comparison.
+ *
+ * @param expr The expression to convert
+ * @param variable_names The set of variable names used in the expression
+ * @param budget Node, memory and time limits to enforce, or nullptr
+ * @param sizing Initial unique-table and cache sizes of the manager (see manager_sizing.hpp)
+ * @return Pair containing the CUDD manager and the root ZDD
+ * @throws conversion_aborted If a limit of @p budget is exceeded
+ */
+inline std::pair<std::unique_ptr<Cudd>, ZDD> convert_to_cudd_zdd(
+    const my_expression& expr, const std::unordered_set<std::string>& variable_names,
+    conversion_budget* budget = nullptr, const manager_sizing& sizing = {}) {
+    std::vector<std::string> sorted_vars = ordered_variable_names(variable_names);
+    const auto count = static_cast<unsigned int>(sorted_vars.size());
+    auto cudd_mgr =
+        std::make_unique<Cudd>(count, count, sizing.cudd_unique_slots, sizing.cudd_cache_slots);
+
+    std::unordered_map<std::string, int> var_map;
+    for (size_t i = 0; i < sorted_vars.size(); ++i) {
+        var_map[sorted_vars[i]] = static_cast<int>(i);
+    }
+
+    ZDD result = convert_to_cudd_zdd_with_map(expr, *cudd_mgr, var_map, budget);
+    return std::make_pair(std::move(cudd_mgr), result);
+}
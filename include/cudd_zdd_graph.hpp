@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file cudd_zdd_graph.hpp
+ * @brief CUDD ZDD graph generation using generic template systems
+ *
+ * Provides DOT, Mermaid and node table output for zero-suppressed decision
+ * diagrams built by convert_to_cudd_zdd(). Dashed edges are taken when the
+ * variable is 0 and solid edges when it is 1, as for BDDs; every edge is
+ * labelled with its branch and with the variables it skips, which are 0 on
+ * that edge.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cudd/cudd.h>
+
+#include <cudd/cuddObj.hh>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Writes a CUDD ZDD as DOT graph using the generic template system
+ *
+ * @param cudd_manager CUDD manager containing the ZDD
+ * @param zdd CUDD ZDD to process
+ * @param variable_names ZDD variable names by index, one per level
+ * @param out Output stream for DOT content
+ * @param graph_name Name for the generated DOT graph (default: "CUDD_ZDD")
+ */
+void write_cudd_zdd_to_dot(const Cudd& cudd_manager, const ZDD& zdd,
+                           const std::vector<std::string>& variable_names, std::ostream& out,
+                           const std::string& graph_name = "CUDD_ZDD");
+
+/**
+ * @brief Writes a CUDD ZDD as Mermaid graph using the generic template system
+ *
+ * @param cudd_manager CUDD manager containing the ZDD
+ * @param zdd CUDD ZDD to process
+ * @param variable_names ZDD variable names by index, one per level
+ * @param out Output stream for Mermaid content
+ * @param graph_title Title for the generated Mermaid graph (default: "ZDD")
+ */
+void write_cudd_zdd_to_mermaid(const Cudd& cudd_manager, const ZDD& zdd,
+                               const std::vector<std::string>& variable_names, std::ostream& out,
+                               const std::string& graph_title = "ZDD");
+
+/**
+ * @brief Writes a CUDD ZDD node table to an output stream using the generic template
+ *
+ * Each row lists the node's variable, type and its children as
+ * `label->index` pairs, with the label of get_edge_label() in
+ * cudd_zdd_iterator.hpp (e.g. `1 (c..f=0)->4`).
+ *
+ * @param cudd_manager CUDD manager containing the ZDD
+ * @param zdd CUDD ZDD to analyze
+ * @param variable_names ZDD variable names by index, one per level
+ * @param out Output stream to write the table to
+ * @param include_headers Whether to include descriptive headers and footers (default: true)
+ */
+void write_cudd_zdd_nodes_to_stream(const Cudd& cudd_manager, const ZDD& zdd,
+                                    const std::vector<std::string>& variable_names,
+                                    std::ostream& out, bool include_headers = true);
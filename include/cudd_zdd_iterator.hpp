@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file cudd_zdd_iterator.hpp
+ * @brief CUDD ZDD iterator interface for graph traversal
+ *
+ * Iterator over the nodes of a CUDD zero-suppressed decision diagram. ZDD
+ * edges carry no complement bit, so each node is visited once. An edge that
+ * skips variables means those variables are 0, not free as in a BDD; the
+ * edge label names them so that the DOT graph and node table can be read
+ * without knowing the variable count.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cudd/cudd.h>
+
+#include <cstddef>
+#include <cudd/cuddObj.hh>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @class cudd_zdd_iterator
+ * @brief Iterator for traversing CUDD ZDD structures
+ *
+ * Compatible with the generic DOT and Mermaid generators and with
+ * node_table::generate_multiway_text_table(). Children are returned in
+ * BDD order: the 0-edge (variable absent) first, the 1-edge second. The
+ * variables of @p variable_names are the ZDD variables by index, and their
+ * number is the number of levels of the diagram.
+ */
+class cudd_zdd_iterator {
+   private:
+    const Cudd* cudd_manager_;                        ///< CUDD manager pointer
+    DdNode* node_;                                    ///< Current ZDD node
+    const std::vector<std::string>* variable_names_;  ///< Variable names for display
+
+    /**
+     * @brief Level of @p node, with the terminals below the last variable
+     */
+    std::size_t level_of(DdNode* node) const {
+        if (Cudd_IsConstant(node)) {
+            return variable_names_ ? variable_names_->size() : 0;
+        }
+        return Cudd_NodeReadIndex(node);
+    }
+
+    std::string name_of(std::size_t index) const {
+        if (variable_names_ && index < variable_names_->size()) {
+            return (*variable_names_)[index];
+        }
+        return std::format("x{}", index);
+    }
+
+   public:
+    /**
+     * @brief Construct iterator for a CUDD ZDD node
+     * @param cudd_mgr CUDD manager wrapper
+     * @param node ZDD node
+     * @param variable_names Variable names for display
+     */
+    cudd_zdd_iterator(const Cudd& cudd_mgr, DdNode* node,
+                      const std::vector<std::string>* variable_names)
+        : cudd_manager_(&cudd_mgr), node_(node), variable_names_(variable_names) {}
+
+    // ========================================================================
+    // BaseGraphIterator Interface Requirements
+    // ========================================================================
+
+    /**
+     * @brief Get child iterators for this node
+     * @return ELSE (0-edge) and THEN (1-edge) children, none for terminals
+     */
+    std::vector<cudd_zdd_iterator> get_children() const {
+        std::vector<cudd_zdd_iterator> children;
+        if (!node_ || Cudd_IsConstant(node_)) {
+            return children;
+        }
+        children.reserve(2);
+        children.emplace_back(*cudd_manager_, Cudd_E(node_), variable_names_);
+        children.emplace_back(*cudd_manager_, Cudd_T(node_), variable_names_);
+        return children;
+    }
+
+    const void* get_node_address() const {
+        return static_cast<const void*>(node_);
+    }
+
+    bool operator==(const cudd_zdd_iterator& other) const {
+        return node_ == other.node_;
+    }
+
+    bool operator!=(const cudd_zdd_iterator& other) const {
+        return node_ != other.node_;
+    }
+
+    // ========================================================================
+    // DOT and Mermaid Generator Interface
+    // ========================================================================
+
+    std::string get_label() const {
+        if (is_terminal()) {
+            return get_terminal_value() ? "1" : "0";
+        }
+        return get_variable_name();
+    }
+
+    std::string get_shape() const {
+        if (!node_) {
+            return "circle";
+        }
+        return is_terminal() ? "square" : "circle";
+    }
+
+    std::string get_tooltip() const {
+        if (!node_) {
+            return "";
+        }
+        if (is_terminal()) {
+            return std::to_string(get_terminal_value());
+        }
+        return std::to_string(Cudd_NodeReadIndex(node_));
+    }
+
+    std::string get_css_class() const {
+        if (!node_) {
+            return "default";
+        }
+        return is_terminal() ? "terminal" : "zddVariable";
+    }
+
+    std::string get_edge_style(const cudd_zdd_iterator& /*child*/, size_t child_index) const {
+        return child_index == 0 ? "dashed" : "solid";
+    }
+
+    /**
+     * @brief Branch of the edge to @p child and the variables it suppresses
+     *
+     * Edges into the empty family (terminal 0) suppress nothing, since no
+     * assignment goes through them.
+     *
+     * @return "0" or "1", followed by e.g. " (c=0)" or " (c..f=0)" when the
+     *         edge skips variables
+     */
+    std::string get_edge_label(const cudd_zdd_iterator& child, size_t child_index) const {
+        std::string label = child_index == 0 ? "0" : "1";
+        if (!node_ || is_terminal() || (child.is_terminal() && !child.get_terminal_value())) {
+            return label;
+        }
+        const std::size_t first = level_of(node_) + 1;
+        const std::size_t end = level_of(child.node_);
+        if (first + 1 == end) {
+            label += " (" + name_of(first) + "=0)";
+        } else if (first < end) {
+            label += " (" + name_of(first) + ".." + name_of(end - 1) + "=0)";
+        }
+        return label;
+    }
+
+    // ========================================================================
+    // Node Table Generator Interface
+    // ========================================================================
+
+    std::string get_variable_name() const {
+        if (is_terminal()) {
+            return "-";
+        }
+        return name_of(Cudd_NodeReadIndex(node_));
+    }
+
+    bool is_terminal() const {
+        return node_ && Cudd_IsConstant(node_);
+    }
+
+    /**
+     * @brief 1 for the family holding the empty set, 0 for the empty family
+     */
+    int get_terminal_value() const {
+        if (!is_terminal()) {
+            throw std::runtime_error("get_terminal_value called on non-terminal node");
+        }
+        return Cudd_V(node_) != 0 ? 1 : 0;
+    }
+
+    DdNode* get_node() const {
+        return node_;
+    }
+
+    bool is_valid() const {
+        return node_ != nullptr;
+    }
+
+    std::string get_type() const {
+        if (!node_) {
+            return "Invalid";
+        }
+        if (is_terminal()) {
+            return "Terminal(" + std::to_string(get_terminal_value()) + ")";
+        }
+        return "Variable";
+    }
+};
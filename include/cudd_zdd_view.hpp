@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+/**
+ * @file cudd_zdd_view.hpp
+ * @brief Adapter exposing a CUDD ZDD as a graph::external_dag_view with BDD semantics
+ *
+ * The algorithms written against the views (count_solutions(),
+ * cube_enumerator) read a level skipped by an edge as a free variable, which
+ * is right for BDDs but wrong for ZDDs, where a skipped variable is 0. This
+ * view puts the suppressed levels back: a handle is a ZDD node together with
+ * the level it is reached at, and a handle above its node's level is a
+ * virtual node whose 1-edge leads to the empty family and whose 0-edge
+ * moves one level down. The one terminal reached above the last level
+ * becomes a chain of such nodes as well. No level is then skipped on a path
+ * to the one terminal, and the generic algorithms see the ZDD's function.
+ */
+#pragma once
+
+#include <cudd/cudd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cudd/cuddObj.hh>
+#include <vector>
+
+#include "graph_concepts.hpp"
+
+/**
+ * @brief CUDD ZDD external_dag_view adapter with the suppressed levels expanded
+ *
+ * CUDD's ZDD variables are not reordered here, so variable i is at level i.
+ */
+struct cudd_zdd_view {
+    /**
+     * @brief A ZDD node reached at a level at or above its own
+     *
+     * The empty family is always at level `variables`, so there is one
+     * handle for it.
+     */
+    struct handle {
+        DdNode* p = nullptr;
+        std::uint32_t level = 0;
+
+        /**
+         * @brief Node address with the level in the top 16 bits
+         *
+         * User-space addresses fit in 48 bits, so keys of different handles
+         * differ while there are fewer than 65536 variables.
+         */
+        std::uint64_t stable_key() const noexcept {
+            return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(p))
+                   ^ (static_cast<std::uint64_t>(level) << 48);
+        }
+
+        const void* debug_address() const noexcept {
+            return static_cast<const void*>(p);
+        }
+
+        friend bool operator==(const handle& a, const handle& b) noexcept {
+            return a.p == b.p && a.level == b.level;
+        }
+        friend bool operator!=(const handle& a, const handle& b) noexcept {
+            return !(a == b);
+        }
+    };
+
+    /**
+     * @brief Edge reference returned by `children()`
+     *
+     * `label()` encodes branch semantics: 0 == else/low, 1 == then/high.
+     */
+    struct edge {
+        handle tgt;
+        int branch = 0;  // 0 = else/low, 1 = then/high
+        handle target() const noexcept {
+            return tgt;
+        }
+        int label() const noexcept {
+            return branch;
+        }
+    };
+
+    /// CUDD manager pointer
+    const Cudd* manager = nullptr;
+    /// The root ZDD node
+    DdNode* root = nullptr;
+    /// Number of ZDD variables the families range over; the terminals are at this level
+    std::uint32_t variables = 0;
+
+    cudd_zdd_view() = default;
+    cudd_zdd_view(const Cudd* m, DdNode* r, std::uint32_t vars)
+        : manager(m), root(r), variables(vars) {}
+
+    /**
+     * @brief Handle of @p node reached at @p level
+     */
+    handle at(DdNode* node, std::uint32_t level) const {
+        if (Cudd_IsConstant(node) && Cudd_V(node) == 0) {
+            return handle{node, variables};
+        }
+        return handle{node, level};
+    }
+
+    /**
+     * @brief True for the two terminals at the bottom level
+     */
+    bool is_terminal(handle h) const {
+        return Cudd_IsConstant(h.p) && h.level >= variables;
+    }
+
+    /**
+     * @brief Child of @p h on @p branch, a virtual node above a suppressed level
+     */
+    handle child(handle h, int branch) const {
+        const bool virtual_node = Cudd_IsConstant(h.p) || h.level < Cudd_NodeReadIndex(h.p);
+        if (virtual_node) {
+            return branch == 0 ? at(h.p, h.level + 1) : at(Cudd_ReadZero(manager->getManager()), 0);
+        }
+        return at(branch == 0 ? Cudd_E(h.p) : Cudd_T(h.p), h.level + 1);
+    }
+
+    /**
+     * @brief Return child edges for node handle `h`, none for terminals
+     */
+    auto children(handle h) const {
+        std::vector<edge> out;
+        if (!h.p || is_terminal(h)) {
+            return out;
+        }
+        out.push_back(edge{child(h, 0), 0});
+        out.push_back(edge{child(h, 1), 1});
+        return out;
+    }
+
+    /**
+     * @brief Return the view roots as a small vector of handles
+     */
+    auto roots() const {
+        return std::vector<handle>{at(root, 0)};
+    }
+};
+
+static_assert(graph::external_dag_view<cudd_zdd_view>,
+              "cudd_zdd_view should model external_dag_view");
@@ -23,6 +23,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "graph_iterator_concepts.hpp"
@@ -71,40 +72,24 @@ template <typename V, typename Iterator>
 concept Visitor = requires(V visitor, const NodeInfo<Iterator>& node_info) { visitor(node_info); };
 
 /**
- * @brief Walk a DAG in weak topological order using a visitor pattern
- *
- * This function traverses a tree or DAG structure in weak topological order,
- * ensuring that each node is visited after all its dependencies (children) have
- * been processed. This is useful for operations like dependency resolution,
- * bottom-up computation, or post-order processing.
- *
- * The traversal order guarantees that:
- * - Leaf nodes (no children) are visited first
- * - Each node is visited only after all its children have been visited
- * - Shared nodes in DAGs are visited only once, after all paths to them complete
- *
- * Required iterator interface:
- * - std::vector<Iterator> get_children() const
- * - const void* get_node_address() const (for unique node identification)
+ * @brief Walk the union of several DAGs in weak topological order
  *
- * Optional filtering:
- * - bool should_process() const (defaults to true if not provided)
+ * Like the single-root overload below, but nodes shared between the roots (e.g. the
+ * outputs of one manager) are visited once, when first reached from a
+ * root in @p roots order.
  *
  * @tparam Iterator The iterator type that represents tree/DAG nodes
  * @tparam V A callable that accepts NodeInfo<Iterator>&
- * @param root_iterator The root iterator to start traversal from
+ * @param roots The root iterators to start traversal from
  * @param visitor Function called for each node during traversal
- *
- * @requires Iterator must satisfy DagWalkerIterator concept
- * @requires V must satisfy Visitor<V, Iterator> concept
  */
 template <DagWalkerIterator Iterator, Visitor<Iterator> V>
-void walk_dag_topological_order(const Iterator& root_iterator, V&& visitor) {
+void walk_dag_topological_order(const std::vector<Iterator>& roots, V&& visitor) {
     static_assert(DagWalkerIterator<Iterator>,
                   "Iterator must satisfy DagWalkerIterator concept for topological traversal");
 
-    std::unordered_set<const void*> visited_nodes;
-    std::unordered_set<const void*> completed_nodes;
+    // Nodes being visited (false) or completed (true), looked up once per visit
+    std::unordered_map<const void*, bool> node_completed;
 
     // Helper to check if iterator has should_process method
     auto should_process_impl = [&](const Iterator& iter) -> bool {
@@ -124,19 +109,18 @@ void walk_dag_topological_order(const Iterator& root_iterator, V&& visitor) {
                 return;
             }
 
-            // If we've already completed this node, don't process it again
-            if (completed_nodes.find(node_key) != completed_nodes.end()) {
-                return;
-            }
-
-            // Check if we're already in the process of visiting this node (cycle detection)
-            if (visited_nodes.find(node_key) != visited_nodes.end()) {
-                // We're in a cycle - treat as a revisit but don't recurse
+            auto [state, first_visit] = node_completed.try_emplace(node_key, false);
+            if (!first_visit) {
+                // If we've already completed this node, don't process it again
+                if (state->second) {
+                    return;
+                }
+                // We're already in the process of visiting this node: a cycle. Treat it
+                // as a revisit but don't recurse
                 NodeInfo<Iterator> node_info(current, index_from_parent, parent);
                 visitor(node_info);
                 return;
             }
-            visited_nodes.insert(node_key);
 
             // Process all children first (post-order traversal)
             std::vector<Iterator> children = current.get_children();
@@ -149,12 +133,47 @@ void walk_dag_topological_order(const Iterator& root_iterator, V&& visitor) {
             NodeInfo<Iterator> node_info(current, index_from_parent, parent);
             visitor(node_info);
 
-            // Mark this node as completed
-            completed_nodes.insert(node_key);
+            // Mark this node as completed (children may have rehashed the map)
+            node_completed[node_key] = true;
         };
 
-    // Start traversal from root
-    walk_impl(root_iterator, 0, nullptr);
+    // Start traversal from each root in turn
+    for (const Iterator& root_iterator : roots) {
+        walk_impl(root_iterator, 0, nullptr);
+    }
+}
+
+/**
+ * @brief Walk a DAG in weak topological order using a visitor pattern
+ *
+ * This function traverses a tree or DAG structure in weak topological order,
+ * ensuring that each node is visited after all its dependencies (children) have
+ * been processed. This is useful for operations like dependency resolution,
+ * bottom-up computation, or post-order processing.
+ *
+ * The traversal order guarantees that:
+ * - Leaf nodes (no children) are visited first
+ * - Each node is visited only after all its children have been visited
+ * - Shared nodes in DAGs are visited only once, after all paths to them complete
+ *
+ * Required iterator interface:
+ * - std::vector<Iterator> get_children() const
+ * - const void* get_node_address() const (for unique node identification)
+ *
+ * Optional filtering:
+ * - bool should_process() const (defaults to true if not provided)
+ *
+ * @tparam Iterator The iterator type that represents tree/DAG nodes
+ * @tparam V A callable that accepts NodeInfo<Iterator>&
+ * @param root_iterator The root iterator to start traversal from
+ * @param visitor Function called for each node during traversal
+ *
+ * @requires Iterator must satisfy DagWalkerIterator concept
+ * @requires V must satisfy Visitor<V, Iterator> concept
+ */
+template <DagWalkerIterator Iterator, Visitor<Iterator> V>
+void walk_dag_topological_order(const Iterator& root_iterator, V&& visitor) {
+    walk_dag_topological_order(std::vector<Iterator>{root_iterator}, std::forward<V>(visitor));
 }
 
 /**
@@ -176,20 +195,18 @@ struct EdgeInfo {
 };
 
 /**
- * @brief Collect nodes and edges from a DAG or tree in weak topological order
+ * @brief Collect the nodes and edges reachable from several roots
  *
- * This performs a single traversal and returns both the list of nodes (in
- * topological order) and the list of edges (parent->child) discovered while
- * visiting parents. This avoids doing two separate traversals when callers
- * need both nodes and edges.
+ * Nodes shared between the roots are listed once (see the multi-root
+ * walk_dag_topological_order()).
  *
  * @tparam Iterator The iterator type that represents tree/DAG nodes
- * @param root_iterator The root iterator to start traversal from
+ * @param roots The root iterators to start traversal from
  * @return pair of (nodes vector, edges vector)
  */
 template <DagWalkerIterator Iterator>
 std::pair<std::vector<Iterator>, std::vector<EdgeInfo<Iterator>>>
-collect_nodes_and_edges_topological(const Iterator& root_iterator) {
+collect_nodes_and_edges_topological(const std::vector<Iterator>& roots) {
     static_assert(DagWalkerIterator<Iterator>,
                   "Iterator must satisfy DagWalkerIterator concept for topological collection");
 
@@ -198,7 +215,7 @@ collect_nodes_and_edges_topological(const Iterator& root_iterator) {
 
     // Use the existing walk_dag_topological_order implementation to ensure
     // cycle handling and should_process behavior remain consistent.
-    walk_dag_topological_order(root_iterator, [&](const NodeInfo<Iterator>& info) {
+    walk_dag_topological_order(roots, [&](const NodeInfo<Iterator>& info) {
         // Record the node in topological order
         nodes.push_back(info.node);
 
@@ -212,6 +229,24 @@ collect_nodes_and_edges_topological(const Iterator& root_iterator) {
     return {nodes, edges};
 }
 
+/**
+ * @brief Collect nodes and edges from a DAG or tree in weak topological order
+ *
+ * This performs a single traversal and returns both the list of nodes (in
+ * topological order) and the list of edges (parent->child) discovered while
+ * visiting parents. This avoids doing two separate traversals when callers
+ * need both nodes and edges.
+ *
+ * @tparam Iterator The iterator type that represents tree/DAG nodes
+ * @param root_iterator The root iterator to start traversal from
+ * @return pair of (nodes vector, edges vector)
+ */
+template <DagWalkerIterator Iterator>
+std::pair<std::vector<Iterator>, std::vector<EdgeInfo<Iterator>>>
+collect_nodes_and_edges_topological(const Iterator& root_iterator) {
+    return collect_nodes_and_edges_topological(std::vector<Iterator>{root_iterator});
+}
+
 /**
  * @brief Count the number of nodes reachable from a root in weak topological order
  *
@@ -237,4 +272,23 @@ size_t count_nodes_topological(const Iterator& root_iterator) {
     return counter;
 }
 
+/**
+ * @brief Count the nodes reachable from any of several roots
+ *
+ * Nodes shared between the roots are counted once.
+ *
+ * @tparam Iterator The iterator type that represents tree/DAG nodes
+ * @param roots The root iterators to start traversal from
+ * @return size_t Number of distinct nodes processed
+ */
+template <DagWalkerIterator Iterator>
+size_t count_nodes_topological(const std::vector<Iterator>& roots) {
+    size_t counter = 0;
+    walk_dag_topological_order(roots, [&](const NodeInfo<Iterator>& info) {
+        (void)info;
+        ++counter;
+    });
+    return counter;
+}
+
 }  // namespace dag_walker
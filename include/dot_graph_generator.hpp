@@ -27,6 +27,7 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "dag_walker.hpp"
@@ -190,43 +191,22 @@ struct DotConfig {
 };
 
 /**
- * @brief Pure iterator-based DOT generation using dag_walker for traversal
+ * @brief DOT generation for several roots sharing one graph
  *
- * This function generates Graphviz DOT format from tree/DAG structures by leveraging
- * the dag_walker for all traversal logic and focusing purely on DOT formatting.
- *
- * Required iterator interface (enforced by DotGraphIterator concept):
- * - std::vector<Iterator> get_children() const
- * - const void* get_node_address() const (for unique node identification)
- * - bool operator==(const Iterator&) const / bool operator!=(const Iterator&) const
- *
- * Optional node property methods (auto-detected via C++20 concepts):
- * - std::string get_label() const
- * - std::string get_shape() const
- * - std::string get_style() const
- * - std::string get_fillcolor() const
- * - std::string get_fontcolor() const
- * - std::string get_tooltip() const
- *
- * Optional edge property methods (auto-detected via C++20 concepts):
- * - std::string get_edge_label(const Iterator& child, size_t index) const
- * - std::string get_edge_style(const Iterator& child, size_t index) const
- * - std::string get_edge_color(const Iterator& child, size_t index) const
- * - std::string get_edge_fontcolor(const Iterator& child, size_t index) const
- *
- * Optional filtering:
- * - bool should_process() const (handled by dag_walker)
+ * Nodes reachable from more than one root are drawn once. Each root with
+ * a non-empty name gets a plain-text label node pointing at it, so the
+ * outputs of a multi-output file can be told apart in one picture.
  *
  * @tparam Iterator The iterator type that represents tree/DAG nodes
- * @param root_iterator The root iterator to start traversal from
+ * @param roots Name and root iterator of each root
  * @param out Output stream for the DOT content
  * @param config Configuration for the DOT graph appearance
  *
  * @requires DotGraphIterator<Iterator>
  */
 template <DotGraphIterator Iterator>
-void generate_dot_graph(const Iterator& root_iterator, std::ostream& out,
-                        const DotConfig& config = DotConfig()) {
+void generate_dot_graph(const std::vector<std::pair<std::string, Iterator>>& roots,
+                        std::ostream& out, const DotConfig& config = DotConfig()) {
     static_assert(DotGraphIterator<Iterator>,
                   "Iterator must satisfy DotGraphIterator concept for DOT graph generation");
 
@@ -267,9 +247,8 @@ void generate_dot_graph(const Iterator& root_iterator, std::ostream& out,
     // Use shared node_id_allocator to produce stable node identifiers
     graph_common::node_id_allocator id_alloc("node");
 
-    auto get_node_id = [&](const Iterator& iter) -> std::string {
-        const void* key = iter.get_node_address();
-        return id_alloc.get_id(key);
+    auto get_node_id = [&](const Iterator& iter) -> const std::string& {
+        return id_alloc.get_id(iter.get_node_address());
     };
 
     // Generate node attributes from iterator properties using shared helpers
@@ -332,7 +311,13 @@ void generate_dot_graph(const Iterator& root_iterator, std::ostream& out,
     };
 
     // Collect nodes and edges in a single traversal to avoid double-walking
-    auto [unique_nodes, edges] = dag_walker::collect_nodes_and_edges_topological(root_iterator);
+    std::vector<Iterator> root_iterators;
+    root_iterators.reserve(roots.size());
+    for (const auto& [name, root] : roots) {
+        root_iterators.push_back(root);
+    }
+    auto [unique_nodes, edges] = dag_walker::collect_nodes_and_edges_topological(root_iterators);
+    id_alloc.reserve(unique_nodes.size());
 
     if (config.use_bdd_format) {
         // BDD-specific grouped shape format
@@ -347,7 +332,7 @@ void generate_dot_graph(const Iterator& root_iterator, std::ostream& out,
         std::vector<std::string> circle_nodes;
 
         for (const auto& node : unique_nodes) {
-            std::string node_id = id_alloc.get_id(node.get_node_address());
+            const std::string& node_id = id_alloc.get_id(node.get_node_address());
             std::string shape = "circle";  // default
             if constexpr (has_get_shape<Iterator>) {
                 shape = node.get_shape();
@@ -374,7 +359,7 @@ void generate_dot_graph(const Iterator& root_iterator, std::ostream& out,
         std::vector<std::string> node_lines;
         node_lines.reserve(unique_nodes.size());
         for (const auto& node : unique_nodes) {
-            std::string node_id = id_alloc.get_id(node.get_node_address());
+            const std::string& node_id = id_alloc.get_id(node.get_node_address());
             std::vector<std::string> props;
             if constexpr (has_get_label<Iterator>) {
                 props.push_back("label = \"" + graph_render_helpers::escape_label(node.get_label())
@@ -399,7 +384,7 @@ void generate_dot_graph(const Iterator& root_iterator, std::ostream& out,
         std::vector<std::string> node_lines;
         node_lines.reserve(unique_nodes.size());
         for (const auto& node : unique_nodes) {
-            std::string node_id = get_node_id(node);
+            const std::string& node_id = get_node_id(node);
             std::string node_attrs = build_node_attributes(node, node_id);
             node_lines.push_back("    " + node_id + " " + node_attrs + ";\n");
         }
@@ -415,8 +400,8 @@ void generate_dot_graph(const Iterator& root_iterator, std::ostream& out,
     std::vector<std::string> edge_lines;
     edge_lines.reserve(edges.size());
     for (const auto& edge : edges) {
-        std::string parent_id = get_node_id(edge.parent);
-        std::string child_id = get_node_id(edge.child);
+        const std::string& parent_id = get_node_id(edge.parent);
+        const std::string& child_id = get_node_id(edge.child);
         std::string edge_attrs = build_edge_attributes(edge.parent, edge.child, edge.child_index);
 
         std::string line = "    " + parent_id + " -> " + child_id;
@@ -432,9 +417,68 @@ void generate_dot_graph(const Iterator& root_iterator, std::ostream& out,
         out << line;
     }
 
+    // Point a label node at every named root
+    bool first_label = true;
+    for (size_t i = 0; i < roots.size(); ++i) {
+        const auto& [name, root] = roots[i];
+        if (name.empty()) {
+            continue;
+        }
+        if (first_label) {
+            out << "\n";
+            first_label = false;
+        }
+        const std::string label_id = "output" + std::to_string(i);
+        out << "    " << label_id << " [label = \"" << graph_render_helpers::escape_label(name)
+            << "\", shape = plaintext];\n";
+        out << "    " << label_id << " -> " << get_node_id(root) << ";\n";
+    }
+
     out << "}\n";
 }
 
+/**
+ * @brief Pure iterator-based DOT generation using dag_walker for traversal
+ *
+ * This function generates Graphviz DOT format from tree/DAG structures by leveraging
+ * the dag_walker for all traversal logic and focusing purely on DOT formatting.
+ *
+ * Required iterator interface (enforced by DotGraphIterator concept):
+ * - std::vector<Iterator> get_children() const
+ * - const void* get_node_address() const (for unique node identification)
+ * - bool operator==(const Iterator&) const / bool operator!=(const Iterator&) const
+ *
+ * Optional node property methods (auto-detected via C++20 concepts):
+ * - std::string get_label() const
+ * - std::string get_shape() const
+ * - std::string get_style() const
+ * - std::string get_fillcolor() const
+ * - std::string get_fontcolor() const
+ * - std::string get_tooltip() const
+ *
+ * Optional edge property methods (auto-detected via C++20 concepts):
+ * - std::string get_edge_label(const Iterator& child, size_t index) const
+ * - std::string get_edge_style(const Iterator& child, size_t index) const
+ * - std::string get_edge_color(const Iterator& child, size_t index) const
+ * - std::string get_edge_fontcolor(const Iterator& child, size_t index) const
+ *
+ * Optional filtering:
+ * - bool should_process() const (handled by dag_walker)
+ *
+ * @tparam Iterator The iterator type that represents tree/DAG nodes
+ * @param root_iterator The root iterator to start traversal from
+ * @param out Output stream for the DOT content
+ * @param config Configuration for the DOT graph appearance
+ *
+ * @requires DotGraphIterator<Iterator>
+ */
+template <DotGraphIterator Iterator>
+void generate_dot_graph(const Iterator& root_iterator, std::ostream& out,
+                        const DotConfig& config = DotConfig()) {
+    generate_dot_graph(std::vector<std::pair<std::string, Iterator>>{{"", root_iterator}}, out,
+                       config);
+}
+
 /**
  * @brief Convenience function for DOT generation with simple graph name
  *
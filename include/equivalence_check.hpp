@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file equivalence_check.hpp
+ * @brief Equivalence and implication checks between two expressions
+ *
+ * Both expressions are built in one CUDD manager over the union of their
+ * variables, ordered by ordered_variable_names(). BDDs in one manager are
+ * canonical, so equivalence is a comparison of the two roots and implication
+ * is Cudd_bddLeq, which answers without building `left AND NOT right`. When
+ * the relation fails, a counterexample is read off the first cube of the
+ * difference.
+ *
+ * check_relation_lazy() splits on the top variables of the order instead.
+ * It builds the cofactors of both expressions one assignment of those
+ * variables at a time, substituting constants during the conversion, and
+ * stops at the first pair of cofactors that differ. A faulty rewrite is
+ * then found without building either expression in full; proving
+ * equivalence takes one pair of builds per assignment.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <cudd/cudd.h>
+
+#include <cudd/cuddObj.hh>
+
+#include "cudd_convert.hpp"
+#include "cudd_view.hpp"
+#include "expression_graph.hpp"
+#include "expression_types.hpp"
+#include "model_count.hpp"
+
+/**
+ * @brief Relation checked between a left and a right expression
+ */
+enum class expression_relation {
+    equivalent,  ///< left and right have the same value under every assignment
+    implies,     ///< right is true under every assignment that makes left true
+};
+
+/**
+ * @brief Outcome of check_relation() or check_relation_lazy()
+ */
+struct relation_result {
+    bool holds = true;
+    std::vector<std::string> variables;  ///< Merged variable order
+    /// Values by variable index under which the relation fails (empty if it holds)
+    std::vector<std::uint8_t> counterexample;
+    bool left_value = false;   ///< Value of the left expression under the counterexample
+    bool right_value = false;  ///< Value of the right expression under the counterexample
+    std::size_t cofactors = 0;  ///< Pairs of (cofactor) BDDs built
+};
+
+namespace equivalence_detail {
+
+inline std::vector<std::string> merged_variables(const my_expression& left,
+                                                 const my_expression& right) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(left, names);
+    collect_variables_with_dag_walker(right, names);
+    return ordered_variable_names(names);
+}
+
+inline std::unordered_map<std::string, int> index_map(const std::vector<std::string>& names) {
+    std::unordered_map<std::string, int> var_map;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        var_map[names[i]] = static_cast<int>(i);
+    }
+    return var_map;
+}
+
+/**
+ * @brief Compares two BDDs of one manager and records a counterexample
+ *
+ * Variables the counterexample does not depend on keep their value in
+ * @p result.counterexample, so the caller can preset them.
+ *
+ * @return Whether the relation holds between @p left and @p right
+ */
+inline bool compare(const Cudd& mgr, const BDD& left, const BDD& right,
+                    expression_relation relation, relation_result& result) {
+    const bool holds = relation == expression_relation::equivalent ? left == right : left <= right;
+    if (holds) {
+        return true;
+    }
+
+    // An implication fails only where left is true and right is false
+    BDD witness = left & !right;
+    result.left_value = true;
+    if (witness.IsZero()) {
+        witness = (!left) & right;
+        result.left_value = false;
+    }
+    result.right_value = !result.left_value;
+    result.holds = false;
+
+    cube_enumerator<cudd_view> cubes(cudd_view(&mgr, witness.getNode()),
+                                     result.counterexample.size());
+    cubes.next();
+    for (std::size_t i = 0; i < result.counterexample.size(); ++i) {
+        if (cubes.cube()[i] != cube_enumerator<cudd_view>::free) {
+            result.counterexample[i] = static_cast<std::uint8_t>(cubes.cube()[i]);
+        }
+    }
+    return false;
+}
+
+}  // namespace equivalence_detail
+
+/**
+ * @brief Checks a relation between two expressions with both built in full
+ *
+ * @param left Left expression
+ * @param right Right expression
+ * @param relation Equivalence, or implication of @p right by @p left
+ * @return Whether the relation holds, with a counterexample if it does not
+ */
+inline relation_result check_relation(const my_expression& left, const my_expression& right,
+                                      expression_relation relation) {
+    using namespace equivalence_detail;
+    relation_result result;
+    result.variables = merged_variables(left, right);
+    const auto var_map = index_map(result.variables);
+
+    Cudd mgr(static_cast<unsigned int>(result.variables.size()), 0);
+    BDD left_bdd = convert_to_cudd_bdd_with_map(left, mgr, var_map);
+    BDD right_bdd = convert_to_cudd_bdd_with_map(right, mgr, var_map);
+    result.cofactors = 1;
+
+    result.counterexample.assign(result.variables.size(), 0);
+    if (compare(mgr, left_bdd, right_bdd, relation, result)) {
+        result.counterexample.clear();
+    }
+    return result;
+}
+
+/**
+ * @brief Checks a relation cofactor by cofactor, stopping at the first that differs
+ *
+ * Assignments of the split variables are tried in order with the topmost
+ * variable as the most significant bit, so the counterexample found is the
+ * first in that order.
+ *
+ * @param left Left expression
+ * @param right Right expression
+ * @param relation Equivalence, or implication of @p right by @p left
+ * @param split_variables Number of top variables to split on (at most 20)
+ * @return Whether the relation holds, with a counterexample if it does not;
+ *         `cofactors` is the number of assignments tried
+ */
+inline relation_result check_relation_lazy(const my_expression& left,
+                                           const my_expression& right,
+                                           expression_relation relation,
+                                           std::size_t split_variables = 4) {
+    using namespace equivalence_detail;
+    relation_result result;
+    result.variables = merged_variables(left, right);
+    const auto var_map = index_map(result.variables);
+    const std::size_t split =
+        std::min({split_variables, result.variables.size(), std::size_t{20}});
+
+    Cudd mgr(static_cast<unsigned int>(result.variables.size()), 0);
+    std::unordered_map<std::string, bool> fixed;
+    for (std::uint64_t assignment = 0; assignment < (std::uint64_t{1} << split); ++assignment) {
+        result.counterexample.assign(result.variables.size(), 0);
+        for (std::size_t i = 0; i < split; ++i) {
+            const bool value = ((assignment >> (split - 1 - i)) & 1) != 0;
+            fixed[result.variables[i]] = value;
+            result.counterexample[i] = value ? 1 : 0;
+        }
+        BDD left_bdd = convert_to_cudd_bdd_with_map(left, mgr, var_map, nullptr, &fixed);
+        BDD right_bdd = convert_to_cudd_bdd_with_map(right, mgr, var_map, nullptr, &fixed);
+        ++result.cofactors;
+        if (!compare(mgr, left_bdd, right_bdd, relation, result)) {
+            return result;
+        }
+    }
+    result.counterexample.clear();
+    return result;
+}
@@ -16,9 +16,13 @@
 
 #pragma once
 
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "expression_types.hpp"
 
@@ -26,33 +30,32 @@
  * @brief Adapter class to make our expression types compatible with TeDDy's expression_node concept
  *
  * This class wraps our my_expression variant and provides the interface required
- * by TeDDy's from_expression_tree method. The adapter maintains a reference to
- * a variable mapping to convert variable names to indices.
+ * by TeDDy's from_expression_tree method. The adapter constructed for the root
+ * builds one thin node per expression node in a single pass and resolves every
+ * variable to its index up front; the nodes live in a flat store shared by all
+ * copies of the root, so copying an adapter is constant time.
+ *
+ * NOT is presented as a binary operation whose right operand is a TRUE leaf
+ * that evaluate() ignores, so from_expression_tree descends into the negated
+ * sub-expression once rather than twice and nested NOTs stay linear.
+ *
+ * @note The adapters returned by get_left() and get_right() are valid while an
+ *       adapter constructed from the root (or a copy of it) is alive.
  */
 class expression_adapter {
    public:
     /**
      * @brief Constructs an adapter for the given expression
      *
-     * @param expr Reference to the expression to wrap
-     * @param var_map Reference to variable name to index mapping
+     * @param expr Reference to the expression to wrap; it must outlive the adapter
+     * @param var_map Variable name to index mapping; only read during construction
+     * @throws std::runtime_error If the expression contains a cardinality constraint or a
+     *         field comparison
      */
     explicit expression_adapter(const my_expression& expr,
                                 const std::unordered_map<std::string, int>& var_map)
-        : expr_(expr), var_map_(var_map), left_adapter_(nullptr), right_adapter_(nullptr) {
-        // Pre-create child adapters for operations
-        initialize_child_adapters();
-    }
-
-    /**
-     * @brief Copy constructor
-     */
-    expression_adapter(const expression_adapter& other)
-        : expr_(other.expr_),
-          var_map_(other.var_map_),
-          left_adapter_(nullptr),
-          right_adapter_(nullptr) {
-        initialize_child_adapters();
+        : expr_(&expr), nodes_(std::make_shared<std::deque<expression_adapter>>()) {
+        link_children(var_map);
     }
 
     /**
@@ -60,18 +63,15 @@ class expression_adapter {
      * @return true if the wrapped expression is a my_variable
      */
     bool is_variable() const {
-        return std::holds_alternative<my_variable>(expr_);
+        return std::holds_alternative<my_variable>(*expr_);
     }
 
     /**
      * @brief Check if this node represents a constant
-     * @return false (our expression system doesn't have explicit constants)
-     *
-     * @note Our expression system doesn't have explicit constant nodes,
-     *       so this always returns false. Constants are handled during evaluation.
+     * @return true if the wrapped expression is a my_constant (TRUE or FALSE)
      */
     bool is_constant() const {
-        return false;  // Our expression system doesn't have explicit constants
+        return std::holds_alternative<my_constant>(*expr_);
     }
 
     /**
@@ -79,8 +79,8 @@ class expression_adapter {
      * @return true if the wrapped expression is an operation (AND, OR, NOT, XOR)
      */
     bool is_operation() const {
-        return std::holds_alternative<my_and>(expr_) || std::holds_alternative<my_or>(expr_)
-               || std::holds_alternative<my_not>(expr_) || std::holds_alternative<my_xor>(expr_);
+        return std::holds_alternative<my_and>(*expr_) || std::holds_alternative<my_or>(*expr_)
+               || std::holds_alternative<my_not>(*expr_) || std::holds_alternative<my_xor>(*expr_);
     }
 
     /**
@@ -92,23 +92,23 @@ class expression_adapter {
         if (!is_variable()) {
             throw std::runtime_error("get_index() called on non-variable node");
         }
-
-        const auto& var = std::get<my_variable>(expr_);
-        auto it = var_map_.find(var.variable_name);
-        if (it == var_map_.end()) {
-            throw std::runtime_error("Variable not found: " + var.variable_name);
+        if (index_ < 0) {
+            throw std::runtime_error("Variable not found: "
+                                     + std::get<my_variable>(*expr_).variable_name);
         }
-        return it->second;
+        return index_;
     }
 
     /**
      * @brief Get the constant value (for constant nodes)
-     * @return The constant value
-     * @throws std::runtime_error since our expression system doesn't have constants
+     * @return 1 for TRUE and 0 for FALSE
+     * @throws std::runtime_error if called on non-constant node
      */
     int32_t get_value() const {
-        throw std::runtime_error(
-            "get_value() called - our expression system doesn't have constants");
+        if (!is_constant()) {
+            throw std::runtime_error("get_value() called on non-constant node");
+        }
+        return std::get<my_constant>(*expr_).value ? 1 : 0;
     }
 
     /**
@@ -136,7 +136,7 @@ class expression_adapter {
                     throw std::runtime_error("evaluate() called on non-operation node");
                 }
             },
-            expr_);
+            *expr_);
     }
 
     /**
@@ -145,62 +145,104 @@ class expression_adapter {
      * @throws std::runtime_error if called on non-operation node or node has no left child
      */
     const expression_adapter& get_left() const {
-        if (!left_adapter_) {
+        if (!left_) {
             throw std::runtime_error(
                 "get_left() called on non-operation node or left child not available");
         }
-        return *left_adapter_;
+        return *left_;
     }
 
     /**
      * @brief Get the right child node (for binary operation nodes)
-     * @return Reference to adapter wrapping the right child expression
+     * @return Reference to adapter wrapping the right child expression, or a TRUE leaf for NOT
      * @throws std::runtime_error if called on non-binary-operation node or node has no right child
      */
     const expression_adapter& get_right() const {
-        if (!right_adapter_) {
+        if (!right_) {
             throw std::runtime_error(
                 "get_right() called on non-operation node or right child not available");
         }
-        return *right_adapter_;
+        return *right_;
     }
 
    private:
     /**
-     * @brief Initialize child adapters based on the expression type
+     * @brief Constructs a node of the flat store; its children are linked by the root
      */
-    void initialize_child_adapters() {
-        std::visit(
-            [this](const auto& variant_expr) {
-                using T = std::decay_t<decltype(variant_expr)>;
+    explicit expression_adapter(const my_expression* expr) : expr_(expr) {}
 
-                if constexpr (std::is_same_v<T, my_and> || std::is_same_v<T, my_or>
-                              || std::is_same_v<T, my_xor>) {
-                    if (variant_expr.left) {
-                        left_adapter_ =
-                            std::make_unique<expression_adapter>(*variant_expr.left, var_map_);
-                    }
-                    if (variant_expr.right) {
-                        right_adapter_ =
-                            std::make_unique<expression_adapter>(*variant_expr.right, var_map_);
-                    }
-                } else if constexpr (std::is_same_v<T, my_not>) {
-                    if (variant_expr.expr) {
-                        left_adapter_ =
-                            std::make_unique<expression_adapter>(*variant_expr.expr, var_map_);
-                        // For NOT operations, TeDDy's from_expression_tree expects binary
-                        // operations. Create a dummy right adapter with the same expression to
-                        // satisfy this requirement.
-                        right_adapter_ =
-                            std::make_unique<expression_adapter>(*variant_expr.expr, var_map_);
+    /**
+     * @brief Right operand of every NOT node
+     */
+    static const my_expression& true_leaf() {
+        static const my_expression expr = my_constant{true};
+        return expr;
+    }
+
+    /**
+     * @brief Creates the nodes below the root and links each to its children
+     *
+     * Visits every expression node once with an explicit work list, so deep
+     * expressions do not recurse here.
+     */
+    void link_children(const std::unordered_map<std::string, int>& var_map) {
+        auto& nodes = *nodes_;
+        const expression_adapter* true_node = nullptr;
+        std::vector<expression_adapter*> pending{this};
+        while (!pending.empty()) {
+            expression_adapter* node = pending.back();
+            pending.pop_back();
+            auto add_child = [&](const my_expression* child) {
+                expression_adapter* added = &nodes.emplace_back(expression_adapter(child));
+                pending.push_back(added);
+                return added;
+            };
+            std::visit(
+                [&](const auto& variant_expr) {
+                    using T = std::decay_t<decltype(variant_expr)>;
+
+                    if constexpr (std::is_same_v<T, my_and> || std::is_same_v<T, my_or>
+                                  || std::is_same_v<T, my_xor>) {
+                        if (variant_expr.left && variant_expr.right) {
+                            node->left_ = add_child(variant_expr.left.get());
+                            node->right_ = add_child(variant_expr.right.get());
+                        }
+                    } else if constexpr (std::is_same_v<T, my_variable>) {
+                        auto it = var_map.find(variant_expr.variable_name);
+                        node->index_ = it == var_map.end() ? -1 : it->second;
+                    } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                        // from_expression_tree only understands binary operations; building an
+                        // n-ary counter from them would defeat the purpose of the node
+                        throw std::runtime_error(
+                            "Cardinality constraints are not supported by TeDDy's "
+                            "from_expression_tree; use the custom or CUDD conversion method");
+                    } else if constexpr (std::is_same_v<T, my_compare>) {
+                        // A comparison expands to many bit variables, which has no leaf
+                        // equivalent
+                        throw std::runtime_error(
+                            "Field comparisons are not supported by TeDDy's "
+                            "from_expression_tree; use the custom or CUDD conversion method");
+                    } else if constexpr (std::is_same_v<T, my_not>) {
+                        if (variant_expr.expr) {
+                            node->left_ = add_child(variant_expr.expr.get());
+                            // from_expression_tree expects binary operations; one shared
+                            // constant leaf is the cheapest operand for evaluate() to ignore
+                            if (!true_node) {
+                                true_node =
+                                    &nodes.emplace_back(expression_adapter(&true_leaf()));
+                            }
+                            node->right_ = true_node;
+                        }
                     }
-                }
-            },
-            expr_);
+                },
+                *node->expr_);
+        }
     }
 
-    const my_expression& expr_;                            ///< Reference to the wrapped expression
-    const std::unordered_map<std::string, int>& var_map_;  ///< Reference to variable mapping
-    std::unique_ptr<expression_adapter> left_adapter_;     ///< Left child adapter
-    std::unique_ptr<expression_adapter> right_adapter_;    ///< Right child adapter
+    const my_expression* expr_;                  ///< Wrapped expression
+    const expression_adapter* left_ = nullptr;   ///< Left child adapter
+    const expression_adapter* right_ = nullptr;  ///< Right child adapter
+    int32_t index_ = -1;                         ///< Variable index, or -1 if not in the map
+    /// Nodes below the root, shared by copies of the root (empty in those nodes)
+    std::shared_ptr<std::deque<expression_adapter>> nodes_;
 };
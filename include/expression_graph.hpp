@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "expression_types.hpp"
 
@@ -97,3 +99,41 @@ void write_expression_to_mermaid(const my_expression& expr, std::ostream& out,
  */
 void collect_variables_with_dag_walker(const my_expression& expr,
                                        std::unordered_set<std::string>& variables);
+
+/**
+ * @brief Orders variable names for BDD construction
+ *
+ * Plain variables come first in lexicographic order. Bit variables of
+ * bit-vector fields (named by field_bit_name()) follow, most significant bit
+ * first and interleaved across fields by bit position, which keeps field
+ * comparisons linear in the field width.
+ *
+ * @param variables Set of variable names to order
+ * @return Variable names in BDD level order
+ */
+std::vector<std::string> ordered_variable_names(const std::unordered_set<std::string>& variables);
+
+/**
+ * @brief Counts the expression nodes below and including @p expr
+ *
+ * Shared sub-expressions are counted once per occurrence, matching the number
+ * of operations the recursive converters perform.
+ *
+ * @param expr Expression to measure
+ * @return Number of expression nodes
+ */
+std::size_t expression_size(const my_expression& expr);
+
+/**
+ * @brief Formats an expression as infix text, for diagnostics
+ *
+ * Binary operators are parenthesized, cardinality constraints are written
+ * as in the input format (e.g. `AT_MOST_K(2, a, b, c)`) and field
+ * comparisons use their display labels. Text beyond @p max_length characters
+ * is cut off and replaced by "...".
+ *
+ * @param expr Expression to format
+ * @param max_length Maximum length of the result (0 = unlimited)
+ * @return Text of the expression
+ */
+std::string expression_to_string(const my_expression& expr, size_t max_length = 0);
@@ -16,10 +16,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <format>
 #include <string>
 #include <type_traits>
-#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -43,6 +43,24 @@ inline constexpr const char* not_label() {
 inline constexpr const char* xor_label() {
     return "XOR";
 }
+inline constexpr const char* exactly_label() {
+    return "EXACTLY_K";
+}
+inline constexpr const char* at_most_label() {
+    return "AT_MOST_K";
+}
+inline constexpr const char* at_least_label() {
+    return "AT_LEAST_K";
+}
+inline constexpr const char* in_label() {
+    return "IN";
+}
+inline constexpr const char* true_label() {
+    return "TRUE";
+}
+inline constexpr const char* false_label() {
+    return "FALSE";
+}
 
 // Edge labels (constexpr for compile-time evaluation)
 inline constexpr const char* left_edge() {
@@ -76,6 +94,15 @@ inline constexpr const char* not_color() {
 inline constexpr const char* xor_color() {
     return "lightpink";
 }
+inline constexpr const char* cardinality_color() {
+    return "lightsalmon";
+}
+inline constexpr const char* compare_color() {
+    return "lightcyan";
+}
+inline constexpr const char* constant_color() {
+    return "lightgray";
+}
 inline constexpr const char* default_color() {
     return "white";
 }
@@ -132,6 +159,101 @@ struct expression_traits<my_xor> {
     static constexpr const char* shape = expression_constants::operator_shape();
     static constexpr const char* fillcolor = expression_constants::xor_color();
 };
+
+template <>
+struct expression_traits<my_cardinality> {
+    static constexpr const char* label = "";  // Will use kind and bound
+    static constexpr const char* shape = expression_constants::operator_shape();
+    static constexpr const char* fillcolor = expression_constants::cardinality_color();
+};
+
+template <>
+struct expression_traits<my_compare> {
+    static constexpr const char* label = "";  // Will use field, operator and operand
+    static constexpr const char* shape = expression_constants::operator_shape();
+    static constexpr const char* fillcolor = expression_constants::compare_color();
+};
+
+template <>
+struct expression_traits<my_constant> {
+    static constexpr const char* label = "";  // Will use the value
+    static constexpr const char* shape = expression_constants::variable_shape();
+    static constexpr const char* fillcolor = expression_constants::constant_color();
+};
+
+/**
+ * @brief Display label for a cardinality node, e.g. "EXACTLY_ONE" or "AT_MOST_K(2)"
+ */
+inline std::string cardinality_label(const my_cardinality& node) {
+    switch (node.kind) {
+        case cardinality_kind::exactly:
+            return node.k == 1 ? std::string("EXACTLY_ONE")
+                               : std::format("{}({})", expression_constants::exactly_label(),
+                                             node.k);
+        case cardinality_kind::at_most:
+            return std::format("{}({})", expression_constants::at_most_label(), node.k);
+        case cardinality_kind::at_least:
+            return std::format("{}({})", expression_constants::at_least_label(), node.k);
+    }
+    return "";
+}
+
+/**
+ * @brief Display text of a field value, using the value name of enumerated fields
+ */
+inline std::string field_value_label(const my_field& field, uint64_t value) {
+    if (value < field.value_names.size()) {
+        return field.value_names[value];
+    }
+    return std::format("{}", value);
+}
+
+/**
+ * @brief Display label for a field comparison, e.g. "port[16] == 443" or "proto[8] IN {6, 17}"
+ *
+ * Enumerated fields are shown without a width, e.g. "color IN {red, blue}".
+ */
+inline std::string compare_label(const my_compare& node) {
+    std::string label = node.field.domain != 0
+                            ? node.field.name + " "
+                            : std::format("{}[{}] ", node.field.name, node.field.width);
+    switch (node.op) {
+        case compare_op::eq:
+            label += "==";
+            break;
+        case compare_op::ne:
+            label += "!=";
+            break;
+        case compare_op::lt:
+            label += "<";
+            break;
+        case compare_op::le:
+            label += "<=";
+            break;
+        case compare_op::gt:
+            label += ">";
+            break;
+        case compare_op::ge:
+            label += ">=";
+            break;
+        case compare_op::in: {
+            label += std::format("{} {{", expression_constants::in_label());
+            for (size_t i = 0; i < node.ranges.size(); ++i) {
+                const auto& [lo, hi] = node.ranges[i];
+                label += i == 0 ? "" : ", ";
+                label += field_value_label(node.field, lo);
+                if (lo != hi) {
+                    label += ".." + field_value_label(node.field, hi);
+                }
+            }
+            return label + "}";
+        }
+    }
+    if (node.rhs_field) {
+        return label + std::format(" {}[{}]", node.rhs_field->name, node.rhs_field->width);
+    }
+    return label + std::format(" {}", node.value);
+}
 }  // namespace detail
 
 // ============================================================================
@@ -144,67 +266,27 @@ struct expression_traits<my_xor> {
  * This iterator traverses an expression tree in depth-first order and provides
  * individual property methods for generating DOT graph attributes. It's designed
  * to be compatible with the templated DOT generation system.
+ *
+ * The iterator is a single pointer to the current node, so the walkers copy it
+ * freely into child lists, node lists and edge lists. Textual node ids are not
+ * kept here: the DOT and Mermaid generators assign them once per render from
+ * the node addresses (graph_common::node_id_allocator).
  */
 class expression_iterator {
    private:
     const my_expression* current_expr_;  ///< Current expression node
-    mutable std::unordered_map<const my_expression*, std::string> id_cache_;  ///< Node ID cache
-    mutable size_t next_id_;                                                  ///< Next available ID
 
    public:
     /**
      * @brief Constructs iterator from expression
-     * @param expr Expression to iterate over (can be nullptr for end iterator)
+     * @param expr Expression to iterate over
      */
-    explicit expression_iterator(const my_expression& expr) : current_expr_(&expr), next_id_(0) {}
+    explicit expression_iterator(const my_expression& expr) : current_expr_(&expr) {}
 
     /**
      * @brief Default constructor for end iterator
      */
-    expression_iterator() : current_expr_(nullptr), next_id_(0) {}
-
-    /**
-     * @brief Copy constructor
-     */
-    expression_iterator(const expression_iterator& other)
-        : current_expr_(other.current_expr_),
-          id_cache_(other.id_cache_),
-          next_id_(other.next_id_) {}
-
-    /**
-     * @brief Move constructor
-     */
-    expression_iterator(expression_iterator&& other) noexcept
-        : current_expr_(other.current_expr_),
-          id_cache_(std::move(other.id_cache_)),
-          next_id_(other.next_id_) {
-        other.current_expr_ = nullptr;
-    }
-
-    /**
-     * @brief Copy assignment
-     */
-    expression_iterator& operator=(const expression_iterator& other) {
-        if (this != &other) {
-            current_expr_ = other.current_expr_;
-            id_cache_ = other.id_cache_;
-            next_id_ = other.next_id_;
-        }
-        return *this;
-    }
-
-    /**
-     * @brief Move assignment
-     */
-    expression_iterator& operator=(expression_iterator&& other) noexcept {
-        if (this != &other) {
-            current_expr_ = other.current_expr_;
-            id_cache_ = std::move(other.id_cache_);
-            next_id_ = other.next_id_;
-            other.current_expr_ = nullptr;
-        }
-        return *this;
-    }
+    expression_iterator() : current_expr_(nullptr) {}
 
     /**
      * @brief Checks if iterator is valid (not end)
@@ -252,6 +334,15 @@ class expression_iterator {
                 if constexpr (std::is_same_v<T, my_variable>) {
                     // Variables use their actual name, not the trait label
                     return variant_expr.variable_name;
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    // Cardinality labels include the bound
+                    return detail::cardinality_label(variant_expr);
+                } else if constexpr (std::is_same_v<T, my_compare>) {
+                    // Comparison labels include the field and operand
+                    return detail::compare_label(variant_expr);
+                } else if constexpr (std::is_same_v<T, my_constant>) {
+                    return variant_expr.value ? expression_constants::true_label()
+                                              : expression_constants::false_label();
                 } else {
                     // Operators use their trait-defined label
                     return detail::expression_traits<T>::label;
@@ -323,8 +414,14 @@ class expression_iterator {
                     if (variant_expr.expr) {
                         children.emplace_back(*variant_expr.expr);
                     }
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    for (const auto& operand : variant_expr.operands) {
+                        if (operand) {
+                            children.emplace_back(*operand);
+                        }
+                    }
                 }
-                // Variables have no children
+                // Variables, comparisons and constants have no children
             },
             *current_expr_);
 
@@ -23,6 +23,7 @@
  * - Parenthetical grouping support
  * - Comment filtering (lines starting with #)
  * - Variable name extraction and validation
+ * - `let` definitions and multiple named outputs per file
  */
 
 #include <string>
@@ -48,9 +49,11 @@
  * @throws std::runtime_error If the file cannot be opened or read
  * @throws std::runtime_error If the expression contains syntax errors
  * @throws std::runtime_error If the file is empty or contains only comments
+ * @throws std::runtime_error If the file defines more than one output
  *
  * @note The function automatically trims whitespace from the expression
  * @note Empty lines and lines starting with # are treated as comments and ignored
+ * @note `let` definitions are expanded into the expression (see inline_definitions())
  *
  * Example file format:
  * @code
@@ -59,3 +62,43 @@
  * @endcode
  */
 my_expression_ptr read_expression_from_file(const std::string& filename);
+
+/**
+ * @brief Reads the definitions and named outputs of an expression file
+ *
+ * A file may define names with `let name = expression;` and name its
+ * outputs with `name = expression;`. Later statements refer to a
+ * definition by its name, which the program keeps as a my_variable so
+ * that the definition can be built once and shared by every output (see
+ * multi_output.hpp). A file holding a single bare expression gives one
+ * unnamed output.
+ *
+ * @param filename Path to the expression file
+ * @return The definitions and outputs in file order
+ *
+ * @throws std::runtime_error If the file cannot be read or does not parse
+ * @throws std::runtime_error If a name is defined twice, or a definition is
+ *         named after a variable used before it
+ *
+ * Example file format:
+ * @code
+ * let web = port[16] IN {80, 443};
+ * let internal = src[8] < 16;
+ * allow = web AND NOT internal;
+ * log = web OR internal;
+ * @endcode
+ */
+my_program read_program_from_file(const std::string& filename);
+
+/**
+ * @brief Expands the definitions of a single-output program into one tree
+ *
+ * Each reference gets its own copy of the body, so a chain of definitions
+ * that each use the previous one twice doubles with every level; build the
+ * definitions once with multi_output.hpp where the converter allows it.
+ *
+ * @param program Program with exactly one output
+ * @return The output with every definition reference replaced by a copy of its body
+ * @throws std::runtime_error If the program does not have exactly one output
+ */
+my_expression_ptr inline_definitions(my_program program);
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file expression_simplify.hpp
+ * @brief Algebraic simplification of expression trees before BDD construction
+ *
+ * Every operator of an expression costs at least one apply when it is
+ * converted, and NOT costs an apply<XOR> with the constant one in TeDDy.
+ * Machine-generated expressions repeat operands, negate twice and combine
+ * with constants; simplify_expression() removes these operators from the
+ * tree so that the converters never build them:
+ *
+ * - Constant propagation: `x AND TRUE` -> `x`, `x OR TRUE` -> `TRUE`, and
+ *   constant operands of XOR and of cardinality constraints
+ * - Idempotence: `x AND x` -> `x`, `x OR x` -> `x`
+ * - Absorption: `x AND (x OR y)` -> `x`, `x OR (x AND y)` -> `x`
+ * - Complements: `x AND NOT x` -> `FALSE`, `x OR NOT x` -> `TRUE`
+ * - Double negation: `NOT NOT x` -> `x`
+ * - XOR cancellation: `x XOR y XOR x` -> `y`, `x XOR NOT x` -> `TRUE`
+ * - De Morgan normalization: negations are moved through AND/OR so that as
+ *   few NOTs as possible are built (`NOT a AND NOT b` -> `NOT (a OR b)`),
+ *   and negated field comparisons and AT_MOST_K/AT_LEAST_K are flipped
+ * - Flattening: chains of one associative operator are merged into one
+ *   operand list, so the rules above apply across the whole chain
+ *
+ * The result is equivalent to the input over the same variables, although
+ * variables may disappear from it (`x AND NOT x` has none). Chains are
+ * rebuilt left-deep with their operands in their original order, so the
+ * order of the applies is that of the input. Operands are compared
+ * structurally: `a AND b` and `b AND a` are different operands.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "expression_types.hpp"
+
+/**
+ * @brief Number of rewrites of each kind made by simplify_expression()
+ */
+struct simplify_stats {
+    std::size_t constants = 0;          ///< Constant operands folded or operators made constant
+    std::size_t idempotence = 0;        ///< Repeated AND/OR operands removed
+    std::size_t absorption = 0;         ///< AND/OR operands absorbed by another operand
+    std::size_t complements = 0;        ///< AND/OR chains holding x and NOT x made constant
+    std::size_t double_negations = 0;   ///< Pairs of NOT removed
+    std::size_t xor_cancellations = 0;  ///< Pairs of equal XOR operands removed
+    std::size_t de_morgan = 0;          ///< Negations pushed through an operator
+    std::size_t flattened = 0;          ///< Operators merged into a chain of the same operator
+    std::size_t nodes_before = 0;       ///< Expression nodes of the input (see expression_size())
+    std::size_t nodes_after = 0;        ///< Expression nodes of the result
+
+    /**
+     * @brief Total number of rewrites
+     */
+    std::size_t rewrites() const {
+        return constants + idempotence + absorption + complements + double_negations
+               + xor_cancellations + de_morgan + flattened;
+    }
+};
+
+/**
+ * @brief Returns a simplified copy of an expression
+ *
+ * @param expr Expression to simplify; it is not modified
+ * @param stats Receives the rewrite counts, added to its current values, or nullptr
+ * @return Equivalent expression without the redundant operators listed in
+ *         expression_simplify.hpp
+ */
+my_expression_ptr simplify_expression(const my_expression& expr,
+                                      simplify_stats* stats = nullptr);
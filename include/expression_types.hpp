@@ -6,8 +6,9 @@
  * @brief Expression tree data structures for logical expressions
  *
  * Defines the variant-based abstract syntax tree (AST) structures
- * for representing logical expressions with AND, OR, XOR, NOT operators
- * and variable references.
+ * for representing logical expressions with AND, OR, XOR, NOT operators,
+ * n-ary cardinality constraints, bit-vector field comparisons, variable
+ * references and the TRUE/FALSE constants.
  *
  * @author Alan Jowett
  * @date 2025
@@ -16,9 +17,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 /// @name Expression Tree Data Structures
 /// @{
@@ -30,14 +36,18 @@
  * for representing logical expressions with AND, OR, XOR, NOT operators
  * and variable references.
  */
-struct my_and;       ///< Binary AND operation
-struct my_or;        ///< Binary OR operation
-struct my_not;       ///< Unary NOT operation
-struct my_xor;       ///< Binary XOR operation
-struct my_variable;  ///< Variable reference
+struct my_and;          ///< Binary AND operation
+struct my_or;           ///< Binary OR operation
+struct my_not;          ///< Unary NOT operation
+struct my_xor;          ///< Binary XOR operation
+struct my_variable;     ///< Variable reference
+struct my_cardinality;  ///< N-ary cardinality constraint
+struct my_compare;      ///< Bit-vector field comparison
+struct my_constant;     ///< TRUE or FALSE
 
 /// @brief Variant type representing any expression node
-using my_expression = std::variant<my_and, my_or, my_not, my_xor, my_variable>;
+using my_expression = std::variant<my_and, my_or, my_not, my_xor, my_variable, my_cardinality,
+                                   my_compare, my_constant>;
 
 /// @brief Smart pointer to an expression for memory management
 using my_expression_ptr = std::unique_ptr<my_expression>;
@@ -52,6 +62,15 @@ struct my_variable {
     auto operator<=>(const my_variable& other) const = default;
 };
 
+/**
+ * @brief Represents the constant TRUE or FALSE
+ */
+struct my_constant {
+    bool value = false;  ///< Value of the constant
+
+    auto operator<=>(const my_constant& other) const = default;
+};
+
 /**
  * @brief Represents a logical AND operation between two sub-expressions
  */
@@ -83,4 +102,115 @@ struct my_xor {
     my_expression_ptr right;  ///< Right operand
 };
 
+/**
+ * @brief Kind of counting constraint represented by a my_cardinality node
+ */
+enum class cardinality_kind {
+    exactly,   ///< Exactly k operands are true (EXACTLY_ONE, EXACTLY_K)
+    at_most,   ///< At most k operands are true (AT_MOST_K)
+    at_least,  ///< At least k operands are true (AT_LEAST_K)
+};
+
+/**
+ * @brief Represents a constraint on how many of its operands are true
+ *
+ * Unlike the binary operators this node is n-ary, so converters can build
+ * the constraint as a single layered BDD instead of a chain of applies.
+ */
+struct my_cardinality {
+    cardinality_kind kind = cardinality_kind::exactly;  ///< Comparison against k
+    size_t k = 1;                                       ///< Bound on the number of true operands
+    std::vector<my_expression_ptr> operands;            ///< Counted sub-expressions
+
+    /**
+     * @brief Whether a given number of true operands satisfies the constraint
+     */
+    bool accepts(size_t count) const {
+        switch (kind) {
+            case cardinality_kind::exactly:
+                return count == k;
+            case cardinality_kind::at_most:
+                return count <= k;
+            case cardinality_kind::at_least:
+                return count >= k;
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Comparison operator of a my_compare node
+ */
+enum class compare_op {
+    eq,  ///< ==
+    ne,  ///< !=
+    lt,  ///< <
+    le,  ///< <=
+    gt,  ///< >
+    ge,  ///< >=
+    in,  ///< IN { values and lo..hi ranges }
+};
+
+/**
+ * @brief A declared unsigned bit-vector variable, e.g. `port[16]`
+ *
+ * Bit i (0 = least significant) is the Boolean variable named by
+ * field_bit_name(name, i).
+ *
+ * Fields declared with `DOMAIN` are enumerated: they take one of `domain`
+ * values and are encoded in the smallest `width` that holds them when
+ * bit-blasted, or as a single multi-valued variable in MDD mode.
+ */
+struct my_field {
+    std::string name;                           ///< Field name (e.g., "port")
+    size_t width = 1;                           ///< Number of bits (1..64)
+    size_t domain = 0;                          ///< Number of values if enumerated, otherwise 0
+    std::vector<std::string> value_names = {};  ///< Symbolic value names of an enumerated field
+
+    auto operator<=>(const my_field& other) const = default;
+};
+
+/**
+ * @brief Name of the Boolean variable holding bit @p bit of field @p field
+ */
+inline std::string field_bit_name(const std::string& field, size_t bit) {
+    return field + "[" + std::to_string(bit) + "]";
+}
+
+/**
+ * @brief Compares a bit-vector field with a constant, another field or a set
+ *
+ * Exactly one right-hand side is used: `rhs_field` when set, `ranges` for
+ * compare_op::in, and `value` otherwise.
+ */
+struct my_compare {
+    my_field field;                                     ///< Left-hand side
+    compare_op op = compare_op::eq;                     ///< Comparison operator
+    uint64_t value = 0;                                 ///< Constant right-hand side
+    std::optional<my_field> rhs_field;                  ///< Field right-hand side
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;  ///< Inclusive ranges for IN
+};
+
+/**
+ * @brief An expression bound to a name by `let name = ...;` or `name = ...;`
+ */
+struct my_named_expression {
+    std::string name;        ///< Definition or output name (empty for an unnamed output)
+    my_expression_ptr expr;  ///< Bound expression
+};
+
+/**
+ * @brief Contents of an expression file: shared definitions and named outputs
+ *
+ * A variable whose name is that of a definition refers to the definition
+ * rather than to a Boolean variable. Definitions only refer to earlier
+ * definitions, so building them in order builds every reference first.
+ * A file holding a single expression has no definitions and one unnamed
+ * output.
+ */
+struct my_program {
+    std::vector<my_named_expression> definitions;  ///< `let` bindings in file order
+    std::vector<my_named_expression> outputs;      ///< Outputs in file order
+};
+
 /// @}
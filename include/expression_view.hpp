@@ -52,7 +52,8 @@ struct expression_view {
      * @brief Edge descriptor returned by `children()`
      *
      * The `branch` integer encodes a lightweight branch label: for binary
-     * operators 0==left, 1==right; for unary operators the branch is 0.
+     * operators 0==left, 1==right; for unary operators the branch is 0; for
+     * cardinality constraints it is the operand position.
      */
     struct edge {
         handle tgt;
@@ -77,8 +78,9 @@ struct expression_view {
      *
      * Returns an owned `std::vector<edge>` containing the logical children of
      * the expression node. Binary operators yield two edges (when both
-     * children exist); `my_not` yields a single child; `my_variable` yields no
-     * children.
+     * children exist); `my_not` yields a single child; `my_cardinality` yields
+     * one edge per operand labelled with its position; `my_variable`,
+     * `my_compare` and `my_constant` yield no children.
      *
      * @param h Node handle for which children are requested
      * @return `std::vector<edge>` listing outgoing edges
@@ -100,7 +102,15 @@ struct expression_view {
                 } else if constexpr (std::is_same_v<T, my_not>) {
                     if (v.expr)
                         out.push_back(edge{handle{v.expr.get()}, 0});
-                } else if constexpr (std::is_same_v<T, my_variable>) {
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    for (size_t i = 0; i < v.operands.size(); ++i) {
+                        if (v.operands[i])
+                            out.push_back(
+                                edge{handle{v.operands[i].get()}, static_cast<int>(i)});
+                    }
+                } else if constexpr (std::is_same_v<T, my_variable>
+                                     || std::is_same_v<T, my_compare>
+                                     || std::is_same_v<T, my_constant>) {
                     // no children
                 }
             },
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file field_compare_bdd.hpp
+ * @brief Library-independent construction of bit-vector comparisons as BDDs
+ *
+ * Each comparison is built as a comparator chain from the least significant
+ * bit upwards, one if-then-else per bit (two for field-to-field comparisons).
+ * With the most significant bit at the top of the variable order (see
+ * ordered_variable_names()), every ITE places a bit variable above the
+ * already-built chain, so a comparison with a constant has at most one node
+ * per bit and a field-to-field comparison at most three per bit pair.
+ *
+ * The builder is templated on the diagram type and takes variable lookup and
+ * ITE as callables so that the TeDDy and CUDD converters can share it.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "expression_types.hpp"
+
+namespace field_compare_bdd {
+
+/**
+ * @brief Largest value representable by a field of the given width
+ */
+inline uint64_t max_value(size_t width) {
+    return width >= 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t{1} << width) - 1;
+}
+
+namespace detail {
+
+/**
+ * @brief Bit diagrams of a field, least significant bit first
+ */
+template <typename Diagram, typename Var>
+std::vector<Diagram> field_bits(const my_field& field, Var& var) {
+    std::vector<Diagram> bits;
+    bits.reserve(field.width);
+    for (size_t i = 0; i < field.width; ++i) {
+        bits.push_back(var(field_bit_name(field.name, i)));
+    }
+    return bits;
+}
+
+/// x <= c
+template <typename Diagram, typename Ite>
+Diagram le_const(const std::vector<Diagram>& x, uint64_t c, const Diagram& zero,
+                 const Diagram& one, Ite& ite) {
+    Diagram r = one;
+    for (size_t i = 0; i < x.size(); ++i) {
+        r = ((c >> i) & 1) ? ite(x[i], r, one) : ite(x[i], zero, r);
+    }
+    return r;
+}
+
+/// x >= c
+template <typename Diagram, typename Ite>
+Diagram ge_const(const std::vector<Diagram>& x, uint64_t c, const Diagram& zero,
+                 const Diagram& one, Ite& ite) {
+    Diagram r = one;
+    for (size_t i = 0; i < x.size(); ++i) {
+        r = ((c >> i) & 1) ? ite(x[i], r, zero) : ite(x[i], one, r);
+    }
+    return r;
+}
+
+/// x == c
+template <typename Diagram, typename Ite>
+Diagram eq_const(const std::vector<Diagram>& x, uint64_t c, const Diagram& zero,
+                 const Diagram& one, Ite& ite) {
+    Diagram r = one;
+    for (size_t i = 0; i < x.size(); ++i) {
+        r = ((c >> i) & 1) ? ite(x[i], r, zero) : ite(x[i], zero, r);
+    }
+    return r;
+}
+
+/// lo <= x <= hi
+template <typename Diagram, typename Ite>
+Diagram in_range(const std::vector<Diagram>& x, uint64_t lo, uint64_t hi, const Diagram& zero,
+                 const Diagram& one, Ite& ite) {
+    const uint64_t max = max_value(x.size());
+    if (lo > hi) {
+        return zero;
+    }
+    if (lo == hi) {
+        return eq_const(x, lo, zero, one, ite);
+    }
+    if (lo == 0) {
+        return le_const(x, hi, zero, one, ite);
+    }
+    if (hi == max) {
+        return ge_const(x, lo, zero, one, ite);
+    }
+    return ite(ge_const(x, lo, zero, one, ite), le_const(x, hi, zero, one, ite), zero);
+}
+
+/// x == y (ordered = false), x < y (ordered, !or_equal) or x <= y (ordered, or_equal)
+template <typename Diagram, typename Ite>
+Diagram compare_fields(const std::vector<Diagram>& x, const std::vector<Diagram>& y, bool ordered,
+                       bool or_equal, const Diagram& zero, const Diagram& one, Ite& ite) {
+    Diagram r = or_equal ? one : zero;
+    for (size_t i = 0; i < x.size(); ++i) {
+        // x_i = 1: equal bits keep r, otherwise x > y (or unequal)
+        Diagram when_x = ite(y[i], r, zero);
+        // x_i = 0: y_i = 1 means x < y (or unequal), equal bits keep r
+        Diagram when_not_x = ite(y[i], ordered ? one : zero, r);
+        r = ite(x[i], when_x, when_not_x);
+    }
+    return r;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Builds a field comparison as a BDD
+ *
+ * @tparam Diagram Diagram handle type of the target library
+ * @tparam Var Callable `Diagram(const std::string& bit_variable_name)`
+ * @tparam Ite Callable `Diagram(const Diagram& f, const Diagram& g, const Diagram& h)`
+ * @param cmp The comparison
+ * @param var Variable lookup for bit variables
+ * @param zero Constant false diagram
+ * @param one Constant true diagram
+ * @param ite If-then-else operation of the target library
+ * @return Diagram that is true iff the comparison holds
+ * @throws std::runtime_error If compared fields have different widths
+ */
+template <typename Diagram, typename Var, typename Ite>
+Diagram build(const my_compare& cmp, Var&& var, const Diagram& zero, const Diagram& one,
+              Ite&& ite) {
+    std::vector<Diagram> x = detail::field_bits<Diagram>(cmp.field, var);
+
+    if (cmp.rhs_field) {
+        if (cmp.rhs_field->width != cmp.field.width) {
+            throw std::runtime_error("Cannot compare fields of different widths: "
+                                     + cmp.field.name + " and " + cmp.rhs_field->name);
+        }
+        std::vector<Diagram> y = detail::field_bits<Diagram>(*cmp.rhs_field, var);
+        switch (cmp.op) {
+            case compare_op::eq:
+                return detail::compare_fields(x, y, false, true, zero, one, ite);
+            case compare_op::ne:
+                return ite(detail::compare_fields(x, y, false, true, zero, one, ite), zero, one);
+            case compare_op::lt:
+                return detail::compare_fields(x, y, true, false, zero, one, ite);
+            case compare_op::le:
+                return detail::compare_fields(x, y, true, true, zero, one, ite);
+            case compare_op::gt:
+                return detail::compare_fields(y, x, true, false, zero, one, ite);
+            case compare_op::ge:
+                return detail::compare_fields(y, x, true, true, zero, one, ite);
+            case compare_op::in:
+                break;
+        }
+        throw std::runtime_error("IN requires a set of constants");
+    }
+
+    const uint64_t max = max_value(cmp.field.width);
+    const uint64_t c = cmp.value;
+    switch (cmp.op) {
+        case compare_op::eq:
+            return detail::eq_const(x, c, zero, one, ite);
+        case compare_op::ne:
+            return ite(detail::eq_const(x, c, zero, one, ite), zero, one);
+        case compare_op::lt:
+            return c == 0 ? zero : detail::le_const(x, c - 1, zero, one, ite);
+        case compare_op::le:
+            return detail::le_const(x, c, zero, one, ite);
+        case compare_op::gt:
+            return c >= max ? zero : detail::ge_const(x, c + 1, zero, one, ite);
+        case compare_op::ge:
+            return detail::ge_const(x, c, zero, one, ite);
+        case compare_op::in: {
+            Diagram result = zero;
+            for (const auto& [lo, hi] : cmp.ranges) {
+                result = ite(detail::in_range(x, lo, hi, zero, one, ite), one, result);
+            }
+            return result;
+        }
+    }
+    throw std::runtime_error("Unknown comparison operator");
+}
+
+}  // namespace field_compare_bdd
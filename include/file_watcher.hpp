@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file file_watcher.hpp
+ * @brief Notification when a file is saved
+ *
+ * On Linux the directory of the file is watched with inotify, for writes
+ * that close the file and for renames onto it, so both in-place saves and
+ * editors that write a temporary file and rename it are seen. Elsewhere the
+ * modification time and size of the file are polled.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+/**
+ * @class file_watcher
+ * @brief Waits for saves of one file
+ */
+class file_watcher {
+   public:
+    /// Timeout of wait() that never expires
+    static constexpr std::chrono::milliseconds forever{-1};
+
+    /**
+     * @param path File to watch; its directory must exist
+     * @throws std::runtime_error If the directory cannot be watched
+     */
+    explicit file_watcher(std::filesystem::path path);
+    ~file_watcher();
+
+    file_watcher(const file_watcher&) = delete;
+    file_watcher& operator=(const file_watcher&) = delete;
+
+    /**
+     * @brief Waits until the file is saved
+     *
+     * Several saves in quick succession are reported once.
+     *
+     * @param timeout Longest time to wait (forever if negative)
+     * @return true if the file was saved, false on timeout
+     */
+    bool wait(std::chrono::milliseconds timeout = forever);
+
+   private:
+    std::filesystem::path path_;
+    int inotify_fd_ = -1;                               ///< inotify instance (Linux)
+    std::filesystem::file_time_type last_write_time_;  ///< Polled state elsewhere
+    std::uintmax_t last_size_ = 0;
+};
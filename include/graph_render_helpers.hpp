@@ -5,22 +5,16 @@
  *
  * This header provides lightweight, header-only utilities used by the
  * Mermaid and DOT generators to produce deterministic textual lines for
- * nodes, edges and CSS class assignments. The helpers ensure consistent
- * escaping of labels and stable ordering of class-to-node mappings which
- * is important for the test-suite's byte-for-byte comparisons.
+ * nodes, edges and DOT attribute lists. The helpers ensure consistent
+ * escaping of labels, which is important for the test-suite's byte-for-byte
+ * comparisons.
  */
 #pragma once
 
-#include <algorithm>
 #include <format>
-#include <iterator>
 #include <string>
-#include <unordered_map>
-#include <utility>
 #include <vector>
 
-#include "node_id_helpers.hpp"
-
 /**
  * @brief Utilities for rendering graph elements (nodes/edges/classes).
  *
@@ -116,33 +110,6 @@ inline std::string render_edge_line(const std::string& parent_id, const std::str
     return std::format("    {}{}{}\n", parent_id, style, child_id);
 }
 
-/**
- * @brief Flatten and deterministically sort class->node mappings.
- *
- * The test-suite expects class assignments to appear in a stable order. This
- * helper converts a map of class_name -> vector(node_ids) into a vector of
- * (node_id, class_name) pairs sorted by the node id using
- * `graph_common::node_id_less` for deterministic numeric-aware ordering.
- *
- * @param class_to_nodes Mapping from CSS class name to nodes assigned to it.
- * @return Vector of (node_id, class_name) pairs sorted by node id.
- */
-inline std::vector<std::pair<std::string, std::string>> flatten_and_sort_class_assignments(
-    const std::unordered_map<std::string, std::vector<std::string>>& class_to_nodes) {
-    std::vector<std::pair<std::string, std::string>> out;
-    out.reserve(256);
-    for (const auto& p : class_to_nodes) {
-        const auto& class_name = p.first;
-        const auto& ids = p.second;
-        std::transform(ids.begin(), ids.end(), std::back_inserter(out),
-                       [&](const std::string& id) { return std::make_pair(id, class_name); });
-    }
-    std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) {
-        return graph_common::node_id_less(a.first, b.first);
-    });
-    return out;
-}
-
 /**
  * @brief Join DOT property assignments into a single attribute list string.
  *
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file incremental_convert.hpp
+ * @brief Reuse of the BDDs of unchanged sub-expressions across conversions
+ *
+ * Every subtree of an expression gets a 128-bit structural hash computed from
+ * its operator, its operands' hashes and its variable names, so equal
+ * subtrees of two versions of a file hash alike wherever they sit. A
+ * subtree_cache maps these hashes to the TeDDy diagrams built for them in a
+ * warm manager. Converting an edited expression fetches the diagram of every
+ * unchanged subtree from the cache and only recomputes the nodes above the
+ * edits.
+ *
+ * The cache is bound to one manager and one variable order: diagrams refer
+ * to variable indices, which change when a variable is added or removed.
+ * It can be saved to a file, holding all cached diagrams over one shared node
+ * table, and loaded into a fresh manager by a later run.
+ *
+ * Only subtrees of at least `min_subtree_size` expression nodes are cached,
+ * and a conversion keeps only the entries it used or created, so the cache
+ * tracks the current version of the file.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <libteddy/core.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "conversion_limits.hpp"
+#include "expression_types.hpp"
+
+namespace incremental {
+
+/**
+ * @brief Structural hash of an expression subtree
+ */
+struct subtree_key {
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+
+    bool operator==(const subtree_key& other) const = default;
+};
+
+struct subtree_key_hash {
+    std::size_t operator()(const subtree_key& key) const {
+        return static_cast<std::size_t>(key.high ^ (key.low * 0x9E3779B97F4A7C15ULL));
+    }
+};
+
+/**
+ * @brief Structural hash of an expression
+ *
+ * Stable across runs and platforms, so keys can be stored in a file.
+ */
+subtree_key structural_hash(const my_expression& expr);
+
+/**
+ * @brief What one conversion through the cache did
+ */
+struct convert_stats {
+    std::size_t reused = 0;        ///< Subtrees whose diagram came from the cache
+    std::size_t reused_nodes = 0;  ///< Expression nodes covered by the reused subtrees
+    std::size_t rebuilt = 0;       ///< Expression nodes converted
+    std::size_t cached = 0;        ///< Entries kept for the next conversion
+};
+
+/**
+ * @class subtree_cache
+ * @brief Diagrams of expression subtrees, kept in a warm TeDDy manager
+ */
+class subtree_cache {
+   public:
+    using diagram_t = teddy::bdd_manager::diagram_t;
+
+    /// Default lower bound on the size of a cached subtree, in expression nodes
+    static constexpr std::size_t default_min_subtree_size = 16;
+
+    /**
+     * @param manager Manager that holds the cached diagrams; must outlive the cache
+     * @param variable_names Variable names by index in @p manager
+     * @param min_subtree_size Smallest subtree to cache, in expression nodes
+     */
+    subtree_cache(teddy::bdd_manager& manager, std::vector<std::string> variable_names,
+                  std::size_t min_subtree_size = default_min_subtree_size);
+
+    const std::vector<std::string>& variable_names() const {
+        return variable_names_;
+    }
+
+    /// Number of cached subtrees
+    std::size_t size() const {
+        return entries_.size();
+    }
+
+    /**
+     * @brief Converts an expression, reusing the diagrams of cached subtrees
+     *
+     * Gives the same diagram as convert_to_bdd_with_map() with the cache's
+     * variable order. Afterwards the cache holds exactly the subtrees of
+     * @p expr that are large enough.
+     *
+     * @param expr Expression over variables of variable_names()
+     * @param stats Receives the reuse counts, or nullptr
+     * @param budget Limits to enforce, or nullptr
+     * @throws std::runtime_error If a variable of @p expr is not in the order
+     * @throws conversion_aborted If a limit of @p budget is exceeded
+     */
+    diagram_t convert(const my_expression& expr, convert_stats* stats = nullptr,
+                      conversion_budget* budget = nullptr);
+
+    /**
+     * @brief Writes all cached diagrams and the variable order to a file
+     * @throws std::runtime_error If the file cannot be written
+     */
+    void save(const std::filesystem::path& path) const;
+
+    /**
+     * @brief Adds the diagrams saved by save() to the cache
+     *
+     * @return Number of entries loaded: 0 if the file does not exist or was
+     *         saved with a different variable order
+     * @throws std::runtime_error If the file exists but is not a valid cache
+     */
+    std::size_t load(const std::filesystem::path& path);
+
+   private:
+    teddy::bdd_manager* manager_;
+    std::vector<std::string> variable_names_;
+    std::unordered_map<std::string, int> var_map_;
+    std::size_t min_subtree_size_;
+    std::unordered_map<subtree_key, diagram_t, subtree_key_hash> entries_;
+};
+
+}  // namespace incremental
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file manager_sizing.hpp
+ * @brief Initial TeDDy node pool and CUDD table sizes estimated from the input
+ *
+ * Both libraries grow on demand: TeDDy allocates overflow node pools when its
+ * initial pool runs out, and CUDD rehashes its unique subtables and enlarges
+ * its computed table (cache) as the diagram grows. Sizing them up front from
+ * an estimate of the peak node count avoids the repeated growth on large
+ * inputs and the oversized default cache on small ones.
+ *
+ * The estimate comes from the size of the expression and the number of
+ * variables, or from the peak node count of a previous run recorded in a
+ * sizing profile, which is much closer for files that are converted again.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <cudd/cudd.h>
+
+/**
+ * @brief Initial sizes of the TeDDy and CUDD managers
+ *
+ * A default-constructed value holds the fixed sizes used without a sizing
+ * policy: a 1,000-node TeDDy pool and CUDD's compiled-in defaults.
+ */
+struct manager_sizing {
+    std::int64_t teddy_pool = 1'000;                     ///< Nodes in TeDDy's initial pool
+    std::int64_t teddy_overflow = 500;                   ///< Nodes in each TeDDy overflow pool
+    unsigned int cudd_unique_slots = CUDD_UNIQUE_SLOTS;  ///< Initial slots per unique subtable
+    unsigned int cudd_cache_slots = CUDD_CACHE_SLOTS;    ///< Initial computed-table slots
+    std::size_t estimated_nodes = 0;                     ///< Peak estimate (0 = fixed sizes)
+};
+
+namespace manager_sizing_detail {
+
+/// Expected peak nodes per expression node when there is no profile
+inline constexpr std::size_t nodes_per_expression_node = 8;
+/// Headroom added to the peak of a previous run
+inline constexpr std::size_t profile_headroom_divisor = 4;
+/// Average keys per unique-table slot before CUDD resizes a subtable
+inline constexpr std::size_t cudd_keys_per_slot = 4;
+
+inline constexpr std::size_t min_estimate = 1'000;
+inline constexpr std::size_t max_estimate = std::size_t{1} << 24;
+inline constexpr std::size_t max_unique_slots = std::size_t{1} << 20;
+inline constexpr std::size_t min_cache_slots = std::size_t{1} << 12;
+inline constexpr std::size_t max_cache_slots = std::size_t{1} << 22;
+
+inline unsigned int power_of_two_in(std::size_t value, std::size_t low, std::size_t high) {
+    return static_cast<unsigned int>(std::clamp(std::bit_ceil(value), low, high));
+}
+
+}  // namespace manager_sizing_detail
+
+/**
+ * @brief Estimates the peak number of live and dead nodes of a conversion
+ *
+ * @param expression_nodes Size of the expression (see expression_size())
+ * @param variables Number of BDD variables
+ * @param previous_peak Peak of an earlier conversion of the same input (0 if unknown)
+ * @return Estimated peak node count
+ */
+inline std::size_t estimate_peak_nodes(std::size_t expression_nodes, std::size_t variables,
+                                       std::size_t previous_peak = 0) {
+    using namespace manager_sizing_detail;
+    std::size_t estimate = previous_peak != 0
+                               ? previous_peak + previous_peak / profile_headroom_divisor
+                               : expression_nodes * nodes_per_expression_node + 2 * variables;
+    return std::clamp(estimate, min_estimate, max_estimate);
+}
+
+/**
+ * @brief Chooses manager sizes for an input
+ *
+ * The TeDDy pool holds the whole estimate, with overflow pools of half that
+ * size (TeDDy's own ratio). CUDD gets enough slots per variable to keep the
+ * estimate below its resize threshold, and a power-of-two cache of about one
+ * entry per estimated node.
+ *
+ * @param expression_nodes Size of the expression (see expression_size())
+ * @param variables Number of BDD variables
+ * @param previous_peak Peak of an earlier conversion of the same input (0 if unknown)
+ * @return Sizes for both managers
+ */
+inline manager_sizing size_managers(std::size_t expression_nodes, std::size_t variables,
+                                    std::size_t previous_peak = 0) {
+    using namespace manager_sizing_detail;
+    const std::size_t estimate = estimate_peak_nodes(expression_nodes, variables, previous_peak);
+
+    manager_sizing sizing;
+    sizing.estimated_nodes = estimate;
+    sizing.teddy_pool = static_cast<std::int64_t>(estimate);
+    sizing.teddy_overflow = static_cast<std::int64_t>(estimate / 2);
+    sizing.cudd_unique_slots = power_of_two_in(
+        estimate / (std::max<std::size_t>(variables, 1) * cudd_keys_per_slot),
+        CUDD_UNIQUE_SLOTS, max_unique_slots);
+    sizing.cudd_cache_slots = power_of_two_in(estimate, min_cache_slots, max_cache_slots);
+    return sizing;
+}
+
+/**
+ * @brief Number of overflow pools TeDDy allocates to hold @p peak_nodes nodes
+ *
+ * TeDDy does not expose its pools, so growth is derived from the peak and
+ * the pool sizes it was given.
+ */
+inline std::size_t teddy_pool_growth(const manager_sizing& sizing, std::size_t peak_nodes) {
+    const auto pool = static_cast<std::size_t>(sizing.teddy_pool);
+    const auto overflow =
+        static_cast<std::size_t>(std::max<std::int64_t>(sizing.teddy_overflow, 1));
+    return peak_nodes <= pool ? 0 : (peak_nodes - pool + overflow - 1) / overflow;
+}
+
+/**
+ * @brief Reads the peak node count recorded by write_sizing_profile()
+ *
+ * @param path Profile file
+ * @return Recorded peak, or 0 if the file does not exist
+ * @throws std::runtime_error If the file exists but holds no peak
+ */
+inline std::size_t read_sizing_profile(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    if (!in) {
+        return 0;
+    }
+    const std::string key = "peak_nodes=";
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.starts_with(key)) {
+            try {
+                return std::stoull(line.substr(key.size()));
+            } catch (const std::exception&) {
+                break;
+            }
+        }
+    }
+    throw std::runtime_error("Invalid sizing profile: " + path.string());
+}
+
+/**
+ * @brief Records the peak node count of a conversion for the next run
+ *
+ * @throws std::runtime_error If the file cannot be written
+ */
+inline void write_sizing_profile(const std::filesystem::path& path, std::size_t peak_nodes) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write sizing profile: " + path.string());
+    }
+    out << "peak_nodes=" << peak_nodes << "\n";
+}
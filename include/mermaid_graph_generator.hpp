@@ -34,7 +34,6 @@
 #include "graph_iterator_concepts.hpp"
 #include "graph_render_helpers.hpp"
 #include "node_id_allocator.hpp"
-#include "node_id_helpers.hpp"
 
 namespace mermaid_graph {
 
@@ -225,9 +224,6 @@ void generate_mermaid_graph(const Iterator& root_iterator, std::ostream& out,
     out << "flowchart " << config.direction << "\n";
 
     graph_common::node_id_allocator id_alloc(config.node_id_prefix, config.node_id_start);
-    auto get_node_id = [&](const Iterator& iter) -> std::string {
-        return id_alloc.get_id(iter.get_node_address());
-    };
 
     using graph_render_helpers::render_node_line;
     auto build_node_definition = [&](const Iterator& iter, const std::string& node_id) {
@@ -254,27 +250,19 @@ void generate_mermaid_graph(const Iterator& root_iterator, std::ostream& out,
         return render_edge_line(parent_id, child_id, style, label);
     };
 
-    std::unordered_map<std::string, std::vector<std::string>> class_to_nodes;
-    std::vector<Iterator> unique_nodes;
-
     // Collect nodes and edges in a single traversal to avoid double-walking
-    auto [unique_nodes_local, edges] =
-        dag_walker::collect_nodes_and_edges_topological(root_iterator);
-    unique_nodes = std::move(unique_nodes_local);
-
-    std::unordered_map<const void*, std::vector<dag_walker::EdgeInfo<Iterator>>> edges_by_parent;
-    for (const auto& edge : edges)
-        edges_by_parent[edge.parent.get_node_address()].push_back(edge);
+    auto [unique_nodes, edges] = dag_walker::collect_nodes_and_edges_topological(root_iterator);
+    id_alloc.reserve(unique_nodes.size());
 
-    std::vector<std::pair<std::string, const void*>> parent_ids_and_keys;
-    // Map node address -> emitted node id to avoid repeated linear searches
-    std::unordered_map<const void*, std::string> node_address_to_id;
+    // CSS class of each node by its dense id index, so assignments come out in id order
+    // without parsing the ids back into numbers
+    std::vector<std::pair<size_t, std::string>> node_classes;
     // Collect node definition lines so we can sort them lexicographically
     std::vector<std::string> node_lines;
     node_lines.reserve(unique_nodes.size());
     for (const auto& node : unique_nodes) {
-        std::string node_id = get_node_id(node);
-        node_address_to_id[node.get_node_address()] = node_id;
+        const size_t node_index = id_alloc.get_index(node.get_node_address());
+        const std::string& node_id = id_alloc.get_id(node.get_node_address());
         node_lines.push_back(build_node_definition(node, node_id));
 
         if (config.show_css_classes) {
@@ -289,7 +277,7 @@ void generate_mermaid_graph(const Iterator& root_iterator, std::ostream& out,
                 css_class = config.default_css_class;
             }
             if (!css_class.empty())
-                class_to_nodes[css_class].push_back(node_id);
+                node_classes.emplace_back(node_index, std::move(css_class));
         }
     }
 
@@ -298,50 +286,29 @@ void generate_mermaid_graph(const Iterator& root_iterator, std::ostream& out,
     for (const auto& line : node_lines)
         out << line;
 
-    // collect parent ids in numeric order-aware list for topological emission
-    for (const auto& [parent_key, _] : edges_by_parent) {
-        auto it = node_address_to_id.find(parent_key);
-        if (it != node_address_to_id.end())
-            parent_ids_and_keys.push_back({it->second, parent_key});
-    }
-
-    std::sort(
-        parent_ids_and_keys.begin(), parent_ids_and_keys.end(),
-        [](const auto& a, const auto& b) { return graph_common::node_id_less(a.first, b.first); });
     if (!edges.empty() && !unique_nodes.empty())
         out << "\n";
 
     // Collect all edge definition lines, sort lexicographically, then emit.
     std::vector<std::string> edge_lines;
     edge_lines.reserve(edges.size());
-    for (const auto& [parent_id, parent_key] : parent_ids_and_keys) {
-        auto& parent_edges = edges_by_parent[parent_key];
-        std::sort(parent_edges.begin(), parent_edges.end(),
-                  [](const auto& a, const auto& b) { return a.child_index < b.child_index; });
-        for (const auto& edge : parent_edges) {
-            const void* parent_addr = edge.parent.get_node_address();
-            const void* child_addr = edge.child.get_node_address();
-            auto pit = node_address_to_id.find(parent_addr);
-            auto cit = node_address_to_id.find(child_addr);
-            const std::string& pid =
-                (pit != node_address_to_id.end()) ? pit->second : get_node_id(edge.parent);
-            const std::string& cid =
-                (cit != node_address_to_id.end()) ? cit->second : get_node_id(edge.child);
-            edge_lines.push_back(
-                build_edge_definition(edge.parent, edge.child, edge.child_index, pid, cid));
-        }
+    for (const auto& edge : edges) {
+        const std::string& parent_id = id_alloc.get_id(edge.parent.get_node_address());
+        const std::string& child_id = id_alloc.get_id(edge.child.get_node_address());
+        edge_lines.push_back(
+            build_edge_definition(edge.parent, edge.child, edge.child_index, parent_id, child_id));
     }
 
     std::sort(edge_lines.begin(), edge_lines.end());
     for (const auto& line : edge_lines)
         out << line;
 
-    if (config.show_css_classes && !class_to_nodes.empty()) {
+    if (config.show_css_classes && !node_classes.empty()) {
         out << "\n";
-        auto sorted_class_assignments =
-            graph_render_helpers::flatten_and_sort_class_assignments(class_to_nodes);
-        for (const auto& [node_id, class_name] : sorted_class_assignments) {
-            out << "    class " << node_id << " " << class_name << "\n";
+        std::sort(node_classes.begin(), node_classes.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& [node_index, class_name] : node_classes) {
+            out << "    class " << id_alloc.id_at(node_index) << " " << class_name << "\n";
         }
 
         if (!config.class_definitions.empty()) {
@@ -0,0 +1,431 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file model_count.hpp
+ * @brief Exact counting and lazy enumeration of the solutions of a BDD
+ *
+ * count_solutions() is one memoized bottom-up pass (graph::postorder_fold)
+ * over teddy_view, cudd_view or native_view, so it is linear in the size of
+ * the diagram and never walks individual paths. Each node's count covers the
+ * levels from the node down to the terminals; an edge that skips levels
+ * multiplies the child's count by two per skipped level. Complemented CUDD
+ * and native edges are expanded by the views, so each phase of a node is
+ * counted once. cudd_zdd_view expands the levels a ZDD suppresses, so ZDDs
+ * are counted and enumerated by the same code. Counts are exact at any size
+ * (big_count).
+ *
+ * cube_enumerator walks the paths to the one terminal depth first, keeping
+ * only the current path, and yields one cube per path: each variable is 0, 1
+ * or free. assignment_enumerator expands the free variables of each cube to
+ * yield complete assignments. Both do O(variables) work per solution.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cudd/cudd.h>
+
+#include <cudd/cuddObj.hh>
+#include <libteddy/core.hpp>
+
+#include "cudd_view.hpp"
+#include "cudd_zdd_view.hpp"
+#include "graph.hpp"
+#include "native_bdd.hpp"
+#include "native_view.hpp"
+#include "teddy_view.hpp"
+
+/**
+ * @class big_count
+ * @brief Unsigned integer of arbitrary size, for solution counts
+ *
+ * Only the operations counting needs: addition, multiplication by a power
+ * of two and conversion to decimal text or an approximate double.
+ */
+class big_count {
+   public:
+    big_count() = default;
+
+    explicit big_count(std::uint64_t value) {
+        while (value != 0) {
+            limbs_.push_back(static_cast<std::uint32_t>(value));
+            value >>= 32;
+        }
+    }
+
+    bool is_zero() const {
+        return limbs_.empty();
+    }
+
+    big_count& operator+=(const big_count& other) {
+        if (limbs_.size() < other.limbs_.size()) {
+            limbs_.resize(other.limbs_.size(), 0);
+        }
+        std::uint64_t carry = 0;
+        for (std::size_t i = 0; i < limbs_.size(); ++i) {
+            std::uint64_t sum = carry + limbs_[i];
+            if (i < other.limbs_.size()) {
+                sum += other.limbs_[i];
+            }
+            limbs_[i] = static_cast<std::uint32_t>(sum);
+            carry = sum >> 32;
+        }
+        if (carry != 0) {
+            limbs_.push_back(static_cast<std::uint32_t>(carry));
+        }
+        return *this;
+    }
+
+    friend big_count operator+(big_count a, const big_count& b) {
+        return a += b;
+    }
+
+    /// This value times 2^bits
+    big_count shifted_left(std::size_t bits) const {
+        big_count result;
+        if (is_zero()) {
+            return result;
+        }
+        const std::size_t words = bits / 32;
+        const unsigned shift = static_cast<unsigned>(bits % 32);
+        result.limbs_.assign(words, 0);
+        std::uint32_t carry = 0;
+        for (std::uint32_t limb : limbs_) {
+            result.limbs_.push_back(shift == 0 ? limb : (limb << shift) | carry);
+            carry = shift == 0 ? 0 : limb >> (32 - shift);
+        }
+        if (carry != 0) {
+            result.limbs_.push_back(carry);
+        }
+        return result;
+    }
+
+    /// Decimal representation
+    std::string to_string() const {
+        if (is_zero()) {
+            return "0";
+        }
+        // Repeated division by 10^9 yields nine decimal digits at a time
+        std::vector<std::uint32_t> value = limbs_;
+        std::vector<std::uint32_t> chunks;
+        while (!value.empty()) {
+            std::uint64_t remainder = 0;
+            for (std::size_t i = value.size(); i-- > 0;) {
+                const std::uint64_t current = (remainder << 32) | value[i];
+                value[i] = static_cast<std::uint32_t>(current / 1'000'000'000);
+                remainder = current % 1'000'000'000;
+            }
+            while (!value.empty() && value.back() == 0) {
+                value.pop_back();
+            }
+            chunks.push_back(static_cast<std::uint32_t>(remainder));
+        }
+        std::string text = std::to_string(chunks.back());
+        for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+            const std::string digits = std::to_string(chunks[i]);
+            text += std::string(9 - digits.size(), '0') + digits;
+        }
+        return text;
+    }
+
+    /// Nearest double (infinity beyond its range)
+    double to_double() const {
+        double result = 0.0;
+        for (std::size_t i = limbs_.size(); i-- > 0;) {
+            result = result * 4294967296.0 + limbs_[i];
+        }
+        return result;
+    }
+
+    friend bool operator==(const big_count& a, const big_count& b) = default;
+
+   private:
+    std::vector<std::uint32_t> limbs_;  ///< Little-endian 32-bit words, no leading zeros
+};
+
+namespace model_count_detail {
+
+// Node access for each view: terminal test and value, variable index and level, children
+
+inline bool is_terminal(const teddy_view&, teddy_view::handle h) {
+    return h.p->is_terminal();
+}
+inline bool terminal_value(const teddy_view&, teddy_view::handle h) {
+    return h.p->get_value() != 0;
+}
+inline std::size_t variable_index(const teddy_view&, teddy_view::handle h) {
+    return static_cast<std::size_t>(h.p->get_index());
+}
+inline std::size_t level(const teddy_view& view, teddy_view::handle h) {
+    return static_cast<std::size_t>(view.manager->get_level(h.p->get_index()));
+}
+inline teddy_view::handle child(const teddy_view&, teddy_view::handle h, int branch) {
+    return teddy_view::handle{h.p->get_son(branch)};
+}
+
+inline bool is_terminal(const cudd_view&, cudd_view::handle h) {
+    return Cudd_IsConstant(Cudd_Regular(h.p)) != 0;
+}
+inline bool terminal_value(const cudd_view&, cudd_view::handle h) {
+    return !Cudd_IsComplement(h.p);
+}
+inline std::size_t variable_index(const cudd_view&, cudd_view::handle h) {
+    return static_cast<std::size_t>(Cudd_NodeReadIndex(Cudd_Regular(h.p)));
+}
+inline std::size_t level(const cudd_view& view, cudd_view::handle h) {
+    return static_cast<std::size_t>(
+        view.manager->ReadPerm(static_cast<int>(Cudd_NodeReadIndex(Cudd_Regular(h.p)))));
+}
+inline cudd_view::handle child(const cudd_view&, cudd_view::handle h, int branch) {
+    DdNode* regular = Cudd_Regular(h.p);
+    DdNode* next = branch == 0 ? Cudd_E(regular) : Cudd_T(regular);
+    return cudd_view::handle{Cudd_NotCond(next, Cudd_IsComplement(h.p))};
+}
+
+inline bool is_terminal(const cudd_zdd_view& view, cudd_zdd_view::handle h) {
+    return view.is_terminal(h);
+}
+inline bool terminal_value(const cudd_zdd_view&, cudd_zdd_view::handle h) {
+    return Cudd_V(h.p) != 0;
+}
+inline std::size_t variable_index(const cudd_zdd_view&, cudd_zdd_view::handle h) {
+    return h.level;  // ZDD variables are not reordered
+}
+inline std::size_t level(const cudd_zdd_view&, cudd_zdd_view::handle h) {
+    return h.level;
+}
+inline cudd_zdd_view::handle child(const cudd_zdd_view& view, cudd_zdd_view::handle h,
+                                   int branch) {
+    return view.child(h, branch);
+}
+
+inline bool is_terminal(const native_view&, native_view::handle h) {
+    return native_bdd::is_constant(h.e);
+}
+inline bool terminal_value(const native_view&, native_view::handle h) {
+    return h.e == native_bdd::one_edge;
+}
+inline std::size_t variable_index(const native_view& view, native_view::handle h) {
+    return view.manager->top_var(h.e);
+}
+inline std::size_t level(const native_view& view, native_view::handle h) {
+    return view.manager->top_var(h.e);  // The native package does not reorder
+}
+inline native_view::handle child(const native_view& view, native_view::handle h, int branch) {
+    return native_view::handle{branch == 0 ? view.manager->low(h.e) : view.manager->high(h.e)};
+}
+
+}  // namespace model_count_detail
+
+/**
+ * @brief Counts the satisfying assignments of a diagram over @p variables variables
+ *
+ * @param view teddy_view, cudd_view, cudd_zdd_view or native_view of the diagram (with its
+ *        manager)
+ * @param variables Number of variables the assignments range over, at least
+ *        one more than the deepest level in the diagram
+ * @return Number of assignments mapped to one
+ */
+template <class View>
+big_count count_solutions(const View& view, std::size_t variables) {
+    using handle = typename View::handle;
+    auto level_of = [&](handle h) {
+        return model_count_detail::is_terminal(view, h) ? variables
+                                                        : model_count_detail::level(view, h);
+    };
+
+    // The count of a node covers the levels from the node down to the terminals
+    const handle root = view.roots().front();
+    big_count below = graph::postorder_fold<View, big_count>(
+        view, root, [&](const View& g, handle h, std::span<const big_count> children) {
+            if (model_count_detail::is_terminal(g, h)) {
+                return model_count_detail::terminal_value(g, h) ? big_count(1) : big_count();
+            }
+            const std::size_t here = level_of(h);
+            const handle low = model_count_detail::child(g, h, 0);
+            const handle high = model_count_detail::child(g, h, 1);
+            return children[0].shifted_left(level_of(low) - here - 1)
+                   + children[1].shifted_left(level_of(high) - here - 1);
+        });
+    return below.shifted_left(level_of(root));
+}
+
+/**
+ * @brief Counts the satisfying assignments of a TeDDy BDD over all variables of its manager
+ */
+inline big_count count_solutions(const teddy::bdd_manager& manager,
+                                 const teddy::bdd_manager::diagram_t& f) {
+    return count_solutions(teddy_view(&manager, f),
+                           static_cast<std::size_t>(manager.get_var_count()));
+}
+
+/**
+ * @brief Counts the satisfying assignments of a CUDD BDD over all variables of its manager
+ */
+inline big_count count_solutions(const Cudd& manager, const BDD& f) {
+    return count_solutions(cudd_view(&manager, f.getNode()),
+                           static_cast<std::size_t>(manager.ReadSize()));
+}
+
+/**
+ * @brief Counts the sets of a CUDD ZDD, i.e. the assignments of its function
+ *
+ * The assignments range over all ZDD variables of the manager.
+ */
+inline big_count count_solutions(const Cudd& manager, const ZDD& f) {
+    const auto variables = static_cast<std::uint32_t>(manager.ReadZddSize());
+    return count_solutions(cudd_zdd_view(&manager, f.getNode(), variables), variables);
+}
+
+/**
+ * @brief Counts the satisfying assignments of a native BDD over all variables of its manager
+ */
+inline big_count count_solutions(const native_bdd::manager& manager, const native_bdd::bdd& f) {
+    return count_solutions(native_view(&manager, f.get_edge()), manager.variable_count());
+}
+
+/**
+ * @class cube_enumerator
+ * @brief Lazily yields the paths of a diagram to the one terminal as cubes
+ *
+ * Cubes are disjoint and together cover exactly the satisfying assignments.
+ * Only the current path is stored. Reduced diagrams have no node from which
+ * the one terminal is unreachable, so every call to next() descends at most
+ * once per variable before it finds the next cube.
+ *
+ * @tparam View teddy_view, cudd_view, cudd_zdd_view or native_view
+ */
+template <class View>
+class cube_enumerator {
+   public:
+    /// Value of a variable that the current cube does not test
+    static constexpr std::int8_t free = -1;
+
+    /**
+     * @param view View of the diagram (with its manager)
+     * @param variables Number of variables, as for count_solutions()
+     */
+    cube_enumerator(View view, std::size_t variables)
+        : view_(std::move(view)), cube_(variables, free) {}
+
+    /**
+     * @brief Advances to the next cube
+     * @return false once all cubes have been produced
+     */
+    bool next() {
+        if (!started_) {
+            started_ = true;
+            path_.push_back(frame{view_.roots().front(), 0});
+        } else if (!path_.empty()) {
+            path_.pop_back();  // Leave the terminal of the previous cube
+        }
+        while (!path_.empty()) {
+            frame& top = path_.back();
+            if (model_count_detail::is_terminal(view_, top.node)) {
+                if (model_count_detail::terminal_value(view_, top.node)) {
+                    return true;
+                }
+                path_.pop_back();
+                continue;
+            }
+            const std::size_t index = model_count_detail::variable_index(view_, top.node);
+            if (top.branch < 2) {
+                const int branch = top.branch++;
+                cube_[index] = static_cast<std::int8_t>(branch);
+                const auto next_node = model_count_detail::child(view_, top.node, branch);
+                path_.push_back(frame{next_node, 0});
+            } else {
+                cube_[index] = free;
+                path_.pop_back();
+            }
+        }
+        return false;
+    }
+
+    /// Current cube by variable index: 0, 1 or free
+    const std::vector<std::int8_t>& cube() const {
+        return cube_;
+    }
+
+   private:
+    struct frame {
+        typename View::handle node;
+        int branch;  ///< Next branch to take (2 = both done)
+    };
+
+    View view_;
+    std::vector<std::int8_t> cube_;
+    std::vector<frame> path_;
+    bool started_ = false;
+};
+
+/**
+ * @class assignment_enumerator
+ * @brief Lazily yields every satisfying assignment of a diagram
+ *
+ * Expands the free variables of each cube of cube_enumerator with a binary
+ * counter, so memory stays proportional to the number of variables however
+ * many assignments there are.
+ *
+ * @tparam View teddy_view, cudd_view, cudd_zdd_view or native_view
+ */
+template <class View>
+class assignment_enumerator {
+   public:
+    assignment_enumerator(View view, std::size_t variables)
+        : cubes_(std::move(view), variables), assignment_(variables, 0) {}
+
+    /**
+     * @brief Advances to the next assignment
+     * @return false once all assignments have been produced
+     */
+    bool next() {
+        if (in_cube_) {
+            // Binary increment over the free variables of the current cube
+            for (std::size_t index : free_) {
+                if (assignment_[index] == 0) {
+                    assignment_[index] = 1;
+                    return true;
+                }
+                assignment_[index] = 0;
+            }
+        }
+        in_cube_ = cubes_.next();
+        if (!in_cube_) {
+            return false;
+        }
+        free_.clear();
+        const auto& cube = cubes_.cube();
+        for (std::size_t i = 0; i < cube.size(); ++i) {
+            if (cube[i] == cube_enumerator<View>::free) {
+                free_.push_back(i);
+                assignment_[i] = 0;
+            } else {
+                assignment_[i] = static_cast<std::uint8_t>(cube[i]);
+            }
+        }
+        return true;
+    }
+
+    /// Current assignment by variable index
+    const std::vector<std::uint8_t>& assignment() const {
+        return assignment_;
+    }
+
+   private:
+    cube_enumerator<View> cubes_;
+    std::vector<std::uint8_t> assignment_;
+    std::vector<std::size_t> free_;
+    bool in_cube_ = false;
+};
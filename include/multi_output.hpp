@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file multi_output.hpp
+ * @brief Builds every output of a multi-output expression file in one manager
+ *
+ * A file read with read_program_from_file() holds `let` definitions and
+ * named outputs that refer to the definitions by name. The definitions are
+ * built once, in file order, and every later reference resolves to the
+ * diagram already built, so sub-expressions shared by a family of filters
+ * are converted once instead of once per filter. The outputs share the
+ * nodes of one manager, which the multi-root DOT and node table writers
+ * (write_teddy_outputs_to_dot() and friends) render as one graph.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <libteddy/core.hpp>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <cudd/cudd.h>
+
+#include <cudd/cuddObj.hh>
+
+#include "conversion_limits.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_types.hpp"
+#include "teddy_convert.hpp"
+
+namespace multi_output {
+
+/// Name and diagram of each output, in file order
+template <typename Diagram>
+using named_diagrams = std::vector<std::pair<std::string, Diagram>>;
+
+/**
+ * @brief Boolean variables of a program, in ordered_variable_names() order
+ *
+ * Names that refer to a definition are not variables.
+ */
+inline std::vector<std::string> program_variables(const my_program& program) {
+    std::unordered_set<std::string> names;
+    for (const auto& definition : program.definitions) {
+        collect_variables_with_dag_walker(*definition.expr, names);
+    }
+    for (const auto& output : program.outputs) {
+        collect_variables_with_dag_walker(*output.expr, names);
+    }
+    for (const auto& definition : program.definitions) {
+        names.erase(definition.name);
+    }
+    return ordered_variable_names(names);
+}
+
+/**
+ * @brief Expression nodes of all definitions and outputs (see expression_size())
+ */
+inline std::size_t program_size(const my_program& program) {
+    std::size_t size = 0;
+    for (const auto& definition : program.definitions) {
+        size += expression_size(*definition.expr);
+    }
+    for (const auto& output : program.outputs) {
+        size += expression_size(*output.expr);
+    }
+    return size;
+}
+
+namespace detail {
+
+inline std::unordered_map<std::string, int> index_map(const std::vector<std::string>& names) {
+    std::unordered_map<std::string, int> var_map;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        var_map[names[i]] = static_cast<int>(i);
+    }
+    return var_map;
+}
+
+}  // namespace detail
+
+/// Diagram of each definition by name, as convert_to_bdd_with_map() takes them
+template <typename Diagram>
+using defined_diagrams = std::unordered_map<std::string, Diagram>;
+
+/**
+ * @brief Builds the definitions of @p program in one TeDDy manager, in file order
+ *
+ * Every definition is built once; a reference to an earlier definition
+ * resolves to its diagram. Passing the result to convert_to_bdd_with_map()
+ * builds an expression that refers to the definitions without expanding
+ * them, which keeps a chain of definitions that each use the previous one
+ * several times linear in the length of the chain.
+ *
+ * @param program Definitions to build; the outputs are ignored
+ * @param mgr Manager with a variable for each of @p variables
+ * @param variables Variable order, usually program_variables()
+ * @param budget Limits to enforce over the whole build, or nullptr
+ * @return Diagram of each definition by name
+ * @throws std::runtime_error If a definition uses a variable not in @p variables
+ * @throws conversion_aborted If a limit of @p budget is exceeded
+ */
+inline defined_diagrams<teddy::bdd_manager::diagram_t> build_teddy_definitions(
+    const my_program& program, teddy::bdd_manager& mgr, const std::vector<std::string>& variables,
+    conversion_budget* budget = nullptr) {
+    const auto var_map = detail::index_map(variables);
+    defined_diagrams<teddy::bdd_manager::diagram_t> defined;
+    for (const auto& definition : program.definitions) {
+        defined.insert_or_assign(
+            definition.name,
+            convert_to_bdd_with_map(*definition.expr, mgr, var_map, budget, &defined));
+    }
+    return defined;
+}
+
+/**
+ * @brief Builds the definitions of @p program in one CUDD manager, in file order
+ *
+ * The CUDD counterpart of build_teddy_definitions(), for
+ * convert_to_cudd_bdd_with_map().
+ *
+ * @param program Definitions to build; the outputs are ignored
+ * @param mgr Manager with a variable for each of @p variables
+ * @param variables Variable order, usually program_variables()
+ * @param budget Limits to enforce over the whole build, or nullptr
+ * @return BDD of each definition by name
+ * @throws std::runtime_error If a definition uses a variable not in @p variables
+ * @throws conversion_aborted If a limit of @p budget is exceeded
+ */
+inline defined_diagrams<BDD> build_cudd_definitions(const my_program& program, const Cudd& mgr,
+                                                    const std::vector<std::string>& variables,
+                                                    conversion_budget* budget = nullptr) {
+    const auto var_map = detail::index_map(variables);
+    defined_diagrams<BDD> defined;
+    for (const auto& definition : program.definitions) {
+        defined.insert_or_assign(definition.name,
+                                 convert_to_cudd_bdd_with_map(*definition.expr, mgr, var_map,
+                                                              budget, nullptr, &defined));
+    }
+    return defined;
+}
+
+/**
+ * @brief Builds every output of @p program in one TeDDy manager
+ *
+ * @param program Definitions and outputs
+ * @param mgr Manager with a variable for each of @p variables
+ * @param variables Variable order, usually program_variables()
+ * @param budget Limits to enforce over the whole build, or nullptr
+ * @return Name and diagram of each output
+ * @throws std::runtime_error If an expression uses a variable not in @p variables
+ * @throws conversion_aborted If a limit of @p budget is exceeded
+ */
+inline named_diagrams<teddy::bdd_manager::diagram_t> build_teddy(
+    const my_program& program, teddy::bdd_manager& mgr, const std::vector<std::string>& variables,
+    conversion_budget* budget = nullptr) {
+    const auto var_map = detail::index_map(variables);
+    const auto defined = build_teddy_definitions(program, mgr, variables, budget);
+    named_diagrams<teddy::bdd_manager::diagram_t> outputs;
+    outputs.reserve(program.outputs.size());
+    for (const auto& output : program.outputs) {
+        outputs.emplace_back(output.name,
+                             convert_to_bdd_with_map(*output.expr, mgr, var_map, budget, &defined));
+    }
+    return outputs;
+}
+
+/**
+ * @brief Builds every output of @p program in one CUDD manager
+ *
+ * @param program Definitions and outputs
+ * @param mgr Manager with a variable for each of @p variables
+ * @param variables Variable order, usually program_variables()
+ * @param budget Limits to enforce over the whole build, or nullptr
+ * @return Name and BDD of each output
+ * @throws std::runtime_error If an expression uses a variable not in @p variables
+ * @throws conversion_aborted If a limit of @p budget is exceeded
+ */
+inline named_diagrams<BDD> build_cudd(const my_program& program, const Cudd& mgr,
+                                      const std::vector<std::string>& variables,
+                                      conversion_budget* budget = nullptr) {
+    const auto var_map = detail::index_map(variables);
+    const auto defined = build_cudd_definitions(program, mgr, variables, budget);
+    named_diagrams<BDD> outputs;
+    outputs.reserve(program.outputs.size());
+    for (const auto& output : program.outputs) {
+        outputs.emplace_back(output.name, convert_to_cudd_bdd_with_map(
+                                              *output.expr, mgr, var_map, budget, nullptr,
+                                              &defined));
+    }
+    return outputs;
+}
+
+}  // namespace multi_output
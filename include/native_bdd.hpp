@@ -0,0 +1,729 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file native_bdd.hpp
+ * @brief Header-only BDD package with complement edges
+ *
+ * A small reduced ordered BDD package used as a third backend next to TeDDy
+ * and CUDD. Variable i always sits at level i; the package does not reorder.
+ *
+ * Representation:
+ * - All nodes live in one contiguous arena and are addressed by 32-bit indices
+ * - An edge is a node index shifted left by one with the complement flag in
+ *   bit 0; NOT is a single XOR on the edge
+ * - The then-edge of a stored node is never complemented, which keeps every
+ *   function canonical; the only terminal is the constant one at index 0
+ * - Each level has its own open-addressing unique table (linear probing)
+ * - ITE results are memoized in a lossy direct-mapped computed cache
+ * - ITE is evaluated with an explicit stack, so deep diagrams cannot
+ *   overflow the call stack
+ * - Unreferenced nodes are reclaimed by mark-and-sweep from the nodes held by
+ *   bdd handles; collection only runs at the start of a top-level operation
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace native_bdd {
+
+/// Reference to a node: index << 1, with the complement flag in bit 0
+using edge = std::uint32_t;
+
+/// The constant one (regular edge to the terminal)
+constexpr edge one_edge = 0;
+/// The constant zero (complemented edge to the terminal)
+constexpr edge zero_edge = 1;
+
+/// Variable stored in the terminal node, below every real variable
+constexpr std::uint32_t terminal_var = std::numeric_limits<std::uint32_t>::max() - 1;
+/// Variable stored in a node that is on the free list
+constexpr std::uint32_t free_var = std::numeric_limits<std::uint32_t>::max();
+
+constexpr std::uint32_t node_index(edge e) {
+    return e >> 1;
+}
+
+constexpr bool is_complement(edge e) {
+    return (e & 1) != 0;
+}
+
+constexpr edge regular(edge e) {
+    return e & ~edge{1};
+}
+
+constexpr edge negate(edge e) {
+    return e ^ 1;
+}
+
+constexpr bool is_constant(edge e) {
+    return e <= zero_edge;
+}
+
+/// Hash of a node's children, used by the unique tables
+inline std::size_t hash_pair(edge low, edge high) {
+    std::uint64_t key = (std::uint64_t{low} << 32) | high;
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+    return static_cast<std::size_t>(key);
+}
+
+/// Hash of an ITE triple, used by the computed caches
+inline std::size_t hash_triple(edge f, edge g, edge h) {
+    std::uint64_t key = (std::uint64_t{f} << 32 | g) * 0x9E3779B97F4A7C15ULL;
+    key ^= std::uint64_t{h} * 0xC2B2AE3D27D4EB4FULL;
+    key ^= key >> 29;
+    return static_cast<std::size_t>(key);
+}
+
+/**
+ * @brief Reduces ITE operands to a standard triple or a final result
+ *
+ * Terminal cases are resolved, commuted forms of AND, OR and XOR are ordered
+ * so they share one cache entry, and f and g are made regular; the result of
+ * the reduced triple must then be negated if @p negate_result is set.
+ *
+ * @return true if the result is known and stored in @p result
+ */
+inline bool normalize_ite(edge& f, edge& g, edge& h, bool& negate_result, edge& result) {
+    if (f == one_edge) {
+        result = g;
+        return true;
+    }
+    if (f == zero_edge) {
+        result = h;
+        return true;
+    }
+    if (g == f) {
+        g = one_edge;
+    } else if (g == negate(f)) {
+        g = zero_edge;
+    }
+    if (h == f) {
+        h = zero_edge;
+    } else if (h == negate(f)) {
+        h = one_edge;
+    }
+    if (g == h) {
+        result = g;
+        return true;
+    }
+    if (g == one_edge && h == zero_edge) {
+        result = f;
+        return true;
+    }
+    if (g == zero_edge && h == one_edge) {
+        result = negate(f);
+        return true;
+    }
+
+    // Commuted forms of AND, OR and XOR share one cache entry
+    if (h == zero_edge && regular(g) < regular(f)) {
+        std::swap(f, g);
+    } else if (g == one_edge && regular(h) < regular(f)) {
+        std::swap(f, h);
+    } else if (h == negate(g) && regular(g) < regular(f)) {
+        std::swap(f, g);
+        h = negate(g);
+    }
+
+    // Regular f, then regular g
+    if (is_complement(f)) {
+        f = negate(f);
+        std::swap(g, h);
+    }
+    if (is_complement(g)) {
+        g = negate(g);
+        h = negate(h);
+        negate_result = !negate_result;
+    }
+    return false;
+}
+
+/**
+ * @brief Arena record of one decision node
+ */
+struct node {
+    std::uint32_t var;   ///< Variable index (terminal_var or free_var for special nodes)
+    edge low;            ///< Else child; may be complemented
+    edge high;           ///< Then child; never complemented
+    std::uint32_t refs;  ///< External references from bdd handles (saturating)
+};
+
+/**
+ * @brief Sizing options for a manager
+ */
+struct manager_config {
+    /// Arena size that triggers the first garbage collection
+    std::size_t initial_nodes = std::size_t{1} << 16;
+    /// Initial computed cache entries (rounded up to a power of two)
+    std::size_t cache_entries = std::size_t{1} << 12;
+    /// Upper bound for the computed cache as it grows with the arena
+    std::size_t max_cache_entries = std::size_t{1} << 22;
+};
+
+/**
+ * @brief Counters describing the state of a manager
+ */
+struct statistics {
+    std::size_t live_nodes = 0;    ///< Nodes in use, including the terminal
+    std::size_t arena_nodes = 0;   ///< Arena records, including free ones
+    std::size_t peak_nodes = 0;    ///< Largest number of nodes in use
+    std::size_t gc_runs = 0;       ///< Completed garbage collections
+    std::size_t cache_lookups = 0; ///< Computed cache probes
+    std::size_t cache_hits = 0;    ///< Computed cache probes that found a result
+};
+
+class manager;
+
+/**
+ * @class bdd
+ * @brief Reference-counted handle to a function of a manager
+ *
+ * Holding a handle keeps its nodes alive across garbage collections. The
+ * manager must outlive all of its handles.
+ */
+class bdd {
+   public:
+    bdd() = default;
+    bdd(manager* mgr, edge e);
+    bdd(const bdd& other);
+    bdd(bdd&& other) noexcept;
+    bdd& operator=(const bdd& other);
+    bdd& operator=(bdd&& other) noexcept;
+    ~bdd();
+
+    edge get_edge() const {
+        return edge_;
+    }
+
+    manager* get_manager() const {
+        return manager_;
+    }
+
+    bool is_zero() const {
+        return edge_ == zero_edge;
+    }
+
+    bool is_one() const {
+        return edge_ == one_edge;
+    }
+
+    bool is_constant() const {
+        return native_bdd::is_constant(edge_);
+    }
+
+    /// Complement in constant time
+    bdd operator!() const {
+        return bdd(manager_, negate(edge_));
+    }
+
+    friend bdd operator&(const bdd& f, const bdd& g);
+    friend bdd operator|(const bdd& f, const bdd& g);
+    friend bdd operator^(const bdd& f, const bdd& g);
+
+    /// Same function of the same manager (constant time, by canonicity)
+    friend bool operator==(const bdd& f, const bdd& g) {
+        return f.manager_ == g.manager_ && f.edge_ == g.edge_;
+    }
+
+   private:
+    void acquire() const;
+    void release() const;
+
+    manager* manager_ = nullptr;
+    edge edge_ = zero_edge;
+};
+
+/**
+ * @class manager
+ * @brief Owner of the node arena, unique tables and computed cache
+ */
+class manager {
+   public:
+    /**
+     * @brief Creates a manager over a fixed number of variables
+     *
+     * @param variable_count Number of variables; variable i is at level i
+     * @param config Arena and cache sizing
+     * @throws std::runtime_error If variable_count does not fit a node record
+     */
+    explicit manager(std::uint32_t variable_count, const manager_config& config = {})
+        : variable_count_(variable_count),
+          config_(config),
+          gc_trigger_(std::max<std::size_t>(config.initial_nodes, 2)),
+          levels_(variable_count) {
+        if (variable_count >= terminal_var) {
+            throw std::runtime_error("Too many variables for a native BDD manager");
+        }
+        nodes_.push_back(node{terminal_var, one_edge, one_edge, 0});
+        live_nodes_ = 1;
+        peak_nodes_ = 1;
+        resize_cache(config.cache_entries);
+    }
+
+    manager(const manager&) = delete;
+    manager& operator=(const manager&) = delete;
+
+    std::uint32_t variable_count() const {
+        return variable_count_;
+    }
+
+    bdd zero() {
+        return bdd(this, zero_edge);
+    }
+
+    bdd one() {
+        return bdd(this, one_edge);
+    }
+
+    /**
+     * @brief Returns the projection function of a variable
+     * @throws std::runtime_error If the index is out of range
+     */
+    bdd variable(std::uint32_t index) {
+        if (index >= variable_count_) {
+            throw std::runtime_error("Variable index " + std::to_string(index)
+                                     + " out of range for " + std::to_string(variable_count_)
+                                     + " variables");
+        }
+        maybe_collect();
+        return bdd(this, make_node(index, zero_edge, one_edge));
+    }
+
+    /**
+     * @brief If-then-else: (f AND g) OR (NOT f AND h)
+     * @throws std::runtime_error If an operand belongs to another manager
+     */
+    bdd ite(const bdd& f, const bdd& g, const bdd& h) {
+        check_owner(f);
+        check_owner(g);
+        check_owner(h);
+        maybe_collect();
+        return bdd(this, ite_edge(f.get_edge(), g.get_edge(), h.get_edge()));
+    }
+
+    bdd apply_and(const bdd& f, const bdd& g) {
+        return ite(f, g, zero());
+    }
+
+    bdd apply_or(const bdd& f, const bdd& g) {
+        return ite(f, one(), g);
+    }
+
+    bdd apply_xor(const bdd& f, const bdd& g) {
+        return ite(f, !g, g);
+    }
+
+    /**
+     * @brief Evaluates a function for one assignment
+     *
+     * @param f Function to evaluate
+     * @param values One value per variable (0 = false, otherwise true)
+     * @throws std::runtime_error If fewer values than variables are given
+     */
+    bool evaluate(const bdd& f, std::span<const std::uint8_t> values) const {
+        if (values.size() < variable_count_) {
+            throw std::runtime_error("Assignment has " + std::to_string(values.size())
+                                     + " values, expected " + std::to_string(variable_count_));
+        }
+        edge e = f.get_edge();
+        while (!is_constant(e)) {
+            const node& n = nodes_[node_index(e)];
+            e = (values[n.var] != 0 ? n.high : n.low) ^ (e & 1);
+        }
+        return e == one_edge;
+    }
+
+    /**
+     * @brief Number of distinct nodes of a function, counting the terminal
+     *
+     * A node reached through both a regular and a complemented edge is
+     * counted once, as CUDD's Cudd_DagSize does.
+     */
+    std::size_t node_count(const bdd& f) const {
+        std::vector<std::uint8_t> seen(nodes_.size(), 0);
+        std::vector<std::uint32_t> pending = {node_index(f.get_edge())};
+        std::size_t count = 0;
+        while (!pending.empty()) {
+            std::uint32_t index = pending.back();
+            pending.pop_back();
+            if (seen[index] != 0) {
+                continue;
+            }
+            seen[index] = 1;
+            ++count;
+            if (index != 0) {
+                pending.push_back(node_index(nodes_[index].low));
+                pending.push_back(node_index(nodes_[index].high));
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Reclaims every node that no bdd handle can reach
+     */
+    void collect_garbage() {
+        std::vector<std::uint8_t> marked(nodes_.size(), 0);
+        std::vector<std::uint32_t> pending;
+        marked[0] = 1;
+        for (std::uint32_t i = 1; i < nodes_.size(); ++i) {
+            if (nodes_[i].var != free_var && nodes_[i].refs != 0) {
+                pending.push_back(i);
+            }
+        }
+        while (!pending.empty()) {
+            std::uint32_t index = pending.back();
+            pending.pop_back();
+            if (marked[index] != 0) {
+                continue;
+            }
+            marked[index] = 1;
+            pending.push_back(node_index(nodes_[index].low));
+            pending.push_back(node_index(nodes_[index].high));
+        }
+
+        // Sweep into the free list, then rebuild the tables from the survivors
+        free_list_ = 0;
+        live_nodes_ = 1;
+        for (auto& table : levels_) {
+            std::fill(table.slots.begin(), table.slots.end(), 0);
+            table.used = 0;
+        }
+        for (auto i = static_cast<std::uint32_t>(nodes_.size() - 1); i > 0; --i) {
+            node& n = nodes_[i];
+            if (marked[i] == 0) {
+                n = node{free_var, free_list_, 0, 0};
+                free_list_ = i;
+                continue;
+            }
+            ++live_nodes_;
+            insert_unique(n.var, i);
+        }
+        free_count_ = nodes_.size() - live_nodes_;
+        std::fill(cache_.begin(), cache_.end(), cache_entry{});
+        ++gc_runs_;
+    }
+
+    statistics get_statistics() const {
+        return statistics{live_nodes_, nodes_.size(), peak_nodes_, gc_runs_, cache_lookups_,
+                          cache_hits_};
+    }
+
+    /**
+     * @brief Arena record of a node, for iterators and views
+     */
+    const node& get_node(std::uint32_t index) const {
+        return nodes_[index];
+    }
+
+    /// Variable at the top of an edge (terminal_var for constants)
+    std::uint32_t top_var(edge e) const {
+        return nodes_[node_index(e)].var;
+    }
+
+    /// Else child of a non-constant edge, with the complement pushed down
+    edge low(edge e) const {
+        return nodes_[node_index(e)].low ^ (e & 1);
+    }
+
+    /// Then child of a non-constant edge, with the complement pushed down
+    edge high(edge e) const {
+        return nodes_[node_index(e)].high ^ (e & 1);
+    }
+
+   private:
+    friend class bdd;
+
+    struct level_table {
+        std::vector<std::uint32_t> slots;  ///< Node indices; 0 marks an empty slot
+        std::size_t used = 0;
+    };
+
+    struct cache_entry {
+        edge f = free_var;
+        edge g = 0;
+        edge h = 0;
+        edge result = 0;
+    };
+
+    struct ite_frame {
+        edge f, g, h;
+        std::uint32_t var;
+        edge low;
+        bool negate_result;
+        std::uint8_t stage;  ///< 0 = new, 1 = waiting for low, 2 = waiting for high
+    };
+
+    void check_owner(const bdd& f) const {
+        if (f.get_manager() != this) {
+            throw std::runtime_error("BDD operand belongs to a different manager");
+        }
+    }
+
+    void resize_cache(std::size_t entries) {
+        cache_.assign(std::bit_ceil(std::max<std::size_t>(entries, 2)), cache_entry{});
+    }
+
+    /**
+     * @brief Collects garbage at a safe point once the arena reaches its trigger
+     *
+     * The trigger moves to twice the surviving node count, so collection cost
+     * stays proportional to allocation.
+     */
+    void maybe_collect() {
+        if (free_count_ != 0 || nodes_.size() < gc_trigger_) {
+            return;
+        }
+        collect_garbage();
+        gc_trigger_ = std::max(gc_trigger_, 2 * live_nodes_);
+    }
+
+    void insert_unique(std::uint32_t var, std::uint32_t index) {
+        level_table& table = levels_[var];
+        if (2 * (table.used + 1) > table.slots.size()) {
+            grow_level(table);
+        }
+        const std::size_t mask = table.slots.size() - 1;
+        std::size_t slot = hash_pair(nodes_[index].low, nodes_[index].high) & mask;
+        while (table.slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        table.slots[slot] = index;
+        ++table.used;
+    }
+
+    void grow_level(level_table& table) {
+        std::vector<std::uint32_t> old = std::move(table.slots);
+        table.slots.assign(std::max<std::size_t>(old.size() * 2, 16), 0);
+        const std::size_t mask = table.slots.size() - 1;
+        for (std::uint32_t index : old) {
+            if (index == 0) {
+                continue;
+            }
+            std::size_t slot = hash_pair(nodes_[index].low, nodes_[index].high) & mask;
+            while (table.slots[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            table.slots[slot] = index;
+        }
+    }
+
+    /**
+     * @brief Finds or creates the node (var, low, high) in canonical form
+     */
+    edge make_node(std::uint32_t var, edge low, edge high) {
+        if (low == high) {
+            return low;
+        }
+        // Keep then-edges regular: (v, l, ~h) is stored as ~(v, ~l, h)
+        const edge flip = high & 1;
+        low ^= flip;
+        high ^= flip;
+
+        level_table& table = levels_[var];
+        if (2 * (table.used + 1) > table.slots.size()) {
+            grow_level(table);
+        }
+        const std::size_t mask = table.slots.size() - 1;
+        std::size_t slot = hash_pair(low, high) & mask;
+        while (table.slots[slot] != 0) {
+            const node& n = nodes_[table.slots[slot]];
+            if (n.low == low && n.high == high) {
+                return (table.slots[slot] << 1) | flip;
+            }
+            slot = (slot + 1) & mask;
+        }
+
+        std::uint32_t index;
+        if (free_list_ != 0) {
+            index = free_list_;
+            free_list_ = nodes_[index].low;
+            --free_count_;
+            nodes_[index] = node{var, low, high, 0};
+        } else {
+            if (nodes_.size() > (std::numeric_limits<std::uint32_t>::max() >> 1)) {
+                throw std::runtime_error("Native BDD arena exhausted");
+            }
+            index = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.push_back(node{var, low, high, 0});
+            // The cache grows with the arena; dropping its entries is always safe
+            if (nodes_.size() > 2 * cache_.size() && cache_.size() < config_.max_cache_entries) {
+                resize_cache(cache_.size() * 2);
+            }
+        }
+        table.slots[slot] = index;
+        ++table.used;
+        peak_nodes_ = std::max(peak_nodes_, ++live_nodes_);
+        return (index << 1) | flip;
+    }
+
+    edge cofactor(edge e, std::uint32_t var, bool value) const {
+        if (top_var(e) != var) {
+            return e;
+        }
+        return value ? high(e) : low(e);
+    }
+
+    edge ite_edge(edge f, edge g, edge h) {
+        stack_.clear();
+        stack_.push_back(ite_frame{f, g, h, 0, 0, false, 0});
+        edge result = 0;
+        bool have_result = false;
+        while (true) {
+            ite_frame& fr = stack_.back();
+            if (have_result) {
+                if (fr.stage == 1) {
+                    fr.low = result;
+                    fr.stage = 2;
+                    have_result = false;
+                    ite_frame child{cofactor(fr.f, fr.var, true), cofactor(fr.g, fr.var, true),
+                                    cofactor(fr.h, fr.var, true), 0, 0, false, 0};
+                    stack_.push_back(child);
+                    continue;
+                }
+                edge r = make_node(fr.var, fr.low, result);
+                cache_entry& entry = cache_[hash_triple(fr.f, fr.g, fr.h) & (cache_.size() - 1)];
+                entry = cache_entry{fr.f, fr.g, fr.h, r};
+                result = fr.negate_result ? negate(r) : r;
+            } else {
+                edge known = 0;
+                if (normalize_ite(fr.f, fr.g, fr.h, fr.negate_result, known)) {
+                    result = fr.negate_result ? negate(known) : known;
+                } else {
+                    ++cache_lookups_;
+                    const cache_entry& entry =
+                        cache_[hash_triple(fr.f, fr.g, fr.h) & (cache_.size() - 1)];
+                    if (entry.f == fr.f && entry.g == fr.g && entry.h == fr.h) {
+                        ++cache_hits_;
+                        result = fr.negate_result ? negate(entry.result) : entry.result;
+                    } else {
+                        fr.var = std::min({top_var(fr.f), top_var(fr.g), top_var(fr.h)});
+                        fr.stage = 1;
+                        ite_frame child{cofactor(fr.f, fr.var, false),
+                                        cofactor(fr.g, fr.var, false),
+                                        cofactor(fr.h, fr.var, false), 0, 0, false, 0};
+                        stack_.push_back(child);
+                        continue;
+                    }
+                }
+            }
+            stack_.pop_back();
+            if (stack_.empty()) {
+                return result;
+            }
+            have_result = true;
+        }
+    }
+
+    void add_ref(edge e) {
+        std::uint32_t& refs = nodes_[node_index(e)].refs;
+        if (refs != std::numeric_limits<std::uint32_t>::max()) {
+            ++refs;
+        }
+    }
+
+    void drop_ref(edge e) {
+        std::uint32_t& refs = nodes_[node_index(e)].refs;
+        if (refs != 0 && refs != std::numeric_limits<std::uint32_t>::max()) {
+            --refs;
+        }
+    }
+
+    std::uint32_t variable_count_;
+    manager_config config_;
+    std::size_t gc_trigger_;
+    std::vector<node> nodes_;
+    std::vector<level_table> levels_;
+    std::vector<cache_entry> cache_;
+    std::vector<ite_frame> stack_;
+    std::uint32_t free_list_ = 0;  ///< Head of the free list (0 when empty)
+    std::size_t free_count_ = 0;
+    std::size_t live_nodes_ = 0;
+    std::size_t peak_nodes_ = 0;
+    std::size_t gc_runs_ = 0;
+    std::size_t cache_lookups_ = 0;
+    std::size_t cache_hits_ = 0;
+};
+
+// ============================================================================
+// bdd handle members (need the complete manager)
+// ============================================================================
+
+inline bdd::bdd(manager* mgr, edge e) : manager_(mgr), edge_(e) {
+    acquire();
+}
+
+inline bdd::bdd(const bdd& other) : manager_(other.manager_), edge_(other.edge_) {
+    acquire();
+}
+
+inline bdd::bdd(bdd&& other) noexcept : manager_(other.manager_), edge_(other.edge_) {
+    other.manager_ = nullptr;
+}
+
+inline bdd& bdd::operator=(const bdd& other) {
+    if (this != &other) {
+        other.acquire();
+        release();
+        manager_ = other.manager_;
+        edge_ = other.edge_;
+    }
+    return *this;
+}
+
+inline bdd& bdd::operator=(bdd&& other) noexcept {
+    if (this != &other) {
+        release();
+        manager_ = other.manager_;
+        edge_ = other.edge_;
+        other.manager_ = nullptr;
+    }
+    return *this;
+}
+
+inline bdd::~bdd() {
+    release();
+}
+
+inline void bdd::acquire() const {
+    if (manager_ != nullptr) {
+        manager_->add_ref(edge_);
+    }
+}
+
+inline void bdd::release() const {
+    if (manager_ != nullptr) {
+        manager_->drop_ref(edge_);
+    }
+}
+
+inline bdd operator&(const bdd& f, const bdd& g) {
+    return f.get_manager()->apply_and(f, g);
+}
+
+inline bdd operator|(const bdd& f, const bdd& g) {
+    return f.get_manager()->apply_or(f, g);
+}
+
+inline bdd operator^(const bdd& f, const bdd& g) {
+    return f.get_manager()->apply_xor(f, g);
+}
+
+}  // namespace native_bdd
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file native_convert.hpp
+ * @brief Conversion of expression trees into the native BDD package
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+#include "cardinality_bdd.hpp"
+#include "expression_graph.hpp"
+#include "expression_types.hpp"
+#include "field_compare_bdd.hpp"
+#include "native_bdd.hpp"
+
+namespace native_convert_detail {
+
+/**
+ * @brief Expression conversion shared by the native and parallel packages
+ *
+ * @tparam Manager native_bdd::manager or parallel_bdd::manager
+ * @param package Name printed with the variable ordering
+ */
+template <class Manager>
+auto convert(const my_expression& expr, Manager& mgr, const char* package) {
+    using bdd = decltype(mgr.zero());
+
+    std::unordered_set<std::string> variable_names;
+    collect_variables_with_dag_walker(expr, variable_names);
+    std::vector<std::string> sorted_vars = ordered_variable_names(variable_names);
+
+    std::cout << package << " variable ordering: ";
+    for (size_t i = 0; i < sorted_vars.size(); ++i) {
+        std::cout << sorted_vars[i] << "=" << i;
+        if (i < sorted_vars.size() - 1)
+            std::cout << ", ";
+    }
+    std::cout << std::endl;
+
+    if (sorted_vars.size() > mgr.variable_count()) {
+        throw std::runtime_error(std::string(package) + " BDD manager has "
+                                 + std::to_string(mgr.variable_count())
+                                 + " variables, the expression needs "
+                                 + std::to_string(sorted_vars.size()));
+    }
+    std::unordered_map<std::string, std::uint32_t> var_map;
+    for (size_t i = 0; i < sorted_vars.size(); ++i) {
+        var_map[sorted_vars[i]] = static_cast<std::uint32_t>(i);
+    }
+
+    auto ite = [&mgr](const bdd& f, const bdd& g, const bdd& h) { return mgr.ite(f, g, h); };
+
+    std::function<bdd(const my_expression&)> convert_recursive = [&](const my_expression& e) {
+        return std::visit(
+            [&](const auto& content) -> bdd {
+                using T = std::decay_t<decltype(content)>;
+
+                if constexpr (std::is_same_v<T, my_variable>) {
+                    auto it = var_map.find(content.variable_name);
+                    if (it == var_map.end()) {
+                        throw std::runtime_error("Variable not found: " + content.variable_name);
+                    }
+                    return mgr.variable(it->second);
+                } else if constexpr (std::is_same_v<T, my_not>) {
+                    return !convert_recursive(*content.expr);
+                } else if constexpr (std::is_same_v<T, my_and>) {
+                    bdd left = convert_recursive(*content.left);
+                    bdd right = convert_recursive(*content.right);
+                    return mgr.apply_and(left, right);
+                } else if constexpr (std::is_same_v<T, my_or>) {
+                    bdd left = convert_recursive(*content.left);
+                    bdd right = convert_recursive(*content.right);
+                    return mgr.apply_or(left, right);
+                } else if constexpr (std::is_same_v<T, my_xor>) {
+                    bdd left = convert_recursive(*content.left);
+                    bdd right = convert_recursive(*content.right);
+                    return mgr.apply_xor(left, right);
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    std::vector<std::pair<int, bdd>> operands;
+                    operands.reserve(content.operands.size());
+                    for (const auto& operand : content.operands) {
+                        bdd operand_bdd = convert_recursive(*operand);
+                        // Variable index and level coincide in these packages
+                        int level = cardinality_bdd::operand_level(
+                            *operand, [&](const std::string& name) {
+                                return static_cast<int>(var_map.at(name));
+                            });
+                        operands.emplace_back(level, std::move(operand_bdd));
+                    }
+                    return cardinality_bdd::build(content, std::move(operands), mgr.zero(),
+                                                  mgr.one(), ite);
+                } else if constexpr (std::is_same_v<T, my_compare>) {
+                    auto var = [&](const std::string& name) {
+                        return mgr.variable(var_map.at(name));
+                    };
+                    return field_compare_bdd::build(content, var, mgr.zero(), mgr.one(), ite);
+                } else if constexpr (std::is_same_v<T, my_constant>) {
+                    return content.value ? mgr.one() : mgr.zero();
+                }
+                throw std::runtime_error("Unknown expression type");
+            },
+            e);
+    };
+
+    return convert_recursive(expr);
+}
+
+}  // namespace native_convert_detail
+
+/**
+ * @brief Converts an expression tree to a native BDD
+ *
+ * Uses the same variable order as convert_to_bdd and convert_to_cudd_bdd:
+ * variable i of @p mgr is the i-th name of ordered_variable_names(). NOT is
+ * a complement edge; cardinality constraints and field comparisons are built
+ * with the package's ITE as in the other backends.
+ *
+ * @param expr The root expression to convert
+ * @param mgr Manager with at least as many variables as the expression uses
+ * @return Handle to the function of @p expr
+ * @throws std::runtime_error If a variable is not found or the manager is too small
+ */
+inline native_bdd::bdd convert_to_native_bdd(const my_expression& expr,
+                                             native_bdd::manager& mgr) {
+    return native_convert_detail::convert(expr, mgr, "Native");
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file native_graph.hpp
+ * @brief Native BDD graph generation using generic template systems
+ *
+ * Output functions for diagrams of the native BDD package. They drive the same
+ * generic DOT, Mermaid, node table and C code templates as the TeDDy and CUDD
+ * writers through native_iterator, which expands complement edges, so the
+ * output is identical to theirs for the same function and variable order.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "c_code_generator.hpp"
+#include "native_bdd.hpp"
+
+/**
+ * @brief Writes a native BDD as DOT graph using the generic template system
+ *
+ * @param manager Manager owning the diagram
+ * @param f Diagram to render
+ * @param variable_names Vector of variable names for labeling
+ * @param out Output stream for DOT content
+ * @param graph_name Name for the generated DOT graph (default: "DD")
+ */
+void write_native_to_dot(const native_bdd::manager& manager, const native_bdd::bdd& f,
+                         const std::vector<std::string>& variable_names, std::ostream& out,
+                         const std::string& graph_name = "DD");
+
+/**
+ * @brief Writes a native BDD as Mermaid graph using the generic template system
+ *
+ * @param manager Manager owning the diagram
+ * @param f Diagram to render
+ * @param variable_names Vector of variable names for labeling
+ * @param out Output stream for Mermaid content
+ * @param graph_title Title for the generated Mermaid graph (default: "BDD")
+ */
+void write_native_to_mermaid(const native_bdd::manager& manager, const native_bdd::bdd& f,
+                             const std::vector<std::string>& variable_names, std::ostream& out,
+                             const std::string& graph_title = "BDD");
+
+/**
+ * @brief Writes a native BDD node table to output stream using generic template
+ *
+ * @param manager Manager owning the diagram
+ * @param f Diagram to analyze
+ * @param variable_names Vector of variable names for display
+ * @param out Output stream to write the table to
+ * @param include_headers Whether to include descriptive headers and footers (default: true)
+ */
+void write_native_nodes_to_stream(const native_bdd::manager& manager, const native_bdd::bdd& f,
+                                  const std::vector<std::string>& variable_names,
+                                  std::ostream& out, bool include_headers = true);
+
+/**
+ * @brief Writes a native BDD node table in Markdown format using generic template
+ *
+ * @param manager Manager owning the diagram
+ * @param f Diagram to analyze
+ * @param variable_names Vector of variable names for display
+ * @param out Output stream to write the Markdown table to
+ */
+void write_native_nodes_to_markdown(const native_bdd::manager& manager, const native_bdd::bdd& f,
+                                    const std::vector<std::string>& variable_names,
+                                    std::ostream& out);
+
+/**
+ * @brief Writes a native BDD as a self-contained C evaluator
+ *
+ * @param manager Manager owning the diagram
+ * @param f Diagram to compile
+ * @param variable_names Vector of variable names, in input bit order
+ * @param out Output stream for the C source
+ * @param config Function name and code style options
+ * @throws std::runtime_error If the configuration is invalid for this BDD
+ */
+void write_native_to_c(const native_bdd::manager& manager, const native_bdd::bdd& f,
+                       const std::vector<std::string>& variable_names, std::ostream& out,
+                       const c_code::CCodeConfig& config = c_code::CCodeConfig());
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file native_iterator.hpp
+ * @brief Native BDD iterator interface for graph traversal
+ *
+ * This file provides the iterator class for traversing diagrams of the native
+ * BDD package (native_bdd.hpp). The iterator is compatible with the generic
+ * graph generation templates.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "native_bdd.hpp"
+
+/**
+ * @brief Iterator for traversing native BDD structures with generic template properties
+ *
+ * Like cudd_iterator, this expands complement edges: a node reached through a
+ * complemented edge is reported as a distinct node whose children and terminal
+ * value are complemented, so the output matches TeDDy's explicit structure.
+ */
+class native_iterator {
+   private:
+    const native_bdd::manager* manager_;              ///< Owning manager
+    native_bdd::edge edge_;                           ///< Current edge (may be complemented)
+    const std::vector<std::string>* variable_names_;  ///< Variable names for display
+
+   public:
+    /**
+     * @brief Construct iterator for a native BDD edge
+     * @param manager Manager owning the diagram
+     * @param e Edge to the node (the complement flag is part of the identity)
+     * @param variable_names Variable names for display
+     */
+    native_iterator(const native_bdd::manager& manager, native_bdd::edge e,
+                    const std::vector<std::string>* variable_names)
+        : manager_(&manager), edge_(e), variable_names_(variable_names) {}
+
+    // ========================================================================
+    // BaseGraphIterator Interface Requirements
+    // ========================================================================
+
+    /**
+     * @brief Get child iterators for this node
+     * @return FALSE (else) child first, TRUE (then) child second; empty for terminals
+     */
+    std::vector<native_iterator> get_children() const {
+        std::vector<native_iterator> children;
+        if (!is_terminal()) {
+            children.reserve(2);
+            children.emplace_back(*manager_, manager_->low(edge_), variable_names_);
+            children.emplace_back(*manager_, manager_->high(edge_), variable_names_);
+        }
+        return children;
+    }
+
+    /**
+     * @brief Get unique address for this node (for equality comparisons)
+     *
+     * The address of the arena record with the complement flag in the low bit,
+     * so a node and its complement are distinct.
+     */
+    const void* get_node_address() const {
+        const auto* record = &manager_->get_node(native_bdd::node_index(edge_));
+        return reinterpret_cast<const void*>(reinterpret_cast<std::uintptr_t>(record)
+                                             | (edge_ & 1));
+    }
+
+    bool operator==(const native_iterator& other) const {
+        return manager_ == other.manager_ && edge_ == other.edge_;
+    }
+
+    bool operator!=(const native_iterator& other) const {
+        return !(*this == other);
+    }
+
+    // ========================================================================
+    // DOT Graph Generator Interface
+    // ========================================================================
+
+    std::string get_label() const {
+        if (is_terminal()) {
+            return get_terminal_value() ? "1" : "0";
+        }
+        return get_variable_name();
+    }
+
+    std::string get_dot_node_attributes() const {
+        if (is_terminal()) {
+            std::string color = get_terminal_value() == 1 ? "lightgreen" : "lightcoral";
+            return std::format("shape=box,style=filled,fillcolor={}", color);
+        }
+        return "shape=circle";
+    }
+
+    std::string get_edge_style(const native_iterator& child, size_t child_index) const {
+        return child_index == 0 ? "dashed" : "solid";
+    }
+
+    std::string get_shape() const {
+        return is_terminal() ? "square" : "circle";
+    }
+
+    std::string get_tooltip() const {
+        if (is_terminal()) {
+            return std::to_string(get_terminal_value());
+        }
+        return std::to_string(manager_->top_var(edge_));
+    }
+
+    std::string get_css_class() const {
+        return is_terminal() ? "terminal" : "bddVariable";
+    }
+
+    std::string get_dot_edge_attributes(const native_iterator& child, size_t child_index) const {
+        return child_index == 0 ? "label=\"0\",style=dashed" : "label=\"1\",style=solid";
+    }
+
+    // ========================================================================
+    // Node Table Generator Interface
+    // ========================================================================
+
+    std::string get_variable_name() const {
+        if (is_terminal()) {
+            return "-";
+        }
+        std::uint32_t var = manager_->top_var(edge_);
+        if (variable_names_ && var < variable_names_->size()) {
+            return (*variable_names_)[var];
+        }
+        return std::format("x{}", var);
+    }
+
+    bool is_terminal() const {
+        return native_bdd::is_constant(edge_);
+    }
+
+    /**
+     * @brief Get terminal value (only valid for terminal nodes)
+     */
+    int get_terminal_value() const {
+        if (!is_terminal()) {
+            throw std::runtime_error("get_terminal_value called on non-terminal node");
+        }
+        return edge_ == native_bdd::one_edge ? 1 : 0;
+    }
+
+    /**
+     * @brief Get the underlying edge
+     */
+    native_bdd::edge get_edge() const {
+        return edge_;
+    }
+
+    bool is_valid() const {
+        return manager_ != nullptr;
+    }
+
+    std::string get_type() const {
+        if (is_terminal()) {
+            return "Terminal(" + std::to_string(get_terminal_value()) + ")";
+        }
+        return "Variable";
+    }
+};
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+/**
+ * @file native_view.hpp
+ * @brief Adapter exposing a native BDD as a graph::external_dag_view
+ *
+ * Handles are native_bdd edges, so the complement flag is part of a node's
+ * identity exactly as in cudd_view.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "graph_concepts.hpp"
+#include "native_bdd.hpp"
+
+/**
+ * @brief native_bdd-backed external_dag_view adapter
+ */
+struct native_view {
+    /**
+     * @brief Handle wrapping an edge; `stable_key()` is the edge value
+     */
+    struct handle {
+        native_bdd::edge e = native_bdd::zero_edge;
+
+        std::uint64_t stable_key() const noexcept {
+            return e;
+        }
+
+        friend bool operator==(const handle& a, const handle& b) noexcept {
+            return a.e == b.e;
+        }
+        friend bool operator!=(const handle& a, const handle& b) noexcept {
+            return a.e != b.e;
+        }
+    };
+
+    /**
+     * @brief Edge reference returned by `children()`
+     *
+     * `label()` encodes branch semantics: 0 == else/low, 1 == then/high.
+     */
+    struct edge {
+        handle tgt;
+        int branch = 0;  // 0 = else/low, 1 = then/high
+        handle target() const noexcept {
+            return tgt;
+        }
+        int label() const noexcept {
+            return branch;
+        }
+    };
+
+    /// Manager owning the diagram
+    const native_bdd::manager* manager = nullptr;
+    /// The root edge for this view
+    native_bdd::edge root = native_bdd::zero_edge;
+
+    native_view() = default;
+    native_view(const native_bdd::manager* m, native_bdd::edge r) : manager(m), root(r) {}
+
+    /**
+     * @brief Return child edges for node handle `h`
+     *
+     * Constants have no children. Complemented handles yield complemented
+     * children.
+     */
+    auto children(handle h) const {
+        std::vector<edge> out;
+        if (manager == nullptr || native_bdd::is_constant(h.e)) {
+            return out;
+        }
+        out.push_back(edge{handle{manager->low(h.e)}, 0});
+        out.push_back(edge{handle{manager->high(h.e)}, 1});
+        return out;
+    }
+
+    /**
+     * @brief Return the view roots as a small vector of handles
+     */
+    auto roots() const {
+        return std::vector<handle>{handle{root}};
+    }
+};
+
+static_assert(graph::external_dag_view<native_view>, "native_view should model external_dag_view");
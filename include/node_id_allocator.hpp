@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <deque>
 #include <format>
 #include <string>
 #include <unordered_map>
@@ -15,6 +17,11 @@
  * (pointer) to a textual identifier used by DOT and Mermaid generators.
  * The allocator supports configurable prefix and start index so different
  * output formats can choose their preferred numbering scheme.
+ *
+ * One allocator is the shared id context of a render: every node gets a
+ * dense index in the order it is first seen, and its textual ID is formatted
+ * once and then handed out by reference, so generators can order nodes by
+ * index instead of parsing IDs back into numbers.
  */
 namespace graph_common {
 
@@ -34,39 +41,59 @@ class node_id_allocator {
      * @param start_index Starting numeric index for generated IDs (default: 0).
      */
     explicit node_id_allocator(const std::string& prefix = "N", size_t start_index = 0)
-        : map_(), next_(start_index), prefix_(prefix), start_index_(start_index) {}
+        : prefix_(prefix), start_index_(start_index) {}
 
     /**
-     * @brief Get (or create) the textual ID for the given node pointer.
+     * @brief Get (or create) the dense index of the given node pointer.
      * @param key Pointer used to uniquely identify a node.
-     * @return std::string Textual identifier (prefix + index).
+     * @return size_t 0 for the first key seen, 1 for the next, and so on.
      */
-    std::string get_id(const void* key) {
-        auto it = map_.find(key);
-        if (it != map_.end()) {
-            return it->second;
+    size_t get_index(const void* key) {
+        auto [it, inserted] = index_.try_emplace(key, ids_.size());
+        if (inserted) {
+            ids_.push_back(std::format("{}{}", prefix_, start_index_ + it->second));
         }
-        std::string id = std::format("{}{}", prefix_, next_++);
-        map_[key] = id;
-        return id;
+        return it->second;
+    }
+
+    /**
+     * @brief Get (or create) the textual ID for the given node pointer.
+     * @param key Pointer used to uniquely identify a node.
+     * @return const std::string& Textual identifier (prefix + index), valid until reset().
+     */
+    const std::string& get_id(const void* key) {
+        return ids_[get_index(key)];
+    }
+
+    /**
+     * @brief Textual ID of a dense index returned by get_index().
+     */
+    const std::string& id_at(size_t index) const {
+        return ids_[index];
+    }
+
+    /**
+     * @brief Pre-size the table for @p count nodes.
+     */
+    void reserve(size_t count) {
+        index_.reserve(count);
     }
 
     /**
      * @brief Reset the allocator, clearing mappings and index counter.
      *
-     * After reset the next generated ID will start again at the original
-     * configured start index only if the caller reconstructs the allocator.
+     * After reset the next generated ID starts again at the configured start index.
      */
     void reset() {
-        map_.clear();
-        next_ = start_index_;
+        index_.clear();
+        ids_.clear();
     }
 
    private:
-    std::unordered_map<const void*, std::string> map_;  ///< Pointer -> ID map.
-    size_t next_;                                       ///< Next numeric index to use.
-    std::string prefix_;                                ///< ID prefix string.
-    size_t start_index_;                                ///< Initial index value.
+    std::unordered_map<const void*, size_t> index_;  ///< Pointer -> dense index.
+    std::deque<std::string> ids_;  ///< Textual ID of each index; a deque keeps references valid.
+    std::string prefix_;           ///< ID prefix string.
+    size_t start_index_;           ///< Initial index value.
 };
 
 }  // namespace graph_common
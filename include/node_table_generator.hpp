@@ -27,6 +27,7 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "dag_walker.hpp"
@@ -57,6 +58,18 @@ concept NodeTableIterator = BaseGraphIterator<T> && requires(T t) {
     { t.get_terminal_value() } -> std::convertible_to<int>;
 };
 
+/**
+ * @brief Concept for node table iterators with any number of labelled children
+ *
+ * Used for multi-valued diagrams, where each child is reached by a set of
+ * values described by the edge label.
+ */
+template <typename T>
+concept MultiwayNodeTableIterator =
+    NodeTableIterator<T> && requires(T t, T child, std::size_t index) {
+        { t.get_edge_label(child, index) } -> std::convertible_to<std::string>;
+    };
+
 /// @}
 
 /// @name Configuration structures for different table formats
@@ -105,26 +118,32 @@ struct MarkdownTableConfig {
 /// @{
 
 /**
- * @brief Generate a plain text table of nodes
+ * @brief Generate one plain text table for several roots sharing nodes
  *
- * Creates a formatted plain text table showing node structure, relationships,
- * and properties. Uses the TextTableConfig for formatting options.
+ * Nodes reachable from more than one root get a single row. When roots are
+ * named, the table is followed by an "Outputs:" section giving the row of
+ * each named root.
  *
  * @tparam Iterator Type that satisfies NodeTableIterator concept
- * @param root_iterator Iterator positioned at the root of the structure
+ * @param roots Name and root iterator of each root
  * @param out Output stream to write the table to
  * @param config Configuration options for text table formatting
  *
  * @requires NodeTableIterator<Iterator>
  */
 template <NodeTableIterator Iterator>
-void generate_text_table(const Iterator& root_iterator, std::ostream& out,
-                         const TextTableConfig& config = TextTableConfig()) {
+void generate_text_table(const std::vector<std::pair<std::string, Iterator>>& roots,
+                         std::ostream& out, const TextTableConfig& config = TextTableConfig()) {
     static_assert(NodeTableIterator<Iterator>,
                   "Iterator must satisfy NodeTableIterator concept for text table generation");
 
     // Collect all nodes (and edges, unused here) using DAG walker
-    auto [nodes, edges] = dag_walker::collect_nodes_and_edges_topological(root_iterator);
+    std::vector<Iterator> root_iterators;
+    root_iterators.reserve(roots.size());
+    for (const auto& [name, root] : roots) {
+        root_iterators.push_back(root);
+    }
+    auto [nodes, edges] = dag_walker::collect_nodes_and_edges_topological(root_iterators);
     (void)edges;
 
     // Reverse to achieve parents-before-children ordering with terminals at end
@@ -183,12 +202,45 @@ void generate_text_table(const Iterator& root_iterator, std::ostream& out,
         out << iter.get_type() << "\n";
     }
 
+    // Give the row of every named root
+    bool first_output = true;
+    for (const auto& [name, root] : roots) {
+        if (name.empty()) {
+            continue;
+        }
+        if (first_output) {
+            out << "\nOutputs:\n";
+            first_output = false;
+        }
+        out << name << config.separator << node_to_index.at(root.get_node_address()) << "\n";
+    }
+
     if (config.include_headers) {
         out << "\nTotal nodes: " << nodes.size() << "\n";
         out << "Note: Topological order ensures parents appear before children.\n";
     }
 }
 
+/**
+ * @brief Generate a plain text table of nodes
+ *
+ * Creates a formatted plain text table showing node structure, relationships,
+ * and properties. Uses the TextTableConfig for formatting options.
+ *
+ * @tparam Iterator Type that satisfies NodeTableIterator concept
+ * @param root_iterator Iterator positioned at the root of the structure
+ * @param out Output stream to write the table to
+ * @param config Configuration options for text table formatting
+ *
+ * @requires NodeTableIterator<Iterator>
+ */
+template <NodeTableIterator Iterator>
+void generate_text_table(const Iterator& root_iterator, std::ostream& out,
+                         const TextTableConfig& config = TextTableConfig()) {
+    generate_text_table(std::vector<std::pair<std::string, Iterator>>{{"", root_iterator}}, out,
+                        config);
+}
+
 /**
  * @brief Generate a Markdown table of nodes
  *
@@ -344,6 +396,70 @@ void generate_csv_table(const Iterator& root_iterator, std::ostream& out,
     }
 }
 
+/**
+ * @brief Generate a plain text table of nodes with any number of children
+ *
+ * Like generate_text_table(), but lists the children of each node as
+ * `label->index` pairs instead of fixed false/true columns, so it can
+ * describe multi-valued diagrams.
+ *
+ * @tparam Iterator Type that satisfies MultiwayNodeTableIterator concept
+ * @param root_iterator Iterator positioned at the root of the structure
+ * @param out Output stream to write the table to
+ * @param config Configuration options (title, headers, index and variable widths)
+ *
+ * @requires MultiwayNodeTableIterator<Iterator>
+ */
+template <MultiwayNodeTableIterator Iterator>
+void generate_multiway_text_table(const Iterator& root_iterator, std::ostream& out,
+                                  const TextTableConfig& config = TextTableConfig()) {
+    // Collect all nodes (and edges, unused here) using DAG walker
+    auto [nodes, edges] = dag_walker::collect_nodes_and_edges_topological(root_iterator);
+    (void)edges;
+
+    // Parents before children with terminals at the end, as in generate_text_table()
+    std::reverse(nodes.begin(), nodes.end());
+
+    std::unordered_map<const void*, int> node_to_index;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        node_to_index[nodes[i].get_node_address()] = static_cast<int>(i);
+    }
+
+    if (config.include_headers) {
+        out << config.table_title << ":\n";
+    }
+    out << "Index" << config.separator << "Variable" << config.separator
+        << std::format("{:<13}", "Type") << config.separator << "Children\n";
+    out << "------|----------|---------------|---------\n";
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const auto& iter = nodes[i];
+
+        out << std::format("{:>{}}", static_cast<int>(i), config.index_width) << config.separator;
+        out << std::format("{:>{}}", iter.get_variable_name(), config.variable_width)
+            << config.separator;
+        out << std::format("{:<13}", iter.get_type()) << config.separator;
+
+        if (iter.is_terminal()) {
+            out << "-";
+        } else {
+            auto children = iter.get_children();
+            for (size_t c = 0; c < children.size(); ++c) {
+                auto it = node_to_index.find(children[c].get_node_address());
+                int child_idx = it != node_to_index.end() ? it->second : -1;
+                out << (c == 0 ? "" : "; ") << iter.get_edge_label(children[c], c) << "->"
+                    << child_idx;
+            }
+        }
+        out << "\n";
+    }
+
+    if (config.include_headers) {
+        out << "\nTotal nodes: " << nodes.size() << "\n";
+        out << "Note: Topological order ensures parents appear before children.\n";
+    }
+}
+
 /// @}
 
 /// @name Utility functions for different output formats
@@ -0,0 +1,296 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file parallel_bdd.hpp
+ * @brief Multi-threaded BDD package with a lock-free unique table
+ *
+ * A parallel counterpart of native_bdd in the style of Sylvan. It uses the
+ * same edge encoding (32-bit node indices with a complement bit, regular
+ * then-edges) and the same fixed order, variable i at level i, so results can
+ * be copied into a native_bdd::manager for the existing generators.
+ *
+ * Design:
+ * - One open-addressing unique table for all levels; a node is published by a
+ *   compare-and-swap on its bucket, so lookups and inserts never take a lock
+ * - The computed cache is lossy; each entry is guarded by a sequence counter,
+ *   so readers never block and torn entries are treated as misses
+ * - ITE splits into a task for the else-branch while the calling worker
+ *   computes the then-branch; idle workers steal tasks from per-worker
+ *   Chase-Lev deques, and a worker waiting for a stolen task helps the thief
+ * - Below a spawn depth, recursion continues on an explicit per-worker stack,
+ *   so deep diagrams cannot overflow a thread's call stack
+ * - Garbage collection runs between top-level operations: all workers mark
+ *   from the nodes held by bdd handles and rehash the survivors in parallel.
+ *   An operation that runs out of node slots is abandoned, the table is
+ *   collected and doubled, and the operation is restarted
+ *
+ * Operations on a manager must be issued from one client thread at a time;
+ * the manager parallelizes each operation internally.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "native_bdd.hpp"
+
+namespace parallel_bdd {
+
+using native_bdd::edge;
+using native_bdd::one_edge;
+using native_bdd::zero_edge;
+
+/**
+ * @brief Sizing and threading options for a manager
+ */
+struct manager_config {
+    /// Worker threads including the calling thread (0 = hardware concurrency)
+    unsigned threads = 0;
+    /// Initial node capacity; the table doubles when a collection frees too little
+    std::size_t initial_nodes = std::size_t{1} << 16;
+    /// Initial computed cache entries (rounded up to a power of two)
+    std::size_t cache_entries = std::size_t{1} << 14;
+    /// Upper bound for the computed cache as it grows with the table
+    std::size_t max_cache_entries = std::size_t{1} << 22;
+    /// Recursion levels that spawn tasks (0 = chosen from the thread count)
+    unsigned spawn_depth = 0;
+};
+
+/**
+ * @brief Counters describing the state of a manager
+ */
+struct statistics {
+    std::size_t capacity = 0;       ///< Node slots, including the terminal
+    std::size_t used_nodes = 0;     ///< Slots in use or handed to workers since the last GC
+    std::size_t gc_runs = 0;        ///< Completed garbage collections
+    std::size_t grows = 0;          ///< Times the node table was doubled
+    std::size_t restarts = 0;       ///< Operations restarted after running out of slots
+    std::size_t steals = 0;         ///< Tasks executed by a worker other than their owner
+    std::size_t cache_lookups = 0;  ///< Computed cache probes
+    std::size_t cache_hits = 0;     ///< Computed cache probes that found a result
+};
+
+class manager;
+
+/**
+ * @class bdd
+ * @brief Reference-counted handle to a function of a parallel manager
+ *
+ * Holding a handle keeps its nodes alive across garbage collections. Handles
+ * belong to the client thread; the manager must outlive all of them.
+ */
+class bdd {
+   public:
+    bdd() = default;
+    bdd(manager* mgr, edge e);
+    bdd(const bdd& other);
+    bdd(bdd&& other) noexcept;
+    bdd& operator=(const bdd& other);
+    bdd& operator=(bdd&& other) noexcept;
+    ~bdd();
+
+    edge get_edge() const {
+        return edge_;
+    }
+
+    manager* get_manager() const {
+        return manager_;
+    }
+
+    bool is_zero() const {
+        return edge_ == zero_edge;
+    }
+
+    bool is_one() const {
+        return edge_ == one_edge;
+    }
+
+    bool is_constant() const {
+        return native_bdd::is_constant(edge_);
+    }
+
+    /// Complement in constant time
+    bdd operator!() const {
+        return bdd(manager_, native_bdd::negate(edge_));
+    }
+
+    friend bdd operator&(const bdd& f, const bdd& g);
+    friend bdd operator|(const bdd& f, const bdd& g);
+    friend bdd operator^(const bdd& f, const bdd& g);
+
+    /// Same function of the same manager (constant time, by canonicity)
+    friend bool operator==(const bdd& f, const bdd& g) {
+        return f.manager_ == g.manager_ && f.edge_ == g.edge_;
+    }
+
+   private:
+    manager* manager_ = nullptr;
+    edge edge_ = zero_edge;
+};
+
+/**
+ * @class manager
+ * @brief Owner of the node table, computed cache and worker threads
+ */
+class manager {
+   public:
+    /**
+     * @brief Creates a manager and starts its worker threads
+     *
+     * @param variable_count Number of variables; variable i is at level i
+     * @param config Table, cache and thread options
+     * @throws std::runtime_error If variable_count does not fit a node record
+     */
+    explicit manager(std::uint32_t variable_count, const manager_config& config = {});
+    ~manager();
+
+    manager(const manager&) = delete;
+    manager& operator=(const manager&) = delete;
+
+    std::uint32_t variable_count() const;
+
+    /// Worker threads including the calling thread
+    unsigned thread_count() const;
+
+    bdd zero() {
+        return bdd(this, zero_edge);
+    }
+
+    bdd one() {
+        return bdd(this, one_edge);
+    }
+
+    /**
+     * @brief Returns the projection function of a variable
+     * @throws std::runtime_error If the index is out of range
+     */
+    bdd variable(std::uint32_t index);
+
+    /**
+     * @brief If-then-else: (f AND g) OR (NOT f AND h), computed by all workers
+     * @throws std::runtime_error If an operand belongs to another manager or
+     *         the table cannot grow any further
+     */
+    bdd ite(const bdd& f, const bdd& g, const bdd& h);
+
+    bdd apply_and(const bdd& f, const bdd& g) {
+        return ite(f, g, zero());
+    }
+
+    bdd apply_or(const bdd& f, const bdd& g) {
+        return ite(f, one(), g);
+    }
+
+    bdd apply_xor(const bdd& f, const bdd& g) {
+        return ite(f, !g, g);
+    }
+
+    /**
+     * @brief Evaluates a function for one assignment
+     *
+     * @param f Function to evaluate
+     * @param values One value per variable (0 = false, otherwise true)
+     * @throws std::runtime_error If fewer values than variables are given
+     */
+    bool evaluate(const bdd& f, std::span<const std::uint8_t> values) const;
+
+    /**
+     * @brief Number of distinct nodes of a function, counting the terminal
+     */
+    std::size_t node_count(const bdd& f) const;
+
+    /**
+     * @brief Reclaims every node that no bdd handle can reach
+     */
+    void collect_garbage();
+
+    statistics get_statistics() const;
+
+    /// Variable at the top of an edge (native_bdd::terminal_var for constants)
+    std::uint32_t top_var(edge e) const;
+
+    /// Else child of a non-constant edge, with the complement pushed down
+    edge low(edge e) const;
+
+    /// Then child of a non-constant edge, with the complement pushed down
+    edge high(edge e) const;
+
+   private:
+    friend class bdd;
+    struct engine;
+
+    void add_ref(edge e);
+    void drop_ref(edge e);
+
+    std::unique_ptr<engine> engine_;
+};
+
+// ============================================================================
+// bdd handle members (need the complete manager)
+// ============================================================================
+
+inline bdd::bdd(manager* mgr, edge e) : manager_(mgr), edge_(e) {
+    if (manager_ != nullptr) {
+        manager_->add_ref(edge_);
+    }
+}
+
+inline bdd::bdd(const bdd& other) : bdd(other.manager_, other.edge_) {}
+
+inline bdd::bdd(bdd&& other) noexcept : manager_(other.manager_), edge_(other.edge_) {
+    other.manager_ = nullptr;
+}
+
+inline bdd& bdd::operator=(const bdd& other) {
+    if (this != &other) {
+        if (other.manager_ != nullptr) {
+            other.manager_->add_ref(other.edge_);
+        }
+        if (manager_ != nullptr) {
+            manager_->drop_ref(edge_);
+        }
+        manager_ = other.manager_;
+        edge_ = other.edge_;
+    }
+    return *this;
+}
+
+inline bdd& bdd::operator=(bdd&& other) noexcept {
+    if (this != &other) {
+        if (manager_ != nullptr) {
+            manager_->drop_ref(edge_);
+        }
+        manager_ = other.manager_;
+        edge_ = other.edge_;
+        other.manager_ = nullptr;
+    }
+    return *this;
+}
+
+inline bdd::~bdd() {
+    if (manager_ != nullptr) {
+        manager_->drop_ref(edge_);
+    }
+}
+
+inline bdd operator&(const bdd& f, const bdd& g) {
+    return f.get_manager()->apply_and(f, g);
+}
+
+inline bdd operator|(const bdd& f, const bdd& g) {
+    return f.get_manager()->apply_or(f, g);
+}
+
+inline bdd operator^(const bdd& f, const bdd& g) {
+    return f.get_manager()->apply_xor(f, g);
+}
+
+}  // namespace parallel_bdd
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file parallel_convert.hpp
+ * @brief Conversion of expression trees into the parallel BDD package
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "expression_types.hpp"
+#include "native_bdd.hpp"
+#include "native_convert.hpp"
+#include "parallel_bdd.hpp"
+
+/**
+ * @brief Converts an expression tree to a parallel BDD
+ *
+ * Each AND, OR, XOR and ITE of the conversion runs on all workers of
+ * @p mgr. The variable order is the one of convert_to_native_bdd.
+ *
+ * @param expr The root expression to convert
+ * @param mgr Manager with at least as many variables as the expression uses
+ * @return Handle to the function of @p expr
+ * @throws std::runtime_error If a variable is not found or the manager is too small
+ */
+inline parallel_bdd::bdd convert_to_parallel_bdd(const my_expression& expr,
+                                                 parallel_bdd::manager& mgr) {
+    return native_convert_detail::convert(expr, mgr, "Parallel");
+}
+
+/**
+ * @brief Copies a parallel BDD into a native manager
+ *
+ * Both packages use the same levels and edge conventions, so every node is
+ * rebuilt bottom-up with a single trivial ITE. The native copy can then be
+ * written with the native generators (DOT, Mermaid, node tables, C code).
+ *
+ * @param mgr Manager owning @p f
+ * @param f Function to copy
+ * @param target Native manager with at least as many variables as @p mgr
+ * @return Handle to the same function in @p target
+ * @throws std::runtime_error If @p target has too few variables
+ */
+inline native_bdd::bdd copy_to_native(const parallel_bdd::manager& mgr,
+                                      const parallel_bdd::bdd& f,
+                                      native_bdd::manager& target) {
+    using native_bdd::edge;
+    if (target.variable_count() < mgr.variable_count()) {
+        throw std::runtime_error("Native BDD manager has too few variables for the copy");
+    }
+
+    // Distinct regular nodes, children before parents (deepest level first)
+    std::unordered_map<std::uint32_t, native_bdd::bdd> copied;
+    std::vector<edge> order;
+    std::vector<edge> pending = {native_bdd::regular(f.get_edge())};
+    while (!pending.empty()) {
+        edge e = pending.back();
+        pending.pop_back();
+        if (native_bdd::is_constant(e) || copied.contains(native_bdd::node_index(e))) {
+            continue;
+        }
+        copied.emplace(native_bdd::node_index(e), native_bdd::bdd());
+        order.push_back(e);
+        pending.push_back(native_bdd::regular(mgr.low(e)));
+        pending.push_back(native_bdd::regular(mgr.high(e)));
+    }
+    std::sort(order.begin(), order.end(),
+              [&](edge a, edge b) { return mgr.top_var(a) > mgr.top_var(b); });
+
+    auto lookup = [&](edge e) {
+        native_bdd::bdd r = native_bdd::is_constant(e) ? target.one()
+                                                       : copied.at(native_bdd::node_index(e));
+        return native_bdd::is_complement(e) ? !r : r;
+    };
+    for (edge e : order) {
+        copied[native_bdd::node_index(e)] =
+            target.ite(target.variable(mgr.top_var(e)), lookup(mgr.high(e)), lookup(mgr.low(e)));
+    }
+    return lookup(f.get_edge());
+}
@@ -0,0 +1,322 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file partitioned_convert.hpp
+ * @brief Conversion of independent subtrees in worker managers on separate threads
+ *
+ * Wide conjunctions (and disjunctions) of constraint groups are converted one
+ * operand after another by convert_to_bdd(). Here the operands of the
+ * top-level AND or OR chain are split into balanced partitions. Each
+ * partition is converted on its own thread in its own teddy::bdd_manager or
+ * Cudd, with the variable numbering of the whole expression. The partial
+ * results are then copied node by node into the main manager and combined
+ * there (see bdd_transfer.hpp). This uses the existing single-threaded
+ * libraries unchanged; a manager is only ever touched by one thread at a time.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "bdd_transfer.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "teddy_convert.hpp"
+
+/**
+ * @brief Operands of the top-level chain, grouped into partitions
+ */
+struct partition_plan {
+    /// Operator of the top-level chain
+    enum class chain_op {
+        none,  ///< The root is not an AND or OR; everything is one partition
+        conjunction,
+        disjunction,
+    } op = chain_op::none;
+
+    /// Operands of each partition, in their order in the expression
+    std::vector<std::vector<const my_expression*>> partitions;
+
+    /// Expression nodes in each partition, the measure used for balancing
+    std::vector<std::size_t> sizes;
+};
+
+namespace partitioned_convert_detail {
+
+/**
+ * @brief Operands of the chain of @p T nodes at the root, left to right
+ */
+template <class T>
+std::vector<const my_expression*> chain_operands(const my_expression& expr) {
+    std::vector<const my_expression*> operands;
+    std::vector<const my_expression*> pending = {&expr};
+    while (!pending.empty()) {
+        const my_expression* e = pending.back();
+        pending.pop_back();
+        if (const auto* node = std::get_if<T>(e)) {
+            pending.push_back(node->right.get());
+            pending.push_back(node->left.get());
+        } else {
+            operands.push_back(e);
+        }
+    }
+    return operands;
+}
+
+/**
+ * @brief Variable numbering of the whole expression (as in convert_to_bdd)
+ */
+inline std::unordered_map<std::string, int> variable_map(const std::vector<std::string>& sorted) {
+    std::unordered_map<std::string, int> var_map;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        var_map[sorted[i]] = static_cast<int>(i);
+    }
+    return var_map;
+}
+
+inline void print_plan(const char* package, const std::vector<std::string>& sorted_vars,
+                       const partition_plan& plan) {
+    std::cout << package << " variable ordering: ";
+    for (size_t i = 0; i < sorted_vars.size(); ++i) {
+        std::cout << sorted_vars[i] << "=" << i;
+        if (i < sorted_vars.size() - 1)
+            std::cout << ", ";
+    }
+    std::cout << std::endl;
+
+    std::size_t operands = 0;
+    for (const auto& partition : plan.partitions) {
+        operands += partition.size();
+    }
+    std::cout << "Partitioned conversion: " << operands << " operands of the top-level "
+              << (plan.op == partition_plan::chain_op::disjunction ? "OR" : "AND") << " in "
+              << plan.partitions.size() << " partitions (sizes";
+    for (std::size_t size : plan.sizes) {
+        std::cout << " " << size;
+    }
+    std::cout << ")" << std::endl;
+}
+
+/**
+ * @brief Converts every partition on its own thread and combines the copies
+ *
+ * @tparam Worker Manager type of the worker threads
+ * @param make_worker Creates the manager of one thread (called on this thread)
+ * @param convert `Result(Worker&, const my_expression&)`, runs on the worker thread
+ * @param combine `Result(Worker&, const Result&, const Result&)` for the chain
+ *        operator, runs on the worker thread
+ * @param import `Main(const Worker&, const Result&)`, copies a result into the
+ *        main manager on this thread
+ * @param combine_main `Main(const Main&, const Main&)` for the chain operator
+ */
+template <class Worker, class MakeWorker, class Convert, class Combine, class Import,
+          class CombineMain>
+auto run_partitions(const partition_plan& plan, MakeWorker make_worker, Convert convert,
+                    Combine combine, Import import, CombineMain combine_main) {
+    // Managers outlive the futures, whose destructors wait for their threads
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (std::size_t i = 0; i < plan.partitions.size(); ++i) {
+        workers.push_back(make_worker());
+    }
+
+    using result_t = decltype(convert(*workers.front(), *plan.partitions.front().front()));
+    std::vector<std::future<result_t>> futures;
+    for (std::size_t i = 0; i < plan.partitions.size(); ++i) {
+        futures.push_back(std::async(std::launch::async, [&, i] {
+            Worker& worker = *workers[i];
+            const auto& operands = plan.partitions[i];
+            result_t result = convert(worker, *operands.front());
+            for (std::size_t j = 1; j < operands.size(); ++j) {
+                result = combine(worker, result, convert(worker, *operands[j]));
+            }
+            return result;
+        }));
+    }
+
+    // Import in partition order; a worker's diagram is read only after its thread finished
+    std::vector<result_t> results;
+    for (auto& future : futures) {
+        results.push_back(future.get());
+    }
+    auto combined = import(*workers.front(), results.front());
+    for (std::size_t i = 1; i < results.size(); ++i) {
+        combined = combine_main(combined, import(*workers[i], results[i]));
+    }
+    return combined;
+}
+
+}  // namespace partitioned_convert_detail
+
+/**
+ * @brief Splits the top-level AND or OR chain of an expression into partitions
+ *
+ * The chain's operands are assigned largest first to the partition with the
+ * fewest expression nodes so far, so partitions have similar conversion work
+ * when the operands are alike. Within a partition the operands keep their
+ * order in the expression.
+ *
+ * @param expr The root expression
+ * @param count Wanted number of partitions (0 = hardware concurrency); at most
+ *        one partition per operand is made
+ * @return Plan with at least one partition
+ */
+inline partition_plan plan_partitions(const my_expression& expr, unsigned count) {
+    using partitioned_convert_detail::chain_operands;
+    if (count == 0) {
+        count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    partition_plan plan;
+    std::vector<const my_expression*> operands;
+    if (std::holds_alternative<my_and>(expr)) {
+        plan.op = partition_plan::chain_op::conjunction;
+        operands = chain_operands<my_and>(expr);
+    } else if (std::holds_alternative<my_or>(expr)) {
+        plan.op = partition_plan::chain_op::disjunction;
+        operands = chain_operands<my_or>(expr);
+    } else {
+        operands = {&expr};
+    }
+
+    std::vector<std::size_t> operand_sizes;
+    for (const my_expression* operand : operands) {
+        operand_sizes.push_back(expression_size(*operand));
+    }
+    std::vector<std::size_t> by_size(operands.size());
+    std::iota(by_size.begin(), by_size.end(), std::size_t{0});
+    std::stable_sort(by_size.begin(), by_size.end(), [&](std::size_t a, std::size_t b) {
+        return operand_sizes[a] > operand_sizes[b];
+    });
+
+    const std::size_t partitions = std::min<std::size_t>(count, operands.size());
+    std::vector<std::vector<std::size_t>> members(partitions);
+    plan.sizes.assign(partitions, 0);
+    for (std::size_t index : by_size) {
+        auto lightest = std::min_element(plan.sizes.begin(), plan.sizes.end());
+        auto p = static_cast<std::size_t>(lightest - plan.sizes.begin());
+        members[p].push_back(index);
+        *lightest += operand_sizes[index];
+    }
+    for (auto& indices : members) {
+        std::sort(indices.begin(), indices.end());
+        auto& partition = plan.partitions.emplace_back();
+        for (std::size_t index : indices) {
+            partition.push_back(operands[index]);
+        }
+    }
+    return plan;
+}
+
+/**
+ * @brief Converts an expression to a TeDDy BDD with one thread per partition
+ *
+ * The operands of the top-level AND or OR are partitioned with
+ * plan_partitions(). Each partition is converted by convert_to_bdd_with_map()
+ * in a worker teddy::bdd_manager of its own, using the variable numbering of
+ * convert_to_bdd(); the results are copied into @p mgr with copy_teddy_bdd()
+ * and combined there. With a single partition the expression is converted in
+ * @p mgr directly.
+ *
+ * The import is not linear in the size of a worker's result: copy_teddy_bdd()
+ * costs the sum of its sub-diagram sizes, up to quadratic, because TeDDy only
+ * builds nodes through apply. convert_to_cudd_bdd_partitioned() imports in
+ * linear time and suits partitions with large results better.
+ *
+ * @param expr The root expression to convert
+ * @param mgr Main manager with as many variables as the expression uses
+ * @param partitions Wanted number of partitions and threads (0 = hardware concurrency)
+ * @return BDD diagram of @p expr in @p mgr
+ * @throws std::runtime_error If a variable is not found (rethrown from the worker)
+ */
+inline teddy::bdd_manager::diagram_t convert_to_bdd_partitioned(const my_expression& expr,
+                                                                teddy::bdd_manager& mgr,
+                                                                unsigned partitions = 0) {
+    using bdd_t = teddy::bdd_manager::diagram_t;
+    using namespace teddy::ops;
+
+    std::unordered_set<std::string> variable_names;
+    collect_variables_with_dag_walker(expr, variable_names);
+    std::vector<std::string> sorted_vars = ordered_variable_names(variable_names);
+    const auto var_map = partitioned_convert_detail::variable_map(sorted_vars);
+
+    partition_plan plan = plan_partitions(expr, partitions);
+    partitioned_convert_detail::print_plan("TeDDy", sorted_vars, plan);
+    if (plan.partitions.size() < 2) {
+        return convert_to_bdd_with_map(expr, mgr, var_map);
+    }
+
+    const bool conjunction = plan.op == partition_plan::chain_op::conjunction;
+    auto apply = [conjunction](teddy::bdd_manager& m, const bdd_t& f, const bdd_t& g) {
+        return conjunction ? m.apply<AND>(f, g) : m.apply<OR>(f, g);
+    };
+    const int variable_count = static_cast<int>(sorted_vars.size());
+    return partitioned_convert_detail::run_partitions<teddy::bdd_manager>(
+        plan,
+        [&] { return std::make_unique<teddy::bdd_manager>(variable_count, 1'000); },
+        [&](teddy::bdd_manager& worker, const my_expression& e) {
+            return convert_to_bdd_with_map(e, worker, var_map);
+        },
+        apply,
+        [&](const teddy::bdd_manager&, const bdd_t& f) { return copy_teddy_bdd(f, mgr); },
+        [&](const bdd_t& f, const bdd_t& g) { return apply(mgr, f, g); });
+}
+
+/**
+ * @brief Converts an expression to a CUDD BDD with one thread per partition
+ *
+ * The CUDD counterpart of convert_to_bdd_partitioned(): every partition is
+ * converted in a Cudd manager of its own and copied into the returned one
+ * with copy_cudd_bdd(). The numbering is the one of convert_to_cudd_bdd().
+ *
+ * @param expr The expression to convert
+ * @param variable_names The set of variable names used in the expression
+ * @param partitions Wanted number of partitions and threads (0 = hardware concurrency)
+ * @return Pair containing the CUDD manager and the root BDD
+ * @throws std::runtime_error If a variable is not found (rethrown from the worker)
+ */
+inline std::pair<std::unique_ptr<Cudd>, BDD> convert_to_cudd_bdd_partitioned(
+    const my_expression& expr, const std::unordered_set<std::string>& variable_names,
+    unsigned partitions = 0) {
+    auto cudd_mgr = std::make_unique<Cudd>();
+    std::vector<std::string> sorted_vars = ordered_variable_names(variable_names);
+    const auto var_map = partitioned_convert_detail::variable_map(sorted_vars);
+
+    partition_plan plan = plan_partitions(expr, partitions);
+    partitioned_convert_detail::print_plan("CUDD", sorted_vars, plan);
+    if (plan.partitions.size() < 2) {
+        BDD result = convert_to_cudd_bdd_with_map(expr, *cudd_mgr, var_map);
+        return std::make_pair(std::move(cudd_mgr), result);
+    }
+
+    const bool conjunction = plan.op == partition_plan::chain_op::conjunction;
+    auto apply = [conjunction](const BDD& f, const BDD& g) {
+        return conjunction ? f & g : f | g;
+    };
+    const Cudd& target = *cudd_mgr;
+    BDD result = partitioned_convert_detail::run_partitions<Cudd>(
+        plan, [] { return std::make_unique<Cudd>(); },
+        [&](const Cudd& worker, const my_expression& e) {
+            return convert_to_cudd_bdd_with_map(e, worker, var_map);
+        },
+        [&](const Cudd&, const BDD& f, const BDD& g) { return apply(f, g); },
+        [&](const Cudd& worker, const BDD& f) { return copy_cudd_bdd(worker, f, target); },
+        apply);
+    return std::make_pair(std::move(cudd_mgr), result);
+}
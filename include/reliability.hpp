@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file reliability.hpp
+ * @brief Probability of a BDD being one, for independent variable probabilities
+ *
+ * A built TeDDy, CUDD or native diagram is first compiled to a flat list of
+ * nodes with children before parents. P(f = 1) is then one pass over that
+ * list: every node takes `P(low) + p(var) * (P(high) - P(low))`. Levels
+ * skipped by an edge need no correction, since a skipped variable sums out
+ * to one, and complemented CUDD edges are expanded during compilation.
+ *
+ * Batches of probability vectors are evaluated a tile at a time, with one
+ * lane per vector so the inner loop over lanes vectorizes; tiles are split
+ * across threads. A second, top-down pass gives the Birnbaum importance of
+ * every variable and its marginal probability given f = 1.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <libteddy/core.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "native_bdd.hpp"
+
+class BDD;
+
+namespace reliability {
+
+/**
+ * @brief Node of a compiled diagram
+ *
+ * Children are node ids: 0 is the constant zero, 1 the constant one and
+ * `2 + i` the node at position `i` of diagram::nodes.
+ */
+struct node {
+    std::uint32_t variable = 0;  ///< Variable index
+    std::uint32_t low = 0;       ///< Child when the variable is 0
+    std::uint32_t high = 0;      ///< Child when the variable is 1
+};
+
+/**
+ * @brief Diagram compiled for probability evaluation
+ *
+ * Nodes are listed children first, so one forward pass evaluates them all.
+ */
+struct diagram {
+    std::size_t variables = 0;  ///< Length of a probability vector
+    std::vector<node> nodes;
+    std::uint32_t root = 0;  ///< Id of the root (0 or 1 for a constant function)
+
+    static constexpr std::uint32_t zero = 0;
+    static constexpr std::uint32_t one = 1;
+    static constexpr std::uint32_t first_node = 2;
+};
+
+/**
+ * @brief Compiles a TeDDy BDD
+ *
+ * @param f The BDD to compile
+ * @param variables Number of variables (at least one more than the largest index)
+ */
+diagram compile_teddy(teddy::bdd_manager::diagram_t f, std::size_t variables);
+
+/**
+ * @brief Compiles a CUDD BDD, expanding complemented edges
+ *
+ * @param f The BDD to compile
+ * @param variables Number of variables (at least one more than the largest index)
+ */
+diagram compile_cudd(const BDD& f, std::size_t variables);
+
+/**
+ * @brief Compiles a native BDD, expanding complemented edges
+ */
+diagram compile_native(const native_bdd::manager& manager, const native_bdd::bdd& f);
+
+/**
+ * @brief Probability that the function is one
+ *
+ * @param d Compiled diagram
+ * @param p Probability of each variable being one, by variable index
+ * @throws std::runtime_error If @p p does not hold d.variables values
+ */
+double probability(const diagram& d, std::span<const double> p);
+
+/**
+ * @brief Execution settings for probabilities()
+ */
+struct batch_options {
+    unsigned threads = 0;          ///< Worker threads (0 = hardware concurrency)
+    std::size_t tile_lanes = 256;  ///< Probability vectors evaluated together
+    /// Upper bound on the per-thread scratch space; large diagrams get fewer lanes
+    std::size_t scratch_bytes = std::size_t{64} << 20;
+};
+
+/**
+ * @brief Probability that the function is one, for many probability vectors
+ *
+ * @param d Compiled diagram
+ * @param vectors Row-major matrix of `rows` vectors of d.variables values each
+ * @param options Thread count and tile size
+ * @return One probability per vector
+ * @throws std::runtime_error If the size of @p vectors is not a multiple of
+ *         d.variables, or the tile size is zero
+ */
+std::vector<double> probabilities(const diagram& d, std::span<const double> vectors,
+                                  const batch_options& options = {});
+
+/**
+ * @brief Result of analyze()
+ */
+struct importance {
+    double probability = 0.0;      ///< P(f = 1)
+    std::vector<double> birnbaum;  ///< P(f = 1 | x_i = 1) - P(f = 1 | x_i = 0)
+    std::vector<double> marginal;  ///< P(x_i = 1 | f = 1), zero if P(f = 1) is zero
+};
+
+/**
+ * @brief Probability, Birnbaum importance and marginals of all variables
+ *
+ * Birnbaum importance is the derivative of P(f = 1) with respect to p_i:
+ * the sum over the nodes of variable i of the probability of reaching the
+ * node times `P(high) - P(low)`. One bottom-up and one top-down pass compute
+ * it for every variable.
+ *
+ * @param d Compiled diagram
+ * @param p Probability of each variable being one
+ * @throws std::runtime_error If @p p does not hold d.variables values
+ */
+importance analyze(const diagram& d, std::span<const double> p);
+
+/**
+ * @brief Probability vectors read from a file
+ */
+struct probability_table {
+    std::size_t variables = 0;
+    std::vector<double> values;  ///< Row-major, `variables` values per row
+
+    std::size_t rows() const {
+        return variables == 0 ? 0 : values.size() / variables;
+    }
+
+    std::span<const double> row(std::size_t r) const {
+        return std::span<const double>(values).subspan(r * variables, variables);
+    }
+};
+
+/**
+ * @brief Reads probability vectors for the given variables
+ *
+ * The first non-comment line names the columns, separated by commas or
+ * whitespace; each further line is one vector. Variables without a column
+ * get probability 0.5. `#` starts a comment.
+ *
+ * ```
+ * # Availability of each component
+ * pump_a, pump_b, valve
+ * 0.99, 0.98, 0.999
+ * 0.95, 0.98, 0.990
+ * ```
+ *
+ * @param path File to read
+ * @param variable_names Variable names by index
+ * @return One row per vector, columns in variable index order
+ * @throws std::runtime_error If the file cannot be read, names an unknown or
+ *         duplicate variable, or holds a malformed value or one outside [0, 1]
+ */
+probability_table read_probability_file(const std::string& path,
+                                        const std::vector<std::string>& variable_names);
+
+}  // namespace reliability
@@ -41,73 +41,104 @@
 
 #include <cudd/cuddObj.hh>
 
+#include "cardinality_bdd.hpp"
+#include "conversion_limits.hpp"
 #include "cudd_graph.hpp"
 #include "dag_walker.hpp"
 #include "expression_adapter.hpp"
 #include "expression_graph.hpp"
 #include "expression_parser.hpp"
+#include "field_compare_bdd.hpp"
 #include "node_table_generator.hpp"
 #include "teddy_graph.hpp"
 
 /**
- * @brief Converts an expression tree to a Binary Decision Diagram (BDD)
+ * @brief Creates an if-then-else operation for 0/1-valued TeDDy diagrams
  *
- * Performs recursive conversion of the custom expression tree into a BDD using
- * the TeDDy library. Uses dag_walker for efficient variable collection and
- * simple recursion for BDD construction since expressions form a tree structure.
+ * TeDDy has no ITE primitive, so this is (f AND g) OR (NOT f AND h): one XOR
+ * for NOT f and three applies. TeDDy's apply has no shortcut for a variable
+ * placed above g and h, so each apply walks the operands below it and one
+ * call costs O(|g| + |h|), unlike CUDD's Ite, which makes such a node with a
+ * single unique-table lookup. Layered builds such as cardinality_bdd::build()
+ * are therefore O(n * k) only with CUDD; with this ITE they are O(n^2 * k^2).
+ * TeDDy's node constructor is not public, so the layers cannot be made directly.
  *
- * The conversion process:
- * 1. Uses dag_walker to collect all unique variable names efficiently
- * 2. Creates a sorted variable mapping for consistent BDD ordering
- * 3. Recursively converts each expression node to BDD operations
+ * @tparam Manager TeDDy manager type (BDD or MDD)
+ * @param mgr Manager used for the apply operations; must outlive the result
+ * @return Callable `diagram_t(const diagram_t& f, const diagram_t& g, const diagram_t& h)`
+ */
+template <typename Manager>
+auto make_teddy_ite(Manager& mgr) {
+    using diagram_t = typename Manager::diagram_t;
+    using namespace teddy::ops;
+    return [&mgr, one = mgr.constant(1)](const diagram_t& f, const diagram_t& g,
+                                         const diagram_t& h) {
+        if (g.equals(h)) {
+            return g;
+        }
+        diagram_t not_f = mgr.template apply<XOR>(f, one);
+        return mgr.template apply<OR>(mgr.template apply<AND>(f, g),
+                                      mgr.template apply<AND>(not_f, h));
+    };
+}
+
+/**
+ * @brief Estimated memory per TeDDy node: the node record and its unique-table slot
  *
- * @param expr The root expression to convert
- * @param mgr Reference to the BDD manager for creating BDD nodes
- * @return BDD diagram representing the logical function
+ * Used with conversion_budget to turn a memory limit into a node count.
+ */
+inline constexpr std::size_t teddy_bytes_per_node =
+    sizeof(teddy::bdd_manager::diagram_t::node_t) + sizeof(void*);
+
+/**
+ * @brief Converts an expression tree with a given variable numbering
  *
- * @throws std::runtime_error If a variable reference is not found during conversion
+ * The recursive conversion behind convert_to_bdd(). Taking the numbering as
+ * a parameter lets a subtree be converted with the indices of the whole
+ * expression, e.g. in a separate manager (see partitioned_convert.hpp).
+ * Nothing is printed.
  *
- * Operator mappings:
- * - AND -> BDD AND operation
- * - OR -> BDD OR operation
- * - XOR -> BDD XOR operation
- * - NOT -> XOR with constant 1
- * - Variable -> BDD variable node
+ * With a @p budget the manager's node count is checked after every
+ * expression node. TeDDy cannot be interrupted inside an operation, so a
+ * limit is noticed when the operation that crossed it returns; a garbage
+ * collection is forced before giving up on a node or memory limit.
+ *
+ * Names listed in @p defined stand for diagrams built earlier in @p mgr,
+ * e.g. the `let` definitions of a multi-output file (see multi_output.hpp).
+ *
+ * @param expr The expression to convert
+ * @param mgr Manager with at least as many variables as @p var_map assigns
+ * @param var_map Variable index of every name used by @p expr
+ * @param budget Limits to enforce, or nullptr
+ * @param defined Diagram of each name that refers to a definition, or nullptr
+ * @return BDD diagram representing the logical function
+ * @throws std::runtime_error If a variable of @p expr is in neither map
+ * @throws conversion_aborted If a limit of @p budget is exceeded
  */
-teddy::bdd_manager::diagram_t inline convert_to_bdd(const my_expression& expr,
-                                                    teddy::bdd_manager& mgr) {
+teddy::bdd_manager::diagram_t inline convert_to_bdd_with_map(
+    const my_expression& expr, teddy::bdd_manager& mgr,
+    const std::unordered_map<std::string, int>& var_map, conversion_budget* budget = nullptr,
+    const std::unordered_map<std::string, teddy::bdd_manager::diagram_t>* defined = nullptr) {
     using bdd_t = teddy::bdd_manager::diagram_t;
     using namespace teddy::ops;
 
-    // First pass: collect all unique variable names using dag_walker
-    std::unordered_set<std::string> variable_names;
-    collect_variables_with_dag_walker(expr, variable_names);
-
-    // Build variable map with sorted variable names for consistent ordering
-    std::vector<std::string> sorted_vars(variable_names.begin(), variable_names.end());
-    std::ranges::sort(sorted_vars);
-
-    std::cout << "TeDDy variable ordering: ";
-    for (size_t i = 0; i < sorted_vars.size(); ++i) {
-        std::cout << sorted_vars[i] << "=" << i;
-        if (i < sorted_vars.size() - 1)
-            std::cout << ", ";
-    }
-    std::cout << std::endl;
-
-    std::unordered_map<std::string, int> var_map;
-    for (size_t i = 0; i < sorted_vars.size(); ++i) {
-        var_map[sorted_vars[i]] = static_cast<int>(i);
-    }
+    bdd_t one = mgr.constant(1);
+    auto ite = make_teddy_ite(mgr);
 
     // Helper function for recursive conversion (no memoization needed for tree structure)
     std::function<bdd_t(const my_expression&)> convert_recursive =
         [&](const my_expression& e) -> bdd_t {
-        return std::visit(
+        bdd_t result = std::visit(
             [&](const auto& variant_expr) -> bdd_t {
                 using T = std::decay_t<decltype(variant_expr)>;
 
                 if constexpr (std::is_same_v<T, my_variable>) {
+                    if (defined != nullptr) {
+                        if (auto def = defined->find(variant_expr.variable_name);
+                            def != defined->end()) {
+                            return def->second;
+                        }
+                    }
                     auto it = var_map.find(variant_expr.variable_name);
                     if (it == var_map.end()) {
                         throw std::runtime_error("Variable not found: "
@@ -124,20 +155,107 @@ teddy::bdd_manager::diagram_t inline convert_to_bdd(const my_expression& expr,
                     return mgr.apply<OR>(left_bdd, right_bdd);
                 } else if constexpr (std::is_same_v<T, my_not>) {
                     bdd_t expr_bdd = convert_recursive(*variant_expr.expr);
-                    bdd_t one = mgr.constant(1);
                     return mgr.apply<XOR>(expr_bdd, one);
                 } else if constexpr (std::is_same_v<T, my_xor>) {
                     bdd_t left_bdd = convert_recursive(*variant_expr.left);
                     bdd_t right_bdd = convert_recursive(*variant_expr.right);
                     return mgr.apply<XOR>(left_bdd, right_bdd);
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    std::vector<std::pair<int, bdd_t>> operands;
+                    operands.reserve(variant_expr.operands.size());
+                    for (const auto& operand : variant_expr.operands) {
+                        bdd_t operand_bdd = convert_recursive(*operand);
+                        int level = cardinality_bdd::operand_level(
+                            *operand, [&](const std::string& name) {
+                                auto it = var_map.find(name);
+                                return it == var_map.end()
+                                           ? -1
+                                           : static_cast<int>(mgr.get_level(it->second));
+                            });
+                        operands.emplace_back(level, std::move(operand_bdd));
+                    }
+                    return cardinality_bdd::build(variant_expr, std::move(operands),
+                                                  mgr.constant(0), one, ite);
+                } else if constexpr (std::is_same_v<T, my_compare>) {
+                    auto var = [&](const std::string& name) {
+                        return mgr.variable(var_map.at(name));
+                    };
+                    return field_compare_bdd::build(variant_expr, var, mgr.constant(0), one, ite);
+                } else if constexpr (std::is_same_v<T, my_constant>) {
+                    return variant_expr.value ? one : mgr.constant(0);
                 }
             },
             e);
+        if (budget != nullptr) {
+            budget->check(e, static_cast<std::size_t>(mgr.get_node_count()), [&] {
+                mgr.force_gc();
+                return static_cast<std::size_t>(mgr.get_node_count());
+            });
+        }
+        return result;
     };
 
     return convert_recursive(expr);
 }
 
+/**
+ * @brief Converts an expression tree to a Binary Decision Diagram (BDD)
+ *
+ * Performs recursive conversion of the custom expression tree into a BDD using
+ * the TeDDy library. Uses dag_walker for efficient variable collection and
+ * simple recursion for BDD construction since expressions form a tree structure.
+ *
+ * The conversion process:
+ * 1. Uses dag_walker to collect all unique variable names efficiently
+ * 2. Creates a sorted variable mapping for consistent BDD ordering
+ * 3. Recursively converts each expression node to BDD operations
+ *
+ * @param expr The root expression to convert
+ * @param mgr Reference to the BDD manager for creating BDD nodes
+ * @param budget Node, memory and time limits to enforce, or nullptr (see
+ *        convert_to_bdd_with_map())
+ * @return BDD diagram representing the logical function
+ *
+ * @throws std::runtime_error If a variable reference is not found during conversion
+ * @throws conversion_aborted If a limit of @p budget is exceeded
+ *
+ * Operator mappings:
+ * - AND -> BDD AND operation
+ * - OR -> BDD OR operation
+ * - XOR -> BDD XOR operation
+ * - NOT -> XOR with constant 1
+ * - EXACTLY_ONE / EXACTLY_K / AT_MOST_K / AT_LEAST_K -> layered counter BDD
+ *   (see cardinality_bdd.hpp)
+ * - Field comparisons / IN -> bit-level comparator chain (see field_compare_bdd.hpp)
+ * - TRUE / FALSE -> constant diagram
+ * - Variable -> BDD variable node
+ */
+teddy::bdd_manager::diagram_t inline convert_to_bdd(const my_expression& expr,
+                                                    teddy::bdd_manager& mgr,
+                                                    conversion_budget* budget = nullptr) {
+    // First pass: collect all unique variable names using dag_walker
+    std::unordered_set<std::string> variable_names;
+    collect_variables_with_dag_walker(expr, variable_names);
+
+    // Build variable map with ordered variable names for consistent ordering
+    std::vector<std::string> sorted_vars = ordered_variable_names(variable_names);
+
+    std::cout << "TeDDy variable ordering: ";
+    for (size_t i = 0; i < sorted_vars.size(); ++i) {
+        std::cout << sorted_vars[i] << "=" << i;
+        if (i < sorted_vars.size() - 1)
+            std::cout << ", ";
+    }
+    std::cout << std::endl;
+
+    std::unordered_map<std::string, int> var_map;
+    for (size_t i = 0; i < sorted_vars.size(); ++i) {
+        var_map[sorted_vars[i]] = static_cast<int>(i);
+    }
+
+    return convert_to_bdd_with_map(expr, mgr, var_map, budget);
+}
+
 /**
  * @brief Alternative conversion using TeDDy's built-in from_expression_tree method
  *
@@ -166,9 +284,8 @@ teddy::bdd_manager::diagram_t inline convert_to_bdd_with_teddy_adapter(const my_
     std::unordered_set<std::string> variable_names;
     collect_variables_with_dag_walker(expr, variable_names);
 
-    // Build variable map with sorted variable names for consistent ordering
-    std::vector<std::string> sorted_vars(variable_names.begin(), variable_names.end());
-    std::ranges::sort(sorted_vars);
+    // Build variable map with ordered variable names for consistent ordering
+    std::vector<std::string> sorted_vars = ordered_variable_names(variable_names);
 
     std::cout << "TeDDy Adapter variable ordering: ";
     for (size_t i = 0; i < sorted_vars.size(); ++i) {
@@ -20,8 +20,10 @@
 #include <iostream>
 #include <libteddy/core.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "c_code_generator.hpp"
 #include "dot_graph_generator.hpp"
 #include "mermaid_graph_generator.hpp"
 #include "node_table_generator.hpp"
@@ -127,3 +129,58 @@ void write_teddy_nodes_to_markdown(const teddy::bdd_manager& manager,
                                    teddy::bdd_manager::diagram_t diagram,
                                    const std::vector<std::string>& variable_names,
                                    std::ostream& out);
+
+/**
+ * @brief Writes TeDDy BDD as a self-contained C evaluator
+ *
+ * Generates C source using the generic c_code_generator.hpp template: a
+ * branching `int <name>(const uint64_t* bits)` and, unless disabled in the
+ * configuration, a branch-free `<name>_batch` over 64-assignment words.
+ * Variable i of the generated code is variable_names[i].
+ *
+ * @param manager BDD manager (currently unused but kept for compatibility)
+ * @param diagram BDD diagram to compile
+ * @param variable_names Vector of variable names, in input bit order
+ * @param out Output stream for the C source
+ * @param config Function name and code style options
+ * @throws std::runtime_error If the configuration is invalid for this diagram
+ */
+void write_teddy_to_c(const teddy::bdd_manager& manager, teddy::bdd_manager::diagram_t diagram,
+                      const std::vector<std::string>& variable_names, std::ostream& out,
+                      const c_code::CCodeConfig& config = c_code::CCodeConfig());
+
+/**
+ * @brief Writes several BDDs of one manager as a single DOT graph
+ *
+ * Nodes shared between the outputs are drawn once, and a label node with
+ * the output name points at each root (see multi_output.hpp).
+ *
+ * @param manager BDD manager owning every diagram (currently unused)
+ * @param outputs Name and diagram of each output
+ * @param variable_names Vector of variable names for labeling
+ * @param out Output stream for DOT content
+ * @param graph_name Name for the generated DOT graph (default: "DD")
+ */
+void write_teddy_outputs_to_dot(
+    const teddy::bdd_manager& manager,
+    const std::vector<std::pair<std::string, teddy::bdd_manager::diagram_t>>& outputs,
+    const std::vector<std::string>& variable_names, std::ostream& out,
+    const std::string& graph_name = "DD");
+
+/**
+ * @brief Writes one node table for several BDDs of one manager
+ *
+ * Shared nodes get a single row; the row of each output root is listed
+ * after the table.
+ *
+ * @param manager BDD manager owning every diagram (currently unused)
+ * @param outputs Name and diagram of each output
+ * @param variable_names Vector of variable names for display
+ * @param out Output stream to write the table to
+ * @param include_headers Whether to include descriptive headers and footers (default: true)
+ */
+void write_teddy_outputs_nodes_to_stream(
+    const teddy::bdd_manager& manager,
+    const std::vector<std::pair<std::string, teddy::bdd_manager::diagram_t>>& outputs,
+    const std::vector<std::string>& variable_names, std::ostream& out,
+    bool include_headers = true);
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file teddy_mdd_convert.hpp
+ * @brief Conversion of expressions to TeDDy Multi-valued Decision Diagrams
+ *
+ * Enumerated fields (declared with `DOMAIN`) become a single multi-valued
+ * variable of a teddy::imdd_manager instead of being bit-blasted, so a test
+ * such as `color IN {red, blue}` is one node regardless of the domain size.
+ * Boolean variables and bit-vector field bits become two-valued variables,
+ * and all diagrams stay 0/1-valued so the Boolean operators carry over.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <functional>
+#include <libteddy/core.hpp>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "cardinality_bdd.hpp"
+#include "dag_walker.hpp"
+#include "expression_graph.hpp"
+#include "expression_iterator.hpp"
+#include "field_compare_bdd.hpp"
+#include "teddy_convert.hpp"
+#include "teddy_mdd_graph.hpp"
+
+/**
+ * @brief Collects the MDD variables of an expression in level order
+ *
+ * Uses the same order as the bit-blasted BDD (ordered_variable_names()),
+ * with each enumerated field placed where its most significant bit would be.
+ *
+ * @param expr Expression to scan
+ * @return Variable names, domains and value names
+ */
+inline mdd_variables collect_mdd_variables(const my_expression& expr) {
+    std::unordered_set<std::string> bit_names;
+    collect_variables_with_dag_walker(expr, bit_names);
+
+    // Map every bit of an enumerated field back to its field
+    std::unordered_map<std::string, my_field> enumerated_bits;
+    dag_walker::walk_dag_topological_order(
+        expression_iterator(expr), [&](const dag_walker::NodeInfo<expression_iterator>& info) {
+            const auto* node = static_cast<const my_expression*>(info.node.get_node_address());
+            if (const auto* cmp = node ? std::get_if<my_compare>(node) : nullptr) {
+                if (cmp->field.domain != 0) {
+                    for (size_t i = 0; i < cmp->field.width; ++i) {
+                        enumerated_bits.emplace(field_bit_name(cmp->field.name, i), cmp->field);
+                    }
+                }
+            }
+        });
+
+    mdd_variables vars;
+    auto add = [&](const std::string& name, int domain, std::vector<std::string> value_names) {
+        vars.index_of.emplace(name, static_cast<int>(vars.names.size()));
+        vars.names.push_back(name);
+        vars.domains.push_back(domain);
+        vars.value_names.push_back(std::move(value_names));
+    };
+    for (const auto& name : ordered_variable_names(bit_names)) {
+        auto it = enumerated_bits.find(name);
+        if (it == enumerated_bits.end()) {
+            add(name, 2, {});
+        } else if (!vars.index_of.contains(it->second.name)) {
+            add(it->second.name, static_cast<int>(it->second.domain), it->second.value_names);
+        }
+    }
+    return vars;
+}
+
+/**
+ * @brief Converts an expression tree to a Multi-valued Decision Diagram
+ *
+ * The manager must have been created over the domains of @p vars, e.g.
+ * `teddy::imdd_manager mgr(vars.names.size(), pool, vars.domains)`.
+ *
+ * @param expr The root expression to convert
+ * @param mgr MDD manager created over @p vars
+ * @param vars Variables returned by collect_mdd_variables()
+ * @return 0/1-valued MDD representing the logical function
+ *
+ * @throws std::runtime_error If a variable reference is not found during conversion
+ *
+ * Operator mappings:
+ * - AND / OR / XOR -> MDD apply on 0/1 diagrams
+ * - NOT -> XOR with constant 1
+ * - Enumerated field IN -> single node via EQUAL_TO / GREATER_EQUAL / LESS_EQUAL
+ * - Bit-vector field comparisons -> comparator chain (see field_compare_bdd.hpp)
+ * - Cardinality constraints -> layered counter (see cardinality_bdd.hpp)
+ */
+inline teddy::imdd_manager::diagram_t convert_to_mdd(const my_expression& expr,
+                                                     teddy::imdd_manager& mgr,
+                                                     const mdd_variables& vars) {
+    using mdd_t = teddy::imdd_manager::diagram_t;
+    using namespace teddy::ops;
+
+    auto variable = [&](const std::string& name) {
+        auto it = vars.index_of.find(name);
+        if (it == vars.index_of.end()) {
+            throw std::runtime_error("Variable not found: " + name);
+        }
+        return mgr.variable(it->second);
+    };
+
+    mdd_t zero = mgr.constant(0);
+    mdd_t one = mgr.constant(1);
+    auto ite = make_teddy_ite(mgr);
+
+    // Helper function for recursive conversion (no memoization needed for tree structure)
+    std::function<mdd_t(const my_expression&)> convert_recursive =
+        [&](const my_expression& e) -> mdd_t {
+        return std::visit(
+            [&](const auto& variant_expr) -> mdd_t {
+                using T = std::decay_t<decltype(variant_expr)>;
+
+                if constexpr (std::is_same_v<T, my_variable>) {
+                    return variable(variant_expr.variable_name);
+                } else if constexpr (std::is_same_v<T, my_and>) {
+                    return mgr.apply<AND>(convert_recursive(*variant_expr.left),
+                                          convert_recursive(*variant_expr.right));
+                } else if constexpr (std::is_same_v<T, my_or>) {
+                    return mgr.apply<OR>(convert_recursive(*variant_expr.left),
+                                         convert_recursive(*variant_expr.right));
+                } else if constexpr (std::is_same_v<T, my_xor>) {
+                    return mgr.apply<XOR>(convert_recursive(*variant_expr.left),
+                                          convert_recursive(*variant_expr.right));
+                } else if constexpr (std::is_same_v<T, my_not>) {
+                    return mgr.apply<XOR>(convert_recursive(*variant_expr.expr), one);
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    std::vector<std::pair<int, mdd_t>> operands;
+                    operands.reserve(variant_expr.operands.size());
+                    for (const auto& operand : variant_expr.operands) {
+                        mdd_t operand_mdd = convert_recursive(*operand);
+                        int level = cardinality_bdd::operand_level(
+                            *operand, [&](const std::string& name) {
+                                return static_cast<int>(mgr.get_level(vars.index_of.at(name)));
+                            });
+                        operands.emplace_back(level, std::move(operand_mdd));
+                    }
+                    return cardinality_bdd::build(variant_expr, std::move(operands), zero, one,
+                                                  ite);
+                } else if constexpr (std::is_same_v<T, my_compare>) {
+                    if (variant_expr.field.domain == 0) {
+                        return field_compare_bdd::build(variant_expr, variable, zero, one, ite);
+                    }
+                    // The parser normalizes every enumerated comparison to IN
+                    mdd_t x = variable(variant_expr.field.name);
+                    mdd_t result = zero;
+                    for (const auto& [lo, hi] : variant_expr.ranges) {
+                        mdd_t low = mgr.constant(static_cast<int>(lo));
+                        mdd_t high = mgr.constant(static_cast<int>(hi));
+                        mdd_t in_range =
+                            lo == hi ? mgr.apply<EQUAL_TO>(x, low)
+                                     : mgr.apply<AND>(mgr.apply<GREATER_EQUAL>(x, low),
+                                                      mgr.apply<LESS_EQUAL>(x, high));
+                        result = mgr.apply<OR>(result, in_range);
+                    }
+                    return result;
+                } else if constexpr (std::is_same_v<T, my_constant>) {
+                    return variant_expr.value ? one : zero;
+                }
+            },
+            e);
+    };
+
+    return convert_recursive(expr);
+}
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file teddy_mdd_graph.hpp
+ * @brief TeDDy MDD graph generation using generic template systems
+ *
+ * Provides DOT and node table output for Multi-valued Decision Diagrams built
+ * by convert_to_mdd(). Nodes of enumerated variables have one outgoing edge
+ * per distinct child, labelled with the set of values leading to it.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <iostream>
+#include <libteddy/core.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Variables of an MDD in level order
+ *
+ * Enumerated fields become a single variable with one value per domain
+ * element; Boolean variables and bit-vector field bits become two-valued
+ * variables.
+ */
+struct mdd_variables {
+    std::vector<std::string> names;                     ///< Variable names by index
+    std::vector<int> domains;                           ///< Domain sizes by index
+    std::vector<std::vector<std::string>> value_names;  ///< Value names by index (may be empty)
+    std::unordered_map<std::string, int> index_of;      ///< Index by variable name
+};
+
+/**
+ * @brief Writes an MDD as DOT graph using the generic template system
+ *
+ * Terminals are drawn as squares and variables as circles; edges are labelled
+ * with the values (or value names) of the variable that lead to each child.
+ *
+ * @param diagram MDD diagram to process
+ * @param variables Variables the diagram was built over
+ * @param out Output stream for DOT content
+ * @param graph_name Name for the generated DOT graph (default: "MDD")
+ */
+void write_teddy_mdd_to_dot(teddy::imdd_manager::diagram_t diagram, const mdd_variables& variables,
+                            std::ostream& out, const std::string& graph_name = "MDD");
+
+/**
+ * @brief Writes an MDD node table to an output stream using the generic template
+ *
+ * Each row lists the node's variable, type and its children as
+ * `values->index` pairs.
+ *
+ * @param diagram MDD diagram to analyze
+ * @param variables Variables the diagram was built over
+ * @param out Output stream to write the table to
+ * @param include_headers Whether to include descriptive headers and footers (default: true)
+ */
+void write_teddy_mdd_nodes_to_stream(teddy::imdd_manager::diagram_t diagram,
+                                     const mdd_variables& variables, std::ostream& out,
+                                     bool include_headers = true);
@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file teddy_mdd_iterator.hpp
+ * @brief TeDDy MDD iterator interface for graph traversal
+ *
+ * Iterator over the nodes of a TeDDy Multi-valued Decision Diagram. Unlike
+ * teddy_iterator, a node may have any number of sons; sons reached by several
+ * values are reported once, and the edge label lists the values.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <format>
+#include <libteddy/core.hpp>
+#include <string>
+#include <vector>
+
+#include "teddy_mdd_graph.hpp"
+
+/**
+ * @class teddy_mdd_iterator
+ * @brief Iterator for traversing TeDDy Multi-valued Decision Diagrams
+ *
+ * Compatible with the generic DOT generator and with
+ * node_table::generate_multiway_text_table().
+ */
+class teddy_mdd_iterator {
+   public:
+    using node_t = teddy::imdd_manager::diagram_t::node_t;
+
+   private:
+    node_t* current_node_;            ///< Current MDD node
+    const mdd_variables* variables_;  ///< Variable names, domains and value names
+
+    /**
+     * @brief Number of sons of the current (internal) node
+     */
+    int domain() const {
+        int index = current_node_->get_index();
+        if (variables_ && index < static_cast<int>(variables_->domains.size())) {
+            return variables_->domains[index];
+        }
+        return 2;
+    }
+
+    /**
+     * @brief Display text for value @p value of the current node's variable
+     */
+    std::string value_label(int value) const {
+        int index = current_node_->get_index();
+        if (variables_ && index < static_cast<int>(variables_->value_names.size())) {
+            const auto& names = variables_->value_names[index];
+            if (value < static_cast<int>(names.size())) {
+                return names[value];
+            }
+        }
+        return std::to_string(value);
+    }
+
+   public:
+    explicit teddy_mdd_iterator(node_t* node = nullptr, const mdd_variables* variables = nullptr)
+        : current_node_(node), variables_(variables) {}
+
+    bool is_valid() const {
+        return current_node_ != nullptr;
+    }
+
+    bool operator==(const teddy_mdd_iterator& other) const {
+        return current_node_ == other.current_node_;
+    }
+
+    bool operator!=(const teddy_mdd_iterator& other) const {
+        return !(*this == other);
+    }
+
+    // Generic Template Property Methods (required by both template systems)
+    const void* get_node_address() const {
+        return static_cast<const void*>(current_node_);
+    }
+
+    node_t* get_node() const {
+        return current_node_;
+    }
+
+    /**
+     * @brief Get the display label for this node
+     * @return Variable name for internal nodes, value for terminals
+     */
+    std::string get_label() const {
+        if (!current_node_) {
+            return "";
+        }
+        if (current_node_->is_terminal()) {
+            return std::to_string(current_node_->get_value());
+        }
+        return get_variable_name();
+    }
+
+    std::string get_shape() const {
+        if (!current_node_) {
+            return "circle";
+        }
+        return current_node_->is_terminal() ? "square" : "circle";
+    }
+
+    std::string get_tooltip() const {
+        if (!current_node_) {
+            return "";
+        }
+        if (current_node_->is_terminal()) {
+            return std::to_string(current_node_->get_value());
+        }
+        return std::format("{} (domain {})", current_node_->get_index(), domain());
+    }
+
+    /**
+     * @brief Get child iterators for this node
+     * @return One iterator per distinct son, in order of the first value leading to it
+     */
+    std::vector<teddy_mdd_iterator> get_children() const {
+        std::vector<teddy_mdd_iterator> children;
+        if (!current_node_ || current_node_->is_terminal()) {
+            return children;
+        }
+
+        for (int value = 0; value < domain(); ++value) {
+            node_t* son = current_node_->get_son(value);
+            bool seen = std::ranges::any_of(
+                children, [son](const teddy_mdd_iterator& c) { return c.current_node_ == son; });
+            if (son && !seen) {
+                children.emplace_back(son, variables_);
+            }
+        }
+        return children;
+    }
+
+    /**
+     * @brief Values of this node's variable that lead to @p child
+     * @return Comma separated values, with runs of three or more written as "lo..hi"
+     */
+    std::string get_edge_label(const teddy_mdd_iterator& child, size_t /*child_index*/) const {
+        if (!current_node_ || current_node_->is_terminal()) {
+            return "";
+        }
+
+        std::string label;
+        const int count = domain();
+        for (int value = 0; value < count; ++value) {
+            if (current_node_->get_son(value) != child.current_node_) {
+                continue;
+            }
+            int last = value;
+            while (last + 1 < count && current_node_->get_son(last + 1) == child.current_node_) {
+                ++last;
+            }
+            label += label.empty() ? "" : ", ";
+            if (last - value >= 2) {
+                label += value_label(value) + ".." + value_label(last);
+                value = last;
+            } else {
+                label += value_label(value);
+            }
+        }
+        return label;
+    }
+
+    std::string get_edge_style(const teddy_mdd_iterator& /*child*/, size_t /*child_index*/) const {
+        return "solid";
+    }
+
+    // NodeTableIterator concept methods
+    bool is_terminal() const {
+        return current_node_ && current_node_->is_terminal();
+    }
+
+    std::string get_variable_name() const {
+        if (!current_node_ || current_node_->is_terminal()) {
+            return "-";
+        }
+        int index = current_node_->get_index();
+        if (variables_ && index < static_cast<int>(variables_->names.size())) {
+            return variables_->names[index];
+        }
+        return std::format("x{}", index);
+    }
+
+    std::string get_type() const {
+        if (!current_node_) {
+            return "Invalid";
+        }
+        if (current_node_->is_terminal()) {
+            return std::format("Terminal({})", current_node_->get_value());
+        }
+        return std::format("Variable({})", domain());
+    }
+
+    int get_terminal_value() const {
+        if (current_node_ && current_node_->is_terminal()) {
+            return current_node_->get_value();
+        }
+        return 0;
+    }
+};
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file truth_table.hpp
+ * @brief Bit-parallel truth tables for expressions with small supports
+ *
+ * For an expression over n <= max_variables variables the whole function fits
+ * in 2^n bits. The table is computed by evaluating the expression once over
+ * all rows with the bit-sliced batch evaluator (see batch_evaluator.hpp), so
+ * every AND/OR/XOR/NOT handles 64 rows per word, or more with AVX2/AVX-512.
+ *
+ * Row r of a table is the assignment in which variable i has the value of bit
+ * i of r, with variables indexed by their position in the ordered name list.
+ *
+ * A table converts to a TeDDy BDD bottom-up in time linear in its size, and
+ * doubles as an O(1) lookup-table evaluator that can be exported as C source.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <libteddy/core.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "batch_evaluator.hpp"
+#include "expression_types.hpp"
+
+namespace truth_table {
+
+/// Largest support a table is built for (2^20 rows, 128 KiB)
+constexpr std::size_t max_variables = 20;
+
+/**
+ * @class table
+ * @brief Truth table of a Boolean function, one bit per row
+ */
+class table {
+   public:
+    /**
+     * @brief Creates a table from its packed rows
+     *
+     * @param variable_count Number of variables n
+     * @param words 2^n row bits, 64 rows per word, unused high bits zero
+     * @throws std::runtime_error If n exceeds max_variables or the word count is wrong
+     */
+    table(std::size_t variable_count, std::vector<std::uint64_t> words);
+
+    std::size_t variable_count() const {
+        return variable_count_;
+    }
+
+    std::uint64_t rows() const {
+        return std::uint64_t{1} << variable_count_;
+    }
+
+    const std::vector<std::uint64_t>& words() const {
+        return words_;
+    }
+
+    /**
+     * @brief Looks up one row
+     * @param row Assignment with variable i in bit i; higher bits are ignored
+     */
+    bool evaluate(std::uint64_t row) const {
+        row &= rows() - 1;
+        return ((words_[row >> 6] >> (row & 63)) & 1) != 0;
+    }
+
+    /**
+     * @brief Looks up one assignment
+     *
+     * @param assignment One byte per variable (0 = false, otherwise true)
+     * @throws std::runtime_error If the assignment has fewer values than variables
+     */
+    bool evaluate(std::span<const std::uint8_t> assignment) const;
+
+    /**
+     * @brief Number of rows for which the function is true
+     */
+    std::uint64_t count_true() const;
+
+   private:
+    std::size_t variable_count_;
+    std::vector<std::uint64_t> words_;
+};
+
+/**
+ * @brief Computes the truth table of an expression
+ *
+ * @param expr Expression to tabulate
+ * @param variable_names Ordered variables; must contain every variable of @p expr
+ * @param options Instruction set and threads for the bit-sliced evaluation
+ * @throws std::runtime_error If there are more than max_variables variables or a
+ *         variable of the expression is missing from @p variable_names
+ */
+table build(const my_expression& expr, const std::vector<std::string>& variable_names,
+            const batch_eval::evaluate_options& options = {});
+
+/**
+ * @brief Builds the TeDDy BDD of a table bottom-up
+ *
+ * The table is rearranged into TeDDy's truth-vector order and reduced level by
+ * level with bdd_manager::from_vector, which is linear in the table size.
+ *
+ * @param tt Table to convert
+ * @param manager Manager with exactly tt.variable_count() variables
+ * @throws std::runtime_error If the manager has a different number of variables
+ */
+teddy::bdd_manager::diagram_t to_teddy(const table& tt, teddy::bdd_manager& manager);
+
+/**
+ * @brief Writes a table as a self-contained C lookup function
+ *
+ * Emits `int <function_name>(uint32_t row)` over a constant word array, with
+ * the variable bit positions listed in a comment.
+ *
+ * @param tt Table to export
+ * @param variable_names Name of each variable, in row bit order
+ * @param out Output stream for the C source
+ * @param function_name Name of the generated function (a C identifier)
+ */
+void write_c_lookup(const table& tt, const std::vector<std::string>& variable_names,
+                    std::ostream& out, const std::string& function_name = "tt_eval");
+
+}  // namespace truth_table
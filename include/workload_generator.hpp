@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file workload_generator.hpp
+ * @brief Synthetic expression-file generator for scalable BDD stress inputs
+ *
+ * Generates expression files in the project's input format for parameterized
+ * problem families (N-Queens, random k-CNF, parity chains, adders, multipliers
+ * and packet-filter-like rule sets). All randomness is driven by a seedable
+ * generator so every workload is reproducible from its parameters.
+ *
+ * Variable names are chosen so that the lexicographic ordering used by the
+ * converters yields the intended BDD variable order (see
+ * GeneratorOptions::interleaved).
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace workload_generator {
+
+/**
+ * @brief Parameters shared by all workload families
+ *
+ * Not every family uses every field; unused fields are ignored.
+ */
+struct GeneratorOptions {
+    int n = 8;                 ///< Problem size (board size, variable count or operand width)
+    std::uint64_t seed = 1;    ///< Seed for all random choices
+    int k = 3;                 ///< Literals per clause for random k-CNF
+    double ratio = 4.26;       ///< Clause/variable ratio for random k-CNF
+    int bit = -1;              ///< Output bit for adder/multiplier (-1 selects the default)
+    int rules = 16;            ///< Number of rules for packet filters
+    std::string fields = "proto:8,port:16,ttl:8";  ///< Packet filter fields as name:width
+    bool interleaved = true;   ///< Interleave operand bits in the variable order
+    std::size_t max_size = 5'000'000;  ///< Upper bound on expanded expression tree nodes
+};
+
+/**
+ * @brief Names of all supported workload families
+ */
+const std::vector<std::string>& family_names();
+
+/**
+ * @brief Generates N-Queens constraints for an n x n board
+ *
+ * Encodes exactly one queen per row and column and at most one queen per
+ * diagonal using pairwise at-most-one constraints, so the number of
+ * satisfying assignments equals the number of N-Queens solutions.
+ *
+ * @param options Generator options (uses `n`)
+ * @return Expression file contents
+ * @throws std::invalid_argument If n < 1
+ */
+std::string generate_n_queens(const GeneratorOptions& options);
+
+/**
+ * @brief Generates a uniform random k-CNF formula
+ *
+ * Produces round(ratio * n) clauses over n variables, each with k distinct
+ * variables and random polarities.
+ *
+ * @param options Generator options (uses `n`, `k`, `ratio`, `seed`)
+ * @return Expression file contents
+ * @throws std::invalid_argument If k < 1, k > n or ratio <= 0
+ */
+std::string generate_random_cnf(const GeneratorOptions& options);
+
+/**
+ * @brief Generates an n-variable parity chain with random literal polarities
+ *
+ * @param options Generator options (uses `n`, `seed`)
+ * @return Expression file contents
+ * @throws std::invalid_argument If n < 1
+ */
+std::string generate_parity_chain(const GeneratorOptions& options);
+
+/**
+ * @brief Generates one output bit of an n-bit ripple-carry adder
+ *
+ * Bits 0..n-1 select sum bits, bit n selects the carry-out (default).
+ *
+ * @param options Generator options (uses `n`, `bit`, `interleaved`, `max_size`)
+ * @return Expression file contents
+ * @throws std::invalid_argument If n < 1 or the bit is out of range
+ */
+std::string generate_adder_bit(const GeneratorOptions& options);
+
+/**
+ * @brief Generates one product bit of an n x n array multiplier
+ *
+ * The default bit is n-1, the middle bit that is known to require
+ * exponential BDD size under every variable order.
+ *
+ * @param options Generator options (uses `n`, `bit`, `interleaved`, `max_size`)
+ * @return Expression file contents
+ * @throws std::invalid_argument If n < 1 or the bit is out of range
+ * @throws std::runtime_error If the expanded expression exceeds `max_size` nodes
+ */
+std::string generate_multiplier_bit(const GeneratorOptions& options);
+
+/**
+ * @brief Generates a packet-filter-like disjunction of field matches
+ *
+ * Each rule is a conjunction of exact or prefix matches on randomly chosen
+ * fields; the filter accepts a packet if any rule matches.
+ *
+ * @param options Generator options (uses `rules`, `fields`, `seed`)
+ * @return Expression file contents
+ * @throws std::invalid_argument If the field specification is malformed
+ */
+std::string generate_packet_filter(const GeneratorOptions& options);
+
+/**
+ * @brief Generates a workload by family name
+ *
+ * @param family One of the names returned by family_names()
+ * @param options Generator options
+ * @return Expression file contents
+ * @throws std::invalid_argument If the family is unknown
+ */
+std::string generate_workload(const std::string& family, const GeneratorOptions& options);
+
+}  // namespace workload_generator
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file adapter_benchmark_main.cpp
+ * @brief Benchmark for TeDDy's from_expression_tree on deeply nested negations
+ *
+ * Generates NOT chains and NOT/AND nests of growing depth, then times the
+ * construction and copy of the expression_adapter for each and the
+ * conversion with from_expression_tree against the custom recursive
+ * conversion (convert_to_bdd()). Both diagrams must be equal. The adapter
+ * is linear in the expression size, so the times should grow linearly with
+ * the depth.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "benchmark_timing.hpp"
+#include "expression_adapter.hpp"
+#include "expression_graph.hpp"
+#include "teddy_convert.hpp"
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using benchmark_timing::best_time;
+
+/// Variables cycled through by the NOT/AND nests
+constexpr int nest_variables = 8;
+
+void print_help() {
+    std::cout << "Expression Adapter Benchmark - nested negations with from_expression_tree\n";
+    std::cout << "=========================================================================\n\n";
+    std::cout << "Usage: bdd_adapter_bench [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --max-depth=<int>     Largest nesting depth (default 4096); depths grow\n";
+    std::cout << "                        from 16 by factors of 4\n";
+    std::cout << "  --repeat=<int>        Timed runs per measurement, best is reported "
+                 "(default 3)\n";
+    std::cout << "  --help, -h            Show this help message\n";
+}
+
+/**
+ * @brief `NOT NOT ... NOT x0` with @p depth negations
+ */
+my_expression_ptr not_chain(int depth) {
+    auto expr = std::make_unique<my_expression>(my_variable{"x0"});
+    for (int i = 0; i < depth; ++i) {
+        expr = std::make_unique<my_expression>(my_not{std::move(expr)});
+    }
+    return expr;
+}
+
+/**
+ * @brief `NOT (x0 AND NOT (x1 AND NOT (...)))` with @p depth levels
+ */
+my_expression_ptr not_and_nest(int depth) {
+    auto expr = std::make_unique<my_expression>(my_variable{"x0"});
+    for (int i = depth - 1; i >= 0; --i) {
+        auto variable =
+            std::make_unique<my_expression>(my_variable{"x" + std::to_string(i % nest_variables)});
+        expr = std::make_unique<my_expression>(
+            my_not{std::make_unique<my_expression>(my_and{std::move(variable), std::move(expr)})});
+    }
+    return expr;
+}
+
+/**
+ * @brief Destroys a generated expression without recursing once per level
+ */
+void release(my_expression_ptr expr) {
+    while (expr) {
+        if (auto* negation = std::get_if<my_not>(expr.get())) {
+            expr = std::move(negation->expr);
+        } else if (auto* conjunction = std::get_if<my_and>(expr.get())) {
+            expr = std::move(conjunction->right);
+        } else {
+            expr.reset();
+        }
+    }
+}
+
+/**
+ * @brief Prints one row of measurements
+ * @return false if from_expression_tree built a different diagram
+ */
+bool run_workload(const std::string& name, int depth, const my_expression& expr, int repeat) {
+    std::unordered_map<std::string, int> var_map;
+    for (int i = 0; i < nest_variables; ++i) {
+        var_map["x" + std::to_string(i)] = i;
+    }
+
+    const double build_time =
+        best_time(repeat, [&] { expression_adapter adapter(expr, var_map); });
+    expression_adapter adapter(expr, var_map);
+    const double copy_time = best_time(repeat, [&] { expression_adapter copy(adapter); });
+
+    const double teddy_time = best_time(repeat, [&] {
+        teddy::bdd_manager manager(nest_variables, 10'000);
+        manager.from_expression_tree(adapter);
+    });
+    const double custom_time = best_time(repeat, [&] {
+        teddy::bdd_manager manager(nest_variables, 10'000);
+        convert_to_bdd_with_map(expr, manager, var_map);
+    });
+
+    teddy::bdd_manager manager(nest_variables, 10'000);
+    auto f = manager.from_expression_tree(adapter);
+    const auto nodes = manager.get_node_count(f);
+    const bool equal = f.equals(convert_to_bdd_with_map(expr, manager, var_map));
+
+    std::cout << std::format("{:<10} {:>7} {:>9} {:>12.3f} {:>10.3f} {:>12.3f} {:>12.3f} {:>7}\n",
+                             name, depth, expression_size(expr), build_time * 1e3,
+                             copy_time * 1e6, teddy_time * 1e3, custom_time * 1e3, nodes);
+    if (!equal) {
+        std::cerr << "Error: from_expression_tree disagrees on " << name << " depth " << depth
+                  << "\n";
+    }
+    return equal;
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+/**
+ * @brief Adapter benchmark entry point
+ *
+ * @param argc Number of command line arguments
+ * @param argv Array of command line argument strings
+ * @return 0 on success, 1 on error or if the conversions disagree
+ */
+int main(int argc, const char* argv[]) {
+    int max_depth = 4096;
+    int repeat = 3;
+    bool show_help = false;
+    bool help_due_to_error = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg.starts_with("--max-depth=")) {
+                max_depth = std::max(1, std::stoi(arg.substr(12)));
+            } else if (arg.starts_with("--repeat=")) {
+                repeat = std::max(1, std::stoi(arg.substr(9)));
+            } else if (arg == "--help" || arg == "-h") {
+                show_help = true;
+                break;
+            } else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric option value\n";
+        return 1;
+    }
+
+    if (show_help) {
+        print_help();
+        return help_due_to_error ? 1 : 0;
+    }
+
+    std::vector<int> depths;
+    for (int depth = 16; depth < max_depth; depth *= 4) {
+        depths.push_back(depth);
+    }
+    depths.push_back(max_depth);
+
+    bool agree = true;
+    std::cout << std::format("{:<10} {:>7} {:>9} {:>12} {:>10} {:>12} {:>12} {:>7}\n", "Workload",
+                             "Depth", "Expr", "Adapter ms", "Copy us", "TeDDy ms", "Custom ms",
+                             "nodes");
+    try {
+        for (int depth : depths) {
+            auto chain = not_chain(depth);
+            agree = run_workload("not-chain", depth, *chain, repeat) && agree;
+            release(std::move(chain));
+        }
+        for (int depth : depths) {
+            auto nest = not_and_nest(depth);
+            agree = run_workload("not-and", depth, *nest, repeat) && agree;
+            release(std::move(nest));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return agree ? 0 : 1;
+}
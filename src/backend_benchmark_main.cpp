@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file backend_benchmark_main.cpp
+ * @brief Conversion benchmark for the TeDDy, CUDD and native BDD backends
+ *
+ * Converts every expression file of a corpus with each backend, reports the
+ * best conversion time and the resulting node counts, and cross-checks that
+ * all three diagrams agree on random assignments. The TeDDy diagram is also
+ * copied into the CUDD manager (bdd_transfer.hpp), where by canonicity it
+ * must be the node CUDD built. Directories are expanded to the expression
+ * files they contain. TeDDy and CUDD managers are sized from the input
+ * (manager_sizing.hpp) unless `--sizing=fixed` selects the fixed defaults, so
+ * the two policies can be timed against each other.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include <algorithm>
+#include <cudd/cuddObj.hh>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "bdd_transfer.hpp"
+#include "benchmark_timing.hpp"
+#include "cudd_convert.hpp"
+#include "cudd_iterator.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "manager_sizing.hpp"
+#include "native_bdd.hpp"
+#include "native_convert.hpp"
+#include "teddy_convert.hpp"
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using benchmark_timing::best_time;
+
+void print_help() {
+    std::cout << "BDD Backend Benchmark - TeDDy, CUDD and native conversion\n";
+    std::cout << "==========================================================\n\n";
+    std::cout << "Usage: bdd_backend_bench <file_or_directory>... [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --repeat=<int>        Timed runs per backend, best is reported (default 3)\n";
+    std::cout << "  --rows=<int>          Random assignments for the cross-check (default 1000)\n";
+    std::cout << "  --seed=<int>          Seed for the random assignments (default 1)\n";
+    std::cout << "  --sizing=auto|fixed   Size TeDDy and CUDD managers from the input (default)\n";
+    std::cout << "                        or use the fixed defaults\n";
+    std::cout << "  --help, -h            Show this help message\n";
+}
+
+/**
+ * @brief Silences std::cout while alive (the converters log the variable order)
+ */
+class quiet_cout {
+   public:
+    quiet_cout() : saved_(std::cout.rdbuf(sink_.rdbuf())) {}
+    ~quiet_cout() {
+        std::cout.rdbuf(saved_);
+    }
+
+   private:
+    std::ostringstream sink_;
+    std::streambuf* saved_;
+};
+
+/**
+ * @brief Expands directories into their expression files, sorted by name
+ *
+ * Files written by bdd_demo next to its input (`*_nodes.txt`) are skipped.
+ */
+std::vector<std::filesystem::path> expand_inputs(const std::vector<std::string>& inputs) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& input : inputs) {
+        std::filesystem::path path(input);
+        if (!std::filesystem::is_directory(path)) {
+            files.push_back(path);
+            continue;
+        }
+        std::vector<std::filesystem::path> found;
+        for (const auto& entry : std::filesystem::directory_iterator(path)) {
+            const auto& file = entry.path();
+            if (entry.is_regular_file() && file.extension() == ".txt"
+                && !file.stem().string().ends_with("_nodes")) {
+                found.push_back(file);
+            }
+        }
+        std::sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
+    }
+    return files;
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+/**
+ * @brief Backend benchmark entry point
+ *
+ * @param argc Number of command line arguments
+ * @param argv Array of command line argument strings
+ * @return 0 on success, 1 on error or if the backends disagree
+ */
+int main(int argc, const char* argv[]) {
+    std::vector<std::string> inputs;
+    int repeat = 3;
+    std::size_t rows = 1000;
+    std::uint64_t seed = 1;
+    bool adaptive_sizing = true;
+    bool show_help = false;
+    bool help_due_to_error = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg.starts_with("--repeat=")) {
+                repeat = std::max(1, std::stoi(arg.substr(9)));
+            } else if (arg.starts_with("--rows=")) {
+                rows = std::stoull(arg.substr(7));
+            } else if (arg.starts_with("--seed=")) {
+                seed = std::stoull(arg.substr(7));
+            } else if (arg == "--sizing=auto" || arg == "--sizing=fixed") {
+                adaptive_sizing = arg == "--sizing=auto";
+            } else if (arg == "--help" || arg == "-h") {
+                show_help = true;
+                break;
+            } else if (arg.starts_with("-")) {
+                std::cerr << "Unknown option: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            } else {
+                inputs.push_back(arg);
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric option value\n";
+        return 1;
+    }
+
+    if (!show_help && inputs.empty()) {
+        std::cerr << "No expression files specified\n";
+        show_help = true;
+        help_due_to_error = true;
+    }
+
+    if (show_help) {
+        print_help();
+        return help_due_to_error ? 1 : 0;
+    }
+
+    bool agree = true;
+    std::cout << std::format("{:<32} {:>5} {:>10} {:>9} {:>10} {:>9} {:>10} {:>9} {:>9}\n",
+                             "File", "Vars", "TeDDy ms", "nodes", "CUDD ms", "nodes", "Native ms",
+                             "nodes", "peak");
+    for (const auto& file : expand_inputs(inputs)) {
+        my_expression_ptr expr;
+        try {
+            quiet_cout quiet;
+            expr = read_expression_from_file(file.string());
+        } catch (const std::exception& e) {
+            // Files the parser rejects (edge-case inputs) are not benchmarks
+            std::cout << std::format("{:<32} skipped: {}\n", file.filename().string(), e.what());
+            continue;
+        }
+        try {
+            std::unordered_set<std::string> variable_names;
+            collect_variables_with_dag_walker(*expr, variable_names);
+            const auto n = variable_names.size();
+            const manager_sizing sizing =
+                adaptive_sizing ? size_managers(expression_size(*expr), n) : manager_sizing{};
+
+            // Each timed run starts from an empty manager
+            std::size_t teddy_nodes = 0;
+            std::size_t cudd_nodes = 0;
+            std::size_t native_nodes = 0;
+            std::size_t native_peak = 0;
+            double teddy_time = 0.0;
+            double cudd_time = 0.0;
+            double native_time = 0.0;
+            {
+                quiet_cout quiet;
+                teddy_time = best_time(repeat, [&] {
+                    teddy::bdd_manager manager(static_cast<int>(n), sizing.teddy_pool,
+                                               sizing.teddy_overflow);
+                    teddy_nodes = manager.get_node_count(convert_to_bdd(*expr, manager));
+                });
+                cudd_time = best_time(repeat, [&] {
+                    auto [cudd_mgr, bdd] =
+                        convert_to_cudd_bdd(*expr, variable_names, nullptr, sizing);
+                    cudd_nodes = static_cast<std::size_t>(bdd.nodeCount());
+                });
+                native_time = best_time(repeat, [&] {
+                    native_bdd::manager manager(static_cast<std::uint32_t>(n));
+                    auto f = convert_to_native_bdd(*expr, manager);
+                    native_nodes = manager.node_count(f);
+                    native_peak = manager.get_statistics().peak_nodes;
+                });
+            }
+
+            // Cross-check one diagram of each backend on random assignments
+            bool file_agrees = true;
+            {
+                quiet_cout quiet;
+                teddy::bdd_manager manager(static_cast<int>(n), 1'000);
+                auto f = convert_to_bdd(*expr, manager);
+                auto [cudd_mgr, cudd_bdd] = convert_to_cudd_bdd(*expr, variable_names);
+                native_bdd::manager native_mgr(static_cast<std::uint32_t>(n));
+                auto g = convert_to_native_bdd(*expr, native_mgr);
+                file_agrees = copy_teddy_to_cudd(f, *cudd_mgr).getNode() == cudd_bdd.getNode();
+                std::mt19937_64 rng(seed);
+                std::vector<int> values(n);
+                std::vector<std::uint8_t> bytes(n);
+                for (std::size_t r = 0; r < rows && file_agrees; ++r) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        values[i] = static_cast<int>(rng() & 1);
+                        bytes[i] = static_cast<std::uint8_t>(values[i]);
+                    }
+                    const bool expected = manager.evaluate(f, values) == 1;
+                    cudd_iterator it(*cudd_mgr, cudd_bdd.getNode(), nullptr);
+                    while (!it.is_terminal()) {
+                        auto children = it.get_children();
+                        it = children[values[Cudd_NodeReadIndex(it.get_node())]];
+                    }
+                    const bool from_cudd = it.get_terminal_value() == 1;
+                    const bool from_native = native_mgr.evaluate(g, bytes);
+                    file_agrees = expected == from_cudd && expected == from_native;
+                }
+            }
+            if (!file_agrees) {
+                std::cerr << "Error: backends disagree on " << file.string() << "\n";
+                agree = false;
+            }
+
+            std::cout << std::format(
+                "{:<32} {:>5} {:>10.3f} {:>9} {:>10.3f} {:>9} {:>10.3f} {:>9} {:>9}\n",
+                file.filename().string(), n, teddy_time * 1e3, teddy_nodes, cudd_time * 1e3,
+                cudd_nodes, native_time * 1e3, native_nodes, native_peak);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << file.string() << ": " << e.what() << "\n";
+            agree = false;
+        }
+    }
+    return agree ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file batch_benchmark_main.cpp
+ * @brief Throughput benchmark for the bit-sliced batch evaluator
+ *
+ * Compiles an expression file to batch programs (directly from the expression
+ * tree and from the TeDDy and CUDD BDDs), evaluates them over random columnar
+ * input with each available instruction set, checks that all of them agree,
+ * and reports throughput in assignments per second.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cudd/cuddObj.hh>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "batch_evaluator.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "teddy_convert.hpp"
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+void print_help() {
+    std::cout << "BDD Batch Benchmark - Bit-sliced evaluation throughput\n";
+    std::cout << "======================================================\n\n";
+    std::cout << "Usage: bdd_batch_bench <expression_file> [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --rows=<int>          Assignments per batch (default 1000000)\n";
+    std::cout << "  --repeat=<int>        Timed runs per configuration, best is reported "
+                 "(default 5)\n";
+    std::cout << "  --threads=<int>       Worker threads (default 0 = hardware concurrency)\n";
+    std::cout << "  --isa=<name>          auto, scalar, avx2, avx512 or all (default all)\n";
+    std::cout << "  --source=<name>       expression, teddy, cudd or all (default all)\n";
+    std::cout << "  --seed=<int>          Seed for the random input columns (default 1)\n";
+    std::cout << "  --help, -h            Show this help message\n";
+}
+
+/**
+ * @brief Named program to benchmark
+ */
+struct benchmark_program {
+    std::string source;
+    batch_eval::program prog;
+};
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+/**
+ * @brief Batch benchmark entry point
+ *
+ * @param argc Number of command line arguments
+ * @param argv Array of command line argument strings
+ * @return 0 on success, 1 on error or if the evaluated results disagree
+ */
+int main(int argc, const char* argv[]) {
+    std::string input_file;
+    std::size_t rows = 1'000'000;
+    int repeat = 5;
+    unsigned threads = 0;
+    std::string isa_option = "all";
+    std::string source_option = "all";
+    std::uint64_t seed = 1;
+    bool show_help = false;
+    bool help_due_to_error = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg.starts_with("--rows=")) {
+                rows = std::stoull(arg.substr(7));
+            } else if (arg.starts_with("--repeat=")) {
+                repeat = std::max(1, std::stoi(arg.substr(9)));
+            } else if (arg.starts_with("--threads=")) {
+                threads = static_cast<unsigned>(std::stoul(arg.substr(10)));
+            } else if (arg.starts_with("--isa=")) {
+                isa_option = arg.substr(6);
+            } else if (arg.starts_with("--source=")) {
+                source_option = arg.substr(9);
+            } else if (arg.starts_with("--seed=")) {
+                seed = std::stoull(arg.substr(7));
+            } else if (arg == "--help" || arg == "-h") {
+                show_help = true;
+                break;
+            } else if (arg.starts_with("-")) {
+                std::cerr << "Unknown option: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            } else if (input_file.empty()) {
+                input_file = arg;
+            } else {
+                std::cerr << "Multiple input files specified. Only one file is allowed.\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric option value\n";
+        return 1;
+    }
+
+    if (!show_help && input_file.empty()) {
+        std::cerr << "No expression file specified\n";
+        show_help = true;
+        help_due_to_error = true;
+    }
+
+    if (show_help) {
+        print_help();
+        return help_due_to_error ? 1 : 0;
+    }
+
+    std::vector<batch_eval::isa> isas;
+    std::vector<benchmark_program> programs;
+    try {
+        if (isa_option == "all") {
+            for (auto value : {batch_eval::isa::scalar, batch_eval::isa::avx2,
+                               batch_eval::isa::avx512}) {
+                if (batch_eval::isa_supported(value)) {
+                    isas.push_back(value);
+                }
+            }
+        } else {
+            isas.push_back(batch_eval::parse_isa(isa_option));
+        }
+        if (source_option != "all" && source_option != "expression" && source_option != "teddy"
+            && source_option != "cudd") {
+            throw std::runtime_error("Unknown source: " + source_option
+                                     + " (expected expression, teddy, cudd or all)");
+        }
+
+        auto expr = read_expression_from_file(input_file);
+        std::unordered_set<std::string> variable_names;
+        collect_variables_with_dag_walker(*expr, variable_names);
+        std::vector<std::string> ordered = ordered_variable_names(variable_names);
+
+        if (source_option == "all" || source_option == "expression") {
+            programs.push_back({"expression", batch_eval::compile_expression(*expr)});
+        }
+        if (source_option == "all" || source_option == "teddy") {
+            teddy::bdd_manager manager(static_cast<int>(ordered.size()), 1'000);
+            auto f = convert_to_bdd(*expr, manager);
+            programs.push_back({"teddy", batch_eval::compile_teddy(f, ordered)});
+        }
+        if (source_option == "all" || source_option == "cudd") {
+            auto [cudd_mgr, bdd] = convert_to_cudd_bdd(*expr, variable_names);
+            programs.push_back({"cudd", batch_eval::compile_cudd(bdd, ordered)});
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    // Random input columns shared by every configuration
+    batch_eval::column_batch batch;
+    batch.rows = rows;
+    std::mt19937_64 rng(seed);
+    for (const auto& name : programs.front().prog.inputs()) {
+        std::vector<std::uint64_t> column(batch_eval::words_for_rows(rows));
+        std::generate(column.begin(), column.end(), std::ref(rng));
+        batch.columns.emplace(name, std::move(column));
+    }
+
+    std::cout << std::format("\nRows: {}, variables: {}, repeat: {}\n\n", rows,
+                             programs.front().prog.inputs().size(), repeat);
+    std::cout << std::format("{:<12} {:<8} {:>12} {:>12} {:>16} {:>12}\n", "Source", "ISA",
+                             "Instructions", "Best ms", "Assignments/s", "True rows");
+
+    std::vector<std::uint64_t> reference;
+    bool mismatch = false;
+    for (const auto& [source, prog] : programs) {
+        for (auto instruction_set : isas) {
+            batch_eval::evaluate_options options;
+            options.instruction_set = instruction_set;
+            options.threads = threads;
+
+            std::vector<std::uint64_t> result;
+            double best_seconds = 0.0;
+            try {
+                result = batch_eval::evaluate(prog, batch, options);  // Warm-up
+                for (int r = 0; r < repeat; ++r) {
+                    auto start = std::chrono::steady_clock::now();
+                    result = batch_eval::evaluate(prog, batch, options);
+                    std::chrono::duration<double> elapsed =
+                        std::chrono::steady_clock::now() - start;
+                    if (r == 0 || elapsed.count() < best_seconds) {
+                        best_seconds = elapsed.count();
+                    }
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << "\n";
+                return 1;
+            }
+
+            std::uint64_t true_rows = 0;
+            for (auto word : result) {
+                true_rows += static_cast<std::uint64_t>(std::popcount(word));
+            }
+            double rate = best_seconds > 0.0 ? static_cast<double>(rows) / best_seconds : 0.0;
+            std::cout << std::format("{:<12} {:<8} {:>12} {:>12.3f} {:>16.3e} {:>12}\n", source,
+                                     batch_eval::isa_name(instruction_set), prog.code().size(),
+                                     best_seconds * 1000.0, rate, true_rows);
+
+            if (reference.empty()) {
+                reference = std::move(result);
+            } else if (result != reference) {
+                std::cerr << "Error: " << source << " (" << batch_eval::isa_name(instruction_set)
+                          << ") disagrees with the first configuration\n";
+                mismatch = true;
+            }
+        }
+    }
+
+    return mismatch ? 1 : 0;
+}
@@ -0,0 +1,752 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file batch_evaluator.cpp
+ * @brief Bit-sliced batch evaluation of expressions and decision diagrams implementation
+ *
+ * Implements program construction, the compilers from expression trees and
+ * TeDDy/CUDD diagrams, and the tiled multi-threaded interpreter with scalar,
+ * AVX2 and AVX-512 kernels.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "batch_evaluator.hpp"
+
+#include <algorithm>
+#include <cudd/cudd.h>
+#include <cudd/cuddObj.hh>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+
+#include "cardinality_bdd.hpp"
+#include "expression_graph.hpp"
+#include "field_compare_bdd.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BATCH_EVAL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BATCH_EVAL_TARGET(isa_string) __attribute__((target(isa_string)))
+#else
+#define BATCH_EVAL_TARGET(isa_string)
+#endif
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using batch_eval::instruction;
+using batch_eval::isa;
+using batch_eval::opcode;
+using word_t = std::uint64_t;
+
+/**
+ * @brief Bitwise kernels over `n` consecutive words
+ *
+ * Destination and operands may alias, as every word is computed from the
+ * words at the same position only.
+ */
+struct kernel_table {
+    void (*op_and)(word_t* d, const word_t* a, const word_t* b, std::size_t n);
+    void (*op_or)(word_t* d, const word_t* a, const word_t* b, std::size_t n);
+    void (*op_xor)(word_t* d, const word_t* a, const word_t* b, std::size_t n);
+    void (*op_not)(word_t* d, const word_t* a, std::size_t n);
+    void (*op_mux)(word_t* d, const word_t* s, const word_t* a, const word_t* b, std::size_t n);
+};
+
+// ----------------------------------------------------------------------------
+// Scalar kernels
+// ----------------------------------------------------------------------------
+
+void scalar_and(word_t* d, const word_t* a, const word_t* b, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        d[i] = a[i] & b[i];
+    }
+}
+
+void scalar_or(word_t* d, const word_t* a, const word_t* b, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        d[i] = a[i] | b[i];
+    }
+}
+
+void scalar_xor(word_t* d, const word_t* a, const word_t* b, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        d[i] = a[i] ^ b[i];
+    }
+}
+
+void scalar_not(word_t* d, const word_t* a, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        d[i] = ~a[i];
+    }
+}
+
+void scalar_mux(word_t* d, const word_t* s, const word_t* a, const word_t* b, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        d[i] = (s[i] & a[i]) | (~s[i] & b[i]);
+    }
+}
+
+constexpr kernel_table scalar_kernels{scalar_and, scalar_or, scalar_xor, scalar_not, scalar_mux};
+
+#ifdef BATCH_EVAL_X86
+
+// ----------------------------------------------------------------------------
+// AVX2 kernels (4 words per lane, scalar tail)
+// ----------------------------------------------------------------------------
+
+BATCH_EVAL_TARGET("avx2")
+__m256i avx2_load(const word_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+BATCH_EVAL_TARGET("avx2")
+void avx2_store(word_t* p, __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+BATCH_EVAL_TARGET("avx2")
+void avx2_and(word_t* d, const word_t* a, const word_t* b, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        avx2_store(d + i, _mm256_and_si256(avx2_load(a + i), avx2_load(b + i)));
+    }
+    scalar_and(d + i, a + i, b + i, n - i);
+}
+
+BATCH_EVAL_TARGET("avx2")
+void avx2_or(word_t* d, const word_t* a, const word_t* b, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        avx2_store(d + i, _mm256_or_si256(avx2_load(a + i), avx2_load(b + i)));
+    }
+    scalar_or(d + i, a + i, b + i, n - i);
+}
+
+BATCH_EVAL_TARGET("avx2")
+void avx2_xor(word_t* d, const word_t* a, const word_t* b, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        avx2_store(d + i, _mm256_xor_si256(avx2_load(a + i), avx2_load(b + i)));
+    }
+    scalar_xor(d + i, a + i, b + i, n - i);
+}
+
+BATCH_EVAL_TARGET("avx2")
+void avx2_not(word_t* d, const word_t* a, std::size_t n) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        avx2_store(d + i, _mm256_xor_si256(avx2_load(a + i), ones));
+    }
+    scalar_not(d + i, a + i, n - i);
+}
+
+BATCH_EVAL_TARGET("avx2")
+void avx2_mux(word_t* d, const word_t* s, const word_t* a, const word_t* b, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i sel = avx2_load(s + i);
+        avx2_store(d + i, _mm256_or_si256(_mm256_and_si256(sel, avx2_load(a + i)),
+                                          _mm256_andnot_si256(sel, avx2_load(b + i))));
+    }
+    scalar_mux(d + i, s + i, a + i, b + i, n - i);
+}
+
+constexpr kernel_table avx2_kernels{avx2_and, avx2_or, avx2_xor, avx2_not, avx2_mux};
+
+// ----------------------------------------------------------------------------
+// AVX-512 kernels (8 words per lane, scalar tail)
+// ----------------------------------------------------------------------------
+
+BATCH_EVAL_TARGET("avx512f")
+__m512i avx512_load(const word_t* p) {
+    return _mm512_loadu_si512(p);
+}
+
+BATCH_EVAL_TARGET("avx512f")
+void avx512_store(word_t* p, __m512i v) {
+    _mm512_storeu_si512(p, v);
+}
+
+BATCH_EVAL_TARGET("avx512f")
+void avx512_and(word_t* d, const word_t* a, const word_t* b, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        avx512_store(d + i, _mm512_and_si512(avx512_load(a + i), avx512_load(b + i)));
+    }
+    scalar_and(d + i, a + i, b + i, n - i);
+}
+
+BATCH_EVAL_TARGET("avx512f")
+void avx512_or(word_t* d, const word_t* a, const word_t* b, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        avx512_store(d + i, _mm512_or_si512(avx512_load(a + i), avx512_load(b + i)));
+    }
+    scalar_or(d + i, a + i, b + i, n - i);
+}
+
+BATCH_EVAL_TARGET("avx512f")
+void avx512_xor(word_t* d, const word_t* a, const word_t* b, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        avx512_store(d + i, _mm512_xor_si512(avx512_load(a + i), avx512_load(b + i)));
+    }
+    scalar_xor(d + i, a + i, b + i, n - i);
+}
+
+BATCH_EVAL_TARGET("avx512f")
+void avx512_not(word_t* d, const word_t* a, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i v = avx512_load(a + i);
+        // Truth table 0x55 is NOT of the third operand
+        avx512_store(d + i, _mm512_ternarylogic_epi64(v, v, v, 0x55));
+    }
+    scalar_not(d + i, a + i, n - i);
+}
+
+BATCH_EVAL_TARGET("avx512f")
+void avx512_mux(word_t* d, const word_t* s, const word_t* a, const word_t* b, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // Truth table 0xCA is (s & a) | (~s & b)
+        avx512_store(d + i, _mm512_ternarylogic_epi64(avx512_load(s + i), avx512_load(a + i),
+                                                      avx512_load(b + i), 0xCA));
+    }
+    scalar_mux(d + i, s + i, a + i, b + i, n - i);
+}
+
+constexpr kernel_table avx512_kernels{avx512_and, avx512_or, avx512_xor, avx512_not, avx512_mux};
+
+/**
+ * @brief CPUID-based feature check including OS support for the vector state
+ */
+bool cpu_has(isa value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave) {
+        return false;
+    }
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if (value == isa::avx2) {
+        return (xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0;
+    }
+    return (xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16)) != 0;
+#else
+    // libgcc also checks that the OS saves the extended register state
+    if (value == isa::avx2) {
+        return __builtin_cpu_supports("avx2");
+    }
+    return __builtin_cpu_supports("avx512f");
+#endif
+}
+
+#endif  // BATCH_EVAL_X86
+
+const kernel_table& kernels_for(isa value) {
+#ifdef BATCH_EVAL_X86
+    if (value == isa::avx512) {
+        return avx512_kernels;
+    }
+    if (value == isa::avx2) {
+        return avx2_kernels;
+    }
+#endif
+    return scalar_kernels;
+}
+
+/**
+ * @brief Scratch slot assignment for the instructions of a program
+ *
+ * Slots are reused once the value they hold has no further uses, so the
+ * working set stays proportional to the program's live values rather than
+ * its length.
+ */
+struct execution_plan {
+    std::vector<std::uint32_t> slot;  ///< Scratch slot of each instruction's value
+    std::uint32_t slot_count = 0;     ///< Number of scratch slots needed
+};
+
+execution_plan plan_execution(const batch_eval::program& prog) {
+    const auto& code = prog.code();
+    const std::uint32_t first = prog.first_result();
+    constexpr std::uint32_t never = std::numeric_limits<std::uint32_t>::max();
+
+    // Last instruction reading each instruction value
+    std::vector<std::uint32_t> last_use(code.size(), 0);
+    auto mark = [&](std::uint32_t value, std::uint32_t at) {
+        if (value >= first) {
+            last_use[value - first] = at;
+        }
+    };
+    for (std::uint32_t i = 0; i < code.size(); ++i) {
+        mark(code[i].a, i);
+        if (code[i].op != opcode::op_not) {
+            mark(code[i].b, i);
+        }
+        if (code[i].op == opcode::op_mux) {
+            mark(code[i].c, i);
+        }
+    }
+    if (prog.result() >= first) {
+        last_use[prog.result() - first] = never;
+    }
+
+    execution_plan plan;
+    plan.slot.resize(code.size());
+    std::vector<std::uint32_t> free_slots;
+    auto release = [&](std::uint32_t value, std::uint32_t at) {
+        if (value >= first && last_use[value - first] == at) {
+            free_slots.push_back(plan.slot[value - first]);
+            last_use[value - first] = never;  // Release once even if read twice
+        }
+    };
+    for (std::uint32_t i = 0; i < code.size(); ++i) {
+        // Operands die before the result is placed, so the result may overwrite one
+        release(code[i].a, i);
+        if (code[i].op != opcode::op_not) {
+            release(code[i].b, i);
+        }
+        if (code[i].op == opcode::op_mux) {
+            release(code[i].c, i);
+        }
+        if (free_slots.empty()) {
+            plan.slot[i] = plan.slot_count++;
+        } else {
+            plan.slot[i] = free_slots.back();
+            free_slots.pop_back();
+        }
+    }
+    return plan;
+}
+
+/**
+ * @brief Runs a program over words [begin, end) of the batch, tile by tile
+ */
+void run_range(const batch_eval::program& prog, const execution_plan& plan,
+               const std::vector<const word_t*>& columns, const kernel_table& kernels,
+               std::size_t tile_words, std::size_t begin, std::size_t end, word_t* out) {
+    const std::uint32_t first = prog.first_result();
+
+    // Scratch rows: constant zero, constant one, then the plan's slots
+    std::vector<word_t> scratch((plan.slot_count + 2) * tile_words, 0);
+    std::fill_n(scratch.begin() + static_cast<std::ptrdiff_t>(tile_words), tile_words,
+                ~word_t{0});
+    word_t* slots = scratch.data() + 2 * tile_words;
+
+    for (std::size_t offset = begin; offset < end; offset += tile_words) {
+        const std::size_t n = std::min(tile_words, end - offset);
+        auto value = [&](std::uint32_t id) -> const word_t* {
+            if (id < prog.zero()) {
+                return columns[id] + offset;
+            }
+            if (id < first) {
+                return scratch.data() + (id - prog.zero()) * tile_words;
+            }
+            return slots + plan.slot[id - first] * tile_words;
+        };
+
+        const auto& code = prog.code();
+        for (std::size_t i = 0; i < code.size(); ++i) {
+            const instruction& ins = code[i];
+            word_t* d = slots + plan.slot[i] * tile_words;
+            switch (ins.op) {
+                case opcode::op_and:
+                    kernels.op_and(d, value(ins.a), value(ins.b), n);
+                    break;
+                case opcode::op_or:
+                    kernels.op_or(d, value(ins.a), value(ins.b), n);
+                    break;
+                case opcode::op_xor:
+                    kernels.op_xor(d, value(ins.a), value(ins.b), n);
+                    break;
+                case opcode::op_not:
+                    kernels.op_not(d, value(ins.a), n);
+                    break;
+                case opcode::op_mux:
+                    kernels.op_mux(d, value(ins.a), value(ins.b), value(ins.c), n);
+                    break;
+            }
+        }
+        std::copy_n(value(prog.result()), n, out + offset);
+    }
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (batch_eval namespace)
+// ============================================================================
+
+namespace batch_eval {
+
+std::string isa_name(isa value) {
+    switch (value) {
+        case isa::automatic:
+            return "auto";
+        case isa::scalar:
+            return "scalar";
+        case isa::avx2:
+            return "avx2";
+        case isa::avx512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+isa parse_isa(const std::string& name) {
+    for (isa value : {isa::automatic, isa::scalar, isa::avx2, isa::avx512}) {
+        if (isa_name(value) == name) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Unknown instruction set: " + name
+                             + " (expected auto, scalar, avx2 or avx512)");
+}
+
+bool isa_supported(isa value) {
+    switch (value) {
+        case isa::automatic:
+        case isa::scalar:
+            return true;
+        case isa::avx2:
+        case isa::avx512:
+#ifdef BATCH_EVAL_X86
+            return cpu_has(value);
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+isa detect_isa() {
+    if (isa_supported(isa::avx512)) {
+        return isa::avx512;
+    }
+    if (isa_supported(isa::avx2)) {
+        return isa::avx2;
+    }
+    return isa::scalar;
+}
+
+program::program(std::vector<std::string> inputs) : inputs_(std::move(inputs)) {
+    for (std::uint32_t i = 0; i < inputs_.size(); ++i) {
+        input_index_.emplace(inputs_[i], i);
+    }
+    result_ = zero();
+}
+
+std::uint32_t program::input(const std::string& name) const {
+    auto it = input_index_.find(name);
+    if (it == input_index_.end()) {
+        throw std::runtime_error("Variable not found in batch program: " + name);
+    }
+    return it->second;
+}
+
+std::uint32_t program::emit(opcode op, std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+    code_.push_back({op, a, b, c});
+    return first_result() + static_cast<std::uint32_t>(code_.size() - 1);
+}
+
+std::uint32_t program::apply_and(std::uint32_t a, std::uint32_t b) {
+    if (a == zero() || b == zero()) {
+        return zero();
+    }
+    if (a == one() || a == b) {
+        return b;
+    }
+    if (b == one()) {
+        return a;
+    }
+    return emit(opcode::op_and, a, b);
+}
+
+std::uint32_t program::apply_or(std::uint32_t a, std::uint32_t b) {
+    if (a == one() || b == one()) {
+        return one();
+    }
+    if (a == zero() || a == b) {
+        return b;
+    }
+    if (b == zero()) {
+        return a;
+    }
+    return emit(opcode::op_or, a, b);
+}
+
+std::uint32_t program::apply_xor(std::uint32_t a, std::uint32_t b) {
+    if (a == b) {
+        return zero();
+    }
+    if (a == zero()) {
+        return b;
+    }
+    if (b == zero()) {
+        return a;
+    }
+    if (a == one()) {
+        return apply_not(b);
+    }
+    if (b == one()) {
+        return apply_not(a);
+    }
+    return emit(opcode::op_xor, a, b);
+}
+
+std::uint32_t program::apply_not(std::uint32_t a) {
+    if (a == zero()) {
+        return one();
+    }
+    if (a == one()) {
+        return zero();
+    }
+    return emit(opcode::op_not, a);
+}
+
+std::uint32_t program::ite(std::uint32_t f, std::uint32_t g, std::uint32_t h) {
+    if (f == one() || g == h) {
+        return g;
+    }
+    if (f == zero()) {
+        return h;
+    }
+    if (g == one() && h == zero()) {
+        return f;
+    }
+    if (g == zero() && h == one()) {
+        return apply_not(f);
+    }
+    if (g == zero()) {
+        return apply_and(apply_not(f), h);
+    }
+    if (h == zero()) {
+        return apply_and(f, g);
+    }
+    if (g == one()) {
+        return apply_or(f, h);
+    }
+    return emit(opcode::op_mux, f, g, h);
+}
+
+program compile_expression(const my_expression& expr) {
+    std::unordered_set<std::string> variable_names;
+    collect_variables_with_dag_walker(expr, variable_names);
+    program prog(ordered_variable_names(variable_names));
+
+    auto variable = [&](const std::string& name) { return prog.input(name); };
+    auto ite = [&](std::uint32_t f, std::uint32_t g, std::uint32_t h) {
+        return prog.ite(f, g, h);
+    };
+    const std::uint32_t zero = prog.zero();
+    const std::uint32_t one = prog.one();
+
+    // Shared subexpressions are compiled once
+    std::unordered_map<const my_expression*, std::uint32_t> compiled;
+    std::function<std::uint32_t(const my_expression&)> compile_recursive =
+        [&](const my_expression& e) -> std::uint32_t {
+        if (auto it = compiled.find(&e); it != compiled.end()) {
+            return it->second;
+        }
+        std::uint32_t value = std::visit(
+            [&](const auto& node) -> std::uint32_t {
+                using T = std::decay_t<decltype(node)>;
+
+                if constexpr (std::is_same_v<T, my_variable>) {
+                    return variable(node.variable_name);
+                } else if constexpr (std::is_same_v<T, my_and>) {
+                    return prog.apply_and(compile_recursive(*node.left),
+                                          compile_recursive(*node.right));
+                } else if constexpr (std::is_same_v<T, my_or>) {
+                    return prog.apply_or(compile_recursive(*node.left),
+                                         compile_recursive(*node.right));
+                } else if constexpr (std::is_same_v<T, my_xor>) {
+                    return prog.apply_xor(compile_recursive(*node.left),
+                                          compile_recursive(*node.right));
+                } else if constexpr (std::is_same_v<T, my_not>) {
+                    return prog.apply_not(compile_recursive(*node.expr));
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    // Operand order only affects diagram size, not the program's result
+                    std::vector<std::pair<int, std::uint32_t>> operands;
+                    operands.reserve(node.operands.size());
+                    for (const auto& operand : node.operands) {
+                        operands.emplace_back(0, compile_recursive(*operand));
+                    }
+                    return cardinality_bdd::build(node, std::move(operands), zero, one, ite);
+                } else if constexpr (std::is_same_v<T, my_compare>) {
+                    return field_compare_bdd::build(node, variable, zero, one, ite);
+                } else if constexpr (std::is_same_v<T, my_constant>) {
+                    return node.value ? one : zero;
+                }
+            },
+            e);
+        compiled.emplace(&e, value);
+        return value;
+    };
+
+    prog.set_result(compile_recursive(expr));
+    return prog;
+}
+
+program compile_teddy(teddy::bdd_manager::diagram_t diagram,
+                      const std::vector<std::string>& variable_names) {
+    using node_t = teddy::bdd_manager::diagram_t::node_t;
+    program prog(variable_names);
+
+    std::unordered_map<node_t*, std::uint32_t> compiled;
+    std::function<std::uint32_t(node_t*)> compile_recursive = [&](node_t* node) {
+        if (node->is_terminal()) {
+            return node->get_value() != 0 ? prog.one() : prog.zero();
+        }
+        if (auto it = compiled.find(node); it != compiled.end()) {
+            return it->second;
+        }
+        const auto index = static_cast<std::size_t>(node->get_index());
+        if (index >= variable_names.size()) {
+            throw std::runtime_error("TeDDy variable index has no name: "
+                                     + std::to_string(index));
+        }
+        std::uint32_t low = compile_recursive(node->get_son(0));
+        std::uint32_t high = compile_recursive(node->get_son(1));
+        std::uint32_t value = prog.ite(static_cast<std::uint32_t>(index), high, low);
+        compiled.emplace(node, value);
+        return value;
+    };
+
+    prog.set_result(compile_recursive(diagram.unsafe_get_root()));
+    return prog;
+}
+
+program compile_cudd(const BDD& bdd, const std::vector<std::string>& variable_names) {
+    program prog(variable_names);
+
+    // Keyed by edge, so a node reached both plainly and complemented is compiled
+    // once and negated once
+    std::unordered_map<DdNode*, std::uint32_t> compiled;
+    std::function<std::uint32_t(DdNode*)> compile_recursive = [&](DdNode* edge) {
+        if (auto it = compiled.find(edge); it != compiled.end()) {
+            return it->second;
+        }
+        DdNode* node = Cudd_Regular(edge);
+        std::uint32_t value;
+        if (Cudd_IsConstant(node)) {
+            value = Cudd_V(node) != 0 ? prog.one() : prog.zero();
+        } else {
+            const auto index = static_cast<std::size_t>(Cudd_NodeReadIndex(node));
+            if (index >= variable_names.size()) {
+                throw std::runtime_error("CUDD variable index has no name: "
+                                         + std::to_string(index));
+            }
+            value = prog.ite(static_cast<std::uint32_t>(index), compile_recursive(Cudd_T(node)),
+                             compile_recursive(Cudd_E(node)));
+        }
+        if (Cudd_IsComplement(edge)) {
+            value = prog.apply_not(value);
+        }
+        compiled.emplace(edge, value);
+        return value;
+    };
+
+    prog.set_result(compile_recursive(bdd.getNode()));
+    return prog;
+}
+
+std::vector<std::uint64_t> evaluate(const program& prog, const column_batch& batch,
+                                    const evaluate_options& options) {
+    const std::size_t words = words_for_rows(batch.rows);
+    if (options.tile_words == 0 || options.tile_words % 8 != 0) {
+        throw std::runtime_error("Tile size must be a positive multiple of 8 words");
+    }
+    isa selected =
+        options.instruction_set == isa::automatic ? detect_isa() : options.instruction_set;
+    if (!isa_supported(selected)) {
+        throw std::runtime_error("Instruction set not supported by this CPU: "
+                                 + isa_name(selected));
+    }
+
+    std::vector<const word_t*> columns;
+    columns.reserve(prog.inputs().size());
+    for (const auto& name : prog.inputs()) {
+        auto it = batch.columns.find(name);
+        if (it == batch.columns.end()) {
+            throw std::runtime_error("Missing input column: " + name);
+        }
+        if (it->second.size() != words) {
+            throw std::runtime_error("Input column '" + name + "' has "
+                                     + std::to_string(it->second.size()) + " words, expected "
+                                     + std::to_string(words));
+        }
+        columns.push_back(it->second.data());
+    }
+
+    std::vector<std::uint64_t> result(words, 0);
+    if (words == 0) {
+        return result;
+    }
+
+    const execution_plan plan = plan_execution(prog);
+    const kernel_table& kernels = kernels_for(selected);
+
+    // Whole tiles per thread, so threads never share a destination word
+    const std::size_t tiles = (words + options.tile_words - 1) / options.tile_words;
+    std::size_t threads = options.threads != 0 ? options.threads
+                                               : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, tiles);
+    const std::size_t tiles_per_thread = (tiles + threads - 1) / threads;
+
+    auto run_chunk = [&](std::size_t chunk) {
+        const std::size_t begin = chunk * tiles_per_thread * options.tile_words;
+        const std::size_t end = std::min(words, begin + tiles_per_thread * options.tile_words);
+        if (begin < end) {
+            run_range(prog, plan, columns, kernels, options.tile_words, begin, end,
+                      result.data());
+        }
+    };
+    if (threads == 1) {
+        run_chunk(0);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back(run_chunk, t);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    if (batch.rows % 64 != 0) {
+        result.back() &= (word_t{1} << (batch.rows % 64)) - 1;
+    }
+    return result;
+}
+
+}  // namespace batch_eval
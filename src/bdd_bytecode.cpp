@@ -0,0 +1,371 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file bdd_bytecode.cpp
+ * @brief Compact BDD bytecode implementation
+ *
+ * Implements the depth-first layout shared by the TeDDy and CUDD compilers,
+ * the bytecode verifier, the serialized format, and an interpreter that uses
+ * threaded dispatch (computed goto) on GCC and Clang and a switch loop
+ * elsewhere.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "bdd_bytecode.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cudd/cudd.h>
+#include <cudd/cuddObj.hh>
+#include <format>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using bdd_bytecode::opcode;
+using bdd_bytecode::program;
+
+constexpr std::array<std::uint8_t, 8> file_magic = {'B', 'D', 'D', 'B', 'C', '0', '0', '1'};
+constexpr std::size_t test_size = 7;
+constexpr std::size_t test_wide_size = 13;
+
+inline std::uint32_t read_u16(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8);
+}
+
+inline std::uint32_t read_u32(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8)
+           | (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+void put_uint(std::vector<std::uint8_t>& out, std::uint32_t value, std::size_t bytes) {
+    for (std::size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+}
+
+/**
+ * @brief Runs verified code for one assignment
+ *
+ * No bounds checks: the verifier guarantees that every jump lands on an
+ * instruction inside the code and every variable index is in range.
+ */
+inline bool run(const std::uint8_t* code, const std::uint8_t* assignment) {
+    const std::uint8_t* pc = code;
+#if defined(__GNUC__) || defined(__clang__)
+    // Threaded dispatch: every handler jumps directly to the next handler
+    static const void* const handlers[] = {&&op_ret_false, &&op_ret_true, &&op_test,
+                                           &&op_test_wide};
+    goto* handlers[*pc];
+op_test:
+    pc += test_size + read_u16(pc + (assignment[read_u16(pc + 1)] != 0 ? 5 : 3));
+    goto* handlers[*pc];
+op_test_wide:
+    pc += test_wide_size + read_u32(pc + (assignment[read_u32(pc + 1)] != 0 ? 9 : 5));
+    goto* handlers[*pc];
+op_ret_false:
+    return false;
+op_ret_true:
+    return true;
+#else
+    for (;;) {
+        switch (static_cast<opcode>(*pc)) {
+            case opcode::test:
+                pc += test_size + read_u16(pc + (assignment[read_u16(pc + 1)] != 0 ? 5 : 3));
+                break;
+            case opcode::test_wide:
+                pc += test_wide_size
+                      + read_u32(pc + (assignment[read_u32(pc + 1)] != 0 ? 9 : 5));
+                break;
+            case opcode::ret_true:
+                return true;
+            default:
+                return false;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief A diagram node as seen by the layout pass
+ */
+template <typename Key>
+struct expanded_node {
+    bool terminal = false;       ///< Whether this is a terminal
+    bool value = false;          ///< Terminal value
+    std::uint32_t var = 0;       ///< Variable index
+    std::array<Key, 2> child{};  ///< Low and high child
+};
+
+/**
+ * @brief Lays out a diagram in depth-first order and encodes it
+ *
+ * Decision nodes are placed in reverse post-order of a depth-first walk that
+ * visits the high child first, so parents precede children (every jump goes
+ * forward) and a node's low child usually follows it directly. The two return
+ * instructions close the code.
+ *
+ * @param root Root of the source diagram
+ * @param expand Callable returning the expanded_node for a key
+ * @param variable_names Name of each variable index
+ */
+template <typename Key, typename Expand>
+program lay_out(Key root, Expand&& expand, std::vector<std::string> variable_names) {
+    auto root_node = expand(root);
+    if (root_node.terminal) {
+        std::vector<std::uint8_t> code = {static_cast<std::uint8_t>(
+            root_node.value ? opcode::ret_true : opcode::ret_false)};
+        return program(std::move(code), std::move(variable_names));
+    }
+
+    // Iterative depth-first walk recording the post-order
+    std::vector<Key> order;
+    std::unordered_set<Key> seen = {root};
+    std::vector<std::pair<Key, int>> stack = {{root, 1}};
+    while (!stack.empty()) {
+        auto& [key, next_child] = stack.back();
+        if (next_child < 0) {
+            order.push_back(key);
+            stack.pop_back();
+            continue;
+        }
+        Key child = expand(key).child[next_child--];
+        if (!expand(child).terminal && seen.insert(child).second) {
+            stack.emplace_back(child, 1);
+        }
+    }
+    std::reverse(order.begin(), order.end());
+
+    // One operand width for the whole program keeps the addresses simple
+    const bool wide = order.size() * test_size + 2 > 0xFFFF || variable_names.size() > 0x10000;
+    const std::size_t size = wide ? test_wide_size : test_size;
+    const std::size_t width = wide ? 4 : 2;
+    const std::size_t ret_false_address = order.size() * size;
+
+    std::unordered_map<Key, std::size_t> address;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        address.emplace(order[i], i * size);
+    }
+
+    std::vector<std::uint8_t> code;
+    code.reserve(ret_false_address + 2);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        auto node = expand(order[i]);
+        const std::size_t end = (i + 1) * size;
+        code.push_back(static_cast<std::uint8_t>(wide ? opcode::test_wide : opcode::test));
+        put_uint(code, node.var, width);
+        for (const Key& child : node.child) {
+            auto child_node = expand(child);
+            std::size_t target = child_node.terminal
+                                     ? ret_false_address + (child_node.value ? 1 : 0)
+                                     : address.at(child);
+            put_uint(code, static_cast<std::uint32_t>(target - end), width);
+        }
+    }
+    code.push_back(static_cast<std::uint8_t>(opcode::ret_false));
+    code.push_back(static_cast<std::uint8_t>(opcode::ret_true));
+    return program(std::move(code), std::move(variable_names));
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (bdd_bytecode namespace)
+// ============================================================================
+
+namespace bdd_bytecode {
+
+void verify(std::span<const std::uint8_t> code, std::size_t variable_count) {
+    if (code.empty()) {
+        throw std::runtime_error("Invalid bytecode: empty program");
+    }
+
+    // Decode every instruction once, then check that jumps land on instruction starts
+    std::vector<bool> is_start(code.size(), false);
+    std::vector<std::pair<std::size_t, std::uint64_t>> jumps;
+    std::size_t pc = 0;
+    while (pc < code.size()) {
+        is_start[pc] = true;
+        const auto op = static_cast<opcode>(code[pc]);
+        if (op == opcode::ret_false || op == opcode::ret_true) {
+            ++pc;
+            continue;
+        }
+        if (op != opcode::test && op != opcode::test_wide) {
+            throw std::runtime_error(
+                std::format("Invalid bytecode: unknown opcode {} at offset {}", code[pc], pc));
+        }
+        const bool wide = op == opcode::test_wide;
+        const std::size_t size = wide ? test_wide_size : test_size;
+        if (code.size() - pc < size) {
+            throw std::runtime_error(
+                std::format("Invalid bytecode: truncated instruction at offset {}", pc));
+        }
+        auto operand = [&](std::size_t k) {
+            const std::uint8_t* p = code.data() + pc + 1 + k * (wide ? 4 : 2);
+            return wide ? read_u32(p) : read_u16(p);
+        };
+        if (operand(0) >= variable_count) {
+            throw std::runtime_error(std::format(
+                "Invalid bytecode: variable {} out of range at offset {}", operand(0), pc));
+        }
+        for (std::size_t k = 1; k <= 2; ++k) {
+            const std::uint64_t target = pc + size + std::uint64_t{operand(k)};
+            if (target >= code.size()) {
+                throw std::runtime_error(
+                    std::format("Invalid bytecode: jump out of range at offset {}", pc));
+            }
+            jumps.emplace_back(pc, target);
+        }
+        pc += size;
+    }
+    for (const auto& [from, target] : jumps) {
+        if (!is_start[static_cast<std::size_t>(target)]) {
+            throw std::runtime_error(std::format(
+                "Invalid bytecode: jump into the middle of an instruction at offset {}", from));
+        }
+    }
+}
+
+program::program(std::vector<std::uint8_t> code, std::vector<std::string> variable_names)
+    : code_(std::move(code)), variable_names_(std::move(variable_names)) {
+    verify(code_, variable_names_.size());
+}
+
+std::vector<std::uint8_t> program::serialize() const {
+    std::vector<std::uint8_t> out(file_magic.begin(), file_magic.end());
+    put_uint(out, static_cast<std::uint32_t>(variable_names_.size()), 4);
+    put_uint(out, static_cast<std::uint32_t>(code_.size()), 4);
+    for (const auto& name : variable_names_) {
+        put_uint(out, static_cast<std::uint32_t>(name.size()), 4);
+        out.insert(out.end(), name.begin(), name.end());
+    }
+    out.insert(out.end(), code_.begin(), code_.end());
+    return out;
+}
+
+program program::deserialize(std::span<const std::uint8_t> bytes) {
+    constexpr std::size_t header_size = 16;
+    if (bytes.size() < header_size
+        || !std::equal(file_magic.begin(), file_magic.end(), bytes.begin())) {
+        throw std::runtime_error("Not a BDD bytecode program");
+    }
+    const std::uint32_t variable_count = read_u32(bytes.data() + 8);
+    const std::uint32_t code_size = read_u32(bytes.data() + 12);
+
+    std::size_t offset = header_size;
+    std::vector<std::string> names;
+    for (std::uint32_t v = 0; v < variable_count; ++v) {
+        if (bytes.size() - offset < 4) {
+            throw std::runtime_error("Invalid bytecode program: truncated name table");
+        }
+        const std::uint32_t length = read_u32(bytes.data() + offset);
+        offset += 4;
+        if (bytes.size() - offset < length) {
+            throw std::runtime_error("Invalid bytecode program: truncated name table");
+        }
+        names.emplace_back(reinterpret_cast<const char*>(bytes.data() + offset), length);
+        offset += length;
+    }
+    if (bytes.size() - offset != code_size) {
+        throw std::runtime_error("Invalid bytecode program: code size does not match");
+    }
+    return program(std::vector<std::uint8_t>(bytes.begin() + static_cast<std::ptrdiff_t>(offset),
+                                             bytes.end()),
+                   std::move(names));
+}
+
+std::string program::disassemble() const {
+    std::string out;
+    std::size_t pc = 0;
+    while (pc < code_.size()) {
+        const auto op = static_cast<opcode>(code_[pc]);
+        if (op == opcode::ret_false || op == opcode::ret_true) {
+            out += std::format("{:6}: ret {}\n", pc, op == opcode::ret_true ? "true" : "false");
+            ++pc;
+            continue;
+        }
+        const bool wide = op == opcode::test_wide;
+        const std::size_t size = wide ? test_wide_size : test_size;
+        auto operand = [&](std::size_t k) {
+            const std::uint8_t* p = code_.data() + pc + 1 + k * (wide ? 4 : 2);
+            return wide ? read_u32(p) : read_u16(p);
+        };
+        out += std::format("{:6}: {} {} false -> {} true -> {}\n", pc,
+                           wide ? "test_wide" : "test", variable_names_[operand(0)],
+                           pc + size + operand(1), pc + size + operand(2));
+        pc += size;
+    }
+    return out;
+}
+
+bool program::evaluate(std::span<const std::uint8_t> assignment) const {
+    if (assignment.size() < variable_names_.size()) {
+        throw std::runtime_error("Assignment has " + std::to_string(assignment.size())
+                                 + " values, expected " + std::to_string(variable_names_.size()));
+    }
+    return run(code_.data(), assignment.data());
+}
+
+void program::evaluate_batch(std::span<const std::uint8_t> rows,
+                             std::span<std::uint8_t> results) const {
+    const std::size_t stride = variable_names_.size();
+    if (rows.size() != results.size() * stride) {
+        throw std::runtime_error("Batch has " + std::to_string(rows.size()) + " bytes, expected "
+                                 + std::to_string(results.size() * stride));
+    }
+    const std::uint8_t* code = code_.data();
+    for (std::size_t r = 0; r < results.size(); ++r) {
+        results[r] = run(code, rows.data() + r * stride) ? 1 : 0;
+    }
+}
+
+program compile_teddy(teddy::bdd_manager::diagram_t diagram,
+                      const std::vector<std::string>& variable_names) {
+    using node_t = teddy::bdd_manager::diagram_t::node_t;
+
+    auto expand = [](node_t* node) {
+        expanded_node<node_t*> result;
+        if (node->is_terminal()) {
+            result.terminal = true;
+            result.value = node->get_value() != 0;
+            return result;
+        }
+        result.var = static_cast<std::uint32_t>(node->get_index());
+        result.child = {node->get_son(0), node->get_son(1)};
+        return result;
+    };
+    return lay_out(diagram.unsafe_get_root(), expand, variable_names);
+}
+
+program compile_cudd(const BDD& bdd, const std::vector<std::string>& variable_names) {
+    // Keys are edges: the complement bit is pushed down to the children
+    auto expand = [](DdNode* edge) {
+        expanded_node<DdNode*> result;
+        DdNode* node = Cudd_Regular(edge);
+        const int complemented = Cudd_IsComplement(edge);
+        if (Cudd_IsConstant(node)) {
+            result.terminal = true;
+            result.value = (Cudd_V(node) != 0) != (complemented != 0);
+            return result;
+        }
+        result.var = static_cast<std::uint32_t>(Cudd_NodeReadIndex(node));
+        result.child = {Cudd_NotCond(Cudd_E(node), complemented),
+                        Cudd_NotCond(Cudd_T(node), complemented)};
+        return result;
+    };
+    return lay_out(bdd.getNode(), expand, variable_names);
+}
+
+}  // namespace bdd_bytecode
@@ -0,0 +1,440 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file bdd_image.cpp
+ * @brief Flat, immutable BDD images implementation
+ *
+ * Implements the level-ordered breadth-first layout shared by the TeDDy and
+ * CUDD lowerings, lookup with group prefetching, and the image file format
+ * with POSIX and Windows read-only mappings.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "bdd_image.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <cudd/cudd.h>
+#include <cudd/cuddObj.hh>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using bdd_image::image;
+using bdd_image::node_record;
+
+constexpr std::array<char, 8> file_magic = {'B', 'D', 'D', 'I', 'M', 'G', '0', '1'};
+constexpr std::uint32_t file_version = 1;
+
+/**
+ * @brief Fixed header at the start of an image file
+ */
+struct file_header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t node_count;
+    std::uint32_t variable_count;
+    std::uint32_t root;
+    std::uint64_t names_offset;
+};
+
+static_assert(sizeof(file_header) == 32, "image file header must stay 32 bytes");
+
+inline void prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+/**
+ * @brief A diagram node as seen by the layout pass
+ */
+template <typename Key>
+struct expanded_node {
+    bool terminal = false;       ///< Whether this is a terminal
+    bool value = false;          ///< Terminal value
+    std::uint32_t var = 0;       ///< Variable index
+    int level = 0;               ///< Level of the variable in the source manager
+    std::array<Key, 2> child{};  ///< Low and high child
+};
+
+/**
+ * @brief Lays out a diagram level by level in breadth-first order
+ *
+ * Nodes of each level receive consecutive indices in the order they were
+ * first reached from the level above, so every child index is larger than its
+ * parent's and a lookup walks forward through the array.
+ *
+ * @param root Root of the source diagram
+ * @param expand Callable returning the expanded_node for a key
+ * @param variable_names Name of each variable index
+ */
+template <typename Key, typename Expand>
+image lay_out(Key root, Expand&& expand, std::vector<std::string> variable_names) {
+    std::vector<node_record> records(2, node_record{0, {0, 0}});
+
+    auto root_node = expand(root);
+    if (root_node.terminal) {
+        return image(std::move(records), root_node.value ? image::true_index : image::false_index,
+                     std::move(variable_names));
+    }
+
+    // Nodes waiting for an index, by level; a child is always at a deeper level
+    std::map<int, std::vector<Key>> pending;
+    std::unordered_map<Key, std::uint32_t> index_of;
+    std::unordered_set<Key> seen;
+    std::vector<std::pair<Key, expanded_node<Key>>> placed;
+    pending[root_node.level].push_back(root);
+    seen.insert(root);
+
+    while (!pending.empty()) {
+        auto level_nodes = std::move(pending.begin()->second);
+        pending.erase(pending.begin());
+        for (const Key& key : level_nodes) {
+            auto node = expand(key);
+            index_of.emplace(key, static_cast<std::uint32_t>(records.size()));
+            records.push_back(node_record{node.var, {0, 0}});
+            for (const Key& child : node.child) {
+                auto child_node = expand(child);
+                if (!child_node.terminal && seen.insert(child).second) {
+                    pending[child_node.level].push_back(child);
+                }
+            }
+            placed.emplace_back(key, std::move(node));
+        }
+    }
+
+    // Resolve child indices now that every node is placed
+    for (auto& [key, node] : placed) {
+        node_record& record = records[index_of.at(key)];
+        for (int k = 0; k < 2; ++k) {
+            auto child_node = expand(node.child[k]);
+            record.child[k] =
+                child_node.terminal
+                    ? (child_node.value ? image::true_index : image::false_index)
+                    : index_of.at(node.child[k]);
+        }
+    }
+
+    // The root is the first node placed after the two terminals
+    return image(std::move(records), 2, std::move(variable_names));
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (bdd_image namespace)
+// ============================================================================
+
+namespace bdd_image {
+
+image::image(std::vector<node_record> records, std::uint32_t root,
+             std::vector<std::string> variable_names)
+    : owned_(std::move(records)), root_(root), variable_names_(std::move(variable_names)) {
+    nodes_ = owned_.data();
+    node_count_ = owned_.size();
+    validate();
+}
+
+image::image(image&& other) noexcept
+    : owned_(std::move(other.owned_)),
+      nodes_(other.nodes_),
+      node_count_(other.node_count_),
+      root_(other.root_),
+      variable_names_(std::move(other.variable_names_)),
+      mapping_(other.mapping_),
+      mapping_size_(other.mapping_size_) {
+    other.nodes_ = nullptr;
+    other.node_count_ = 0;
+    other.root_ = false_index;
+    other.mapping_ = nullptr;
+    other.mapping_size_ = 0;
+}
+
+image& image::operator=(image&& other) noexcept {
+    if (this != &other) {
+        release();
+        owned_ = std::move(other.owned_);
+        nodes_ = other.nodes_;
+        node_count_ = other.node_count_;
+        root_ = other.root_;
+        variable_names_ = std::move(other.variable_names_);
+        mapping_ = other.mapping_;
+        mapping_size_ = other.mapping_size_;
+        other.nodes_ = nullptr;
+        other.node_count_ = 0;
+        other.root_ = false_index;
+        other.mapping_ = nullptr;
+        other.mapping_size_ = 0;
+    }
+    return *this;
+}
+
+image::~image() {
+    release();
+}
+
+void image::release() {
+    if (mapping_ != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapping_);
+#else
+        munmap(mapping_, mapping_size_);
+#endif
+        mapping_ = nullptr;
+        mapping_size_ = 0;
+    }
+    nodes_ = nullptr;
+    node_count_ = 0;
+}
+
+void image::validate() const {
+    if (node_count_ < 2 || root_ >= node_count_) {
+        throw std::runtime_error("Invalid BDD image: bad root or node count");
+    }
+    // Children must be terminals or later records, which also rules out cycles
+    for (std::size_t i = 2; i < node_count_; ++i) {
+        const node_record& record = nodes_[i];
+        if (record.var >= variable_names_.size()) {
+            throw std::runtime_error("Invalid BDD image: variable index out of range in node "
+                                     + std::to_string(i));
+        }
+        for (std::uint32_t child : record.child) {
+            if (child > true_index && (child <= i || child >= node_count_)) {
+                throw std::runtime_error("Invalid BDD image: bad child index in node "
+                                         + std::to_string(i));
+            }
+        }
+    }
+}
+
+bool image::evaluate(std::span<const std::uint8_t> assignment) const {
+    if (assignment.size() < variable_names_.size()) {
+        throw std::runtime_error("Assignment has " + std::to_string(assignment.size())
+                                 + " values, expected " + std::to_string(variable_names_.size()));
+    }
+    std::uint32_t i = root_;
+    while (i > true_index) {
+        const node_record& record = nodes_[i];
+        i = record.child[assignment[record.var] != 0];
+    }
+    return i == true_index;
+}
+
+void image::evaluate_batch(std::span<const std::uint8_t> rows,
+                           std::span<std::uint8_t> results) const {
+    const std::size_t stride = variable_names_.size();
+    if (rows.size() != results.size() * stride) {
+        throw std::runtime_error("Batch has " + std::to_string(rows.size()) + " bytes, expected "
+                                 + std::to_string(results.size() * stride));
+    }
+
+    constexpr std::size_t group = 8;
+    for (std::size_t base = 0; base < results.size(); base += group) {
+        const std::size_t count = std::min(group, results.size() - base);
+        std::array<std::uint32_t, group> cursor;
+        cursor.fill(root_);
+
+        bool active = root_ > true_index;
+        while (active) {
+            active = false;
+            for (std::size_t j = 0; j < count; ++j) {
+                if (cursor[j] > true_index) {
+                    const node_record& record = nodes_[cursor[j]];
+                    cursor[j] = record.child[rows[(base + j) * stride + record.var] != 0];
+                    prefetch(nodes_ + cursor[j]);
+                    active = active || cursor[j] > true_index;
+                }
+            }
+        }
+        for (std::size_t j = 0; j < count; ++j) {
+            results[base + j] = cursor[j] == true_index ? 1 : 0;
+        }
+    }
+}
+
+void image::save(const std::string& path) const {
+    file_header header{};
+    header.magic = file_magic;
+    header.version = file_version;
+    header.node_count = static_cast<std::uint32_t>(node_count_);
+    header.variable_count = static_cast<std::uint32_t>(variable_names_.size());
+    header.root = root_;
+    header.names_offset = sizeof(file_header) + node_count_ * sizeof(node_record);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Could not create image file: " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(nodes_),
+              static_cast<std::streamsize>(node_count_ * sizeof(node_record)));
+    for (const auto& name : variable_names_) {
+        auto length = static_cast<std::uint32_t>(name.size());
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+    if (!out) {
+        throw std::runtime_error("Error writing image file: " + path);
+    }
+}
+
+image image::load(const std::string& path) {
+    image result;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open image file: " + path);
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)
+        || static_cast<std::size_t>(file_size.QuadPart) < sizeof(file_header)) {
+        CloseHandle(file);
+        throw std::runtime_error("Invalid BDD image: file too small: " + path);
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        throw std::runtime_error("Could not map image file: " + path);
+    }
+    void* base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (base == nullptr) {
+        throw std::runtime_error("Could not map image file: " + path);
+    }
+    const auto size = static_cast<std::size_t>(file_size.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open image file: " + path);
+    }
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0
+        || static_cast<std::size_t>(file_stat.st_size) < sizeof(file_header)) {
+        close(fd);
+        throw std::runtime_error("Invalid BDD image: file too small: " + path);
+    }
+    const auto size = static_cast<std::size_t>(file_stat.st_size);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Could not map image file: " + path);
+    }
+#endif
+    // From here on the destructor unmaps the file if validation fails
+    result.mapping_ = base;
+    result.mapping_size_ = size;
+
+    const auto* bytes = static_cast<const unsigned char*>(base);
+    file_header header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != file_magic || header.version != file_version) {
+        throw std::runtime_error("Not a BDD image file: " + path);
+    }
+    const std::uint64_t records_end =
+        sizeof(file_header) + std::uint64_t{header.node_count} * sizeof(node_record);
+    if (header.names_offset != records_end || records_end > size) {
+        throw std::runtime_error("Invalid BDD image: truncated node records: " + path);
+    }
+
+    std::size_t offset = static_cast<std::size_t>(header.names_offset);
+    result.variable_names_.reserve(header.variable_count);
+    for (std::uint32_t v = 0; v < header.variable_count; ++v) {
+        std::uint32_t length = 0;
+        if (size - offset < sizeof(length)) {
+            throw std::runtime_error("Invalid BDD image: truncated name table: " + path);
+        }
+        std::memcpy(&length, bytes + offset, sizeof(length));
+        offset += sizeof(length);
+        if (size - offset < length) {
+            throw std::runtime_error("Invalid BDD image: truncated name table: " + path);
+        }
+        result.variable_names_.emplace_back(reinterpret_cast<const char*>(bytes + offset), length);
+        offset += length;
+    }
+
+    result.nodes_ = reinterpret_cast<const node_record*>(bytes + sizeof(file_header));
+    result.node_count_ = header.node_count;
+    result.root_ = header.root;
+    result.validate();
+    return result;
+}
+
+image compile_teddy(const teddy::bdd_manager& manager, teddy::bdd_manager::diagram_t diagram,
+                    const std::vector<std::string>& variable_names) {
+    using node_t = teddy::bdd_manager::diagram_t::node_t;
+
+    auto expand = [&](node_t* node) {
+        expanded_node<node_t*> result;
+        if (node->is_terminal()) {
+            result.terminal = true;
+            result.value = node->get_value() != 0;
+            return result;
+        }
+        result.var = static_cast<std::uint32_t>(node->get_index());
+        result.level = static_cast<int>(manager.get_level(node->get_index()));
+        result.child = {node->get_son(0), node->get_son(1)};
+        return result;
+    };
+    return lay_out(diagram.unsafe_get_root(), expand, variable_names);
+}
+
+image compile_cudd(const Cudd& manager, const BDD& bdd,
+                   const std::vector<std::string>& variable_names) {
+    // Keys are edges: the complement bit is pushed down to the children
+    auto expand = [&](DdNode* edge) {
+        expanded_node<DdNode*> result;
+        DdNode* node = Cudd_Regular(edge);
+        const int complemented = Cudd_IsComplement(edge);
+        if (Cudd_IsConstant(node)) {
+            result.terminal = true;
+            result.value = (Cudd_V(node) != 0) != (complemented != 0);
+            return result;
+        }
+        const int index = static_cast<int>(Cudd_NodeReadIndex(node));
+        result.var = static_cast<std::uint32_t>(index);
+        result.level = manager.ReadPerm(index);
+        result.child = {Cudd_NotCond(Cudd_E(node), complemented),
+                        Cudd_NotCond(Cudd_T(node), complemented)};
+        return result;
+    };
+    return lay_out(bdd.getNode(), expand, variable_names);
+}
+
+}  // namespace bdd_image
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file bytecode_benchmark_main.cpp
+ * @brief Latency and throughput benchmark for the BDD bytecode interpreter
+ *
+ * Builds the BDD of an expression file, compiles it to bytecode, sends the
+ * program through serialize()/deserialize() as a deployment would, and then
+ * compares the interpreter with walking the TeDDy diagram with teddy_iterator:
+ * single-assignment latency (each lookup picks its row from the previous
+ * result, so lookups cannot overlap) and batch throughput over independent
+ * rows. All results are cross-checked, including bytecode compiled from the
+ * CUDD BDD of the same expression.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include <algorithm>
+#include <cudd/cuddObj.hh>
+#include <format>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "bdd_bytecode.hpp"
+#include "benchmark_timing.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "teddy_convert.hpp"
+#include "teddy_iterator.hpp"
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using benchmark_timing::best_time;
+
+void print_help() {
+    std::cout << "BDD Bytecode Benchmark - Interpreter latency and throughput\n";
+    std::cout << "===========================================================\n\n";
+    std::cout << "Usage: bdd_bytecode_bench <expression_file> [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --rows=<int>          Assignments to evaluate (default 1000000)\n";
+    std::cout << "  --repeat=<int>        Timed runs per method, best is reported (default 3)\n";
+    std::cout << "  --seed=<int>          Seed for the random assignments (default 1)\n";
+    std::cout << "  --disassemble         Print the bytecode listing\n";
+    std::cout << "  --help, -h            Show this help message\n";
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+/**
+ * @brief Bytecode benchmark entry point
+ *
+ * @param argc Number of command line arguments
+ * @param argv Array of command line argument strings
+ * @return 0 on success, 1 on error or if the evaluation methods disagree
+ */
+int main(int argc, const char* argv[]) {
+    std::string input_file;
+    std::size_t rows = 1'000'000;
+    int repeat = 3;
+    std::uint64_t seed = 1;
+    bool disassemble = false;
+    bool show_help = false;
+    bool help_due_to_error = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg.starts_with("--rows=")) {
+                rows = std::stoull(arg.substr(7));
+            } else if (arg.starts_with("--repeat=")) {
+                repeat = std::max(1, std::stoi(arg.substr(9)));
+            } else if (arg.starts_with("--seed=")) {
+                seed = std::stoull(arg.substr(7));
+            } else if (arg == "--disassemble") {
+                disassemble = true;
+            } else if (arg == "--help" || arg == "-h") {
+                show_help = true;
+                break;
+            } else if (arg.starts_with("-")) {
+                std::cerr << "Unknown option: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            } else if (input_file.empty()) {
+                input_file = arg;
+            } else {
+                std::cerr << "Multiple input files specified. Only one file is allowed.\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric option value\n";
+        return 1;
+    }
+
+    if (!show_help && input_file.empty()) {
+        std::cerr << "No expression file specified\n";
+        show_help = true;
+        help_due_to_error = true;
+    }
+
+    if (show_help) {
+        print_help();
+        return help_due_to_error ? 1 : 0;
+    }
+
+    if (rows == 0) {
+        std::cerr << "Error: --rows must be positive\n";
+        return 1;
+    }
+
+    try {
+        auto expr = read_expression_from_file(input_file);
+        std::unordered_set<std::string> variable_names;
+        collect_variables_with_dag_walker(*expr, variable_names);
+        std::vector<std::string> ordered = ordered_variable_names(variable_names);
+
+        teddy::bdd_manager manager(static_cast<int>(ordered.size()), 1'000);
+        auto f = convert_to_bdd(*expr, manager);
+        auto [cudd_mgr, cudd_bdd] = convert_to_cudd_bdd(*expr, variable_names);
+
+        // Ship the program through its deployment encoding
+        auto wire = bdd_bytecode::compile_teddy(f, ordered).serialize();
+        auto prog = bdd_bytecode::program::deserialize(wire);
+        auto from_cudd = bdd_bytecode::compile_cudd(cudd_bdd, ordered);
+
+        std::cout << std::format("\nTeDDy nodes: {}, bytecode: {} bytes ({} serialized), "
+                                 "CUDD bytecode: {} bytes\n",
+                                 manager.get_node_count(f), prog.code().size(), wire.size(),
+                                 from_cudd.code().size());
+        if (disassemble) {
+            std::cout << "\n" << prog.disassemble();
+        }
+
+        // Random row-major assignments, one byte per variable
+        const std::size_t stride = ordered.size();
+        std::vector<std::uint8_t> assignments(rows * stride);
+        std::mt19937_64 rng(seed);
+        for (auto& value : assignments) {
+            value = static_cast<std::uint8_t>(rng() & 1);
+        }
+        auto row = [&](std::size_t r) {
+            return std::span<const std::uint8_t>(assignments.data() + r * stride, stride);
+        };
+        auto iterator_lookup = [&](std::size_t r) {
+            teddy_iterator it(f.unsafe_get_root(), &ordered);
+            while (!it.is_terminal()) {
+                auto children = it.get_children();
+                it = children[row(r)[it.get_node()->get_index()] != 0];
+            }
+            return it.get_terminal_value() != 0;
+        };
+
+        // Dependent chains: the next row depends on the previous result
+        std::size_t iterator_chain = 0;
+        std::size_t bytecode_chain = 0;
+        auto next_row = [&](std::size_t r, bool result) {
+            return (r + 1 + (result ? 1 : 0)) % rows;
+        };
+        double iterator_latency = best_time(repeat, [&] {
+            std::size_t r = 0;
+            for (std::size_t k = 0; k < rows; ++k) {
+                r = next_row(r, iterator_lookup(r));
+            }
+            iterator_chain = r;
+        });
+        double bytecode_latency = best_time(repeat, [&] {
+            std::size_t r = 0;
+            for (std::size_t k = 0; k < rows; ++k) {
+                r = next_row(r, prog.evaluate(row(r)));
+            }
+            bytecode_chain = r;
+        });
+
+        std::vector<std::uint8_t> iterator_results(rows);
+        std::vector<std::uint8_t> batch_results(rows);
+        std::vector<std::uint8_t> cudd_results(rows);
+        double iterator_batch = best_time(repeat, [&] {
+            for (std::size_t r = 0; r < rows; ++r) {
+                iterator_results[r] = iterator_lookup(r) ? 1 : 0;
+            }
+        });
+        double bytecode_batch =
+            best_time(repeat, [&] { prog.evaluate_batch(assignments, batch_results); });
+        from_cudd.evaluate_batch(assignments, cudd_results);
+
+        const auto count = static_cast<double>(rows);
+        std::cout << std::format("Rows: {}, variables: {}, repeat: {}\n\n", rows, stride,
+                                 repeat);
+        std::cout << std::format("{:<16} {:>18} {:>20}\n", "Method", "Latency ns/lookup",
+                                 "Batch lookups/s");
+        std::cout << std::format("{:<16} {:>18.1f} {:>20.3e}\n", "teddy_iterator",
+                                 iterator_latency * 1e9 / count,
+                                 iterator_batch > 0.0 ? count / iterator_batch : 0.0);
+        std::cout << std::format("{:<16} {:>18.1f} {:>20.3e}\n", "bytecode",
+                                 bytecode_latency * 1e9 / count,
+                                 bytecode_batch > 0.0 ? count / bytecode_batch : 0.0);
+
+        if (batch_results != iterator_results || cudd_results != iterator_results
+            || bytecode_chain != iterator_chain) {
+            std::cerr << "Error: evaluation methods disagree\n";
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
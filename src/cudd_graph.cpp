@@ -19,6 +19,7 @@
 #include <iostream>
 #include <ranges>
 
+#include "c_code_generator.hpp"
 #include "cudd_iterator.hpp"
 #include "dag_walker.hpp"
 #include "dot_graph_generator.hpp"
@@ -96,3 +97,51 @@ void write_cudd_nodes_to_markdown(const Cudd& cudd_manager, const BDD& bdd,
     // Use the generic Markdown table generator
     node_table::generate_markdown_table(root_iter, out);
 }
+
+void write_cudd_to_c(const Cudd& cudd_manager, const BDD& bdd,
+                     const std::vector<std::string>& variable_names, std::ostream& out,
+                     const c_code::CCodeConfig& config) {
+    // Create iterator for the root node
+    cudd_iterator root_iter(cudd_manager, bdd.getNode(), &variable_names);
+
+    // Use the generic C code generator
+    c_code::generate_c_code(root_iter, variable_names, out, config);
+}
+
+void write_cudd_outputs_to_dot(const Cudd& cudd_manager,
+                               const std::vector<std::pair<std::string, BDD>>& outputs,
+                               const std::vector<std::string>& variable_names, std::ostream& out,
+                               const std::string& graph_name) {
+    std::vector<std::pair<std::string, cudd_iterator>> roots;
+    roots.reserve(outputs.size());
+    for (const auto& [name, bdd] : outputs) {
+        roots.emplace_back(name, cudd_iterator(cudd_manager, bdd.getNode(), &variable_names));
+    }
+
+    // Same BDD-specific format as write_cudd_to_dot()
+    dot_graph::DotConfig config;
+    config.graph_name = graph_name;
+    config.rankdir = "";
+    config.font_name = "";
+    config.default_node_shape = "";
+    config.default_node_style = "";
+    config.default_edge_style = "";
+    config.use_bdd_format = true;
+
+    dot_graph::generate_dot_graph(roots, out, config);
+}
+
+void write_cudd_outputs_nodes_to_stream(const Cudd& cudd_manager,
+                                        const std::vector<std::pair<std::string, BDD>>& outputs,
+                                        const std::vector<std::string>& variable_names,
+                                        std::ostream& out, bool include_headers) {
+    std::vector<std::pair<std::string, cudd_iterator>> roots;
+    roots.reserve(outputs.size());
+    for (const auto& [name, bdd] : outputs) {
+        roots.emplace_back(name, cudd_iterator(cudd_manager, bdd.getNode(), &variable_names));
+    }
+
+    node_table::TextTableConfig config(include_headers,
+                                       "Shared CUDD BDD Node Table (topological ordering)");
+    node_table::generate_text_table(roots, out, config);
+}
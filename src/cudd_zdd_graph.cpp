@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file cudd_zdd_graph.cpp
+ * @brief CUDD ZDD graph generation using generic template systems implementation
+ *
+ * Implementation of the ZDD DOT, Mermaid and node table output functions on
+ * top of cudd_zdd_iterator and the generic generators.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "cudd_zdd_graph.hpp"
+
+#include <iostream>
+
+#include "cudd_zdd_iterator.hpp"
+#include "dot_graph_generator.hpp"
+#include "mermaid_graph_generator.hpp"
+#include "node_table_generator.hpp"
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+void write_cudd_zdd_to_dot(const Cudd& cudd_manager, const ZDD& zdd,
+                           const std::vector<std::string>& variable_names, std::ostream& out,
+                           const std::string& graph_name) {
+    cudd_zdd_iterator root_iter(cudd_manager, zdd.getNode(), &variable_names);
+
+    // Same grouped shape format as BDDs; edges carry branch and suppression labels
+    dot_graph::DotConfig config;
+    config.graph_name = graph_name;
+    config.rankdir = "";
+    config.font_name = "";
+    config.default_node_shape = "";
+    config.default_node_style = "";
+    config.default_edge_style = "";
+    config.use_bdd_format = true;
+
+    dot_graph::generate_dot_graph(root_iter, out, config);
+}
+
+void write_cudd_zdd_to_mermaid(const Cudd& cudd_manager, const ZDD& zdd,
+                               const std::vector<std::string>& variable_names, std::ostream& out,
+                               const std::string& graph_title) {
+    cudd_zdd_iterator root_iter(cudd_manager, zdd.getNode(), &variable_names);
+
+    // Same layout as write_cudd_to_mermaid()
+    mermaid_graph::MermaidConfig config;
+    config.graph_title = graph_title;
+    config.direction = "TD";
+    config.default_node_shape = "";
+    config.show_frontmatter = true;
+    config.show_css_classes = true;
+    config.node_id_prefix = "N";
+    config.node_id_start = 0;
+
+    config.class_definitions.push_back(
+        {"zddVariable", "fill:lightyellow,stroke:#333,stroke-width:2px,color:#000"});
+    config.class_definitions.push_back(
+        {"terminal", "fill:lightgray,stroke:#333,stroke-width:2px,color:#000"});
+
+    mermaid_graph::generate_mermaid_graph(root_iter, out, config);
+}
+
+void write_cudd_zdd_nodes_to_stream(const Cudd& cudd_manager, const ZDD& zdd,
+                                    const std::vector<std::string>& variable_names,
+                                    std::ostream& out, bool include_headers) {
+    cudd_zdd_iterator root_iter(cudd_manager, zdd.getNode(), &variable_names);
+
+    node_table::TextTableConfig config(include_headers,
+                                       "CUDD ZDD Node Table (topological ordering)");
+
+    node_table::generate_multiway_text_table(root_iter, out, config);
+}
@@ -16,6 +16,8 @@
 
 #include "expression_graph.hpp"
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <type_traits>
 #include <unordered_map>
@@ -74,6 +76,17 @@ void collect_variables_with_dag_walker(const my_expression& expr,
                         using T = std::decay_t<decltype(variant_expr)>;
                         if constexpr (std::is_same_v<T, my_variable>) {
                             variables.insert(variant_expr.variable_name);
+                        } else if constexpr (std::is_same_v<T, my_compare>) {
+                            // Field comparisons reference every bit of each field
+                            for (size_t i = 0; i < variant_expr.field.width; ++i) {
+                                variables.insert(field_bit_name(variant_expr.field.name, i));
+                            }
+                            if (variant_expr.rhs_field) {
+                                for (size_t i = 0; i < variant_expr.rhs_field->width; ++i) {
+                                    variables.insert(
+                                        field_bit_name(variant_expr.rhs_field->name, i));
+                                }
+                            }
                         }
                         // Operators are ignored - only variables are collected
                     },
@@ -82,6 +95,177 @@ void collect_variables_with_dag_walker(const my_expression& expr,
         });
 }
 
+namespace {
+
+/**
+ * @brief Splits a field bit variable name ("port[15]") into field and bit index
+ *
+ * @return false if @p name is not a field bit variable
+ */
+bool parse_field_bit_name(const std::string& name, std::string& field, size_t& bit) {
+    if (name.size() < 4 || name.back() != ']') {
+        return false;
+    }
+    size_t open = name.rfind('[');
+    if (open == std::string::npos || open == 0 || open + 2 > name.size() - 1) {
+        return false;
+    }
+    size_t value = 0;
+    for (size_t i = open + 1; i + 1 < name.size(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(name[i]))) {
+            return false;
+        }
+        value = value * 10 + static_cast<size_t>(name[i] - '0');
+    }
+    field = name.substr(0, open);
+    bit = value;
+    return true;
+}
+
+}  // namespace
+
+std::vector<std::string> ordered_variable_names(const std::unordered_set<std::string>& variables) {
+    struct key {
+        bool is_field_bit;
+        size_t bit;
+        std::string field;
+        std::string name;
+    };
+    std::vector<key> keys;
+    keys.reserve(variables.size());
+    for (const auto& name : variables) {
+        key k{false, 0, {}, name};
+        k.is_field_bit = parse_field_bit_name(name, k.field, k.bit);
+        keys.push_back(std::move(k));
+    }
+
+    std::ranges::sort(keys, [](const key& a, const key& b) {
+        if (a.is_field_bit != b.is_field_bit) {
+            return !a.is_field_bit;  // Plain variables first
+        }
+        if (!a.is_field_bit) {
+            return a.name < b.name;
+        }
+        if (a.bit != b.bit) {
+            return a.bit > b.bit;  // Most significant bit first
+        }
+        return a.field < b.field;  // Interleave fields at equal significance
+    });
+
+    std::vector<std::string> ordered;
+    ordered.reserve(keys.size());
+    for (auto& k : keys) {
+        ordered.push_back(std::move(k.name));
+    }
+    return ordered;
+}
+
+// ============================================================================
+// Expression Size
+// ============================================================================
+
+std::size_t expression_size(const my_expression& expr) {
+    std::size_t size = 0;
+    std::vector<const my_expression*> pending = {&expr};
+    while (!pending.empty()) {
+        const my_expression* e = pending.back();
+        pending.pop_back();
+        ++size;
+        std::visit(
+            [&](const auto& content) {
+                using T = std::decay_t<decltype(content)>;
+                if constexpr (std::is_same_v<T, my_and> || std::is_same_v<T, my_or>
+                              || std::is_same_v<T, my_xor>) {
+                    pending.push_back(content.right.get());
+                    pending.push_back(content.left.get());
+                } else if constexpr (std::is_same_v<T, my_not>) {
+                    pending.push_back(content.expr.get());
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    for (const auto& operand : content.operands) {
+                        pending.push_back(operand.get());
+                    }
+                }
+            },
+            *e);
+    }
+    return size;
+}
+
+// ============================================================================
+// Expression Text
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Appends the text of @p expr to @p out, stopping once it exceeds @p limit
+ */
+void append_expression(const my_expression& expr, std::string& out, size_t limit) {
+    if (out.size() > limit) {
+        return;
+    }
+    auto binary = [&](const my_expression& left, const char* op, const my_expression& right) {
+        out += "(";
+        append_expression(left, out, limit);
+        out += op;
+        append_expression(right, out, limit);
+        out += ")";
+    };
+    std::visit(
+        [&](const auto& content) {
+            using T = std::decay_t<decltype(content)>;
+            if constexpr (std::is_same_v<T, my_variable>) {
+                out += content.variable_name;
+            } else if constexpr (std::is_same_v<T, my_and>) {
+                binary(*content.left, " AND ", *content.right);
+            } else if constexpr (std::is_same_v<T, my_or>) {
+                binary(*content.left, " OR ", *content.right);
+            } else if constexpr (std::is_same_v<T, my_xor>) {
+                binary(*content.left, " XOR ", *content.right);
+            } else if constexpr (std::is_same_v<T, my_not>) {
+                out += "NOT ";
+                append_expression(*content.expr, out, limit);
+            } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                const char* separator = "(";
+                if (content.kind == cardinality_kind::exactly && content.k == 1) {
+                    out += "EXACTLY_ONE";
+                } else {
+                    out += content.kind == cardinality_kind::exactly
+                               ? expression_constants::exactly_label()
+                           : content.kind == cardinality_kind::at_most
+                               ? expression_constants::at_most_label()
+                               : expression_constants::at_least_label();
+                    out += "(" + std::to_string(content.k);
+                    separator = ", ";
+                }
+                for (const auto& operand : content.operands) {
+                    out += separator;
+                    append_expression(*operand, out, limit);
+                    separator = ", ";
+                }
+                out += ")";
+            } else if constexpr (std::is_same_v<T, my_compare>) {
+                out += detail::compare_label(content);
+            } else if constexpr (std::is_same_v<T, my_constant>) {
+                out += content.value ? expression_constants::true_label()
+                                     : expression_constants::false_label();
+            }
+        },
+        expr);
+}
+
+}  // namespace
+
+std::string expression_to_string(const my_expression& expr, size_t max_length) {
+    std::string text;
+    append_expression(expr, text, max_length == 0 ? std::string::npos : max_length);
+    if (max_length != 0 && text.size() > max_length) {
+        text.resize(max_length > 3 ? max_length - 3 : 0);
+        text += "...";
+    }
+    return text;
+}
+
 // ============================================================================
 // Mermaid Graph Generation
 // ============================================================================
@@ -3,15 +3,26 @@
 
 #include "expression_parser.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cctype>
+#include <charconv>
 #include <format>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include "expression_types.hpp"
+#include "field_compare_bdd.hpp"
 
 // ============================================================================
 // Anonymous namespace for implementation details
@@ -51,7 +62,39 @@ class Tokenizer {
     }
 
    public:
-    enum class TokenType { VARIABLE, AND, OR, XOR, NOT, LPAREN, RPAREN, EOF_TOKEN };
+    enum class TokenType {
+        VARIABLE,
+        AND,
+        OR,
+        XOR,
+        NOT,
+        EXACTLY_ONE,
+        EXACTLY_K,
+        AT_MOST_K,
+        AT_LEAST_K,
+        IN,
+        DOMAIN,
+        LET,
+        TRUE_CONSTANT,
+        FALSE_CONSTANT,
+        LPAREN,
+        RPAREN,
+        LBRACKET,
+        RBRACKET,
+        LBRACE,
+        RBRACE,
+        COMMA,
+        DOTDOT,
+        EQ,
+        NE,
+        LT,
+        LE,
+        GT,
+        GE,
+        ASSIGN,
+        SEMICOLON,
+        EOF_TOKEN
+    };
 
     struct Token {
         TokenType type;
@@ -80,10 +123,56 @@ class Tokenizer {
                 return "XOR";
             case TokenType::NOT:
                 return "NOT";
+            case TokenType::EXACTLY_ONE:
+                return "EXACTLY_ONE";
+            case TokenType::EXACTLY_K:
+                return "EXACTLY_K";
+            case TokenType::AT_MOST_K:
+                return "AT_MOST_K";
+            case TokenType::AT_LEAST_K:
+                return "AT_LEAST_K";
+            case TokenType::IN:
+                return "IN";
+            case TokenType::DOMAIN:
+                return "DOMAIN";
+            case TokenType::LET:
+                return "let";
+            case TokenType::TRUE_CONSTANT:
+                return "TRUE";
+            case TokenType::FALSE_CONSTANT:
+                return "FALSE";
             case TokenType::LPAREN:
                 return "'('";
             case TokenType::RPAREN:
                 return "')'";
+            case TokenType::LBRACKET:
+                return "'['";
+            case TokenType::RBRACKET:
+                return "']'";
+            case TokenType::LBRACE:
+                return "'{'";
+            case TokenType::RBRACE:
+                return "'}'";
+            case TokenType::COMMA:
+                return "','";
+            case TokenType::DOTDOT:
+                return "'..'";
+            case TokenType::EQ:
+                return "'=='";
+            case TokenType::NE:
+                return "'!='";
+            case TokenType::LT:
+                return "'<'";
+            case TokenType::LE:
+                return "'<='";
+            case TokenType::GT:
+                return "'>'";
+            case TokenType::GE:
+                return "'>='";
+            case TokenType::ASSIGN:
+                return "'='";
+            case TokenType::SEMICOLON:
+                return "';'";
             case TokenType::EOF_TOKEN:
                 return "end of input";
             default:
@@ -101,7 +190,8 @@ class Tokenizer {
     /**
      * @brief Gets the next token from the input stream
      *
-     * Performs lexical analysis to identify operators, parentheses, and variables.
+     * Performs lexical analysis to identify operators, brackets, commas, comparison
+     * operators and variables.
      * Handles proper boundary detection for operator keywords within variable names.
      *
      * @return The next token with type, value, and position information
@@ -117,21 +207,22 @@ class Tokenizer {
         size_t start_pos = pos;
 
         // Check for operators and parentheses
+        auto is_separator = [](char ch) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            return std::isspace(c)
+                   || std::string_view("(),[]{}=!<>;").find(ch) != std::string_view::npos;
+        };
         auto is_boundary_char = [&](size_t idx) {
             if (idx >= text.length()) {
                 return true;
             }
-            char ch = text[idx];
-            unsigned char c = static_cast<unsigned char>(ch);
-            return std::isspace(c) || ch == '(' || ch == ')';
+            return is_separator(text[idx]) || text.compare(idx, 2, "..") == 0;
         };
         auto has_boundary_before = [&](size_t idx) {
             if (idx == 0) {
                 return true;
             }
-            char ch = text[idx - 1];
-            unsigned char c = static_cast<unsigned char>(ch);
-            return std::isspace(c) || ch == '(' || ch == ')';
+            return is_separator(text[idx - 1]);
         };
 
         if (pos + 3 <= text.length() && text.compare(pos, 3, "AND") == 0 && has_boundary_before(pos)
@@ -154,6 +245,27 @@ class Tokenizer {
             pos += 3;
             return {.type = TokenType::NOT, .value = "NOT", .position = start_pos};
         }
+        // Cardinality keywords (n-ary, followed by a parenthesized operand list), IN, DOMAIN,
+        // let and the constants
+        static constexpr std::pair<const char*, TokenType> cardinality_keywords[] = {
+            {"EXACTLY_ONE", TokenType::EXACTLY_ONE},
+            {"EXACTLY_K", TokenType::EXACTLY_K},
+            {"AT_MOST_K", TokenType::AT_MOST_K},
+            {"AT_LEAST_K", TokenType::AT_LEAST_K},
+            {"IN", TokenType::IN},
+            {"DOMAIN", TokenType::DOMAIN},
+            {"let", TokenType::LET},
+            {"TRUE", TokenType::TRUE_CONSTANT},
+            {"FALSE", TokenType::FALSE_CONSTANT},
+        };
+        for (const auto& [keyword, type] : cardinality_keywords) {
+            size_t len = std::char_traits<char>::length(keyword);
+            if (pos + len <= text.length() && text.compare(pos, len, keyword) == 0
+                && has_boundary_before(pos) && is_boundary_char(pos + len)) {
+                pos += len;
+                return {.type = type, .value = keyword, .position = start_pos};
+            }
+        }
         if (text[pos] == '(') {
             pos++;
             return {.type = TokenType::LPAREN, .value = "(", .position = start_pos};
@@ -162,13 +274,38 @@ class Tokenizer {
             pos++;
             return {.type = TokenType::RPAREN, .value = ")", .position = start_pos};
         }
+        if (text[pos] == ',') {
+            pos++;
+            return {.type = TokenType::COMMA, .value = ",", .position = start_pos};
+        }
+        // Field syntax: widths, value sets, ranges and comparison operators; statements
+        static constexpr std::pair<const char*, TokenType> symbols[] = {
+            {"==", TokenType::EQ},
+            {"!=", TokenType::NE},
+            {"<=", TokenType::LE},
+            {">=", TokenType::GE},
+            {"..", TokenType::DOTDOT},
+            {"<", TokenType::LT},
+            {">", TokenType::GT},
+            {"=", TokenType::ASSIGN},
+            {";", TokenType::SEMICOLON},
+            {"[", TokenType::LBRACKET},
+            {"]", TokenType::RBRACKET},
+            {"{", TokenType::LBRACE},
+            {"}", TokenType::RBRACE},
+        };
+        for (const auto& [symbol, type] : symbols) {
+            size_t len = std::char_traits<char>::length(symbol);
+            if (text.compare(pos, len, symbol) == 0) {
+                pos += len;
+                return {.type = type, .value = symbol, .position = start_pos};
+            }
+        }
 
-        // Parse variable name (any non-whitespace that's not an operator or parentheses)
-        if (!std::isspace(static_cast<unsigned char>(text[pos])) && text[pos] != '('
-            && text[pos] != ')') {
+        // Parse variable name (any non-whitespace that's not an operator or separator)
+        if (!is_boundary_char(pos)) {
             std::string var_name;
-            while (pos < text.length() && !std::isspace(static_cast<unsigned char>(text[pos]))
-                   && text[pos] != '(' && text[pos] != ')') {
+            while (!is_boundary_char(pos)) {
                 var_name += text[pos];
                 pos++;
             }
@@ -199,17 +336,44 @@ class Tokenizer {
  * @brief Recursive descent parser for logical expressions
  *
  * Grammar (in order of precedence, lowest to highest):
+ * input -> declaration* ( expression | statement+ )
+ * declaration -> DOMAIN VARIABLE ( { VARIABLE (, VARIABLE)* } | NUMBER )
+ * statement -> let? VARIABLE = expression ;
  * expression -> xor_expr
  * xor_expr -> or_expr (XOR or_expr)*
  * or_expr -> and_expr (OR and_expr)*
  * and_expr -> not_expr (AND not_expr)*
  * not_expr -> NOT not_expr | primary
- * primary -> VARIABLE | ( expression )
+ * primary -> VARIABLE | TRUE | FALSE | comparison | ( expression ) | cardinality
+ * cardinality -> EXACTLY_ONE ( expression (, expression)* )
+ *              | (EXACTLY_K | AT_MOST_K | AT_LEAST_K) ( NUMBER , expression (, expression)* )
+ * comparison -> field (== | != | < | <= | > | >=) (NUMBER | field)
+ *             | field IN { item (, item)* }
+ * field -> VARIABLE [ NUMBER ]?
+ * item -> NUMBER (.. NUMBER)?
+ *
+ * A field's width is declared with its first use (e.g. port[16]) and applies
+ * to the rest of the expression. Enumerated fields are declared up front with
+ * DOMAIN and compared without a width, against value names or indices.
+ *
+ * A `let` statement defines a name that later statements use like a
+ * variable; the other statements name the outputs of the file. The `;` of
+ * the last statement may be omitted.
  */
 class Parser {
    private:
+    static constexpr uint64_t max_domain_size = 65536;  ///< Largest enumerated domain
+
+
     Tokenizer tokenizer;
     Tokenizer::Token current_token;
+    std::unordered_map<std::string, size_t> field_widths;  ///< Declared field widths
+    std::unordered_map<std::string, my_field> enumerated_fields;  ///< DOMAIN declarations
+    std::unordered_set<std::string> definition_names;              ///< Names bound by let
+    std::unordered_set<std::string> used_variables;  ///< Variables referenced so far
+    std::set<std::string> statement_domains;  ///< Enumerated fields used by the current statement
+    std::unordered_map<std::string, std::set<std::string>>
+        definition_domains;  ///< Enumerated fields used by each definition
 
     /**
      * @brief Advances to the next token in the input stream
@@ -246,19 +410,455 @@ class Parser {
     my_expression_ptr parse_primary() {
         if (current_token.type == Tokenizer::TokenType::VARIABLE) {
             std::string var_name = current_token.value;
+            size_t position = current_token.position;
             advance();
+            if (current_token.type == Tokenizer::TokenType::LBRACKET
+                || comparison_op(current_token.type)
+                || current_token.type == Tokenizer::TokenType::IN) {
+                if (definition_names.contains(var_name)) {
+                    throw std::runtime_error(std::format(
+                        "Definition '{}' at position {} cannot be used as a field", var_name,
+                        position));
+                }
+                return parse_comparison(var_name, position);
+            }
+            if (!definition_names.contains(var_name)) {
+                used_variables.insert(var_name);
+            } else {
+                const auto& fields = definition_domains[var_name];
+                statement_domains.insert(fields.begin(), fields.end());
+            }
             return std::make_unique<my_expression>(my_variable{var_name});
+        } else if (current_token.type == Tokenizer::TokenType::TRUE_CONSTANT
+                   || current_token.type == Tokenizer::TokenType::FALSE_CONSTANT) {
+            bool value = current_token.type == Tokenizer::TokenType::TRUE_CONSTANT;
+            advance();
+            return std::make_unique<my_expression>(my_constant{value});
         } else if (current_token.type == Tokenizer::TokenType::LPAREN) {
             advance();  // consume '('
             auto expr = parse_expression();
             expect(Tokenizer::TokenType::RPAREN);
             return expr;
+        } else if (current_token.type == Tokenizer::TokenType::EXACTLY_ONE
+                   || current_token.type == Tokenizer::TokenType::EXACTLY_K
+                   || current_token.type == Tokenizer::TokenType::AT_MOST_K
+                   || current_token.type == Tokenizer::TokenType::AT_LEAST_K) {
+            return parse_cardinality();
         } else {
             throw std::runtime_error(
                 std::format("Expected variable or '(' at position {}", current_token.position));
         }
     }
 
+    /**
+     * @brief Parses an n-ary cardinality constraint
+     *
+     * EXACTLY_ONE takes only operands; the _K forms take a non-negative
+     * integer bound followed by at least one operand.
+     *
+     * @return Pointer to the parsed my_cardinality expression
+     * @throws std::runtime_error If the bound or operand list is malformed
+     */
+    my_expression_ptr parse_cardinality() {
+        my_cardinality node;
+        Tokenizer::TokenType type = current_token.type;
+        switch (type) {
+            case Tokenizer::TokenType::EXACTLY_ONE:
+            case Tokenizer::TokenType::EXACTLY_K:
+                node.kind = cardinality_kind::exactly;
+                break;
+            case Tokenizer::TokenType::AT_MOST_K:
+                node.kind = cardinality_kind::at_most;
+                break;
+            default:
+                node.kind = cardinality_kind::at_least;
+                break;
+        }
+        advance();  // consume keyword
+        expect(Tokenizer::TokenType::LPAREN);
+
+        if (type != Tokenizer::TokenType::EXACTLY_ONE) {
+            const std::string& bound = current_token.value;
+            bool is_number =
+                current_token.type == Tokenizer::TokenType::VARIABLE && !bound.empty()
+                && bound.size() <= 9 && std::ranges::all_of(bound, [](char c) {
+                       return std::isdigit(static_cast<unsigned char>(c)) != 0;
+                   });
+            if (!is_number) {
+                throw std::runtime_error(std::format(
+                    "Expected non-negative integer bound at position {}", current_token.position));
+            }
+            node.k = std::stoul(bound);
+            advance();
+            expect(Tokenizer::TokenType::COMMA);
+        }
+
+        node.operands.push_back(parse_expression());
+        while (current_token.type == Tokenizer::TokenType::COMMA) {
+            advance();  // consume ','
+            node.operands.push_back(parse_expression());
+        }
+        expect(Tokenizer::TokenType::RPAREN);
+
+        return std::make_unique<my_expression>(std::move(node));
+    }
+
+    /**
+     * @brief Maps a comparison operator token to its operator
+     *
+     * @return The operator, or std::nullopt if @p type is not a comparison operator
+     */
+    static std::optional<compare_op> comparison_op(Tokenizer::TokenType type) {
+        switch (type) {
+            case Tokenizer::TokenType::EQ:
+                return compare_op::eq;
+            case Tokenizer::TokenType::NE:
+                return compare_op::ne;
+            case Tokenizer::TokenType::LT:
+                return compare_op::lt;
+            case Tokenizer::TokenType::LE:
+                return compare_op::le;
+            case Tokenizer::TokenType::GT:
+                return compare_op::gt;
+            case Tokenizer::TokenType::GE:
+                return compare_op::ge;
+            default:
+                return std::nullopt;
+        }
+    }
+
+    /**
+     * @brief Parses the current token as an unsigned integer constant
+     *
+     * Accepts decimal, hexadecimal (0x prefix) and binary (0b prefix) literals.
+     *
+     * @return The value of the constant
+     * @throws std::runtime_error If the current token is not a valid constant
+     */
+    uint64_t parse_number() {
+        const std::string& text = current_token.value;
+        if (current_token.type != Tokenizer::TokenType::VARIABLE || text.empty()
+            || !std::isdigit(static_cast<unsigned char>(text[0]))) {
+            throw std::runtime_error(
+                std::format("Expected integer constant at position {}", current_token.position));
+        }
+
+        int base = 10;
+        size_t offset = 0;
+        if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+            base = 16;
+            offset = 2;
+        } else if (text.size() > 2 && text[0] == '0' && (text[1] == 'b' || text[1] == 'B')) {
+            base = 2;
+            offset = 2;
+        }
+
+        uint64_t value = 0;
+        const char* first = text.data() + offset;
+        const char* last = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(first, last, value, base);
+        if (ec != std::errc() || ptr != last) {
+            throw std::runtime_error(std::format("Invalid integer constant '{}' at position {}",
+                                                 text, current_token.position));
+        }
+        advance();
+        return value;
+    }
+
+    /**
+     * @brief Parses a field reference with an optional width declaration
+     *
+     * The first use of a field must declare its width (name[N], 1 <= N <= 64);
+     * later uses may omit it or must repeat the same width.
+     *
+     * @param name Field name (already consumed)
+     * @param position Position of the field name for error messages
+     * @return The field with its width
+     * @throws std::runtime_error If the width is missing, invalid or inconsistent
+     */
+    my_field parse_field(const std::string& name, size_t position) {
+        if (enumerated_fields.contains(name)) {
+            throw std::runtime_error(std::format(
+                "Enumerated field '{}' at position {} cannot be used as a bit-vector", name,
+                position));
+        }
+        auto it = field_widths.find(name);
+        if (current_token.type != Tokenizer::TokenType::LBRACKET) {
+            if (it == field_widths.end()) {
+                throw std::runtime_error(
+                    std::format("Field '{}' at position {} has no declared width; declare it as "
+                                "{}[N]",
+                                name, position, name));
+            }
+            return {name, it->second};
+        }
+
+        advance();  // consume '['
+        size_t width_position = current_token.position;
+        uint64_t width = parse_number();
+        if (width < 1 || width > 64) {
+            throw std::runtime_error(std::format(
+                "Field width must be between 1 and 64 at position {}", width_position));
+        }
+        expect(Tokenizer::TokenType::RBRACKET);
+
+        if (it != field_widths.end() && it->second != width) {
+            throw std::runtime_error(
+                std::format("Field '{}' redeclared with width {} at position {} (was {})", name,
+                            width, position, it->second));
+        }
+        field_widths[name] = static_cast<size_t>(width);
+        return {name, static_cast<size_t>(width)};
+    }
+
+    /**
+     * @brief Parses a constant and checks that it fits in the field
+     */
+    uint64_t parse_field_value(const my_field& field) {
+        size_t position = current_token.position;
+        uint64_t value = parse_number();
+        if (value > field_compare_bdd::max_value(field.width)) {
+            throw std::runtime_error(std::format("Value {} at position {} does not fit in {}[{}]",
+                                                 value, position, field.name, field.width));
+        }
+        return value;
+    }
+
+    /**
+     * @brief Parses a field comparison or set membership test
+     *
+     * @param name Field name (already consumed)
+     * @param position Position of the field name for error messages
+     * @return Pointer to the parsed my_compare expression
+     * @throws std::runtime_error If the comparison is malformed
+     */
+    my_expression_ptr parse_comparison(const std::string& name, size_t position) {
+        if (auto it = enumerated_fields.find(name); it != enumerated_fields.end()) {
+            return parse_enumerated_comparison(it->second);
+        }
+
+        my_compare node;
+        node.field = parse_field(name, position);
+
+        if (current_token.type == Tokenizer::TokenType::IN) {
+            node.op = compare_op::in;
+            advance();  // consume 'IN'
+            expect(Tokenizer::TokenType::LBRACE);
+            do {
+                if (!node.ranges.empty()) {
+                    advance();  // consume ','
+                }
+                size_t item_position = current_token.position;
+                uint64_t lo = parse_field_value(node.field);
+                uint64_t hi = lo;
+                if (current_token.type == Tokenizer::TokenType::DOTDOT) {
+                    advance();  // consume '..'
+                    hi = parse_field_value(node.field);
+                    if (hi < lo) {
+                        throw std::runtime_error(
+                            std::format("Empty range at position {}", item_position));
+                    }
+                }
+                node.ranges.emplace_back(lo, hi);
+            } while (current_token.type == Tokenizer::TokenType::COMMA);
+            expect(Tokenizer::TokenType::RBRACE);
+            return std::make_unique<my_expression>(std::move(node));
+        }
+
+        auto op = comparison_op(current_token.type);
+        if (!op) {
+            throw std::runtime_error(std::format(
+                "Expected comparison operator or IN after field '{}' at position {}", name,
+                current_token.position));
+        }
+        node.op = *op;
+        advance();  // consume operator
+
+        if (current_token.type == Tokenizer::TokenType::VARIABLE && !current_token.value.empty()
+            && !std::isdigit(static_cast<unsigned char>(current_token.value[0]))) {
+            std::string rhs_name = current_token.value;
+            size_t rhs_position = current_token.position;
+            advance();
+            node.rhs_field = parse_field(rhs_name, rhs_position);
+            if (node.rhs_field->width != node.field.width) {
+                throw std::runtime_error(
+                    std::format("Cannot compare {}[{}] with {}[{}] at position {}", name,
+                                node.field.width, rhs_name, node.rhs_field->width, position));
+            }
+        } else {
+            node.value = parse_field_value(node.field);
+        }
+        return std::make_unique<my_expression>(std::move(node));
+    }
+
+    /**
+     * @brief Parses a DOMAIN declaration of an enumerated field
+     *
+     * `DOMAIN color {red, green, blue}` declares symbolic values;
+     * `DOMAIN level 5` declares the values 0 to 4.
+     *
+     * @throws std::runtime_error If the declaration is malformed or the name is already used
+     */
+    void parse_domain() {
+        advance();  // consume 'DOMAIN'
+        size_t position = current_token.position;
+        if (current_token.type != Tokenizer::TokenType::VARIABLE
+            || std::isdigit(static_cast<unsigned char>(current_token.value[0]))) {
+            throw std::runtime_error(
+                std::format("Expected domain name after DOMAIN at position {}", position));
+        }
+        my_field field;
+        field.name = current_token.value;
+        if (enumerated_fields.contains(field.name) || field_widths.contains(field.name)) {
+            throw std::runtime_error(
+                std::format("Field '{}' redeclared at position {}", field.name, position));
+        }
+        advance();
+
+        if (current_token.type == Tokenizer::TokenType::LBRACE) {
+            do {
+                advance();  // consume '{' or ','
+                const std::string& value = current_token.value;
+                if (current_token.type != Tokenizer::TokenType::VARIABLE
+                    || std::isdigit(static_cast<unsigned char>(value[0]))) {
+                    throw std::runtime_error(std::format("Expected value name at position {}",
+                                                         current_token.position));
+                }
+                if (std::ranges::find(field.value_names, value) != field.value_names.end()) {
+                    throw std::runtime_error(std::format("Duplicate value '{}' at position {}",
+                                                         value, current_token.position));
+                }
+                field.value_names.push_back(value);
+                advance();
+            } while (current_token.type == Tokenizer::TokenType::COMMA);
+            expect(Tokenizer::TokenType::RBRACE);
+            field.domain = field.value_names.size();
+        } else {
+            field.domain = parse_number();
+        }
+
+        if (field.domain < 2 || field.domain > max_domain_size) {
+            throw std::runtime_error(
+                std::format("Domain '{}' at position {} must have between 2 and {} values",
+                            field.name, position, max_domain_size));
+        }
+        field.width = static_cast<size_t>(std::bit_width(field.domain - 1));
+        enumerated_fields.emplace(field.name, std::move(field));
+    }
+
+    /**
+     * @brief Parses a value of an enumerated field (name or index)
+     */
+    uint64_t parse_enumerated_value(const my_field& field) {
+        size_t position = current_token.position;
+        const std::string& text = current_token.value;
+        if (current_token.type == Tokenizer::TokenType::VARIABLE && !text.empty()
+            && !std::isdigit(static_cast<unsigned char>(text[0]))) {
+            auto it = std::ranges::find(field.value_names, text);
+            if (it == field.value_names.end()) {
+                throw std::runtime_error(std::format("Unknown value '{}' of domain '{}' at "
+                                                     "position {}",
+                                                     text, field.name, position));
+            }
+            advance();
+            return static_cast<uint64_t>(it - field.value_names.begin());
+        }
+        uint64_t value = parse_number();
+        if (value >= field.domain) {
+            throw std::runtime_error(std::format("Value {} at position {} is outside domain '{}'",
+                                                 value, position, field.name));
+        }
+        return value;
+    }
+
+    /**
+     * @brief Parses a comparison on an enumerated field
+     *
+     * Every operator is normalized to IN over the values of the domain. The
+     * codes outside the domain are excluded once per output by
+     * constrain_domains(), not here, so that NOT of a comparison stays within
+     * the domain as well.
+     *
+     * @param field The enumerated field (name already consumed)
+     * @return Pointer to the parsed my_compare expression
+     */
+    my_expression_ptr parse_enumerated_comparison(const my_field& field) {
+        my_compare node;
+        node.field = field;
+        node.op = compare_op::in;
+        const uint64_t last = field.domain - 1;
+        statement_domains.insert(field.name);
+
+        if (current_token.type == Tokenizer::TokenType::IN) {
+            advance();  // consume 'IN'
+            expect(Tokenizer::TokenType::LBRACE);
+            bool first = true;
+            do {
+                if (!first) {
+                    advance();  // consume ','
+                }
+                first = false;
+                size_t item_position = current_token.position;
+                uint64_t lo = parse_enumerated_value(field);
+                uint64_t hi = lo;
+                if (current_token.type == Tokenizer::TokenType::DOTDOT) {
+                    advance();  // consume '..'
+                    hi = parse_enumerated_value(field);
+                    if (hi < lo) {
+                        throw std::runtime_error(
+                            std::format("Empty range at position {}", item_position));
+                    }
+                }
+                node.ranges.emplace_back(lo, hi);
+            } while (current_token.type == Tokenizer::TokenType::COMMA);
+            expect(Tokenizer::TokenType::RBRACE);
+            return std::make_unique<my_expression>(std::move(node));
+        }
+
+        auto op = comparison_op(current_token.type);
+        if (!op) {
+            throw std::runtime_error(
+                std::format("Expected comparison operator or IN after field '{}' at position {}",
+                            field.name, current_token.position));
+        }
+        advance();  // consume operator
+        uint64_t v = parse_enumerated_value(field);
+
+        auto add = [&](uint64_t lo, uint64_t hi) {
+            if (lo <= hi) {
+                node.ranges.emplace_back(lo, hi);
+            }
+        };
+        switch (*op) {
+            case compare_op::eq:
+                add(v, v);
+                break;
+            case compare_op::ne:
+                if (v > 0) {
+                    add(0, v - 1);
+                }
+                add(v + 1, last);
+                break;
+            case compare_op::lt:
+                if (v > 0) {
+                    add(0, v - 1);
+                }
+                break;
+            case compare_op::le:
+                add(0, v);
+                break;
+            case compare_op::gt:
+                add(v + 1, last);
+                break;
+            case compare_op::ge:
+                add(v, last);
+                break;
+            case compare_op::in:
+                break;
+        }
+        return std::make_unique<my_expression>(std::move(node));
+    }
+
     /**
      * @brief Parses NOT expressions (unary, right-associative)
      *
@@ -338,6 +938,88 @@ class Parser {
         return left;
     }
 
+    /**
+     * @brief Conjoins an output with `field IN {0..domain-1}` for every enumerated field it uses
+     *
+     * The bit-blasted code of a field whose domain is not a power of two has
+     * values outside the domain. Excluding them at the root of each output,
+     * including the fields reached through definitions, keeps every atom and
+     * its negation within the domain.
+     */
+    my_expression_ptr constrain_domains(my_expression_ptr expr) {
+        for (const std::string& name : statement_domains) {
+            const my_field& field = enumerated_fields.at(name);
+            if (std::has_single_bit(field.domain)) {
+                continue;
+            }
+            my_compare in_domain;
+            in_domain.field = field;
+            in_domain.op = compare_op::in;
+            in_domain.ranges.emplace_back(0, field.domain - 1);
+            expr = std::make_unique<my_expression>(
+                my_and{std::move(expr), std::make_unique<my_expression>(std::move(in_domain))});
+        }
+        statement_domains.clear();
+        return expr;
+    }
+
+    /**
+     * @brief Whether the current token starts a `let` or output statement
+     */
+    bool at_statement() {
+        return current_token.type == Tokenizer::TokenType::LET
+               || (current_token.type == Tokenizer::TokenType::VARIABLE
+                   && tokenizer.peek_token().type == Tokenizer::TokenType::ASSIGN);
+    }
+
+    /**
+     * @brief Parses a `let` definition or a named output into @p program
+     *
+     * @throws std::runtime_error If the name is already taken, or a definition
+     *         is named after a variable or field used before it
+     */
+    void parse_statement(my_program& program) {
+        const bool definition = current_token.type == Tokenizer::TokenType::LET;
+        if (definition) {
+            advance();  // consume 'let'
+        }
+        const size_t position = current_token.position;
+        if (current_token.type != Tokenizer::TokenType::VARIABLE
+            || std::isdigit(static_cast<unsigned char>(current_token.value[0]))) {
+            throw std::runtime_error(std::format("Expected name at position {}", position));
+        }
+        std::string name = current_token.value;
+        advance();
+        expect(Tokenizer::TokenType::ASSIGN);
+        auto expr = parse_expression();
+        if (current_token.type == Tokenizer::TokenType::SEMICOLON) {
+            advance();
+        } else if (current_token.type != Tokenizer::TokenType::EOF_TOKEN) {
+            throw std::runtime_error(std::format("Expected ';' after '{}' at position {}", name,
+                                                 current_token.position));
+        }
+
+        auto named = [&](const my_named_expression& other) { return other.name == name; };
+        if (definition_names.contains(name) || std::ranges::any_of(program.outputs, named)) {
+            throw std::runtime_error(
+                std::format("Name '{}' at position {} is already defined", name, position));
+        }
+        if (!definition) {
+            program.outputs.push_back({std::move(name), constrain_domains(std::move(expr))});
+            return;
+        }
+        // Variables and fields used so far would change meaning below this point
+        if (used_variables.contains(name) || field_widths.contains(name)
+            || enumerated_fields.contains(name)) {
+            throw std::runtime_error(std::format(
+                "Definition '{}' at position {} names a variable or field used before it", name,
+                position));
+        }
+        definition_names.insert(name);
+        definition_domains[name] = std::exchange(statement_domains, {});
+        program.definitions.push_back({std::move(name), std::move(expr)});
+    }
+
    public:
     /**
      * @brief Constructs a parser with input text
@@ -358,23 +1040,41 @@ class Parser {
     }
 
     /**
-     * @brief Parses a complete expression and ensures no trailing tokens
+     * @brief Parses a complete input and ensures no trailing tokens
      *
-     * @return Pointer to the parsed expression tree
-     * @throws std::runtime_error If unexpected tokens remain after parsing
+     * @return The definitions and outputs; a bare expression is one unnamed output
+     * @throws std::runtime_error If unexpected tokens remain after parsing or
+     *         statements define no output
      */
-    my_expression_ptr parse() {
-        auto expr = parse_expression();
-        if (current_token.type != Tokenizer::TokenType::EOF_TOKEN) {
-            throw std::runtime_error(std::format("Unexpected token after expression at position {}",
-                                                 current_token.position));
+    my_program parse() {
+        while (current_token.type == Tokenizer::TokenType::DOMAIN) {
+            parse_domain();
         }
-        return expr;
+        my_program program;
+        if (!at_statement()) {
+            program.outputs.push_back({"", constrain_domains(parse_expression())});
+            if (current_token.type != Tokenizer::TokenType::EOF_TOKEN) {
+                throw std::runtime_error(std::format(
+                    "Unexpected token after expression at position {}", current_token.position));
+            }
+            return program;
+        }
+        while (current_token.type != Tokenizer::TokenType::EOF_TOKEN) {
+            if (!at_statement()) {
+                throw std::runtime_error(std::format("Expected 'let' or 'name =' at position {}",
+                                                     current_token.position));
+            }
+            parse_statement(program);
+        }
+        if (program.outputs.empty()) {
+            throw std::runtime_error("No outputs defined; name one with 'name = expression;'");
+        }
+        return program;
     }
 };
 
 /**
- * @brief Parses a logical expression string into an expression tree
+ * @brief Parses the text of an expression file into its definitions and outputs
  *
  * Clean recursive descent parser that handles operator precedence correctly.
  * Supports proper operator precedence (highest to lowest):
@@ -383,10 +1083,10 @@ class Parser {
  * 3. OR (binary, left-associative)
  * 4. XOR (binary, left-associative)
  *
- * @param expr_str String representation of the logical expression
- * @return Smart pointer to the root of the parsed expression tree
+ * @param expr_str Text of the file without comments
+ * @return The parsed definitions and outputs
  */
-my_expression_ptr parse_expression(const std::string& expr_str) {
+my_program parse_program(const std::string& expr_str) {
     std::string trimmed = trim(expr_str);
 
     if (trimmed.empty()) {
@@ -401,6 +1101,38 @@ my_expression_ptr parse_expression(const std::string& expr_str) {
     }
 }
 
+/**
+ * @brief Copies an expression with every definition reference replaced by its body
+ */
+my_expression_ptr expand(const my_expression& expr,
+                         const std::unordered_map<std::string, const my_expression*>& bodies) {
+    return std::visit(
+        [&](const auto& node) -> my_expression_ptr {
+            using T = std::decay_t<decltype(node)>;
+            if constexpr (std::is_same_v<T, my_variable>) {
+                if (auto it = bodies.find(node.variable_name); it != bodies.end()) {
+                    return expand(*it->second, bodies);
+                }
+                return std::make_unique<my_expression>(node);
+            } else if constexpr (std::is_same_v<T, my_not>) {
+                return std::make_unique<my_expression>(my_not{expand(*node.expr, bodies)});
+            } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                my_cardinality copy{node.kind, node.k, {}};
+                copy.operands.reserve(node.operands.size());
+                for (const auto& operand : node.operands) {
+                    copy.operands.push_back(expand(*operand, bodies));
+                }
+                return std::make_unique<my_expression>(std::move(copy));
+            } else if constexpr (std::is_same_v<T, my_compare> || std::is_same_v<T, my_constant>) {
+                return std::make_unique<my_expression>(node);
+            } else {
+                return std::make_unique<my_expression>(
+                    T{expand(*node.left, bodies), expand(*node.right, bodies)});
+            }
+        },
+        expr);
+}
+
 }  // end anonymous namespace
 
 // ============================================================================
@@ -433,6 +1165,17 @@ my_expression_ptr parse_expression(const std::string& expr_str) {
  * ```
  */
 my_expression_ptr read_expression_from_file(const std::string& filename) {
+    return inline_definitions(read_program_from_file(filename));
+}
+
+/**
+ * @brief Reads the definitions and outputs of an expression file
+ *
+ * Reads the file like read_expression_from_file() but keeps `let`
+ * definitions and every output separate, so that shared definitions can
+ * be built once.
+ */
+my_program read_program_from_file(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
         throw std::runtime_error("Could not open file: " + filename);
@@ -456,5 +1199,30 @@ my_expression_ptr read_expression_from_file(const std::string& filename) {
 
     std::cout << "Read expression from file: " << expression_str << "\n\n";
 
-    return parse_expression(expression_str);
+    return parse_program(expression_str);
+}
+
+/**
+ * @brief Expands the definitions of a single-output program into its output
+ *
+ * Every reference receives its own copy of the definition, so the result is
+ * a plain tree that every converter accepts. The tree grows with the number
+ * of paths to each definition: a chain of definitions that each use the
+ * previous one twice doubles with every level. multi_output::build_teddy()
+ * and friends build each definition once instead.
+ */
+my_expression_ptr inline_definitions(my_program program) {
+    if (program.outputs.size() != 1) {
+        throw std::runtime_error(std::format(
+            "Expression file defines {} outputs where a single expression is expected",
+            program.outputs.size()));
+    }
+    if (program.definitions.empty()) {
+        return std::move(program.outputs.front().expr);
+    }
+    std::unordered_map<std::string, const my_expression*> bodies;
+    for (const auto& definition : program.definitions) {
+        bodies.emplace(definition.name, definition.expr.get());
+    }
+    return expand(*program.outputs.front().expr, bodies);
 }
@@ -0,0 +1,543 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file expression_simplify.cpp
+ * @brief Algebraic simplification of expression trees implementation
+ *
+ * The pass copies the tree bottom-up in negation normal form: a negation is
+ * carried down as a flag instead of being built. Each AND, OR and XOR chain
+ * is gathered into one operand list, its operands are simplified, and the
+ * rules of its operator are applied to the list before it is rebuilt.
+ * Operands are found again through a hash of every node built, with a full
+ * structural comparison on equal hashes.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "expression_simplify.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "expression_graph.hpp"
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+std::uint64_t mix(std::uint64_t seed, std::uint64_t value) {
+    return seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2));
+}
+
+/**
+ * @brief Whether two expressions have the same structure
+ */
+bool equal(const my_expression& a, const my_expression& b) {
+    if (a.index() != b.index()) {
+        return false;
+    }
+    return std::visit(
+        [&](const auto& x) -> bool {
+            using T = std::decay_t<decltype(x)>;
+            const T& y = std::get<T>(b);
+            if constexpr (std::is_same_v<T, my_variable> || std::is_same_v<T, my_constant>) {
+                return x == y;
+            } else if constexpr (std::is_same_v<T, my_not>) {
+                return equal(*x.expr, *y.expr);
+            } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                if (x.kind != y.kind || x.k != y.k || x.operands.size() != y.operands.size()) {
+                    return false;
+                }
+                for (std::size_t i = 0; i < x.operands.size(); ++i) {
+                    if (!equal(*x.operands[i], *y.operands[i])) {
+                        return false;
+                    }
+                }
+                return true;
+            } else if constexpr (std::is_same_v<T, my_compare>) {
+                return x.field == y.field && x.op == y.op && x.value == y.value
+                       && x.rhs_field == y.rhs_field && x.ranges == y.ranges;
+            } else {
+                return equal(*x.left, *y.left) && equal(*x.right, *y.right);
+            }
+        },
+        a);
+}
+
+/**
+ * @brief Negated comparison operator, or std::nullopt for IN
+ */
+std::optional<compare_op> negated(compare_op op) {
+    switch (op) {
+        case compare_op::eq:
+            return compare_op::ne;
+        case compare_op::ne:
+            return compare_op::eq;
+        case compare_op::lt:
+            return compare_op::ge;
+        case compare_op::le:
+            return compare_op::gt;
+        case compare_op::gt:
+            return compare_op::le;
+        case compare_op::ge:
+            return compare_op::lt;
+        case compare_op::in:
+            break;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Moves the operands of a chain of @p T nodes into @p out, left to right
+ */
+template <typename T>
+void split_chain(my_expression_ptr expr, std::vector<my_expression_ptr>& out) {
+    if (auto* node = std::get_if<T>(expr.get())) {
+        split_chain<T>(std::move(node->left), out);
+        split_chain<T>(std::move(node->right), out);
+    } else {
+        out.push_back(std::move(expr));
+    }
+}
+
+class simplifier {
+   public:
+    explicit simplifier(simplify_stats& stats) : stats_(stats) {}
+
+    /**
+     * @brief Simplified copy of @p expr, or of `NOT expr` if @p negate is set
+     */
+    my_expression_ptr simplify(const my_expression& expr, bool negate) {
+        return std::visit(
+            [&](const auto& node) -> my_expression_ptr {
+                using T = std::decay_t<decltype(node)>;
+                if constexpr (std::is_same_v<T, my_constant>) {
+                    return constant(node.value != negate);
+                } else if constexpr (std::is_same_v<T, my_variable>) {
+                    auto variable = make(node);
+                    return negate ? make(my_not{std::move(variable)}) : std::move(variable);
+                } else if constexpr (std::is_same_v<T, my_not>) {
+                    if (negate) {
+                        ++stats_.double_negations;
+                    }
+                    return simplify(*node.expr, !negate);
+                } else if constexpr (std::is_same_v<T, my_and> || std::is_same_v<T, my_or>) {
+                    // NOT (a AND b) is NOT a OR NOT b
+                    const bool is_and = std::is_same_v<T, my_and> != negate;
+                    std::vector<my_expression_ptr> operands;
+                    gather_junction(*node.left, negate, is_and, operands);
+                    gather_junction(*node.right, negate, is_and, operands);
+                    return is_and ? junction<my_and>(std::move(operands), negate)
+                                  : junction<my_or>(std::move(operands), negate);
+                } else if constexpr (std::is_same_v<T, my_xor>) {
+                    std::vector<my_expression_ptr> operands;
+                    std::size_t negations = negate ? 1 : 0;
+                    gather_xor(*node.left, operands, negations);
+                    gather_xor(*node.right, operands, negations);
+                    return exclusive_or(std::move(operands), negations);
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    return cardinality(node, negate);
+                } else if constexpr (std::is_same_v<T, my_compare>) {
+                    if (negate) {
+                        if (auto op = negated(node.op)) {
+                            ++stats_.de_morgan;
+                            my_compare flipped = node;
+                            flipped.op = *op;
+                            return make(std::move(flipped));
+                        }
+                        return make(my_not{make(node)});
+                    }
+                    return make(node);
+                }
+            },
+            expr);
+    }
+
+   private:
+    simplify_stats& stats_;
+    /// Hash of every node built; the entry of a node is written when it is built
+    std::unordered_map<const my_expression*, std::uint64_t> hashes_;
+
+    /// Operands already in a list, by hash
+    using operand_index = std::unordered_multimap<std::uint64_t, const my_expression*>;
+
+    std::uint64_t hash_of(const my_expression& expr) const {
+        return hashes_.at(&expr);
+    }
+
+    my_expression_ptr make(my_expression node) {
+        auto expr = std::make_unique<my_expression>(std::move(node));
+        std::uint64_t h = mix(0, expr->index() + 1);
+        std::visit(
+            [&](const auto& content) {
+                using T = std::decay_t<decltype(content)>;
+                if constexpr (std::is_same_v<T, my_variable>) {
+                    h = mix(h, std::hash<std::string>{}(content.variable_name));
+                } else if constexpr (std::is_same_v<T, my_constant>) {
+                    h = mix(h, content.value ? 1 : 0);
+                } else if constexpr (std::is_same_v<T, my_not>) {
+                    h = mix(h, hash_of(*content.expr));
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    h = mix(mix(h, static_cast<std::uint64_t>(content.kind)), content.k);
+                    for (const auto& operand : content.operands) {
+                        h = mix(h, hash_of(*operand));
+                    }
+                } else if constexpr (std::is_same_v<T, my_compare>) {
+                    h = mix(h, std::hash<std::string>{}(content.field.name));
+                    h = mix(mix(h, static_cast<std::uint64_t>(content.op)), content.value);
+                } else {
+                    h = mix(mix(h, hash_of(*content.left)), hash_of(*content.right));
+                }
+            },
+            *expr);
+        hashes_[expr.get()] = h;
+        return expr;
+    }
+
+    my_expression_ptr constant(bool value) {
+        return make(my_constant{value});
+    }
+
+    const my_expression* find(const operand_index& index, const my_expression& expr) const {
+        auto [first, last] = index.equal_range(hash_of(expr));
+        for (auto it = first; it != last; ++it) {
+            if (equal(*it->second, expr)) {
+                return it->second;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Whether an operand of the chain of @p T nodes at @p expr is in @p index
+     */
+    template <typename T>
+    bool chain_shares_operand(const my_expression& expr, const operand_index& index) const {
+        std::vector<const my_expression*> pending = {&expr};
+        while (!pending.empty()) {
+            const my_expression* e = pending.back();
+            pending.pop_back();
+            if (const auto* node = std::get_if<T>(e)) {
+                pending.push_back(node->right.get());
+                pending.push_back(node->left.get());
+            } else if (find(index, *e) != nullptr) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Simplifies the operands of an AND (@p is_and) or OR chain into @p out
+     *
+     * Operands that are chains of the same operator, possibly under an even
+     * number of negations, are merged into the list.
+     */
+    void gather_junction(const my_expression& expr, bool negate, bool is_and,
+                         std::vector<my_expression_ptr>& out) {
+        const my_expression* inner = &expr;
+        std::size_t negations = 0;
+        while (const auto* neg = std::get_if<my_not>(inner)) {
+            inner = neg->expr.get();
+            ++negations;
+        }
+        const my_expression_ptr* left = nullptr;
+        const my_expression_ptr* right = nullptr;
+        if (negations % 2 == 1) {
+            // Merging NOT (a OR b) into an AND chain would only move the negation
+        } else if (const auto* conj = std::get_if<my_and>(inner); conj && is_and != negate) {
+            left = &conj->left;
+            right = &conj->right;
+        } else if (const auto* disj = std::get_if<my_or>(inner); disj && is_and == negate) {
+            left = &disj->left;
+            right = &disj->right;
+        }
+        if (left == nullptr) {
+            out.push_back(simplify(expr, negate));
+            return;
+        }
+        ++stats_.flattened;
+        stats_.double_negations += negations / 2;
+        gather_junction(**left, negate, is_and, out);
+        gather_junction(**right, negate, is_and, out);
+    }
+
+    /**
+     * @brief Applies the AND (@p T = my_and) or OR rules to simplified operands
+     *
+     * @param simplified Simplified operands
+     * @param negated Whether the operands come from a negated chain of the
+     *        dual operator, i.e. NOT (a OR b) given as NOT a AND NOT b
+     */
+    template <typename T>
+    my_expression_ptr junction(std::vector<my_expression_ptr> simplified, bool negated) {
+        constexpr bool is_and = std::is_same_v<T, my_and>;
+        using dual = std::conditional_t<is_and, my_or, my_and>;
+
+        // Simplified operands may themselves be chains of this operator
+        std::vector<my_expression_ptr> operands;
+        operands.reserve(simplified.size());
+        for (auto& operand : simplified) {
+            split_chain<T>(std::move(operand), operands);
+        }
+
+        std::vector<my_expression_ptr> kept;
+        operand_index seen;
+        for (auto& operand : operands) {
+            if (const auto* c = std::get_if<my_constant>(operand.get())) {
+                ++stats_.constants;
+                if (c->value != is_and) {
+                    return constant(!is_and);  // FALSE in AND, TRUE in OR
+                }
+                continue;
+            }
+            if (find(seen, *operand) != nullptr) {
+                ++stats_.idempotence;
+                continue;
+            }
+            seen.emplace(hash_of(*operand), operand.get());
+            kept.push_back(std::move(operand));
+        }
+
+        // x AND NOT x, and x AND NOT (x OR y), are FALSE
+        for (const auto& operand : kept) {
+            const auto* neg = std::get_if<my_not>(operand.get());
+            if (neg != nullptr && chain_shares_operand<dual>(*neg->expr, seen)) {
+                ++stats_.complements;
+                return constant(!is_and);
+            }
+        }
+
+        // x AND (x OR y) is x: drop dual chains sharing an operand with this one
+        std::vector<my_expression_ptr> result;
+        result.reserve(kept.size());
+        std::size_t negations = 0;
+        for (auto& operand : kept) {
+            if (std::holds_alternative<dual>(*operand)
+                && chain_shares_operand<dual>(*operand, seen)) {
+                ++stats_.absorption;
+                continue;
+            }
+            negations += std::holds_alternative<my_not>(*operand) ? 1 : 0;
+            result.push_back(std::move(operand));
+        }
+
+        if (result.empty()) {
+            return constant(is_and);
+        }
+
+        // NOT a AND NOT b is NOT (a OR b): one negation instead of several, placed where
+        // the first negated operand was
+        if (negated ? negations < result.size() : negations >= 2) {
+            ++stats_.de_morgan;
+        }
+        if (negations >= 2) {
+            std::vector<my_expression_ptr> inner;
+            std::size_t first = result.size();
+            std::size_t next = 0;
+            for (std::size_t i = 0; i < result.size(); ++i) {
+                if (auto* neg = std::get_if<my_not>(result[i].get())) {
+                    split_chain<dual>(std::move(neg->expr), inner);
+                    if (first != result.size()) {
+                        continue;
+                    }
+                    first = next;
+                }
+                if (next != i) {
+                    result[next] = std::move(result[i]);
+                }
+                ++next;
+            }
+            result.resize(next);
+            result[first] = make(my_not{chain<dual>(std::move(inner))});
+        }
+        return chain<T>(std::move(result));
+    }
+
+    /**
+     * @brief Simplifies the operands of an XOR chain into @p out
+     *
+     * Negations are counted in @p negations instead of being built.
+     */
+    void gather_xor(const my_expression& expr, std::vector<my_expression_ptr>& out,
+                    std::size_t& negations) {
+        if (const auto* neg = std::get_if<my_not>(&expr)) {
+            ++negations;
+            gather_xor(*neg->expr, out, negations);
+        } else if (const auto* node = std::get_if<my_xor>(&expr)) {
+            ++stats_.flattened;
+            gather_xor(*node->left, out, negations);
+            gather_xor(*node->right, out, negations);
+        } else {
+            out.push_back(simplify(expr, false));
+        }
+    }
+
+    /**
+     * @brief Applies the XOR rules to simplified operands, negated @p negations times
+     */
+    my_expression_ptr exclusive_or(std::vector<my_expression_ptr> simplified,
+                                   std::size_t negations) {
+        std::vector<my_expression_ptr> operands;
+        operands.reserve(simplified.size());
+        for (auto& operand : simplified) {
+            split_chain<my_xor>(std::move(operand), operands);
+        }
+
+        bool parity = false;
+        std::vector<my_expression_ptr> kept;
+        operand_index seen;
+        for (auto& operand : operands) {
+            if (const auto* c = std::get_if<my_constant>(operand.get())) {
+                ++stats_.constants;
+                parity = parity != c->value;
+                continue;
+            }
+            if (auto* neg = std::get_if<my_not>(operand.get())) {
+                ++negations;
+                operand = std::move(neg->expr);
+            }
+            if (const my_expression* same = find(seen, *operand)) {
+                // x XOR x is FALSE: remove both
+                ++stats_.xor_cancellations;
+                auto [first, last] = seen.equal_range(hash_of(*operand));
+                for (auto it = first; it != last; ++it) {
+                    if (it->second == same) {
+                        seen.erase(it);
+                        break;
+                    }
+                }
+                std::erase_if(kept, [&](const auto& e) { return e.get() == same; });
+                continue;
+            }
+            seen.emplace(hash_of(*operand), operand.get());
+            kept.push_back(std::move(operand));
+        }
+        stats_.double_negations += negations / 2;
+        parity = parity != (negations % 2 == 1);
+
+        if (kept.empty()) {
+            return constant(parity);
+        }
+        if (parity) {
+            // Negate the operand that is cheapest to negate
+            std::size_t cheapest = 0;
+            for (std::size_t i = 0; i < kept.size(); ++i) {
+                if (std::holds_alternative<my_variable>(*kept[i])
+                    || std::holds_alternative<my_compare>(*kept[i])) {
+                    cheapest = i;
+                    break;
+                }
+            }
+            // Simplifying the operand again makes no new rewrites
+            const simplify_stats counts = stats_;
+            kept[cheapest] = simplify(*kept[cheapest], true);
+            stats_ = counts;
+        }
+        return chain<my_xor>(std::move(kept));
+    }
+
+    /**
+     * @brief Simplified copy of a cardinality constraint, or of its negation
+     *
+     * Constant operands are removed and the bound adjusted; constraints that
+     * no longer depend on their operands become constants.
+     */
+    my_expression_ptr cardinality(const my_cardinality& node, bool negate) {
+        my_cardinality result{node.kind, node.k, {}};
+        std::size_t true_operands = 0;
+        for (const auto& operand : node.operands) {
+            auto simplified = simplify(*operand, false);
+            if (const auto* c = std::get_if<my_constant>(simplified.get())) {
+                ++stats_.constants;
+                true_operands += c->value ? 1 : 0;
+                continue;
+            }
+            result.operands.push_back(std::move(simplified));
+        }
+
+        // Count the true constants against the bound
+        const std::size_t n = result.operands.size();
+        std::optional<bool> value;
+        if (true_operands > result.k) {
+            value = result.kind == cardinality_kind::at_least;
+        } else {
+            result.k -= true_operands;
+            if (n == 0 || (result.kind == cardinality_kind::at_least && result.k == 0)) {
+                value = result.accepts(0);
+            } else if (result.kind == cardinality_kind::at_most && result.k >= n) {
+                value = true;
+            } else if (result.k > n) {
+                value = false;  // EXACTLY_K and AT_LEAST_K above the operand count
+            }
+        }
+        if (value) {
+            ++stats_.constants;
+            return constant(*value != negate);
+        }
+
+        if (negate) {
+            // NOT AT_MOST_K(k) is AT_LEAST_K(k + 1) and NOT AT_LEAST_K(k) is AT_MOST_K(k - 1)
+            if (result.kind == cardinality_kind::exactly) {
+                return make(my_not{make(std::move(result))});
+            }
+            ++stats_.de_morgan;
+            if (result.kind == cardinality_kind::at_most) {
+                result.kind = cardinality_kind::at_least;
+                ++result.k;
+            } else {
+                result.kind = cardinality_kind::at_most;
+                --result.k;
+            }
+        }
+        return make(std::move(result));
+    }
+
+    /**
+     * @brief Left-deep chain of @p T over @p operands, in order
+     */
+    template <typename T>
+    my_expression_ptr chain(std::vector<my_expression_ptr> operands) {
+        my_expression_ptr result = std::move(operands.front());
+        for (std::size_t i = 1; i < operands.size(); ++i) {
+            result = make(T{std::move(result), std::move(operands[i])});
+        }
+        return result;
+    }
+};
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+my_expression_ptr simplify_expression(const my_expression& expr, simplify_stats* stats) {
+    simplify_stats counts;
+    my_expression_ptr result = simplifier(counts).simplify(expr, false);
+    if (stats != nullptr) {
+        stats->constants += counts.constants;
+        stats->idempotence += counts.idempotence;
+        stats->absorption += counts.absorption;
+        stats->complements += counts.complements;
+        stats->double_negations += counts.double_negations;
+        stats->xor_cancellations += counts.xor_cancellations;
+        stats->de_morgan += counts.de_morgan;
+        stats->flattened += counts.flattened;
+        stats->nodes_before += expression_size(expr);
+        stats->nodes_after += expression_size(*result);
+    }
+    return result;
+}
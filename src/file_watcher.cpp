@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file file_watcher.cpp
+ * @brief Notification when a file is saved implementation
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "file_watcher.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+/// Quiet period after a save, so the writes of one save are reported once
+constexpr std::chrono::milliseconds settle_time{50};
+
+#ifndef __linux__
+constexpr std::chrono::milliseconds poll_interval{200};
+#endif
+
+}  // namespace
+
+// ============================================================================
+// Exported functions (file_watcher class)
+// ============================================================================
+
+file_watcher::file_watcher(std::filesystem::path path) : path_(std::move(path)) {
+#ifdef __linux__
+    auto directory = path_.parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0
+        || inotify_add_watch(inotify_fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        const std::string error = std::strerror(errno);
+        if (inotify_fd_ >= 0) {
+            close(inotify_fd_);
+        }
+        throw std::runtime_error("Cannot watch " + directory.string() + ": " + error);
+    }
+#else
+    std::error_code ec;
+    last_write_time_ = std::filesystem::last_write_time(path_, ec);
+    last_size_ = std::filesystem::file_size(path_, ec);
+#endif
+}
+
+file_watcher::~file_watcher() {
+#ifdef __linux__
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_);
+    }
+#endif
+}
+
+bool file_watcher::wait(std::chrono::milliseconds timeout) {
+    using clock = std::chrono::steady_clock;
+    const bool unbounded = timeout.count() < 0;
+    const auto deadline = unbounded ? clock::time_point::max() : clock::now() + timeout;
+
+#ifdef __linux__
+    const std::string name = path_.filename().string();
+    // Reads the queued events; true if one names the watched file
+    auto drain = [&] {
+        alignas(inotify_event) std::array<char, 4096> buffer;
+        bool matched = false;
+        ssize_t length;
+        while ((length = read(inotify_fd_, buffer.data(), buffer.size())) > 0) {
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+                if (event->len > 0 && name == event->name) {
+                    matched = true;
+                }
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+        return matched;
+    };
+
+    for (;;) {
+        int wait_ms = -1;
+        if (!unbounded) {
+            const auto left =
+                std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now());
+            if (left.count() <= 0) {
+                return false;
+            }
+            wait_ms = static_cast<int>(left.count());
+        }
+        pollfd descriptor{inotify_fd_, POLLIN, 0};
+        const int ready = poll(&descriptor, 1, wait_ms);
+        if (ready < 0 && errno != EINTR) {
+            throw std::runtime_error(std::string("Cannot wait for file changes: ")
+                                     + std::strerror(errno));
+        }
+        if (ready > 0 && drain()) {
+            std::this_thread::sleep_for(settle_time);
+            drain();
+            return true;
+        }
+    }
+#else
+    for (;;) {
+        std::error_code ec;
+        const auto write_time = std::filesystem::last_write_time(path_, ec);
+        const auto size = std::filesystem::file_size(path_, ec);
+        if (!ec && (write_time != last_write_time_ || size != last_size_)) {
+            std::this_thread::sleep_for(settle_time);
+            last_write_time_ = std::filesystem::last_write_time(path_, ec);
+            last_size_ = std::filesystem::file_size(path_, ec);
+            return true;
+        }
+        if (clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(poll_interval);
+    }
+#endif
+}
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file image_benchmark_main.cpp
+ * @brief Lookup benchmark for flat BDD images
+ *
+ * Builds the BDD of an expression file, lowers it to a flat image, writes the
+ * image to a file and maps it back read-only, then compares single-assignment
+ * lookup throughput of the image against walking the TeDDy diagram with
+ * teddy_iterator and with raw node pointers. All results are cross-checked,
+ * including an image lowered from the CUDD BDD of the same expression.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include <cudd/cuddObj.hh>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "bdd_image.hpp"
+#include "benchmark_timing.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "teddy_convert.hpp"
+#include "teddy_iterator.hpp"
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using benchmark_timing::best_time;
+
+void print_help() {
+    std::cout << "BDD Image Benchmark - Flat image lookup throughput\n";
+    std::cout << "==================================================\n\n";
+    std::cout << "Usage: bdd_image_bench <expression_file> [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --rows=<int>          Assignments to look up (default 1000000)\n";
+    std::cout << "  --repeat=<int>        Timed runs per method, best is reported (default 3)\n";
+    std::cout << "  --seed=<int>          Seed for the random assignments (default 1)\n";
+    std::cout << "  --image=<file>        Keep the image file at this path (default: a "
+                 "temporary file)\n";
+    std::cout << "  --help, -h            Show this help message\n";
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+/**
+ * @brief Image benchmark entry point
+ *
+ * @param argc Number of command line arguments
+ * @param argv Array of command line argument strings
+ * @return 0 on success, 1 on error or if the lookup methods disagree
+ */
+int main(int argc, const char* argv[]) {
+    std::string input_file;
+    std::size_t rows = 1'000'000;
+    int repeat = 3;
+    std::uint64_t seed = 1;
+    std::filesystem::path image_file;
+    bool show_help = false;
+    bool help_due_to_error = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg.starts_with("--rows=")) {
+                rows = std::stoull(arg.substr(7));
+            } else if (arg.starts_with("--repeat=")) {
+                repeat = std::max(1, std::stoi(arg.substr(9)));
+            } else if (arg.starts_with("--seed=")) {
+                seed = std::stoull(arg.substr(7));
+            } else if (arg.starts_with("--image=")) {
+                image_file = arg.substr(8);
+            } else if (arg == "--help" || arg == "-h") {
+                show_help = true;
+                break;
+            } else if (arg.starts_with("-")) {
+                std::cerr << "Unknown option: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            } else if (input_file.empty()) {
+                input_file = arg;
+            } else {
+                std::cerr << "Multiple input files specified. Only one file is allowed.\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric option value\n";
+        return 1;
+    }
+
+    if (!show_help && input_file.empty()) {
+        std::cerr << "No expression file specified\n";
+        show_help = true;
+        help_due_to_error = true;
+    }
+
+    if (show_help) {
+        print_help();
+        return help_due_to_error ? 1 : 0;
+    }
+
+    const bool keep_image = !image_file.empty();
+    if (!keep_image) {
+        image_file = std::filesystem::temp_directory_path() / "bdd_image_bench.img";
+    }
+
+    int status = 0;
+
+    try {
+        auto expr = read_expression_from_file(input_file);
+        std::unordered_set<std::string> variable_names;
+        collect_variables_with_dag_walker(*expr, variable_names);
+        std::vector<std::string> ordered = ordered_variable_names(variable_names);
+
+        teddy::bdd_manager manager(static_cast<int>(ordered.size()), 1'000);
+        auto f = convert_to_bdd(*expr, manager);
+        auto [cudd_mgr, cudd_bdd] = convert_to_cudd_bdd(*expr, variable_names);
+
+        bdd_image::compile_teddy(manager, f, ordered).save(image_file.string());
+        bdd_image::image mapped = bdd_image::image::load(image_file.string());
+        bdd_image::image from_cudd = bdd_image::compile_cudd(*cudd_mgr, cudd_bdd, ordered);
+
+        std::cout << std::format("\nTeDDy nodes: {}, image records: {} ({} bytes, {}), "
+                                 "CUDD image records: {}\n",
+                                 manager.get_node_count(f), mapped.nodes().size(),
+                                 mapped.nodes().size_bytes(),
+                                 mapped.is_mapped() ? "memory mapped" : "in memory",
+                                 from_cudd.nodes().size());
+
+        // Random row-major assignments, one byte per variable
+        const std::size_t stride = ordered.size();
+        std::vector<std::uint8_t> assignments(rows * stride);
+        std::mt19937_64 rng(seed);
+        for (auto& value : assignments) {
+            value = static_cast<std::uint8_t>(rng() & 1);
+        }
+        auto row = [&](std::size_t r) {
+            return std::span<const std::uint8_t>(assignments.data() + r * stride, stride);
+        };
+
+        std::vector<std::uint8_t> iterator_results(rows);
+        std::vector<std::uint8_t> pointer_results(rows);
+        std::vector<std::uint8_t> single_results(rows);
+        std::vector<std::uint8_t> batch_results(rows);
+        std::vector<std::uint8_t> cudd_results(rows);
+
+        struct method_time {
+            std::string name;
+            double seconds;
+        };
+        std::vector<method_time> times;
+
+        times.push_back({"teddy_iterator", best_time(repeat, [&] {
+                             for (std::size_t r = 0; r < rows; ++r) {
+                                 teddy_iterator it(f.unsafe_get_root(), &ordered);
+                                 while (!it.is_terminal()) {
+                                     auto children = it.get_children();
+                                     it = children[row(r)[it.get_node()->get_index()] != 0];
+                                 }
+                                 iterator_results[r] =
+                                     static_cast<std::uint8_t>(it.get_terminal_value());
+                             }
+                         })});
+        times.push_back({"teddy pointers", best_time(repeat, [&] {
+                             for (std::size_t r = 0; r < rows; ++r) {
+                                 auto* node = f.unsafe_get_root();
+                                 while (!node->is_terminal()) {
+                                     node = node->get_son(row(r)[node->get_index()] != 0);
+                                 }
+                                 pointer_results[r] = static_cast<std::uint8_t>(node->get_value());
+                             }
+                         })});
+        times.push_back({"image", best_time(repeat, [&] {
+                             for (std::size_t r = 0; r < rows; ++r) {
+                                 single_results[r] = mapped.evaluate(row(r)) ? 1 : 0;
+                             }
+                         })});
+        times.push_back({"image batch", best_time(repeat, [&] {
+                             mapped.evaluate_batch(assignments, batch_results);
+                         })});
+        from_cudd.evaluate_batch(assignments, cudd_results);
+
+        std::cout << std::format("Rows: {}, variables: {}, repeat: {}\n\n", rows, stride,
+                                 repeat);
+        std::cout << std::format("{:<16} {:>12} {:>16}\n", "Method", "Best ms", "Lookups/s");
+        for (const auto& [name, seconds] : times) {
+            double rate = seconds > 0.0 ? static_cast<double>(rows) / seconds : 0.0;
+            std::cout << std::format("{:<16} {:>12.3f} {:>16.3e}\n", name, seconds * 1000.0,
+                                     rate);
+        }
+
+        if (keep_image) {
+            std::cout << "\nImage saved to '" << image_file.string() << "'\n";
+        }
+        if (pointer_results != iterator_results || single_results != iterator_results
+            || batch_results != iterator_results || cudd_results != iterator_results) {
+            std::cerr << "Error: lookup methods disagree\n";
+            status = 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        status = 1;
+    }
+
+    // The mapping is gone once the try block is left, so the file can be removed
+    if (!keep_image) {
+        std::error_code ignored;
+        std::filesystem::remove(image_file, ignored);
+    }
+    return status;
+}
@@ -0,0 +1,437 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file incremental_convert.cpp
+ * @brief Subtree cache for incremental conversion implementation
+ *
+ * Implements the structural hash, the cached conversion and the cache file.
+ *
+ * File layout (native byte order):
+ * - magic "BDDSUBT1", 32-bit format version, 32-bit variable count, 64-bit
+ *   node count, 64-bit entry count
+ * - name table: for each variable a 32-bit length followed by its bytes
+ * - node records of three 32-bit values (variable, low, high); ids 0 and 1
+ *   are the terminals and record i has id i + 2, with its children listed
+ *   before it
+ * - entries: 64-bit high and low key, 32-bit root id
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "incremental_convert.hpp"
+
+#include <array>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "cardinality_bdd.hpp"
+#include "teddy_convert.hpp"
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using incremental::subtree_key;
+using diagram_t = teddy::bdd_manager::diagram_t;
+
+constexpr std::array<char, 8> cache_magic = {'B', 'D', 'D', 'S', 'U', 'B', 'T', '1'};
+constexpr std::uint32_t cache_version = 1;
+
+// splitmix64 finalizer
+constexpr std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief Two independently mixed 64-bit lanes over a stream of words
+ *
+ * Strings are fed as little-endian 8-byte chunks, so the hash does not
+ * depend on the platform.
+ */
+class hasher {
+   public:
+    void add(std::uint64_t value) {
+        high_ = mix(high_ ^ value);
+        low_ = mix(low_ + value * 0x9E3779B97F4A7C15ULL + 0x632BE59BD9B4E019ULL);
+    }
+
+    void add(const std::string& text) {
+        add(text.size());
+        for (std::size_t i = 0; i < text.size(); i += 8) {
+            std::uint64_t chunk = 0;
+            for (std::size_t j = 0; j < 8 && i + j < text.size(); ++j) {
+                chunk |= std::uint64_t{static_cast<unsigned char>(text[i + j])} << (8 * j);
+            }
+            add(chunk);
+        }
+    }
+
+    void add(const subtree_key& key) {
+        add(key.high);
+        add(key.low);
+    }
+
+    void add(const my_field& field) {
+        add(field.name);
+        add(field.width);
+        add(field.domain);
+        add(field.value_names.size());
+        for (const auto& name : field.value_names) {
+            add(name);
+        }
+    }
+
+    subtree_key key() const {
+        return {high_, low_};
+    }
+
+   private:
+    std::uint64_t high_ = 0x6A09E667F3BCC908ULL;
+    std::uint64_t low_ = 0xBB67AE8584CAA73BULL;
+};
+
+struct subtree_info {
+    subtree_key key;
+    std::size_t size = 0;  ///< Expression nodes in the subtree
+};
+
+using info_map = std::unordered_map<const my_expression*, subtree_info>;
+
+/// Hashes every subtree of @p expr bottom-up into @p info
+const subtree_info& hash_subtrees(const my_expression& expr, info_map& info) {
+    hasher h;
+    h.add(expr.index() + 1);
+    std::size_t size = 1;
+    auto add_child = [&](const my_expression& child) {
+        const auto& child_info = hash_subtrees(child, info);
+        h.add(child_info.key);
+        size += child_info.size;
+    };
+    std::visit(
+        [&](const auto& node) {
+            using T = std::decay_t<decltype(node)>;
+            if constexpr (std::is_same_v<T, my_variable>) {
+                h.add(node.variable_name);
+            } else if constexpr (std::is_same_v<T, my_not>) {
+                add_child(*node.expr);
+            } else if constexpr (std::is_same_v<T, my_and> || std::is_same_v<T, my_or>
+                                 || std::is_same_v<T, my_xor>) {
+                add_child(*node.left);
+                add_child(*node.right);
+            } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                h.add(static_cast<std::uint64_t>(node.kind));
+                h.add(node.k);
+                h.add(node.operands.size());
+                for (const auto& operand : node.operands) {
+                    add_child(*operand);
+                }
+            } else if constexpr (std::is_same_v<T, my_compare>) {
+                h.add(node.field);
+                h.add(static_cast<std::uint64_t>(node.op));
+                h.add(node.value);
+                h.add(node.rhs_field.has_value() ? 1 : 0);
+                if (node.rhs_field) {
+                    h.add(*node.rhs_field);
+                }
+                h.add(node.ranges.size());
+                for (const auto& [lo, hi] : node.ranges) {
+                    h.add(lo);
+                    h.add(hi);
+                }
+            } else if constexpr (std::is_same_v<T, my_constant>) {
+                h.add(node.value ? 1 : 0);
+            }
+        },
+        expr);
+    return info[&expr] = subtree_info{h.key(), size};
+}
+
+/// Calls @p visit for each direct operand of @p expr
+template <class Visit>
+void for_each_operand(const my_expression& expr, Visit&& visit) {
+    std::visit(
+        [&](const auto& node) {
+            using T = std::decay_t<decltype(node)>;
+            if constexpr (std::is_same_v<T, my_not>) {
+                visit(*node.expr);
+            } else if constexpr (std::is_same_v<T, my_and> || std::is_same_v<T, my_or>
+                                 || std::is_same_v<T, my_xor>) {
+                visit(*node.left);
+                visit(*node.right);
+            } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                for (const auto& operand : node.operands) {
+                    visit(*operand);
+                }
+            }
+        },
+        expr);
+}
+
+template <class T>
+void write_value(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <class T>
+T read_value(std::ifstream& in) {
+    T value{};
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+// ============================================================================
+// Exported functions (incremental namespace)
+// ============================================================================
+
+namespace incremental {
+
+subtree_key structural_hash(const my_expression& expr) {
+    info_map info;
+    return hash_subtrees(expr, info).key;
+}
+
+subtree_cache::subtree_cache(teddy::bdd_manager& manager, std::vector<std::string> variable_names,
+                             std::size_t min_subtree_size)
+    : manager_(&manager),
+      variable_names_(std::move(variable_names)),
+      min_subtree_size_(min_subtree_size) {
+    for (std::size_t i = 0; i < variable_names_.size(); ++i) {
+        var_map_[variable_names_[i]] = static_cast<int>(i);
+    }
+}
+
+subtree_cache::diagram_t subtree_cache::convert(const my_expression& expr, convert_stats* stats,
+                                                conversion_budget* budget) {
+    using namespace teddy::ops;
+    teddy::bdd_manager& mgr = *manager_;
+
+    info_map info;
+    hash_subtrees(expr, info);
+
+    convert_stats counts;
+    std::unordered_map<subtree_key, diagram_t, subtree_key_hash> next;
+    const diagram_t one = mgr.constant(1);
+    auto ite = make_teddy_ite(mgr);
+
+    // A reused subtree keeps the entries below it, for later edits inside it
+    std::function<void(const my_expression&)> keep_descendants = [&](const my_expression& e) {
+        for_each_operand(e, [&](const my_expression& child) {
+            const subtree_info& node = info.at(&child);
+            if (node.size < min_subtree_size_) {
+                return;
+            }
+            if (auto it = entries_.find(node.key); it != entries_.end()) {
+                next.emplace(node.key, it->second);
+            }
+            keep_descendants(child);
+        });
+    };
+
+    std::function<diagram_t(const my_expression&)> convert_recursive =
+        [&](const my_expression& e) -> diagram_t {
+        const subtree_info& node = info.at(&e);
+        const bool cacheable = node.size >= min_subtree_size_;
+        if (cacheable) {
+            // A subtree repeated within this expression is found in `next`
+            auto it = next.find(node.key);
+            if (it == next.end() && (it = entries_.find(node.key)) != entries_.end()) {
+                it = next.emplace(node.key, it->second).first;
+            }
+            if (it != next.end()) {
+                keep_descendants(e);
+                ++counts.reused;
+                counts.reused_nodes += node.size;
+                return it->second;
+            }
+        }
+
+        diagram_t result = std::visit(
+            [&](const auto& content) -> diagram_t {
+                using T = std::decay_t<decltype(content)>;
+                if constexpr (std::is_same_v<T, my_and>) {
+                    return mgr.apply<AND>(convert_recursive(*content.left),
+                                          convert_recursive(*content.right));
+                } else if constexpr (std::is_same_v<T, my_or>) {
+                    return mgr.apply<OR>(convert_recursive(*content.left),
+                                         convert_recursive(*content.right));
+                } else if constexpr (std::is_same_v<T, my_xor>) {
+                    return mgr.apply<XOR>(convert_recursive(*content.left),
+                                          convert_recursive(*content.right));
+                } else if constexpr (std::is_same_v<T, my_not>) {
+                    return mgr.apply<XOR>(convert_recursive(*content.expr), one);
+                } else if constexpr (std::is_same_v<T, my_cardinality>) {
+                    std::vector<std::pair<int, diagram_t>> operands;
+                    operands.reserve(content.operands.size());
+                    for (const auto& operand : content.operands) {
+                        diagram_t operand_bdd = convert_recursive(*operand);
+                        int level = cardinality_bdd::operand_level(
+                            *operand, [&](const std::string& name) {
+                                return static_cast<int>(mgr.get_level(var_map_.at(name)));
+                            });
+                        operands.emplace_back(level, std::move(operand_bdd));
+                    }
+                    return cardinality_bdd::build(content, std::move(operands), mgr.constant(0),
+                                                  one, ite);
+                } else {
+                    // Variables, field comparisons and constants have no sub-expressions
+                    // to reuse
+                    counts.rebuilt += node.size - 1;
+                    return convert_to_bdd_with_map(e, mgr, var_map_);
+                }
+            },
+            e);
+        ++counts.rebuilt;
+        if (budget != nullptr) {
+            budget->check(e, static_cast<std::size_t>(mgr.get_node_count()), [&] {
+                mgr.force_gc();
+                return static_cast<std::size_t>(mgr.get_node_count());
+            });
+        }
+        if (cacheable) {
+            next.emplace(node.key, result);
+        }
+        return result;
+    };
+
+    diagram_t result = convert_recursive(expr);
+    entries_ = std::move(next);
+    counts.cached = entries_.size();
+    if (stats != nullptr) {
+        *stats = counts;
+    }
+    return result;
+}
+
+void subtree_cache::save(const std::filesystem::path& path) const {
+    using node_t = diagram_t::node_t;
+
+    // One node table for all entries, children before parents
+    std::vector<std::array<std::uint32_t, 3>> records;
+    std::unordered_map<node_t*, std::uint32_t> ids;
+    std::function<std::uint32_t(node_t*)> export_recursive = [&](node_t* node) {
+        if (node->is_terminal()) {
+            return node->get_value() != 0 ? std::uint32_t{1} : std::uint32_t{0};
+        }
+        if (auto it = ids.find(node); it != ids.end()) {
+            return it->second;
+        }
+        std::uint32_t low = export_recursive(node->get_son(0));
+        std::uint32_t high = export_recursive(node->get_son(1));
+        records.push_back({static_cast<std::uint32_t>(node->get_index()), low, high});
+        const auto id = static_cast<std::uint32_t>(records.size() + 1);
+        ids.emplace(node, id);
+        return id;
+    };
+    std::vector<std::pair<subtree_key, std::uint32_t>> roots;
+    roots.reserve(entries_.size());
+    for (const auto& [key, diagram] : entries_) {
+        diagram_t copy = diagram;
+        roots.emplace_back(key, export_recursive(copy.unsafe_get_root()));
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Cannot write subtree cache: " + path.string());
+    }
+    out.write(cache_magic.data(), cache_magic.size());
+    write_value(out, cache_version);
+    write_value(out, static_cast<std::uint32_t>(variable_names_.size()));
+    write_value(out, static_cast<std::uint64_t>(records.size()));
+    write_value(out, static_cast<std::uint64_t>(roots.size()));
+    for (const auto& name : variable_names_) {
+        write_value(out, static_cast<std::uint32_t>(name.size()));
+        out.write(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+    for (const auto& record : records) {
+        for (std::uint32_t value : record) {
+            write_value(out, value);
+        }
+    }
+    for (const auto& [key, root] : roots) {
+        write_value(out, key.high);
+        write_value(out, key.low);
+        write_value(out, root);
+    }
+    if (!out) {
+        throw std::runtime_error("Cannot write subtree cache: " + path.string());
+    }
+}
+
+std::size_t subtree_cache::load(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return 0;
+    }
+    auto invalid = [&] { return std::runtime_error("Invalid subtree cache: " + path.string()); };
+
+    std::array<char, 8> magic{};
+    in.read(magic.data(), magic.size());
+    if (!in || magic != cache_magic || read_value<std::uint32_t>(in) != cache_version) {
+        throw invalid();
+    }
+    const auto variables = read_value<std::uint32_t>(in);
+    const auto node_count = read_value<std::uint64_t>(in);
+    const auto entry_count = read_value<std::uint64_t>(in);
+    if (!in) {
+        throw invalid();
+    }
+
+    // Diagrams refer to variable indices, so they only fit the same order
+    std::vector<std::string> names(variables);
+    for (auto& name : names) {
+        const auto length = read_value<std::uint32_t>(in);
+        if (!in || length > (std::uint32_t{1} << 20)) {
+            throw invalid();
+        }
+        name.resize(length);
+        in.read(name.data(), length);
+    }
+    if (!in) {
+        throw invalid();
+    }
+    if (names != variable_names_) {
+        return 0;
+    }
+
+    teddy::bdd_manager& mgr = *manager_;
+    auto ite = make_teddy_ite(mgr);
+    std::vector<diagram_t> built{mgr.constant(0), mgr.constant(1)};
+    for (std::uint64_t i = 0; i < node_count; ++i) {
+        const auto var = read_value<std::uint32_t>(in);
+        const auto low = read_value<std::uint32_t>(in);
+        const auto high = read_value<std::uint32_t>(in);
+        if (!in || var >= variables || low >= built.size() || high >= built.size()) {
+            throw invalid();
+        }
+        built.push_back(ite(mgr.variable(static_cast<int>(var)), built[high], built[low]));
+    }
+    for (std::uint64_t i = 0; i < entry_count; ++i) {
+        subtree_key key;
+        key.high = read_value<std::uint64_t>(in);
+        key.low = read_value<std::uint64_t>(in);
+        const auto root = read_value<std::uint32_t>(in);
+        if (!in || root >= built.size()) {
+            throw invalid();
+        }
+        entries_.insert_or_assign(key, built[root]);
+    }
+    return static_cast<std::size_t>(entry_count);
+}
+
+}  // namespace incremental
@@ -16,6 +16,11 @@
  *
  * Features:
  * - Parse logical expressions with AND, OR, XOR, NOT operators
+ * - Cardinality constraints (EXACTLY_ONE, EXACTLY_K, AT_MOST_K, AT_LEAST_K)
+ * - Bit-vector field comparisons (==, !=, <, <=, >, >=, IN sets and ranges)
+ * - Enumerated DOMAIN fields, optionally built as multi-valued decision diagrams
+ * - `let` definitions and several named outputs per file, built in one manager
+ * - Optional algebraic simplification of the expression before conversion
  * - Convert expressions to Binary Decision Diagrams (BDDs)
  * - Generate DOT graph representations for visualization
  * - Output detailed BDD node tables
@@ -25,6 +30,10 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <filesystem>
 #include <format>
 #include <fstream>
@@ -32,7 +41,10 @@
 #include <iomanip>
 #include <iostream>
 #include <libteddy/core.hpp>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <ranges>
 #include <sstream>
 #include <stack>
@@ -47,17 +59,37 @@
 
 #include <cudd/cuddObj.hh>
 
+#include "conjunctive_partition.hpp"
+#include "conversion_limits.hpp"
 #include "cudd_convert.hpp"
 #include "cudd_graph.hpp"
 #include "cudd_iterator.hpp"
+#include "cudd_zdd_convert.hpp"
+#include "cudd_zdd_graph.hpp"
 #include "dag_walker.hpp"
+#include "equivalence_check.hpp"
 #include "expression_adapter.hpp"
 #include "expression_graph.hpp"
 #include "expression_parser.hpp"
+#include "expression_simplify.hpp"
+#include "file_watcher.hpp"
+#include "incremental_convert.hpp"
+#include "manager_sizing.hpp"
+#include "model_count.hpp"
+#include "multi_output.hpp"
+#include "native_convert.hpp"
+#include "native_graph.hpp"
+#include "native_iterator.hpp"
+#include "parallel_convert.hpp"
+#include "partitioned_convert.hpp"
 #include "node_table_generator.hpp"
+#include "reliability.hpp"
 #include "teddy_convert.hpp"
 #include "teddy_graph.hpp"
 #include "teddy_iterator.hpp"
+#include "teddy_mdd_convert.hpp"
+#include "teddy_mdd_graph.hpp"
+#include "truth_table.hpp"
 
 // ============================================================================
 // Anonymous namespace for implementation details
@@ -65,6 +97,9 @@
 
 namespace {
 
+/// Largest --threads value; each thread is a real worker, so a typo must not spawn millions
+constexpr unsigned max_threads = 1024;
+
 /**
  * @brief Constructs output file path with suffix in same directory as input file
  *
@@ -84,6 +119,454 @@ std::filesystem::path get_output_path(const std::filesystem::path& input_filepat
     return dir / (base_name + suffix);
 }
 
+/**
+ * @brief Parses the leading digits of a count and reports where they end
+ *
+ * std::stoull accepts a leading sign and wraps negative values, so the text
+ * must start with a digit.
+ *
+ * @throws std::invalid_argument If the text does not start with a digit
+ * @throws std::out_of_range If the value does not fit
+ */
+std::size_t parse_leading_count(const std::string& text, std::size_t& end) {
+    if (text.empty() || !std::isdigit(static_cast<unsigned char>(text.front()))) {
+        throw std::invalid_argument("not a non-negative integer: " + text);
+    }
+    return std::stoull(text, &end);
+}
+
+/**
+ * @brief Parses a count in [minimum, maximum], such as a node limit
+ *
+ * @throws std::invalid_argument If the text is not an integer with nothing after it
+ * @throws std::out_of_range If the value is outside [minimum, maximum]
+ */
+std::size_t parse_count(const std::string& text, std::size_t minimum = 1,
+                        std::size_t maximum = std::numeric_limits<std::size_t>::max()) {
+    std::size_t end = 0;
+    const auto value = parse_leading_count(text, end);
+    if (end != text.size()) {
+        throw std::invalid_argument("trailing characters: " + text);
+    }
+    if (value < minimum || value > maximum) {
+        throw std::out_of_range("count out of range: " + text);
+    }
+    return value;
+}
+
+/**
+ * @brief Parses a positive byte count with an optional K, M or G suffix (powers of 1024)
+ *
+ * @throws std::invalid_argument If the text is not a positive number with a known suffix
+ * @throws std::out_of_range If the value does not fit
+ */
+std::size_t parse_byte_count(const std::string& text) {
+    std::size_t end = 0;
+    const auto value = parse_leading_count(text, end);
+    if (value == 0) {
+        throw std::invalid_argument("must be positive: " + text);
+    }
+    const std::string suffix = text.substr(end);
+    int shift = 0;
+    if (suffix == "K" || suffix == "k") {
+        shift = 10;
+    } else if (suffix == "M" || suffix == "m") {
+        shift = 20;
+    } else if (suffix == "G" || suffix == "g") {
+        shift = 30;
+    } else if (!suffix.empty()) {
+        throw std::invalid_argument("unknown size suffix: " + suffix);
+    }
+    if (value > (std::numeric_limits<std::size_t>::max() >> shift)) {
+        throw std::out_of_range("byte count too large: " + text);
+    }
+    return value << shift;
+}
+
+/**
+ * @brief Parses a positive time limit in seconds, rounded up to whole milliseconds
+ *
+ * @throws std::invalid_argument If the text is not a positive number
+ * @throws std::out_of_range If the value does not fit
+ */
+std::chrono::milliseconds parse_timeout(const std::string& text) {
+    std::size_t end = 0;
+    const double seconds = std::stod(text, &end);
+    if (end != text.size()) {
+        throw std::invalid_argument("trailing characters: " + text);
+    }
+    if (!(seconds > 0.0)) {
+        throw std::invalid_argument("must be positive: " + text);
+    }
+    const double milliseconds = std::ceil(seconds * 1000.0);
+    if (!(milliseconds < static_cast<double>(std::numeric_limits<long long>::max()))) {
+        throw std::out_of_range("time limit too large: " + text);
+    }
+    return std::chrono::milliseconds(static_cast<long long>(milliseconds));
+}
+
+/**
+ * @brief Prints the solution count and the first solutions of a diagram
+ *
+ * @param view teddy_view, cudd_view or native_view of the diagram
+ * @param names Variable names by index
+ * @param count Print the number of satisfying assignments
+ * @param limit Print up to this many solutions (0 = none)
+ * @param cubes Print cubes (paths) instead of complete assignments
+ */
+template <class View>
+void report_solutions(const View& view, const std::vector<std::string>& names, bool count,
+                      std::size_t limit, bool cubes) {
+    if (count) {
+        std::cout << "Satisfying assignments: " << count_solutions(view, names.size()).to_string()
+                  << " (over " << names.size() << " variables)\n";
+    }
+    if (limit == 0) {
+        return;
+    }
+
+    std::size_t listed = 0;
+    if (cubes) {
+        cube_enumerator<View> it(view, names.size());
+        while (listed < limit && it.next()) {
+            std::string text;
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                if (it.cube()[i] != cube_enumerator<View>::free) {
+                    text += (text.empty() ? "" : " AND ") + std::string(it.cube()[i] ? "" : "NOT ")
+                            + names[i];
+                }
+            }
+            std::cout << std::format("Cube {}: {}\n", ++listed, text.empty() ? "TRUE" : text);
+        }
+    } else {
+        assignment_enumerator<View> it(view, names.size());
+        while (listed < limit && it.next()) {
+            std::string text;
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                if (it.assignment()[i] != 0) {
+                    text += (text.empty() ? "" : ", ") + names[i];
+                }
+            }
+            std::cout << std::format("Solution {}: {{{}}}\n", ++listed, text);
+        }
+    }
+    if (listed == 0) {
+        std::cout << "No solutions\n";
+    }
+}
+
+/**
+ * @brief Prints P(f = 1) for the vectors of a probability file
+ *
+ * A single vector also prints the Birnbaum importance and marginal of every
+ * variable; several vectors print a summary and write one probability per
+ * vector to `<input>_probability.csv`.
+ *
+ * @param d Compiled diagram
+ * @param names Variable names by index
+ * @param table Probability vectors read from the file
+ * @param input_file Input expression file, for the output path
+ * @param threads Worker threads for batches (0 = hardware concurrency)
+ */
+void report_reliability(const reliability::diagram& d, const std::vector<std::string>& names,
+                        const reliability::probability_table& table,
+                        const std::filesystem::path& input_file, unsigned threads) {
+    if (table.rows() == 0) {
+        std::cout << "Probability file holds no vectors\n";
+        return;
+    }
+    if (table.rows() == 1) {
+        const auto result = reliability::analyze(d, table.row(0));
+        std::cout << std::format("P(f = 1) = {:.10g}\n", result.probability);
+        std::cout << std::format("{:<24} {:>12} {:>12} {:>12}\n", "Variable", "p", "Birnbaum",
+                                 "P(x|f)");
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            std::cout << std::format("{:<24} {:>12.6g} {:>12.6g} {:>12.6g}\n", names[i],
+                                     table.row(0)[i], result.birnbaum[i], result.marginal[i]);
+        }
+        return;
+    }
+
+    reliability::batch_options options;
+    options.threads = threads;
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = reliability::probabilities(d, table.values, options);
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    const auto [min_it, max_it] = std::ranges::minmax_element(result);
+    double sum = 0.0;
+    for (double value : result) {
+        sum += value;
+    }
+    std::cout << std::format(
+        "P(f = 1) for {} vectors in {:.3f} ms: min {:.10g}, mean {:.10g}, max {:.10g}\n",
+        result.size(), elapsed.count(), *min_it, sum / static_cast<double>(result.size()),
+        *max_it);
+
+    const std::string csv_filename = get_output_path(input_file, "_probability.csv").string();
+    std::ofstream csv(csv_filename);
+    if (!csv.is_open()) {
+        std::cerr << "Error: Could not create output file '" << csv_filename << "'\n";
+        return;
+    }
+    csv << "row,probability\n";
+    for (std::size_t r = 0; r < result.size(); ++r) {
+        csv << std::format("{},{:.17g}\n", r + 1, result[r]);
+    }
+    std::cout << "Probabilities saved to '" << csv_filename << "'\n";
+}
+
+/**
+ * @brief Checks equivalence or implication against a second expression file
+ *
+ * @param expr Left expression (the input file)
+ * @param other_file File holding the right expression
+ * @param relation Relation to check
+ * @param lazy_split Top variables to split on for the early-exit check (0 = build in full)
+ * @return 0 if the relation holds, 2 if it does not, 1 on error
+ */
+int run_relation_check(const my_expression& expr, const std::string& other_file,
+                       expression_relation relation, std::size_t lazy_split) {
+    my_expression_ptr other;
+    try {
+        other = read_expression_from_file(other_file);
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading expression file: " << e.what() << "\n";
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    relation_result result;
+    try {
+        result = lazy_split != 0 ? check_relation_lazy(expr, *other, relation, lazy_split)
+                                 : check_relation(expr, *other, relation);
+    } catch (const std::exception& e) {
+        std::cerr << "Error checking expressions: " << e.what() << "\n";
+        return 1;
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    const bool equivalence = relation == expression_relation::equivalent;
+    std::cout << std::format("Checked over {} variables ({} BDD pair{} built, {:.3f} ms)\n",
+                             result.variables.size(), result.cofactors,
+                             result.cofactors == 1 ? "" : "s", elapsed.count());
+    if (result.holds) {
+        std::cout << std::format("Yes: input {} '{}'\n",
+                                 equivalence ? "is equivalent to" : "implies", other_file);
+        return 0;
+    }
+    std::cout << std::format("No: input {} '{}'\n",
+                             equivalence ? "is not equivalent to" : "does not imply", other_file);
+    std::cout << std::format("Counterexample (input = {}, other = {}):\n",
+                             result.left_value ? 1 : 0, result.right_value ? 1 : 0);
+    for (std::size_t i = 0; i < result.variables.size(); ++i) {
+        std::cout << "  " << result.variables[i] << " = " << int{result.counterexample[i]} << "\n";
+    }
+    return 2;
+}
+
+/**
+ * @brief Converts the input on every save, reusing the BDDs of unchanged subtrees
+ *
+ * The manager and the subtree cache stay warm between saves; both are
+ * replaced when an edit changes the variable order. Runs until interrupted.
+ *
+ * @param input_file Expression file to watch
+ * @param cache_file Subtree cache to start from and keep up to date (empty for none)
+ * @return 1 if the file cannot be watched
+ */
+int run_watch(const std::filesystem::path& input_file, const std::string& cache_file) {
+    std::unique_ptr<file_watcher> watcher;
+    try {
+        watcher = std::make_unique<file_watcher>(input_file);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    // The cache holds diagrams of the manager, so it is declared after it
+    std::unique_ptr<teddy::bdd_manager> manager;
+    std::unique_ptr<incremental::subtree_cache> cache;
+    for (bool first = true;; first = false) {
+        try {
+            auto expr = read_expression_from_file(input_file.string());
+            std::unordered_set<std::string> names;
+            collect_variables_with_dag_walker(*expr, names);
+            auto order = ordered_variable_names(names);
+            const std::size_t expression_nodes = expression_size(*expr);
+
+            if (cache == nullptr || cache->variable_names() != order) {
+                if (cache != nullptr) {
+                    std::cout << "Variable order changed; starting with an empty cache\n";
+                }
+                cache.reset();
+                const manager_sizing sizing = size_managers(expression_nodes, order.size());
+                manager = std::make_unique<teddy::bdd_manager>(
+                    static_cast<int>(order.size()), sizing.teddy_pool, sizing.teddy_overflow);
+                cache = std::make_unique<incremental::subtree_cache>(*manager, std::move(order));
+                if (first && !cache_file.empty()) {
+                    std::cout << "Loaded " << cache->load(cache_file)
+                              << " cached subtrees from '" << cache_file << "'\n";
+                }
+            }
+
+            incremental::convert_stats stats;
+            const auto start = std::chrono::steady_clock::now();
+            auto f = cache->convert(*expr, &stats);
+            const std::chrono::duration<double, std::milli> elapsed =
+                std::chrono::steady_clock::now() - start;
+            std::cout << std::format(
+                "Compiled in {:.3f} ms: {} BDD nodes, {} subtrees reused ({} of {} expression "
+                "nodes), {} nodes rebuilt\n",
+                elapsed.count(), manager->get_node_count(f), stats.reused, stats.reused_nodes,
+                expression_nodes, stats.rebuilt);
+            if (!cache_file.empty()) {
+                cache->save(cache_file);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+        }
+        std::cout << "Watching " << input_file << " for changes (Ctrl+C to stop)..." << std::endl;
+        watcher->wait();
+    }
+}
+
+/**
+ * @brief Prints the size change and the rewrite counts of a simplification
+ */
+void report_simplification(const simplify_stats& stats) {
+    std::cout << std::format(
+        "Simplified expression: {} -> {} nodes ({} rewrites: {} constants, {} idempotence, {} "
+        "absorption, {} complements, {} double negations, {} XOR cancellations, {} De Morgan, "
+        "{} flattened)\n",
+        stats.nodes_before, stats.nodes_after, stats.rewrites(), stats.constants,
+        stats.idempotence, stats.absorption, stats.complements, stats.double_negations,
+        stats.xor_cancellations, stats.de_morgan, stats.flattened);
+}
+
+/**
+ * @brief Simplifies every definition and output of a program on its own and reports the total
+ */
+void simplify_program(my_program& program) {
+    simplify_stats stats;
+    for (auto* statements : {&program.definitions, &program.outputs}) {
+        for (auto& statement : *statements) {
+            statement.expr = simplify_expression(*statement.expr, &stats);
+        }
+    }
+    report_simplification(stats);
+}
+
+/**
+ * @brief Builds every output of a multi-output file in one manager
+ *
+ * Definitions are built once and shared by the outputs that use them. The
+ * outputs are written as one multi-root DOT graph and one node table.
+ *
+ * @param program Definitions and outputs of the input file
+ * @param input_file Input file, for the output file names
+ * @param use_cudd Build in a CUDD manager instead of TeDDy
+ * @param limits Node, memory and time limits for the whole build
+ * @param adaptive_sizing Size the manager from the program
+ * @param quiet_mode Do not print the node table
+ * @return 0 on success, 1 on error
+ */
+int run_multi_output(const my_program& program, const std::filesystem::path& input_file,
+                     bool use_cudd, const conversion_limits& limits, bool adaptive_sizing,
+                     bool quiet_mode) {
+    const auto variables = multi_output::program_variables(program);
+    std::cout << std::format("Multi-output file: {} definitions, {} outputs, {} variables\n",
+                             program.definitions.size(), program.outputs.size(),
+                             variables.size());
+    manager_sizing sizing;
+    if (adaptive_sizing) {
+        sizing = size_managers(multi_output::program_size(program), variables.size());
+    }
+
+    std::filesystem::path bdd_dot_filename = get_output_path(input_file, "_bdd.dot");
+    std::filesystem::path bdd_nodes_filename = get_output_path(input_file, "_bdd_nodes.txt");
+    std::ofstream dot_file(bdd_dot_filename);
+    std::ofstream nodes_file(bdd_nodes_filename);
+    if (!dot_file.is_open() || !nodes_file.is_open()) {
+        std::cerr << "Error: Could not create output files next to " << input_file << "\n";
+        return 1;
+    }
+
+    // Report per-output and shared sizes, then write the shared graph and table
+    auto report = [&](const auto& outputs, auto node_count, const auto& roots) {
+        std::size_t separate = 0;
+        for (const auto& [name, diagram] : outputs) {
+            const std::size_t nodes = node_count(diagram);
+            separate += nodes;
+            std::cout << std::format("  {}: {} nodes\n", name, nodes);
+        }
+        std::cout << std::format("Shared nodes: {} ({} if built separately)\n",
+                                 dag_walker::count_nodes_topological(roots), separate);
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        if (use_cudd) {
+            std::cout << "Converting outputs to BDDs in one CUDD manager...\n";
+            Cudd mgr(static_cast<unsigned int>(variables.size()), 0, sizing.cudd_unique_slots,
+                     sizing.cudd_cache_slots);
+            conversion_budget budget(limits);
+            const auto outputs = multi_output::build_cudd(program, mgr, variables, &budget);
+            std::vector<cudd_iterator> roots;
+            for (const auto& [name, bdd] : outputs) {
+                roots.emplace_back(mgr, bdd.getNode(), &variables);
+            }
+            report(
+                outputs,
+                [](const BDD& bdd) { return static_cast<std::size_t>(bdd.nodeCount()); }, roots);
+            write_cudd_outputs_to_dot(mgr, outputs, variables, dot_file);
+            write_cudd_outputs_nodes_to_stream(mgr, outputs, variables, nodes_file, false);
+            if (!quiet_mode) {
+                write_cudd_outputs_nodes_to_stream(mgr, outputs, variables, std::cout, true);
+            }
+        } else {
+            std::cout << "Converting outputs to BDDs in one TeDDy manager...\n";
+            teddy::bdd_manager mgr(static_cast<int>(variables.size()), sizing.teddy_pool,
+                                   sizing.teddy_overflow);
+            conversion_budget budget(limits, teddy_bytes_per_node);
+            const auto outputs = multi_output::build_teddy(program, mgr, variables, &budget);
+            std::vector<teddy_iterator> roots;
+            for (const auto& [name, diagram] : outputs) {
+                roots.emplace_back(diagram.unsafe_get_root(), &variables);
+            }
+            report(outputs,
+                   [&](const teddy::bdd_manager::diagram_t& diagram) {
+                       return static_cast<std::size_t>(mgr.get_node_count(diagram));
+                   },
+                   roots);
+            write_teddy_outputs_to_dot(mgr, outputs, variables, dot_file);
+            write_teddy_outputs_nodes_to_stream(mgr, outputs, variables, nodes_file, false);
+            if (!quiet_mode) {
+                write_teddy_outputs_nodes_to_stream(mgr, outputs, variables, std::cout, true);
+            }
+        }
+    } catch (const conversion_aborted& e) {
+        std::cerr << "Conversion aborted: " << e.what() << "\n";
+        std::cerr << "  while building: " << e.subexpression() << "\n";
+        std::cerr << std::format("  peak nodes: {}, time used: {:.3f} ms\n", e.peak_nodes(),
+                                 e.seconds() * 1e3);
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error converting expression: " << e.what() << "\n";
+        return 1;
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << std::format("Built {} outputs in {:.3f} ms\n", program.outputs.size(),
+                             elapsed.count());
+
+    std::cout << "Shared BDD DOT representation saved to '" << bdd_dot_filename.string() << "'\n";
+    std::cout << "Shared BDD node table saved to '" << bdd_nodes_filename.string() << "'\n";
+    std::cout << "\nDemo completed successfully!\n";
+    return 0;
+}
+
 }  // end anonymous namespace
 
 // ============================================================================
@@ -107,9 +590,42 @@ std::filesystem::path get_output_path(const std::filesystem::path& input_filepat
  * - `--force-reorder` : Force immediate reordering and reduce after BDD construction
  * - `--method=custom` : Use custom recursive conversion method (default)
  * - `--method=teddy` : Use TeDDy's from_expression_tree method
+ * - `--method=mdd` : Also build a multi-valued decision diagram over DOMAIN fields
+ * - `--method=cudd-zdd` : Also build a zero-suppressed decision diagram with CUDD
+ * - `--method=truthtable` : Build the BDD from a bit-parallel truth table (up to 20 variables)
+ * - `--method=native` : Use the built-in BDD package with complement edges
+ * - `--method=parallel` : Use the multi-threaded BDD package (output via a native copy)
+ * - `--method=partitioned` : Convert the top-level AND/OR operands in worker TeDDy managers
+ * - `--threads=<n>` : Worker threads for --method=parallel and --method=partitioned
+ *   (0 to 1024, default 0 = hardware concurrency)
+ * - `--method=conjunctive` : Keep the top-level conjuncts as separate CUDD BDDs, clustered
+ *   up to --cluster-size nodes, and check satisfiability on the partitions
+ * - `--cluster-size=<n>` : Node threshold for merging conjuncts (default 1000, 0 = never merge)
+ * - `--max-nodes=<n>` : Abort the conversion when the manager holds more than n nodes
+ * - `--max-memory=<bytes>[K|M|G]` : Abort the conversion above this much manager memory
+ * - `--timeout=<seconds>` : Abort the conversion after this much time
+ * - `--sizing=auto|fixed` : Size the TeDDy node pool and CUDD tables from the input (default)
+ *   or use the fixed defaults
+ * - `--pool-size=<n>`, `--cudd-slots=<n>`, `--cudd-cache=<n>` : Override one of those sizes
+ * - `--count` : Print the exact number of satisfying assignments
+ * - `--enumerate=<n>` : Print the first n satisfying assignments (as the set of true variables)
+ * - `--enumerate-cubes=<n>` : Print the first n cubes (paths to the one terminal)
+ * - `--probabilities=<file>` : Print P(f = 1) for the variable probabilities in this file,
+ *   with importance measures for a single vector
+ * - `--equiv=<file>` : Check that the input and the expression in file are equivalent
+ * - `--implies=<file>` : Check that the input implies the expression in file
+ * - `--lazy-check[=<k>]` : Check cofactor by cofactor over the top k variables (default 4),
+ *   stopping at the first that differs
+ * - `--cache=<file>` : Reuse the BDDs of unchanged subtrees saved in file by a previous run
+ *   (custom method), and save those of this run
+ * - `--watch` : Convert the input again every time it is saved, reusing the BDDs of
+ *   unchanged subtrees
+ * - `--sizing-profile=<file>` : Size from the peak recorded in this file by a previous run,
+ *   and record the peak of this run
  * - `--quiet` or `-q` : Suppress console output of BDD structure and DOT graph (default)
  * - `--verbose` or `-v` : Show detailed console output of BDD structure and DOT graph
  * - `--mermaid` or `-m` : Generate Mermaid format graphs for Markdown embedding
+ * - `--c-code` : Generate a self-contained C evaluator for the BDD
  * - `--help` or `-h` : Show help message
  *
  * Generated outputs (in same directory as input file):
@@ -118,6 +634,14 @@ std::filesystem::path get_output_path(const std::filesystem::path& input_filepat
  * - `*_bdd_nodes.txt` : Detailed table of BDD nodes and structure
  * - `*_expression_tree.md` : Mermaid graph of expression tree (with --mermaid)
  * - `*_bdd.md` : Mermaid graph of BDD structure (with --mermaid)
+ * - `*_mdd.dot`, `*_mdd_nodes.txt` : DOT graph and node table of the MDD (with --method=mdd)
+ * - `*_zdd.dot`, `*_zdd_nodes.txt` : DOT graph and node table of the ZDD (with --method=cudd-zdd)
+ * - `*_bdd.c` : C evaluator functions for the BDD (with --c-code)
+ * - `*_truth_table.c` : C lookup-table evaluator (with --method=truthtable)
+ * - `*_probability.csv` : P(f = 1) per vector (with a multi-vector --probabilities file)
+ *
+ * For a file with several outputs, `*_bdd.dot` and `*_bdd_nodes.txt` hold all of them
+ * with their shared nodes drawn once, and the other outputs are not written.
  *
  * The program automatically:
  * 1. Parses the input expression file
@@ -129,7 +653,7 @@ std::filesystem::path get_output_path(const std::filesystem::path& input_filepat
  *
  * @param argc Number of command line arguments
  * @param argv Array of command line argument strings
- * @return 0 on success, 1 on error
+ * @return 0 on success, 1 on error, 2 if an --equiv or --implies check fails
  *
  * @note Generated DOT files can be visualized using Graphviz tools:
  *       `dot -Tpng input.dot -o output.png`
@@ -141,12 +665,38 @@ int main(int argc, const char* argv[]) {
     enum class ConversionMethod {
         Custom,
         TeDDy,
-        CUDD
+        CUDD,
+        CUDDZDD,
+        MDD,
+        TruthTable,
+        Native,
+        Parallel,
+        Partitioned,
+        Conjunctive
     } conversion_method = ConversionMethod::Custom;
     bool quiet_mode = true;
     bool show_help = false;
     bool help_due_to_error = false;
     bool generate_mermaid = false;
+    bool generate_c_code = false;
+    unsigned parallel_threads = 0;
+    std::size_t cluster_size = conjunctive_partition::default_cluster_size;
+    conversion_limits limits;
+    bool adaptive_sizing = true;
+    std::int64_t pool_size_override = 0;
+    unsigned cudd_slots_override = 0;
+    unsigned cudd_cache_override = 0;
+    std::string sizing_profile;
+    bool count_requested = false;
+    std::size_t enumerate_limit = 0;
+    bool enumerate_cubes = false;
+    std::string probability_file;
+    std::string relation_file;
+    expression_relation relation = expression_relation::equivalent;
+    std::size_t lazy_split = 0;
+    std::string cache_file;
+    bool watch = false;
+    bool simplify = false;
 
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -164,12 +714,124 @@ int main(int argc, const char* argv[]) {
             conversion_method = ConversionMethod::TeDDy;
         } else if (arg == "--method=cudd") {
             conversion_method = ConversionMethod::CUDD;
+        } else if (arg == "--method=cudd-zdd") {
+            conversion_method = ConversionMethod::CUDDZDD;
+        } else if (arg == "--method=mdd") {
+            conversion_method = ConversionMethod::MDD;
+        } else if (arg == "--method=truthtable") {
+            conversion_method = ConversionMethod::TruthTable;
+        } else if (arg == "--method=native") {
+            conversion_method = ConversionMethod::Native;
+        } else if (arg == "--method=parallel") {
+            conversion_method = ConversionMethod::Parallel;
+        } else if (arg == "--method=partitioned") {
+            conversion_method = ConversionMethod::Partitioned;
+        } else if (arg == "--method=conjunctive") {
+            conversion_method = ConversionMethod::Conjunctive;
+        } else if (arg.starts_with("--cluster-size=")) {
+            try {
+                cluster_size = parse_count(arg.substr(15), 0);
+            } catch (const std::exception&) {
+                std::cerr << "Invalid cluster size: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        } else if (arg.starts_with("--threads=")) {
+            try {
+                parallel_threads =
+                    static_cast<unsigned>(parse_count(arg.substr(10), 0, max_threads));
+            } catch (const std::exception&) {
+                std::cerr << "Invalid thread count: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        } else if (arg.starts_with("--max-nodes=") || arg.starts_with("--max-memory=")
+                   || arg.starts_with("--timeout=")) {
+            try {
+                const std::string value = arg.substr(arg.find('=') + 1);
+                if (arg.starts_with("--max-nodes=")) {
+                    limits.max_nodes = parse_count(value);
+                } else if (arg.starts_with("--max-memory=")) {
+                    limits.max_memory = parse_byte_count(value);
+                } else {
+                    limits.timeout = parse_timeout(value);
+                }
+            } catch (const std::exception&) {
+                std::cerr << "Invalid limit: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        } else if (arg == "--sizing=auto") {
+            adaptive_sizing = true;
+        } else if (arg == "--sizing=fixed") {
+            adaptive_sizing = false;
+        } else if (arg.starts_with("--pool-size=") || arg.starts_with("--cudd-slots=")
+                   || arg.starts_with("--cudd-cache=")) {
+            try {
+                const std::string value = arg.substr(arg.find('=') + 1);
+                if (arg.starts_with("--pool-size=")) {
+                    pool_size_override = std::stoll(value);
+                } else if (arg.starts_with("--cudd-slots=")) {
+                    cudd_slots_override = static_cast<unsigned>(
+                        parse_count(value, 0, std::numeric_limits<unsigned>::max()));
+                } else {
+                    cudd_cache_override = static_cast<unsigned>(
+                        parse_count(value, 0, std::numeric_limits<unsigned>::max()));
+                }
+            } catch (const std::exception&) {
+                std::cerr << "Invalid manager size: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        } else if (arg == "--count") {
+            count_requested = true;
+        } else if (arg.starts_with("--enumerate=") || arg.starts_with("--enumerate-cubes=")) {
+            try {
+                enumerate_limit = parse_count(arg.substr(arg.find('=') + 1), 0);
+                enumerate_cubes = arg.starts_with("--enumerate-cubes=");
+            } catch (const std::exception&) {
+                std::cerr << "Invalid solution limit: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        } else if (arg.starts_with("--equiv=") || arg.starts_with("--implies=")) {
+            relation_file = arg.substr(arg.find('=') + 1);
+            relation = arg.starts_with("--equiv=") ? expression_relation::equivalent
+                                                   : expression_relation::implies;
+        } else if (arg == "--lazy-check") {
+            lazy_split = 4;
+        } else if (arg.starts_with("--lazy-check=")) {
+            try {
+                lazy_split = parse_count(arg.substr(13));
+            } catch (const std::exception&) {
+                std::cerr << "Invalid split variable count: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        } else if (arg.starts_with("--cache=")) {
+            cache_file = arg.substr(8);
+        } else if (arg == "--watch") {
+            watch = true;
+        } else if (arg == "--simplify") {
+            simplify = true;
+        } else if (arg.starts_with("--probabilities=")) {
+            probability_file = arg.substr(16);
+        } else if (arg.starts_with("--sizing-profile=")) {
+            sizing_profile = arg.substr(17);
         } else if (arg == "--quiet" || arg == "-q") {
             quiet_mode = true;
         } else if (arg == "--verbose" || arg == "-v") {
             quiet_mode = false;
         } else if (arg == "--mermaid" || arg == "-m") {
             generate_mermaid = true;
+        } else if (arg == "--c-code") {
+            generate_c_code = true;
         } else if (arg == "--help" || arg == "-h") {
             show_help = true;
             break;
@@ -204,17 +866,74 @@ int main(int argc, const char* argv[]) {
         std::cout << "  --method=custom       Use custom recursive conversion method (default)\n";
         std::cout << "  --method=teddy        Use TeDDy's from_expression_tree method\n";
         std::cout << "  --method=cudd         Use CUDD library for BDD conversion\n";
+        std::cout << "  --method=cudd-zdd     Also build a zero-suppressed diagram with CUDD and "
+                     "compare sizes\n";
+        std::cout << "  --method=mdd          Also build a multi-valued diagram with one variable "
+                     "per DOMAIN field\n";
+        std::cout << "  --method=truthtable   Build the BDD from a bit-parallel truth table "
+                     "(<= 20 variables)\n";
+        std::cout << "  --method=native       Use the built-in BDD package with complement edges\n";
+        std::cout << "  --method=parallel     Use the multi-threaded BDD package\n";
+        std::cout << "  --method=partitioned  Convert the top-level AND/OR operands on separate "
+                     "threads\n";
+        std::cout << "  --threads=<n>         Worker threads for --method=parallel and "
+                     "--method=partitioned\n";
+        std::cout << "                        (at most 1024, default: 0 = all cores)\n";
+        std::cout << "  --method=conjunctive  Keep the top-level conjuncts as separate CUDD BDDs "
+                     "and check\n";
+        std::cout << "                        satisfiability on them\n";
+        std::cout << "  --cluster-size=<n>    Merge conjuncts while they stay within n nodes "
+                     "(default 1000)\n";
+        std::cout << "  --max-nodes=<n>       Abort the conversion above n nodes in the manager\n";
+        std::cout << "  --max-memory=<size>   Abort the conversion above this much manager memory "
+                     "(e.g. 512M)\n";
+        std::cout << "  --timeout=<seconds>   Abort the conversion after this much time\n";
+        std::cout << "                        (limits apply to the custom, mdd, cudd, cudd-zdd and "
+                     "conjunctive methods)\n";
+        std::cout << "  --sizing=auto|fixed   Size the TeDDy pool and CUDD tables from the input "
+                     "(default)\n";
+        std::cout << "                        or use fixed defaults\n";
+        std::cout << "  --pool-size=<n>       Initial TeDDy node pool\n";
+        std::cout << "  --cudd-slots=<n>      Initial CUDD unique-table slots per variable\n";
+        std::cout << "  --cudd-cache=<n>      Initial CUDD cache slots\n";
+        std::cout << "  --count               Print the number of satisfying assignments\n";
+        std::cout << "  --enumerate=<n>       Print the first n satisfying assignments\n";
+        std::cout << "  --enumerate-cubes=<n> Print the first n cubes (paths to TRUE)\n";
+        std::cout << "  --equiv=<file>        Check that the input is equivalent to the "
+                     "expression in file\n";
+        std::cout << "  --implies=<file>      Check that the input implies the expression in "
+                     "file\n";
+        std::cout << "  --lazy-check[=<k>]    Check cofactors of the top k variables (default 4) "
+                     "one by one\n";
+        std::cout << "  --cache=<file>        Reuse BDDs of unchanged subtrees saved in file "
+                     "(custom method)\n";
+        std::cout << "  --watch               Convert again on every save of the input file\n";
+        std::cout << "  --simplify            Remove redundant operators (NOT NOT x, x AND x, "
+                     "x XOR x, ...) before\n";
+        std::cout << "                        conversion\n";
+        std::cout << "  --probabilities=<file>  Print P(f = 1) for the variable probabilities "
+                     "in file\n";
+        std::cout << "  --sizing-profile=<file>  Size from the peak of a previous run and record "
+                     "this one\n";
         std::cout << "  --quiet, -q           Suppress console output of BDD structure and DOT "
                      "graph (default)\n";
         std::cout << "  --verbose, -v         Show detailed console output of BDD structure and "
                      "DOT graph\n";
         std::cout
             << "  --mermaid, -m         Generate Mermaid format graphs for Markdown embedding\n";
+        std::cout << "  --c-code              Generate a C evaluator for the BDD (*_bdd.c)\n";
         std::cout << "  --help, -h            Show this help message\n\n";
         std::cout << "Example expression file format:\n";
         std::cout << "  # This is a comment\n";
         std::cout << "  (x0 AND x1) OR (NOT x2) XOR (x3 AND (NOT x4))\n\n";
-        std::cout << "Supported operators: AND, OR, XOR, NOT\n";
+        std::cout << "Supported operators: AND, OR, XOR, NOT; constants TRUE and FALSE\n";
+        std::cout << "Cardinality constraints: EXACTLY_ONE(a, b, ...), EXACTLY_K(k, a, b, ...),\n";
+        std::cout << "  AT_MOST_K(k, a, b, ...), AT_LEAST_K(k, a, b, ...)\n";
+        std::cout << "Field comparisons: port[16] == 443, ttl[8] < 64, proto[8] IN {6, 17},\n";
+        std::cout << "  port IN {0..1023}, src[32] == dst[32]\n";
+        std::cout << "Enumerated fields: DOMAIN color {red, green, blue} color IN {red, blue}\n";
+        std::cout << "Definitions and outputs: let web = port[16] IN {80, 443}; allow = web AND "
+                     "NOT blocked;\n";
         std::cout << "Use parentheses for grouping\n\n";
         std::cout << "Generated DOT files can be visualized using Graphviz tools:\n";
         std::cout << "  dot -Tpng input.dot -o output.png\n";
@@ -226,6 +945,10 @@ int main(int argc, const char* argv[]) {
         input_file = "test_expressions/filter_expression.txt";
     }
 
+    if (watch) {
+        return run_watch(input_file, cache_file);
+    }
+
     std::cout << "TeDDy BDD Demo - Building BDD from Filter Expression File\n";
     std::cout << "========================================================\n\n";
     std::cout << "Reading filter expression from: " << input_file << "\n";
@@ -253,29 +976,121 @@ int main(int argc, const char* argv[]) {
         }
     }
 
-    my_expression_ptr expr;
+    my_program program;
     try {
-        expr = read_expression_from_file(input_file.string());
+        program = read_program_from_file(input_file.string());
     } catch (const std::exception& e) {
         std::cerr << "Error reading expression file: " << e.what() << "\n";
         std::cerr << "\nExample expression file format:\n";
         std::cerr << "# This is a comment\n";
         std::cerr << "(x0 AND x1) OR (NOT x2) XOR (x3 AND (NOT x4))\n";
-        std::cerr << "\nSupported operators: AND, OR, XOR, NOT\n";
+        std::cerr << "\nSupported operators: AND, OR, XOR, NOT; constants TRUE and FALSE\n";
+        std::cerr << "Cardinality constraints: EXACTLY_ONE(a, b, ...), EXACTLY_K(k, a, b, ...),\n";
+        std::cerr << "  AT_MOST_K(k, a, b, ...), AT_LEAST_K(k, a, b, ...)\n";
+        std::cerr << "Field comparisons: port[16] == 443, ttl[8] < 64, proto[8] IN {6, 17},\n";
+        std::cerr << "  port IN {0..1023}, src[32] == dst[32]\n";
+        std::cerr << "Enumerated fields: DOMAIN color {red, green, blue} color IN {red, blue}\n";
+        std::cerr << "Definitions and outputs: let web = port[16] IN {80, 443}; allow = web AND "
+                     "NOT blocked;\n";
         std::cerr << "Use parentheses for grouping\n";
         return 1;
     }
 
-    // Dynamically determine the number of variables needed
+    // Files with several outputs are built together in one manager
+    if (program.outputs.size() > 1) {
+        if (!relation_file.empty()) {
+            std::cerr << "Error: --equiv and --implies need a file with a single output\n";
+            return 1;
+        }
+        const bool use_cudd = conversion_method == ConversionMethod::CUDD;
+        if (!use_cudd && conversion_method != ConversionMethod::Custom) {
+            std::cout << "Note: multi-output files are built with the custom or cudd method; "
+                         "using custom\n";
+        }
+        if (simplify) {
+            simplify_program(program);
+        }
+        return run_multi_output(program, input_file, use_cudd, limits, adaptive_sizing,
+                                quiet_mode);
+    }
+
+    // The custom and cudd methods build the definitions of a single output once, like those
+    // of a multi-output file, and the output refers to them. Inlining gives every reference
+    // its own copy of the body, which doubles at each level of a chain of definitions that
+    // use the previous one twice; the other methods and the relation checks need that tree
+    my_program shared;
+    my_expression_ptr expr;
+    if (!program.definitions.empty() && relation_file.empty() && cache_file.empty()
+        && (conversion_method == ConversionMethod::Custom
+            || conversion_method == ConversionMethod::CUDD)) {
+        if (simplify) {
+            simplify_program(program);
+        }
+        expr = std::move(program.outputs.front().expr);
+        shared.definitions = std::move(program.definitions);
+        std::cout << std::format("Definitions: {} built once and shared by the output\n",
+                                 shared.definitions.size());
+    } else {
+        expr = inline_definitions(std::move(program));
+        if (simplify) {
+            simplify_stats stats;
+            expr = simplify_expression(*expr, &stats);
+            report_simplification(stats);
+        }
+    }
+
+    // Compare with a second expression instead of converting, if requested
+    if (!relation_file.empty()) {
+        return run_relation_check(*expr, relation_file, relation, lazy_split);
+    }
+
+    // Dynamically determine the number of variables needed; definition names are not variables
     std::unordered_set<std::string> variable_names;
     collect_variables_with_dag_walker(*expr, variable_names);
+    for (const auto& definition : shared.definitions) {
+        collect_variables_with_dag_walker(*definition.expr, variable_names);
+    }
+    for (const auto& definition : shared.definitions) {
+        variable_names.erase(definition.name);
+    }
+
+    // Create ordered variable names for consistent ordering (same as in convert_to_bdd)
+    std::vector<std::string> sorted_variable_names = ordered_variable_names(variable_names);
 
-    // Create sorted variable names for consistent ordering (same as in convert_to_bdd)
-    std::vector<std::string> sorted_variable_names(variable_names.begin(), variable_names.end());
-    std::ranges::sort(sorted_variable_names);
+    // Size the managers for this input, then apply the overrides
+    std::size_t previous_peak = 0;
+    if (!sizing_profile.empty()) {
+        try {
+            previous_peak = read_sizing_profile(sizing_profile);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+    }
+    manager_sizing sizing;
+    if (adaptive_sizing) {
+        sizing = size_managers(expression_size(*expr) + multi_output::program_size(shared),
+                               variable_names.size(), previous_peak);
+    }
+    if (pool_size_override > 0) {
+        sizing.teddy_pool = pool_size_override;
+        sizing.teddy_overflow = std::max<std::int64_t>(pool_size_override / 2, 1);
+    }
+    if (cudd_slots_override > 0) {
+        sizing.cudd_unique_slots = cudd_slots_override;
+    }
+    if (cudd_cache_override > 0) {
+        sizing.cudd_cache_slots = cudd_cache_override;
+    }
+    std::cout << std::format(
+        "Manager sizing ({}): TeDDy pool {} nodes, CUDD {} unique slots per variable, {} cache "
+        "slots\n",
+        !adaptive_sizing ? "fixed" : previous_peak != 0 ? "from profile" : "estimated",
+        sizing.teddy_pool, sizing.cudd_unique_slots, sizing.cudd_cache_slots);
 
     // Create a BDD manager with the appropriate number of variables
-    teddy::bdd_manager manager(static_cast<int>(variable_names.size()), 1'000);
+    teddy::bdd_manager manager(static_cast<int>(variable_names.size()), sizing.teddy_pool,
+                               sizing.teddy_overflow);
 
     // Configure variable reordering based on command line options
     if (enable_auto_reordering) {
@@ -296,29 +1111,285 @@ int main(int argc, const char* argv[]) {
     std::unique_ptr<Cudd> cudd_mgr_ptr;
     BDD cudd_bdd;
     bool using_cudd = false;
+    ZDD cudd_zdd;
+    bool using_zdd = false;
+    std::unique_ptr<native_bdd::manager> native_mgr_ptr;
+    native_bdd::bdd native_root;
+    bool using_native = false;
+    mdd_variables mdd_vars;
+    std::unique_ptr<teddy::imdd_manager> mdd_mgr_ptr;
+    teddy::imdd_manager::diagram_t mdd;
+    bool using_mdd = false;
+    std::optional<truth_table::table> tt;
 
-    switch (conversion_method) {
-        case ConversionMethod::Custom:
-            std::cout << "Converting expression to BDD using custom recursive method...\n";
-            f = convert_to_bdd(*expr, manager);
-            break;
-        case ConversionMethod::TeDDy:
-            std::cout
-                << "Converting expression to BDD using TeDDy's from_expression_tree method...\n";
-            f = convert_to_bdd_with_teddy_adapter(*expr, manager);
-            break;
-        case ConversionMethod::CUDD:
-            std::cout << "Converting expression to BDD using CUDD library...\n";
-            std::tie(cudd_mgr_ptr, cudd_bdd) = convert_to_cudd_bdd(*expr, variable_names);
-            using_cudd = true;
-            std::cout << "CUDD BDD conversion completed successfully\n";
-            std::cout << "CUDD BDD node count: " << cudd_bdd.nodeCount() << "\n";
-            std::cout << "Note: CUDD BDDs are handled separately from TeDDy BDDs\n";
-            break;
+    // TeDDy is checked after every operation with an estimated node size;
+    // CUDD enforces the memory limit itself. Both budgets also record the peak
+    const bool limited = !limits.unlimited();
+    conversion_budget teddy_budget(limits, teddy_bytes_per_node);
+    conversion_budget cudd_budget(limits);
+    if (limited
+        && (conversion_method == ConversionMethod::TeDDy
+            || conversion_method == ConversionMethod::Native
+            || conversion_method == ConversionMethod::Parallel
+            || conversion_method == ConversionMethod::Partitioned)) {
+        std::cout << "Note: --max-nodes, --max-memory and --timeout are ignored by this method\n";
+    }
+
+    try {
+        switch (conversion_method) {
+            case ConversionMethod::Custom:
+                std::cout << "Converting expression to BDD using custom recursive method...\n";
+                if (!shared.definitions.empty()) {
+                    const auto defined = multi_output::build_teddy_definitions(
+                        shared, manager, sorted_variable_names, &teddy_budget);
+                    f = convert_to_bdd_with_map(
+                        *expr, manager,
+                        partitioned_convert_detail::variable_map(sorted_variable_names),
+                        &teddy_budget, &defined);
+                    break;
+                }
+                if (cache_file.empty()) {
+                    f = convert_to_bdd(*expr, manager, &teddy_budget);
+                    break;
+                }
+                {
+                    incremental::subtree_cache cache(manager, sorted_variable_names);
+                    const std::size_t loaded = cache.load(cache_file);
+                    incremental::convert_stats stats;
+                    f = cache.convert(*expr, &stats, &teddy_budget);
+                    std::cout << std::format(
+                        "Subtree cache: {} loaded, {} subtrees reused ({} expression nodes), {} "
+                        "nodes rebuilt, {} saved\n",
+                        loaded, stats.reused, stats.reused_nodes, stats.rebuilt, stats.cached);
+                    cache.save(cache_file);
+                }
+                break;
+            case ConversionMethod::TeDDy:
+                std::cout << "Converting expression to BDD using TeDDy's from_expression_tree "
+                             "method...\n";
+                f = convert_to_bdd_with_teddy_adapter(*expr, manager);
+                break;
+            case ConversionMethod::CUDD:
+                std::cout << "Converting expression to BDD using CUDD library...\n";
+                if (shared.definitions.empty()) {
+                    std::tie(cudd_mgr_ptr, cudd_bdd) =
+                        convert_to_cudd_bdd(*expr, variable_names, &cudd_budget, sizing);
+                } else {
+                    cudd_mgr_ptr = std::make_unique<Cudd>(0, 0, sizing.cudd_unique_slots,
+                                                          sizing.cudd_cache_slots);
+                    const auto defined = multi_output::build_cudd_definitions(
+                        shared, *cudd_mgr_ptr, sorted_variable_names, &cudd_budget);
+                    cudd_bdd = convert_to_cudd_bdd_with_map(
+                        *expr, *cudd_mgr_ptr,
+                        partitioned_convert_detail::variable_map(sorted_variable_names),
+                        &cudd_budget, nullptr, &defined);
+                }
+                using_cudd = true;
+                std::cout << "CUDD BDD conversion completed successfully\n";
+                std::cout << "CUDD BDD node count: " << cudd_bdd.nodeCount() << "\n";
+                std::cout << "Note: CUDD BDDs are handled separately from TeDDy BDDs\n";
+                break;
+            case ConversionMethod::CUDDZDD: {
+                std::cout << "Converting expression to ZDD using CUDD's ZDD operations...\n";
+                std::tie(cudd_mgr_ptr, cudd_zdd) =
+                    convert_to_cudd_zdd(*expr, variable_names, &cudd_budget, sizing);
+                using_zdd = true;
+
+                // The BDD is built in the same manager for the regular outputs and the comparison
+                std::unordered_map<std::string, int> var_map;
+                for (size_t i = 0; i < sorted_variable_names.size(); ++i) {
+                    var_map[sorted_variable_names[i]] = static_cast<int>(i);
+                }
+                cudd_bdd =
+                    convert_to_cudd_bdd_with_map(*expr, *cudd_mgr_ptr, var_map, &cudd_budget);
+                using_cudd = true;
+
+                const int zdd_nodes = Cudd_zddDagSize(cudd_zdd.getNode());
+                const int bdd_nodes = cudd_bdd.nodeCount();
+                std::cout << "ZDD node count: " << zdd_nodes << "\n";
+                std::cout << "BDD node count: " << bdd_nodes << "\n";
+                std::cout << std::format("ZDD/BDD node ratio: {:.2f}\n",
+                                         static_cast<double>(zdd_nodes)
+                                             / static_cast<double>(bdd_nodes));
+                std::cout << "ZDD sets: " << count_solutions(*cudd_mgr_ptr, cudd_zdd).to_string()
+                          << "\n";
+                break;
+            }
+            case ConversionMethod::MDD: {
+                std::cout << "Converting expression to MDD using TeDDy's imdd_manager...\n";
+                // The bit-blasted BDD is kept as the reference for size comparison
+                f = convert_to_bdd(*expr, manager, &teddy_budget);
+                mdd_vars = collect_mdd_variables(*expr);
+                mdd_mgr_ptr = std::make_unique<teddy::imdd_manager>(
+                    static_cast<int>(mdd_vars.names.size()), 1'000, mdd_vars.domains);
+                mdd = convert_to_mdd(*expr, *mdd_mgr_ptr, mdd_vars);
+                using_mdd = true;
+
+                auto mdd_nodes = mdd_mgr_ptr->get_node_count(mdd);
+                auto bdd_nodes = manager.get_node_count(f);
+                std::cout << "MDD variables: " << mdd_vars.names.size() << " (bit-blasted: "
+                          << variable_names.size() << ")\n";
+                std::cout << "MDD node count: " << mdd_nodes << "\n";
+                std::cout << "Bit-blasted BDD node count: " << bdd_nodes << "\n";
+                std::cout << std::format("MDD/BDD node ratio: {:.2f}\n",
+                                         static_cast<double>(mdd_nodes)
+                                             / static_cast<double>(bdd_nodes));
+                break;
+            }
+            case ConversionMethod::TruthTable:
+                if (variable_names.size() > truth_table::max_variables) {
+                    std::cout << "Expression has " << variable_names.size()
+                              << " variables, more than the truth table limit of "
+                              << truth_table::max_variables
+                              << "; using the custom recursive method\n";
+                    f = convert_to_bdd(*expr, manager, &teddy_budget);
+                    break;
+                }
+                std::cout << "Converting expression to BDD through a bit-parallel truth table...\n";
+                tt = truth_table::build(*expr, sorted_variable_names);
+                f = truth_table::to_teddy(*tt, manager);
+                std::cout << "Truth table rows: " << tt->rows() << " (" << tt->count_true()
+                          << " true)\n";
+                break;
+            case ConversionMethod::Native: {
+                std::cout << "Converting expression to BDD using the native BDD package...\n";
+                native_mgr_ptr = std::make_unique<native_bdd::manager>(
+                    static_cast<std::uint32_t>(variable_names.size()));
+                native_root = convert_to_native_bdd(*expr, *native_mgr_ptr);
+                using_native = true;
+                auto stats = native_mgr_ptr->get_statistics();
+                std::cout << "Native BDD node count: " << native_mgr_ptr->node_count(native_root)
+                          << " (peak " << stats.peak_nodes << ", " << stats.gc_runs
+                          << " collections)\n";
+                break;
+            }
+            case ConversionMethod::Parallel: {
+                std::cout << "Converting expression to BDD using the parallel BDD package...\n";
+                const auto n = static_cast<std::uint32_t>(variable_names.size());
+                parallel_bdd::manager_config config;
+                config.threads = parallel_threads;
+                parallel_bdd::manager parallel_mgr(n, config);
+                auto start = std::chrono::steady_clock::now();
+                auto root = convert_to_parallel_bdd(*expr, parallel_mgr);
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                auto stats = parallel_mgr.get_statistics();
+                std::cout << std::format(
+                    "Parallel BDD node count: {} ({} threads, {:.3f} ms, {} collections, "
+                    "{} steals)\n",
+                    parallel_mgr.node_count(root), parallel_mgr.thread_count(),
+                    elapsed.count() * 1e3, stats.gc_runs, stats.steals);
+
+                // The generators read the diagram from a native copy
+                native_mgr_ptr = std::make_unique<native_bdd::manager>(n);
+                native_root = copy_to_native(parallel_mgr, root, *native_mgr_ptr);
+                using_native = true;
+                break;
+            }
+            case ConversionMethod::Partitioned: {
+                std::cout << "Converting expression to BDD in partitions on worker threads...\n";
+                auto start = std::chrono::steady_clock::now();
+                f = convert_to_bdd_partitioned(*expr, manager, parallel_threads);
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                std::cout << std::format("Partitioned BDD node count: {} ({:.3f} ms)\n",
+                                         manager.get_node_count(f), elapsed.count() * 1e3);
+                break;
+            }
+            case ConversionMethod::Conjunctive: {
+                std::cout << "Converting the top-level conjuncts to separate CUDD BDDs...\n";
+                cudd_mgr_ptr = std::make_unique<Cudd>(0, 0, sizing.cudd_unique_slots,
+                                                      sizing.cudd_cache_slots);
+                const auto partition = conjunctive_partition::build(
+                    *expr, *cudd_mgr_ptr,
+                    partitioned_convert_detail::variable_map(sorted_variable_names),
+                    cluster_size, &cudd_budget);
+
+                const auto sizes = partition.part_sizes();
+                std::string listed;
+                for (std::size_t size : sizes) {
+                    listed += std::format(" {}", size);
+                }
+                const std::size_t largest = *std::max_element(sizes.begin(), sizes.end());
+                std::cout << std::format("Conjunctive partition: {} conjuncts in {} partitions "
+                                         "(cluster size {})\n",
+                                         partition.conjuncts(), sizes.size(), cluster_size);
+                std::cout << std::format("Partition node counts:{} (total {}, largest {})\n",
+                                         listed,
+                                         std::accumulate(sizes.begin(), sizes.end(),
+                                                         std::size_t{0}),
+                                         largest);
+
+                // Satisfiability is answered on the partitions before the monolithic BDD exists
+                conjunctive_partition::quantify_stats stats;
+                const bool satisfiable = partition.is_satisfiable(&stats);
+                std::cout << std::format(
+                    "Satisfiable: {} ({} of {} partitions conjoined, {} variables quantified "
+                    "early, peak {} nodes)\n",
+                    satisfiable ? "yes" : "no", stats.steps, sizes.size(), stats.quantified,
+                    stats.peak_nodes);
+
+                // The BDD files written below (DOT, node table, and the C code, counts and
+                // probabilities when requested) need the monolithic BDD. The limits apply to
+                // it as well; when they stop it, the answers above are the result of the run
+                try {
+                    cudd_bdd = partition.conjunction(&cudd_budget);
+                } catch (const conversion_aborted& e) {
+                    std::cout << std::format("monolithic: not built ({} while building the {}; "
+                                             "peak {} nodes, {:.3f} ms)\n",
+                                             e.what(), e.subexpression(), e.peak_nodes(),
+                                             e.seconds() * 1e3);
+                    return 0;
+                }
+                using_cudd = true;
+                std::cout << std::format("Monolithic BDD node count: {} ({:.2f}x the largest "
+                                         "partition)\n",
+                                         cudd_bdd.nodeCount(),
+                                         static_cast<double>(cudd_bdd.nodeCount())
+                                             / static_cast<double>(largest));
+                break;
+            }
+        }
+    } catch (const conversion_aborted& e) {
+        std::cerr << "Conversion aborted: " << e.what() << "\n";
+        std::cerr << "  while building: " << e.subexpression() << "\n";
+        std::cerr << std::format("  peak nodes: {}, time used: {:.3f} ms\n", e.peak_nodes(),
+                                 e.seconds() * 1e3);
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error converting expression: " << e.what() << "\n";
+        return 1;
+    }
+
+    // Report how the managers grew, so the sizing can be checked against the run
+    std::size_t observed_peak = 0;
+    if (using_cudd) {
+        observed_peak = static_cast<std::size_t>(cudd_mgr_ptr->ReadPeakNodeCount());
+        const double lookups = cudd_mgr_ptr->ReadCacheLookUps();
+        const double hit_rate = lookups > 0 ? 100.0 * cudd_mgr_ptr->ReadCacheHits() / lookups : 0.0;
+        std::cout << std::format(
+            "CUDD tables: {} unique slots, {} cache slots, {:.1f}% cache hits ({:.0f} lookups), "
+            "peak {} nodes, {} collections\n",
+            cudd_mgr_ptr->ReadSlots(), cudd_mgr_ptr->ReadCacheSlots(), hit_rate, lookups,
+            observed_peak, cudd_mgr_ptr->ReadGarbageCollections());
+    } else if (!using_native) {
+        // The budget sees the manager between operations; the final count covers the
+        // methods that do not report to it
+        observed_peak = std::max(teddy_budget.peak_nodes(),
+                                 static_cast<std::size_t>(manager.get_node_count()));
+        std::cout << std::format("TeDDy node pool: {} initial nodes, peak {} nodes, {} pool "
+                                 "growth events\n",
+                                 sizing.teddy_pool, observed_peak,
+                                 teddy_pool_growth(sizing, observed_peak));
+    }
+    if (!sizing_profile.empty() && observed_peak != 0) {
+        try {
+            write_sizing_profile(sizing_profile, observed_peak);
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: " << e.what() << "\n";
+        }
     }
 
     // Force variable reordering if requested (only for TeDDy)
-    if (force_reorder_after_build && !using_cudd) {
+    if (force_reorder_after_build && !using_cudd && !using_native) {
         std::cout << "Forcing variable reordering after BDD construction...\n";
         manager.force_reorder();
         std::cout << "Variable reordering completed\n";
@@ -329,11 +1400,47 @@ int main(int argc, const char* argv[]) {
         std::cout << "Reduce method completed successfully\n";
     } else if (force_reorder_after_build && using_cudd) {
         std::cout << "Variable reordering is not supported for CUDD in this implementation\n";
+    } else if (force_reorder_after_build && using_native) {
+        std::cout << "Variable reordering is not supported by the native BDD package\n";
     }
 
     std::cout << "Function created successfully!\n";
     std::cout << "Using " << variable_names.size() << " variables\n\n";
 
+    // Count and list solutions if requested
+    if (count_requested || enumerate_limit > 0) {
+        if (using_cudd) {
+            report_solutions(cudd_view(cudd_mgr_ptr.get(), cudd_bdd.getNode()),
+                             sorted_variable_names, count_requested, enumerate_limit,
+                             enumerate_cubes);
+        } else if (using_native) {
+            report_solutions(native_view(native_mgr_ptr.get(), native_root.get_edge()),
+                             sorted_variable_names, count_requested, enumerate_limit,
+                             enumerate_cubes);
+        } else {
+            report_solutions(teddy_view(&manager, f), sorted_variable_names, count_requested,
+                             enumerate_limit, enumerate_cubes);
+        }
+        std::cout << "\n";
+    }
+
+    // Propagate variable probabilities if requested
+    if (!probability_file.empty()) {
+        try {
+            const auto table =
+                reliability::read_probability_file(probability_file, sorted_variable_names);
+            const auto d =
+                using_cudd     ? reliability::compile_cudd(cudd_bdd, sorted_variable_names.size())
+                : using_native ? reliability::compile_native(*native_mgr_ptr, native_root)
+                               : reliability::compile_teddy(f, sorted_variable_names.size());
+            report_reliability(d, sorted_variable_names, table, input_file, parallel_threads);
+        } catch (const std::exception& e) {
+            std::cerr << "Error computing probabilities: " << e.what() << "\n";
+            return 1;
+        }
+        std::cout << "\n";
+    }
+
     // Handle CUDD-specific output
     if (using_cudd) {
         std::cout << "\n=== CUDD BDD Analysis ===\n";
@@ -393,12 +1500,25 @@ int main(int argc, const char* argv[]) {
             if (using_cudd) {
                 write_cudd_to_mermaid(*cudd_mgr_ptr, cudd_bdd, sorted_variable_names,
                                       combined_file);  // No title
+            } else if (using_native) {
+                write_native_to_mermaid(*native_mgr_ptr, native_root, sorted_variable_names,
+                                        combined_file);  // No title
             } else {
                 write_teddy_to_mermaid(manager, f, sorted_variable_names,
                                        combined_file);  // No title
             }
             combined_file << "```\n\n";
 
+            if (using_zdd) {
+                combined_file << "## Zero-suppressed Decision Diagram (ZDD)\n\n";
+                combined_file << "The same function as a ZDD; edge labels name the variables "
+                                 "an edge skips, which are 0 on that edge:\n\n";
+                combined_file << "```mermaid\n";
+                write_cudd_zdd_to_mermaid(*cudd_mgr_ptr, cudd_zdd, sorted_variable_names,
+                                          combined_file);
+                combined_file << "```\n\n";
+            }
+
             combined_file << "## Analysis Summary\n\n";
             combined_file << "- **Variables**: " << sorted_variable_names.size() << "\n";
 
@@ -407,6 +1527,10 @@ int main(int argc, const char* argv[]) {
             if (using_cudd) {
                 cudd_iterator root_iter(*cudd_mgr_ptr, cudd_bdd.getNode(), &sorted_variable_names);
                 node_count = dag_walker::count_nodes_topological(root_iter);
+            } else if (using_native) {
+                native_iterator root_iter(*native_mgr_ptr, native_root.get_edge(),
+                                          &sorted_variable_names);
+                node_count = dag_walker::count_nodes_topological(root_iter);
             } else {
                 // Use teddy_iterator with dag_walker count helper to avoid allocating vectors
                 teddy_iterator root_iter(f.unsafe_get_root(), &sorted_variable_names);
@@ -422,6 +1546,9 @@ int main(int argc, const char* argv[]) {
             if (using_cudd) {
                 write_cudd_nodes_to_markdown(*cudd_mgr_ptr, cudd_bdd, sorted_variable_names,
                                              combined_file);
+            } else if (using_native) {
+                write_native_nodes_to_markdown(*native_mgr_ptr, native_root, sorted_variable_names,
+                                               combined_file);
             } else {
                 write_teddy_nodes_to_markdown(manager, f, sorted_variable_names, combined_file);
             }
@@ -446,6 +1573,9 @@ int main(int argc, const char* argv[]) {
         if (using_cudd) {
             write_cudd_nodes_to_stream(*cudd_mgr_ptr, cudd_bdd, sorted_variable_names, std::cout,
                                        true);
+        } else if (using_native) {
+            write_native_nodes_to_stream(*native_mgr_ptr, native_root, sorted_variable_names,
+                                         std::cout, true);
         } else {
             write_teddy_nodes_to_stream(manager, f, sorted_variable_names, std::cout, true);
         }
@@ -456,6 +1586,8 @@ int main(int argc, const char* argv[]) {
         std::cout << "==============================\n";
         if (using_cudd) {
             write_cudd_to_dot(*cudd_mgr_ptr, cudd_bdd, sorted_variable_names, std::cout, "DD");
+        } else if (using_native) {
+            write_native_to_dot(*native_mgr_ptr, native_root, sorted_variable_names, std::cout);
         } else {
             write_teddy_to_dot(manager, f, sorted_variable_names, std::cout);
         }
@@ -467,6 +1599,8 @@ int main(int argc, const char* argv[]) {
     if (dot_file.is_open()) {
         if (using_cudd) {
             write_cudd_to_dot(*cudd_mgr_ptr, cudd_bdd, sorted_variable_names, dot_file, "DD");
+        } else if (using_native) {
+            write_native_to_dot(*native_mgr_ptr, native_root, sorted_variable_names, dot_file);
         } else {
             write_teddy_to_dot(manager, f, sorted_variable_names, dot_file);
         }
@@ -485,6 +1619,9 @@ int main(int argc, const char* argv[]) {
         if (using_cudd) {
             write_cudd_nodes_to_stream(*cudd_mgr_ptr, cudd_bdd, sorted_variable_names, nodes_file,
                                        false);
+        } else if (using_native) {
+            write_native_nodes_to_stream(*native_mgr_ptr, native_root, sorted_variable_names,
+                                         nodes_file, false);
         } else {
             write_teddy_nodes_to_stream(manager, f, sorted_variable_names, nodes_file, false);
         }
@@ -495,6 +1632,92 @@ int main(int argc, const char* argv[]) {
         return 1;
     }
 
+    // Output C evaluator if requested
+    if (generate_c_code) {
+        std::filesystem::path c_filename = get_output_path(input_file, "_bdd.c");
+        std::ofstream c_file(c_filename);
+        if (!c_file.is_open()) {
+            std::cerr << "Error: Could not create output file '" << c_filename << "'\n";
+            return 1;
+        }
+        if (using_cudd) {
+            write_cudd_to_c(*cudd_mgr_ptr, cudd_bdd, sorted_variable_names, c_file);
+        } else if (using_native) {
+            write_native_to_c(*native_mgr_ptr, native_root, sorted_variable_names, c_file);
+        } else {
+            write_teddy_to_c(manager, f, sorted_variable_names, c_file);
+        }
+        c_file.close();
+        std::cout << "BDD C evaluator saved to '" << c_filename << "'\n";
+    }
+
+    // Output the truth table lookup evaluator when one was built
+    if (tt) {
+        std::filesystem::path tt_filename = get_output_path(input_file, "_truth_table.c");
+        std::ofstream tt_file(tt_filename);
+        if (!tt_file.is_open()) {
+            std::cerr << "Error: Could not create output file '" << tt_filename << "'\n";
+            return 1;
+        }
+        truth_table::write_c_lookup(*tt, sorted_variable_names, tt_file);
+        tt_file.close();
+        std::cout << "Truth table C lookup saved to '" << tt_filename << "'\n";
+    }
+
+    if (using_zdd) {
+        if (!quiet_mode) {
+            std::cout << "\nZDD Node Structure:\n";
+            std::cout << "==================\n";
+            write_cudd_zdd_nodes_to_stream(*cudd_mgr_ptr, cudd_zdd, sorted_variable_names,
+                                           std::cout, true);
+        }
+
+        std::filesystem::path zdd_dot_filename = get_output_path(input_file, "_zdd.dot");
+        std::ofstream zdd_dot_file(zdd_dot_filename);
+        if (!zdd_dot_file.is_open()) {
+            std::cerr << "Error: Could not create output file '" << zdd_dot_filename << "'\n";
+            return 1;
+        }
+        write_cudd_zdd_to_dot(*cudd_mgr_ptr, cudd_zdd, sorted_variable_names, zdd_dot_file);
+        std::cout << "ZDD DOT representation saved to '" << zdd_dot_filename << "'\n";
+
+        std::filesystem::path zdd_nodes_filename = get_output_path(input_file, "_zdd_nodes.txt");
+        std::ofstream zdd_nodes_file(zdd_nodes_filename);
+        if (!zdd_nodes_file.is_open()) {
+            std::cerr << "Error: Could not create output file '" << zdd_nodes_filename << "'\n";
+            return 1;
+        }
+        write_cudd_zdd_nodes_to_stream(*cudd_mgr_ptr, cudd_zdd, sorted_variable_names,
+                                       zdd_nodes_file, false);
+        std::cout << "ZDD node table saved to '" << zdd_nodes_filename << "'\n";
+    }
+
+    if (using_mdd) {
+        if (!quiet_mode) {
+            std::cout << "\nMDD Node Structure:\n";
+            std::cout << "==================\n";
+            write_teddy_mdd_nodes_to_stream(mdd, mdd_vars, std::cout, true);
+        }
+
+        std::filesystem::path mdd_dot_filename = get_output_path(input_file, "_mdd.dot");
+        std::ofstream mdd_dot_file(mdd_dot_filename);
+        if (!mdd_dot_file.is_open()) {
+            std::cerr << "Error: Could not create output file '" << mdd_dot_filename << "'\n";
+            return 1;
+        }
+        write_teddy_mdd_to_dot(mdd, mdd_vars, mdd_dot_file);
+        std::cout << "MDD DOT representation saved to '" << mdd_dot_filename << "'\n";
+
+        std::filesystem::path mdd_nodes_filename = get_output_path(input_file, "_mdd_nodes.txt");
+        std::ofstream mdd_nodes_file(mdd_nodes_filename);
+        if (!mdd_nodes_file.is_open()) {
+            std::cerr << "Error: Could not create output file '" << mdd_nodes_filename << "'\n";
+            return 1;
+        }
+        write_teddy_mdd_nodes_to_stream(mdd, mdd_vars, mdd_nodes_file, false);
+        std::cout << "MDD node table saved to '" << mdd_nodes_filename << "'\n";
+    }
+
     std::cout << "\nDemo completed successfully!\n";
     return 0;
 }
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file native_graph.cpp
+ * @brief Native BDD graph generation using generic template systems implementation
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "native_graph.hpp"
+
+#include <iostream>
+
+#include "c_code_generator.hpp"
+#include "dot_graph_generator.hpp"
+#include "mermaid_graph_generator.hpp"
+#include "native_iterator.hpp"
+#include "node_table_generator.hpp"
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+void write_native_to_dot(const native_bdd::manager& manager, const native_bdd::bdd& f,
+                         const std::vector<std::string>& variable_names, std::ostream& out,
+                         const std::string& graph_name) {
+    native_iterator root_iter(manager, f.get_edge(), &variable_names);
+
+    // Same BDD-specific format as the TeDDy and CUDD writers
+    dot_graph::DotConfig config;
+    config.graph_name = graph_name;
+    config.rankdir = "";
+    config.font_name = "";
+    config.default_node_shape = "";
+    config.default_node_style = "";
+    config.default_edge_style = "";
+    config.use_bdd_format = true;
+
+    dot_graph::generate_dot_graph(root_iter, out, config);
+}
+
+void write_native_to_mermaid(const native_bdd::manager& manager, const native_bdd::bdd& f,
+                             const std::vector<std::string>& variable_names, std::ostream& out,
+                             const std::string& graph_title) {
+    native_iterator root_iter(manager, f.get_edge(), &variable_names);
+
+    mermaid_graph::MermaidConfig config;
+    config.graph_title = graph_title;
+    config.direction = "TD";
+    config.default_node_shape = "";
+    config.show_frontmatter = true;
+    config.show_css_classes = true;
+    config.node_id_prefix = "N";
+    config.node_id_start = 0;
+    config.class_definitions.push_back(
+        {"bddVariable", "fill:lightblue,stroke:#333,stroke-width:2px,color:#000"});
+    config.class_definitions.push_back(
+        {"terminal", "fill:lightgray,stroke:#333,stroke-width:2px,color:#000"});
+
+    mermaid_graph::generate_mermaid_graph(root_iter, out, config);
+}
+
+void write_native_nodes_to_stream(const native_bdd::manager& manager, const native_bdd::bdd& f,
+                                  const std::vector<std::string>& variable_names,
+                                  std::ostream& out, bool include_headers) {
+    native_iterator root_iter(manager, f.get_edge(), &variable_names);
+    node_table::TextTableConfig config(include_headers,
+                                       "Native BDD Node Table (topological ordering)");
+    node_table::generate_text_table(root_iter, out, config);
+}
+
+void write_native_nodes_to_markdown(const native_bdd::manager& manager, const native_bdd::bdd& f,
+                                    const std::vector<std::string>& variable_names,
+                                    std::ostream& out) {
+    native_iterator root_iter(manager, f.get_edge(), &variable_names);
+    node_table::generate_markdown_table(root_iter, out);
+}
+
+void write_native_to_c(const native_bdd::manager& manager, const native_bdd::bdd& f,
+                       const std::vector<std::string>& variable_names, std::ostream& out,
+                       const c_code::CCodeConfig& config) {
+    native_iterator root_iter(manager, f.get_edge(), &variable_names);
+    c_code::generate_c_code(root_iter, variable_names, out, config);
+}
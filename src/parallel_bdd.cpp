@@ -0,0 +1,912 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file parallel_bdd.cpp
+ * @brief Multi-threaded BDD package implementation
+ *
+ * Implements the lock-free unique table and computed cache, the Chase-Lev
+ * work-stealing scheduler, task-parallel ITE and the parallel garbage
+ * collector behind parallel_bdd::manager.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "parallel_bdd.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using native_bdd::edge;
+using native_bdd::is_constant;
+using native_bdd::negate;
+using native_bdd::node_index;
+using native_bdd::one_edge;
+using native_bdd::terminal_var;
+using native_bdd::zero_edge;
+
+/// Result of an operation abandoned because the node table ran out of slots
+constexpr edge abandoned_edge = std::numeric_limits<edge>::max();
+
+/// Largest node capacity; keeps every real edge below abandoned_edge
+constexpr std::size_t max_capacity = std::size_t{1} << 30;
+
+/// Node slots a worker claims from the shared free list at a time
+constexpr std::size_t slot_chunk = 64;
+
+/// Pending tasks per worker; a spawn that does not fit runs inline
+constexpr std::size_t deque_capacity = std::size_t{1} << 12;
+
+/// Items claimed at a time by the parallel loops of the collector
+constexpr std::size_t gc_chunk = std::size_t{1} << 12;
+
+/// How long an idle worker spins before it sleeps until the next job
+constexpr auto idle_spin = std::chrono::microseconds(200);
+
+/**
+ * @brief Node record; published to other workers through its table bucket
+ */
+struct node_record {
+    std::uint32_t var;
+    edge low;
+    edge high;
+};
+
+/**
+ * @brief Computed cache entry guarded by a sequence counter
+ *
+ * The counter is odd while a writer updates the entry. Readers retry nothing:
+ * an entry that changes under them is a miss.
+ */
+struct cache_entry {
+    std::atomic<std::uint32_t> version{0};
+    std::atomic<edge> f{native_bdd::free_var};
+    std::atomic<edge> g{0};
+    std::atomic<edge> h{0};
+    std::atomic<edge> result{0};
+};
+
+/**
+ * @brief ITE sub-problem spawned for the else-branch
+ *
+ * Lives on the stack of the worker that spawned it until it is done.
+ */
+struct task {
+    edge f;
+    edge g;
+    edge h;
+    unsigned depth;
+    edge result = 0;
+    std::atomic<int> thief{-1};  ///< Worker executing a stolen task
+    std::atomic<bool> done{false};
+};
+
+/**
+ * @brief Chase-Lev work-stealing deque with a fixed capacity
+ *
+ * The owner pushes and pops at the bottom; thieves take the oldest task from
+ * the top. Memory orders follow Le et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ */
+class task_deque {
+   public:
+    explicit task_deque(std::size_t capacity)
+        : buffer_(capacity), mask_(static_cast<std::int64_t>(capacity) - 1) {}
+
+    /// Owner only; false if the deque is full
+    bool push(task* t) {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        if (b - top > mask_) {
+            return false;
+        }
+        buffer_[b & mask_].store(t, std::memory_order_relaxed);
+        // Release store rather than a fence, so a thief also sees the task's fields
+        bottom_.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Owner only; nullptr if the newest task was stolen
+    task* pop() {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_relaxed);
+        if (top > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        task* t = buffer_[b & mask_].load(std::memory_order_relaxed);
+        if (top == b) {
+            // Last task: race against thieves for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                t = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return t;
+    }
+
+    /// Any thread; nullptr if empty or another thief won
+    task* steal() {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom_.load(std::memory_order_acquire);
+        if (top >= b) {
+            return nullptr;
+        }
+        task* t = buffer_[top & mask_].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return t;
+    }
+
+   private:
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    std::vector<std::atomic<task*>> buffer_;
+    std::int64_t mask_;
+};
+
+/**
+ * @brief Frame of the sequential ITE below the spawn depth (as in native_bdd)
+ */
+struct ite_frame {
+    edge f, g, h;
+    std::uint32_t var;
+    edge low;
+    bool negate_result;
+    std::uint8_t stage;  ///< 0 = new, 1 = waiting for low, 2 = waiting for high
+};
+
+/**
+ * @brief Per-thread state; only its own thread touches it during a job
+ */
+struct worker {
+    explicit worker(unsigned worker_id) : id(worker_id), rng(worker_id + 1) {}
+
+    unsigned id;
+    task_deque deque{deque_capacity};
+    std::vector<ite_frame> stack;
+    std::vector<std::uint32_t> mark_stack;
+    std::size_t next_slot = 0;  ///< Next claimed position in the free list
+    std::size_t end_slot = 0;   ///< End of the claimed range
+    std::uint32_t spare = 0;    ///< Filled slot whose node another worker inserted first
+    std::minstd_rand rng;
+    std::size_t steals = 0;
+    std::size_t cache_lookups = 0;
+    std::size_t cache_hits = 0;
+};
+
+/// Spins briefly, yielding the processor now and then
+void relax(unsigned& spins) {
+    if (++spins % 64 == 0) {
+        std::this_thread::yield();
+    }
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (parallel_bdd namespace)
+// ============================================================================
+
+namespace parallel_bdd {
+
+/**
+ * @brief Shared state of a manager and its workers
+ */
+struct manager::engine {
+    engine(std::uint32_t variables, const manager_config& cfg)
+        : variable_count(variables), config(cfg) {
+        if (variables >= terminal_var) {
+            throw std::runtime_error("Too many variables for a parallel BDD manager");
+        }
+        thread_count = config.threads != 0 ? config.threads
+                                           : std::max(1u, std::thread::hardware_concurrency());
+        if (config.spawn_depth != 0) {
+            spawn_depth = config.spawn_depth;
+        } else if (thread_count > 1) {
+            // Enough tasks near the root to keep every worker busy
+            spawn_depth = static_cast<unsigned>(std::bit_width(thread_count)) + 10;
+        }
+
+        capacity = std::bit_ceil(
+            std::clamp<std::size_t>(config.initial_nodes, std::size_t{64}, max_capacity));
+        nodes = std::make_unique<node_record[]>(capacity);
+        nodes[0] = node_record{terminal_var, one_edge, one_edge};
+        refs.assign(capacity, 0);
+        allocate_table();
+        free_slots.reserve(capacity - 1);
+        for (std::uint32_t i = 1; i < capacity; ++i) {
+            free_slots.push_back(i);
+        }
+        resize_cache(config.cache_entries);
+
+        for (unsigned i = 0; i < thread_count; ++i) {
+            workers.push_back(std::make_unique<worker>(i));
+        }
+        for (unsigned i = 1; i < thread_count; ++i) {
+            threads.emplace_back([this, i] { worker_main(*workers[i]); });
+        }
+    }
+
+    ~engine() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+            epoch.fetch_add(1, std::memory_order_release);
+        }
+        wake.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Dispatch
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Runs @p work on every worker, the calling thread acting as worker 0
+     *
+     * Returns once all workers have finished it.
+     */
+    void run_on_all(const std::function<void(worker&)>& work) {
+        if (threads.empty()) {
+            work(*workers[0]);
+            return;
+        }
+        job = &work;
+        busy.store(static_cast<unsigned>(threads.size()), std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            epoch.fetch_add(1, std::memory_order_release);
+        }
+        wake.notify_all();
+        work(*workers[0]);
+        unsigned spins = 0;
+        while (busy.load(std::memory_order_acquire) != 0) {
+            relax(spins);
+        }
+        job = nullptr;
+    }
+
+    void worker_main(worker& w) {
+        std::uint64_t seen = 0;
+        while (true) {
+            // Spin for a while so back-to-back operations avoid a wake-up
+            std::uint64_t current = epoch.load(std::memory_order_acquire);
+            const auto deadline = std::chrono::steady_clock::now() + idle_spin;
+            unsigned spins = 0;
+            while (current == seen) {
+                relax(spins);
+                if (spins % 256 == 0 && std::chrono::steady_clock::now() > deadline) {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [&] {
+                        return epoch.load(std::memory_order_acquire) != seen;
+                    });
+                }
+                current = epoch.load(std::memory_order_acquire);
+            }
+            seen = current;
+            if (stop) {
+                return;
+            }
+            (*job)(w);
+            busy.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Runs @p fn over [0, count) in chunks claimed by all workers
+     */
+    void parallel_for(std::size_t count,
+                      const std::function<void(worker&, std::size_t, std::size_t)>& fn) {
+        std::atomic<std::size_t> cursor{0};
+        run_on_all([&](worker& w) {
+            while (true) {
+                const std::size_t begin = cursor.fetch_add(gc_chunk, std::memory_order_relaxed);
+                if (begin >= count) {
+                    return;
+                }
+                fn(w, begin, std::min(count, begin + gc_chunk));
+            }
+        });
+    }
+
+    /**
+     * @brief Runs a top-level operation, restarting it if the table fills up
+     *
+     * @param op Computes the result on the given worker; returns abandoned_edge
+     *        if it ran out of node slots
+     * @param parallel Whether the other workers steal from this operation
+     */
+    edge run_operation(const std::function<edge(worker&)>& op, bool parallel) {
+        maybe_collect();
+        while (true) {
+            abandoned.store(false, std::memory_order_relaxed);
+            edge result = abandoned_edge;
+            if (!parallel || threads.empty()) {
+                result = op(*workers[0]);
+            } else {
+                op_done.store(false, std::memory_order_relaxed);
+                run_on_all([&](worker& w) {
+                    if (w.id != 0) {
+                        help_until_done(w);
+                        return;
+                    }
+                    result = op(w);
+                    op_done.store(true, std::memory_order_release);
+                });
+            }
+            if (result != abandoned_edge) {
+                return result;
+            }
+            ++restarts;
+            collect(true);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Work stealing
+    // ------------------------------------------------------------------------
+
+    void help_until_done(worker& w) {
+        std::uniform_int_distribution<unsigned> pick(0, thread_count - 2);
+        unsigned spins = 0;
+        while (!op_done.load(std::memory_order_acquire)) {
+            unsigned victim = pick(w.rng);
+            victim += victim >= w.id ? 1 : 0;
+            if (task* t = workers[victim]->deque.steal()) {
+                run_stolen(w, *t);
+                spins = 0;
+            } else {
+                relax(spins);
+            }
+        }
+    }
+
+    void run_stolen(worker& w, task& t) {
+        t.thief.store(static_cast<int>(w.id), std::memory_order_release);
+        ++w.steals;
+        t.result = ite_parallel(w, t.f, t.g, t.h, t.depth);
+        t.done.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Waits for a spawned task, running it inline if nobody stole it
+     *
+     * While a thief runs the task, the owner steals back from the thief
+     * (leapfrogging), which only ever picks up pieces of its own task.
+     */
+    edge sync(worker& w, task& t) {
+        if (w.deque.pop() != nullptr) {
+            return ite_parallel(w, t.f, t.g, t.h, t.depth);
+        }
+        unsigned spins = 0;
+        while (!t.done.load(std::memory_order_acquire)) {
+            const int thief = t.thief.load(std::memory_order_acquire);
+            if (thief >= 0) {
+                if (task* s = workers[static_cast<unsigned>(thief)]->deque.steal()) {
+                    run_stolen(w, *s);
+                    continue;
+                }
+            }
+            relax(spins);
+        }
+        return t.result;
+    }
+
+    // ------------------------------------------------------------------------
+    // Unique table
+    // ------------------------------------------------------------------------
+
+    void allocate_table() {
+        table_size = 2 * capacity;
+        table = std::make_unique<std::atomic<std::uint32_t>[]>(table_size);
+    }
+
+    /// Claims an empty node slot; 0 (and an abandoned operation) if none is left
+    std::uint32_t claim_slot(worker& w) {
+        if (w.spare != 0) {
+            return std::exchange(w.spare, 0);
+        }
+        if (w.next_slot == w.end_slot) {
+            const std::size_t begin = slot_cursor.fetch_add(slot_chunk, std::memory_order_relaxed);
+            if (begin >= free_slots.size()) {
+                abandoned.store(true, std::memory_order_relaxed);
+                return 0;
+            }
+            w.next_slot = begin;
+            w.end_slot = std::min(begin + slot_chunk, free_slots.size());
+        }
+        return free_slots[w.next_slot++];
+    }
+
+    /**
+     * @brief Finds or creates the node (var, low, high) in canonical form
+     *
+     * A new node is written to a private slot first and then published by a
+     * compare-and-swap on an empty bucket. If another worker publishes into
+     * that bucket first, its node is compared like any other and the slot is
+     * kept for the next insertion.
+     */
+    edge make_node(worker& w, std::uint32_t var, edge low, edge high) {
+        if (low == high) {
+            return low;
+        }
+        const edge flip = high & 1;
+        low ^= flip;
+        high ^= flip;
+
+        const std::size_t mask = table_size - 1;
+        std::size_t slot = native_bdd::hash_triple(var, low, high) & mask;
+        while (true) {
+            std::uint32_t index = table[slot].load(std::memory_order_acquire);
+            if (index == 0) {
+                const std::uint32_t fresh = claim_slot(w);
+                if (fresh == 0) {
+                    return abandoned_edge;
+                }
+                nodes[fresh] = node_record{var, low, high};
+                if (table[slot].compare_exchange_strong(index, fresh, std::memory_order_release,
+                                                        std::memory_order_acquire)) {
+                    return (fresh << 1) | flip;
+                }
+                w.spare = fresh;
+            }
+            const node_record& n = nodes[index];
+            if (n.var == var && n.low == low && n.high == high) {
+                return (index << 1) | flip;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Computed cache
+    // ------------------------------------------------------------------------
+
+    void resize_cache(std::size_t entries) {
+        cache_size = std::bit_ceil(std::max<std::size_t>(entries, 2));
+        cache = std::make_unique<cache_entry[]>(cache_size);
+    }
+
+    bool cache_lookup(worker& w, edge f, edge g, edge h, edge& result) {
+        ++w.cache_lookups;
+        cache_entry& entry = cache[native_bdd::hash_triple(f, g, h) & (cache_size - 1)];
+        const std::uint32_t version = entry.version.load(std::memory_order_acquire);
+        if ((version & 1) != 0) {
+            return false;
+        }
+        const edge ef = entry.f.load(std::memory_order_relaxed);
+        const edge eg = entry.g.load(std::memory_order_relaxed);
+        const edge eh = entry.h.load(std::memory_order_relaxed);
+        const edge er = entry.result.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.version.load(std::memory_order_relaxed) != version || ef != f || eg != g
+            || eh != h) {
+            return false;
+        }
+        ++w.cache_hits;
+        result = er;
+        return true;
+    }
+
+    void cache_store(edge f, edge g, edge h, edge result) {
+        cache_entry& entry = cache[native_bdd::hash_triple(f, g, h) & (cache_size - 1)];
+        std::uint32_t version = entry.version.load(std::memory_order_relaxed);
+        // A busy entry is simply not updated; the cache is lossy anyway
+        if ((version & 1) != 0
+            || !entry.version.compare_exchange_strong(version, version + 1,
+                                                      std::memory_order_acquire,
+                                                      std::memory_order_relaxed)) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.f.store(f, std::memory_order_relaxed);
+        entry.g.store(g, std::memory_order_relaxed);
+        entry.h.store(h, std::memory_order_relaxed);
+        entry.result.store(result, std::memory_order_relaxed);
+        entry.version.store(version + 2, std::memory_order_release);
+    }
+
+    // ------------------------------------------------------------------------
+    // ITE
+    // ------------------------------------------------------------------------
+
+    std::uint32_t top_var(edge e) const {
+        return nodes[node_index(e)].var;
+    }
+
+    edge cofactor(edge e, std::uint32_t var, bool value) const {
+        if (top_var(e) != var) {
+            return e;
+        }
+        const node_record& n = nodes[node_index(e)];
+        return (value ? n.high : n.low) ^ (e & 1);
+    }
+
+    /**
+     * @brief Task-parallel ITE: the else-branch is offered to thieves
+     */
+    edge ite_parallel(worker& w, edge f, edge g, edge h, unsigned depth) {
+        if (depth >= spawn_depth) {
+            return ite_sequential(w, f, g, h);
+        }
+        if (abandoned.load(std::memory_order_relaxed)) {
+            return abandoned_edge;
+        }
+        bool negate_result = false;
+        edge known = 0;
+        if (native_bdd::normalize_ite(f, g, h, negate_result, known)) {
+            return negate_result ? negate(known) : known;
+        }
+        edge r = 0;
+        if (!cache_lookup(w, f, g, h, r)) {
+            const std::uint32_t var = std::min({top_var(f), top_var(g), top_var(h)});
+            task t{cofactor(f, var, false), cofactor(g, var, false), cofactor(h, var, false),
+                   depth + 1};
+            const bool spawned = w.deque.push(&t);
+            const edge high = ite_parallel(w, cofactor(f, var, true), cofactor(g, var, true),
+                                           cofactor(h, var, true), depth + 1);
+            const edge low = spawned ? sync(w, t) : ite_parallel(w, t.f, t.g, t.h, depth + 1);
+            if (low == abandoned_edge || high == abandoned_edge) {
+                return abandoned_edge;
+            }
+            r = make_node(w, var, low, high);
+            if (r == abandoned_edge) {
+                return abandoned_edge;
+            }
+            cache_store(f, g, h, r);
+        }
+        return negate_result ? negate(r) : r;
+    }
+
+    /**
+     * @brief ITE on an explicit stack, as native_bdd::manager does it
+     */
+    edge ite_sequential(worker& w, edge f, edge g, edge h) {
+        auto& stack = w.stack;
+        stack.clear();
+        stack.push_back(ite_frame{f, g, h, 0, 0, false, 0});
+        edge result = 0;
+        bool have_result = false;
+        while (true) {
+            ite_frame& fr = stack.back();
+            if (have_result) {
+                if (fr.stage == 1) {
+                    fr.low = result;
+                    fr.stage = 2;
+                    have_result = false;
+                    ite_frame child{cofactor(fr.f, fr.var, true), cofactor(fr.g, fr.var, true),
+                                    cofactor(fr.h, fr.var, true), 0, 0, false, 0};
+                    stack.push_back(child);
+                    continue;
+                }
+                const edge r = make_node(w, fr.var, fr.low, result);
+                if (r == abandoned_edge) {
+                    stack.clear();
+                    return abandoned_edge;
+                }
+                cache_store(fr.f, fr.g, fr.h, r);
+                result = fr.negate_result ? negate(r) : r;
+            } else {
+                edge known = 0;
+                if (native_bdd::normalize_ite(fr.f, fr.g, fr.h, fr.negate_result, known)) {
+                    result = fr.negate_result ? negate(known) : known;
+                } else if (cache_lookup(w, fr.f, fr.g, fr.h, known)) {
+                    result = fr.negate_result ? negate(known) : known;
+                } else {
+                    fr.var = std::min({top_var(fr.f), top_var(fr.g), top_var(fr.h)});
+                    fr.stage = 1;
+                    ite_frame child{cofactor(fr.f, fr.var, false), cofactor(fr.g, fr.var, false),
+                                    cofactor(fr.h, fr.var, false), 0, 0, false, 0};
+                    stack.push_back(child);
+                    continue;
+                }
+            }
+            stack.pop_back();
+            if (stack.empty()) {
+                return result;
+            }
+            have_result = true;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Garbage collection
+    // ------------------------------------------------------------------------
+
+    /// Collects before an operation once most of the free slots are handed out
+    void maybe_collect() {
+        if (4 * slot_cursor.load(std::memory_order_relaxed) >= 3 * free_slots.size()) {
+            collect(false);
+        }
+    }
+
+    /**
+     * @brief Stop-the-world collection between operations
+     *
+     * Marking and rehashing run on all workers. The table doubles when more
+     * than half of it survives, or when @p grow is set because an operation
+     * ran out of slots.
+     */
+    void collect(bool grow) {
+        auto marks = std::make_unique<std::atomic<std::uint8_t>[]>(capacity);
+        marks[0].store(1, std::memory_order_relaxed);
+        std::vector<std::uint32_t> roots;
+        for (std::uint32_t i = 1; i < capacity; ++i) {
+            if (refs[i] != 0) {
+                roots.push_back(i);
+            }
+        }
+        parallel_for(roots.size(), [&](worker& w, std::size_t begin, std::size_t end) {
+            auto& pending = w.mark_stack;
+            for (std::size_t r = begin; r < end; ++r) {
+                pending.push_back(roots[r]);
+                while (!pending.empty()) {
+                    const std::uint32_t index = pending.back();
+                    pending.pop_back();
+                    if (marks[index].exchange(1, std::memory_order_relaxed) != 0) {
+                        continue;
+                    }
+                    pending.push_back(node_index(nodes[index].low));
+                    pending.push_back(node_index(nodes[index].high));
+                }
+            }
+        });
+
+        std::size_t live = 0;
+        for (std::size_t i = 0; i < capacity; ++i) {
+            live += marks[i].load(std::memory_order_relaxed);
+        }
+        const std::size_t old_capacity = capacity;
+        if (grow || 2 * live > capacity) {
+            if (capacity >= max_capacity) {
+                throw std::runtime_error("Parallel BDD node table cannot grow beyond "
+                                         + std::to_string(max_capacity) + " nodes");
+            }
+            capacity *= 2;
+            auto grown = std::make_unique<node_record[]>(capacity);
+            std::copy(nodes.get(), nodes.get() + old_capacity, grown.get());
+            nodes = std::move(grown);
+            refs.resize(capacity, 0);
+            allocate_table();
+            if (cache_size < config.max_cache_entries) {
+                resize_cache(std::min(config.max_cache_entries, 2 * cache_size));
+            }
+            ++grows;
+        } else {
+            parallel_for(table_size, [&](worker&, std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    table[i].store(0, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        // Survivors go back into the table; everything else becomes free
+        free_slots.clear();
+        for (std::uint32_t i = 1; i < capacity; ++i) {
+            if (i >= old_capacity || marks[i].load(std::memory_order_relaxed) == 0) {
+                free_slots.push_back(i);
+            }
+        }
+        const std::size_t mask = table_size - 1;
+        parallel_for(old_capacity, [&](worker&, std::size_t begin, std::size_t end) {
+            for (std::size_t i = std::max<std::size_t>(begin, 1); i < end; ++i) {
+                if (marks[i].load(std::memory_order_relaxed) == 0) {
+                    continue;
+                }
+                const node_record& n = nodes[i];
+                std::size_t slot = native_bdd::hash_triple(n.var, n.low, n.high) & mask;
+                std::uint32_t empty = 0;
+                while (!table[slot].compare_exchange_strong(empty, static_cast<std::uint32_t>(i),
+                                                            std::memory_order_relaxed)) {
+                    empty = 0;
+                    slot = (slot + 1) & mask;
+                }
+            }
+        });
+        parallel_for(cache_size, [&](worker&, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                cache[i].f.store(native_bdd::free_var, std::memory_order_relaxed);
+            }
+        });
+
+        slot_cursor.store(0, std::memory_order_relaxed);
+        for (auto& w : workers) {
+            w->next_slot = 0;
+            w->end_slot = 0;
+            w->spare = 0;
+        }
+        live_after_gc = live;
+        ++gc_runs;
+    }
+
+    // ------------------------------------------------------------------------
+    // State
+    // ------------------------------------------------------------------------
+
+    std::uint32_t variable_count;
+    manager_config config;
+    unsigned thread_count = 1;
+    unsigned spawn_depth = 0;
+
+    std::size_t capacity = 0;
+    std::unique_ptr<node_record[]> nodes;
+    std::vector<std::uint32_t> refs;  ///< Handle references per node (client thread only)
+    std::size_t table_size = 0;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> table;  ///< Node indices; 0 marks empty
+    std::vector<std::uint32_t> free_slots;
+    std::atomic<std::size_t> slot_cursor{0};
+    std::size_t cache_size = 0;
+    std::unique_ptr<cache_entry[]> cache;
+    std::atomic<bool> abandoned{false};
+    std::atomic<bool> op_done{false};
+
+    std::vector<std::unique_ptr<worker>> workers;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::atomic<std::uint64_t> epoch{0};
+    const std::function<void(worker&)>* job = nullptr;
+    std::atomic<unsigned> busy{0};
+    bool stop = false;
+
+    std::size_t live_after_gc = 1;
+    std::size_t gc_runs = 0;
+    std::size_t grows = 0;
+    std::size_t restarts = 0;
+};
+
+manager::manager(std::uint32_t variable_count, const manager_config& config)
+    : engine_(std::make_unique<engine>(variable_count, config)) {}
+
+manager::~manager() = default;
+
+std::uint32_t manager::variable_count() const {
+    return engine_->variable_count;
+}
+
+unsigned manager::thread_count() const {
+    return engine_->thread_count;
+}
+
+bdd manager::variable(std::uint32_t index) {
+    if (index >= engine_->variable_count) {
+        throw std::runtime_error("Variable index " + std::to_string(index) + " out of range for "
+                                 + std::to_string(engine_->variable_count) + " variables");
+    }
+    edge e = engine_->run_operation(
+        [&](worker& w) { return engine_->make_node(w, index, zero_edge, one_edge); }, false);
+    return bdd(this, e);
+}
+
+bdd manager::ite(const bdd& f, const bdd& g, const bdd& h) {
+    for (const bdd* operand : {&f, &g, &h}) {
+        if (operand->get_manager() != this) {
+            throw std::runtime_error("BDD operand belongs to a different manager");
+        }
+    }
+    // Terminal cases need no workers
+    edge ef = f.get_edge();
+    edge eg = g.get_edge();
+    edge eh = h.get_edge();
+    bool negate_result = false;
+    edge known = 0;
+    if (native_bdd::normalize_ite(ef, eg, eh, negate_result, known)) {
+        return bdd(this, negate_result ? negate(known) : known);
+    }
+    edge e = engine_->run_operation(
+        [&](worker& w) { return engine_->ite_parallel(w, ef, eg, eh, 0); },
+        engine_->thread_count > 1);
+    return bdd(this, negate_result ? negate(e) : e);
+}
+
+bool manager::evaluate(const bdd& f, std::span<const std::uint8_t> values) const {
+    if (values.size() < engine_->variable_count) {
+        throw std::runtime_error("Assignment has " + std::to_string(values.size())
+                                 + " values, expected "
+                                 + std::to_string(engine_->variable_count));
+    }
+    edge e = f.get_edge();
+    while (!is_constant(e)) {
+        const node_record& n = engine_->nodes[node_index(e)];
+        e = (values[n.var] != 0 ? n.high : n.low) ^ (e & 1);
+    }
+    return e == one_edge;
+}
+
+std::size_t manager::node_count(const bdd& f) const {
+    std::vector<std::uint8_t> seen(engine_->capacity, 0);
+    std::vector<std::uint32_t> pending = {node_index(f.get_edge())};
+    std::size_t count = 0;
+    while (!pending.empty()) {
+        const std::uint32_t index = pending.back();
+        pending.pop_back();
+        if (seen[index] != 0) {
+            continue;
+        }
+        seen[index] = 1;
+        ++count;
+        if (index != 0) {
+            pending.push_back(node_index(engine_->nodes[index].low));
+            pending.push_back(node_index(engine_->nodes[index].high));
+        }
+    }
+    return count;
+}
+
+void manager::collect_garbage() {
+    engine_->collect(false);
+}
+
+statistics manager::get_statistics() const {
+    const engine& e = *engine_;
+    statistics stats;
+    stats.capacity = e.capacity;
+    stats.used_nodes = e.live_after_gc
+                       + std::min(e.slot_cursor.load(std::memory_order_relaxed),
+                                  e.free_slots.size());
+    stats.gc_runs = e.gc_runs;
+    stats.grows = e.grows;
+    stats.restarts = e.restarts;
+    for (const auto& w : e.workers) {
+        stats.steals += w->steals;
+        stats.cache_lookups += w->cache_lookups;
+        stats.cache_hits += w->cache_hits;
+    }
+    return stats;
+}
+
+std::uint32_t manager::top_var(edge e) const {
+    return engine_->top_var(e);
+}
+
+edge manager::low(edge e) const {
+    return engine_->nodes[node_index(e)].low ^ (e & 1);
+}
+
+edge manager::high(edge e) const {
+    return engine_->nodes[node_index(e)].high ^ (e & 1);
+}
+
+void manager::add_ref(edge e) {
+    std::uint32_t& refs = engine_->refs[node_index(e)];
+    if (refs != std::numeric_limits<std::uint32_t>::max()) {
+        ++refs;
+    }
+}
+
+void manager::drop_ref(edge e) {
+    std::uint32_t& refs = engine_->refs[node_index(e)];
+    if (refs != 0 && refs != std::numeric_limits<std::uint32_t>::max()) {
+        --refs;
+    }
+}
+
+}  // namespace parallel_bdd
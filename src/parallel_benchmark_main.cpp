@@ -0,0 +1,292 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file parallel_benchmark_main.cpp
+ * @brief Speedup benchmark for the parallel BDD package and partitioned conversion
+ *
+ * Generates N-Queens and random k-CNF workloads (or reads expression files),
+ * converts each with the parallel package at thread counts 1, 2, 4, ... up to
+ * a maximum, and reports time and speedup relative to one thread. The same
+ * thread counts are then used as partition counts for partitioned TeDDy and
+ * CUDD conversion (see partitioned_convert.hpp). Every run must produce the
+ * same node count as the single-threaded one.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "benchmark_timing.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "parallel_bdd.hpp"
+#include "parallel_convert.hpp"
+#include "partitioned_convert.hpp"
+#include "workload_generator.hpp"
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using benchmark_timing::best_time;
+
+void print_help() {
+    std::cout << "Parallel BDD Benchmark - Speedup over thread counts\n";
+    std::cout << "===================================================\n\n";
+    std::cout << "Usage: bdd_parallel_bench [expression_file]... [options]\n\n";
+    std::cout << "Without files, generated N-Queens and random k-CNF workloads are used.\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --queens=<int>        N-Queens board size (default 8, 0 to skip)\n";
+    std::cout << "  --cnf-vars=<int>      Random 3-CNF variable count (default 32, 0 to skip)\n";
+    std::cout << "  --ratio=<float>       Clause/variable ratio for the CNF (default 2.0)\n";
+    std::cout << "  --seed=<int>          Seed for the CNF (default 1)\n";
+    std::cout << "  --max-threads=<int>   Largest thread count (default: hardware "
+                 "concurrency)\n";
+    std::cout << "  --repeat=<int>        Timed runs per thread count, best is reported "
+                 "(default 3)\n";
+    std::cout << "  --help, -h            Show this help message\n";
+}
+
+/**
+ * @brief Silences std::cout while alive (the converters log the variable order)
+ */
+class quiet_cout {
+   public:
+    quiet_cout() : saved_(std::cout.rdbuf(sink_.rdbuf())) {}
+    ~quiet_cout() {
+        std::cout.rdbuf(saved_);
+    }
+
+   private:
+    std::ostringstream sink_;
+    std::streambuf* saved_;
+};
+
+/**
+ * @brief Parses generated expression text through the regular file reader
+ */
+my_expression_ptr parse_generated(const std::string& name, const std::string& contents) {
+    std::filesystem::path file =
+        std::filesystem::temp_directory_path() / ("bdd_parallel_bench_" + name + ".txt");
+    {
+        std::ofstream out(file);
+        out << contents;
+    }
+    quiet_cout quiet;
+    auto expr = read_expression_from_file(file.string());
+    std::filesystem::remove(file);
+    return expr;
+}
+
+/**
+ * @brief Thread counts 1, 2, 4, ... up to and including @p max_threads
+ */
+std::vector<unsigned> thread_counts(unsigned max_threads) {
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < max_threads; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(max_threads);
+    return counts;
+}
+
+/**
+ * @brief Prints the speedup curve of one workload
+ * @return false if a thread count produced a different node count
+ */
+bool run_workload(const std::string& name, const my_expression& expr,
+                  const std::vector<unsigned>& counts, int repeat) {
+    std::unordered_set<std::string> variable_names;
+    collect_variables_with_dag_walker(expr, variable_names);
+    const auto n = static_cast<std::uint32_t>(variable_names.size());
+
+    std::cout << std::format("\n{} ({} variables)\n", name, n);
+    std::cout << std::format("{:>8} {:>12} {:>9} {:>10} {:>10} {:>8}\n", "Threads", "ms",
+                             "speedup", "nodes", "steals", "GCs");
+
+    bool consistent = true;
+    double base = 0.0;
+    std::size_t base_nodes = 0;
+    for (unsigned threads : counts) {
+        double best = 0.0;
+        std::size_t nodes = 0;
+        parallel_bdd::statistics stats;
+        for (int r = 0; r < repeat; ++r) {
+            parallel_bdd::manager_config config;
+            config.threads = threads;
+            parallel_bdd::manager mgr(n, config);
+            quiet_cout quiet;
+            auto start = std::chrono::steady_clock::now();
+            auto f = convert_to_parallel_bdd(expr, mgr);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (r == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+                stats = mgr.get_statistics();
+            }
+            nodes = mgr.node_count(f);
+        }
+        if (threads == counts.front()) {
+            base = best;
+            base_nodes = nodes;
+        } else if (nodes != base_nodes) {
+            std::cerr << "Error: " << name << " has " << nodes << " nodes with " << threads
+                      << " threads, " << base_nodes << " with " << counts.front() << "\n";
+            consistent = false;
+        }
+        std::cout << std::format("{:>8} {:>12.3f} {:>9.2f} {:>10} {:>10} {:>8}\n", threads,
+                                 best * 1e3, base / best, nodes, stats.steals, stats.gc_runs);
+    }
+
+    // Partitioned conversion with the single-threaded libraries
+    std::cout << std::format("{:>8} {:>12} {:>9} {:>12} {:>9} {:>10}\n", "Parts", "TeDDy ms",
+                             "speedup", "CUDD ms", "speedup", "nodes");
+    double teddy_base = 0.0;
+    double cudd_base = 0.0;
+    std::size_t teddy_base_nodes = 0;
+    for (unsigned partitions : counts) {
+        std::size_t teddy_nodes = 0;
+        std::size_t cudd_nodes = 0;
+        double teddy_time = best_time(repeat, [&] {
+            teddy::bdd_manager mgr(static_cast<int>(n), 1'000);
+            quiet_cout quiet;
+            teddy_nodes = mgr.get_node_count(convert_to_bdd_partitioned(expr, mgr, partitions));
+        });
+        double cudd_time = best_time(repeat, [&] {
+            quiet_cout quiet;
+            auto [mgr, f] = convert_to_cudd_bdd_partitioned(expr, variable_names, partitions);
+            cudd_nodes = static_cast<std::size_t>(f.nodeCount());
+        });
+        if (partitions == counts.front()) {
+            teddy_base = teddy_time;
+            cudd_base = cudd_time;
+            teddy_base_nodes = teddy_nodes;
+        } else if (teddy_nodes != teddy_base_nodes) {
+            std::cerr << "Error: " << name << " has " << teddy_nodes << " TeDDy nodes with "
+                      << partitions << " partitions, " << teddy_base_nodes << " with "
+                      << counts.front() << "\n";
+            consistent = false;
+        }
+        std::cout << std::format("{:>8} {:>12.3f} {:>9.2f} {:>12.3f} {:>9.2f} {:>10}\n",
+                                 partitions, teddy_time * 1e3, teddy_base / teddy_time,
+                                 cudd_time * 1e3, cudd_base / cudd_time, teddy_nodes);
+    }
+    return consistent;
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+/**
+ * @brief Parallel benchmark entry point
+ *
+ * @param argc Number of command line arguments
+ * @param argv Array of command line argument strings
+ * @return 0 on success, 1 on error or if thread counts disagree
+ */
+int main(int argc, const char* argv[]) {
+    std::vector<std::string> files;
+    int queens = 8;
+    workload_generator::GeneratorOptions cnf;
+    cnf.n = 32;
+    cnf.ratio = 2.0;
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    int repeat = 3;
+    bool show_help = false;
+    bool help_due_to_error = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg.starts_with("--queens=")) {
+                queens = std::stoi(arg.substr(9));
+            } else if (arg.starts_with("--cnf-vars=")) {
+                cnf.n = std::stoi(arg.substr(11));
+            } else if (arg.starts_with("--ratio=")) {
+                cnf.ratio = std::stod(arg.substr(8));
+            } else if (arg.starts_with("--seed=")) {
+                cnf.seed = std::stoull(arg.substr(7));
+            } else if (arg.starts_with("--max-threads=")) {
+                max_threads = std::max(1u, static_cast<unsigned>(std::stoul(arg.substr(14))));
+            } else if (arg.starts_with("--repeat=")) {
+                repeat = std::max(1, std::stoi(arg.substr(9)));
+            } else if (arg == "--help" || arg == "-h") {
+                show_help = true;
+                break;
+            } else if (arg.starts_with("-")) {
+                std::cerr << "Unknown option: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            } else {
+                files.push_back(arg);
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric option value\n";
+        return 1;
+    }
+
+    if (show_help) {
+        print_help();
+        return help_due_to_error ? 1 : 0;
+    }
+
+    std::vector<std::pair<std::string, my_expression_ptr>> workloads;
+    try {
+        if (files.empty()) {
+            if (queens > 0) {
+                workload_generator::GeneratorOptions options;
+                options.n = queens;
+                workloads.emplace_back(
+                    std::format("{}-queens", queens),
+                    parse_generated("queens", workload_generator::generate_n_queens(options)));
+            }
+            if (cnf.n > 0) {
+                workloads.emplace_back(
+                    std::format("random 3-CNF, ratio {}, seed {}", cnf.ratio, cnf.seed),
+                    parse_generated("cnf", workload_generator::generate_random_cnf(cnf)));
+            }
+        }
+        for (const auto& file : files) {
+            quiet_cout quiet;
+            workloads.emplace_back(std::filesystem::path(file).filename().string(),
+                                   read_expression_from_file(file));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error preparing workloads: " << e.what() << "\n";
+        return 1;
+    }
+
+    const auto counts = thread_counts(max_threads);
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n";
+    bool consistent = true;
+    try {
+        for (const auto& [name, expr] : workloads) {
+            consistent = run_workload(name, *expr, counts, repeat) && consistent;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return consistent ? 0 : 1;
+}
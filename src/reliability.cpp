@@ -0,0 +1,374 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file reliability.cpp
+ * @brief Probability propagation over compiled BDDs implementation
+ *
+ * Implements the compilers from TeDDy, CUDD and native diagrams, the scalar
+ * and tiled multi-threaded probability passes, importance analysis, and the
+ * probability file reader.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "reliability.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cudd/cudd.h>
+#include <cudd/cuddObj.hh>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using reliability::diagram;
+
+std::uint32_t append_node(diagram& d, std::size_t index, std::uint32_t low, std::uint32_t high) {
+    if (index >= d.variables) {
+        throw std::runtime_error("BDD variable index " + std::to_string(index)
+                                 + " out of range for " + std::to_string(d.variables)
+                                 + " variables");
+    }
+    d.nodes.push_back({static_cast<std::uint32_t>(index), low, high});
+    return diagram::first_node + static_cast<std::uint32_t>(d.nodes.size() - 1);
+}
+
+void check_vector(const diagram& d, std::size_t size) {
+    if (size != d.variables) {
+        throw std::runtime_error("Expected " + std::to_string(d.variables)
+                                 + " probabilities, got " + std::to_string(size));
+    }
+}
+
+/// P(f = 1) at every node id for one probability vector
+std::vector<double> node_probabilities(const diagram& d, std::span<const double> p) {
+    std::vector<double> value(diagram::first_node + d.nodes.size());
+    value[diagram::zero] = 0.0;
+    value[diagram::one] = 1.0;
+    for (std::size_t i = 0; i < d.nodes.size(); ++i) {
+        const auto& n = d.nodes[i];
+        const double low = value[n.low];
+        value[diagram::first_node + i] = low + p[n.variable] * (value[n.high] - low);
+    }
+    return value;
+}
+
+/**
+ * @brief Evaluates rows [begin, end) of a batch, `lanes` rows at a time
+ *
+ * Probabilities and node values are stored variable- and node-major, so the
+ * loop over lanes runs over consecutive doubles.
+ */
+void run_range(const diagram& d, std::span<const double> vectors, std::size_t lanes,
+               std::size_t begin, std::size_t end, double* result) {
+    const std::size_t ids = diagram::first_node + d.nodes.size();
+    std::vector<double> q(d.variables * lanes);
+    std::vector<double> value(ids * lanes);
+    std::fill_n(value.begin() + diagram::zero * lanes, lanes, 0.0);
+    std::fill_n(value.begin() + diagram::one * lanes, lanes, 1.0);
+
+    for (std::size_t row = begin; row < end; row += lanes) {
+        const std::size_t width = std::min(lanes, end - row);
+        for (std::size_t lane = 0; lane < width; ++lane) {
+            const double* p = vectors.data() + (row + lane) * d.variables;
+            for (std::size_t v = 0; v < d.variables; ++v) {
+                q[v * lanes + lane] = p[v];
+            }
+        }
+        for (std::size_t i = 0; i < d.nodes.size(); ++i) {
+            const auto& n = d.nodes[i];
+            const double* low = value.data() + n.low * lanes;
+            const double* high = value.data() + n.high * lanes;
+            const double* p = q.data() + n.variable * lanes;
+            double* out = value.data() + (diagram::first_node + i) * lanes;
+            for (std::size_t lane = 0; lane < width; ++lane) {
+                out[lane] = low[lane] + p[lane] * (high[lane] - low[lane]);
+            }
+        }
+        std::copy_n(value.data() + d.root * lanes, width, result + row);
+    }
+}
+
+/// Splits a line at commas and whitespace, dropping any `#` comment
+std::vector<std::string> split_fields(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string current;
+    for (char c : line.substr(0, line.find('#'))) {
+        if (c == ',' || std::isspace(static_cast<unsigned char>(c))) {
+            if (!current.empty()) {
+                fields.push_back(std::move(current));
+                current.clear();
+            }
+        } else {
+            current += c;
+        }
+    }
+    if (!current.empty()) {
+        fields.push_back(std::move(current));
+    }
+    return fields;
+}
+
+double parse_probability(const std::string& text, const std::string& where) {
+    std::size_t used = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used != text.size()) {
+        throw std::runtime_error("Invalid probability '" + text + "' " + where);
+    }
+    if (!(value >= 0.0 && value <= 1.0)) {
+        throw std::runtime_error("Probability " + text + " outside [0, 1] " + where);
+    }
+    return value;
+}
+
+}  // namespace
+
+// ============================================================================
+// Exported functions (reliability namespace)
+// ============================================================================
+
+namespace reliability {
+
+diagram compile_teddy(teddy::bdd_manager::diagram_t f, std::size_t variables) {
+    using node_t = teddy::bdd_manager::diagram_t::node_t;
+    diagram d;
+    d.variables = variables;
+
+    std::unordered_map<node_t*, std::uint32_t> compiled;
+    std::function<std::uint32_t(node_t*)> compile_recursive = [&](node_t* node) {
+        if (node->is_terminal()) {
+            return node->get_value() != 0 ? diagram::one : diagram::zero;
+        }
+        if (auto it = compiled.find(node); it != compiled.end()) {
+            return it->second;
+        }
+        std::uint32_t low = compile_recursive(node->get_son(0));
+        std::uint32_t high = compile_recursive(node->get_son(1));
+        std::uint32_t id =
+            append_node(d, static_cast<std::size_t>(node->get_index()), low, high);
+        compiled.emplace(node, id);
+        return id;
+    };
+
+    d.root = compile_recursive(f.unsafe_get_root());
+    return d;
+}
+
+diagram compile_cudd(const BDD& f, std::size_t variables) {
+    diagram d;
+    d.variables = variables;
+
+    // Keyed by edge: a node reached through a complemented edge becomes a
+    // second node over the complemented children
+    std::unordered_map<DdNode*, std::uint32_t> compiled;
+    std::function<std::uint32_t(DdNode*)> compile_recursive = [&](DdNode* edge) {
+        if (auto it = compiled.find(edge); it != compiled.end()) {
+            return it->second;
+        }
+        DdNode* node = Cudd_Regular(edge);
+        const bool complemented = Cudd_IsComplement(edge) != 0;
+        std::uint32_t id;
+        if (Cudd_IsConstant(node)) {
+            id = (Cudd_V(node) != 0) != complemented ? diagram::one : diagram::zero;
+        } else {
+            std::uint32_t low = compile_recursive(Cudd_NotCond(Cudd_E(node), complemented));
+            std::uint32_t high = compile_recursive(Cudd_NotCond(Cudd_T(node), complemented));
+            id = append_node(d, Cudd_NodeReadIndex(node), low, high);
+        }
+        compiled.emplace(edge, id);
+        return id;
+    };
+
+    d.root = compile_recursive(f.getNode());
+    return d;
+}
+
+diagram compile_native(const native_bdd::manager& manager, const native_bdd::bdd& f) {
+    diagram d;
+    d.variables = manager.variable_count();
+
+    std::unordered_map<native_bdd::edge, std::uint32_t> compiled;
+    std::function<std::uint32_t(native_bdd::edge)> compile_recursive = [&](native_bdd::edge e) {
+        if (native_bdd::is_constant(e)) {
+            return e == native_bdd::one_edge ? diagram::one : diagram::zero;
+        }
+        if (auto it = compiled.find(e); it != compiled.end()) {
+            return it->second;
+        }
+        std::uint32_t low = compile_recursive(manager.low(e));
+        std::uint32_t high = compile_recursive(manager.high(e));
+        std::uint32_t id = append_node(d, manager.top_var(e), low, high);
+        compiled.emplace(e, id);
+        return id;
+    };
+
+    d.root = compile_recursive(f.get_edge());
+    return d;
+}
+
+double probability(const diagram& d, std::span<const double> p) {
+    check_vector(d, p.size());
+    return node_probabilities(d, p)[d.root];
+}
+
+std::vector<double> probabilities(const diagram& d, std::span<const double> vectors,
+                                  const batch_options& options) {
+    if (options.tile_lanes == 0) {
+        throw std::runtime_error("Tile size must be at least one probability vector");
+    }
+    if (d.variables == 0 ? !vectors.empty() : vectors.size() % d.variables != 0) {
+        throw std::runtime_error("Probability vectors hold " + std::to_string(vectors.size())
+                                 + " values, not a multiple of "
+                                 + std::to_string(d.variables));
+    }
+    const std::size_t rows = d.variables == 0 ? 0 : vectors.size() / d.variables;
+    std::vector<double> result(rows);
+    if (rows == 0) {
+        return result;
+    }
+
+    // Fewer lanes for large diagrams, so the scratch space of a thread stays bounded
+    const std::size_t bytes_per_lane =
+        (diagram::first_node + d.nodes.size() + d.variables) * sizeof(double);
+    const std::size_t lanes = std::clamp<std::size_t>(options.scratch_bytes / bytes_per_lane, 1,
+                                                      options.tile_lanes);
+
+    // Whole tiles per thread, so threads never share a result
+    const std::size_t tiles = (rows + lanes - 1) / lanes;
+    std::size_t threads = options.threads != 0 ? options.threads
+                                               : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, tiles);
+    const std::size_t tiles_per_thread = (tiles + threads - 1) / threads;
+
+    auto run_chunk = [&](std::size_t chunk) {
+        const std::size_t begin = chunk * tiles_per_thread * lanes;
+        const std::size_t end = std::min(rows, begin + tiles_per_thread * lanes);
+        if (begin < end) {
+            run_range(d, vectors, lanes, begin, end, result.data());
+        }
+    };
+    if (threads == 1) {
+        run_chunk(0);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back(run_chunk, t);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    return result;
+}
+
+importance analyze(const diagram& d, std::span<const double> p) {
+    check_vector(d, p.size());
+    const auto value = node_probabilities(d, p);
+
+    importance result;
+    result.probability = value[d.root];
+    result.birnbaum.assign(d.variables, 0.0);
+    result.marginal.assign(d.variables, 0.0);
+
+    // Probability of reaching each node from the root, parents before children
+    std::vector<double> reach(value.size(), 0.0);
+    reach[d.root] = 1.0;
+    for (std::size_t i = d.nodes.size(); i-- > 0;) {
+        const auto& n = d.nodes[i];
+        const double r = reach[diagram::first_node + i];
+        if (r == 0.0) {
+            continue;
+        }
+        result.birnbaum[n.variable] += r * (value[n.high] - value[n.low]);
+        reach[n.low] += r * (1.0 - p[n.variable]);
+        reach[n.high] += r * p[n.variable];
+    }
+
+    // P(x_i = 1 | f = 1) = p_i * P(f = 1 | x_i = 1) / P(f = 1), where
+    // P(f = 1 | x_i = 1) = P(f = 1) + (1 - p_i) * birnbaum_i
+    if (result.probability > 0.0) {
+        for (std::size_t v = 0; v < d.variables; ++v) {
+            const double given_one = result.probability + (1.0 - p[v]) * result.birnbaum[v];
+            result.marginal[v] = p[v] * given_one / result.probability;
+        }
+    }
+    return result;
+}
+
+probability_table read_probability_file(const std::string& path,
+                                        const std::vector<std::string>& variable_names) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open probability file: " + path);
+    }
+
+    std::unordered_map<std::string, std::size_t> index_of;
+    for (std::size_t i = 0; i < variable_names.size(); ++i) {
+        index_of.emplace(variable_names[i], i);
+    }
+
+    probability_table table;
+    table.variables = variable_names.size();
+    std::vector<std::size_t> columns;  // Variable index of each column
+    bool have_header = false;
+    std::string line;
+    std::size_t line_number = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        auto fields = split_fields(line);
+        if (fields.empty()) {
+            continue;
+        }
+        const std::string where = "at " + path + ":" + std::to_string(line_number);
+        if (!have_header) {
+            std::vector<bool> seen(variable_names.size(), false);
+            for (const auto& name : fields) {
+                auto it = index_of.find(name);
+                if (it == index_of.end()) {
+                    throw std::runtime_error("Unknown variable '" + name + "' " + where);
+                }
+                if (seen[it->second]) {
+                    throw std::runtime_error("Duplicate variable '" + name + "' " + where);
+                }
+                seen[it->second] = true;
+                columns.push_back(it->second);
+            }
+            have_header = true;
+            continue;
+        }
+        if (fields.size() != columns.size()) {
+            throw std::runtime_error("Expected " + std::to_string(columns.size())
+                                     + " probabilities " + where + ", got "
+                                     + std::to_string(fields.size()));
+        }
+        const std::size_t base = table.values.size();
+        table.values.resize(base + table.variables, 0.5);
+        for (std::size_t c = 0; c < columns.size(); ++c) {
+            table.values[base + columns[c]] = parse_probability(fields[c], where);
+        }
+    }
+    if (!have_header) {
+        throw std::runtime_error("Probability file has no header: " + path);
+    }
+    return table;
+}
+
+}  // namespace reliability
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file render_benchmark_main.cpp
+ * @brief Regression benchmark for walking and rendering large expression trees
+ *
+ * Generates a balanced expression tree of about a million nodes (AND, OR,
+ * XOR and NOT over 64 variables) and times the passes that walk it with
+ * expression_iterator: variable collection, node counting, and the DOT and
+ * Mermaid writers used for `*_expression_tree.dot` and `.md`. Every pass
+ * should be close to linear in the node count, so doubling `--nodes`
+ * should roughly double each time.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+#include "benchmark_timing.hpp"
+#include "dag_walker.hpp"
+#include "expression_graph.hpp"
+#include "expression_iterator.hpp"
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using benchmark_timing::best_time;
+
+/// Variables the generated tree draws its leaves from
+constexpr std::size_t tree_variables = 64;
+
+void print_help() {
+    std::cout << "Expression Render Benchmark - walking and rendering large expression trees\n";
+    std::cout << "===========================================================================\n\n";
+    std::cout << "Usage: bdd_render_bench [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --nodes=<int>         Expression nodes to generate (default 1000000)\n";
+    std::cout << "  --repeat=<int>        Timed runs per pass, best is reported (default 3)\n";
+    std::cout << "  --help, -h            Show this help message\n";
+}
+
+/**
+ * @brief Builds a balanced tree of exactly @p size nodes
+ *
+ * Sizes of two and every fifth size are a NOT over the rest; the other
+ * operators split the remaining nodes evenly and rotate through AND, OR and
+ * XOR.
+ */
+my_expression_ptr balanced_tree(std::size_t size, std::size_t& next_variable) {
+    if (size <= 1) {
+        return std::make_unique<my_expression>(
+            my_variable{"x" + std::to_string(next_variable++ % tree_variables)});
+    }
+    if (size == 2 || size % 5 == 0) {
+        return std::make_unique<my_expression>(my_not{balanced_tree(size - 1, next_variable)});
+    }
+    const std::size_t left_size = (size - 1) / 2;
+    auto left = balanced_tree(left_size, next_variable);
+    auto right = balanced_tree(size - 1 - left_size, next_variable);
+    switch (size % 3) {
+        case 0:
+            return std::make_unique<my_expression>(my_and{std::move(left), std::move(right)});
+        case 1:
+            return std::make_unique<my_expression>(my_or{std::move(left), std::move(right)});
+        default:
+            return std::make_unique<my_expression>(my_xor{std::move(left), std::move(right)});
+    }
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+/**
+ * @brief Render benchmark entry point
+ *
+ * @param argc Number of command line arguments
+ * @param argv Array of command line argument strings
+ * @return 0 on success, 1 on error or if a pass saw the wrong number of nodes
+ */
+int main(int argc, const char* argv[]) {
+    std::size_t nodes = 1'000'000;
+    int repeat = 3;
+    bool show_help = false;
+    bool help_due_to_error = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg.starts_with("--nodes=")) {
+                nodes = std::max<std::size_t>(std::stoull(arg.substr(8)), 3);
+            } else if (arg.starts_with("--repeat=")) {
+                repeat = std::max(1, std::stoi(arg.substr(9)));
+            } else if (arg == "--help" || arg == "-h") {
+                show_help = true;
+                break;
+            } else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric option value\n";
+        return 1;
+    }
+
+    if (show_help) {
+        print_help();
+        return help_due_to_error ? 1 : 0;
+    }
+
+    std::size_t next_variable = 0;
+    auto expr = balanced_tree(nodes, next_variable);
+    const my_expression& root = *expr;
+
+    std::size_t counted = 0;
+    std::size_t variables = 0;
+    std::size_t dot_bytes = 0;
+    std::size_t mermaid_bytes = 0;
+    const double count_time = best_time(repeat, [&] {
+        counted = dag_walker::count_nodes_topological(expression_iterator(root));
+    });
+    const double collect_time = best_time(repeat, [&] {
+        std::unordered_set<std::string> names;
+        collect_variables_with_dag_walker(root, names);
+        variables = names.size();
+    });
+    const double dot_time = best_time(repeat, [&] {
+        std::ostringstream out;
+        write_expression_to_dot(root, out, "ExpressionTree");
+        dot_bytes = out.str().size();
+    });
+    const double mermaid_time = best_time(repeat, [&] {
+        std::ostringstream out;
+        write_expression_to_mermaid(root, out, "Expression Tree");
+        mermaid_bytes = out.str().size();
+    });
+
+    std::cout << std::format("Expression tree: {} nodes, {} variables\n\n", counted, variables);
+    std::cout << std::format("{:<28} {:>12} {:>14}\n", "Pass", "ms", "output bytes");
+    std::cout << std::format("{:<28} {:>12.1f} {:>14}\n", "count_nodes_topological",
+                             count_time * 1e3, "-");
+    std::cout << std::format("{:<28} {:>12.1f} {:>14}\n", "collect_variables", collect_time * 1e3,
+                             "-");
+    std::cout << std::format("{:<28} {:>12.1f} {:>14}\n", "write_expression_to_dot",
+                             dot_time * 1e3, dot_bytes);
+    std::cout << std::format("{:<28} {:>12.1f} {:>14}\n", "write_expression_to_mermaid",
+                             mermaid_time * 1e3, mermaid_bytes);
+
+    if (counted != nodes) {
+        std::cerr << "Error: walked " << counted << " nodes, expected " << nodes << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -21,6 +21,7 @@
 #include <ranges>
 #include <unordered_map>
 
+#include "c_code_generator.hpp"
 #include "dag_walker.hpp"
 #include "dot_graph_generator.hpp"
 #include "mermaid_graph_generator.hpp"
@@ -103,3 +104,52 @@ void write_teddy_nodes_to_markdown(const teddy::bdd_manager& manager,
     // Use the generic markdown table generator
     node_table::generate_markdown_table(root_iter, out, config);
 }
+
+void write_teddy_to_c(const teddy::bdd_manager& manager, teddy::bdd_manager::diagram_t diagram,
+                      const std::vector<std::string>& variable_names, std::ostream& out,
+                      const c_code::CCodeConfig& config) {
+    // Create an iterator from the BDD root
+    teddy_iterator root_iter(diagram.unsafe_get_root(), &variable_names);
+
+    // Use the generic C code generator
+    c_code::generate_c_code(root_iter, variable_names, out, config);
+}
+
+void write_teddy_outputs_to_dot(
+    const teddy::bdd_manager& manager,
+    const std::vector<std::pair<std::string, teddy::bdd_manager::diagram_t>>& outputs,
+    const std::vector<std::string>& variable_names, std::ostream& out,
+    const std::string& graph_name) {
+    std::vector<std::pair<std::string, teddy_iterator>> roots;
+    roots.reserve(outputs.size());
+    for (const auto& [name, diagram] : outputs) {
+        roots.emplace_back(name, teddy_iterator(diagram.unsafe_get_root(), &variable_names));
+    }
+
+    // Same BDD-specific format as write_teddy_to_dot()
+    dot_graph::DotConfig config;
+    config.graph_name = graph_name;
+    config.rankdir = "";
+    config.font_name = "";
+    config.default_node_shape = "";
+    config.default_node_style = "";
+    config.default_edge_style = "";
+    config.use_bdd_format = true;
+
+    dot_graph::generate_dot_graph(roots, out, config);
+}
+
+void write_teddy_outputs_nodes_to_stream(
+    const teddy::bdd_manager& manager,
+    const std::vector<std::pair<std::string, teddy::bdd_manager::diagram_t>>& outputs,
+    const std::vector<std::string>& variable_names, std::ostream& out, bool include_headers) {
+    std::vector<std::pair<std::string, teddy_iterator>> roots;
+    roots.reserve(outputs.size());
+    for (const auto& [name, diagram] : outputs) {
+        roots.emplace_back(name, teddy_iterator(diagram.unsafe_get_root(), &variable_names));
+    }
+
+    node_table::TextTableConfig config(include_headers,
+                                       "Shared BDD Node Table (topological ordering)");
+    node_table::generate_text_table(roots, out, config);
+}
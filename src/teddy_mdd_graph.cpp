@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file teddy_mdd_graph.cpp
+ * @brief TeDDy MDD graph generation using generic template systems implementation
+ *
+ * Implementation of the MDD DOT and node table output functions on top of
+ * teddy_mdd_iterator and the generic generators.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "teddy_mdd_graph.hpp"
+
+#include <iostream>
+
+#include "dot_graph_generator.hpp"
+#include "node_table_generator.hpp"
+#include "teddy_mdd_iterator.hpp"
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+void write_teddy_mdd_to_dot(teddy::imdd_manager::diagram_t diagram, const mdd_variables& variables,
+                            std::ostream& out, const std::string& graph_name) {
+    teddy_mdd_iterator root_iter(diagram.unsafe_get_root(), &variables);
+
+    // Same grouped shape format as BDDs; edges carry value labels
+    dot_graph::DotConfig config;
+    config.graph_name = graph_name;
+    config.rankdir = "";
+    config.font_name = "";
+    config.default_node_shape = "";
+    config.default_node_style = "";
+    config.default_edge_style = "";
+    config.use_bdd_format = true;
+
+    dot_graph::generate_dot_graph(root_iter, out, config);
+}
+
+void write_teddy_mdd_nodes_to_stream(teddy::imdd_manager::diagram_t diagram,
+                                     const mdd_variables& variables, std::ostream& out,
+                                     bool include_headers) {
+    teddy_mdd_iterator root_iter(diagram.unsafe_get_root(), &variables);
+
+    node_table::TextTableConfig config(include_headers, "MDD Node Table (topological ordering)");
+
+    node_table::generate_multiway_text_table(root_iter, out, config);
+}
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file truth_table.cpp
+ * @brief Bit-parallel truth tables implementation
+ *
+ * Builds tables by running the compiled expression over projection columns
+ * with the batch evaluator, converts them to TeDDy truth vectors, and exports
+ * them as C lookup functions.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "truth_table.hpp"
+
+#include <array>
+#include <bit>
+#include <format>
+#include <stdexcept>
+#include <unordered_map>
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+/// Word patterns of the variables that change within a word
+constexpr std::array<std::uint64_t, 6> low_patterns = {
+    0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
+
+/**
+ * @brief Column of variable @p index over all 2^n rows of a table
+ */
+std::vector<std::uint64_t> projection(std::size_t index, std::size_t words) {
+    std::vector<std::uint64_t> column(words);
+    for (std::size_t w = 0; w < words; ++w) {
+        if (index < 6) {
+            column[w] = low_patterns[index];
+        } else {
+            column[w] = ((w >> (index - 6)) & 1) != 0 ? ~std::uint64_t{0} : 0;
+        }
+    }
+    return column;
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (truth_table namespace)
+// ============================================================================
+
+namespace truth_table {
+
+table::table(std::size_t variable_count, std::vector<std::uint64_t> words)
+    : variable_count_(variable_count), words_(std::move(words)) {
+    if (variable_count_ > max_variables) {
+        throw std::runtime_error(std::format("Truth tables support at most {} variables, got {}",
+                                             max_variables, variable_count_));
+    }
+    if (words_.size() != batch_eval::words_for_rows(rows())) {
+        throw std::runtime_error(std::format("Truth table over {} variables needs {} words, got {}",
+                                             variable_count_,
+                                             batch_eval::words_for_rows(rows()), words_.size()));
+    }
+    if (rows() < 64) {
+        words_[0] &= (std::uint64_t{1} << rows()) - 1;
+    }
+}
+
+bool table::evaluate(std::span<const std::uint8_t> assignment) const {
+    if (assignment.size() < variable_count_) {
+        throw std::runtime_error("Assignment has " + std::to_string(assignment.size())
+                                 + " values, expected " + std::to_string(variable_count_));
+    }
+    std::uint64_t row = 0;
+    for (std::size_t i = 0; i < variable_count_; ++i) {
+        row |= std::uint64_t{assignment[i] != 0} << i;
+    }
+    return evaluate(row);
+}
+
+std::uint64_t table::count_true() const {
+    std::uint64_t count = 0;
+    for (auto word : words_) {
+        count += static_cast<std::uint64_t>(std::popcount(word));
+    }
+    return count;
+}
+
+table build(const my_expression& expr, const std::vector<std::string>& variable_names,
+            const batch_eval::evaluate_options& options) {
+    if (variable_names.size() > max_variables) {
+        throw std::runtime_error(std::format("Truth tables support at most {} variables, got {}",
+                                             max_variables, variable_names.size()));
+    }
+    std::unordered_map<std::string, std::size_t> position;
+    for (std::size_t i = 0; i < variable_names.size(); ++i) {
+        position.emplace(variable_names[i], i);
+    }
+
+    auto prog = batch_eval::compile_expression(expr);
+    batch_eval::column_batch batch;
+    batch.rows = std::size_t{1} << variable_names.size();
+    const std::size_t words = batch_eval::words_for_rows(batch.rows);
+    for (const auto& name : prog.inputs()) {
+        auto it = position.find(name);
+        if (it == position.end()) {
+            throw std::runtime_error("Variable '" + name + "' is missing from the truth table");
+        }
+        batch.columns.emplace(name, projection(it->second, words));
+    }
+    return table(variable_names.size(), batch_eval::evaluate(prog, batch, options));
+}
+
+teddy::bdd_manager::diagram_t to_teddy(const table& tt, teddy::bdd_manager& manager) {
+    const std::size_t n = tt.variable_count();
+    if (static_cast<std::size_t>(manager.get_var_count()) != n) {
+        throw std::runtime_error(std::format("Manager has {} variables, the truth table has {}",
+                                             manager.get_var_count(), n));
+    }
+
+    // TeDDy's truth vector has the variable at level 0 as its most significant digit
+    std::vector<std::uint64_t> weight(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto level = static_cast<std::size_t>(manager.get_level(static_cast<int>(i)));
+        weight[i] = std::uint64_t{1} << (n - 1 - level);
+    }
+    std::vector<teddy::int32> vector(tt.rows());
+    std::vector<std::uint64_t> position(tt.rows(), 0);
+    for (std::uint64_t row = 0; row < tt.rows(); ++row) {
+        // Each row extends the row without its lowest set bit
+        if (row != 0) {
+            position[row] = position[row & (row - 1)] + weight[std::countr_zero(row)];
+        }
+        vector[position[row]] = tt.evaluate(row) ? 1 : 0;
+    }
+    return manager.from_vector(vector);
+}
+
+void write_c_lookup(const table& tt, const std::vector<std::string>& variable_names,
+                    std::ostream& out, const std::string& function_name) {
+    out << "/*\n";
+    out << std::format(" * Truth table over {} variables ({} of {} rows true).\n",
+                       tt.variable_count(), tt.count_true(), tt.rows());
+    out << " * Generated code; regenerate instead of editing.\n";
+    out << " *\n";
+    out << " * Bit i of the row index is variable i:\n";
+    for (std::size_t i = 0; i < variable_names.size(); ++i) {
+        std::string label = variable_names[i];
+        for (auto pos = label.find("*/"); pos != std::string::npos; pos = label.find("*/")) {
+            label.replace(pos, 2, "* /");  // Keep the comment closed
+        }
+        out << std::format(" *   {}: {}\n", i, label);
+    }
+    out << " */\n\n";
+    out << "#include <stdint.h>\n\n";
+    out << "static const uint64_t " << function_name << "_table[" << tt.words().size()
+        << "] = {\n";
+    for (std::size_t w = 0; w < tt.words().size(); ++w) {
+        out << std::format("{}UINT64_C(0x{:016X}),", w % 4 == 0 ? "    " : " ", tt.words()[w]);
+        if (w % 4 == 3 || w + 1 == tt.words().size()) {
+            out << "\n";
+        }
+    }
+    out << "};\n\n";
+    out << "int " << function_name << "(uint32_t row) {\n";
+    out << std::format("    row &= UINT32_C(0x{:X});\n", tt.rows() - 1);
+    out << "    return (int)((" << function_name << "_table[row >> 6] >> (row & 63)) & 1u);\n";
+    out << "}\n";
+}
+
+}  // namespace truth_table
@@ -0,0 +1,619 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file workload_generator.cpp
+ * @brief Implementation of the synthetic workload generator
+ *
+ * Arithmetic families (adders and multipliers) are first built as a
+ * hash-consed gate circuit with constant folding and then expanded into the
+ * tree-shaped expression format. Because the file format has no sharing, the
+ * expanded size is computed up front and checked against
+ * GeneratorOptions::max_size before any text is produced.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include "workload_generator.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+using workload_generator::GeneratorOptions;
+
+/**
+ * @brief Formats a non-negative integer with leading zeros
+ */
+std::string zero_pad(int value, int width) {
+    std::string digits = std::to_string(value);
+    if (static_cast<int>(digits.size()) < width) {
+        digits.insert(0, static_cast<size_t>(width) - digits.size(), '0');
+    }
+    return digits;
+}
+
+/**
+ * @brief Number of decimal digits needed to print values in [0, max_value]
+ */
+int digit_width(int max_value) {
+    return static_cast<int>(std::to_string(std::max(max_value, 0)).size());
+}
+
+/**
+ * @brief Name of bit @p index of operand @p operand ('a' or 'b')
+ *
+ * Interleaved names (`i00_a`, `i00_b`, `i01_a`, ...) sort so that bits of equal
+ * significance are adjacent; blocked names (`a00`, ..., `b00`, ...) sort all of
+ * operand a before operand b.
+ */
+std::string operand_bit_name(char operand, int index, int width, bool interleaved) {
+    if (interleaved) {
+        return "i" + zero_pad(index, width) + "_" + operand;
+    }
+    return std::string(1, operand) + zero_pad(index, width);
+}
+
+/**
+ * @brief Joins constraint lines into a single conjunction, one per line
+ */
+std::string join_conjunction(const std::vector<std::string>& terms) {
+    std::string out;
+    for (size_t i = 0; i < terms.size(); ++i) {
+        out += terms[i];
+        out += (i + 1 < terms.size()) ? " AND\n" : "\n";
+    }
+    return out;
+}
+
+/**
+ * @brief Pairwise at-most-one constraint over the given literals
+ */
+std::vector<std::string> at_most_one(const std::vector<std::string>& vars) {
+    std::vector<std::string> terms;
+    for (size_t i = 0; i < vars.size(); ++i) {
+        for (size_t j = i + 1; j < vars.size(); ++j) {
+            terms.push_back("NOT (" + vars[i] + " AND " + vars[j] + ")");
+        }
+    }
+    return terms;
+}
+
+/**
+ * @brief Parenthesized disjunction of the given literals
+ */
+std::string any_of(const std::vector<std::string>& vars) {
+    std::string out = "(";
+    for (size_t i = 0; i < vars.size(); ++i) {
+        if (i > 0) {
+            out += " OR ";
+        }
+        out += vars[i];
+    }
+    return out + ")";
+}
+
+/**
+ * @brief Hash-consed Boolean gate circuit with constant folding
+ *
+ * Node 0 is constant false and node 1 is constant true. Inputs and gates are
+ * appended; identical gates are shared through the unique table.
+ */
+class Circuit {
+   public:
+    enum class Op {
+        Const,
+        Input,
+        Not,
+        And,
+        Or,
+        Xor
+    };
+
+    static constexpr int kFalse = 0;
+    static constexpr int kTrue = 1;
+
+    Circuit() {
+        nodes_.push_back({Op::Const, -1, -1, "0"});
+        nodes_.push_back({Op::Const, -1, -1, "1"});
+    }
+
+    int input(const std::string& name) {
+        nodes_.push_back({Op::Input, -1, -1, name});
+        return static_cast<int>(nodes_.size()) - 1;
+    }
+
+    int make_not(int a) {
+        if (a == kFalse || a == kTrue) {
+            return a == kFalse ? kTrue : kFalse;
+        }
+        if (nodes_[a].op == Op::Not) {
+            return nodes_[a].left;
+        }
+        return intern(Op::Not, a, -1);
+    }
+
+    int make_and(int a, int b) {
+        if (a == kFalse || b == kFalse) {
+            return kFalse;
+        }
+        if (a == kTrue) {
+            return b;
+        }
+        if (b == kTrue) {
+            return a;
+        }
+        if (a == b) {
+            return a;
+        }
+        return intern(Op::And, std::min(a, b), std::max(a, b));
+    }
+
+    int make_or(int a, int b) {
+        if (a == kTrue || b == kTrue) {
+            return kTrue;
+        }
+        if (a == kFalse) {
+            return b;
+        }
+        if (b == kFalse) {
+            return a;
+        }
+        if (a == b) {
+            return a;
+        }
+        return intern(Op::Or, std::min(a, b), std::max(a, b));
+    }
+
+    int make_xor(int a, int b) {
+        if (a == kFalse) {
+            return b;
+        }
+        if (b == kFalse) {
+            return a;
+        }
+        if (a == kTrue) {
+            return make_not(b);
+        }
+        if (b == kTrue) {
+            return make_not(a);
+        }
+        if (a == b) {
+            return kFalse;
+        }
+        return intern(Op::Xor, std::min(a, b), std::max(a, b));
+    }
+
+    /**
+     * @brief Number of AST nodes in the tree expansion of @p root
+     *
+     * Saturates at @p limit + 1 so that exponential expansions do not overflow.
+     */
+    size_t expanded_size(int root, size_t limit) const {
+        std::vector<size_t> size(nodes_.size(), 0);
+        for (size_t i = 0; i <= static_cast<size_t>(root); ++i) {
+            const auto& n = nodes_[i];
+            size_t s = 1;
+            if (n.left >= 0) {
+                s += size[n.left];
+            }
+            if (n.right >= 0) {
+                s += size[n.right];
+            }
+            size[i] = std::min(s, limit + 1);
+        }
+        return size[root];
+    }
+
+    void print(int root, std::ostream& out) const {
+        const auto& n = nodes_[root];
+        switch (n.op) {
+            case Op::Const:
+                throw std::runtime_error("Cannot print a constant circuit");
+            case Op::Input:
+                out << n.name;
+                break;
+            case Op::Not:
+                out << "NOT ";
+                print_operand(n.left, out);
+                break;
+            case Op::And:
+            case Op::Or:
+            case Op::Xor:
+                print_operand(n.left, out);
+                out << (n.op == Op::And ? " AND " : n.op == Op::Or ? " OR " : " XOR ");
+                print_operand(n.right, out);
+                break;
+        }
+    }
+
+   private:
+    struct Node {
+        Op op;
+        int left;
+        int right;
+        std::string name;
+    };
+
+    int intern(Op op, int a, int b) {
+        auto key = std::make_tuple(op, a, b);
+        auto it = unique_.find(key);
+        if (it != unique_.end()) {
+            return it->second;
+        }
+        nodes_.push_back({op, a, b, {}});
+        int id = static_cast<int>(nodes_.size()) - 1;
+        unique_.emplace(key, id);
+        return id;
+    }
+
+    void print_operand(int id, std::ostream& out) const {
+        if (nodes_[id].op == Op::Input) {
+            out << nodes_[id].name;
+        } else {
+            out << "(";
+            print(id, out);
+            out << ")";
+        }
+    }
+
+    std::vector<Node> nodes_;
+    std::map<std::tuple<Op, int, int>, int> unique_;
+};
+
+/**
+ * @brief Expands a circuit output to text, enforcing the size guard
+ */
+std::string circuit_to_expression(const Circuit& circuit, int root, size_t max_size) {
+    if (root == Circuit::kFalse || root == Circuit::kTrue) {
+        throw std::runtime_error("Selected output bit is constant");
+    }
+    size_t size = circuit.expanded_size(root, max_size);
+    if (size > max_size) {
+        throw std::runtime_error("Expanded expression exceeds " + std::to_string(max_size) +
+                                 " nodes; increase --max-size or reduce --n");
+    }
+    std::ostringstream out;
+    circuit.print(root, out);
+    out << "\n";
+    return out.str();
+}
+
+/**
+ * @brief Creates the two n-bit operand vectors in the requested order
+ */
+std::pair<std::vector<int>, std::vector<int>> make_operands(Circuit& circuit,
+                                                            const GeneratorOptions& options) {
+    int width = std::max(2, digit_width(options.n - 1));
+    std::vector<int> a;
+    std::vector<int> b;
+    for (int i = 0; i < options.n; ++i) {
+        a.push_back(circuit.input(operand_bit_name('a', i, width, options.interleaved)));
+        b.push_back(circuit.input(operand_bit_name('b', i, width, options.interleaved)));
+    }
+    return {a, b};
+}
+
+/**
+ * @brief Ripple-carry addition of two bit vectors (LSB first)
+ *
+ * @return Sum bits followed by the final carry
+ */
+std::vector<int> ripple_add(Circuit& circuit, const std::vector<int>& a,
+                            const std::vector<int>& b) {
+    std::vector<int> out;
+    int carry = Circuit::kFalse;
+    for (size_t i = 0; i < a.size(); ++i) {
+        int half = circuit.make_xor(a[i], b[i]);
+        out.push_back(circuit.make_xor(half, carry));
+        carry = circuit.make_or(circuit.make_and(a[i], b[i]),
+                                circuit.make_and(circuit.make_or(a[i], b[i]), carry));
+    }
+    out.push_back(carry);
+    return out;
+}
+
+/**
+ * @brief Parses a packet filter field specification ("name:width,...")
+ */
+std::vector<std::pair<std::string, int>> parse_fields(const std::string& spec) {
+    std::vector<std::pair<std::string, int>> fields;
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        auto colon = item.find(':');
+        if (colon == std::string::npos || colon == 0) {
+            throw std::invalid_argument("Invalid field specification: '" + item +
+                                        "' (expected name:width)");
+        }
+        std::string name = item.substr(0, colon);
+        for (char c : name) {
+            if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+                throw std::invalid_argument("Invalid field name: '" + name + "'");
+            }
+        }
+        int width = 0;
+        try {
+            width = std::stoi(item.substr(colon + 1));
+        } catch (const std::exception&) {
+            throw std::invalid_argument("Invalid field width in: '" + item + "'");
+        }
+        if (width < 1 || width > 64) {
+            throw std::invalid_argument("Field width must be between 1 and 64: '" + item + "'");
+        }
+        fields.emplace_back(name, width);
+    }
+    if (fields.empty()) {
+        throw std::invalid_argument("Field specification must name at least one field");
+    }
+    return fields;
+}
+
+void require_positive_n(const GeneratorOptions& options) {
+    if (options.n < 1) {
+        throw std::invalid_argument("n must be at least 1");
+    }
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions
+// ============================================================================
+
+namespace workload_generator {
+
+const std::vector<std::string>& family_names() {
+    static const std::vector<std::string> names = {"nqueens", "cnf",        "parity",
+                                                   "adder",   "multiplier", "filter"};
+    return names;
+}
+
+std::string generate_n_queens(const GeneratorOptions& options) {
+    require_positive_n(options);
+    const int n = options.n;
+    const int width = digit_width(n);
+    auto q = [&](int r, int c) { return "q_" + zero_pad(r, width) + "_" + zero_pad(c, width); };
+
+    std::vector<std::string> terms;
+
+    // Exactly one queen per row
+    for (int r = 1; r <= n; ++r) {
+        std::vector<std::string> row;
+        for (int c = 1; c <= n; ++c) {
+            row.push_back(q(r, c));
+        }
+        terms.push_back(any_of(row));
+        for (auto& t : at_most_one(row)) {
+            terms.push_back(std::move(t));
+        }
+    }
+
+    // At most one queen per column (with one per row this forces exactly one)
+    for (int c = 1; c <= n; ++c) {
+        std::vector<std::string> col;
+        for (int r = 1; r <= n; ++r) {
+            col.push_back(q(r, c));
+        }
+        for (auto& t : at_most_one(col)) {
+            terms.push_back(std::move(t));
+        }
+    }
+
+    // At most one queen per diagonal and anti-diagonal
+    for (int d = -(n - 1); d <= n - 1; ++d) {
+        std::vector<std::string> diag;
+        std::vector<std::string> anti;
+        for (int r = 1; r <= n; ++r) {
+            int c = r + d;
+            if (c >= 1 && c <= n) {
+                diag.push_back(q(r, c));
+            }
+            int ac = n + 1 - r + d;
+            if (ac >= 1 && ac <= n) {
+                anti.push_back(q(r, ac));
+            }
+        }
+        for (auto& t : at_most_one(diag)) {
+            terms.push_back(std::move(t));
+        }
+        for (auto& t : at_most_one(anti)) {
+            terms.push_back(std::move(t));
+        }
+    }
+
+    std::string out = "# " + std::to_string(n) + "-Queens problem (generated)\n";
+    out += "# Variables: q_r_c represents a queen at row r, column c (1-indexed)\n";
+    out += "# Exactly one queen per row, at most one per column and diagonal\n";
+    return out + join_conjunction(terms);
+}
+
+std::string generate_random_cnf(const GeneratorOptions& options) {
+    require_positive_n(options);
+    if (options.k < 1 || options.k > options.n) {
+        throw std::invalid_argument("k must be between 1 and n");
+    }
+    if (!(options.ratio > 0.0)) {
+        throw std::invalid_argument("ratio must be positive");
+    }
+
+    std::mt19937_64 rng(options.seed);
+    const int width = digit_width(options.n - 1);
+    const int clauses =
+        std::max(1, static_cast<int>(std::lround(options.ratio * static_cast<double>(options.n))));
+
+    std::vector<int> pool(static_cast<size_t>(options.n));
+    std::iota(pool.begin(), pool.end(), 0);
+
+    std::vector<std::string> terms;
+    for (int i = 0; i < clauses; ++i) {
+        // Partial Fisher-Yates shuffle selects k distinct variables
+        for (int j = 0; j < options.k; ++j) {
+            std::uniform_int_distribution<int> pick(j, options.n - 1);
+            std::swap(pool[j], pool[pick(rng)]);
+        }
+        std::vector<std::string> literals;
+        for (int j = 0; j < options.k; ++j) {
+            std::string var = "x" + zero_pad(pool[j], width);
+            literals.push_back((rng() & 1) ? "NOT " + var : var);
+        }
+        terms.push_back(any_of(literals));
+    }
+
+    std::string out = "# Random " + std::to_string(options.k) + "-CNF (generated)\n";
+    out += "# Variables: " + std::to_string(options.n) + ", clauses: " + std::to_string(clauses) +
+           ", seed: " + std::to_string(options.seed) + "\n";
+    return out + join_conjunction(terms);
+}
+
+std::string generate_parity_chain(const GeneratorOptions& options) {
+    require_positive_n(options);
+    std::mt19937_64 rng(options.seed);
+    const int width = digit_width(options.n - 1);
+
+    std::string out =
+        "# Parity chain over " + std::to_string(options.n) + " variables (generated)\n";
+    out += "# Seed: " + std::to_string(options.seed) + "\n";
+    for (int i = 0; i < options.n; ++i) {
+        std::string var = "x" + zero_pad(i, width);
+        std::string literal = (rng() & 1) ? "(NOT " + var + ")" : var;
+        out += literal;
+        out += (i + 1 < options.n) ? " XOR\n" : "\n";
+    }
+    return out;
+}
+
+std::string generate_adder_bit(const GeneratorOptions& options) {
+    require_positive_n(options);
+    const int bit = options.bit < 0 ? options.n : options.bit;
+    if (bit > options.n) {
+        throw std::invalid_argument("Adder bit must be between 0 and n");
+    }
+
+    Circuit circuit;
+    auto [a, b] = make_operands(circuit, options);
+    std::vector<int> sum = ripple_add(circuit, a, b);
+
+    std::string out = "# " + std::to_string(options.n) + "-bit ripple-carry adder, " +
+                      (bit == options.n ? std::string("carry-out")
+                                        : "sum bit " + std::to_string(bit)) +
+                      " (generated)\n";
+    out += std::string("# Variable order: ") + (options.interleaved ? "interleaved" : "blocked") +
+           "\n";
+    return out + circuit_to_expression(circuit, sum[bit], options.max_size);
+}
+
+std::string generate_multiplier_bit(const GeneratorOptions& options) {
+    require_positive_n(options);
+    const int bit = options.bit < 0 ? options.n - 1 : options.bit;
+    if (bit > 2 * options.n - 1) {
+        throw std::invalid_argument("Multiplier bit must be between 0 and 2n-1");
+    }
+
+    Circuit circuit;
+    auto [a, b] = make_operands(circuit, options);
+
+    // Shift-and-add: accumulate partial products a * b_j << j
+    std::vector<int> acc(static_cast<size_t>(2 * options.n), Circuit::kFalse);
+    for (int j = 0; j < options.n; ++j) {
+        std::vector<int> partial(acc.size(), Circuit::kFalse);
+        for (int i = 0; i < options.n; ++i) {
+            partial[i + j] = circuit.make_and(a[i], b[j]);
+        }
+        std::vector<int> next = ripple_add(circuit, acc, partial);
+        next.pop_back();
+        acc = std::move(next);
+    }
+
+    std::string out = "# " + std::to_string(options.n) + "x" + std::to_string(options.n) +
+                      " multiplier, product bit " + std::to_string(bit) + " (generated)\n";
+    out += std::string("# Variable order: ") + (options.interleaved ? "interleaved" : "blocked") +
+           "\n";
+    return out + circuit_to_expression(circuit, acc[bit], options.max_size);
+}
+
+std::string generate_packet_filter(const GeneratorOptions& options) {
+    if (options.rules < 1) {
+        throw std::invalid_argument("rules must be at least 1");
+    }
+    auto fields = parse_fields(options.fields);
+    std::mt19937_64 rng(options.seed);
+
+    std::vector<std::string> rules;
+    for (int r = 0; r < options.rules; ++r) {
+        std::vector<std::string> matches;
+        for (size_t f = 0; f < fields.size(); ++f) {
+            const auto& [name, width] = fields[f];
+            // Each field is constrained with probability 1/2 (at least one per rule)
+            bool last_chance = matches.empty() && f + 1 == fields.size();
+            if ((rng() & 1) == 0 && !last_chance) {
+                continue;
+            }
+            std::uniform_int_distribution<int> prefix_dist(1, width);
+            int prefix = (rng() & 1) ? width : prefix_dist(rng);
+            const int idx_width = digit_width(width - 1);
+            for (int bit = 0; bit < prefix; ++bit) {
+                // Bit 0 is the most significant bit of the field
+                std::string var = name + "_" + zero_pad(bit, idx_width);
+                matches.push_back((rng() & 1) ? var : "NOT " + var);
+            }
+        }
+        std::string rule = "(";
+        for (size_t i = 0; i < matches.size(); ++i) {
+            if (i > 0) {
+                rule += " AND ";
+            }
+            rule += matches[i];
+        }
+        rules.push_back(rule + ")");
+    }
+
+    std::string out = "# Packet filter with " + std::to_string(options.rules) +
+                      " rules (generated)\n";
+    out += "# Fields: " + options.fields + ", seed: " + std::to_string(options.seed) + "\n";
+    for (size_t i = 0; i < rules.size(); ++i) {
+        out += rules[i];
+        out += (i + 1 < rules.size()) ? " OR\n" : "\n";
+    }
+    return out;
+}
+
+std::string generate_workload(const std::string& family, const GeneratorOptions& options) {
+    if (family == "nqueens") {
+        return generate_n_queens(options);
+    }
+    if (family == "cnf") {
+        return generate_random_cnf(options);
+    }
+    if (family == "parity") {
+        return generate_parity_chain(options);
+    }
+    if (family == "adder") {
+        return generate_adder_bit(options);
+    }
+    if (family == "multiplier") {
+        return generate_multiplier_bit(options);
+    }
+    if (family == "filter") {
+        return generate_packet_filter(options);
+    }
+    throw std::invalid_argument("Unknown workload family: " + family);
+}
+
+}  // namespace workload_generator
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file workload_generator_main.cpp
+ * @brief Command line front end for the synthetic workload generator
+ *
+ * Writes a generated expression file for one of the supported problem
+ * families to stdout or to a file, so that stress inputs of any size can be
+ * produced reproducibly instead of being committed by hand.
+ *
+ * @author Alan Jowett
+ * @date 2025
+ * @copyright Copyright (c) 2025 Alan Jowett. Licensed under the MIT License
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "workload_generator.hpp"
+
+// ============================================================================
+// Anonymous namespace for implementation details
+// ============================================================================
+
+namespace {
+
+void print_help() {
+    std::cout << "BDD Workload Generator - Synthetic expression files for stress testing\n";
+    std::cout << "======================================================================\n\n";
+    std::cout << "Usage: bdd_workload_gen <family> [options]\n\n";
+    std::cout << "Families:\n";
+    std::cout << "  nqueens               N-Queens constraints on an n x n board\n";
+    std::cout << "  cnf                   Random k-CNF with round(ratio * n) clauses\n";
+    std::cout << "  parity                Parity chain over n variables\n";
+    std::cout << "  adder                 One output bit of an n-bit ripple-carry adder\n";
+    std::cout << "  multiplier            One product bit of an n x n multiplier\n";
+    std::cout << "  filter                Packet-filter-like disjunction of field matches\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --n=<int>             Problem size (default 8)\n";
+    std::cout << "  --seed=<int>          Random seed (default 1)\n";
+    std::cout << "  --k=<int>             Literals per clause for cnf (default 3)\n";
+    std::cout << "  --ratio=<float>       Clause/variable ratio for cnf (default 4.26)\n";
+    std::cout << "  --bit=<int>           Output bit for adder (default carry-out) or "
+                 "multiplier (default n-1)\n";
+    std::cout << "  --rules=<int>         Number of rules for filter (default 16)\n";
+    std::cout << "  --fields=<spec>       Filter fields as name:width,... (default "
+                 "proto:8,port:16,ttl:8)\n";
+    std::cout << "  --order=interleaved   Interleave operand bits for adder/multiplier "
+                 "(default)\n";
+    std::cout << "  --order=blocked       Order all bits of operand a before operand b\n";
+    std::cout << "  --max-size=<int>      Maximum expanded expression nodes (default 5000000)\n";
+    std::cout << "  --output=<file>, -o <file>\n";
+    std::cout << "                        Write to file instead of stdout\n";
+    std::cout << "  --help, -h            Show this help message\n";
+}
+
+}  // end anonymous namespace
+
+// ============================================================================
+// Exported functions (global namespace)
+// ============================================================================
+
+/**
+ * @brief Workload generator entry point
+ *
+ * @param argc Number of command line arguments
+ * @param argv Array of command line argument strings
+ * @return 0 on success, 1 on error
+ */
+int main(int argc, const char* argv[]) {
+    workload_generator::GeneratorOptions options;
+    std::string family;
+    std::filesystem::path output_file;
+    bool show_help = false;
+    bool help_due_to_error = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg.starts_with("--n=")) {
+                options.n = std::stoi(arg.substr(4));
+            } else if (arg.starts_with("--seed=")) {
+                options.seed = std::stoull(arg.substr(7));
+            } else if (arg.starts_with("--k=")) {
+                options.k = std::stoi(arg.substr(4));
+            } else if (arg.starts_with("--ratio=")) {
+                options.ratio = std::stod(arg.substr(8));
+            } else if (arg.starts_with("--bit=")) {
+                options.bit = std::stoi(arg.substr(6));
+            } else if (arg.starts_with("--rules=")) {
+                options.rules = std::stoi(arg.substr(8));
+            } else if (arg.starts_with("--fields=")) {
+                options.fields = arg.substr(9);
+            } else if (arg == "--order=interleaved") {
+                options.interleaved = true;
+            } else if (arg == "--order=blocked") {
+                options.interleaved = false;
+            } else if (arg.starts_with("--max-size=")) {
+                options.max_size = std::stoull(arg.substr(11));
+            } else if (arg.starts_with("--output=")) {
+                output_file = arg.substr(9);
+            } else if (arg == "-o" && i + 1 < argc) {
+                output_file = argv[++i];
+            } else if (arg == "--help" || arg == "-h") {
+                show_help = true;
+                break;
+            } else if (arg.starts_with("-")) {
+                std::cerr << "Unknown option: " << arg << "\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            } else if (family.empty()) {
+                family = arg;
+            } else {
+                std::cerr << "Multiple families specified. Only one family is allowed.\n";
+                show_help = true;
+                help_due_to_error = true;
+                break;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric option value\n";
+        return 1;
+    }
+
+    if (!show_help && family.empty()) {
+        std::cerr << "No workload family specified\n";
+        show_help = true;
+        help_due_to_error = true;
+    }
+
+    if (show_help) {
+        print_help();
+        return help_due_to_error ? 1 : 0;
+    }
+
+    std::string contents;
+    try {
+        contents = workload_generator::generate_workload(family, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error generating workload: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (output_file.empty()) {
+        std::cout << contents;
+        return 0;
+    }
+
+    std::ofstream out(output_file);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not create output file '" << output_file.string() << "'\n";
+        return 1;
+    }
+    out << contents;
+    std::cerr << "Workload written to '" << output_file.string() << "'\n";
+    return 0;
+}
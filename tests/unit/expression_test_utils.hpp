@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include "expression_parser.hpp"
+
+// Shared test helper for a temporary file name that no other test process uses.
+// ctest runs test cases as separate processes, so the name mixes a random value drawn
+// once per process with a per-process counter.
+inline std::filesystem::path unique_temp_path(const std::string& prefix,
+                                              const std::string& suffix = ".txt") {
+    static const std::uint64_t process_tag =
+        (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    static std::atomic<std::uint64_t> counter{0};
+    return std::filesystem::temp_directory_path()
+           / std::format("{}{:016x}_{}{}", prefix, process_tag, counter++, suffix);
+}
+
+// Shared test helper that writes @p contents to a new temporary file and returns its path
+inline std::filesystem::path write_temp_file(const std::string& prefix,
+                                             const std::string& contents) {
+    auto path = unique_temp_path(prefix);
+    std::ofstream(path) << contents;
+    return path;
+}
+
+// Shared test helper that parses expression text through the regular file reader
+inline my_expression_ptr parse_text(const std::string& contents) {
+    const auto path = write_temp_file("test_expression_", contents);
+    auto expr = read_expression_from_file(path.string());
+    std::filesystem::remove(path);
+    return expr;
+}
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_batch_evaluator.cpp
+ * @brief Tests for the bit-sliced batch evaluator
+ *
+ * Checks program construction, exhaustive evaluation of compiled expressions
+ * with every supported instruction set, agreement of programs compiled from
+ * TeDDy and CUDD diagrams, and input validation.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <cudd/cuddObj.hh>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "batch_evaluator.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "teddy_convert.hpp"
+
+namespace {
+
+// Batch whose row r assigns bit i of r to input i, covering every assignment
+batch_eval::column_batch exhaustive_batch(const std::vector<std::string>& inputs) {
+    batch_eval::column_batch batch;
+    batch.rows = size_t{1} << inputs.size();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        std::vector<std::uint64_t> column(batch_eval::words_for_rows(batch.rows), 0);
+        for (size_t r = 0; r < batch.rows; ++r) {
+            if ((r >> i) & 1) {
+                column[r / 64] |= std::uint64_t{1} << (r % 64);
+            }
+        }
+        batch.columns.emplace(inputs[i], std::move(column));
+    }
+    return batch;
+}
+
+bool row_value(const std::vector<std::uint64_t>& result, size_t r) {
+    return ((result[r / 64] >> (r % 64)) & 1) != 0;
+}
+
+std::vector<batch_eval::isa> supported_isas() {
+    std::vector<batch_eval::isa> isas;
+    for (auto value : {batch_eval::isa::scalar, batch_eval::isa::avx2, batch_eval::isa::avx512}) {
+        if (batch_eval::isa_supported(value)) {
+            isas.push_back(value);
+        }
+    }
+    return isas;
+}
+
+}  // namespace
+
+TEST_CASE("batch_eval: program folds constants and trivial operations", "[batch_eval]") {
+    batch_eval::program prog({"a", "b"});
+    const auto a = prog.input("a");
+    const auto b = prog.input("b");
+
+    REQUIRE(prog.apply_and(a, prog.one()) == a);
+    REQUIRE(prog.apply_and(a, prog.zero()) == prog.zero());
+    REQUIRE(prog.apply_or(a, a) == a);
+    REQUIRE(prog.apply_xor(b, b) == prog.zero());
+    REQUIRE(prog.apply_not(prog.zero()) == prog.one());
+    REQUIRE(prog.ite(a, prog.one(), prog.zero()) == a);
+    REQUIRE(prog.ite(prog.one(), a, b) == a);
+    REQUIRE(prog.code().empty());
+
+    auto mux = prog.ite(a, b, prog.apply_not(b));
+    REQUIRE(prog.code().size() == 2);
+    REQUIRE(prog.code().back().op == batch_eval::opcode::op_mux);
+    REQUIRE(mux == prog.first_result() + 1);
+    REQUIRE_THROWS_AS(prog.input("c"), std::runtime_error);
+}
+
+TEST_CASE("batch_eval: expression programs match exhaustive evaluation", "[batch_eval]") {
+    auto expr = parse_text("EXACTLY_K(2, a, b, c, d) XOR (x[3] < 5 AND NOT e)");
+    auto prog = batch_eval::compile_expression(*expr);
+    REQUIRE(prog.inputs()
+            == std::vector<std::string>{"a", "b", "c", "d", "e", "x[2]", "x[1]", "x[0]"});
+
+    auto batch = exhaustive_batch(prog.inputs());
+    for (auto instruction_set : supported_isas()) {
+        for (unsigned threads : {1u, 3u}) {
+            batch_eval::evaluate_options options;
+            options.instruction_set = instruction_set;
+            options.threads = threads;
+            options.tile_words = 8;
+            auto result = batch_eval::evaluate(prog, batch, options);
+            REQUIRE(result.size() == 4);
+
+            for (size_t r = 0; r < batch.rows; ++r) {
+                auto bit = [r](size_t i) { return ((r >> i) & 1) != 0; };
+                int count = bit(0) + bit(1) + bit(2) + bit(3);
+                unsigned x = (bit(5) ? 4u : 0u) | (bit(6) ? 2u : 0u) | (bit(7) ? 1u : 0u);
+                bool expected = (count == 2) != (x < 5 && !bit(4));
+                INFO("isa=" << batch_eval::isa_name(instruction_set) << " threads=" << threads
+                            << " row=" << r);
+                REQUIRE(row_value(result, r) == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("batch_eval: TeDDy and CUDD programs agree with the expression", "[batch_eval]") {
+    auto expr = parse_text("(a AND b) OR (c XOR d) OR NOT (e OR f) OR AT_MOST_K(1, a, c, e)");
+    std::unordered_set<std::string> variable_names;
+    collect_variables_with_dag_walker(*expr, variable_names);
+    auto ordered = ordered_variable_names(variable_names);
+
+    teddy::bdd_manager manager(static_cast<int>(ordered.size()), 1'000);
+    auto f = convert_to_bdd(*expr, manager);
+    auto [cudd_mgr, bdd] = convert_to_cudd_bdd(*expr, variable_names);
+
+    auto from_expr = batch_eval::compile_expression(*expr);
+    auto from_teddy = batch_eval::compile_teddy(f, ordered);
+    auto from_cudd = batch_eval::compile_cudd(bdd, ordered);
+    REQUIRE(from_teddy.inputs() == from_expr.inputs());
+    REQUIRE(from_cudd.inputs() == from_expr.inputs());
+
+    // Random rows with a partial last word
+    batch_eval::column_batch batch;
+    batch.rows = 64 * 156 + 37;
+    std::mt19937_64 rng(42);
+    for (const auto& name : ordered) {
+        std::vector<std::uint64_t> column(batch_eval::words_for_rows(batch.rows));
+        for (auto& word : column) {
+            word = rng();
+        }
+        batch.columns.emplace(name, std::move(column));
+    }
+
+    batch_eval::evaluate_options options;
+    options.threads = 4;
+    auto expected = batch_eval::evaluate(from_expr, batch, options);
+    REQUIRE(expected.back() >> 37 == 0);
+    for (auto instruction_set : supported_isas()) {
+        options.instruction_set = instruction_set;
+        REQUIRE(batch_eval::evaluate(from_teddy, batch, options) == expected);
+        REQUIRE(batch_eval::evaluate(from_cudd, batch, options) == expected);
+    }
+}
+
+TEST_CASE("batch_eval - negative: invalid inputs and options", "[batch_eval][negative]") {
+    auto expr = parse_text("a AND b");
+    auto prog = batch_eval::compile_expression(*expr);
+
+    batch_eval::column_batch batch;
+    batch.rows = 100;
+    batch.columns.emplace("a", std::vector<std::uint64_t>(2, ~0ull));
+    REQUIRE_THROWS_AS(batch_eval::evaluate(prog, batch), std::runtime_error);
+
+    batch.columns.emplace("b", std::vector<std::uint64_t>(1, ~0ull));
+    REQUIRE_THROWS_AS(batch_eval::evaluate(prog, batch), std::runtime_error);
+
+    batch.columns["b"].resize(2, ~0ull);
+    auto result = batch_eval::evaluate(prog, batch);
+    REQUIRE(result == std::vector<std::uint64_t>{~0ull, (1ull << 36) - 1});
+
+    batch_eval::evaluate_options options;
+    options.tile_words = 12;
+    REQUIRE_THROWS_AS(batch_eval::evaluate(prog, batch, options), std::runtime_error);
+
+    REQUIRE(batch_eval::parse_isa("avx2") == batch_eval::isa::avx2);
+    REQUIRE_THROWS_AS(batch_eval::parse_isa("neon"), std::runtime_error);
+}
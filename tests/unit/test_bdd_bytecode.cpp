@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_bdd_bytecode.cpp
+ * @brief Tests for the BDD bytecode compiler, verifier and interpreter
+ *
+ * Checks the forward-only layout, agreement of TeDDy and CUDD compilation with
+ * the source diagram, the serialized round trip, and rejection of malformed
+ * bytecode by the verifier.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cudd/cuddObj.hh>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "bdd_bytecode.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "teddy_convert.hpp"
+
+namespace {
+
+using bdd_bytecode::opcode;
+
+// TeDDy manager and diagram for an expression, with the variable order used
+struct teddy_fixture {
+    std::vector<std::string> ordered;
+    teddy::bdd_manager manager;
+    teddy::bdd_manager::diagram_t f;
+
+    explicit teddy_fixture(const my_expression& expr)
+        : ordered(make_order(expr)),
+          manager(static_cast<int>(ordered.size()), 1'000),
+          f(convert_to_bdd(expr, manager)) {}
+
+    static std::vector<std::string> make_order(const my_expression& expr) {
+        std::unordered_set<std::string> names;
+        collect_variables_with_dag_walker(expr, names);
+        return ordered_variable_names(names);
+    }
+};
+
+std::vector<std::uint8_t> assignment_bytes(size_t row, size_t count) {
+    std::vector<std::uint8_t> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<std::uint8_t>((row >> i) & 1);
+    }
+    return values;
+}
+
+std::uint8_t op(opcode value) {
+    return static_cast<std::uint8_t>(value);
+}
+
+}  // namespace
+
+TEST_CASE("bdd_bytecode: TeDDy compilation is forward only and exact", "[bdd_bytecode]") {
+    auto expr = parse_text("(a AND b) OR (c AND d) OR (e XOR f)");
+    teddy_fixture fx(*expr);
+    auto prog = bdd_bytecode::compile_teddy(fx.f, fx.ordered);
+
+    // One 7-byte test per decision node plus the two returns
+    const auto& code = prog.code();
+    const size_t decisions = fx.manager.get_node_count(fx.f) - 2;
+    REQUIRE(code.size() == decisions * 7 + 2);
+    REQUIRE(code[code.size() - 2] == op(opcode::ret_false));
+    REQUIRE(code[code.size() - 1] == op(opcode::ret_true));
+    size_t fall_through = 0;
+    for (size_t pc = 0; pc + 2 < code.size(); pc += 7) {
+        REQUIRE(code[pc] == op(opcode::test));
+        fall_through += (code[pc + 3] | (code[pc + 4] << 8)) == 0 ? 1 : 0;
+    }
+    // The low child of most nodes is placed right after its parent
+    REQUIRE(fall_through > 0);
+
+    const size_t n = fx.ordered.size();
+    for (size_t row = 0; row < (size_t{1} << n); ++row) {
+        auto values = assignment_bytes(row, n);
+        std::vector<int> ints(values.begin(), values.end());
+        INFO("row=" << row);
+        REQUIRE(prog.evaluate(values) == (fx.manager.evaluate(fx.f, ints) == 1));
+    }
+}
+
+TEST_CASE("bdd_bytecode: CUDD compilation resolves complement edges", "[bdd_bytecode]") {
+    auto expr = parse_text("(a XOR b XOR c) AND NOT (d AND e) OR EXACTLY_ONE(a, d, f)");
+    teddy_fixture fx(*expr);
+    std::unordered_set<std::string> names(fx.ordered.begin(), fx.ordered.end());
+    auto [cudd_mgr, bdd] = convert_to_cudd_bdd(*expr, names);
+
+    auto from_teddy = bdd_bytecode::compile_teddy(fx.f, fx.ordered);
+    auto from_cudd = bdd_bytecode::compile_cudd(bdd, fx.ordered);
+
+    const size_t n = fx.ordered.size();
+    const size_t rows = size_t{1} << n;
+    std::vector<std::uint8_t> all_rows;
+    for (size_t row = 0; row < rows; ++row) {
+        auto values = assignment_bytes(row, n);
+        all_rows.insert(all_rows.end(), values.begin(), values.end());
+    }
+    std::vector<std::uint8_t> expected(rows);
+    std::vector<std::uint8_t> actual(rows);
+    from_teddy.evaluate_batch(all_rows, expected);
+    from_cudd.evaluate_batch(all_rows, actual);
+    REQUIRE(actual == expected);
+
+    for (size_t row = 0; row < rows; ++row) {
+        auto values = assignment_bytes(row, n);
+        std::vector<int> ints(values.begin(), values.end());
+        REQUIRE((expected[row] == 1) == (fx.manager.evaluate(fx.f, ints) == 1));
+    }
+}
+
+TEST_CASE("bdd_bytecode: serialize round trip and disassembly", "[bdd_bytecode]") {
+    auto expr = parse_text("x[4] >= 5 AND (flag OR x[4] == 12)");
+    teddy_fixture fx(*expr);
+    auto prog = bdd_bytecode::compile_teddy(fx.f, fx.ordered);
+
+    auto wire = prog.serialize();
+    auto copy = bdd_bytecode::program::deserialize(wire);
+    REQUIRE(copy.code() == prog.code());
+    REQUIRE(copy.variable_names() == prog.variable_names());
+
+    const size_t n = fx.ordered.size();
+    for (size_t row = 0; row < (size_t{1} << n); ++row) {
+        auto values = assignment_bytes(row, n);
+        REQUIRE(copy.evaluate(values) == prog.evaluate(values));
+    }
+
+    auto listing = prog.disassemble();
+    REQUIRE(listing.find("     0: test ") == 0);
+    REQUIRE(listing.find(": ret false\n") != std::string::npos);
+    REQUIRE(listing.find(": ret true\n") != std::string::npos);
+}
+
+TEST_CASE("bdd_bytecode: constant functions and wide instructions", "[bdd_bytecode]") {
+    auto expr = parse_text("(a AND NOT a) OR (b AND NOT b)");
+    teddy_fixture fx(*expr);
+    auto prog = bdd_bytecode::compile_teddy(fx.f, fx.ordered);
+    REQUIRE(prog.code() == std::vector<std::uint8_t>{op(opcode::ret_false)});
+    REQUIRE_FALSE(prog.evaluate(std::vector<std::uint8_t>{1, 1}));
+
+    // Hand-written wide test: variable 1, false -> ret_false, true -> ret_true
+    std::vector<std::uint8_t> wide = {op(opcode::test_wide), 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0,
+                                      op(opcode::ret_false), op(opcode::ret_true)};
+    bdd_bytecode::program wide_prog(wide, {"a", "b"});
+    REQUIRE(wide_prog.evaluate(std::vector<std::uint8_t>{0, 1}));
+    REQUIRE_FALSE(wide_prog.evaluate(std::vector<std::uint8_t>{1, 0}));
+}
+
+TEST_CASE("bdd_bytecode - negative: verifier rejects malformed code", "[bdd_bytecode][negative]") {
+    using bdd_bytecode::verify;
+    const std::uint8_t test = op(opcode::test);
+    const std::uint8_t ret0 = op(opcode::ret_false);
+    const std::uint8_t ret1 = op(opcode::ret_true);
+
+    // Valid: test a, false -> ret_false, true -> ret_true
+    REQUIRE_NOTHROW(verify(std::vector<std::uint8_t>{test, 0, 0, 0, 0, 1, 0, ret0, ret1}, 1));
+
+    REQUIRE_THROWS_AS(verify(std::vector<std::uint8_t>{}, 1), std::runtime_error);
+    // Unknown opcode
+    REQUIRE_THROWS_AS(verify(std::vector<std::uint8_t>{0x7F}, 1), std::runtime_error);
+    // Truncated instruction
+    REQUIRE_THROWS_AS(verify(std::vector<std::uint8_t>{test, 0, 0, 0}, 1), std::runtime_error);
+    // Variable out of range
+    REQUIRE_THROWS_AS(verify(std::vector<std::uint8_t>{test, 1, 0, 0, 0, 1, 0, ret0, ret1}, 1),
+                      std::runtime_error);
+    // Jump past the end
+    REQUIRE_THROWS_AS(verify(std::vector<std::uint8_t>{test, 0, 0, 0, 0, 2, 0, ret0, ret1}, 1),
+                      std::runtime_error);
+    // Jump into the middle of an instruction
+    REQUIRE_THROWS_AS(
+        verify(std::vector<std::uint8_t>{test, 0, 0, 1, 0, 7, 0, test, 0, 0, 0, 0, 1, 0, ret0,
+                                         ret1},
+               1),
+        std::runtime_error);
+    // A test at the end has nowhere to jump
+    REQUIRE_THROWS_AS(verify(std::vector<std::uint8_t>{ret0, test, 0, 0, 0, 0, 0, 0}, 1),
+                      std::runtime_error);
+
+    REQUIRE_THROWS_AS(bdd_bytecode::program({test, 0, 0, 0, 0, 1, 0, ret0, ret1}, {}),
+                      std::runtime_error);
+
+    bdd_bytecode::program prog({test, 0, 0, 0, 0, 1, 0, ret0, ret1}, {"a"});
+    REQUIRE_THROWS_AS(prog.evaluate(std::vector<std::uint8_t>{}), std::runtime_error);
+    std::vector<std::uint8_t> results(2);
+    REQUIRE_THROWS_AS(prog.evaluate_batch(std::vector<std::uint8_t>{1}, results),
+                      std::runtime_error);
+
+    // Damaged encodings
+    auto wire = prog.serialize();
+    auto bad_magic = wire;
+    bad_magic[0] = 'X';
+    REQUIRE_THROWS_AS(bdd_bytecode::program::deserialize(bad_magic), std::runtime_error);
+    auto truncated = wire;
+    truncated.pop_back();
+    REQUIRE_THROWS_AS(bdd_bytecode::program::deserialize(truncated), std::runtime_error);
+    auto corrupted = wire;
+    corrupted[corrupted.size() - 5] = 9;  // False offset now jumps past the end
+    REQUIRE_THROWS_AS(bdd_bytecode::program::deserialize(corrupted), std::runtime_error);
+}
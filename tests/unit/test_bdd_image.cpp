@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_bdd_image.cpp
+ * @brief Tests for flat BDD images
+ *
+ * Checks the level-ordered layout, agreement of TeDDy and CUDD lowerings with
+ * the source diagram, the save/map round trip, and rejection of invalid
+ * images and inputs.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <cudd/cuddObj.hh>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "bdd_image.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "teddy_convert.hpp"
+
+namespace {
+
+// TeDDy manager and diagram for an expression, with the variable order used
+struct teddy_fixture {
+    std::vector<std::string> ordered;
+    teddy::bdd_manager manager;
+    teddy::bdd_manager::diagram_t f;
+
+    explicit teddy_fixture(const my_expression& expr)
+        : ordered(make_order(expr)),
+          manager(static_cast<int>(ordered.size()), 1'000),
+          f(convert_to_bdd(expr, manager)) {}
+
+    static std::vector<std::string> make_order(const my_expression& expr) {
+        std::unordered_set<std::string> names;
+        collect_variables_with_dag_walker(expr, names);
+        return ordered_variable_names(names);
+    }
+};
+
+std::vector<std::uint8_t> assignment_bytes(size_t row, size_t count) {
+    std::vector<std::uint8_t> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<std::uint8_t>((row >> i) & 1);
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST_CASE("bdd_image: TeDDy lowering is level ordered and exact", "[bdd_image]") {
+    auto expr = parse_text("(a AND b) OR (c AND d) OR (e XOR f)");
+    teddy_fixture fx(*expr);
+    auto img = bdd_image::compile_teddy(fx.manager, fx.f, fx.ordered);
+
+    auto nodes = img.nodes();
+    REQUIRE(nodes.size() == static_cast<size_t>(fx.manager.get_node_count(fx.f)));
+    REQUIRE(img.root() == 2);
+    REQUIRE(img.variable_names() == fx.ordered);
+    REQUIRE_FALSE(img.is_mapped());
+
+    // Levels never decrease along the array and children always come later
+    for (size_t i = 2; i < nodes.size(); ++i) {
+        if (i > 2) {
+            REQUIRE(fx.manager.get_level(nodes[i - 1].var) <= fx.manager.get_level(nodes[i].var));
+        }
+        for (auto child : nodes[i].child) {
+            REQUIRE((child <= bdd_image::image::true_index || child > i));
+        }
+    }
+
+    const size_t n = fx.ordered.size();
+    for (size_t row = 0; row < (size_t{1} << n); ++row) {
+        auto values = assignment_bytes(row, n);
+        std::vector<int> ints(values.begin(), values.end());
+        INFO("row=" << row);
+        REQUIRE(img.evaluate(values) == (fx.manager.evaluate(fx.f, ints) == 1));
+    }
+}
+
+TEST_CASE("bdd_image: CUDD lowering resolves complement edges", "[bdd_image]") {
+    auto expr = parse_text("(a XOR b XOR c) AND NOT (d AND e) OR EXACTLY_ONE(a, d, f)");
+    teddy_fixture fx(*expr);
+    std::unordered_set<std::string> names(fx.ordered.begin(), fx.ordered.end());
+    auto [cudd_mgr, bdd] = convert_to_cudd_bdd(*expr, names);
+
+    auto from_teddy = bdd_image::compile_teddy(fx.manager, fx.f, fx.ordered);
+    auto from_cudd = bdd_image::compile_cudd(*cudd_mgr, bdd, fx.ordered);
+
+    const size_t n = fx.ordered.size();
+    const size_t rows = size_t{1} << n;
+    std::vector<std::uint8_t> all_rows;
+    for (size_t row = 0; row < rows; ++row) {
+        auto values = assignment_bytes(row, n);
+        all_rows.insert(all_rows.end(), values.begin(), values.end());
+    }
+    std::vector<std::uint8_t> expected(rows);
+    std::vector<std::uint8_t> actual(rows);
+    from_teddy.evaluate_batch(all_rows, expected);
+    from_cudd.evaluate_batch(all_rows, actual);
+    REQUIRE(actual == expected);
+
+    for (size_t row = 0; row < rows; ++row) {
+        auto values = assignment_bytes(row, n);
+        REQUIRE(from_teddy.evaluate(values) == (expected[row] == 1));
+    }
+}
+
+TEST_CASE("bdd_image: save and map round trip", "[bdd_image]") {
+    auto expr = parse_text("x[4] >= 5 AND (flag OR x[4] == 12)");
+    teddy_fixture fx(*expr);
+    auto img = bdd_image::compile_teddy(fx.manager, fx.f, fx.ordered);
+
+    auto path = unique_temp_path("test_image_", ".img");
+    img.save(path.string());
+    {
+        auto mapped = bdd_image::image::load(path.string());
+        REQUIRE(mapped.is_mapped());
+        REQUIRE(mapped.root() == img.root());
+        REQUIRE(mapped.variable_names() == img.variable_names());
+        REQUIRE(mapped.nodes().size() == img.nodes().size());
+        for (size_t i = 0; i < img.nodes().size(); ++i) {
+            REQUIRE(mapped.nodes()[i].var == img.nodes()[i].var);
+            REQUIRE(mapped.nodes()[i].child[0] == img.nodes()[i].child[0]);
+            REQUIRE(mapped.nodes()[i].child[1] == img.nodes()[i].child[1]);
+        }
+
+        // Moving keeps the mapping alive in the new owner
+        bdd_image::image moved = std::move(mapped);
+        REQUIRE(moved.is_mapped());
+        const size_t n = fx.ordered.size();
+        for (size_t row = 0; row < (size_t{1} << n); ++row) {
+            auto values = assignment_bytes(row, n);
+            REQUIRE(moved.evaluate(values) == img.evaluate(values));
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("bdd_image: constant functions", "[bdd_image]") {
+    auto expr = parse_text("(a AND NOT a) OR (b AND NOT b)");
+    teddy_fixture fx(*expr);
+    auto img = bdd_image::compile_teddy(fx.manager, fx.f, fx.ordered);
+    REQUIRE(img.root() == bdd_image::image::false_index);
+    REQUIRE(img.nodes().size() == 2);
+    REQUIRE_FALSE(img.evaluate(std::vector<std::uint8_t>{1, 1}));
+}
+
+TEST_CASE("bdd_image - negative: invalid images and inputs", "[bdd_image][negative]") {
+    using bdd_image::node_record;
+
+    // Child pointing backwards would allow cycles
+    std::vector<node_record> records = {{0, {0, 0}}, {0, {0, 0}}, {0, {2, 1}}};
+    REQUIRE_THROWS_AS(bdd_image::image(records, 2, {"a"}), std::runtime_error);
+    // Variable index without a name
+    records[2] = {1, {0, 1}};
+    REQUIRE_THROWS_AS(bdd_image::image(records, 2, {"a"}), std::runtime_error);
+    records[2] = {0, {0, 1}};
+    bdd_image::image img(records, 2, {"a"});
+
+    REQUIRE_THROWS_AS(img.evaluate(std::vector<std::uint8_t>{}), std::runtime_error);
+    std::vector<std::uint8_t> results(2);
+    REQUIRE_THROWS_AS(img.evaluate_batch(std::vector<std::uint8_t>{1}, results),
+                      std::runtime_error);
+
+    REQUIRE_THROWS_AS(bdd_image::image::load("nonexistent_image.img"), std::runtime_error);
+
+    auto path = unique_temp_path("test_image_bad_", ".img");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "NOTANIMAGE-NOTANIMAGE-NOTANIMAGE-NOTANIMAGE";
+    }
+    REQUIRE_THROWS_AS(bdd_image::image::load(path.string()), std::runtime_error);
+
+    // Truncated copy of a valid image
+    img.save(path.string());
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 2);
+    REQUIRE_THROWS_AS(bdd_image::image::load(path.string()), std::runtime_error);
+    std::filesystem::remove(path);
+}
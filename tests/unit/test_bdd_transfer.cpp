@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_bdd_transfer.cpp
+ * @brief Tests for copying diagrams between TeDDy and CUDD managers
+ *
+ * Every copy is compared with a fresh conversion in the target manager, which
+ * by canonicity must be the very same node.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "bdd_transfer.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "teddy_convert.hpp"
+
+namespace {
+
+std::unordered_set<std::string> variables_of(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return names;
+}
+
+const std::vector<std::string> sources = {
+    "(a AND b) OR (c XOR d) OR AT_LEAST_K(2, a, c, e)",
+    "NOT (a AND NOT b) XOR (c OR NOT d)",
+    "x[4] >= 5 AND NOT (y[3] == 2)",
+    "a AND NOT a",
+};
+
+}  // namespace
+
+TEST_CASE("bdd_transfer: copies within a library preserve the diagram", "[bdd_transfer]") {
+    for (const auto& source : sources) {
+        INFO(source);
+        auto expr = parse_text(source);
+        const auto names = variables_of(*expr);
+
+        teddy::bdd_manager from(static_cast<int>(names.size()), 1'000);
+        auto f = convert_to_bdd(*expr, from);
+        teddy::bdd_manager to(static_cast<int>(names.size()), 1'000);
+        auto copy = copy_teddy_bdd(f, to);
+        REQUIRE(to.get_node_count(copy) == from.get_node_count(f));
+        REQUIRE(copy.equals(convert_to_bdd(*expr, to)));
+
+        auto [cudd_from, g] = convert_to_cudd_bdd(*expr, names);
+        auto [cudd_to, h] = convert_to_cudd_bdd(*expr, names);
+        BDD cudd_copy = copy_cudd_bdd(*cudd_from, g, *cudd_to);
+        REQUIRE(cudd_copy.nodeCount() == g.nodeCount());
+        REQUIRE(cudd_copy.getNode() == h.getNode());
+    }
+}
+
+TEST_CASE("bdd_transfer: TeDDy and CUDD round trip", "[bdd_transfer]") {
+    for (const auto& source : sources) {
+        INFO(source);
+        auto expr = parse_text(source);
+        const auto names = variables_of(*expr);
+        teddy::bdd_manager teddy_mgr(static_cast<int>(names.size()), 1'000);
+        auto f = convert_to_bdd(*expr, teddy_mgr);
+        auto [cudd_mgr, g] = convert_to_cudd_bdd(*expr, names);
+
+        // Both directions land on the node the target's own converter built
+        BDD to_cudd = copy_teddy_to_cudd(f, *cudd_mgr);
+        REQUIRE(to_cudd.getNode() == g.getNode());
+        auto to_teddy = copy_cudd_to_teddy(*cudd_mgr, g, teddy_mgr);
+        REQUIRE(to_teddy.equals(f));
+        REQUIRE(copy_cudd_to_teddy(*cudd_mgr, to_cudd, teddy_mgr).equals(f));
+    }
+}
+
+TEST_CASE("bdd_transfer: complement edges are expanded", "[bdd_transfer]") {
+    Cudd cudd_mgr;
+    BDD a = cudd_mgr.bddVar(0);
+    BDD b = cudd_mgr.bddVar(1);
+    BDD c = cudd_mgr.bddVar(2);
+    // The else-edge of a leads to the complement of the function below b
+    BDD g = a.Ite(b & c, !(b & c));
+
+    teddy::bdd_manager teddy_mgr(3, 1'000);
+    auto f = copy_cudd_to_teddy(cudd_mgr, g, teddy_mgr);
+    auto x = [&](int i) { return teddy_mgr.variable(i); };
+    auto expected = make_teddy_ite(teddy_mgr)(
+        x(0), teddy_mgr.apply<teddy::ops::AND>(x(1), x(2)),
+        teddy_mgr.apply<teddy::ops::NAND>(x(1), x(2)));
+    REQUIRE(f.equals(expected));
+
+    // Both phases of b AND c are separate TeDDy nodes: a, 2 x b, 2 x c, 2 terminals
+    REQUIRE(teddy_mgr.get_node_count(f) == 7);
+    REQUIRE(copy_teddy_to_cudd(f, cudd_mgr).getNode() == g.getNode());
+}
+
+TEST_CASE("bdd_transfer: variables are matched by index, not level", "[bdd_transfer]") {
+    auto expr = parse_text("(a AND b) OR (c AND d) OR (e AND NOT a)");
+    const auto names = variables_of(*expr);
+    const int n = static_cast<int>(names.size());
+
+    // TeDDy with the reversed order, CUDD with the identity order
+    std::vector<int> reversed;
+    for (int i = n - 1; i >= 0; --i) {
+        reversed.push_back(i);
+    }
+    teddy::bdd_manager reordered(n, 1'000, reversed);
+    auto f = convert_to_bdd(*expr, reordered);
+    auto [cudd_mgr, g] = convert_to_cudd_bdd(*expr, names);
+    REQUIRE(copy_teddy_to_cudd(f, *cudd_mgr).getNode() == g.getNode());
+    REQUIRE(copy_cudd_to_teddy(*cudd_mgr, g, reordered).equals(f));
+
+    teddy::bdd_manager identity(n, 1'000);
+    REQUIRE(copy_teddy_bdd(f, identity).equals(convert_to_bdd(*expr, identity)));
+}
@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_c_code_generator.cpp
+ * @brief Tests for the generated C evaluators
+ *
+ * Compiles the code generated for each expression in test_expressions/ with
+ * the C compiler found by CMake and checks the goto, nested, CUDD and batch
+ * functions against the TeDDy diagram on random assignments. Also covers the
+ * generated text for constant functions and the configuration errors.
+ */
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+#include <cudd/cuddObj.hh>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cudd_convert.hpp"
+#include "cudd_graph.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "teddy_convert.hpp"
+#include "teddy_graph.hpp"
+
+namespace {
+
+constexpr std::size_t kRows = 256;
+constexpr std::size_t kMaxCompiledNodes = 5'000;
+
+/**
+ * @brief Writes a C driver that prints one line per row
+ *
+ * Each line holds the goto result, the nested result (when emitted), the CUDD
+ * result and the batch result, as '0' or '1' characters.
+ */
+void write_driver(std::ostream& out, const std::vector<std::vector<std::uint64_t>>& row_bits,
+                  const std::vector<std::vector<std::uint64_t>>& columns, bool has_nested) {
+    out << "\n#include <stdio.h>\n\n";
+    out << "static const uint64_t rows[][" << row_bits.front().size() << "] = {\n";
+    for (const auto& row : row_bits) {
+        out << "    {";
+        for (auto word : row) {
+            out << std::format("UINT64_C({}), ", word);
+        }
+        out << "},\n";
+    }
+    out << "};\n\n";
+
+    for (std::size_t v = 0; v < columns.size(); ++v) {
+        out << "static const uint64_t col" << v << "[] = {";
+        for (auto word : columns[v]) {
+            out << std::format("UINT64_C({}), ", word);
+        }
+        out << "};\n";
+    }
+    out << "static const uint64_t* const columns[] = {";
+    for (std::size_t v = 0; v < columns.size(); ++v) {
+        out << "col" << v << ", ";
+    }
+    out << (columns.empty() ? "0" : "") << "};\n\n";
+
+    const std::size_t words = (kRows + 63) / 64;
+    out << "int main(void) {\n";
+    out << "    uint64_t batch[" << words << "];\n";
+    out << "    size_t r;\n";
+    out << "    eval_goto_batch(columns, batch, " << words << ");\n";
+    out << "    for (r = 0; r < " << kRows << "; ++r) {\n";
+    out << "        printf(\"%d\", eval_goto(rows[r]));\n";
+    if (has_nested) {
+        out << "        printf(\"%d\", eval_nested(rows[r]));\n";
+    }
+    out << "        printf(\"%d\", eval_cudd(rows[r]));\n";
+    out << "        printf(\"%d\\n\", (int)((batch[r / 64] >> (r % 64)) & 1u));\n";
+    out << "    }\n";
+    out << "    return 0;\n";
+    out << "}\n";
+}
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+}  // namespace
+
+TEST_CASE("c_code: generated evaluators match the BDD for the test corpus", "[c_code]") {
+#ifndef BDD_TEST_C_COMPILER
+    WARN("No C compiler available to the tests; skipping generated code check");
+    return;
+#else
+    const std::filesystem::path work_dir = unique_temp_path("test_c_code_", "");
+    std::filesystem::create_directories(work_dir);
+
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator("test_expressions")) {
+        // bdd_demo writes its node tables next to the inputs; those are not expressions
+        if (entry.is_regular_file() && entry.path().extension() == ".txt"
+            && !entry.path().stem().string().ends_with("_nodes")) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    REQUIRE_FALSE(files.empty());
+
+    std::mt19937_64 rng(7);
+    std::size_t compiled = 0;
+    for (const auto& file : files) {
+        INFO("expression file: " << file.string());
+        auto expr = read_expression_from_file(file.string());
+        std::unordered_set<std::string> names;
+        collect_variables_with_dag_walker(*expr, names);
+        std::vector<std::string> ordered = ordered_variable_names(names);
+
+        teddy::bdd_manager manager(static_cast<int>(ordered.size()), 1'000);
+        auto f = convert_to_bdd(*expr, manager);
+        if (static_cast<std::size_t>(manager.get_node_count(f)) > kMaxCompiledNodes) {
+            continue;  // Keeps the compile time of the test bounded
+        }
+        auto [cudd_mgr, bdd] = convert_to_cudd_bdd(*expr, names);
+
+        std::ostringstream source;
+        c_code::CCodeConfig config;
+        config.function_name = "eval_goto";
+        write_teddy_to_c(manager, f, ordered, source, config);
+
+        // Nested code only for diagrams whose expanded tree stays small
+        bool has_nested = true;
+        config.function_name = "eval_nested";
+        config.branch_style = c_code::BranchStyle::nested;
+        config.emit_batch = false;
+        config.max_nested_nodes = 20'000;
+        try {
+            std::ostringstream nested;
+            write_teddy_to_c(manager, f, ordered, nested, config);
+            source << "\n" << nested.str();
+        } catch (const std::runtime_error&) {
+            has_nested = false;
+        }
+
+        config.function_name = "eval_cudd";
+        config.branch_style = c_code::BranchStyle::goto_graph;
+        source << "\n";
+        write_cudd_to_c(*cudd_mgr, bdd, ordered, source, config);
+
+        // Random assignments, packed per row and per variable column
+        const std::size_t row_words = std::max<std::size_t>(1, (ordered.size() + 63) / 64);
+        std::vector<std::vector<std::uint64_t>> row_bits(kRows,
+                                                         std::vector<std::uint64_t>(row_words));
+        std::vector<std::vector<std::uint64_t>> columns(
+            ordered.size(), std::vector<std::uint64_t>((kRows + 63) / 64));
+        std::vector<int> expected(kRows);
+        for (std::size_t r = 0; r < kRows; ++r) {
+            std::vector<int> values(ordered.size());
+            for (std::size_t v = 0; v < ordered.size(); ++v) {
+                values[v] = static_cast<int>(rng() & 1);
+                if (values[v] != 0) {
+                    row_bits[r][v / 64] |= std::uint64_t{1} << (v % 64);
+                    columns[v][r / 64] |= std::uint64_t{1} << (r % 64);
+                }
+            }
+            expected[r] = manager.evaluate(f, values);
+        }
+        write_driver(source, row_bits, columns, has_nested);
+
+        const auto stem = file.stem().string();
+        const auto c_path = work_dir / (stem + ".c");
+        const auto exe_path = work_dir / (stem + ".exe");
+        const auto out_path = work_dir / (stem + ".out");
+        {
+            std::ofstream c_file(c_path);
+            c_file << source.str();
+        }
+        std::string compile =
+            std::format("\"{}\" -std=c99 -O2 -Wall -Wextra -Werror -o \"{}\" \"{}\"",
+                        BDD_TEST_C_COMPILER, exe_path.string(), c_path.string());
+        INFO("compile: " << compile);
+        REQUIRE(std::system(compile.c_str()) == 0);
+        std::string run = std::format("\"{}\" > \"{}\"", exe_path.string(), out_path.string());
+        REQUIRE(std::system(run.c_str()) == 0);
+
+        std::istringstream lines(read_file(out_path));
+        std::string line;
+        for (std::size_t r = 0; r < kRows; ++r) {
+            INFO("row " << r);
+            REQUIRE(std::getline(lines, line));
+            REQUIRE(line.size() == (has_nested ? 4u : 3u));
+            for (char c : line) {
+                REQUIRE(c - '0' == expected[r]);
+            }
+        }
+        ++compiled;
+    }
+    REQUIRE(compiled > 0);
+
+    std::error_code ignored;
+    std::filesystem::remove_all(work_dir, ignored);
+#endif
+}
+
+TEST_CASE("c_code: goto style emits shared nodes once", "[c_code]") {
+    std::vector<std::string> ordered = {"a", "b", "c", "d"};
+    teddy::bdd_manager manager(4, 1'000);
+    // (a AND b) OR (c AND d): the c node is shared by both a and b
+    auto f = manager.apply<teddy::ops::OR>(
+        manager.apply<teddy::ops::AND>(manager.variable(0), manager.variable(1)),
+        manager.apply<teddy::ops::AND>(manager.variable(2), manager.variable(3)));
+
+    std::ostringstream out;
+    write_teddy_to_c(manager, f, ordered, out);
+    std::string code = out.str();
+
+    REQUIRE(code.find("int bdd_eval(const uint64_t* bits)") != std::string::npos);
+    REQUIRE(code.find("void bdd_eval_batch(") != std::string::npos);
+    REQUIRE(code.find(" *   3: d") != std::string::npos);
+    // Each decision is emitted once: a jumps to the shared c node, b falls into it
+    std::string scalar = code.substr(0, code.find("void bdd_eval_batch"));
+    std::size_t decisions = 0;
+    for (auto pos = scalar.find("if ("); pos != std::string::npos;
+         pos = scalar.find("if (", pos + 1)) {
+        ++decisions;
+    }
+    REQUIRE(decisions == 4);
+    auto jump = scalar.find("goto n");
+    REQUIRE(jump != std::string::npos);
+    auto target = scalar.substr(jump + 5, scalar.find(';', jump) - jump - 5);
+    REQUIRE(scalar.find("\n" + target + ":\n") != std::string::npos);
+    REQUIRE(scalar.find("goto", jump + 1) == std::string::npos);
+}
+
+TEST_CASE("c_code: constant functions", "[c_code]") {
+    std::vector<std::string> ordered = {"a"};
+    teddy::bdd_manager manager(1, 1'000);
+    auto f = manager.constant(1);
+
+    std::ostringstream out;
+    write_teddy_to_c(manager, f, ordered, out);
+    std::string code = out.str();
+    REQUIRE(code.find("    (void)bits;\n    return 1;") != std::string::npos);
+    REQUIRE(code.find("out[w] = ~UINT64_C(0);") != std::string::npos);
+    REQUIRE(code.find("goto") == std::string::npos);
+}
+
+TEST_CASE("c_code - negative: invalid configurations", "[c_code][negative]") {
+    std::vector<std::string> ordered = {"a", "b", "c", "d", "e", "f"};
+    teddy::bdd_manager manager(6, 1'000);
+    auto f = manager.apply<teddy::ops::XOR>(
+        manager.apply<teddy::ops::XOR>(manager.variable(0), manager.variable(1)),
+        manager.apply<teddy::ops::XOR>(
+            manager.variable(2),
+            manager.apply<teddy::ops::XOR>(
+                manager.variable(3),
+                manager.apply<teddy::ops::XOR>(manager.variable(4), manager.variable(5)))));
+
+    std::ostringstream out;
+    c_code::CCodeConfig config;
+    config.function_name = "1bad";
+    REQUIRE_THROWS_AS(write_teddy_to_c(manager, f, ordered, out, config), std::runtime_error);
+    config.function_name = "bad-name";
+    REQUIRE_THROWS_AS(write_teddy_to_c(manager, f, ordered, out, config), std::runtime_error);
+
+    // A six-variable XOR expands to 63 decisions as a tree
+    config.function_name = "eval";
+    config.branch_style = c_code::BranchStyle::nested;
+    config.max_nested_nodes = 62;
+    REQUIRE_THROWS_AS(write_teddy_to_c(manager, f, ordered, out, config), std::runtime_error);
+    config.max_nested_nodes = 63;
+    REQUIRE_NOTHROW(write_teddy_to_c(manager, f, ordered, out, config));
+
+    // Every decision variable needs a name
+    std::vector<std::string> missing = {"a", "b"};
+    config.branch_style = c_code::BranchStyle::goto_graph;
+    REQUIRE_THROWS_AS(write_teddy_to_c(manager, f, missing, out, config), std::runtime_error);
+}
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_conjunctive_partition.cpp
+ * @brief Tests for conjunctively partitioned CUDD BDDs
+ *
+ * Covers clustering under the node threshold, evaluation and satisfiability
+ * on the partition list against the monolithic BDD, and the on-demand
+ * conjunction with and without limits.
+ */
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "conjunctive_partition.hpp"
+#include "conversion_limits.hpp"
+#include "cudd_convert.hpp"
+#include "dag_walker.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "partitioned_convert.hpp"
+
+namespace {
+
+std::vector<std::string> names_of(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return ordered_variable_names(names);
+}
+
+const char* const constraints =
+    "(a OR b) AND (NOT a OR c) AND (b XOR d) AND AT_MOST_K(1, a, c, e) AND (e OR f OR NOT g) "
+    "AND (g XOR h)";
+
+}  // namespace
+
+TEST_CASE("conjunctive_partition: clusters stay within the threshold", "[conjunctive]") {
+    auto expr = read_expression_from_file("test_expressions/four_queens.txt");
+    const auto names = names_of(*expr);
+    Cudd mgr;
+    const auto var_map = partitioned_convert_detail::variable_map(names);
+    const BDD whole = convert_to_cudd_bdd_with_map(*expr, mgr, var_map);
+    const auto conjuncts = partitioned_convert_detail::chain_operands<my_and>(*expr).size();
+    REQUIRE(conjuncts > 1);
+
+    // Without merging there is one partition per conjunct
+    const auto separate = conjunctive_partition::build(*expr, mgr, var_map, 0);
+    REQUIRE(separate.conjuncts() == conjuncts);
+    REQUIRE(separate.parts().size() == conjuncts);
+
+    // Merged partitions respect the threshold
+    const std::size_t threshold = 20;
+    const auto clustered = conjunctive_partition::build(*expr, mgr, var_map, threshold);
+    REQUIRE(clustered.parts().size() < conjuncts);
+    for (std::size_t i = 0; i < clustered.parts().size(); ++i) {
+        INFO("partition " << i);
+        REQUIRE(static_cast<int>(clustered.part_sizes()[i]) == clustered.parts()[i].nodeCount());
+        const bool single = separate.part_sizes().end()
+                            != std::find(separate.part_sizes().begin(),
+                                         separate.part_sizes().end(), clustered.part_sizes()[i]);
+        REQUIRE((clustered.part_sizes()[i] <= threshold || single));
+    }
+
+    // Without a threshold everything is merged into the monolithic BDD (intermediate
+    // clusters can be larger than the final one, so its size is not enough)
+    const auto merged = conjunctive_partition::build(*expr, mgr, var_map,
+                                                     std::numeric_limits<std::size_t>::max());
+    REQUIRE(merged.parts().size() == 1);
+    REQUIRE(merged.parts().front() == whole);
+
+    for (const auto* partition : {&separate, &clustered, &merged}) {
+        REQUIRE(partition->conjunction() == whole);
+    }
+}
+
+TEST_CASE("conjunctive_partition: evaluation matches the monolithic BDD", "[conjunctive]") {
+    auto expr = parse_text(constraints);
+    const auto names = names_of(*expr);
+    Cudd mgr;
+    const auto var_map = partitioned_convert_detail::variable_map(names);
+    const BDD whole = convert_to_cudd_bdd_with_map(*expr, mgr, var_map);
+    const auto partition = conjunctive_partition::build(*expr, mgr, var_map, 0);
+    REQUIRE(partition.parts().size() == 6);
+
+    // Every row against the minterm of the row conjoined with the monolithic BDD
+    std::vector<std::uint8_t> assignment(names.size());
+    for (std::uint32_t row = 0; row < (1u << names.size()); ++row) {
+        BDD minterm = mgr.bddOne();
+        for (std::size_t v = 0; v < names.size(); ++v) {
+            assignment[v] = static_cast<std::uint8_t>((row >> v) & 1);
+            const BDD var = mgr.bddVar(static_cast<int>(v));
+            minterm &= assignment[v] != 0 ? var : !var;
+        }
+        INFO("row " << row);
+        REQUIRE(partition.evaluate(assignment) == !(whole & minterm).IsZero());
+    }
+
+    REQUIRE_THROWS_AS(partition.evaluate(std::vector<std::uint8_t>{1}), std::runtime_error);
+}
+
+TEST_CASE("conjunctive_partition: satisfiability with early quantification", "[conjunctive]") {
+    Cudd mgr;
+    SECTION("satisfiable constraints") {
+        auto expr = parse_text(constraints);
+        const auto names = names_of(*expr);
+        const auto partition = conjunctive_partition::build(
+            *expr, mgr, partitioned_convert_detail::variable_map(names), 0);
+        conjunctive_partition::quantify_stats stats;
+        REQUIRE(partition.is_satisfiable(&stats));
+        REQUIRE(stats.steps == partition.parts().size());
+        REQUIRE(stats.quantified == names.size());
+    }
+
+    SECTION("N-Queens") {
+        auto expr = read_expression_from_file("test_expressions/four_queens.txt");
+        const auto names = names_of(*expr);
+        const auto partition = conjunctive_partition::build(
+            *expr, mgr, partitioned_convert_detail::variable_map(names), 0);
+        conjunctive_partition::quantify_stats stats;
+        REQUIRE(partition.is_satisfiable(&stats));
+        REQUIRE(stats.peak_nodes < static_cast<std::size_t>(partition.conjunction().nodeCount()));
+    }
+
+    SECTION("a contradiction stops early") {
+        auto expr = parse_text("(a OR b) AND NOT a AND NOT b AND (c XOR d) AND (d OR e)");
+        const auto partition = conjunctive_partition::build(
+            *expr, mgr, partitioned_convert_detail::variable_map(names_of(*expr)), 0);
+        conjunctive_partition::quantify_stats stats;
+        REQUIRE_FALSE(partition.is_satisfiable(&stats));
+        REQUIRE(stats.steps < partition.parts().size());
+        REQUIRE(partition.conjunction().IsZero());
+    }
+
+    SECTION("constant conjuncts") {
+        auto expr = parse_text("a AND FALSE AND b");
+        const auto partition = conjunctive_partition::build(
+            *expr, mgr, partitioned_convert_detail::variable_map(names_of(*expr)), 0);
+        REQUIRE(partition.parts().size() == 1);
+        REQUIRE_FALSE(partition.is_satisfiable());
+
+        auto trivial = parse_text("TRUE AND TRUE");
+        const auto empty = conjunctive_partition::build(*trivial, mgr, {}, 0);
+        REQUIRE(empty.parts().size() == 1);
+        REQUIRE(empty.is_satisfiable());
+        REQUIRE(empty.conjunction().IsOne());
+    }
+}
+
+TEST_CASE("conjunctive_partition: the conjunction honours the node limit", "[conjunctive]") {
+    auto expr = read_expression_from_file("test_expressions/four_queens.txt");
+    Cudd mgr;
+    const auto partition = conjunctive_partition::build(
+        *expr, mgr, partitioned_convert_detail::variable_map(names_of(*expr)), 0);
+
+    conversion_limits limits;
+    limits.max_nodes = static_cast<std::size_t>(mgr.ReadKeys()) + 1;
+    conversion_budget budget(limits);
+    REQUIRE_THROWS_AS(partition.conjunction(&budget), conversion_aborted);
+
+    // Without a limit it is built once and cached
+    const BDD& whole = partition.conjunction();
+    REQUIRE(&partition.conjunction() == &whole);
+    REQUIRE(partition.is_satisfiable() == !whole.IsZero());
+}
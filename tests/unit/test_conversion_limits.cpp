@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_conversion_limits.cpp
+ * @brief Tests for node, memory and time budgets during conversion
+ *
+ * Checks that TeDDy and CUDD conversions stop with conversion_aborted when a
+ * limit is exceeded, that the report names a sub-expression and a peak size,
+ * and that generous limits leave the result unchanged.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+#include "conversion_limits.hpp"
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "teddy_convert.hpp"
+#include "workload_generator.hpp"
+
+namespace {
+
+std::unordered_set<std::string> variables_of(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return names;
+}
+
+my_expression_ptr queens(int n) {
+    workload_generator::GeneratorOptions options;
+    options.n = n;
+    return parse_text(workload_generator::generate_n_queens(options));
+}
+
+conversion_limits node_limit(std::size_t nodes) {
+    conversion_limits limits;
+    limits.max_nodes = nodes;
+    return limits;
+}
+
+}  // namespace
+
+TEST_CASE("conversion_limits: expressions print with truncation", "[conversion_limits]") {
+    auto expr = parse_text("(a AND NOT b) OR (c XOR d)");
+    REQUIRE(expression_to_string(*expr) == "((a AND NOT b) OR (c XOR d))");
+    REQUIRE(expression_to_string(*expr, 10) == "((a AND...");
+    REQUIRE(expression_to_string(*parse_text("EXACTLY_ONE(a, b, c)"))
+            == "EXACTLY_ONE(a, b, c)");
+}
+
+TEST_CASE("conversion_limits: unlimited budgets record the peak", "[conversion_limits]") {
+    auto expr = queens(4);
+    const auto names = variables_of(*expr);
+    teddy::bdd_manager mgr(static_cast<int>(names.size()), 1'000);
+    auto expected = convert_to_bdd(*expr, mgr);
+
+    conversion_budget budget(conversion_limits{});
+    auto f = convert_to_bdd(*expr, mgr, &budget);
+    REQUIRE(f.equals(expected));
+    REQUIRE(budget.peak_nodes() > 0);
+}
+
+TEST_CASE("conversion_limits: TeDDy conversion aborts on the node limit",
+          "[conversion_limits]") {
+    auto expr = queens(5);
+    const auto names = variables_of(*expr);
+    teddy::bdd_manager mgr(static_cast<int>(names.size()), 1'000);
+
+    conversion_budget budget(node_limit(50), teddy_bytes_per_node);
+    try {
+        convert_to_bdd(*expr, mgr, &budget);
+        FAIL("conversion was not aborted");
+    } catch (const conversion_aborted& e) {
+        REQUIRE(std::string(e.what()).starts_with("node limit of 50 exceeded"));
+        REQUIRE(e.peak_nodes() > 50);
+        REQUIRE_FALSE(e.subexpression().empty());
+        REQUIRE(e.subexpression().size() <= conversion_budget::max_report_length);
+        REQUIRE(e.seconds() >= 0.0);
+    }
+}
+
+TEST_CASE("conversion_limits: TeDDy conversion aborts on the memory and time limits",
+          "[conversion_limits]") {
+    auto expr = queens(5);
+    const auto names = variables_of(*expr);
+    teddy::bdd_manager mgr(static_cast<int>(names.size()), 1'000);
+
+    conversion_limits memory;
+    memory.max_memory = 100 * teddy_bytes_per_node;
+    conversion_budget memory_budget(memory, teddy_bytes_per_node);
+    REQUIRE_THROWS_AS(convert_to_bdd(*expr, mgr, &memory_budget), conversion_aborted);
+
+    // A limit of 1 ms has passed by the time the next operation is checked
+    conversion_limits time;
+    time.timeout = std::chrono::milliseconds(1);
+    conversion_budget time_budget(time);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    try {
+        convert_to_bdd(*expr, mgr, &time_budget);
+        FAIL("conversion was not aborted");
+    } catch (const conversion_aborted& e) {
+        REQUIRE(std::string(e.what()) == "time limit of 1 ms exceeded");
+    }
+
+    // The manager is still usable at full size afterwards
+    auto f = convert_to_bdd(*expr, mgr);
+    REQUIRE(mgr.get_node_count(f) > 0);
+}
+
+TEST_CASE("conversion_limits: CUDD conversion aborts and restores the manager",
+          "[conversion_limits]") {
+    auto expr = queens(5);
+    const auto names = variables_of(*expr);
+    auto [reference_mgr, reference] = convert_to_cudd_bdd(*expr, names);
+
+    conversion_budget nodes(node_limit(100));
+    try {
+        convert_to_cudd_bdd(*expr, names, &nodes);
+        FAIL("conversion was not aborted");
+    } catch (const conversion_aborted& e) {
+        REQUIRE(std::string(e.what()).starts_with("node limit of 100 exceeded"));
+        REQUIRE(e.peak_nodes() > 100);
+        REQUIRE_FALSE(e.subexpression().empty());
+    }
+
+    conversion_limits time;
+    time.timeout = std::chrono::milliseconds(1);
+    conversion_budget time_budget(time);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    REQUIRE_THROWS_AS(convert_to_cudd_bdd(*expr, names, &time_budget), conversion_aborted);
+
+    // Generous limits give the same diagram as an unlimited conversion
+    conversion_limits generous;
+    generous.max_nodes = 1'000'000;
+    generous.max_memory = std::size_t{1} << 30;
+    generous.timeout = std::chrono::minutes(10);
+    conversion_budget budget(generous);
+    auto [mgr, f] = convert_to_cudd_bdd(*expr, names, &budget);
+    REQUIRE(f.nodeCount() == reference.nodeCount());
+    REQUIRE(budget.peak_nodes() > 0);
+}
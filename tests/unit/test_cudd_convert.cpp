@@ -147,3 +147,121 @@ TEST_CASE("CuddConvert - empty variable set throws on variable usage", "[cudd_co
 
     REQUIRE_THROWS_AS(convert_to_cudd_bdd(expr, var_names), std::runtime_error);
 }
+
+TEST_CASE("CuddConvert - cardinality constraints match brute-force counting",
+          "[cudd_convert][cardinality]") {
+    const std::vector<std::string> names = {"a", "b", "c", "d", "e"};
+    for (auto kind :
+         {cardinality_kind::exactly, cardinality_kind::at_most, cardinality_kind::at_least}) {
+        for (size_t k = 0; k <= names.size() + 1; ++k) {
+            my_cardinality node;
+            node.kind = kind;
+            node.k = k;
+            for (const auto& name : names) {
+                node.operands.push_back(std::make_unique<my_expression>(my_variable{name}));
+            }
+            // Negate the last operand to exercise literal handling
+            node.operands.back() =
+                std::make_unique<my_expression>(my_not{std::move(node.operands.back())});
+            my_expression expr = std::move(node);
+            const auto& constraint = std::get<my_cardinality>(expr);
+
+            auto [mgr, result] = convert_to_cudd_bdd(
+                expr, std::unordered_set<std::string>(names.begin(), names.end()));
+
+            for (unsigned mask = 0; mask < (1u << names.size()); ++mask) {
+                std::vector<bool> assignment;
+                size_t ones = 0;
+                for (size_t i = 0; i < names.size(); ++i) {
+                    assignment.push_back(((mask >> i) & 1u) != 0);
+                    bool operand_true = (i + 1 == names.size()) ? !assignment[i] : assignment[i];
+                    ones += operand_true ? 1 : 0;
+                }
+                INFO("k=" << k << " mask=" << mask);
+                REQUIRE(evaluate_cudd_bdd(*mgr, result, assignment) == constraint.accepts(ones));
+            }
+        }
+    }
+}
+
+TEST_CASE("CuddConvert - AT_MOST_K size grows linearly in the operand count",
+          "[cudd_convert][cardinality]") {
+    my_cardinality node;
+    node.kind = cardinality_kind::at_most;
+    node.k = 3;
+    std::unordered_set<std::string> names;
+    for (int i = 0; i < 64; ++i) {
+        std::string name = "v" + std::to_string(100 + i);
+        names.insert(name);
+        node.operands.push_back(std::make_unique<my_expression>(my_variable{name}));
+    }
+    my_expression expr = std::move(node);
+
+    auto [mgr, result] = convert_to_cudd_bdd(expr, names);
+    // At most (k + 1) nodes per layer
+    REQUIRE(result.nodeCount() <= static_cast<int>(4 * names.size() + 1));
+}
+
+TEST_CASE("CuddConvert - field comparisons match brute-force evaluation", "[cudd_convert][field]") {
+    // ordered_variable_names places x[2], y[2], x[1], y[1], x[0], y[0] at levels 0..5
+    const std::vector<std::string> order = {"x[2]", "y[2]", "x[1]", "y[1]", "x[0]", "y[0]"};
+    auto decode = [&](const std::vector<bool>& assignment, char field) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (assignment[i] && order[i][0] == field) {
+                value |= uint64_t{1} << (order[i][2] - '0');
+            }
+        }
+        return value;
+    };
+
+    for (bool against_field : {false, true}) {
+        my_compare node;
+        node.field = my_field{"x", 3};
+        node.op = compare_op::gt;
+        if (against_field) {
+            node.rhs_field = my_field{"y", 3};
+        } else {
+            node.value = 5;
+        }
+        my_expression expr = my_or{std::make_unique<my_expression>(std::move(node)),
+                                   std::make_unique<my_expression>(my_compare{
+                                       .field = my_field{"y", 3},
+                                       .op = compare_op::in,
+                                       .value = 0,
+                                       .rhs_field = std::nullopt,
+                                       .ranges = {{0, 0}, {6, 7}},
+                                   })};
+        auto [mgr, result] = convert_to_cudd_bdd(
+            expr, std::unordered_set<std::string>(order.begin(), order.end()));
+
+        for (unsigned mask = 0; mask < 64; ++mask) {
+            std::vector<bool> assignment;
+            for (size_t i = 0; i < order.size(); ++i) {
+                assignment.push_back(((mask >> i) & 1u) != 0);
+            }
+            uint64_t x = decode(assignment, 'x');
+            uint64_t y = decode(assignment, 'y');
+            bool expected = (x > (against_field ? y : 5)) || y == 0 || y >= 6;
+            INFO("against_field=" << against_field << " x=" << x << " y=" << y);
+            REQUIRE(evaluate_cudd_bdd(*mgr, result, assignment) == expected);
+        }
+    }
+}
+
+TEST_CASE("CuddConvert - field equality has one node per bit", "[cudd_convert][field]") {
+    my_expression expr = my_compare{
+        .field = my_field{"port", 16},
+        .op = compare_op::eq,
+        .value = 443,
+        .rhs_field = std::nullopt,
+        .ranges = {},
+    };
+    std::unordered_set<std::string> names;
+    for (size_t bit = 0; bit < 16; ++bit) {
+        names.insert(field_bit_name("port", bit));
+    }
+    auto [mgr, result] = convert_to_cudd_bdd(expr, names);
+    // 16 internal nodes plus the constant (CUDD uses complement edges)
+    REQUIRE(result.nodeCount() == 17);
+}
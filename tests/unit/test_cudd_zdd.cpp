@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_cudd_zdd.cpp
+ * @brief Tests for the CUDD zero-suppressed decision diagram pipeline
+ *
+ * Covers conversion semantics against the CUDD BDD of the same expression,
+ * the suppressed levels expanded by cudd_zdd_view, size against the BDD on
+ * the N-Queens input, and the ZDD iterator used by the DOT and node table
+ * generators.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cudd_convert.hpp"
+#include "cudd_iterator.hpp"
+#include "cudd_zdd_convert.hpp"
+#include "cudd_zdd_graph.hpp"
+#include "cudd_zdd_iterator.hpp"
+#include "cudd_zdd_view.hpp"
+#include "dag_walker.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "model_count.hpp"
+
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+std::vector<std::string> names_of(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return ordered_variable_names(names);
+}
+
+template <class View>
+std::set<std::vector<std::uint8_t>> assignments(const View& view, std::size_t variables) {
+    std::set<std::vector<std::uint8_t>> result;
+    assignment_enumerator<View> it(view, variables);
+    while (it.next()) {
+        result.insert(it.assignment());
+    }
+    return result;
+}
+
+// Builds the ZDD and the BDD of an expression in one manager and compares their functions
+void require_same_function(const std::string& text) {
+    INFO("expression: " << text);
+    auto expr = parse_text(text);
+    const auto names = names_of(*expr);
+    auto [mgr, zdd] =
+        convert_to_cudd_zdd(*expr, std::unordered_set<std::string>(names.begin(), names.end()));
+
+    std::unordered_map<std::string, int> var_map;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        var_map[names[i]] = static_cast<int>(i);
+    }
+    BDD bdd = convert_to_cudd_bdd_with_map(*expr, *mgr, var_map);
+
+    const auto n = static_cast<std::uint32_t>(names.size());
+    REQUIRE(mgr->ReadZddSize() == static_cast<int>(n));
+    REQUIRE(count_solutions(*mgr, zdd).to_string()
+            == count_solutions(cudd_view(mgr.get(), bdd.getNode()), n).to_string());
+    REQUIRE(assignments(cudd_zdd_view(mgr.get(), zdd.getNode(), n), n)
+            == assignments(cudd_view(mgr.get(), bdd.getNode()), n));
+}
+
+}  // namespace
+
+TEST_CASE("cudd_zdd: families match the BDD of the same expression", "[cudd_zdd]") {
+    for (const char* text :
+         {"a", "NOT a", "a AND NOT b AND c", "NOT (a OR b)", "a XOR b XOR c",
+          "(a AND b) OR (NOT c AND d)", "EXACTLY_ONE(a, b, c, d)", "AT_LEAST_K(2, a, NOT b, c)",
+          "port[3] < 5 OR flag", "src[2] == dst[2]", "a OR TRUE", "a AND FALSE"}) {
+        require_same_function(text);
+    }
+}
+
+TEST_CASE("cudd_zdd: suppressed variables are 0, not free", "[cudd_zdd]") {
+    auto expr = parse_text("a AND NOT b AND c");
+    const auto names = names_of(*expr);
+    auto [mgr, zdd] =
+        convert_to_cudd_zdd(*expr, std::unordered_set<std::string>(names.begin(), names.end()));
+
+    // Only a and c have nodes; b is skipped by the 1-edge of a
+    cudd_zdd_iterator root(*mgr, zdd.getNode(), &names);
+    REQUIRE(root.get_variable_name() == "a");
+    REQUIRE(dag_walker::count_nodes_topological(root) == 4);
+    auto children = root.get_children();
+    REQUIRE(children.size() == 2);
+    REQUIRE(children[0].is_terminal());
+    REQUIRE(children[0].get_terminal_value() == 0);
+    REQUIRE(children[1].get_variable_name() == "c");
+    REQUIRE(root.get_edge_label(children[0], 0) == "0");
+    REQUIRE(root.get_edge_label(children[1], 1) == "1 (b=0)");
+
+    // The view reads the skipped level as b = 0, so there is one cube and no free variable
+    cudd_zdd_view view(mgr.get(), zdd.getNode(), 3);
+    cube_enumerator<cudd_zdd_view> cubes(view, 3);
+    REQUIRE(cubes.next());
+    REQUIRE(cubes.cube() == std::vector<std::int8_t>{1, 0, 1});
+    REQUIRE_FALSE(cubes.next());
+
+    // A family holding only the empty set is the one terminal; every variable is 0
+    auto none = parse_text("NOT a AND NOT b AND NOT c");
+    auto [none_mgr, none_zdd] =
+        convert_to_cudd_zdd(*none, std::unordered_set<std::string>(names.begin(), names.end()));
+    REQUIRE(cudd_zdd_iterator(*none_mgr, none_zdd.getNode(), &names).is_terminal());
+    REQUIRE(count_solutions(*none_mgr, none_zdd).to_string() == "1");
+    REQUIRE(assignments(cudd_zdd_view(none_mgr.get(), none_zdd.getNode(), 3), 3)
+            == std::set<std::vector<std::uint8_t>>{{0, 0, 0}});
+}
+
+TEST_CASE("cudd_zdd: N-Queens solutions are smaller as a ZDD", "[cudd_zdd]") {
+    auto expr = read_expression_from_file("test_expressions/four_queens.txt");
+    const auto names = names_of(*expr);
+    auto [mgr, zdd] =
+        convert_to_cudd_zdd(*expr, std::unordered_set<std::string>(names.begin(), names.end()));
+    std::unordered_map<std::string, int> var_map;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        var_map[names[i]] = static_cast<int>(i);
+    }
+    BDD bdd = convert_to_cudd_bdd_with_map(*expr, *mgr, var_map);
+
+    REQUIRE(count_solutions(*mgr, zdd).to_string()
+            == count_solutions(cudd_view(mgr.get(), bdd.getNode()), names.size()).to_string());
+    REQUIRE(Cudd_zddDagSize(zdd.getNode()) < bdd.nodeCount());
+    REQUIRE(dag_walker::count_nodes_topological(cudd_zdd_iterator(*mgr, zdd.getNode(), &names))
+            < dag_walker::count_nodes_topological(cudd_iterator(*mgr, bdd.getNode(), &names)));
+}
+
+TEST_CASE("cudd_zdd: DOT and node table output", "[cudd_zdd]") {
+    auto expr = parse_text("(a AND NOT b AND NOT c AND d) OR (NOT a AND b AND NOT c AND NOT d)");
+    const auto names = names_of(*expr);
+    auto [mgr, zdd] =
+        convert_to_cudd_zdd(*expr, std::unordered_set<std::string>(names.begin(), names.end()));
+
+    std::ostringstream dot;
+    write_cudd_zdd_to_dot(*mgr, zdd, names, dot);
+    REQUIRE_THAT(dot.str(), ContainsSubstring("digraph CUDD_ZDD"));
+    REQUIRE_THAT(dot.str(), ContainsSubstring("1 (b..c=0)"));
+    REQUIRE_THAT(dot.str(), ContainsSubstring("style = dashed"));
+
+    std::ostringstream table;
+    write_cudd_zdd_nodes_to_stream(*mgr, zdd, names, table);
+    REQUIRE_THAT(table.str(), ContainsSubstring("CUDD ZDD Node Table"));
+    REQUIRE_THAT(table.str(), ContainsSubstring("1 (b..c=0)->"));
+    REQUIRE_THAT(table.str(), ContainsSubstring("1 (c..d=0)->"));
+    REQUIRE_THAT(table.str(), ContainsSubstring("Total nodes: 5"));
+
+    std::ostringstream mermaid;
+    write_cudd_zdd_to_mermaid(*mgr, zdd, names, mermaid);
+    REQUIRE_THAT(mermaid.str(), ContainsSubstring("zddVariable"));
+}
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_equivalence_check.cpp
+ * @brief Tests for equivalence and implication checks between expressions
+ *
+ * Checks known rewrites with the full and the cofactor-by-cofactor check,
+ * evaluates every reported counterexample on the expressions themselves,
+ * and checks that the lazy check stops at the first differing cofactor.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "equivalence_check.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+
+namespace {
+
+// Evaluates an expression of plain variables under a counterexample
+bool evaluate(const my_expression& expr, const relation_result& result) {
+    return std::visit(
+        [&](const auto& node) -> bool {
+            using T = std::decay_t<decltype(node)>;
+            if constexpr (std::is_same_v<T, my_variable>) {
+                for (std::size_t i = 0; i < result.variables.size(); ++i) {
+                    if (result.variables[i] == node.variable_name) {
+                        return result.counterexample[i] != 0;
+                    }
+                }
+                FAIL("variable missing from the merged order: " << node.variable_name);
+                return false;
+            } else if constexpr (std::is_same_v<T, my_not>) {
+                return !evaluate(*node.expr, result);
+            } else if constexpr (std::is_same_v<T, my_and>) {
+                return evaluate(*node.left, result) && evaluate(*node.right, result);
+            } else if constexpr (std::is_same_v<T, my_or>) {
+                return evaluate(*node.left, result) || evaluate(*node.right, result);
+            } else if constexpr (std::is_same_v<T, my_xor>) {
+                return evaluate(*node.left, result) != evaluate(*node.right, result);
+            } else {
+                FAIL("unsupported expression node in test");
+                return false;
+            }
+        },
+        expr);
+}
+
+relation_result check(const std::string& left, const std::string& right,
+                      expression_relation relation, std::size_t lazy_split) {
+    auto l = parse_text(left);
+    auto r = parse_text(right);
+    auto result = lazy_split != 0 ? check_relation_lazy(*l, *r, relation, lazy_split)
+                                  : check_relation(*l, *r, relation);
+    if (!result.holds) {
+        // The counterexample must really separate the two expressions
+        REQUIRE(result.counterexample.size() == result.variables.size());
+        REQUIRE(evaluate(*l, result) == result.left_value);
+        REQUIRE(evaluate(*r, result) == result.right_value);
+        REQUIRE(result.left_value != result.right_value);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("equivalence_check: rewrites that hold", "[equivalence_check]") {
+    for (std::size_t split : {std::size_t{0}, std::size_t{1}, std::size_t{4}}) {
+        INFO("split variables: " << split);
+        REQUIRE(check("a AND (b OR c)", "(a AND b) OR (a AND c)",
+                      expression_relation::equivalent, split)
+                    .holds);
+        REQUIRE(check("a XOR b", "(a OR b) AND NOT (a AND b)", expression_relation::equivalent,
+                      split)
+                    .holds);
+        REQUIRE(check("a AND b", "a OR c", expression_relation::implies, split).holds);
+        REQUIRE(check("x[4] IN {8..15}", "x[4] >= 8", expression_relation::equivalent, split)
+                    .holds);
+        REQUIRE(check("EXACTLY_ONE(a, b)", "a XOR b", expression_relation::equivalent, split)
+                    .holds);
+    }
+
+    // Variables of either side are merged into one order
+    auto result = check("a", "a AND (b OR NOT b)", expression_relation::equivalent, 0);
+    REQUIRE(result.holds);
+    REQUIRE(result.variables == std::vector<std::string>{"a", "b"});
+    REQUIRE(result.counterexample.empty());
+}
+
+TEST_CASE("equivalence_check: counterexamples", "[equivalence_check]") {
+    for (std::size_t split : {std::size_t{0}, std::size_t{2}}) {
+        INFO("split variables: " << split);
+        auto or_xor = check("a OR b", "a XOR b", expression_relation::equivalent, split);
+        REQUIRE_FALSE(or_xor.holds);
+        REQUIRE(or_xor.counterexample == std::vector<std::uint8_t>{1, 1});
+
+        // Only left = 1, right = 0 breaks an implication
+        auto implication = check("a OR c", "a AND b", expression_relation::implies, split);
+        REQUIRE_FALSE(implication.holds);
+        REQUIRE(implication.left_value);
+
+        // The reverse difference is found when left is never true without right
+        auto reverse = check("a AND b", "a OR c", expression_relation::equivalent, split);
+        REQUIRE_FALSE(reverse.holds);
+        REQUIRE_FALSE(reverse.left_value);
+    }
+}
+
+TEST_CASE("equivalence_check: lazy check stops at the first differing cofactor",
+          "[equivalence_check]") {
+    // The sides differ when a = b = c = 0, the first cofactor tried
+    const std::string left = "a OR (b AND c) OR d";
+    const std::string right = "a OR (b AND c) OR NOT d";
+    auto result = check(left, right, expression_relation::equivalent, 3);
+    REQUIRE_FALSE(result.holds);
+    REQUIRE(result.cofactors == 1);
+    REQUIRE(result.counterexample[0] == 0);
+
+    // Proving equivalence tries every assignment of the split variables
+    auto same = check(left, "d OR (c AND b) OR a", expression_relation::equivalent, 3);
+    REQUIRE(same.holds);
+    REQUIRE(same.cofactors == 8);
+    REQUIRE(check(left, left, expression_relation::equivalent, 0).cofactors == 1);
+}
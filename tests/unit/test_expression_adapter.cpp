@@ -10,7 +10,10 @@
  */
 
 #include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <variant>
 
 #include "expression_adapter.hpp"
 #include "expression_types.hpp"
@@ -224,3 +227,60 @@ TEST_CASE("ExpressionAdapter - Error: evaluate called with invalid values",
     int val = adapter.evaluate(2, 3);
     REQUIRE((val == 0 || val == 1));
 }
+
+TEST_CASE("ExpressionAdapter - NOT right child is an ignored TRUE leaf",
+          "[expression_adapter][children]") {
+    std::unordered_map<std::string, int> var_map = {{"x", 0}};
+    my_expression expr = my_not{std::make_unique<my_expression>(
+        my_not{std::make_unique<my_expression>(my_variable{"x"})})};
+
+    expression_adapter adapter(expr, var_map);
+    const auto& right = adapter.get_right();
+    REQUIRE(right.is_constant());
+    REQUIRE(right.get_value() == 1);
+
+    // Both NOT nodes share the one leaf
+    REQUIRE(&adapter.get_left().get_right() == &right);
+    REQUIRE(adapter.get_left().get_left().get_index() == 0);
+}
+
+TEST_CASE("ExpressionAdapter - Copies share the child nodes", "[expression_adapter][copy]") {
+    std::unordered_map<std::string, int> var_map = {{"a", 0}, {"b", 1}};
+    my_expression expr = my_and{std::make_unique<my_expression>(my_variable{"a"}),
+                                std::make_unique<my_expression>(my_variable{"b"})};
+
+    expression_adapter copy = [&] {
+        expression_adapter adapter(expr, var_map);
+        return expression_adapter(adapter);
+    }();
+
+    // The original is gone; the copy keeps the nodes alive
+    REQUIRE(copy.get_left().get_index() == 0);
+    REQUIRE(copy.get_right().get_index() == 1);
+    REQUIRE(&expression_adapter(copy).get_left() == &copy.get_left());
+}
+
+TEST_CASE("ExpressionAdapter - Deeply nested NOT chain", "[expression_adapter][complex]") {
+    std::unordered_map<std::string, int> var_map = {{"x", 0}};
+    constexpr int depth = 2000;
+    auto expr = std::make_unique<my_expression>(my_variable{"x"});
+    for (int i = 0; i < depth; ++i) {
+        expr = std::make_unique<my_expression>(my_not{std::move(expr)});
+    }
+
+    expression_adapter adapter(*expr, var_map);
+    const expression_adapter* node = &adapter;
+    int nots = 0;
+    while (node->is_operation()) {
+        REQUIRE(node->get_right().is_constant());
+        node = &node->get_left();
+        ++nots;
+    }
+    REQUIRE(nots == depth);
+    REQUIRE(node->get_index() == 0);
+
+    // Release the chain iteratively so the test does not recurse as deep
+    while (auto* inner = std::get_if<my_not>(expr.get())) {
+        expr = std::move(inner->expr);
+    }
+}
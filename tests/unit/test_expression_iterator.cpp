@@ -10,6 +10,8 @@
  */
 
 #include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <type_traits>
 
 #include "expression_iterator.hpp"
 #include "expression_types.hpp"
@@ -217,6 +219,18 @@ TEST_CASE("ExpressionIterator - Copy semantics", "[expression_iterator][copy]")
     REQUIRE(iter1.get_node_address() == iter2.get_node_address());
 }
 
+TEST_CASE("ExpressionIterator - Pointer-sized value type", "[expression_iterator][copy]") {
+    // The walkers copy iterators into every child, node and edge list
+    STATIC_REQUIRE(sizeof(expression_iterator) == sizeof(const my_expression*));
+    STATIC_REQUIRE(std::is_trivially_copyable_v<expression_iterator>);
+
+    my_expression expr = my_not{std::make_unique<my_expression>(my_variable{"x"})};
+    expression_iterator iter(expr);
+    expression_iterator moved = std::move(iter);
+    REQUIRE(moved.get_label() == "NOT");
+    REQUIRE(moved.get_children()[0].get_label() == "x");
+}
+
 TEST_CASE("ExpressionIterator - Deep nested expression", "[expression_iterator][traversal]") {
     // Expression: ((a AND b) OR (c XOR d)) AND (NOT e)
     my_expression expr = my_and{
@@ -13,19 +13,19 @@
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include <filesystem>
 #include <fstream>
+#include <unordered_set>
+#include <vector>
 
 #include "dag_walker.hpp"
+#include "expression_graph.hpp"
 #include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
 
 using Catch::Matchers::ContainsSubstring;
 
 // Helper function to create a temporary test file
 std::string create_temp_expression_file(const std::string& content) {
-    // Use std::filesystem to get a cross-platform temp directory
-    std::filesystem::path temp_dir = std::filesystem::temp_directory_path();
-    std::filesystem::path temp_file =
-        temp_dir / ("test_expr_" + std::to_string(std::rand()) + ".txt");
-    std::string filename = temp_file.string();
+    std::string filename = unique_temp_path("test_expr_").string();
 
     std::ofstream file(filename);
     file << content;
@@ -374,3 +374,325 @@ TEST_CASE("ExpressionParser - Error: variable starts with digit",
 
     std::remove(filename.c_str());
 }
+
+TEST_CASE("ExpressionParser - Cardinality constraints", "[expression_parser][cardinality]") {
+    SECTION("EXACTLY_ONE takes only operands") {
+        std::string filename = create_temp_expression_file("EXACTLY_ONE(a, b, NOT c)");
+        auto expr = read_expression_from_file(filename);
+
+        REQUIRE(std::holds_alternative<my_cardinality>(*expr));
+        const auto& node = std::get<my_cardinality>(*expr);
+        REQUIRE(node.kind == cardinality_kind::exactly);
+        REQUIRE(node.k == 1);
+        REQUIRE(node.operands.size() == 3);
+        REQUIRE(std::get<my_variable>(*node.operands[0]).variable_name == "a");
+        REQUIRE(std::get<my_variable>(*node.operands[1]).variable_name == "b");
+        REQUIRE(std::holds_alternative<my_not>(*node.operands[2]));
+
+        std::remove(filename.c_str());
+    }
+
+    SECTION("_K forms take a bound and nested expressions") {
+        std::string filename =
+            create_temp_expression_file("AT_MOST_K(2, a AND b, c, d) AND AT_LEAST_K(1,x,y)");
+        auto expr = read_expression_from_file(filename);
+
+        REQUIRE(std::holds_alternative<my_and>(*expr));
+        const auto& and_node = std::get<my_and>(*expr);
+        const auto& at_most = std::get<my_cardinality>(*and_node.left);
+        REQUIRE(at_most.kind == cardinality_kind::at_most);
+        REQUIRE(at_most.k == 2);
+        REQUIRE(at_most.operands.size() == 3);
+        REQUIRE(std::holds_alternative<my_and>(*at_most.operands[0]));
+
+        const auto& at_least = std::get<my_cardinality>(*and_node.right);
+        REQUIRE(at_least.kind == cardinality_kind::at_least);
+        REQUIRE(at_least.k == 1);
+        REQUIRE(at_least.operands.size() == 2);
+
+        std::remove(filename.c_str());
+    }
+
+    SECTION("variables are still collected through cardinality nodes") {
+        std::string filename = create_temp_expression_file("EXACTLY_K(2, p, q, r)");
+        auto expr = read_expression_from_file(filename);
+
+        std::unordered_set<std::string> vars;
+        collect_variables_with_dag_walker(*expr, vars);
+        REQUIRE(vars == std::unordered_set<std::string>{"p", "q", "r"});
+
+        std::remove(filename.c_str());
+    }
+}
+
+TEST_CASE("ExpressionParser - Error: malformed cardinality constraints",
+          "[expression_parser][error_handling][cardinality]") {
+    for (const char* text : {"AT_MOST_K(a, b)", "AT_LEAST_K(2)", "EXACTLY_ONE()",
+                             "EXACTLY_ONE(a, b", "EXACTLY_ONE a, b", "AT_MOST_K(-1, a)"}) {
+        INFO("expression: " << text);
+        std::string filename = create_temp_expression_file(text);
+        REQUIRE_THROWS_WITH(read_expression_from_file(filename),
+                            ContainsSubstring("Parse error"));
+        std::remove(filename.c_str());
+    }
+}
+
+TEST_CASE("ExpressionParser - Cardinality keywords and commas end variable names",
+          "[expression_parser][error_handling][cardinality]") {
+    // Names like these parsed as variables before the cardinality constraints were added
+    for (const char* text : {"EXACTLY_ONE", "a AND AT_MOST_K", "a,b", "x OR y,z"}) {
+        INFO("expression: " << text);
+        std::string filename = create_temp_expression_file(text);
+        REQUIRE_THROWS_WITH(read_expression_from_file(filename),
+                            ContainsSubstring("Parse error"));
+        std::remove(filename.c_str());
+    }
+
+    // A keyword is only recognized as a whole word
+    std::string filename = create_temp_expression_file("EXACTLY_ONE_x OR AT_MOST_K2");
+    auto expr = read_expression_from_file(filename);
+    const auto& or_node = std::get<my_or>(*expr);
+    REQUIRE(std::get<my_variable>(*or_node.left).variable_name == "EXACTLY_ONE_x");
+    REQUIRE(std::get<my_variable>(*or_node.right).variable_name == "AT_MOST_K2");
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("ExpressionParser - TRUE and FALSE constants", "[expression_parser][constants]") {
+    std::string filename = create_temp_expression_file("x AND (TRUE OR NOT FALSE)");
+    auto expr = read_expression_from_file(filename);
+
+    const auto& and_node = std::get<my_and>(*expr);
+    const auto& or_node = std::get<my_or>(*and_node.right);
+    REQUIRE(std::get<my_constant>(*or_node.left).value);
+    REQUIRE_FALSE(std::get<my_constant>(*std::get<my_not>(*or_node.right).expr).value);
+
+    // Constants are not variables
+    std::unordered_set<std::string> vars;
+    collect_variables_with_dag_walker(*expr, vars);
+    REQUIRE(vars == std::unordered_set<std::string>{"x"});
+    std::remove(filename.c_str());
+
+    // The keywords are case sensitive and whole words only
+    filename = create_temp_expression_file("true AND TRUE_1 AND FALSEx");
+    expr = read_expression_from_file(filename);
+    vars.clear();
+    collect_variables_with_dag_walker(*expr, vars);
+    REQUIRE(vars == std::unordered_set<std::string>{"true", "TRUE_1", "FALSEx"});
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("ExpressionParser - Field comparisons", "[expression_parser][field]") {
+    SECTION("first use declares the width, later uses inherit it") {
+        std::string filename = create_temp_expression_file(
+            "port[16] == 443 OR (port >= 0x400 AND ttl[8] < 0b1000000)");
+        auto expr = read_expression_from_file(filename);
+
+        const auto& or_node = std::get<my_or>(*expr);
+        const auto& eq = std::get<my_compare>(*or_node.left);
+        REQUIRE(eq.field == my_field{"port", 16});
+        REQUIRE(eq.op == compare_op::eq);
+        REQUIRE(eq.value == 443);
+        REQUIRE_FALSE(eq.rhs_field.has_value());
+
+        const auto& and_node = std::get<my_and>(*or_node.right);
+        const auto& ge = std::get<my_compare>(*and_node.left);
+        REQUIRE(ge.field == my_field{"port", 16});
+        REQUIRE(ge.op == compare_op::ge);
+        REQUIRE(ge.value == 0x400);
+        const auto& lt = std::get<my_compare>(*and_node.right);
+        REQUIRE(lt.field == my_field{"ttl", 8});
+        REQUIRE(lt.op == compare_op::lt);
+        REQUIRE(lt.value == 64);
+
+        std::remove(filename.c_str());
+    }
+
+    SECTION("IN takes values and ranges") {
+        std::string filename = create_temp_expression_file("NOT proto[8] IN {6, 17, 100..120}");
+        auto expr = read_expression_from_file(filename);
+
+        const auto& not_node = std::get<my_not>(*expr);
+        const auto& in = std::get<my_compare>(*not_node.expr);
+        REQUIRE(in.op == compare_op::in);
+        REQUIRE(in.ranges == std::vector<std::pair<uint64_t, uint64_t>>{
+                                 {6, 6}, {17, 17}, {100, 120}});
+
+        std::remove(filename.c_str());
+    }
+
+    SECTION("fields compare with fields and contribute one variable per bit") {
+        std::string filename = create_temp_expression_file("a[2] != b[2] AND x");
+        auto expr = read_expression_from_file(filename);
+
+        const auto& and_node = std::get<my_and>(*expr);
+        const auto& ne = std::get<my_compare>(*and_node.left);
+        REQUIRE(ne.op == compare_op::ne);
+        REQUIRE(ne.rhs_field == my_field{"b", 2});
+
+        std::unordered_set<std::string> vars;
+        collect_variables_with_dag_walker(*expr, vars);
+        REQUIRE(vars == std::unordered_set<std::string>{"a[0]", "a[1]", "b[0]", "b[1]", "x"});
+        // Plain variables first, then field bits interleaved from the most significant bit
+        REQUIRE(ordered_variable_names(vars)
+                == std::vector<std::string>{"x", "a[1]", "b[1]", "a[0]", "b[0]"});
+
+        std::remove(filename.c_str());
+    }
+}
+
+TEST_CASE("ExpressionParser - Error: malformed field comparisons",
+          "[expression_parser][error_handling][field]") {
+    for (const char* text :
+         {"port == 1", "port[0] == 0", "port[65] == 0", "port[4] == 16", "port[4] = 1",
+          "port[4] == 1 AND port[5] == 1", "a[4] < b[5]", "a[4] IN {}", "a[4] IN {3..1}",
+          "a[4] IN {1, 2", "a[4] == 0x", "a[4] <", "a[4] AND b"}) {
+        INFO("expression: " << text);
+        std::string filename = create_temp_expression_file(text);
+        REQUIRE_THROWS_WITH(read_expression_from_file(filename),
+                            ContainsSubstring("Parse error"));
+        std::remove(filename.c_str());
+    }
+}
+
+TEST_CASE("ExpressionParser - Field syntax and IN end variable names",
+          "[expression_parser][error_handling][field]") {
+    // Names like these parsed as variables before the field comparisons were added
+    for (const char* text : {"a<b", "a!=b", "lo..hi", "v[0]", "set{1}", "IN", "a OR IN"}) {
+        INFO("expression: " << text);
+        std::string filename = create_temp_expression_file(text);
+        REQUIRE_THROWS_WITH(read_expression_from_file(filename),
+                            ContainsSubstring("Parse error"));
+        std::remove(filename.c_str());
+    }
+
+    // '=' splits x=1 into an output named x whose expression is the variable 1
+    std::string filename = create_temp_expression_file("x=1");
+    auto expr = read_expression_from_file(filename);
+    REQUIRE(std::get<my_variable>(*expr).variable_name == "1");
+    std::remove(filename.c_str());
+
+    // IN is only recognized as a whole word
+    filename = create_temp_expression_file("INPUT AND x_IN");
+    expr = read_expression_from_file(filename);
+    const auto& and_node = std::get<my_and>(*expr);
+    REQUIRE(std::get<my_variable>(*and_node.left).variable_name == "INPUT");
+    REQUIRE(std::get<my_variable>(*and_node.right).variable_name == "x_IN");
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("ExpressionParser - Enumerated DOMAIN fields", "[expression_parser][domain]") {
+    std::string filename = create_temp_expression_file(
+        "DOMAIN color {red, green, blue}\n"
+        "DOMAIN level 5\n"
+        "color != green AND level IN {1, 3..4} OR color == 2");
+    auto expr = read_expression_from_file(filename);
+
+    // The output is restricted to the valid codes of each field whose domain is not a
+    // power of two, in name order
+    const auto& level_root = std::get<my_and>(*expr);
+    const auto& level_domain = std::get<my_compare>(*level_root.right);
+    REQUIRE(level_domain.field.name == "level");
+    REQUIRE(level_domain.ranges == std::vector<std::pair<uint64_t, uint64_t>>{{0, 4}});
+    const auto& color_root = std::get<my_and>(*level_root.left);
+    const auto& color_domain = std::get<my_compare>(*color_root.right);
+    REQUIRE(color_domain.field.name == "color");
+    REQUIRE(color_domain.ranges == std::vector<std::pair<uint64_t, uint64_t>>{{0, 2}});
+
+    const auto& or_node = std::get<my_or>(*color_root.left);
+    const auto& and_node = std::get<my_and>(*or_node.left);
+
+    // Every comparison is normalized to IN over the domain
+    const auto& ne = std::get<my_compare>(*and_node.left);
+    REQUIRE(ne.field.name == "color");
+    REQUIRE(ne.field.domain == 3);
+    REQUIRE(ne.field.width == 2);
+    REQUIRE(ne.field.value_names == std::vector<std::string>{"red", "green", "blue"});
+    REQUIRE(ne.op == compare_op::in);
+    REQUIRE(ne.ranges == std::vector<std::pair<uint64_t, uint64_t>>{{0, 0}, {2, 2}});
+
+    const auto& in = std::get<my_compare>(*and_node.right);
+    REQUIRE(in.field.domain == 5);
+    REQUIRE(in.field.width == 3);
+    REQUIRE(in.ranges == std::vector<std::pair<uint64_t, uint64_t>>{{1, 1}, {3, 4}});
+
+    const auto& eq = std::get<my_compare>(*or_node.right);
+    REQUIRE(eq.ranges == std::vector<std::pair<uint64_t, uint64_t>>{{2, 2}});
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("ExpressionParser - Error: malformed DOMAIN declarations",
+          "[expression_parser][error_handling][domain]") {
+    for (const char* text :
+         {"DOMAIN c {a} c == a", "DOMAIN c 1 c == 0", "DOMAIN c {a, a} c == a",
+          "DOMAIN c {a, b} c == d", "DOMAIN c 3 c == 3", "DOMAIN c {a, b} c[2] == 1",
+          "DOMAIN c {a, b} DOMAIN c {a, b} c == a", "DOMAIN c {a, b} x[1] == c",
+          "DOMAIN {a, b} c == a", "DOMAIN c {a, 1} c == a", "DOMAIN", "a OR DOMAIN"}) {
+        INFO("expression: " << text);
+        std::string filename = create_temp_expression_file(text);
+        REQUIRE_THROWS_WITH(read_expression_from_file(filename),
+                            ContainsSubstring("Parse error"));
+        std::remove(filename.c_str());
+    }
+}
+
+TEST_CASE("ExpressionParser - let definitions and named outputs",
+          "[expression_parser][definitions]") {
+    std::string filename = create_temp_expression_file(
+        "# Two filters over one definition\n"
+        "let web = port[16] IN {80, 443};\n"
+        "let trusted = web AND NOT blocked;\n"
+        "allow = trusted OR admin;\n"
+        "log = web XOR trusted\n");
+    auto program = read_program_from_file(filename);
+
+    REQUIRE(program.definitions.size() == 2);
+    REQUIRE(program.definitions[0].name == "web");
+    REQUIRE(std::holds_alternative<my_compare>(*program.definitions[0].expr));
+    REQUIRE(program.outputs.size() == 2);
+    REQUIRE(program.outputs[0].name == "allow");
+    REQUIRE(program.outputs[1].name == "log");
+
+    // References stay names instead of copies of the definition
+    const auto& allow = std::get<my_or>(*program.outputs[0].expr);
+    REQUIRE(std::get<my_variable>(*allow.left).variable_name == "trusted");
+
+    // A bare expression is a single unnamed output
+    std::string single = create_temp_expression_file("a AND b");
+    auto plain = read_program_from_file(single);
+    REQUIRE(plain.definitions.empty());
+    REQUIRE(plain.outputs.size() == 1);
+    REQUIRE(plain.outputs[0].name.empty());
+
+    REQUIRE_THROWS_WITH(read_expression_from_file(filename), ContainsSubstring("2 outputs"));
+    std::remove(filename.c_str());
+    std::remove(single.c_str());
+}
+
+TEST_CASE("ExpressionParser - definitions are expanded for a single output",
+          "[expression_parser][definitions]") {
+    std::string filename =
+        create_temp_expression_file("let ab = a AND b; let both = ab OR ab; f = NOT both;");
+    auto expr = read_expression_from_file(filename);
+
+    const auto& negation = std::get<my_not>(*expr);
+    const auto& both = std::get<my_or>(*negation.expr);
+    const auto& ab = std::get<my_and>(*both.right);
+    REQUIRE(std::get<my_variable>(*ab.left).variable_name == "a");
+    REQUIRE(std::get<my_variable>(*ab.right).variable_name == "b");
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("ExpressionParser - Error: malformed definitions",
+          "[expression_parser][error_handling][definitions]") {
+    for (const char* text :
+         {"let a = x;", "let a = x; let a = y; f = a;", "f = x; f = y;", "let a = x; a = y;",
+          "f = a; let a = x; g = a;", "let a = a OR x; f = a;", "let f = x f = y",
+          "let a = x; a[4] == 1", "let port = x; f = port[4] == 1;", "f = x; a OR b",
+          "let 1 = x; f = x;", "a;b", "let", "let OR x"}) {
+        INFO("expression: " << text);
+        std::string filename = create_temp_expression_file(text);
+        REQUIRE_THROWS_WITH(read_program_from_file(filename), ContainsSubstring("Parse error"));
+        std::remove(filename.c_str());
+    }
+}
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_expression_simplify.cpp
+ * @brief Tests for the algebraic simplification pass
+ *
+ * Checks each rewrite rule on small expressions and that simplified test
+ * expressions build the same BDD as the originals.
+ */
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_simplify.hpp"
+#include "expression_test_utils.hpp"
+#include "teddy_convert.hpp"
+
+namespace {
+
+std::string simplified_text(const std::string& contents, simplify_stats* stats = nullptr) {
+    return expression_to_string(*simplify_expression(*parse_text(contents), stats));
+}
+
+// Builds both expressions over the variables of the original
+void require_equivalent(const my_expression& original, const my_expression& simplified) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(original, names);
+    const auto order = ordered_variable_names(names);
+    std::unordered_map<std::string, int> var_map;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        var_map[order[i]] = static_cast<int>(i);
+    }
+    teddy::bdd_manager mgr(static_cast<int>(std::max<std::size_t>(order.size(), 1)), 10'000);
+    REQUIRE(convert_to_bdd_with_map(original, mgr, var_map)
+                .equals(convert_to_bdd_with_map(simplified, mgr, var_map)));
+}
+
+}  // namespace
+
+TEST_CASE("expression_simplify: rewrite rules", "[expression_simplify]") {
+    simplify_stats stats;
+
+    REQUIRE(simplified_text("NOT NOT x", &stats) == "x");
+    REQUIRE(stats.double_negations == 1);
+
+    REQUIRE(simplified_text("x AND y AND x", &stats) == "(x AND y)");
+    REQUIRE(stats.idempotence == 1);
+    REQUIRE(stats.flattened == 1);
+
+    REQUIRE(simplified_text("x AND (y OR x)", &stats) == "x");
+    REQUIRE(simplified_text("(x AND y) OR x", &stats) == "x");
+    REQUIRE(stats.absorption == 2);
+
+    REQUIRE(simplified_text("a AND x AND NOT x", &stats) == "FALSE");
+    REQUIRE(simplified_text("NOT x OR x", &stats) == "TRUE");
+    REQUIRE(simplified_text("x AND NOT (y OR x)", &stats) == "FALSE");
+    REQUIRE(stats.complements == 3);
+
+    REQUIRE(simplified_text("x XOR y XOR x", &stats) == "y");
+    REQUIRE(simplified_text("x XOR NOT x", &stats) == "TRUE");
+    REQUIRE(simplified_text("NOT a XOR NOT b", &stats) == "(a XOR b)");
+    REQUIRE(stats.xor_cancellations == 2);
+
+    // Negations go down to the operands, but no more of them are built
+    REQUIRE(simplified_text("NOT (a AND (b OR NOT c))", &stats) == "(NOT a OR (NOT b AND c))");
+    REQUIRE(stats.de_morgan == 2);
+    REQUIRE(simplified_text("NOT (a AND b AND c)", &stats) == "NOT ((a AND b) AND c)");
+    REQUIRE(simplified_text("NOT a AND c AND NOT b", &stats) == "(NOT (a OR b) AND c)");
+    REQUIRE(stats.de_morgan == 3);
+}
+
+TEST_CASE("expression_simplify: constants", "[expression_simplify]") {
+    REQUIRE(simplified_text("x AND TRUE") == "x");
+    REQUIRE(simplified_text("x AND FALSE") == "FALSE");
+    REQUIRE(simplified_text("x OR TRUE") == "TRUE");
+    REQUIRE(simplified_text("NOT FALSE OR x") == "TRUE");
+    REQUIRE(simplified_text("x XOR TRUE") == "NOT x");
+    REQUIRE(simplified_text("(a AND b) XOR TRUE") == "NOT (a AND b)");
+
+    // Constant operands move the bound of a cardinality constraint
+    REQUIRE(simplified_text("AT_MOST_K(1, a, TRUE, b)") == "AT_MOST_K(0, a, b)");
+    REQUIRE(simplified_text("EXACTLY_ONE(a, TRUE, TRUE)") == "FALSE");
+    REQUIRE(simplified_text("AT_LEAST_K(2, a, TRUE, FALSE, TRUE)") == "TRUE");
+    REQUIRE(simplified_text("EXACTLY_K(3, a, b)") == "FALSE");
+    REQUIRE(simplified_text("AT_MOST_K(2, a, b)") == "TRUE");
+
+    simplify_stats stats;
+    auto expr = simplify_expression(*parse_text("FALSE OR (a AND TRUE)"), &stats);
+    REQUIRE(expression_to_string(*expr) == "a");
+    REQUIRE(stats.constants == 2);
+    REQUIRE(stats.nodes_before == 5);
+    REQUIRE(stats.nodes_after == 1);
+}
+
+TEST_CASE("expression_simplify: negations of comparisons and counters", "[expression_simplify]") {
+    REQUIRE(simplified_text("NOT (port[8] < 5)") == "port[8] >= 5");
+    REQUIRE(simplified_text("NOT (port[8] == dst[8])") == "port[8] != dst[8]");
+    REQUIRE(simplified_text("NOT (port[8] IN {1, 3})") == "NOT port[8] IN {1, 3}");
+    REQUIRE(simplified_text("NOT AT_MOST_K(1, a, b, c)") == "AT_LEAST_K(2, a, b, c)");
+    REQUIRE(simplified_text("NOT AT_LEAST_K(2, a, b, c)") == "AT_MOST_K(1, a, b, c)");
+    REQUIRE(simplified_text("NOT EXACTLY_ONE(a, b)") == "NOT EXACTLY_ONE(a, b)");
+}
+
+TEST_CASE("expression_simplify: simplified test expressions are equivalent",
+          "[expression_simplify]") {
+    for (const char* file :
+         {"test_expressions/all_operators.txt", "test_expressions/deeply_nested.txt",
+          "test_expressions/filter_expression.txt", "test_expressions/four_queens.txt",
+          "test_expressions/multiple_not.txt", "test_expressions/same_variable.txt",
+          "test_expressions/xor_chain.txt"}) {
+        INFO("file: " << file);
+        auto original = read_expression_from_file(file);
+        simplify_stats stats;
+        auto simplified = simplify_expression(*original, &stats);
+        REQUIRE(stats.nodes_after <= stats.nodes_before);
+        require_equivalent(*original, *simplified);
+    }
+
+    // Redundant operators in a larger expression
+    auto original = parse_text(
+        "NOT NOT (a AND b AND a) OR (c XOR d XOR c) OR NOT (NOT e OR (f AND TRUE)) "
+        "OR (g AND (g OR h)) OR (x0 AND NOT x0) OR AT_MOST_K(1, x1, FALSE, x2)");
+    auto simplified = simplify_expression(*original);
+    REQUIRE(expression_size(*simplified) < expression_size(*original));
+    require_equivalent(*original, *simplified);
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_file_watcher.cpp
+ * @brief Tests for save notifications of file_watcher
+ *
+ * Covers a timeout without changes, an in-place save and a save that
+ * replaces the file by renaming a temporary file onto it.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "expression_test_utils.hpp"
+#include "file_watcher.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("file_watcher: reports saves of the watched file", "[file_watcher]") {
+    const auto directory = unique_temp_path("test_file_watcher_", "");
+    std::filesystem::create_directories(directory);
+    const auto path = directory / "filter.txt";
+    std::ofstream(path) << "a AND b\n";
+
+    file_watcher watcher(path);
+    REQUIRE_FALSE(watcher.wait(50ms));
+
+    // Other files in the directory are ignored
+    std::ofstream(directory / "other.txt") << "c\n";
+    REQUIRE_FALSE(watcher.wait(50ms));
+
+    std::thread writer([&] {
+        std::this_thread::sleep_for(100ms);
+        std::ofstream(path) << "a OR b\n";
+    });
+    REQUIRE(watcher.wait(10s));
+    writer.join();
+
+    std::thread replacer([&] {
+        std::this_thread::sleep_for(100ms);
+        std::ofstream(directory / "filter.txt.tmp") << "a XOR b\n";
+        std::filesystem::rename(directory / "filter.txt.tmp", path);
+    });
+    REQUIRE(watcher.wait(10s));
+    replacer.join();
+
+    std::filesystem::remove_all(directory);
+}
@@ -5,12 +5,11 @@
  * @file tests/unit/test_graph_render_helpers.cpp
  * @brief Tests for graph rendering helper functions
  *
- * Validates label escaping, node/edge rendering helpers, property joining and
- * class assignment flattening used across DOT and Mermaid generators.
+ * Validates label escaping, node/edge rendering helpers and property joining
+ * used across DOT and Mermaid generators.
  */
 
 #include <catch2/catch_test_macros.hpp>
-#include <unordered_map>
 #include <vector>
 
 #include "graph_render_helpers.hpp"
@@ -41,17 +40,7 @@ TEST_CASE("graph_render_helpers - render_edge_line styles and labels", "[graph_r
     REQUIRE(dashed.find("|\"lbl\"|") != std::string::npos);
 }
 
-TEST_CASE("graph_render_helpers - flatten_and_sort_class_assignments and join_dot_properties",
-          "[graph_render_helpers]") {
-    std::unordered_map<std::string, std::vector<std::string>> map;
-    map["classA"] = {"N2", "N10"};
-    map["classB"] = {"N1"};
-
-    auto pairs = graph_render_helpers::flatten_and_sort_class_assignments(map);
-    REQUIRE(!pairs.empty());
-    // Ensure sort order uses node_id_less (N1, N2, N10 expected order)
-    REQUIRE(pairs[0].first == "N1");
-
+TEST_CASE("graph_render_helpers - join_dot_properties", "[graph_render_helpers]") {
     std::vector<std::string> props = {"label = \"X\"", "shape=box"};
     auto joined = graph_render_helpers::join_dot_properties(props);
     REQUIRE(joined.front() == '[');
@@ -75,17 +64,3 @@ TEST_CASE("graph_render_helpers - join_dot_properties empty", "[graph_render_hel
     auto j = graph_render_helpers::join_dot_properties(no_props);
     REQUIRE(j.empty());
 }
-
-TEST_CASE("graph_render_helpers - flatten with duplicates and empty map",
-          "[graph_render_helpers][negative]") {
-    std::unordered_map<std::string, std::vector<std::string>> empty_map;
-    auto empty_pairs = graph_render_helpers::flatten_and_sort_class_assignments(empty_map);
-    REQUIRE(empty_pairs.empty());
-
-    std::unordered_map<std::string, std::vector<std::string>> dup_map;
-    dup_map["classA"] = {"N1", "N2"};
-    dup_map["classB"] = {"N2", "N3"};
-    auto pairs = graph_render_helpers::flatten_and_sort_class_assignments(dup_map);
-    // Even with duplicates across classes, function returns flattened pairs - size should be 4
-    REQUIRE(pairs.size() == 4);
-}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_incremental_convert.cpp
+ * @brief Tests for the subtree cache used by incremental conversion
+ *
+ * Checks the structural hash, that conversions through the cache give the
+ * same diagram as a plain conversion while reusing unchanged subtrees, and
+ * that a saved cache is reused by a fresh manager only with the same
+ * variable order.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "incremental_convert.hpp"
+#include "teddy_convert.hpp"
+
+namespace {
+
+std::filesystem::path temp_path(const std::string& suffix) {
+    return unique_temp_path("test_incremental_convert_", suffix);
+}
+
+std::vector<std::string> order_of(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return ordered_variable_names(names);
+}
+
+constexpr std::size_t count_none = static_cast<std::size_t>(-1);
+
+// A filter-like disjunction of terms; `edited` changes one term
+std::string terms(std::size_t count, std::size_t edited = count_none) {
+    std::string text;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::string n = std::to_string(i);
+        text += i == 0 ? "" : " OR ";
+        text += "(x" + n + " AND NOT y" + n + " AND (z" + n + (i == edited ? " AND " : " OR ")
+                + "w" + n + ") AND port[8] != " + n + ")";
+    }
+    return text;
+}
+
+teddy::bdd_manager::diagram_t plain_convert(const my_expression& expr,
+                                            teddy::bdd_manager& mgr,
+                                            const std::vector<std::string>& order) {
+    std::unordered_map<std::string, int> var_map;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        var_map[order[i]] = static_cast<int>(i);
+    }
+    return convert_to_bdd_with_map(expr, mgr, var_map);
+}
+
+}  // namespace
+
+TEST_CASE("incremental_convert: structural hash", "[incremental_convert]") {
+    auto hash = [](const std::string& text) {
+        return incremental::structural_hash(*parse_text(text));
+    };
+    REQUIRE(hash("a AND (b OR NOT c)") == hash("a AND (b OR NOT c)"));
+    REQUIRE_FALSE(hash("a AND b") == hash("b AND a"));
+    REQUIRE_FALSE(hash("a AND b") == hash("a OR b"));
+    REQUIRE_FALSE(hash("a AND b") == hash("a AND bb"));
+    REQUIRE_FALSE(hash("port[16] == 80") == hash("port[16] == 8080"));
+    REQUIRE_FALSE(hash("AT_MOST_K(1, a, b, c)") == hash("AT_LEAST_K(1, a, b, c)"));
+}
+
+TEST_CASE("incremental_convert: edits reuse unchanged subtrees", "[incremental_convert]") {
+    auto original = parse_text(terms(12));
+    auto edited = parse_text(terms(12, 5));
+    const auto order = order_of(*original);
+    REQUIRE(order_of(*edited) == order);
+
+    teddy::bdd_manager mgr(static_cast<int>(order.size()), 10'000);
+    incremental::subtree_cache cache(mgr, order, 4);
+
+    incremental::convert_stats first;
+    auto f = cache.convert(*original, &first);
+    REQUIRE(f.equals(plain_convert(*original, mgr, order)));
+    REQUIRE(first.reused == 0);
+    REQUIRE(first.rebuilt == expression_size(*original));
+
+    // The same expression again is one lookup
+    incremental::convert_stats again;
+    REQUIRE(cache.convert(*original, &again).equals(f));
+    REQUIRE(again.reused == 1);
+    REQUIRE(again.rebuilt == 0);
+
+    // Only the edited term and the spine above it are rebuilt
+    incremental::convert_stats after_edit;
+    auto g = cache.convert(*edited, &after_edit);
+    REQUIRE(g.equals(plain_convert(*edited, mgr, order)));
+    REQUIRE(after_edit.reused > 0);
+    REQUIRE(after_edit.rebuilt < expression_size(*edited) / 2);
+    REQUIRE(after_edit.reused_nodes + after_edit.rebuilt == expression_size(*edited));
+    REQUIRE(cache.size() == after_edit.cached);
+}
+
+TEST_CASE("incremental_convert: saved caches", "[incremental_convert]") {
+    auto original = parse_text(terms(8));
+    auto edited = parse_text(terms(8, 7));
+    const auto order = order_of(*original);
+    const auto path = temp_path(".cache");
+
+    {
+        teddy::bdd_manager mgr(static_cast<int>(order.size()), 10'000);
+        incremental::subtree_cache cache(mgr, order, 4);
+        REQUIRE(cache.load(path) == 0);  // No file yet
+        cache.convert(*original);
+        cache.save(path);
+    }
+
+    // A later run starts from the saved diagrams in a new manager
+    teddy::bdd_manager mgr(static_cast<int>(order.size()), 10'000);
+    incremental::subtree_cache cache(mgr, order, 4);
+    REQUIRE(cache.load(path) > 0);
+    incremental::convert_stats stats;
+    auto g = cache.convert(*edited, &stats);
+    REQUIRE(g.equals(plain_convert(*edited, mgr, order)));
+    REQUIRE(stats.reused > 0);
+
+    // A different variable order does not fit the saved diagrams
+    auto reordered = order;
+    reordered.push_back("extra");
+    teddy::bdd_manager other(static_cast<int>(reordered.size()), 1'000);
+    incremental::subtree_cache mismatched(other, reordered, 4);
+    REQUIRE(mismatched.load(path) == 0);
+    REQUIRE(mismatched.size() == 0);
+
+    {
+        std::ofstream corrupt(path, std::ios::binary | std::ios::trunc);
+        corrupt << "not a cache";
+    }
+    REQUIRE_THROWS_AS(cache.load(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
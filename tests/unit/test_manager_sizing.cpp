@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_manager_sizing.cpp
+ * @brief Tests for the TeDDy and CUDD manager sizing policy
+ *
+ * Checks the estimates and their bounds, pool growth accounting, sizing
+ * profiles, and that sized managers build the same diagrams as the defaults.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "manager_sizing.hpp"
+#include "teddy_convert.hpp"
+#include "workload_generator.hpp"
+
+namespace {
+
+std::filesystem::path temp_path(const std::string& stem) {
+    return unique_temp_path(stem);
+}
+
+}  // namespace
+
+TEST_CASE("manager_sizing: estimates grow with the input and stay bounded",
+          "[manager_sizing]") {
+    REQUIRE(expression_size(*parse_text("(a AND NOT b) OR c")) == 6);
+
+    // Small inputs keep the old 1,000-node floor and get a smaller cache than CUDD's default
+    auto small = size_managers(6, 3);
+    REQUIRE(small.teddy_pool == 1'000);
+    REQUIRE(small.cudd_unique_slots == CUDD_UNIQUE_SLOTS);
+    REQUIRE(small.cudd_cache_slots < CUDD_CACHE_SLOTS);
+
+    auto large = size_managers(200'000, 100);
+    REQUIRE(large.teddy_pool == 1'600'200);
+    REQUIRE(large.teddy_overflow == large.teddy_pool / 2);
+    REQUIRE(large.cudd_unique_slots > CUDD_UNIQUE_SLOTS);
+    REQUIRE(large.cudd_cache_slots > small.cudd_cache_slots);
+    REQUIRE((large.cudd_unique_slots & (large.cudd_unique_slots - 1)) == 0);
+    REQUIRE((large.cudd_cache_slots & (large.cudd_cache_slots - 1)) == 0);
+
+    // A previous peak overrides the expression-based estimate, with headroom
+    REQUIRE(size_managers(6, 3, 40'000).estimated_nodes == 50'000);
+    REQUIRE(estimate_peak_nodes(std::size_t{1} << 40, 10) == std::size_t{1} << 24);
+}
+
+TEST_CASE("manager_sizing: pool growth counts overflow pools", "[manager_sizing]") {
+    manager_sizing sizing;
+    REQUIRE(teddy_pool_growth(sizing, 900) == 0);
+    REQUIRE(teddy_pool_growth(sizing, 1'000) == 0);
+    REQUIRE(teddy_pool_growth(sizing, 1'001) == 1);
+    REQUIRE(teddy_pool_growth(sizing, 2'001) == 3);
+}
+
+TEST_CASE("manager_sizing: profiles round-trip the peak", "[manager_sizing]") {
+    auto path = temp_path("test_sizing_profile_");
+    REQUIRE(read_sizing_profile(path) == 0);
+
+    write_sizing_profile(path, 12'345);
+    REQUIRE(read_sizing_profile(path) == 12'345);
+
+    {
+        std::ofstream file(path);
+        file << "not a profile\n";
+    }
+    REQUIRE_THROWS_AS(read_sizing_profile(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("manager_sizing: sized managers build the same diagrams", "[manager_sizing]") {
+    workload_generator::GeneratorOptions options;
+    options.n = 5;
+    auto expr = parse_text(workload_generator::generate_n_queens(options));
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(*expr, names);
+    auto sizing = size_managers(expression_size(*expr), names.size());
+
+    teddy::bdd_manager fixed(static_cast<int>(names.size()), 1'000);
+    teddy::bdd_manager sized(static_cast<int>(names.size()), sizing.teddy_pool,
+                             sizing.teddy_overflow);
+    auto f = convert_to_bdd(*expr, fixed);
+    auto g = convert_to_bdd(*expr, sized);
+    REQUIRE(fixed.get_node_count(f) == sized.get_node_count(g));
+    REQUIRE(fixed.satisfy_count(f) == sized.satisfy_count(g));
+
+    auto [default_mgr, reference] = convert_to_cudd_bdd(*expr, names);
+    auto [sized_mgr, h] = convert_to_cudd_bdd(*expr, names, nullptr, sizing);
+    REQUIRE(sized_mgr->ReadCacheSlots() >= sizing.cudd_cache_slots);
+    REQUIRE(h.nodeCount() == reference.nodeCount());
+}
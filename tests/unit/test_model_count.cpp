@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_model_count.cpp
+ * @brief Tests for solution counting and enumeration over BDDs
+ *
+ * Compares counts from TeDDy, CUDD and the native package with brute-force
+ * evaluation, checks counts beyond 64 bits, and checks that the enumerators
+ * produce exactly the satisfying assignments.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "model_count.hpp"
+#include "native_convert.hpp"
+#include "teddy_convert.hpp"
+#include "workload_generator.hpp"
+
+namespace {
+
+std::unordered_set<std::string> variables_of(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return names;
+}
+
+// Counts the assignments of a TeDDy BDD by evaluating every one
+std::uint64_t brute_force_count(const teddy::bdd_manager& mgr,
+                                const teddy::bdd_manager::diagram_t& f, std::size_t n) {
+    std::uint64_t count = 0;
+    std::vector<int> values(n);
+    for (std::uint64_t row = 0; row < (std::uint64_t{1} << n); ++row) {
+        for (std::size_t i = 0; i < n; ++i) {
+            values[i] = static_cast<int>((row >> i) & 1);
+        }
+        count += mgr.evaluate(f, values) == 1 ? 1 : 0;
+    }
+    return count;
+}
+
+std::string queens(int n) {
+    workload_generator::GeneratorOptions options;
+    options.n = n;
+    return workload_generator::generate_n_queens(options);
+}
+
+}  // namespace
+
+TEST_CASE("model_count: big_count arithmetic", "[model_count]") {
+    REQUIRE(big_count().to_string() == "0");
+    REQUIRE(big_count(1'000'000'000).to_string() == "1000000000");
+    REQUIRE(big_count(1).shifted_left(100).to_string() == "1267650600228229401496703205376");
+
+    big_count sum(0xFFFF'FFFF'FFFF'FFFF);
+    sum += big_count(1);
+    REQUIRE(sum == big_count(1).shifted_left(64));
+    REQUIRE(sum.to_string() == "18446744073709551616");
+    REQUIRE(big_count(3).shifted_left(33).to_double() == 3.0 * 8589934592.0);
+}
+
+TEST_CASE("model_count: counts match brute force on every backend", "[model_count]") {
+    for (const std::string source : {"a OR (b AND c) OR d", "(a AND b) XOR (c OR NOT d) XOR e",
+                                     "EXACTLY_ONE(p, q, r, s) AND NOT (p AND t)",
+                                     "x[4] >= 5 AND y[4] != x[4]", "a AND NOT a"}) {
+        INFO("expression: " << source);
+        auto expr = parse_text(source);
+        const auto names = variables_of(*expr);
+        const auto n = names.size();
+
+        teddy::bdd_manager mgr(static_cast<int>(n), 1'000);
+        auto f = convert_to_bdd(*expr, mgr);
+        const big_count expected(brute_force_count(mgr, f, n));
+        REQUIRE(count_solutions(mgr, f) == expected);
+
+        auto [cudd_mgr, g] = convert_to_cudd_bdd(*expr, names);
+        REQUIRE(count_solutions(*cudd_mgr, g) == expected);
+
+        native_bdd::manager native_mgr(static_cast<std::uint32_t>(n));
+        auto h = convert_to_native_bdd(*expr, native_mgr);
+        REQUIRE(count_solutions(native_mgr, h) == expected);
+    }
+}
+
+TEST_CASE("model_count: counts use levels, not indices", "[model_count]") {
+    auto expr = parse_text("(a AND b) OR (c AND NOT d) OR e");
+    teddy::bdd_manager in_order(5, 1'000);
+    teddy::bdd_manager reversed(5, 1'000, {4, 3, 2, 1, 0});
+    auto f = convert_to_bdd(*expr, in_order);
+    auto g = convert_to_bdd(*expr, reversed);
+    REQUIRE(count_solutions(reversed, g) == count_solutions(in_order, f));
+    REQUIRE(count_solutions(in_order, f) == big_count(brute_force_count(in_order, f, 5)));
+}
+
+TEST_CASE("model_count: counts beyond 64 bits", "[model_count]") {
+    std::string any;
+    std::string parity;
+    for (int i = 0; i < 70; ++i) {
+        any += (i == 0 ? "" : " OR ") + std::string("v") + std::to_string(i);
+        parity += (i == 0 ? "" : " XOR ") + std::string("v") + std::to_string(i);
+    }
+    auto any_expr = parse_text(any);
+    auto parity_expr = parse_text(parity);
+    const auto names = variables_of(*any_expr);
+
+    teddy::bdd_manager mgr(70, 1'000);
+    REQUIRE(count_solutions(mgr, convert_to_bdd(*any_expr, mgr)).to_string()
+            == "1180591620717411303423");  // 2^70 - 1
+    auto [cudd_mgr, g] = convert_to_cudd_bdd(*parity_expr, names);
+    REQUIRE(count_solutions(*cudd_mgr, g) == big_count(1).shifted_left(69));
+}
+
+TEST_CASE("model_count: N-Queens solution counts", "[model_count]") {
+    auto expr = parse_text(queens(6));
+    const auto names = variables_of(*expr);
+    teddy::bdd_manager mgr(static_cast<int>(names.size()), 1'000);
+    REQUIRE(count_solutions(mgr, convert_to_bdd(*expr, mgr)) == big_count(4));
+    auto [cudd_mgr, g] = convert_to_cudd_bdd(*expr, names);
+    REQUIRE(count_solutions(*cudd_mgr, g) == big_count(4));
+}
+
+TEST_CASE("model_count: enumerators produce exactly the solutions", "[model_count]") {
+    auto expr = parse_text("(a AND b) OR (c XOR d) OR (NOT a AND e)");
+    const auto names = variables_of(*expr);
+    const auto n = names.size();
+    teddy::bdd_manager mgr(static_cast<int>(n), 1'000);
+    auto f = convert_to_bdd(*expr, mgr);
+    const auto expected = brute_force_count(mgr, f, n);
+
+    // Every assignment satisfies the function and none repeats
+    std::set<std::vector<std::uint8_t>> seen;
+    assignment_enumerator<teddy_view> assignments(teddy_view(&mgr, f), n);
+    while (assignments.next()) {
+        const auto& a = assignments.assignment();
+        REQUIRE(mgr.evaluate(f, std::vector<int>(a.begin(), a.end())) == 1);
+        REQUIRE(seen.insert(a).second);
+    }
+    REQUIRE(seen.size() == expected);
+    REQUIRE_FALSE(assignments.next());
+
+    // Cubes are disjoint, so their sizes add up to the count; CUDD expands complements
+    auto [cudd_mgr, g] = convert_to_cudd_bdd(*expr, names);
+    cube_enumerator<cudd_view> cubes(cudd_view(cudd_mgr.get(), g.getNode()), n);
+    std::uint64_t covered = 0;
+    while (cubes.next()) {
+        std::size_t free = 0;
+        for (auto value : cubes.cube()) {
+            free += value == cube_enumerator<cudd_view>::free ? 1 : 0;
+        }
+        covered += std::uint64_t{1} << free;
+    }
+    REQUIRE(covered == expected);
+
+    // The constant false function has no solutions
+    auto never = parse_text("a AND NOT a");
+    native_bdd::manager native_mgr(1);
+    auto h = convert_to_native_bdd(*never, native_mgr);
+    assignment_enumerator<native_view> none(native_view(&native_mgr, h.get_edge()), 1);
+    REQUIRE_FALSE(none.next());
+}
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_multi_output.cpp
+ * @brief Tests for building multi-output expression files in one manager
+ *
+ * Every output built with shared definitions must equal the output built
+ * on its own with the definitions expanded, for TeDDy and CUDD, and the
+ * multi-root writers must draw shared nodes once and label every output.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <filesystem>
+#include <format>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cudd_graph.hpp"
+#include "cudd_iterator.hpp"
+#include "dag_walker.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "multi_output.hpp"
+#include "teddy_graph.hpp"
+#include "teddy_iterator.hpp"
+
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+const std::string filter_family =
+    "let web = port[8] IN {80, 143..145};\n"
+    "let internal = src[4] < 3 AND NOT spoofed;\n"
+    "allow = web AND internal;\n"
+    "log = web OR internal;\n"
+    "deny = NOT (web AND internal) AND EXACTLY_ONE(a, b, internal);\n";
+
+my_program read_text(const std::string& contents) {
+    auto path = write_temp_file("test_multi_output_", contents);
+    auto program = read_program_from_file(path.string());
+    std::filesystem::remove(path);
+    return program;
+}
+
+// Output `name` of the file on its own, with its definitions expanded
+my_expression_ptr single_output(const std::string& contents, const std::string& name) {
+    auto program = read_text(contents);
+    std::erase_if(program.outputs, [&](const auto& output) { return output.name != name; });
+    return inline_definitions(std::move(program));
+}
+
+std::unordered_map<std::string, int> index_map(const std::vector<std::string>& names) {
+    std::unordered_map<std::string, int> var_map;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        var_map[names[i]] = static_cast<int>(i);
+    }
+    return var_map;
+}
+
+}  // namespace
+
+TEST_CASE("multi_output: program variables exclude definitions", "[multi_output]") {
+    auto program = read_text("let ab = a AND b; f = ab OR c; g = NOT ab;");
+    REQUIRE(multi_output::program_variables(program) == std::vector<std::string>{"a", "b", "c"});
+    REQUIRE(multi_output::program_size(program) == 3 + 3 + 2);
+}
+
+TEST_CASE("multi_output: TeDDy outputs match separate builds", "[multi_output]") {
+    auto program = read_text(filter_family);
+    const auto variables = multi_output::program_variables(program);
+    teddy::bdd_manager mgr(static_cast<int>(variables.size()), 10'000);
+
+    const auto outputs = multi_output::build_teddy(program, mgr, variables);
+    REQUIRE(outputs.size() == 3);
+
+    std::vector<teddy_iterator> roots;
+    std::size_t separate = 0;
+    for (const auto& [name, diagram] : outputs) {
+        INFO("output: " << name);
+        auto expected = convert_to_bdd_with_map(*single_output(filter_family, name), mgr,
+                                                index_map(variables));
+        REQUIRE(diagram.equals(expected));
+        roots.emplace_back(diagram.unsafe_get_root(), &variables);
+        separate += static_cast<std::size_t>(mgr.get_node_count(diagram));
+    }
+    REQUIRE(dag_walker::count_nodes_topological(roots) < separate);
+
+    // One graph and one table with a label for each output
+    std::ostringstream dot;
+    write_teddy_outputs_to_dot(mgr, outputs, variables, dot);
+    REQUIRE_THAT(dot.str(), ContainsSubstring("output0 [label = \"allow\", shape = plaintext]"));
+    REQUIRE_THAT(dot.str(), ContainsSubstring("output2 [label = \"deny\", shape = plaintext]"));
+
+    std::ostringstream table;
+    write_teddy_outputs_nodes_to_stream(mgr, outputs, variables, table);
+    REQUIRE_THAT(table.str(), ContainsSubstring("Outputs:\nallow | "));
+    REQUIRE_THAT(table.str(), ContainsSubstring(
+                                  "Total nodes: "
+                                  + std::to_string(dag_walker::count_nodes_topological(roots))));
+}
+
+TEST_CASE("multi_output: CUDD outputs match separate builds", "[multi_output]") {
+    auto program = read_text(filter_family);
+    const auto variables = multi_output::program_variables(program);
+    Cudd mgr(static_cast<unsigned int>(variables.size()));
+
+    const auto outputs = multi_output::build_cudd(program, mgr, variables);
+    REQUIRE(outputs.size() == 3);
+
+    std::vector<cudd_iterator> roots;
+    for (const auto& [name, bdd] : outputs) {
+        INFO("output: " << name);
+        REQUIRE(bdd == convert_to_cudd_bdd_with_map(*single_output(filter_family, name), mgr,
+                                                    index_map(variables)));
+        roots.emplace_back(mgr, bdd.getNode(), &variables);
+    }
+
+    std::ostringstream dot;
+    write_cudd_outputs_to_dot(mgr, outputs, variables, dot);
+    REQUIRE_THAT(dot.str(), ContainsSubstring("output1 [label = \"log\", shape = plaintext]"));
+
+    std::ostringstream table;
+    write_cudd_outputs_nodes_to_stream(mgr, outputs, variables, table, false);
+    REQUIRE_THAT(table.str(), ContainsSubstring("Outputs:\n"));
+}
+
+TEST_CASE("multi_output: a deep chain of definitions is built once per definition",
+          "[multi_output]") {
+    // Each definition uses the previous one twice, so inlining would copy d0 2^25 times
+    const int depth = 26;
+    std::string text = "let d0 = x;";
+    for (int i = 1; i < depth; ++i) {
+        text += std::format(" let d{} = d{} XOR (d{} AND c{});", i, i - 1, i - 1, i);
+    }
+    text += std::format(" out = d{};", depth - 1);
+    const auto program = read_text(text);
+    REQUIRE(program.outputs.size() == 1);
+    const auto variables = multi_output::program_variables(program);
+    REQUIRE(variables.size() == depth);
+
+    // d_i = d_{i-1} AND NOT c_i, so only x = 1 with every c_i = 0 satisfies the output
+    std::string expected_text = "x";
+    for (int i = 1; i < depth; ++i) {
+        expected_text += std::format(" AND NOT c{}", i);
+    }
+    const auto expected = parse_text(expected_text);
+
+    SECTION("TeDDy") {
+        teddy::bdd_manager mgr(depth, 1'000);
+        const auto defined = multi_output::build_teddy_definitions(program, mgr, variables);
+        REQUIRE(defined.size() == depth);
+        const auto out = convert_to_bdd_with_map(*program.outputs.front().expr, mgr,
+                                                 index_map(variables), nullptr, &defined);
+        REQUIRE(out.equals(convert_to_bdd_with_map(*expected, mgr, index_map(variables))));
+        REQUIRE(mgr.satisfy_count(out) == 1);
+        REQUIRE(multi_output::build_teddy(program, mgr, variables).front().second.equals(out));
+    }
+
+    SECTION("CUDD") {
+        Cudd mgr(depth);
+        const auto defined = multi_output::build_cudd_definitions(program, mgr, variables);
+        const BDD out = convert_to_cudd_bdd_with_map(*program.outputs.front().expr, mgr,
+                                                     index_map(variables), nullptr, nullptr,
+                                                     &defined);
+        REQUIRE(out == convert_to_cudd_bdd_with_map(*expected, mgr, index_map(variables)));
+        REQUIRE(out.nodeCount() == depth + 1);
+        REQUIRE(multi_output::build_cudd(program, mgr, variables).front().second == out);
+    }
+}
+
+TEST_CASE("multi_output: single-root writers are unchanged", "[multi_output]") {
+    auto program = read_text("f = a AND b;");
+    const auto variables = multi_output::program_variables(program);
+    teddy::bdd_manager mgr(static_cast<int>(variables.size()), 1'000);
+    const auto outputs = multi_output::build_teddy(program, mgr, variables);
+
+    std::ostringstream single;
+    write_teddy_to_dot(mgr, outputs.front().second, variables, single);
+    std::ostringstream unnamed;
+    write_teddy_outputs_to_dot(mgr, {{"", outputs.front().second}}, variables, unnamed);
+    REQUIRE(single.str() == unnamed.str());
+}
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_native_bdd.cpp
+ * @brief Tests for the native BDD package
+ *
+ * Checks canonicity with complement edges, agreement with TeDDy on parsed
+ * expressions (including identical generator output through native_iterator),
+ * garbage collection, deep diagrams, the external_dag_view adapter and the
+ * error paths.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "dag_walker.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "graph.hpp"
+#include "native_bdd.hpp"
+#include "native_convert.hpp"
+#include "native_graph.hpp"
+#include "native_iterator.hpp"
+#include "native_view.hpp"
+#include "teddy_convert.hpp"
+#include "teddy_graph.hpp"
+
+namespace {
+
+std::vector<std::string> order_of(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return ordered_variable_names(names);
+}
+
+}  // namespace
+
+TEST_CASE("native_bdd: complement edges keep functions canonical", "[native_bdd]") {
+    native_bdd::manager mgr(3);
+    auto a = mgr.variable(0);
+    auto b = mgr.variable(1);
+    auto c = mgr.variable(2);
+
+    REQUIRE((a & b) == (b & a));
+    REQUIRE((a | b) == (b | a));
+    REQUIRE((a ^ b) == (b ^ a));
+    REQUIRE((!(a & b)) == (!a | !b));
+    REQUIRE((!!c) == c);
+    REQUIRE((a ^ a).is_zero());
+    REQUIRE((a | !a).is_one());
+    REQUIRE(mgr.ite(a, b, c) == ((a & b) | (!a & c)));
+
+    // NOT only flips the complement bit of the root edge
+    auto f = (a & b) | c;
+    REQUIRE((!f).get_edge() == native_bdd::negate(f.get_edge()));
+    REQUIRE(mgr.node_count(f) == mgr.node_count(!f));
+
+    // Stored then-edges are never complemented
+    for (native_bdd::edge e : {f.get_edge(), (a ^ b ^ c).get_edge(), (!a & c).get_edge()}) {
+        if (!native_bdd::is_constant(e)) {
+            REQUIRE_FALSE(native_bdd::is_complement(mgr.get_node(native_bdd::node_index(e)).high));
+        }
+    }
+
+    // Parity of three variables: one node per level shared by both phases
+    REQUIRE(mgr.node_count(a ^ b ^ c) == 4);
+}
+
+TEST_CASE("native_bdd: conversion agrees with TeDDy and drives the same generators",
+          "[native_bdd]") {
+    const std::vector<std::string> sources = {
+        "(a AND b) OR (c AND d) OR (e XOR f)",
+        "(a XOR b XOR c) AND NOT (d AND e) OR EXACTLY_ONE(a, d, f)",
+        "x[4] >= 5 AND (flag OR x[4] == 12)",
+        "AT_LEAST_K(2, p, q, r, s) AND NOT q OR AT_MOST_K(1, r, s)",
+        "NOT (NOT a OR NOT b) XOR NOT c",
+    };
+    for (const auto& source : sources) {
+        INFO("expression: " << source);
+        auto expr = parse_text(source);
+        auto ordered = order_of(*expr);
+        const auto n = ordered.size();
+
+        teddy::bdd_manager manager(static_cast<int>(n), 1'000);
+        auto expected = convert_to_bdd(*expr, manager);
+        native_bdd::manager mgr(static_cast<std::uint32_t>(n));
+        auto f = convert_to_native_bdd(*expr, mgr);
+
+        for (std::size_t row = 0; row < (std::size_t{1} << n); ++row) {
+            std::vector<int> ints(n);
+            std::vector<std::uint8_t> bytes(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                ints[i] = static_cast<int>((row >> i) & 1);
+                bytes[i] = static_cast<std::uint8_t>(ints[i]);
+            }
+            INFO("row=" << row);
+            REQUIRE(mgr.evaluate(f, bytes) == (manager.evaluate(expected, ints) == 1));
+        }
+
+        // With complement edges expanded the structure is TeDDy's
+        native_iterator root(mgr, f.get_edge(), &ordered);
+        REQUIRE(dag_walker::count_nodes_topological(root)
+                == static_cast<size_t>(manager.get_node_count(expected)));
+
+        std::ostringstream native_table;
+        std::ostringstream teddy_table;
+        write_native_nodes_to_stream(mgr, f, ordered, native_table, false);
+        write_teddy_nodes_to_stream(manager, expected, ordered, teddy_table, false);
+        REQUIRE(native_table.str() == teddy_table.str());
+
+        std::ostringstream native_dot;
+        std::ostringstream teddy_dot;
+        write_native_to_dot(mgr, f, ordered, native_dot);
+        write_teddy_to_dot(manager, expected, ordered, teddy_dot);
+        REQUIRE(native_dot.str() == teddy_dot.str());
+    }
+}
+
+TEST_CASE("native_bdd: garbage collection reclaims unreferenced nodes", "[native_bdd]") {
+    native_bdd::manager_config config;
+    config.initial_nodes = 64;
+    config.cache_entries = 16;
+    native_bdd::manager mgr(16, config);
+
+    std::vector<native_bdd::bdd> vars;
+    for (std::uint32_t i = 0; i < 16; ++i) {
+        vars.push_back(mgr.variable(i));
+    }
+    auto keep = vars[0] & vars[15];
+    auto churn = [&](int rounds) {
+        for (int round = 0; round < rounds; ++round) {
+            // Temporaries die at the end of each round
+            auto sum = mgr.zero();
+            for (std::uint32_t i = 0; i < 16; ++i) {
+                auto other = (i + 1 + static_cast<std::uint32_t>(round) % 3) % 16;
+                sum = sum ^ (vars[i] & vars[other]);
+            }
+            REQUIRE_FALSE(sum.is_constant());
+        }
+    };
+    churn(50);
+    auto stats = mgr.get_statistics();
+    REQUIRE(stats.gc_runs > 0);
+
+    // Collected records are recycled, so more of the same work barely grows the arena
+    churn(200);
+    REQUIRE(mgr.get_statistics().arena_nodes <= 2 * stats.arena_nodes);
+
+    mgr.collect_garbage();
+    stats = mgr.get_statistics();
+    // Live: the terminal, the 16 projections and the one extra node of keep
+    REQUIRE(stats.live_nodes == 18);
+    REQUIRE(stats.arena_nodes >= stats.live_nodes);
+
+    std::vector<std::uint8_t> values(16, 0);
+    values[0] = 1;
+    REQUIRE_FALSE(mgr.evaluate(keep, values));
+    values[15] = 1;
+    REQUIRE(mgr.evaluate(keep, values));
+
+    // Freed records are reused and the rebuilt unique tables still find survivors
+    REQUIRE((vars[15] & vars[0]) == keep);
+    REQUIRE(mgr.get_statistics().arena_nodes == stats.arena_nodes);
+}
+
+TEST_CASE("native_bdd: deep diagrams do not recurse", "[native_bdd]") {
+    constexpr std::uint32_t n = 50'000;
+    native_bdd::manager mgr(n);
+
+    // Built bottom-up, each step only touches the new top node
+    auto parity = mgr.variable(n - 1);
+    auto all = mgr.variable(n - 1);
+    for (std::uint32_t i = n - 1; i-- > 0;) {
+        auto x = mgr.variable(i);
+        parity = x ^ parity;
+        all = x & all;
+    }
+    REQUIRE(mgr.node_count(parity) == n + 1);
+
+    // The conjunction walks both chains to the bottom
+    auto both = parity & all;
+    REQUIRE(both == (n % 2 == 1 ? all : mgr.zero()));
+    auto either = parity | !all;
+    REQUIRE(either == !all);
+}
+
+TEST_CASE("native_bdd: native_view models external_dag_view", "[native_bdd]") {
+    static_assert(graph::external_dag_view<native_view>);
+
+    native_bdd::manager mgr(2);
+    auto f = mgr.variable(0) ^ mgr.variable(1);
+    native_view view(&mgr, f.get_edge());
+    auto order = graph::topo_order(view, view.roots());
+    // x0, x1 in both phases, and both terminals
+    REQUIRE(order.size() == 5);
+
+    native_view complemented(&mgr, (!f).get_edge());
+    REQUIRE(view.roots()[0].stable_key() != complemented.roots()[0].stable_key());
+    auto ch = view.children(view.roots()[0]);
+    auto ch2 = complemented.children(complemented.roots()[0]);
+    REQUIRE(ch.size() == 2);
+    for (size_t i = 0; i < ch.size(); ++i) {
+        REQUIRE(ch[i].target().e == native_bdd::negate(ch2[i].target().e));
+    }
+    REQUIRE(view.children(native_view::handle{native_bdd::one_edge}).empty());
+}
+
+TEST_CASE("native_bdd - negative: invalid operands", "[native_bdd][negative]") {
+    native_bdd::manager mgr(2);
+    native_bdd::manager other(2);
+    REQUIRE_THROWS_AS(mgr.variable(2), std::runtime_error);
+    auto a = mgr.variable(0);
+    auto b = other.variable(1);
+    REQUIRE_THROWS_AS(mgr.apply_and(a, b), std::runtime_error);
+    REQUIRE_THROWS_AS(mgr.evaluate(a, std::vector<std::uint8_t>{1}), std::runtime_error);
+
+    native_iterator terminal(mgr, native_bdd::zero_edge, nullptr);
+    REQUIRE(terminal.get_terminal_value() == 0);
+    REQUIRE_THROWS_AS(native_iterator(mgr, a.get_edge(), nullptr).get_terminal_value(),
+                      std::runtime_error);
+
+    auto expr = parse_text("p AND q AND r");
+    REQUIRE_THROWS_AS(convert_to_native_bdd(*expr, mgr), std::runtime_error);
+}
@@ -10,6 +10,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "node_id_allocator.hpp"
 
@@ -69,3 +71,23 @@ TEST_CASE("node_id_allocator - nullptr key handling (negative)", "[node_id_alloc
     auto id_pa = alloc.get_id(pa);
     REQUIRE(id_pa != id_first);
 }
+
+TEST_CASE("node_id_allocator - dense indices in first-seen order", "[node_id_allocator]") {
+    graph_common::node_id_allocator alloc("N", 1);
+    int a = 0, b = 0, c = 0;
+
+    REQUIRE(alloc.get_index(&b) == 0);
+    REQUIRE(alloc.get_index(&a) == 1);
+    REQUIRE(alloc.get_index(&b) == 0);
+    REQUIRE(alloc.get_id(&c) == "N3");
+    REQUIRE(alloc.get_index(&c) == 2);
+    REQUIRE(alloc.id_at(1) == "N2");
+
+    // IDs handed out by reference stay valid as the table grows
+    const std::string& first = alloc.get_id(&b);
+    std::vector<int> more(1000);
+    for (const auto& value : more) {
+        alloc.get_id(&value);
+    }
+    REQUIRE(first == "N1");
+}
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_parallel_bdd.cpp
+ * @brief Tests for the multi-threaded BDD package
+ *
+ * Checks that parallel conversion matches the native package node for node
+ * at several thread counts, that collection and table growth keep results
+ * intact, that deep diagrams fall back to the explicit stack, the
+ * external_dag_view adapter and the error paths.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "graph.hpp"
+#include "native_bdd.hpp"
+#include "native_convert.hpp"
+#include "parallel_bdd.hpp"
+#include "parallel_convert.hpp"
+#include "parallel_view.hpp"
+#include "workload_generator.hpp"
+
+namespace {
+
+std::uint32_t variable_count(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return static_cast<std::uint32_t>(names.size());
+}
+
+parallel_bdd::manager_config with_threads(unsigned threads) {
+    parallel_bdd::manager_config config;
+    config.threads = threads;
+    return config;
+}
+
+}  // namespace
+
+TEST_CASE("parallel_bdd: results match the native package", "[parallel_bdd]") {
+    workload_generator::GeneratorOptions queens;
+    queens.n = 5;
+    workload_generator::GeneratorOptions cnf;
+    cnf.n = 14;
+    cnf.ratio = 2.5;
+    const std::vector<std::string> sources = {
+        "(a AND b) OR (c AND d) OR (e XOR f)",
+        "AT_LEAST_K(2, p, q, r, s) AND NOT q OR x[4] >= 5",
+        workload_generator::generate_n_queens(queens),
+        workload_generator::generate_random_cnf(cnf),
+    };
+    for (const auto& source : sources) {
+        auto expr = parse_text(source);
+        const auto n = variable_count(*expr);
+        native_bdd::manager reference(n);
+        auto expected = convert_to_native_bdd(*expr, reference);
+
+        for (unsigned threads : {1u, 2u, 4u}) {
+            INFO("threads=" << threads << " expression: " << source.substr(0, 60));
+            parallel_bdd::manager mgr(n, with_threads(threads));
+            REQUIRE(mgr.thread_count() == threads);
+            auto f = convert_to_parallel_bdd(*expr, mgr);
+            REQUIRE(mgr.node_count(f) == reference.node_count(expected));
+
+            // By canonicity the copy is the very same native function
+            REQUIRE(copy_to_native(mgr, f, reference) == expected);
+        }
+    }
+}
+
+TEST_CASE("parallel_bdd: operations are canonical across threads", "[parallel_bdd]") {
+    parallel_bdd::manager mgr(4, with_threads(3));
+    auto a = mgr.variable(0);
+    auto b = mgr.variable(1);
+    auto c = mgr.variable(2);
+    auto d = mgr.variable(3);
+
+    REQUIRE((a & b) == (b & a));
+    REQUIRE((!(a & b)) == (!a | !b));
+    REQUIRE((a ^ b ^ c ^ d) == (d ^ (c ^ (b ^ a))));
+    REQUIRE(mgr.ite(a, b, c) == ((a & b) | (!a & c)));
+    REQUIRE((a | !a).is_one());
+    REQUIRE(mgr.node_count(a ^ b ^ c ^ d) == 5);
+
+    std::vector<std::uint8_t> values = {1, 0, 1, 1};
+    REQUIRE(mgr.evaluate(a ^ b ^ c ^ d, values));
+    REQUIRE_FALSE(mgr.evaluate(a & b, values));
+}
+
+TEST_CASE("parallel_bdd: collection and growth keep live functions", "[parallel_bdd]") {
+    parallel_bdd::manager_config config = with_threads(2);
+    config.initial_nodes = 64;
+    config.cache_entries = 16;
+    parallel_bdd::manager mgr(16, config);
+
+    std::vector<parallel_bdd::bdd> vars;
+    for (std::uint32_t i = 0; i < 16; ++i) {
+        vars.push_back(mgr.variable(i));
+    }
+    auto keep = vars[0] & vars[15];
+
+    // Intermediates outgrow the initial table, forcing restarts and growth
+    auto sum = mgr.zero();
+    for (std::uint32_t i = 0; i < 16; ++i) {
+        sum = sum ^ (vars[i] & vars[(i + 5) % 16]);
+    }
+    auto stats = mgr.get_statistics();
+    REQUIRE(stats.gc_runs > 0);
+    REQUIRE(stats.grows > 0);
+    REQUIRE(stats.capacity > 64);
+
+    native_bdd::manager reference(16);
+    auto expected = reference.zero();
+    for (std::uint32_t i = 0; i < 16; ++i) {
+        expected = expected ^ (reference.variable(i) & reference.variable((i + 5) % 16));
+    }
+    REQUIRE(copy_to_native(mgr, sum, reference) == expected);
+
+    // Dropping the sum frees its nodes; the survivors stay reachable
+    sum = mgr.zero();
+    mgr.collect_garbage();
+    REQUIRE(mgr.get_statistics().used_nodes == 18);
+    REQUIRE((vars[15] & vars[0]) == keep);
+}
+
+TEST_CASE("parallel_bdd: deep diagrams do not recurse", "[parallel_bdd]") {
+    constexpr std::uint32_t n = 20'000;
+    parallel_bdd::manager mgr(n, with_threads(2));
+
+    auto parity = mgr.variable(n - 1);
+    auto all = mgr.variable(n - 1);
+    for (std::uint32_t i = n - 1; i-- > 0;) {
+        auto x = mgr.variable(i);
+        parity = x ^ parity;
+        all = x & all;
+    }
+    REQUIRE(mgr.node_count(parity) == n + 1);
+    REQUIRE((parity & all) == (n % 2 == 1 ? all : mgr.zero()));
+    REQUIRE((parity | !all) == !all);
+}
+
+TEST_CASE("parallel_bdd: parallel_view models external_dag_view", "[parallel_bdd]") {
+    static_assert(graph::external_dag_view<parallel_view>);
+
+    parallel_bdd::manager mgr(2, with_threads(1));
+    auto f = mgr.variable(0) ^ mgr.variable(1);
+    parallel_view view(&mgr, f.get_edge());
+    // x0, x1 in both phases, and both terminals
+    REQUIRE(graph::topo_order(view, view.roots()).size() == 5);
+    REQUIRE(view.children(parallel_view::handle{parallel_bdd::one_edge}).empty());
+}
+
+TEST_CASE("parallel_bdd - negative: invalid operands", "[parallel_bdd][negative]") {
+    parallel_bdd::manager mgr(2, with_threads(2));
+    parallel_bdd::manager other(2, with_threads(1));
+    REQUIRE_THROWS_AS(mgr.variable(2), std::runtime_error);
+    auto a = mgr.variable(0);
+    auto b = other.variable(1);
+    REQUIRE_THROWS_AS(mgr.apply_or(a, b), std::runtime_error);
+    REQUIRE_THROWS_AS(mgr.evaluate(a, std::vector<std::uint8_t>{1}), std::runtime_error);
+
+    native_bdd::manager small(1);
+    REQUIRE_THROWS_AS(copy_to_native(mgr, a, small), std::runtime_error);
+
+    auto expr = parse_text("p AND q AND r");
+    REQUIRE_THROWS_AS(convert_to_parallel_bdd(*expr, mgr), std::runtime_error);
+}
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_partitioned_convert.cpp
+ * @brief Tests for partitioned conversion on worker threads
+ *
+ * Checks how the top-level chain is split and that partitioned TeDDy and
+ * CUDD conversion give the same function as the sequential converters at
+ * several partition counts.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "partitioned_convert.hpp"
+#include "teddy_convert.hpp"
+#include "workload_generator.hpp"
+
+namespace {
+
+std::unordered_set<std::string> variables_of(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return names;
+}
+
+std::vector<std::string> workloads() {
+    workload_generator::GeneratorOptions queens;
+    queens.n = 5;
+    workload_generator::GeneratorOptions cnf;
+    cnf.n = 14;
+    cnf.ratio = 2.5;
+    return {
+        "(a AND b) OR (c AND d) OR (e XOR f) OR NOT (a OR f)",
+        "EXACTLY_ONE(p, q, r) AND (p OR s) AND x[4] >= 5 AND NOT (q AND s)",
+        "a XOR b",
+        workload_generator::generate_n_queens(queens),
+        workload_generator::generate_random_cnf(cnf),
+    };
+}
+
+}  // namespace
+
+TEST_CASE("partitioned_convert: plans balance the top-level chain", "[partitioned_convert]") {
+    auto expr = parse_text("(a AND b AND c) AND d AND (e OR f) AND NOT g");
+    auto plan = plan_partitions(*expr, 2);
+    REQUIRE(plan.op == partition_plan::chain_op::conjunction);
+    REQUIRE(plan.partitions.size() == 2);
+
+    // Nested ANDs are part of the chain: a, b, c, d, (e OR f), NOT g
+    std::size_t operands = 0;
+    std::size_t nodes = 0;
+    for (std::size_t i = 0; i < plan.partitions.size(); ++i) {
+        operands += plan.partitions[i].size();
+        nodes += plan.sizes[i];
+    }
+    REQUIRE(operands == 6);
+    REQUIRE(nodes == 9);
+    REQUIRE(plan.sizes[0] + 1 >= plan.sizes[1]);
+    REQUIRE(plan.sizes[1] + 1 >= plan.sizes[0]);
+
+    // No more partitions than operands, and no chain means one partition
+    REQUIRE(plan_partitions(*expr, 16).partitions.size() == 6);
+    REQUIRE(plan_partitions(*parse_text("x OR y"), 4).op
+            == partition_plan::chain_op::disjunction);
+    auto single = plan_partitions(*parse_text("x XOR (y AND z)"), 4);
+    REQUIRE(single.op == partition_plan::chain_op::none);
+    REQUIRE(single.partitions.size() == 1);
+    REQUIRE(single.sizes[0] == 5);
+}
+
+TEST_CASE("partitioned_convert: TeDDy results match sequential conversion",
+          "[partitioned_convert]") {
+    for (const auto& source : workloads()) {
+        auto expr = parse_text(source);
+        const auto names = variables_of(*expr);
+        teddy::bdd_manager mgr(static_cast<int>(names.size()), 1'000);
+        auto expected = convert_to_bdd(*expr, mgr);
+
+        for (unsigned partitions : {1u, 2u, 4u}) {
+            INFO("partitions=" << partitions << " expression: " << source.substr(0, 60));
+            auto f = convert_to_bdd_partitioned(*expr, mgr, partitions);
+            REQUIRE(f.equals(expected));
+        }
+    }
+}
+
+TEST_CASE("partitioned_convert: CUDD results match sequential conversion",
+          "[partitioned_convert]") {
+    for (const auto& source : workloads()) {
+        auto expr = parse_text(source);
+        const auto names = variables_of(*expr);
+        auto [reference_mgr, reference] = convert_to_cudd_bdd(*expr, names);
+
+        for (unsigned partitions : {1u, 2u, 4u}) {
+            INFO("partitions=" << partitions << " expression: " << source.substr(0, 60));
+            auto [mgr, f] = convert_to_cudd_bdd_partitioned(*expr, names, partitions);
+            REQUIRE(f.nodeCount() == reference.nodeCount());
+            BDD expected = copy_cudd_bdd(*reference_mgr, reference, *mgr);
+            REQUIRE(f.getNode() == expected.getNode());
+        }
+    }
+}
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_reliability.cpp
+ * @brief Tests for probability propagation and importance measures over BDDs
+ *
+ * Compares P(f = 1) with a brute-force sum over all assignments, checks that
+ * the tiled batch evaluation matches the single-vector pass for any thread
+ * count and tile size, checks Birnbaum importance and marginals against their
+ * definitions, and covers the probability file reader.
+ */
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cudd_convert.hpp"
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "native_convert.hpp"
+#include "reliability.hpp"
+#include "teddy_convert.hpp"
+
+namespace {
+
+std::filesystem::path write_temp(const std::string& contents) {
+    return write_temp_file("test_reliability_", contents);
+}
+
+std::unordered_set<std::string> variables_of(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return names;
+}
+
+// Sums the probability of every satisfying assignment of a TeDDy BDD
+double brute_force_probability(const teddy::bdd_manager& mgr,
+                               const teddy::bdd_manager::diagram_t& f,
+                               const std::vector<double>& p) {
+    const std::size_t n = p.size();
+    double total = 0.0;
+    std::vector<int> values(n);
+    for (std::uint64_t row = 0; row < (std::uint64_t{1} << n); ++row) {
+        double weight = 1.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            values[i] = static_cast<int>((row >> i) & 1);
+            weight *= values[i] != 0 ? p[i] : 1.0 - p[i];
+        }
+        total += mgr.evaluate(f, values) == 1 ? weight : 0.0;
+    }
+    return total;
+}
+
+std::vector<double> sample_probabilities(std::size_t n, std::size_t seed) {
+    std::vector<double> p(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        p[i] = static_cast<double>((seed * 37 + i * 11) % 97) / 96.0;
+    }
+    return p;
+}
+
+}  // namespace
+
+TEST_CASE("reliability: probability matches brute force on every backend", "[reliability]") {
+    for (const std::string source :
+         {"a OR (b AND c) OR d", "(a AND b) XOR (c OR NOT d) XOR e",
+          "EXACTLY_ONE(p, q, r, s) AND NOT (p AND t)", "a AND NOT a", "a OR NOT a"}) {
+        INFO("expression: " << source);
+        auto expr = parse_text(source);
+        const auto names = variables_of(*expr);
+        const auto n = names.size();
+        const auto p = sample_probabilities(n, 3);
+
+        teddy::bdd_manager mgr(static_cast<int>(n), 1'000);
+        auto f = convert_to_bdd(*expr, mgr);
+        const double expected = brute_force_probability(mgr, f, p);
+        REQUIRE(reliability::probability(reliability::compile_teddy(f, n), p)
+                == Catch::Approx(expected));
+
+        // CUDD numbers variables the same way, but expands complemented edges
+        auto [cudd_mgr, g] = convert_to_cudd_bdd(*expr, names);
+        REQUIRE(reliability::probability(reliability::compile_cudd(g, n), p)
+                == Catch::Approx(expected));
+
+        native_bdd::manager native_mgr(static_cast<std::uint32_t>(n));
+        auto h = convert_to_native_bdd(*expr, native_mgr);
+        REQUIRE(reliability::probability(reliability::compile_native(native_mgr, h), p)
+                == Catch::Approx(expected));
+    }
+}
+
+TEST_CASE("reliability: batches match single vectors", "[reliability]") {
+    auto expr = parse_text("(a AND b) OR (c XOR d) OR (NOT a AND e AND f)");
+    const auto names = variables_of(*expr);
+    const auto n = names.size();
+    auto [cudd_mgr, g] = convert_to_cudd_bdd(*expr, names);
+    const auto d = reliability::compile_cudd(g, n);
+
+    const std::size_t rows = 1'001;
+    std::vector<double> vectors;
+    std::vector<double> expected;
+    for (std::size_t r = 0; r < rows; ++r) {
+        const auto p = sample_probabilities(n, r);
+        vectors.insert(vectors.end(), p.begin(), p.end());
+        expected.push_back(reliability::probability(d, p));
+    }
+
+    for (unsigned threads : {1u, 3u}) {
+        for (std::size_t lanes : {std::size_t{1}, std::size_t{7}, std::size_t{256}}) {
+            INFO("threads " << threads << ", lanes " << lanes);
+            const auto result = reliability::probabilities(d, vectors, {threads, lanes});
+            REQUIRE(result.size() == rows);
+            for (std::size_t r = 0; r < rows; ++r) {
+                REQUIRE(result[r] == Catch::Approx(expected[r]));
+            }
+        }
+    }
+
+    // A small scratch budget only narrows the tiles
+    reliability::batch_options narrow;
+    narrow.scratch_bytes = 1;
+    REQUIRE(reliability::probabilities(d, vectors, narrow)[rows - 1]
+            == Catch::Approx(expected[rows - 1]));
+
+    REQUIRE(reliability::probabilities(d, {}).empty());
+    REQUIRE_THROWS_AS(reliability::probabilities(d, std::span(vectors).first(n + 1)),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(reliability::probabilities(d, vectors, {1, 0}), std::runtime_error);
+    REQUIRE_THROWS_AS(reliability::probability(d, std::span(vectors).first(n - 1)),
+                      std::runtime_error);
+}
+
+TEST_CASE("reliability: Birnbaum importance and marginals", "[reliability]") {
+    // Variables are numbered by name, so a and b are in index order here
+    auto expr = parse_text("(a AND b) OR (c AND NOT d) OR e");
+    const auto names = variables_of(*expr);
+    const auto n = names.size();
+    teddy::bdd_manager mgr(static_cast<int>(n), 1'000);
+    auto f = convert_to_bdd(*expr, mgr);
+    const auto d = reliability::compile_teddy(f, n);
+    const auto p = sample_probabilities(n, 5);
+
+    const auto result = reliability::analyze(d, p);
+    REQUIRE(result.probability == Catch::Approx(reliability::probability(d, p)));
+    for (std::size_t i = 0; i < n; ++i) {
+        INFO("variable " << i);
+        auto given_one = p;
+        auto given_zero = p;
+        given_one[i] = 1.0;
+        given_zero[i] = 0.0;
+        const double p1 = brute_force_probability(mgr, f, given_one);
+        const double p0 = brute_force_probability(mgr, f, given_zero);
+        REQUIRE(result.birnbaum[i] == Catch::Approx(p1 - p0).margin(1e-12));
+        REQUIRE(result.marginal[i]
+                == Catch::Approx(p[i] * p1 / result.probability).margin(1e-12));
+    }
+
+    // An unsatisfiable function has no marginals
+    auto never = parse_text("a AND NOT a");
+    teddy::bdd_manager one_var(1, 1'000);
+    const auto none = reliability::analyze(
+        reliability::compile_teddy(convert_to_bdd(*never, one_var), 1), std::vector{0.5});
+    REQUIRE(none.probability == 0.0);
+    REQUIRE(none.birnbaum[0] == 0.0);
+    REQUIRE(none.marginal[0] == 0.0);
+}
+
+TEST_CASE("reliability: probability file reader", "[reliability]") {
+    const std::vector<std::string> names{"pump_a", "pump_b", "valve"};
+
+    auto path = write_temp(
+        "# Availability of each component\n"
+        "valve, pump_a\n"
+        "\n"
+        "0.999, 0.99\n"
+        "1 0  # whitespace also separates\n");
+    const auto table = reliability::read_probability_file(path.string(), names);
+    std::filesystem::remove(path);
+    REQUIRE(table.variables == 3);
+    REQUIRE(table.rows() == 2);
+    REQUIRE(table.row(0)[0] == 0.99);
+    REQUIRE(table.row(0)[1] == 0.5);  // Unlisted variables default to 0.5
+    REQUIRE(table.row(0)[2] == 0.999);
+    REQUIRE(table.row(1)[0] == 0.0);
+    REQUIRE(table.row(1)[2] == 1.0);
+
+    for (const std::string bad :
+         {"pump_a, tank\n0.5, 0.5\n", "pump_a, pump_a\n0.5, 0.5\n", "pump_a\n1.5\n",
+          "pump_a\nhigh\n", "pump_a, valve\n0.5\n", "# only a comment\n"}) {
+        INFO("contents: " << bad);
+        auto bad_path = write_temp(bad);
+        REQUIRE_THROWS_AS(reliability::read_probability_file(bad_path.string(), names),
+                          std::runtime_error);
+        std::filesystem::remove(bad_path);
+    }
+    REQUIRE_THROWS_AS(reliability::read_probability_file("no_such_file.csv", names),
+                      std::runtime_error);
+}
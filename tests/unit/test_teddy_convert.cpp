@@ -8,7 +8,9 @@
  */
 
 #include <catch2/catch_test_macros.hpp>
+#include <cstdint>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "teddy_convert.hpp"
@@ -87,3 +89,219 @@ TEST_CASE("teddy_convert - negative: empty expression and unknown variable",
         REQUIRE(b2.unsafe_get_root() != nullptr);
     }());
 }
+
+static std::unique_ptr<my_expression> cardinality_ptr(cardinality_kind kind, size_t k,
+                                                      const std::vector<std::string>& names) {
+    my_cardinality node;
+    node.kind = kind;
+    node.k = k;
+    for (const auto& name : names) {
+        node.operands.push_back(var_ptr(name));
+    }
+    return std::make_unique<my_expression>(std::move(node));
+}
+
+TEST_CASE("teddy_convert: cardinality constraints match brute-force counting",
+          "[teddy_convert][cardinality]") {
+    const std::vector<std::string> names = {"a", "b", "c", "d", "e"};
+    for (auto kind : {cardinality_kind::exactly, cardinality_kind::at_most,
+                      cardinality_kind::at_least}) {
+        for (size_t k = 0; k <= names.size() + 1; ++k) {
+            teddy::bdd_manager mgr(static_cast<int>(names.size()), 1000);
+            auto expr = cardinality_ptr(kind, k, names);
+            const auto& node = std::get<my_cardinality>(*expr);
+            auto bdd = convert_to_bdd(*expr, mgr);
+
+            for (unsigned mask = 0; mask < (1u << names.size()); ++mask) {
+                std::vector<bool> assignment;
+                size_t ones = 0;
+                for (size_t i = 0; i < names.size(); ++i) {
+                    assignment.push_back(((mask >> i) & 1u) != 0);
+                    ones += assignment.back() ? 1 : 0;
+                }
+                INFO("k=" << k << " mask=" << mask);
+                REQUIRE(evaluate_teddy_bdd(mgr, bdd, assignment) == node.accepts(ones));
+            }
+        }
+    }
+}
+
+TEST_CASE("teddy_convert: EXACTLY_ONE builds a linear-size BDD", "[teddy_convert][cardinality]") {
+    std::vector<std::string> names;
+    for (int i = 0; i < 40; ++i) {
+        names.push_back(std::format("v{:02}", i));
+    }
+    teddy::bdd_manager mgr(static_cast<int>(names.size()), 10000);
+    auto expr = cardinality_ptr(cardinality_kind::exactly, 1, names);
+    auto bdd = convert_to_bdd(*expr, mgr);
+
+    // 2n - 1 internal nodes plus the two terminals
+    REQUIRE(static_cast<size_t>(mgr.get_node_count(bdd)) == 2 * names.size() + 1);
+    REQUIRE(mgr.satisfy_count(1, bdd) == static_cast<long long>(names.size()));
+}
+
+TEST_CASE("teddy_convert - negative: adapter rejects cardinality constraints",
+          "[teddy_convert][cardinality][negative]") {
+    teddy::bdd_manager mgr(2, 1000);
+    auto expr = cardinality_ptr(cardinality_kind::exactly, 1, {"a", "b"});
+    REQUIRE_THROWS_AS(convert_to_bdd_with_teddy_adapter(*expr, mgr), std::runtime_error);
+}
+
+static std::unique_ptr<my_expression> compare_ptr(const my_field& field, compare_op op,
+                                                  uint64_t value) {
+    my_compare node;
+    node.field = field;
+    node.op = op;
+    node.value = value;
+    return std::make_unique<my_expression>(std::move(node));
+}
+
+// Reference semantics of a comparison between two field values
+static bool compare_values(compare_op op, uint64_t x, uint64_t y) {
+    switch (op) {
+        case compare_op::eq:
+            return x == y;
+        case compare_op::ne:
+            return x != y;
+        case compare_op::lt:
+            return x < y;
+        case compare_op::le:
+            return x <= y;
+        case compare_op::gt:
+            return x > y;
+        case compare_op::ge:
+            return x >= y;
+        default:
+            return false;
+    }
+}
+
+// Decodes the value of `field` from an assignment indexed by variable level
+static uint64_t field_value(const my_field& field, const std::vector<std::string>& order,
+                            const std::vector<bool>& assignment) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (size_t bit = 0; bit < field.width; ++bit) {
+            if (assignment[i] && order[i] == field_bit_name(field.name, bit)) {
+                value |= uint64_t{1} << bit;
+            }
+        }
+    }
+    return value;
+}
+
+TEST_CASE("teddy_convert: field comparisons match brute-force evaluation",
+          "[teddy_convert][field]") {
+    const my_field a{"a", 3};
+    const my_field b{"b", 3};
+    const std::vector<compare_op> ops = {compare_op::eq, compare_op::ne, compare_op::lt,
+                                         compare_op::le, compare_op::gt, compare_op::ge};
+
+    SECTION("field against constant") {
+        std::unordered_set<std::string> vars;
+        for (size_t bit = 0; bit < a.width; ++bit) {
+            vars.insert(field_bit_name(a.name, bit));
+        }
+        auto order = ordered_variable_names(vars);
+        for (auto op : ops) {
+            for (uint64_t c = 0; c < 8; ++c) {
+                teddy::bdd_manager mgr(3, 1000);
+                auto bdd = convert_to_bdd(*compare_ptr(a, op, c), mgr);
+                for (unsigned mask = 0; mask < 8; ++mask) {
+                    std::vector<bool> assignment = {(mask & 1u) != 0, (mask & 2u) != 0,
+                                                    (mask & 4u) != 0};
+                    uint64_t x = field_value(a, order, assignment);
+                    INFO("op=" << static_cast<int>(op) << " c=" << c << " x=" << x);
+                    REQUIRE(evaluate_teddy_bdd(mgr, bdd, assignment) == compare_values(op, x, c));
+                }
+            }
+        }
+    }
+
+    SECTION("field against field") {
+        std::unordered_set<std::string> vars;
+        for (size_t bit = 0; bit < a.width; ++bit) {
+            vars.insert(field_bit_name(a.name, bit));
+            vars.insert(field_bit_name(b.name, bit));
+        }
+        auto order = ordered_variable_names(vars);
+        for (auto op : ops) {
+            my_compare node;
+            node.field = a;
+            node.op = op;
+            node.rhs_field = b;
+            my_expression expr = std::move(node);
+            teddy::bdd_manager mgr(6, 1000);
+            auto bdd = convert_to_bdd(expr, mgr);
+            for (unsigned mask = 0; mask < 64; ++mask) {
+                std::vector<bool> assignment;
+                for (size_t i = 0; i < 6; ++i) {
+                    assignment.push_back(((mask >> i) & 1u) != 0);
+                }
+                uint64_t x = field_value(a, order, assignment);
+                uint64_t y = field_value(b, order, assignment);
+                INFO("op=" << static_cast<int>(op) << " x=" << x << " y=" << y);
+                REQUIRE(evaluate_teddy_bdd(mgr, bdd, assignment) == compare_values(op, x, y));
+            }
+        }
+    }
+
+    SECTION("IN with values and ranges") {
+        my_compare node;
+        node.field = my_field{"p", 4};
+        node.op = compare_op::in;
+        node.ranges = {{1, 1}, {4, 6}, {9, 15}};
+        my_expression expr = std::move(node);
+        teddy::bdd_manager mgr(4, 1000);
+        auto bdd = convert_to_bdd(expr, mgr);
+        // 1 + 3 + 7 matching values
+        REQUIRE(mgr.satisfy_count(1, bdd) == 11);
+    }
+}
+
+TEST_CASE("teddy_convert: field comparisons build linear-size BDDs", "[teddy_convert][field]") {
+    const my_field port{"port", 16};
+
+    teddy::bdd_manager eq_mgr(16, 10000);
+    auto eq = convert_to_bdd(*compare_ptr(port, compare_op::eq, 443), eq_mgr);
+    // One node per bit plus the two terminals
+    REQUIRE(eq_mgr.get_node_count(eq) == 18);
+    REQUIRE(eq_mgr.satisfy_count(1, eq) == 1);
+
+    teddy::bdd_manager lt_mgr(16, 10000);
+    auto lt = convert_to_bdd(*compare_ptr(port, compare_op::lt, 1024), lt_mgr);
+    REQUIRE(lt_mgr.get_node_count(lt) <= 18);
+    REQUIRE(lt_mgr.satisfy_count(1, lt) == 1024);
+
+    my_compare node;
+    node.field = my_field{"src", 16};
+    node.op = compare_op::le;
+    node.rhs_field = my_field{"dst", 16};
+    my_expression expr = std::move(node);
+    teddy::bdd_manager le_mgr(32, 10000);
+    auto le = convert_to_bdd(expr, le_mgr);
+    // At most three nodes per bit pair with interleaved ordering
+    REQUIRE(le_mgr.get_node_count(le) <= 3 * 16 + 2);
+}
+
+TEST_CASE("teddy_convert - negative: adapter rejects field comparisons",
+          "[teddy_convert][field][negative]") {
+    teddy::bdd_manager mgr(4, 1000);
+    auto expr = compare_ptr(my_field{"p", 4}, compare_op::eq, 3);
+    REQUIRE_THROWS_AS(convert_to_bdd_with_teddy_adapter(*expr, mgr), std::runtime_error);
+}
+
+TEST_CASE("teddy_convert: adapter handles nested negations", "[teddy_convert][adapter]") {
+    teddy::bdd_manager mgr(8, 10000);
+
+    // NOT (a0 AND NOT (a1 AND NOT (... NOT a7))) with a NOT run at every level
+    auto root = var_ptr("a7");
+    for (int i = 6; i >= 0; --i) {
+        auto inner = not_ptr(not_ptr(not_ptr(std::move(root))));
+        root = not_ptr(and_ptr(var_ptr("a" + std::to_string(i)), std::move(inner)));
+    }
+
+    auto expected = convert_to_bdd(*root, mgr);
+    auto actual = convert_to_bdd_with_teddy_adapter(*root, mgr);
+    REQUIRE(actual.equals(expected));
+}
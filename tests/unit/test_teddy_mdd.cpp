@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_teddy_mdd.cpp
+ * @brief Tests for the multi-valued decision diagram pipeline
+ *
+ * Covers MDD variable collection for DOMAIN fields, conversion semantics
+ * against brute-force evaluation, size against the bit-blasted BDD, and the
+ * MDD iterator used by the DOT and node table generators.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "teddy_convert.hpp"
+#include "teddy_mdd_convert.hpp"
+#include "teddy_mdd_graph.hpp"
+#include "teddy_mdd_iterator.hpp"
+
+using Catch::Matchers::ContainsSubstring;
+
+TEST_CASE("teddy_mdd: enumerated fields become single variables", "[teddy_mdd]") {
+    auto expr = parse_text(
+        "DOMAIN color {red, green, blue}\n"
+        "color == green AND (flag OR port[2] < 3)");
+    auto vars = collect_mdd_variables(*expr);
+
+    // Plain variables first, then fields by most significant bit
+    REQUIRE(vars.names == std::vector<std::string>{"flag", "color", "port[1]", "port[0]"});
+    REQUIRE(vars.domains == std::vector<int>{2, 3, 2, 2});
+    REQUIRE(vars.value_names[1] == std::vector<std::string>{"red", "green", "blue"});
+    REQUIRE(vars.index_of.at("color") == 1);
+}
+
+TEST_CASE("teddy_mdd: conversion matches brute-force evaluation", "[teddy_mdd]") {
+    auto expr = parse_text(
+        "DOMAIN color {red, green, blue, black}\n"
+        "DOMAIN level 5\n"
+        "(color IN {red, blue} AND level >= 3) OR (color != black AND NOT flag)");
+    auto vars = collect_mdd_variables(*expr);
+    // level has the wider encoding, so its most significant bit comes first
+    REQUIRE(vars.names == std::vector<std::string>{"flag", "level", "color"});
+
+    teddy::imdd_manager mgr(static_cast<int>(vars.names.size()), 1'000, vars.domains);
+    auto mdd = convert_to_mdd(*expr, mgr, vars);
+
+    long long expected_count = 0;
+    for (int flag = 0; flag < 2; ++flag) {
+        for (int color = 0; color < 4; ++color) {
+            for (int level = 0; level < 5; ++level) {
+                bool expected =
+                    ((color == 0 || color == 2) && level >= 3) || (color != 3 && !flag);
+                expected_count += expected ? 1 : 0;
+                INFO("flag=" << flag << " color=" << color << " level=" << level);
+                REQUIRE(mgr.evaluate(mdd, std::vector<int>{flag, level, color})
+                        == (expected ? 1 : 0));
+            }
+        }
+    }
+    REQUIRE(mgr.satisfy_count(1, mdd) == expected_count);
+}
+
+TEST_CASE("teddy_mdd: negated comparisons stay within the domain", "[teddy_mdd]") {
+    // color takes 2 bits, so code 3 is outside the domain in the bit-blasted BDD
+    auto count = [](const std::string& text) {
+        auto expr = parse_text("DOMAIN color {red, green, blue}\n" + text);
+        std::unordered_set<std::string> bits;
+        collect_variables_with_dag_walker(*expr, bits);
+        teddy::bdd_manager mgr(static_cast<int>(bits.size()), 1'000);
+        return mgr.satisfy_count(1, convert_to_bdd(*expr, mgr));
+    };
+    REQUIRE(count("color != red") == 2);
+    REQUIRE(count("NOT (color == red)") == 2);
+    REQUIRE(count("NOT (color IN {green, blue})") == 1);
+    REQUIRE(count("NOT (color == red) XOR NOT (color == blue)") == 2);
+
+    // A definition carries its fields to the outputs that use it
+    auto defined = parse_text(
+        "DOMAIN color {red, green, blue}\n"
+        "let warm = color == red; out = NOT warm;");
+    std::unordered_set<std::string> bits;
+    collect_variables_with_dag_walker(*defined, bits);
+    teddy::bdd_manager mgr(static_cast<int>(bits.size()), 1'000);
+    REQUIRE(mgr.satisfy_count(1, convert_to_bdd(*defined, mgr)) == 2);
+}
+
+TEST_CASE("teddy_mdd: wide enumerations are smaller than the bit-blasted BDD", "[teddy_mdd]") {
+    std::string values;
+    for (int v = 0; v < 200; v += 2) {
+        values += (values.empty() ? "" : ", ") + std::to_string(v);
+    }
+    auto expr = parse_text("DOMAIN proto 200\nproto IN {" + values + "}");
+
+    auto vars = collect_mdd_variables(*expr);
+    teddy::imdd_manager mdd_mgr(static_cast<int>(vars.names.size()), 1'000, vars.domains);
+    auto mdd = convert_to_mdd(*expr, mdd_mgr, vars);
+    // One internal node plus the two terminals
+    REQUIRE(mdd_mgr.get_node_count(mdd) == 3);
+    REQUIRE(mdd_mgr.satisfy_count(1, mdd) == 100);
+
+    std::unordered_set<std::string> bits;
+    collect_variables_with_dag_walker(*expr, bits);
+    REQUIRE(bits.size() == 8);
+    teddy::bdd_manager bdd_mgr(static_cast<int>(bits.size()), 1'000);
+    auto bdd = convert_to_bdd(*expr, bdd_mgr);
+    REQUIRE(bdd_mgr.satisfy_count(1, bdd) == 100);
+    REQUIRE(bdd_mgr.get_node_count(bdd) > mdd_mgr.get_node_count(mdd));
+}
+
+TEST_CASE("teddy_mdd: iterator groups sons and labels edges with values", "[teddy_mdd]") {
+    auto expr = parse_text("DOMAIN color {red, green, blue, cyan, white}\ncolor IN {green..cyan}");
+    auto vars = collect_mdd_variables(*expr);
+    teddy::imdd_manager mgr(static_cast<int>(vars.names.size()), 1'000, vars.domains);
+    auto mdd = convert_to_mdd(*expr, mgr, vars);
+
+    teddy_mdd_iterator root(mdd.unsafe_get_root(), &vars);
+    REQUIRE(root.get_label() == "color");
+    REQUIRE(root.get_type() == "Variable(5)");
+    auto children = root.get_children();
+    REQUIRE(children.size() == 2);
+    REQUIRE(children[0].is_terminal());
+    REQUIRE(children[0].get_terminal_value() == 0);
+    REQUIRE(root.get_edge_label(children[0], 0) == "red, white");
+    REQUIRE(root.get_edge_label(children[1], 1) == "green..cyan");
+
+    std::ostringstream dot;
+    write_teddy_mdd_to_dot(mdd, vars, dot);
+    REQUIRE_THAT(dot.str(), ContainsSubstring("digraph MDD"));
+    REQUIRE_THAT(dot.str(), ContainsSubstring("label = \"green..cyan\""));
+
+    std::ostringstream table;
+    write_teddy_mdd_nodes_to_stream(mdd, vars, table, true);
+    REQUIRE_THAT(table.str(), ContainsSubstring("MDD Node Table"));
+    REQUIRE_THAT(table.str(), ContainsSubstring("red, white->"));
+    REQUIRE_THAT(table.str(), ContainsSubstring("Total nodes: 3"));
+}
+
+TEST_CASE("teddy_mdd - negative: unknown variable", "[teddy_mdd][negative]") {
+    auto expr = parse_text("a AND b");
+    mdd_variables vars;
+    vars.names = {"a"};
+    vars.domains = {2};
+    vars.value_names = {{}};
+    vars.index_of = {{"a", 0}};
+    teddy::imdd_manager mgr(1, 1'000, vars.domains);
+    REQUIRE_THROWS_AS(convert_to_mdd(*expr, mgr, vars), std::runtime_error);
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_truth_table.cpp
+ * @brief Tests for bit-parallel truth tables
+ *
+ * Checks that tables built from expressions agree with the BDD built by the
+ * recursive converter, that the bottom-up conversion yields the identical
+ * diagram in the same manager, and the exported C lookup function.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "teddy_convert.hpp"
+#include "truth_table.hpp"
+
+namespace {
+
+std::vector<std::string> order_of(const my_expression& expr) {
+    std::unordered_set<std::string> names;
+    collect_variables_with_dag_walker(expr, names);
+    return ordered_variable_names(names);
+}
+
+std::vector<int> assignment_ints(std::uint64_t row, size_t count) {
+    std::vector<int> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<int>((row >> i) & 1);
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST_CASE("truth_table: table and BDD agree with the recursive converter", "[truth_table]") {
+    const std::vector<std::string> sources = {
+        "(a AND b) OR (c AND d) OR (e XOR f)",
+        "(a XOR b XOR c) AND NOT (d AND e) OR EXACTLY_ONE(a, d, f)",
+        "x[4] >= 5 AND (flag OR x[4] == 12)",
+        "AT_LEAST_K(2, p, q, r, s) AND NOT q OR AT_MOST_K(1, r, s)",
+    };
+    for (const auto& source : sources) {
+        INFO("expression: " << source);
+        auto expr = parse_text(source);
+        auto ordered = order_of(*expr);
+        teddy::bdd_manager manager(static_cast<int>(ordered.size()), 1'000);
+        auto expected = convert_to_bdd(*expr, manager);
+
+        auto tt = truth_table::build(*expr, ordered);
+        REQUIRE(tt.variable_count() == ordered.size());
+        REQUIRE(tt.rows() == (std::uint64_t{1} << ordered.size()));
+
+        std::uint64_t true_rows = 0;
+        for (std::uint64_t row = 0; row < tt.rows(); ++row) {
+            auto ints = assignment_ints(row, ordered.size());
+            const bool value = manager.evaluate(expected, ints) == 1;
+            INFO("row=" << row);
+            REQUIRE(tt.evaluate(row) == value);
+            true_rows += value ? 1 : 0;
+        }
+        REQUIRE(tt.count_true() == true_rows);
+
+        // Canonicity: the bottom-up build finds the very same diagram
+        auto built = truth_table::to_teddy(tt, manager);
+        REQUIRE(built.equals(expected));
+    }
+}
+
+TEST_CASE("truth_table: tables spanning several words", "[truth_table]") {
+    // Nine variables give 512 rows in eight words
+    auto expr = parse_text("(v0 AND v8) OR (v3 XOR v7) OR (v1 AND v2 AND NOT v4) OR (v5 AND v6)");
+    auto ordered = order_of(*expr);
+    REQUIRE(ordered.size() == 9);
+    teddy::bdd_manager manager(9, 1'000);
+    auto expected = convert_to_bdd(*expr, manager);
+
+    auto tt = truth_table::build(*expr, ordered);
+    REQUIRE(tt.words().size() == 8);
+    for (std::uint64_t row = 0; row < tt.rows(); ++row) {
+        auto ints = assignment_ints(row, ordered.size());
+        std::vector<std::uint8_t> bytes(ints.begin(), ints.end());
+        REQUIRE(tt.evaluate(bytes) == (manager.evaluate(expected, ints) == 1));
+    }
+    REQUIRE(truth_table::to_teddy(tt, manager).equals(expected));
+}
+
+TEST_CASE("truth_table: constants and the C lookup export", "[truth_table]") {
+    auto expr = parse_text("(a AND NOT a) OR (b AND NOT b)");
+    auto ordered = order_of(*expr);
+    teddy::bdd_manager manager(static_cast<int>(ordered.size()), 1'000);
+    auto tt = truth_table::build(*expr, ordered);
+    REQUIRE(tt.count_true() == 0);
+    REQUIRE(truth_table::to_teddy(tt, manager).equals(manager.constant(0)));
+
+    // a OR b: rows 1, 2 and 3 are true; padding above row 3 is cleared
+    truth_table::table or_table(2, {0xFFFFFFFFFFFFFFFEULL});
+    REQUIRE(or_table.words()[0] == 0xE);
+    REQUIRE(or_table.evaluate(std::uint64_t{7}));  // Bits above the variables are ignored
+
+    std::ostringstream out;
+    truth_table::write_c_lookup(or_table, {"a", "b*/"}, out, "or_eval");
+    auto text = out.str();
+    REQUIRE(text.find("(3 of 4 rows true)") != std::string::npos);
+    REQUIRE(text.find(" *   1: b* /\n") != std::string::npos);
+    REQUIRE(text.find("static const uint64_t or_eval_table[1] = {\n"
+                      "    UINT64_C(0x000000000000000E),\n};")
+            != std::string::npos);
+    REQUIRE(text.find("int or_eval(uint32_t row) {\n    row &= UINT32_C(0x3);\n")
+            != std::string::npos);
+}
+
+TEST_CASE("truth_table - negative: size and manager mismatches", "[truth_table][negative]") {
+    std::string wide = "v0";
+    for (int i = 1; i <= 20; ++i) {
+        wide += " OR v" + std::to_string(i);
+    }
+    auto expr = parse_text(wide);
+    auto ordered = order_of(*expr);
+    REQUIRE(ordered.size() == 21);
+    REQUIRE_THROWS_AS(truth_table::build(*expr, ordered), std::runtime_error);
+    REQUIRE_THROWS_AS(truth_table::table(21, std::vector<std::uint64_t>(std::size_t{1} << 15)),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(truth_table::table(7, std::vector<std::uint64_t>(1)), std::runtime_error);
+
+    auto small = parse_text("a AND b");
+    REQUIRE_THROWS_AS(truth_table::build(*small, {"a"}), std::runtime_error);
+    auto tt = truth_table::build(*small, {"a", "b"});
+    teddy::bdd_manager three(3, 1'000);
+    REQUIRE_THROWS_AS(truth_table::to_teddy(tt, three), std::runtime_error);
+    REQUIRE_THROWS_AS(tt.evaluate(std::vector<std::uint8_t>{1}), std::runtime_error);
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: Copyright (c) 2025 Alan Jowett
+
+/**
+ * @file tests/unit/test_workload_generator.cpp
+ * @brief Tests for the synthetic workload generator
+ *
+ * Checks that every family produces parseable expression files, that output
+ * is deterministic for a given seed, and that the generated functions have
+ * the expected number of satisfying assignments.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+#include "expression_graph.hpp"
+#include "expression_parser.hpp"
+#include "expression_test_utils.hpp"
+#include "teddy_convert.hpp"
+#include "workload_generator.hpp"
+
+using workload_generator::GeneratorOptions;
+
+namespace {
+
+// Parses generated file contents through the regular file reader
+my_expression_ptr parse_generated(const std::string& contents) {
+    auto temp_file = write_temp_file("test_workload_", contents);
+    auto expr = read_expression_from_file(temp_file.string());
+    std::filesystem::remove(temp_file);
+    return expr;
+}
+
+// Number of satisfying assignments of the generated expression over `total_vars` variables
+// (variables that do not occur in the expression are unconstrained)
+long long count_solutions(const std::string& contents, int total_vars = 0) {
+    auto expr = parse_generated(contents);
+    std::unordered_set<std::string> vars;
+    collect_variables_with_dag_walker(*expr, vars);
+    teddy::bdd_manager manager(static_cast<int>(vars.size()), 1'000);
+    auto f = convert_to_bdd(*expr, manager);
+    long long count = manager.satisfy_count(1, f);
+    for (int i = static_cast<int>(vars.size()); i < total_vars; ++i) {
+        count *= 2;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST_CASE("workload_generator: every family parses", "[workload_generator]") {
+    GeneratorOptions options;
+    options.n = 4;
+    options.rules = 4;
+    for (const auto& family : workload_generator::family_names()) {
+        INFO("family: " << family);
+        auto contents = workload_generator::generate_workload(family, options);
+        REQUIRE(contents.starts_with("#"));
+        REQUIRE(parse_generated(contents) != nullptr);
+    }
+}
+
+TEST_CASE("workload_generator: output is deterministic per seed", "[workload_generator]") {
+    GeneratorOptions options;
+    options.n = 20;
+    options.seed = 42;
+    auto first = workload_generator::generate_random_cnf(options);
+    REQUIRE(first == workload_generator::generate_random_cnf(options));
+
+    options.seed = 43;
+    REQUIRE(first != workload_generator::generate_random_cnf(options));
+}
+
+TEST_CASE("workload_generator: N-Queens has the known number of solutions",
+          "[workload_generator]") {
+    GeneratorOptions options;
+    options.n = 4;
+    REQUIRE(count_solutions(workload_generator::generate_n_queens(options)) == 2);
+    options.n = 5;
+    REQUIRE(count_solutions(workload_generator::generate_n_queens(options)) == 10);
+    options.n = 6;
+    REQUIRE(count_solutions(workload_generator::generate_n_queens(options)) == 4);
+}
+
+TEST_CASE("workload_generator: arithmetic bits match integer arithmetic",
+          "[workload_generator]") {
+    GeneratorOptions options;
+    options.n = 3;
+
+    SECTION("adder carry-out is set for 28 of 64 operand pairs") {
+        REQUIRE(count_solutions(workload_generator::generate_adder_bit(options)) == 28);
+        options.interleaved = false;
+        REQUIRE(count_solutions(workload_generator::generate_adder_bit(options)) == 28);
+    }
+
+    SECTION("multiplier bits match a brute-force count") {
+        for (int bit = 0; bit < 2 * options.n; ++bit) {
+            long long expected = 0;
+            for (int a = 0; a < 8; ++a) {
+                for (int b = 0; b < 8; ++b) {
+                    expected += ((a * b) >> bit) & 1;
+                }
+            }
+            options.bit = bit;
+            INFO("bit: " << bit);
+            REQUIRE(count_solutions(workload_generator::generate_multiplier_bit(options), 6)
+                    == expected);
+        }
+    }
+}
+
+TEST_CASE("workload_generator - negative: invalid parameters", "[workload_generator][negative]") {
+    GeneratorOptions options;
+    REQUIRE_THROWS_AS(workload_generator::generate_workload("unknown", options),
+                      std::invalid_argument);
+
+    options.k = 10;
+    options.n = 5;
+    REQUIRE_THROWS_AS(workload_generator::generate_random_cnf(options), std::invalid_argument);
+
+    options.fields = "proto";
+    REQUIRE_THROWS_AS(workload_generator::generate_packet_filter(options), std::invalid_argument);
+
+    options.n = 16;
+    options.bit = 15;
+    options.max_size = 1'000;
+    REQUIRE_THROWS_AS(workload_generator::generate_multiplier_bit(options), std::runtime_error);
+}